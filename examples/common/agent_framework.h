@@ -5,12 +5,12 @@
 #include <cstdint>
 #include <limits>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "s2clientprotocol/sc2api.pb.h"
 #include "common/planning/EIntentDomain.h"
+#include "common/spatial/FGroundPathfinder.h"
+#include "common/spatial/FUnitSpatialIndex.h"
 #include "sc2api/sc2_api.h"
 #include "sc2api/sc2_map_info.h"
 #include "terran_unit_container.h"
@@ -24,20 +24,31 @@ struct FFrameContext
     QueryInterface* Query{nullptr};
     const SC2APIProtocol::Observation* RawObservation{nullptr};
     const GameInfo* GameInfo{nullptr};
+    // Pathing, placement, creep and visibility decoded once for this step; null when the observation has none.
+    const MapGrids* DecodedMapGrids{nullptr};
     Point2D CameraWorld;
     uint64_t CurrentStep{0};
     uint64_t GameLoop{0};
+    // Built once per step from every observed unit and shared by all planners; null when the caller has none.
+    const FUnitSpatialIndex* UnitSpatialIndex{nullptr};
+    // Local ground pathing with this step's structures overlaid; null when the caller has none.
+    FGroundPathfinder* GroundPathfinder{nullptr};
 
-    static FFrameContext Create(const ObservationInterface* ObservationPtr, QueryInterface* QueryPtr, uint64_t CurrentStepValue)
+    static FFrameContext Create(const ObservationInterface* ObservationPtr, QueryInterface* QueryPtr, uint64_t CurrentStepValue,
+                                const FUnitSpatialIndex* UnitSpatialIndexPtr = nullptr,
+                                FGroundPathfinder* GroundPathfinderPtr = nullptr)
     {
         FFrameContext FrameContextValue;
         FrameContextValue.Observation = ObservationPtr;
         FrameContextValue.Query = QueryPtr;
         FrameContextValue.CurrentStep = CurrentStepValue;
+        FrameContextValue.UnitSpatialIndex = UnitSpatialIndexPtr;
+        FrameContextValue.GroundPathfinder = GroundPathfinderPtr;
         if (ObservationPtr)
         {
             FrameContextValue.RawObservation = ObservationPtr->GetRawObservation();
             FrameContextValue.GameInfo = &ObservationPtr->GetGameInfo();
+            FrameContextValue.DecodedMapGrids = ObservationPtr->GetMapGrids();
             FrameContextValue.CameraWorld = ObservationPtr->GetCameraPos();
             FrameContextValue.GameLoop = ObservationPtr->GetGameLoop();
         }
@@ -79,6 +90,38 @@ inline bool IsGroundPathingResultValid(const Unit& ActorUnitValue, const Point2D
     return true;
 }
 
+inline bool HasLocalGroundPathing(const FFrameContext& Frame)
+{
+    return Frame.GroundPathfinder != nullptr && Frame.GroundPathfinder->IsReady();
+}
+
+inline bool CanValidateGroundPathing(const FFrameContext& Frame)
+{
+    return HasLocalGroundPathing(Frame) || Frame.Query != nullptr;
+}
+
+// Ground distance from the unit to the point, 0 when unreachable. The local pathfinder answers when it has terrain;
+// in its verification mode the game query is still issued and its answer is the one returned.
+inline float GetGroundPathingDistance(const FFrameContext& Frame, const Unit& ActorUnitValue,
+                                      const Point2D& TargetPointValue)
+{
+    if (!HasLocalGroundPathing(Frame))
+    {
+        return Frame.Query != nullptr ? Frame.Query->PathingDistance(&ActorUnitValue, TargetPointValue) : 0.0f;
+    }
+
+    const float LocalDistanceValue =
+        Frame.GroundPathfinder->GetDistance(Point2D(ActorUnitValue.pos), TargetPointValue, ActorUnitValue.radius);
+    if (!Frame.GroundPathfinder->IsQueryVerificationEnabled() || Frame.Query == nullptr)
+    {
+        return LocalDistanceValue;
+    }
+
+    const float ServerDistanceValue = Frame.Query->PathingDistance(&ActorUnitValue, TargetPointValue);
+    Frame.GroundPathfinder->RecordVerificationResult(LocalDistanceValue, ServerDistanceValue);
+    return ServerDistanceValue;
+}
+
 struct FSpatialChannel8BPP
 {
     int Width{0};
@@ -522,11 +565,6 @@ struct FIntentArbiter
         return GetIntentDomainOrder(Challenger.Domain) < GetIntentDomainOrder(Incumbent.Domain);
     }
 
-    const Unit* FindActor(const FTerranUnitContainer& UnitContainerValue, Tag ActorTagValue) const
-    {
-        return UnitContainerValue.GetUnitByTag(ActorTagValue);
-    }
-
     const Unit* FindTarget(const FFrameContext& Frame, Tag TargetTagValue) const
     {
         if (!Frame.Observation)
@@ -537,16 +575,22 @@ struct FIntentArbiter
         return Frame.Observation->GetUnit(TargetTagValue);
     }
 
-    bool ValidateAndNormalize(FUnitIntent& IntentValue, const FFrameContext& Frame, const FTerranUnitContainer& UnitContainerValue,
-                              std::unordered_set<Tag>& ReservedBuildActors) const
+    bool RequiresPlacementQuery(const FUnitIntent& IntentValue) const
     {
-        const Unit* ActorUnit = FindActor(UnitContainerValue, IntentValue.ActorTag);
-        if (!ActorUnit)
-        {
-            return false;
-        }
+        return IntentValue.TargetKind == EIntentTargetKind::Point && IntentValue.RequiresPlacementValidation;
+    }
+
+    bool RequiresPathingQuery(const FUnitIntent& IntentValue, const Unit& ActorUnitValue) const
+    {
+        return IntentValue.TargetKind == EIntentTargetKind::Point && IntentValue.RequiresPathingValidation &&
+               !ActorUnitValue.is_flying;
+    }
 
-        if (IntentValue.Domain == EIntentDomain::StructureBuild && !ReservedBuildActors.insert(IntentValue.ActorTag).second)
+    // Validates everything that does not need a game query round trip and normalizes point targets. Placement and
+    // pathing results are applied separately so callers can batch them.
+    bool ValidateAndNormalizeLocal(FUnitIntent& IntentValue, const FFrameContext& Frame, const Unit* ActorUnit) const
+    {
+        if (!ActorUnit)
         {
             return false;
         }
@@ -570,83 +614,233 @@ struct FIntentArbiter
 
             IntentValue.TargetPoint = ClampToPlayable(*Frame.GameInfo, IntentValue.TargetPoint);
 
-            if (IntentValue.RequiresPlacementValidation)
+            if (!Frame.Query && RequiresPlacementQuery(IntentValue))
             {
-                if (!Frame.Query || !Frame.Query->Placement(IntentValue.Ability, IntentValue.TargetPoint, ActorUnit))
-                {
-                    return false;
-                }
+                return false;
             }
 
-            if (IntentValue.RequiresPathingValidation && !ActorUnit->is_flying)
+            if (!CanValidateGroundPathing(Frame) && RequiresPathingQuery(IntentValue, *ActorUnit))
             {
-                if (!Frame.Query)
-                {
-                    return false;
-                }
-
-                const float PathingDistanceValue = Frame.Query->PathingDistance(ActorUnit, IntentValue.TargetPoint);
-                if (!IsGroundPathingResultValid(*ActorUnit, IntentValue.TargetPoint, PathingDistanceValue))
-                {
-                    return false;
-                }
+                return false;
             }
         }
 
         return true;
     }
 
-    std::vector<FUnitIntent> Resolve(const FFrameContext& Frame, const FTerranUnitContainer& UnitContainerValue,
-                                     const FIntentBuffer& BufferValue) const
+    bool ValidateAndNormalize(FUnitIntent& IntentValue, const FFrameContext& Frame, const Unit* ActorUnit) const
     {
-        std::unordered_map<Tag, FUnitIntent> WinningIntents;
-        for (const FUnitIntent& IntentValue : BufferValue.Intents)
+        if (!ValidateAndNormalizeLocal(IntentValue, Frame, ActorUnit))
+        {
+            return false;
+        }
+
+        if (RequiresPlacementQuery(IntentValue) &&
+            !Frame.Query->Placement(IntentValue.Ability, IntentValue.TargetPoint, ActorUnit))
+        {
+            return false;
+        }
+
+        if (RequiresPathingQuery(IntentValue, *ActorUnit))
         {
-            if (IntentValue.ActorTag == NullTag)
+            const float PathingDistanceValue = GetGroundPathingDistance(Frame, *ActorUnit, IntentValue.TargetPoint);
+            if (!IsGroundPathingResultValid(*ActorUnit, IntentValue.TargetPoint, PathingDistanceValue))
             {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Resolves at most one intent per controlled actor into OutResolvedIntents, preserving buffer order of the
+    // winners. Scratch storage is retained across frames so steady-state calls do not allocate once the buffer and
+    // unit counts stop growing.
+    //
+    // Resolution runs in two phases. The collect phase picks winners, applies local validation, and queues every
+    // placement and pathing check. The resolve phase sends at most one batched placement request and one batched
+    // pathing request for the whole frame and drops the winners those results reject. Pathing is answered by the local
+    // pathfinder when the frame has one, and by the game only in its verification mode or when it is missing.
+    void Resolve(const FFrameContext& Frame, const FTerranUnitContainer& UnitContainerValue,
+                 const FIntentBuffer& BufferValue, std::vector<FUnitIntent>& OutResolvedIntents)
+    {
+        OutResolvedIntents.clear();
+        PendingPlacementQueries.clear();
+        PendingPathingQueries.clear();
+        PendingPathingStartRadii.clear();
+        CandidateActorSlots.clear();
+        CandidatePlacementQueryIndices.clear();
+        CandidatePathingQueryIndices.clear();
+        PlacementResults.clear();
+        PathingDistances.clear();
+
+        const size_t IntentCountValue = BufferValue.Intents.size();
+        WinningIntentIndicesByActorSlot.assign(UnitContainerValue.ControlledUnits.size(), InvalidIntentIndexValue);
+        IntentActorSlots.resize(IntentCountValue);
+
+        for (size_t IntentIndexValue = 0; IntentIndexValue < IntentCountValue; ++IntentIndexValue)
+        {
+            const FUnitIntent& IntentValue = BufferValue.Intents[IntentIndexValue];
+            size_t ActorSlotValue = 0;
+            if (IntentValue.ActorTag == NullTag ||
+                !UnitContainerValue.TryGetUnitIndexByTag(IntentValue.ActorTag, ActorSlotValue))
+            {
+                IntentActorSlots[IntentIndexValue] = InvalidIntentIndexValue;
                 continue;
             }
 
-            std::unordered_map<Tag, FUnitIntent>::iterator FoundWinner = WinningIntents.find(IntentValue.ActorTag);
-            if (FoundWinner == WinningIntents.end() || ShouldReplaceWinner(IntentValue, FoundWinner->second))
+            IntentActorSlots[IntentIndexValue] = static_cast<uint32_t>(ActorSlotValue);
+            uint32_t& WinningIntentIndexValue = WinningIntentIndicesByActorSlot[ActorSlotValue];
+            if (WinningIntentIndexValue == InvalidIntentIndexValue ||
+                ShouldReplaceWinner(IntentValue, BufferValue.Intents[WinningIntentIndexValue]))
             {
-                WinningIntents[IntentValue.ActorTag] = IntentValue;
+                WinningIntentIndexValue = static_cast<uint32_t>(IntentIndexValue);
             }
         }
 
-        std::vector<FUnitIntent> ResolvedIntents;
-        ResolvedIntents.reserve(WinningIntents.size());
-
-        std::unordered_set<Tag> AddedActors;
-        std::unordered_set<Tag> ReservedBuildActors;
-        for (const FUnitIntent& OriginalIntent : BufferValue.Intents)
+        // A winner strictly beats every earlier intent for its actor, so its own buffer position is the first match
+        // and each actor slot is validated exactly once. That also enforces one structure-build reservation per worker.
+        for (size_t IntentIndexValue = 0; IntentIndexValue < IntentCountValue; ++IntentIndexValue)
         {
-            std::unordered_map<Tag, FUnitIntent>::iterator FoundWinner = WinningIntents.find(OriginalIntent.ActorTag);
-            if (FoundWinner == WinningIntents.end())
+            const uint32_t ActorSlotValue = IntentActorSlots[IntentIndexValue];
+            if (ActorSlotValue == InvalidIntentIndexValue ||
+                WinningIntentIndicesByActorSlot[ActorSlotValue] != IntentIndexValue)
             {
                 continue;
             }
-            if (AddedActors.find(OriginalIntent.ActorTag) != AddedActors.end())
+
+            const Unit* ActorUnit = UnitContainerValue.ControlledUnits[ActorSlotValue];
+            OutResolvedIntents.push_back(BufferValue.Intents[IntentIndexValue]);
+            FUnitIntent& CandidateIntent = OutResolvedIntents.back();
+            if (!ValidateAndNormalizeLocal(CandidateIntent, Frame, ActorUnit))
             {
+                OutResolvedIntents.pop_back();
                 continue;
             }
-            if (!OriginalIntent.Matches(FoundWinner->second))
+
+            uint32_t PlacementQueryIndexValue = InvalidIntentIndexValue;
+            if (RequiresPlacementQuery(CandidateIntent))
             {
-                continue;
+                PlacementQueryIndexValue = static_cast<uint32_t>(PendingPlacementQueries.size());
+                QueryInterface::PlacementQuery PlacementQueryValue(CandidateIntent.Ability,
+                                                                   CandidateIntent.TargetPoint);
+                PlacementQueryValue.placing_unit_tag = ActorUnit->tag;
+                PendingPlacementQueries.push_back(PlacementQueryValue);
+            }
+
+            uint32_t PathingQueryIndexValue = InvalidIntentIndexValue;
+            if (RequiresPathingQuery(CandidateIntent, *ActorUnit))
+            {
+                PathingQueryIndexValue = static_cast<uint32_t>(PendingPathingQueries.size());
+                QueryInterface::PathingQuery PathingQueryValue;
+                PathingQueryValue.start_unit_tag_ = ActorUnit->tag;
+                PathingQueryValue.start_ = Point2D(ActorUnit->pos);
+                PathingQueryValue.end_ = CandidateIntent.TargetPoint;
+                PendingPathingQueries.push_back(PathingQueryValue);
+                PendingPathingStartRadii.push_back(ActorUnit->radius);
             }
 
-            FUnitIntent NormalizedIntent = FoundWinner->second;
-            if (!ValidateAndNormalize(NormalizedIntent, Frame, UnitContainerValue, ReservedBuildActors))
+            CandidateActorSlots.push_back(ActorSlotValue);
+            CandidatePlacementQueryIndices.push_back(PlacementQueryIndexValue);
+            CandidatePathingQueryIndices.push_back(PathingQueryIndexValue);
+        }
+
+        if (PendingPlacementQueries.empty() && PendingPathingQueries.empty())
+        {
+            return;
+        }
+
+        if (!PendingPlacementQueries.empty())
+        {
+            Frame.Query->TryPlacement(PendingPlacementQueries, PlacementResults);
+        }
+
+        if (!PendingPathingQueries.empty())
+        {
+            ResolvePathingDistances(Frame, PathingDistances);
+        }
+
+        size_t WriteIndexValue = 0;
+        for (size_t CandidateIndexValue = 0; CandidateIndexValue < OutResolvedIntents.size(); ++CandidateIndexValue)
+        {
+            const FUnitIntent& CandidateIntent = OutResolvedIntents[CandidateIndexValue];
+            const uint32_t PlacementQueryIndexValue = CandidatePlacementQueryIndices[CandidateIndexValue];
+            if (PlacementQueryIndexValue != InvalidIntentIndexValue &&
+                (PlacementQueryIndexValue >= PlacementResults.size() || !PlacementResults[PlacementQueryIndexValue]))
             {
                 continue;
             }
 
-            ResolvedIntents.push_back(NormalizedIntent);
-            AddedActors.insert(NormalizedIntent.ActorTag);
+            const uint32_t PathingQueryIndexValue = CandidatePathingQueryIndices[CandidateIndexValue];
+            if (PathingQueryIndexValue != InvalidIntentIndexValue)
+            {
+                const uint32_t ActorSlotValue = CandidateActorSlots[CandidateIndexValue];
+                const Unit& ActorUnitValue = *UnitContainerValue.ControlledUnits[ActorSlotValue];
+                if (PathingQueryIndexValue >= PathingDistances.size() ||
+                    !IsGroundPathingResultValid(ActorUnitValue, CandidateIntent.TargetPoint,
+                                                PathingDistances[PathingQueryIndexValue]))
+                {
+                    continue;
+                }
+            }
+
+            if (WriteIndexValue != CandidateIndexValue)
+            {
+                OutResolvedIntents[WriteIndexValue] = CandidateIntent;
+            }
+            ++WriteIndexValue;
         }
 
+        OutResolvedIntents.resize(WriteIndexValue);
+    }
+
+    std::vector<FUnitIntent> Resolve(const FFrameContext& Frame, const FTerranUnitContainer& UnitContainerValue,
+                                     const FIntentBuffer& BufferValue)
+    {
+        std::vector<FUnitIntent> ResolvedIntents;
+        Resolve(Frame, UnitContainerValue, BufferValue, ResolvedIntents);
         return ResolvedIntents;
     }
+
+private:
+    static constexpr uint32_t InvalidIntentIndexValue = std::numeric_limits<uint32_t>::max();
+
+    void ResolvePathingDistances(const FFrameContext& Frame, std::vector<float>& OutPathingDistances)
+    {
+        if (!HasLocalGroundPathing(Frame))
+        {
+            Frame.Query->TryPathingDistance(PendingPathingQueries, OutPathingDistances);
+            return;
+        }
+
+        Frame.GroundPathfinder->GetDistances(PendingPathingQueries, PendingPathingStartRadii, OutPathingDistances);
+        if (!Frame.GroundPathfinder->IsQueryVerificationEnabled() || Frame.Query == nullptr)
+        {
+            return;
+        }
+
+        Frame.Query->TryPathingDistance(PendingPathingQueries, ServerPathingDistances);
+        for (size_t QueryIndexValue = 0; QueryIndexValue < OutPathingDistances.size(); ++QueryIndexValue)
+        {
+            const float ServerDistanceValue =
+                QueryIndexValue < ServerPathingDistances.size() ? ServerPathingDistances[QueryIndexValue] : 0.0f;
+            Frame.GroundPathfinder->RecordVerificationResult(OutPathingDistances[QueryIndexValue],
+                                                             ServerDistanceValue);
+            OutPathingDistances[QueryIndexValue] = ServerDistanceValue;
+        }
+    }
+
+    std::vector<uint32_t> WinningIntentIndicesByActorSlot;
+    std::vector<uint32_t> IntentActorSlots;
+    std::vector<uint32_t> CandidateActorSlots;
+    std::vector<uint32_t> CandidatePlacementQueryIndices;
+    std::vector<uint32_t> CandidatePathingQueryIndices;
+    std::vector<QueryInterface::PlacementQuery> PendingPlacementQueries;
+    std::vector<QueryInterface::PathingQuery> PendingPathingQueries;
+    std::vector<float> PendingPathingStartRadii;
+    std::vector<bool> PlacementResults;
+    std::vector<float> PathingDistances;
+    std::vector<float> ServerPathingDistances;
 };
 
 }  // namespace sc2
@@ -772,7 +772,7 @@ struct FAgentState
             return;
         }
 
-        UnitContainer.SetUnits(Frame.Observation->GetUnits(Unit::Alliance::Self));
+        UnitContainer.UpdateUnits(Frame.Observation->GetUnits(Unit::Alliance::Self));
 
         Economy.Minerals = static_cast<uint32_t>(Frame.Observation->GetMinerals());
         Economy.Vespene = static_cast<uint32_t>(Frame.Observation->GetVespene());
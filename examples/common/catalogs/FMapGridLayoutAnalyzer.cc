@@ -0,0 +1,996 @@
+#include "common/catalogs/FMapGridLayoutAnalyzer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <sstream>
+#include <utility>
+
+#include "common/catalogs/FMapLayoutDictionary.h"
+
+namespace sc2
+{
+
+namespace
+{
+
+constexpr float UnreachableDistanceValue = std::numeric_limits<float>::max();
+constexpr float DiagonalStepCostValue = 1.41421356f;
+constexpr uint8_t UnconnectedBaseIndexValue = 0xFFU;
+
+// Resources closer than this, center to center, belong to the same base.
+constexpr float ResourceClusterLinkDistanceValue = 8.5f;
+// Mineral walls and reduced patches are not bases; a base needs a mineral line and at least one geyser.
+constexpr size_t MinimumBaseMineralPatchCountValue = 4U;
+// Town halls keep three empty cells between their footprint and any resource footprint.
+constexpr int32_t TownHallHalfFootprintValue = 2;
+constexpr int32_t TownHallResourceGapValue = 3;
+constexpr int32_t TownHallSearchRadiusValue = 12;
+constexpr float StartLocationMatchDistanceValue = 4.0f;
+
+// A pathable, unplaceable component is a ramp only when it spans at least this much terrain height.
+constexpr float MinimumRampHeightSpanValue = 1.0f;
+constexpr size_t MinimumRampTileCountValue = 4U;
+constexpr float RampEdgeHeightToleranceValue = 0.25f;
+constexpr float RampBaseHeightToleranceValue = 0.5f;
+
+struct FResourceFootprint
+{
+    Point2D Center;
+    bool bGeyser = false;
+};
+
+std::vector<std::string> SplitLines(const std::string& TextValue)
+{
+    std::vector<std::string> LinesValue;
+    std::string CurrentLineValue;
+    for (const char CharacterValue : TextValue)
+    {
+        if (CharacterValue == '\n')
+        {
+            LinesValue.push_back(CurrentLineValue);
+            CurrentLineValue.clear();
+            continue;
+        }
+        if (CharacterValue != '\r')
+        {
+            CurrentLineValue.push_back(CharacterValue);
+        }
+    }
+    if (!CurrentLineValue.empty())
+    {
+        LinesValue.push_back(CurrentLineValue);
+    }
+    while (!LinesValue.empty() && LinesValue.back().empty())
+    {
+        LinesValue.pop_back();
+    }
+    return LinesValue;
+}
+
+// Boolean grid dumps are written top row first with ' ' for true and '#' for false.
+bool ParseBooleanGrid(const std::string& TextValue, const char* GridNameValue, int32_t& OutWidthValue,
+                      int32_t& OutHeightValue, std::vector<uint8_t>& OutCellsValue, std::string& OutErrorValue)
+{
+    const std::vector<std::string> LinesValue = SplitLines(TextValue);
+    if (LinesValue.empty() || LinesValue.front().empty())
+    {
+        OutErrorValue = std::string(GridNameValue) + " grid is empty";
+        return false;
+    }
+
+    OutWidthValue = static_cast<int32_t>(LinesValue.front().size());
+    OutHeightValue = static_cast<int32_t>(LinesValue.size());
+    OutCellsValue.assign(static_cast<size_t>(OutWidthValue) * static_cast<size_t>(OutHeightValue), 0U);
+    for (int32_t RowIndexValue = 0; RowIndexValue < OutHeightValue; ++RowIndexValue)
+    {
+        const std::string& LineValue = LinesValue[static_cast<size_t>(RowIndexValue)];
+        if (static_cast<int32_t>(LineValue.size()) != OutWidthValue)
+        {
+            OutErrorValue = std::string(GridNameValue) + " grid row " + std::to_string(RowIndexValue) +
+                            " has an unexpected width";
+            return false;
+        }
+
+        const int32_t YValue = OutHeightValue - 1 - RowIndexValue;
+        for (int32_t XValue = 0; XValue < OutWidthValue; ++XValue)
+        {
+            OutCellsValue[static_cast<size_t>(XValue + YValue * OutWidthValue)] =
+                LineValue[static_cast<size_t>(XValue)] == ' ' ? 1U : 0U;
+        }
+    }
+    return true;
+}
+
+// Height dumps are written one line per column, each cell followed by '|'.
+bool ParseHeightGrid(const std::string& TextValue, const int32_t WidthValue, const int32_t HeightValue,
+                     std::vector<float>& OutHeightsValue, std::string& OutErrorValue)
+{
+    const std::vector<std::string> LinesValue = SplitLines(TextValue);
+    if (static_cast<int32_t>(LinesValue.size()) != WidthValue)
+    {
+        OutErrorValue = "height grid has " + std::to_string(LinesValue.size()) + " columns, expected " +
+                        std::to_string(WidthValue);
+        return false;
+    }
+
+    OutHeightsValue.assign(static_cast<size_t>(WidthValue) * static_cast<size_t>(HeightValue), 0.0f);
+    for (int32_t XValue = 0; XValue < WidthValue; ++XValue)
+    {
+        const char* CursorValue = LinesValue[static_cast<size_t>(XValue)].c_str();
+        for (int32_t YValue = 0; YValue < HeightValue; ++YValue)
+        {
+            char* EndValue = nullptr;
+            const float TerrainHeightValue = std::strtof(CursorValue, &EndValue);
+            if (EndValue == CursorValue || *EndValue != '|')
+            {
+                OutErrorValue = "height grid column " + std::to_string(XValue) + " is truncated";
+                return false;
+            }
+            OutHeightsValue[static_cast<size_t>(XValue + YValue * WidthValue)] = TerrainHeightValue;
+            CursorValue = EndValue + 1;
+        }
+    }
+    return true;
+}
+
+bool ReadTextFile(const std::string& FilePathValue, std::string& OutTextValue)
+{
+    std::ifstream FileStreamValue(FilePathValue, std::ios::binary);
+    if (!FileStreamValue)
+    {
+        return false;
+    }
+
+    std::ostringstream TextStreamValue;
+    TextStreamValue << FileStreamValue.rdbuf();
+    OutTextValue = TextStreamValue.str();
+    return true;
+}
+
+std::string GetDirectoryBaseName(const std::string& DirectoryPathValue)
+{
+    std::string TrimmedPathValue = DirectoryPathValue;
+    while (TrimmedPathValue.size() > 1U && (TrimmedPathValue.back() == '/' || TrimmedPathValue.back() == '\\'))
+    {
+        TrimmedPathValue.pop_back();
+    }
+
+    const size_t SeparatorIndexValue = TrimmedPathValue.find_last_of("/\\");
+    return SeparatorIndexValue == std::string::npos ? TrimmedPathValue
+                                                    : TrimmedPathValue.substr(SeparatorIndexValue + 1U);
+}
+
+// Visits the cells of the 4- or 8-connected component containing the seed and marks them in VisitedValue.
+void CollectComponent(const FMapGridDump& GridDumpValue, const int32_t SeedIndexValue, const bool bEightConnectedValue,
+                      const std::function<bool(int32_t, int32_t)>& IsMemberValue, std::vector<uint8_t>& VisitedValue,
+                      std::vector<Point2DI>& OutTilesValue)
+{
+    static const int32_t NeighborOffsetsValue[8][2] = {{1, 0}, {-1, 0}, {0, 1},  {0, -1},
+                                                       {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+    const int32_t NeighborCountValue = bEightConnectedValue ? 8 : 4;
+
+    OutTilesValue.clear();
+    std::vector<int32_t> PendingIndicesValue{SeedIndexValue};
+    VisitedValue[static_cast<size_t>(SeedIndexValue)] = 1U;
+    while (!PendingIndicesValue.empty())
+    {
+        const int32_t CellIndexValue = PendingIndicesValue.back();
+        PendingIndicesValue.pop_back();
+        const int32_t XValue = CellIndexValue % GridDumpValue.Width;
+        const int32_t YValue = CellIndexValue / GridDumpValue.Width;
+        OutTilesValue.emplace_back(XValue, YValue);
+
+        for (int32_t NeighborIndexValue = 0; NeighborIndexValue < NeighborCountValue; ++NeighborIndexValue)
+        {
+            const int32_t NeighborXValue = XValue + NeighborOffsetsValue[NeighborIndexValue][0];
+            const int32_t NeighborYValue = YValue + NeighborOffsetsValue[NeighborIndexValue][1];
+            if (!GridDumpValue.IsInside(NeighborXValue, NeighborYValue))
+            {
+                continue;
+            }
+
+            const int32_t NeighborCellIndexValue = NeighborXValue + NeighborYValue * GridDumpValue.Width;
+            if (VisitedValue[static_cast<size_t>(NeighborCellIndexValue)] != 0U ||
+                !IsMemberValue(NeighborXValue, NeighborYValue))
+            {
+                continue;
+            }
+            VisitedValue[static_cast<size_t>(NeighborCellIndexValue)] = 1U;
+            PendingIndicesValue.push_back(NeighborCellIndexValue);
+        }
+    }
+}
+
+bool IsResourceCell(const FMapGridDump& GridDumpValue, const int32_t XValue, const int32_t YValue)
+{
+    return GridDumpValue.IsPlaceable(XValue, YValue) && !GridDumpValue.IsPathable(XValue, YValue);
+}
+
+// Splits resource cells into geysers (full 3x3 blocks) and 2x1 mineral patches paired left to right along each row.
+void CollectResourceFootprints(const FMapGridDump& GridDumpValue, std::vector<FResourceFootprint>& OutResourcesValue,
+                               std::vector<uint8_t>& OutResourceMaskValue)
+{
+    const size_t CellCountValue = GridDumpValue.PathableCells.size();
+    OutResourceMaskValue.assign(CellCountValue, 0U);
+    std::vector<uint8_t> VisitedValue(CellCountValue, 0U);
+    std::vector<Point2DI> ComponentTilesValue;
+    const auto IsMemberValue = [&GridDumpValue](const int32_t XValue, const int32_t YValue)
+    {
+        return IsResourceCell(GridDumpValue, XValue, YValue);
+    };
+
+    for (int32_t CellIndexValue = 0; CellIndexValue < static_cast<int32_t>(CellCountValue); ++CellIndexValue)
+    {
+        const int32_t XValue = CellIndexValue % GridDumpValue.Width;
+        const int32_t YValue = CellIndexValue / GridDumpValue.Width;
+        if (VisitedValue[static_cast<size_t>(CellIndexValue)] != 0U || !IsResourceCell(GridDumpValue, XValue, YValue))
+        {
+            continue;
+        }
+
+        CollectComponent(GridDumpValue, CellIndexValue, false, IsMemberValue, VisitedValue, ComponentTilesValue);
+        for (const Point2DI& TileValue : ComponentTilesValue)
+        {
+            OutResourceMaskValue[static_cast<size_t>(TileValue.x + TileValue.y * GridDumpValue.Width)] = 1U;
+        }
+
+        int32_t MinXValue = ComponentTilesValue.front().x;
+        int32_t MinYValue = ComponentTilesValue.front().y;
+        int32_t MaxXValue = MinXValue;
+        int32_t MaxYValue = MinYValue;
+        for (const Point2DI& TileValue : ComponentTilesValue)
+        {
+            MinXValue = std::min(MinXValue, TileValue.x);
+            MinYValue = std::min(MinYValue, TileValue.y);
+            MaxXValue = std::max(MaxXValue, TileValue.x);
+            MaxYValue = std::max(MaxYValue, TileValue.y);
+        }
+
+        if (ComponentTilesValue.size() == 9U && MaxXValue - MinXValue == 2 && MaxYValue - MinYValue == 2)
+        {
+            FResourceFootprint GeyserValue;
+            GeyserValue.Center = Point2D(static_cast<float>(MinXValue) + 1.5f, static_cast<float>(MinYValue) + 1.5f);
+            GeyserValue.bGeyser = true;
+            OutResourcesValue.push_back(GeyserValue);
+            continue;
+        }
+
+        std::sort(ComponentTilesValue.begin(), ComponentTilesValue.end(),
+                  [](const Point2DI& LeftValue, const Point2DI& RightValue)
+                  { return LeftValue.y != RightValue.y ? LeftValue.y < RightValue.y : LeftValue.x < RightValue.x; });
+        for (size_t TileIndexValue = 0U; TileIndexValue + 1U < ComponentTilesValue.size();)
+        {
+            const Point2DI& LeftTileValue = ComponentTilesValue[TileIndexValue];
+            const Point2DI& RightTileValue = ComponentTilesValue[TileIndexValue + 1U];
+            if (RightTileValue.y != LeftTileValue.y || RightTileValue.x != LeftTileValue.x + 1)
+            {
+                ++TileIndexValue;
+                continue;
+            }
+
+            FResourceFootprint MineralValue;
+            MineralValue.Center =
+                Point2D(static_cast<float>(LeftTileValue.x) + 1.0f, static_cast<float>(LeftTileValue.y) + 0.5f);
+            OutResourcesValue.push_back(MineralValue);
+            TileIndexValue += 2U;
+        }
+    }
+}
+
+std::vector<std::vector<size_t>> ClusterResources(const std::vector<FResourceFootprint>& ResourcesValue)
+{
+    std::vector<size_t> ParentIndicesValue(ResourcesValue.size());
+    std::iota(ParentIndicesValue.begin(), ParentIndicesValue.end(), 0U);
+    const std::function<size_t(size_t)> FindRootValue = [&ParentIndicesValue, &FindRootValue](const size_t IndexValue)
+    {
+        if (ParentIndicesValue[IndexValue] != IndexValue)
+        {
+            ParentIndicesValue[IndexValue] = FindRootValue(ParentIndicesValue[IndexValue]);
+        }
+        return ParentIndicesValue[IndexValue];
+    };
+
+    for (size_t LeftIndexValue = 0U; LeftIndexValue < ResourcesValue.size(); ++LeftIndexValue)
+    {
+        for (size_t RightIndexValue = LeftIndexValue + 1U; RightIndexValue < ResourcesValue.size(); ++RightIndexValue)
+        {
+            if (Distance2D(ResourcesValue[LeftIndexValue].Center, ResourcesValue[RightIndexValue].Center) <=
+                ResourceClusterLinkDistanceValue)
+            {
+                ParentIndicesValue[FindRootValue(LeftIndexValue)] = FindRootValue(RightIndexValue);
+            }
+        }
+    }
+
+    std::vector<std::vector<size_t>> ClustersValue;
+    std::vector<int32_t> ClusterIndexByRootValue(ResourcesValue.size(), -1);
+    for (size_t ResourceIndexValue = 0U; ResourceIndexValue < ResourcesValue.size(); ++ResourceIndexValue)
+    {
+        const size_t RootIndexValue = FindRootValue(ResourceIndexValue);
+        if (ClusterIndexByRootValue[RootIndexValue] < 0)
+        {
+            ClusterIndexByRootValue[RootIndexValue] = static_cast<int32_t>(ClustersValue.size());
+            ClustersValue.emplace_back();
+        }
+        ClustersValue[static_cast<size_t>(ClusterIndexByRootValue[RootIndexValue])].push_back(ResourceIndexValue);
+    }
+    return ClustersValue;
+}
+
+bool IsTownHallCenterValid(const FMapGridDump& GridDumpValue, const std::vector<uint8_t>& ResourceMaskValue,
+                           const int32_t CenterTileXValue, const int32_t CenterTileYValue)
+{
+    for (int32_t YValue = CenterTileYValue - TownHallHalfFootprintValue;
+         YValue <= CenterTileYValue + TownHallHalfFootprintValue; ++YValue)
+    {
+        for (int32_t XValue = CenterTileXValue - TownHallHalfFootprintValue;
+             XValue <= CenterTileXValue + TownHallHalfFootprintValue; ++XValue)
+        {
+            if (!GridDumpValue.IsPlaceable(XValue, YValue) || !GridDumpValue.IsPathable(XValue, YValue))
+            {
+                return false;
+            }
+        }
+    }
+
+    const int32_t ExclusionRadiusValue = TownHallHalfFootprintValue + TownHallResourceGapValue;
+    for (int32_t YValue = CenterTileYValue - ExclusionRadiusValue; YValue <= CenterTileYValue + ExclusionRadiusValue;
+         ++YValue)
+    {
+        for (int32_t XValue = CenterTileXValue - ExclusionRadiusValue;
+             XValue <= CenterTileXValue + ExclusionRadiusValue; ++XValue)
+        {
+            if (GridDumpValue.IsInside(XValue, YValue) &&
+                ResourceMaskValue[static_cast<size_t>(XValue + YValue * GridDumpValue.Width)] != 0U)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Picks the valid town hall center that minimizes the summed distance to the cluster's resources.
+bool TryFindTownHallLocation(const FMapGridDump& GridDumpValue, const std::vector<uint8_t>& ResourceMaskValue,
+                             const std::vector<FResourceFootprint>& ResourcesValue,
+                             const std::vector<size_t>& ClusterIndicesValue, Point2D& OutLocationValue)
+{
+    Point2D CentroidValue(0.0f, 0.0f);
+    for (const size_t ResourceIndexValue : ClusterIndicesValue)
+    {
+        CentroidValue += ResourcesValue[ResourceIndexValue].Center;
+    }
+    CentroidValue /= static_cast<float>(ClusterIndicesValue.size());
+
+    const int32_t CentroidTileXValue = static_cast<int32_t>(std::floor(CentroidValue.x));
+    const int32_t CentroidTileYValue = static_cast<int32_t>(std::floor(CentroidValue.y));
+    float BestScoreValue = std::numeric_limits<float>::max();
+    bool bFoundValue = false;
+    for (int32_t TileYValue = CentroidTileYValue - TownHallSearchRadiusValue;
+         TileYValue <= CentroidTileYValue + TownHallSearchRadiusValue; ++TileYValue)
+    {
+        for (int32_t TileXValue = CentroidTileXValue - TownHallSearchRadiusValue;
+             TileXValue <= CentroidTileXValue + TownHallSearchRadiusValue; ++TileXValue)
+        {
+            if (!IsTownHallCenterValid(GridDumpValue, ResourceMaskValue, TileXValue, TileYValue))
+            {
+                continue;
+            }
+
+            const Point2D CandidateValue(static_cast<float>(TileXValue) + 0.5f, static_cast<float>(TileYValue) + 0.5f);
+            float ScoreValue = 0.0f;
+            for (const size_t ResourceIndexValue : ClusterIndicesValue)
+            {
+                ScoreValue += Distance2D(CandidateValue, ResourcesValue[ResourceIndexValue].Center);
+            }
+            if (ScoreValue < BestScoreValue)
+            {
+                BestScoreValue = ScoreValue;
+                OutLocationValue = CandidateValue;
+                bFoundValue = true;
+            }
+        }
+    }
+    return bFoundValue;
+}
+
+std::vector<FMapBaseDescriptor> DetectBases(const FMapGridDump& GridDumpValue)
+{
+    std::vector<FResourceFootprint> ResourcesValue;
+    std::vector<uint8_t> ResourceMaskValue;
+    CollectResourceFootprints(GridDumpValue, ResourcesValue, ResourceMaskValue);
+
+    std::vector<FMapBaseDescriptor> BasesValue;
+    for (const std::vector<size_t>& ClusterIndicesValue : ClusterResources(ResourcesValue))
+    {
+        std::vector<Point2D> MineralPositionsValue;
+        std::vector<Point2D> GeyserPositionsValue;
+        for (const size_t ResourceIndexValue : ClusterIndicesValue)
+        {
+            const FResourceFootprint& ResourceValue = ResourcesValue[ResourceIndexValue];
+            (ResourceValue.bGeyser ? GeyserPositionsValue : MineralPositionsValue).push_back(ResourceValue.Center);
+        }
+        if (MineralPositionsValue.size() < MinimumBaseMineralPatchCountValue || GeyserPositionsValue.empty())
+        {
+            continue;
+        }
+
+        FMapBaseDescriptor BaseValue{};
+        if (!TryFindTownHallLocation(GridDumpValue, ResourceMaskValue, ResourcesValue, ClusterIndicesValue,
+                                     BaseValue.Location))
+        {
+            continue;
+        }
+
+        // Keep the resources nearest the town hall when a cluster holds more than the descriptor can store.
+        const auto IsNearerValue = [&BaseValue](const Point2D& LeftValue, const Point2D& RightValue)
+        {
+            return DistanceSquared2D(LeftValue, BaseValue.Location) <
+                   DistanceSquared2D(RightValue, BaseValue.Location);
+        };
+        std::stable_sort(MineralPositionsValue.begin(), MineralPositionsValue.end(), IsNearerValue);
+        std::stable_sort(GeyserPositionsValue.begin(), GeyserPositionsValue.end(), IsNearerValue);
+        BaseValue.MineralPatchCount = static_cast<uint8_t>(
+            std::min(MineralPositionsValue.size(), BaseValue.MineralPatchPositions.size()));
+        std::copy_n(MineralPositionsValue.begin(), BaseValue.MineralPatchCount,
+                    BaseValue.MineralPatchPositions.begin());
+        BaseValue.GeyserCount =
+            static_cast<uint8_t>(std::min(GeyserPositionsValue.size(), BaseValue.GeyserPositions.size()));
+        std::copy_n(GeyserPositionsValue.begin(), BaseValue.GeyserCount, BaseValue.GeyserPositions.begin());
+
+        for (const Point2D& StartLocationValue : GridDumpValue.StartLocations)
+        {
+            if (Distance2D(StartLocationValue, BaseValue.Location) <= StartLocationMatchDistanceValue)
+            {
+                BaseValue.bIsStartLocation = true;
+            }
+        }
+        BasesValue.push_back(BaseValue);
+    }
+
+    // Number bases from the top-left of the map, row by row, so reruns produce stable indices.
+    std::sort(BasesValue.begin(), BasesValue.end(),
+              [](const FMapBaseDescriptor& LeftValue, const FMapBaseDescriptor& RightValue)
+              {
+                  return LeftValue.Location.y != RightValue.Location.y ? LeftValue.Location.y > RightValue.Location.y
+                                                                       : LeftValue.Location.x < RightValue.Location.x;
+              });
+    for (size_t BaseIndexValue = 0U; BaseIndexValue < BasesValue.size(); ++BaseIndexValue)
+    {
+        BasesValue[BaseIndexValue].BaseIndex = static_cast<uint8_t>(BaseIndexValue);
+    }
+    return BasesValue;
+}
+
+// Exact octile shortest path lengths from one tile over the pathing grid. Diagonal steps may not cut a blocked corner.
+std::vector<float> BuildGroundDistanceField(const FMapGridDump& GridDumpValue, const Point2D& SourcePointValue)
+{
+    static const int32_t NeighborOffsetsValue[8][2] = {{1, 0}, {-1, 0}, {0, 1},  {0, -1},
+                                                       {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+    using FQueueEntry = std::pair<float, int32_t>;
+
+    std::vector<float> DistancesValue(GridDumpValue.PathableCells.size(), UnreachableDistanceValue);
+    const int32_t SourceXValue = static_cast<int32_t>(std::floor(SourcePointValue.x));
+    const int32_t SourceYValue = static_cast<int32_t>(std::floor(SourcePointValue.y));
+    if (!GridDumpValue.IsPathable(SourceXValue, SourceYValue))
+    {
+        return DistancesValue;
+    }
+
+    std::priority_queue<FQueueEntry, std::vector<FQueueEntry>, std::greater<FQueueEntry>> PendingCellsValue;
+    const int32_t SourceIndexValue = SourceXValue + SourceYValue * GridDumpValue.Width;
+    DistancesValue[static_cast<size_t>(SourceIndexValue)] = 0.0f;
+    PendingCellsValue.emplace(0.0f, SourceIndexValue);
+    while (!PendingCellsValue.empty())
+    {
+        const FQueueEntry EntryValue = PendingCellsValue.top();
+        PendingCellsValue.pop();
+        if (EntryValue.first > DistancesValue[static_cast<size_t>(EntryValue.second)])
+        {
+            continue;
+        }
+
+        const int32_t XValue = EntryValue.second % GridDumpValue.Width;
+        const int32_t YValue = EntryValue.second / GridDumpValue.Width;
+        for (int32_t NeighborIndexValue = 0; NeighborIndexValue < 8; ++NeighborIndexValue)
+        {
+            const int32_t OffsetXValue = NeighborOffsetsValue[NeighborIndexValue][0];
+            const int32_t OffsetYValue = NeighborOffsetsValue[NeighborIndexValue][1];
+            const int32_t NeighborXValue = XValue + OffsetXValue;
+            const int32_t NeighborYValue = YValue + OffsetYValue;
+            if (!GridDumpValue.IsPathable(NeighborXValue, NeighborYValue))
+            {
+                continue;
+            }
+
+            const bool bDiagonalValue = OffsetXValue != 0 && OffsetYValue != 0;
+            if (bDiagonalValue && (!GridDumpValue.IsPathable(XValue + OffsetXValue, YValue) ||
+                                   !GridDumpValue.IsPathable(XValue, YValue + OffsetYValue)))
+            {
+                continue;
+            }
+
+            const float CandidateDistanceValue = EntryValue.first + (bDiagonalValue ? DiagonalStepCostValue : 1.0f);
+            const int32_t NeighborCellIndexValue = NeighborXValue + NeighborYValue * GridDumpValue.Width;
+            if (CandidateDistanceValue < DistancesValue[static_cast<size_t>(NeighborCellIndexValue)])
+            {
+                DistancesValue[static_cast<size_t>(NeighborCellIndexValue)] = CandidateDistanceValue;
+                PendingCellsValue.emplace(CandidateDistanceValue, NeighborCellIndexValue);
+            }
+        }
+    }
+    return DistancesValue;
+}
+
+float GetFieldDistance(const FMapGridDump& GridDumpValue, const std::vector<float>& DistanceFieldValue,
+                       const Point2D& PointValue)
+{
+    const int32_t XValue = static_cast<int32_t>(std::floor(PointValue.x));
+    const int32_t YValue = static_cast<int32_t>(std::floor(PointValue.y));
+    if (!GridDumpValue.IsInside(XValue, YValue))
+    {
+        return UnreachableDistanceValue;
+    }
+    return DistanceFieldValue[static_cast<size_t>(XValue + YValue * GridDumpValue.Width)];
+}
+
+ERampOrientation GetRampFacing(const Point2D& TopCenterValue, const Point2D& BottomCenterValue)
+{
+    const bool bFacesEastValue = BottomCenterValue.x >= TopCenterValue.x;
+    const bool bFacesNorthValue = BottomCenterValue.y > TopCenterValue.y;
+    if (bFacesNorthValue)
+    {
+        return bFacesEastValue ? ERampOrientation::NorthEast : ERampOrientation::NorthWest;
+    }
+    return bFacesEastValue ? ERampOrientation::SouthEast : ERampOrientation::SouthWest;
+}
+
+// Ramp tiles are recorded by their integer corner, as in the authored dictionary.
+Point2D GetTileCorner(const Point2DI& TileValue)
+{
+    return Point2D(static_cast<float>(TileValue.x), static_cast<float>(TileValue.y));
+}
+
+// Fills one ramp edge with up to eight tiles nearest the edge's center and returns the center of the whole edge.
+Point2D FillRampEdge(std::vector<Point2DI> EdgeTilesValue, std::array<Point2DI, 8>& OutTilesValue,
+                     uint8_t& OutTileCountValue)
+{
+    Point2D CenterValue(0.0f, 0.0f);
+    for (const Point2DI& TileValue : EdgeTilesValue)
+    {
+        CenterValue += GetTileCorner(TileValue);
+    }
+    CenterValue /= static_cast<float>(EdgeTilesValue.size());
+
+    std::stable_sort(EdgeTilesValue.begin(), EdgeTilesValue.end(),
+                     [&CenterValue](const Point2DI& LeftValue, const Point2DI& RightValue)
+                     {
+                         return DistanceSquared2D(GetTileCorner(LeftValue), CenterValue) <
+                                DistanceSquared2D(GetTileCorner(RightValue), CenterValue);
+                     });
+    EdgeTilesValue.resize(std::min(EdgeTilesValue.size(), OutTilesValue.size()));
+    std::sort(EdgeTilesValue.begin(), EdgeTilesValue.end(),
+              [](const Point2DI& LeftValue, const Point2DI& RightValue)
+              { return LeftValue.y != RightValue.y ? LeftValue.y < RightValue.y : LeftValue.x < RightValue.x; });
+    OutTileCountValue = static_cast<uint8_t>(EdgeTilesValue.size());
+    std::copy(EdgeTilesValue.begin(), EdgeTilesValue.end(), OutTilesValue.begin());
+    return CenterValue;
+}
+
+// Returns the base on the requested side of a ramp edge that is nearest along the ground.
+uint8_t FindConnectedBaseIndex(const FMapGridDump& GridDumpValue, const std::vector<FMapBaseDescriptor>& BasesValue,
+                               const std::vector<std::vector<float>>& DistanceFieldsValue,
+                               const Point2D& EdgeCenterValue, const float EdgeHeightValue, const bool bAboveEdgeValue,
+                               const uint8_t ExcludedBaseIndexValue)
+{
+    uint8_t BestBaseIndexValue = UnconnectedBaseIndexValue;
+    float BestDistanceValue = UnreachableDistanceValue;
+    for (size_t BaseIndexValue = 0U; BaseIndexValue < BasesValue.size(); ++BaseIndexValue)
+    {
+        const Point2D& LocationValue = BasesValue[BaseIndexValue].Location;
+        const float BaseHeightValue = GridDumpValue.GetTerrainHeight(static_cast<int32_t>(LocationValue.x),
+                                                                     static_cast<int32_t>(LocationValue.y));
+        const bool bOnSideValue = bAboveEdgeValue ? BaseHeightValue >= EdgeHeightValue - RampBaseHeightToleranceValue
+                                                  : BaseHeightValue <= EdgeHeightValue + RampBaseHeightToleranceValue;
+        if (!bOnSideValue || BaseIndexValue == ExcludedBaseIndexValue)
+        {
+            continue;
+        }
+
+        const float DistanceValue =
+            GetFieldDistance(GridDumpValue, DistanceFieldsValue[BaseIndexValue], EdgeCenterValue);
+        if (DistanceValue < BestDistanceValue)
+        {
+            BestDistanceValue = DistanceValue;
+            BestBaseIndexValue = static_cast<uint8_t>(BaseIndexValue);
+        }
+    }
+    return BestBaseIndexValue;
+}
+
+std::vector<FMapRampDescriptor> DetectRamps(const FMapGridDump& GridDumpValue,
+                                            const std::vector<FMapBaseDescriptor>& BasesValue,
+                                            const std::vector<std::vector<float>>& DistanceFieldsValue)
+{
+    const auto IsMemberValue = [&GridDumpValue](const int32_t XValue, const int32_t YValue)
+    { return GridDumpValue.IsPathable(XValue, YValue) && !GridDumpValue.IsPlaceable(XValue, YValue); };
+
+    std::vector<FMapRampDescriptor> RampsValue;
+    std::vector<uint8_t> VisitedValue(GridDumpValue.PathableCells.size(), 0U);
+    std::vector<Point2DI> ComponentTilesValue;
+    for (int32_t CellIndexValue = 0; CellIndexValue < static_cast<int32_t>(VisitedValue.size()); ++CellIndexValue)
+    {
+        const int32_t XValue = CellIndexValue % GridDumpValue.Width;
+        const int32_t YValue = CellIndexValue / GridDumpValue.Width;
+        if (VisitedValue[static_cast<size_t>(CellIndexValue)] != 0U || !IsMemberValue(XValue, YValue))
+        {
+            continue;
+        }
+
+        CollectComponent(GridDumpValue, CellIndexValue, true, IsMemberValue, VisitedValue, ComponentTilesValue);
+        if (ComponentTilesValue.size() < MinimumRampTileCountValue)
+        {
+            continue;
+        }
+
+        float MinHeightValue = std::numeric_limits<float>::max();
+        float MaxHeightValue = std::numeric_limits<float>::lowest();
+        for (const Point2DI& TileValue : ComponentTilesValue)
+        {
+            const float TerrainHeightValue = GridDumpValue.GetTerrainHeight(TileValue.x, TileValue.y);
+            MinHeightValue = std::min(MinHeightValue, TerrainHeightValue);
+            MaxHeightValue = std::max(MaxHeightValue, TerrainHeightValue);
+        }
+        if (MaxHeightValue - MinHeightValue < MinimumRampHeightSpanValue)
+        {
+            continue;
+        }
+
+        std::vector<Point2DI> TopTilesValue;
+        std::vector<Point2DI> BottomTilesValue;
+        for (const Point2DI& TileValue : ComponentTilesValue)
+        {
+            const float TerrainHeightValue = GridDumpValue.GetTerrainHeight(TileValue.x, TileValue.y);
+            if (TerrainHeightValue >= MaxHeightValue - RampEdgeHeightToleranceValue)
+            {
+                TopTilesValue.push_back(TileValue);
+            }
+            else if (TerrainHeightValue <= MinHeightValue + RampEdgeHeightToleranceValue)
+            {
+                BottomTilesValue.push_back(TileValue);
+            }
+        }
+
+        FMapRampDescriptor RampValue{};
+        RampValue.TopCenter = FillRampEdge(TopTilesValue, RampValue.TopTiles, RampValue.TopTileCount);
+        RampValue.BottomCenter = FillRampEdge(BottomTilesValue, RampValue.BottomTiles, RampValue.BottomTileCount);
+        RampValue.Orientation = GetRampFacing(RampValue.TopCenter, RampValue.BottomCenter);
+        RampValue.Width = static_cast<uint8_t>(
+            std::min<size_t>(std::min(TopTilesValue.size(), BottomTilesValue.size()), UnconnectedBaseIndexValue));
+        RampValue.ConnectedBaseIndexA = FindConnectedBaseIndex(GridDumpValue, BasesValue, DistanceFieldsValue,
+                                                               RampValue.TopCenter, MaxHeightValue, true,
+                                                               UnconnectedBaseIndexValue);
+        RampValue.ConnectedBaseIndexB = FindConnectedBaseIndex(GridDumpValue, BasesValue, DistanceFieldsValue,
+                                                               RampValue.BottomCenter, MinHeightValue, false,
+                                                               RampValue.ConnectedBaseIndexA);
+        RampsValue.push_back(RampValue);
+    }
+
+    std::sort(RampsValue.begin(), RampsValue.end(),
+              [](const FMapRampDescriptor& LeftValue, const FMapRampDescriptor& RightValue)
+              {
+                  if (LeftValue.TopCenter.y != RightValue.TopCenter.y)
+                  {
+                      return LeftValue.TopCenter.y > RightValue.TopCenter.y;
+                  }
+                  return LeftValue.TopCenter.x < RightValue.TopCenter.x;
+              });
+    for (size_t RampIndexValue = 0U; RampIndexValue < RampsValue.size(); ++RampIndexValue)
+    {
+        RampsValue[RampIndexValue].RampIndex = static_cast<uint8_t>(RampIndexValue);
+    }
+    return RampsValue;
+}
+
+// Builds the YAML MapId from the map name: words are capitalized and joined, and a trailing ladder "LE" is dropped.
+std::string GetMapIdentifier(const std::string& MapNameValue)
+{
+    std::vector<std::string> WordsValue;
+    std::string CurrentWordValue;
+    for (const char CharacterValue : MapNameValue)
+    {
+        if (std::isalnum(static_cast<unsigned char>(CharacterValue)) != 0)
+        {
+            CurrentWordValue.push_back(CharacterValue);
+            continue;
+        }
+        if (!CurrentWordValue.empty())
+        {
+            WordsValue.push_back(CurrentWordValue);
+            CurrentWordValue.clear();
+        }
+    }
+    if (!CurrentWordValue.empty())
+    {
+        WordsValue.push_back(CurrentWordValue);
+    }
+    if (WordsValue.size() > 1U && WordsValue.back() == "LE")
+    {
+        WordsValue.pop_back();
+    }
+
+    std::string IdentifierValue;
+    for (std::string& WordValue : WordsValue)
+    {
+        WordValue.front() = static_cast<char>(std::toupper(static_cast<unsigned char>(WordValue.front())));
+        IdentifierValue += WordValue;
+    }
+    return IdentifierValue;
+}
+
+std::string FormatPoint(const Point2D& PointValue)
+{
+    char BufferValue[64];
+    std::snprintf(BufferValue, sizeof(BufferValue), "[%.1f, %.1f]", PointValue.x, PointValue.y);
+    return BufferValue;
+}
+
+std::string FormatBound(const Point2D& PointValue)
+{
+    char BufferValue[64];
+    std::snprintf(BufferValue, sizeof(BufferValue), "[%g, %g]", PointValue.x, PointValue.y);
+    return BufferValue;
+}
+
+const char* GetOrientationName(const ERampOrientation OrientationValue)
+{
+    switch (OrientationValue)
+    {
+        case ERampOrientation::NorthEast:
+            return "NorthEast";
+        case ERampOrientation::SouthEast:
+            return "SouthEast";
+        case ERampOrientation::SouthWest:
+            return "SouthWest";
+        case ERampOrientation::NorthWest:
+            return "NorthWest";
+        default:
+            return "Unknown";
+    }
+}
+
+template <typename TValue, size_t CapacityValue>
+void AppendPointList(std::ostringstream& YamlStreamValue, const char* KeyValue,
+                     const std::array<TValue, CapacityValue>& PointsValue, const uint8_t CountValue,
+                     const std::function<std::string(const TValue&)>& FormatValue)
+{
+    YamlStreamValue << "        " << KeyValue << ":";
+    if (CountValue == 0U)
+    {
+        YamlStreamValue << " []\n";
+        return;
+    }
+
+    YamlStreamValue << "\n";
+    for (uint8_t PointIndexValue = 0U; PointIndexValue < CountValue; ++PointIndexValue)
+    {
+        YamlStreamValue << "          - " << FormatValue(PointsValue[PointIndexValue]) << "\n";
+    }
+}
+
+}  // namespace
+
+bool FMapGridDump::IsInside(const int32_t XValue, const int32_t YValue) const
+{
+    return XValue >= 0 && YValue >= 0 && XValue < Width && YValue < Height;
+}
+
+bool FMapGridDump::IsPathable(const int32_t XValue, const int32_t YValue) const
+{
+    return IsInside(XValue, YValue) && PathableCells[static_cast<size_t>(XValue + YValue * Width)] != 0U;
+}
+
+bool FMapGridDump::IsPlaceable(const int32_t XValue, const int32_t YValue) const
+{
+    return IsInside(XValue, YValue) && PlaceableCells[static_cast<size_t>(XValue + YValue * Width)] != 0U;
+}
+
+float FMapGridDump::GetTerrainHeight(const int32_t XValue, const int32_t YValue) const
+{
+    return IsInside(XValue, YValue) ? TerrainHeights[static_cast<size_t>(XValue + YValue * Width)] : 0.0f;
+}
+
+bool FMapGridLayoutAnalyzer::ParseGridDump(const std::string& PathingTextValue, const std::string& PlacementTextValue,
+                                           const std::string& HeightTextValue, FMapGridDump& OutGridDumpValue,
+                                           std::string& OutErrorValue)
+{
+    int32_t PlacementWidthValue = 0;
+    int32_t PlacementHeightValue = 0;
+    if (!ParseBooleanGrid(PathingTextValue, "pathing", OutGridDumpValue.Width, OutGridDumpValue.Height,
+                          OutGridDumpValue.PathableCells, OutErrorValue) ||
+        !ParseBooleanGrid(PlacementTextValue, "placement", PlacementWidthValue, PlacementHeightValue,
+                          OutGridDumpValue.PlaceableCells, OutErrorValue))
+    {
+        return false;
+    }
+    if (PlacementWidthValue != OutGridDumpValue.Width || PlacementHeightValue != OutGridDumpValue.Height)
+    {
+        OutErrorValue = "placement grid size differs from pathing grid size";
+        return false;
+    }
+    return ParseHeightGrid(HeightTextValue, OutGridDumpValue.Width, OutGridDumpValue.Height,
+                           OutGridDumpValue.TerrainHeights, OutErrorValue);
+}
+
+bool FMapGridLayoutAnalyzer::LoadGridDumpDirectory(const std::string& DirectoryPathValue,
+                                                   FMapGridDump& OutGridDumpValue, std::string& OutErrorValue)
+{
+    const std::string PrefixValue = DirectoryPathValue + "/";
+    std::string PathingTextValue;
+    std::string PlacementTextValue;
+    std::string HeightTextValue;
+    if (!ReadTextFile(PrefixValue + "pathing.txt", PathingTextValue) ||
+        !ReadTextFile(PrefixValue + "placement.txt", PlacementTextValue) ||
+        !ReadTextFile(PrefixValue + "height.txt", HeightTextValue))
+    {
+        OutErrorValue = "missing pathing.txt, placement.txt or height.txt in " + DirectoryPathValue;
+        return false;
+    }
+    if (!ParseGridDump(PathingTextValue, PlacementTextValue, HeightTextValue, OutGridDumpValue, OutErrorValue))
+    {
+        OutErrorValue = DirectoryPathValue + ": " + OutErrorValue;
+        return false;
+    }
+
+    OutGridDumpValue.MapName = GetDirectoryBaseName(DirectoryPathValue);
+    OutGridDumpValue.StartLocations.clear();
+    std::string StartLocationsTextValue;
+    if (ReadTextFile(PrefixValue + "start_locations.txt", StartLocationsTextValue))
+    {
+        std::istringstream StartLocationsStreamValue(StartLocationsTextValue);
+        float XValue = 0.0f;
+        float YValue = 0.0f;
+        while (StartLocationsStreamValue >> XValue >> YValue)
+        {
+            OutGridDumpValue.StartLocations.emplace_back(XValue, YValue);
+        }
+    }
+    return true;
+}
+
+FGeneratedMapLayout FMapGridLayoutAnalyzer::Analyze(const FMapGridDump& GridDumpValue)
+{
+    FGeneratedMapLayout GeneratedMapLayoutValue;
+    GeneratedMapLayoutValue.MapName = GridDumpValue.MapName;
+
+    int32_t MinXValue = GridDumpValue.Width;
+    int32_t MinYValue = GridDumpValue.Height;
+    int32_t MaxXValue = -1;
+    int32_t MaxYValue = -1;
+    for (int32_t YValue = 0; YValue < GridDumpValue.Height; ++YValue)
+    {
+        for (int32_t XValue = 0; XValue < GridDumpValue.Width; ++XValue)
+        {
+            if (GridDumpValue.IsPathable(XValue, YValue))
+            {
+                MinXValue = std::min(MinXValue, XValue);
+                MinYValue = std::min(MinYValue, YValue);
+                MaxXValue = std::max(MaxXValue, XValue);
+                MaxYValue = std::max(MaxYValue, YValue);
+            }
+        }
+    }
+    if (MaxXValue < 0)
+    {
+        return GeneratedMapLayoutValue;
+    }
+
+    GeneratedMapLayoutValue.PlayableMin = Point2D(static_cast<float>(MinXValue), static_cast<float>(MinYValue));
+    GeneratedMapLayoutValue.PlayableMax = Point2D(static_cast<float>(MaxXValue + 1), static_cast<float>(MaxYValue + 1));
+    GeneratedMapLayoutValue.MapCenter =
+        (GeneratedMapLayoutValue.PlayableMin + GeneratedMapLayoutValue.PlayableMax) / 2.0f;
+
+    GeneratedMapLayoutValue.Bases = DetectBases(GridDumpValue);
+
+    std::vector<std::vector<float>> DistanceFieldsValue;
+    DistanceFieldsValue.reserve(GeneratedMapLayoutValue.Bases.size());
+    for (const FMapBaseDescriptor& BaseValue : GeneratedMapLayoutValue.Bases)
+    {
+        DistanceFieldsValue.push_back(BuildGroundDistanceField(GridDumpValue, BaseValue.Location));
+    }
+
+    for (size_t FromIndexValue = 0U; FromIndexValue < GeneratedMapLayoutValue.Bases.size(); ++FromIndexValue)
+    {
+        for (size_t ToIndexValue = FromIndexValue + 1U; ToIndexValue < GeneratedMapLayoutValue.Bases.size();
+             ++ToIndexValue)
+        {
+            const float DistanceValue = GetFieldDistance(GridDumpValue, DistanceFieldsValue[FromIndexValue],
+                                                         GeneratedMapLayoutValue.Bases[ToIndexValue].Location);
+            if (DistanceValue == UnreachableDistanceValue)
+            {
+                continue;
+            }
+            GeneratedMapLayoutValue.GroundDistances.push_back(FMapGroundDistanceEntry{
+                static_cast<uint8_t>(FromIndexValue), static_cast<uint8_t>(ToIndexValue), DistanceValue});
+        }
+    }
+
+    GeneratedMapLayoutValue.Ramps = DetectRamps(GridDumpValue, GeneratedMapLayoutValue.Bases, DistanceFieldsValue);
+    return GeneratedMapLayoutValue;
+}
+
+std::string FMapGridLayoutAnalyzer::FormatYamlEntry(const FGeneratedMapLayout& GeneratedMapLayoutValue)
+{
+    const std::function<std::string(const Point2D&)> FormatPointValue = FormatPoint;
+    const std::function<std::string(const Point2DI&)> FormatTileValue = [](const Point2DI& TileValue)
+    { return "[" + std::to_string(TileValue.x) + ", " + std::to_string(TileValue.y) + "]"; };
+
+    std::ostringstream YamlStreamValue;
+    const std::string NormalizedNameValue = FMapLayoutDictionary::NormalizeMapName(GeneratedMapLayoutValue.MapName);
+    const std::string MapIdentifierValue = GetMapIdentifier(GeneratedMapLayoutValue.MapName);
+    YamlStreamValue << "  - MapId: " << MapIdentifierValue << "\n";
+    YamlStreamValue << "    NormalizedNames:\n";
+    YamlStreamValue << "      - " << FMapLayoutDictionary::NormalizeMapName(MapIdentifierValue) << "\n";
+    if (NormalizedNameValue != FMapLayoutDictionary::NormalizeMapName(MapIdentifierValue))
+    {
+        YamlStreamValue << "      - " << NormalizedNameValue << "\n";
+    }
+    YamlStreamValue << "    PlayableBounds:\n";
+    YamlStreamValue << "      Min: " << FormatBound(GeneratedMapLayoutValue.PlayableMin) << "\n";
+    YamlStreamValue << "      Max: " << FormatBound(GeneratedMapLayoutValue.PlayableMax) << "\n";
+    YamlStreamValue << "    MapCenter: " << FormatBound(GeneratedMapLayoutValue.MapCenter) << "\n\n";
+
+    YamlStreamValue << "    Bases:" << (GeneratedMapLayoutValue.Bases.empty() ? " []\n" : "\n");
+    for (const FMapBaseDescriptor& BaseValue : GeneratedMapLayoutValue.Bases)
+    {
+        YamlStreamValue << "      - BaseIndex: " << static_cast<uint32_t>(BaseValue.BaseIndex) << "\n";
+        YamlStreamValue << "        Location: " << FormatPoint(BaseValue.Location) << "\n";
+        YamlStreamValue << "        IsStartLocation: " << (BaseValue.bIsStartLocation ? "true" : "false") << "\n";
+        AppendPointList(YamlStreamValue, "MineralPatches", BaseValue.MineralPatchPositions,
+                        BaseValue.MineralPatchCount, FormatPointValue);
+        AppendPointList(YamlStreamValue, "Geysers", BaseValue.GeyserPositions, BaseValue.GeyserCount,
+                        FormatPointValue);
+        YamlStreamValue << "\n";
+    }
+
+    YamlStreamValue << "    Ramps:" << (GeneratedMapLayoutValue.Ramps.empty() ? " []\n" : "\n");
+    for (const FMapRampDescriptor& RampValue : GeneratedMapLayoutValue.Ramps)
+    {
+        YamlStreamValue << "      - RampIndex: " << static_cast<uint32_t>(RampValue.RampIndex) << "\n";
+        AppendPointList(YamlStreamValue, "TopTiles", RampValue.TopTiles, RampValue.TopTileCount, FormatTileValue);
+        AppendPointList(YamlStreamValue, "BottomTiles", RampValue.BottomTiles, RampValue.BottomTileCount,
+                        FormatTileValue);
+        YamlStreamValue << "        TopCenter: " << FormatPoint(RampValue.TopCenter) << "\n";
+        YamlStreamValue << "        BottomCenter: " << FormatPoint(RampValue.BottomCenter) << "\n";
+        YamlStreamValue << "        Orientation: " << GetOrientationName(RampValue.Orientation) << "\n";
+        YamlStreamValue << "        Width: " << static_cast<uint32_t>(RampValue.Width) << "\n";
+        YamlStreamValue << "        ConnectsBaseIndices: [" << static_cast<uint32_t>(RampValue.ConnectedBaseIndexA)
+                        << ", " << static_cast<uint32_t>(RampValue.ConnectedBaseIndexB) << "]\n\n";
+    }
+
+    YamlStreamValue << "    Watchtowers: []\n\n";
+    YamlStreamValue << "    DestructibleRocks: []\n\n";
+    YamlStreamValue << "    GroundDistances:" << (GeneratedMapLayoutValue.GroundDistances.empty() ? " []\n" : "\n");
+    for (const FMapGroundDistanceEntry& GroundDistanceValue : GeneratedMapLayoutValue.GroundDistances)
+    {
+        char BufferValue[64];
+        std::snprintf(BufferValue, sizeof(BufferValue), "      - [%u, %u, %.1f]\n",
+                      static_cast<uint32_t>(GroundDistanceValue.FromBaseIndex),
+                      static_cast<uint32_t>(GroundDistanceValue.ToBaseIndex), GroundDistanceValue.Distance);
+        YamlStreamValue << BufferValue;
+    }
+
+    YamlStreamValue << "\n    # Spawn layouts (ramp walls, production columns, natural walls) are authored by hand.\n";
+    YamlStreamValue << "    Spawns: []\n";
+    return YamlStreamValue.str();
+}
+
+}  // namespace sc2
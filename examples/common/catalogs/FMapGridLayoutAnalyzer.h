@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/catalogs/FMapLayoutTypes.h"
+#include "sc2api/sc2_common.h"
+
+namespace sc2
+{
+
+// Terrain grids of one map as written by PathingGrid::Dump, PlacementGrid::Dump and HeightMap::Dump at game start.
+// Cells are indexed x + y * Width with y pointing north, matching the game's grids.
+struct FMapGridDump
+{
+public:
+    bool IsInside(int32_t XValue, int32_t YValue) const;
+    bool IsPathable(int32_t XValue, int32_t YValue) const;
+    bool IsPlaceable(int32_t XValue, int32_t YValue) const;
+    float GetTerrainHeight(int32_t XValue, int32_t YValue) const;
+
+public:
+    std::string MapName;
+    int32_t Width = 0;
+    int32_t Height = 0;
+    std::vector<uint8_t> PathableCells;
+    std::vector<uint8_t> PlaceableCells;
+    std::vector<float> TerrainHeights;
+    std::vector<Point2D> StartLocations;
+};
+
+// Map layout derived from grid dumps, in the shape of the authored FMapDescriptor entries. Spawn layouts, watchtowers
+// and rocks cannot be read from the terrain grids and remain authored.
+struct FGeneratedMapLayout
+{
+public:
+    std::string MapName;
+    Point2D PlayableMin;
+    Point2D PlayableMax;
+    Point2D MapCenter;
+    std::vector<FMapBaseDescriptor> Bases;
+    std::vector<FMapRampDescriptor> Ramps;
+    std::vector<FMapGroundDistanceEntry> GroundDistances;
+};
+
+// Offline analysis of dumped terrain grids. Resources are found as cells that are placeable but not pathable, which
+// holds for the start-of-game pathing grid where mineral fields and geysers are already stamped as blocked. Ramps are
+// pathable, unplaceable components spanning a height change. Ground distances are exact octile shortest paths over
+// the pathing grid with no corner cutting.
+struct FMapGridLayoutAnalyzer
+{
+public:
+    // Parses the three dump files into a grid dump. Returns false and fills OutErrorValue when a file is missing or
+    // the grids disagree on size.
+    static bool ParseGridDump(const std::string& PathingTextValue, const std::string& PlacementTextValue,
+                              const std::string& HeightTextValue, FMapGridDump& OutGridDumpValue,
+                              std::string& OutErrorValue);
+
+    // Reads pathing.txt, placement.txt, height.txt and the optional start_locations.txt ("x y" per line) from a map
+    // dump directory. The directory name becomes the map name.
+    static bool LoadGridDumpDirectory(const std::string& DirectoryPathValue, FMapGridDump& OutGridDumpValue,
+                                      std::string& OutErrorValue);
+
+    static FGeneratedMapLayout Analyze(const FMapGridDump& GridDumpValue);
+
+    // Formats one map entry in the MapLayoutDictionary.yaml schema, indented for the Maps list.
+    static std::string FormatYamlEntry(const FGeneratedMapLayout& GeneratedMapLayoutValue);
+};
+
+}  // namespace sc2
@@ -0,0 +1,23 @@
+#include "common/containers/EFlatHashSlotState.h"
+
+namespace sc2
+{
+
+const char* ToString(const EFlatHashSlotState FlatHashSlotStateValue)
+{
+    switch (FlatHashSlotStateValue)
+    {
+        case EFlatHashSlotState::Empty:
+            return "Empty";
+        case EFlatHashSlotState::Occupied:
+            return "Occupied";
+        case EFlatHashSlotState::Tombstone:
+            return "Tombstone";
+        case EFlatHashSlotState::Relocating:
+            return "Relocating";
+        default:
+            return "Unknown";
+    }
+}
+
+}  // namespace sc2
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sc2
+{
+
+enum class EFlatHashSlotState : uint8_t
+{
+    Empty,
+    Occupied,
+    Tombstone,
+    Relocating,
+};
+
+const char* ToString(EFlatHashSlotState FlatHashSlotStateValue);
+
+}  // namespace sc2
@@ -0,0 +1,445 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "common/containers/EFlatHashSlotState.h"
+
+namespace sc2
+{
+
+// Open-addressing hash map with linear probing and tombstone deletion.
+// Slot states, keys and values are stored as parallel arrays. Clear() and Reserve() never release
+// storage, so a table that is cleared and refilled every step reaches a steady state with no allocations.
+template <typename TKeyType, typename TValueType, typename THashType = std::hash<TKeyType>,
+          typename TKeyEqualType = std::equal_to<TKeyType>>
+class FFlatHashMap
+{
+public:
+    FFlatHashMap();
+
+    void Clear();
+    void Reserve(size_t ElementCountValue);
+    void RehashInPlace();
+    size_t GetCount() const;
+    size_t GetCapacity() const;
+    size_t GetTombstoneCount() const;
+    size_t GetRetainedBytes() const;
+    bool IsEmpty() const;
+    bool Contains(const TKeyType& KeyValue) const;
+    bool TryGetValue(const TKeyType& KeyValue, TValueType& OutValue) const;
+    const TValueType* FindValue(const TKeyType& KeyValue) const;
+    TValueType* FindValue(const TKeyType& KeyValue);
+    bool TryAdd(const TKeyType& KeyValue, const TValueType& ValueValue);
+    void Set(const TKeyType& KeyValue, const TValueType& ValueValue);
+    TValueType& FindOrAdd(const TKeyType& KeyValue);
+    bool Remove(const TKeyType& KeyValue);
+
+    template <typename TFunctorType>
+    void ForEach(TFunctorType&& FunctorValue) const;
+
+private:
+    static constexpr size_t MinimumCapacityValue = 16U;
+
+    static size_t GetRequiredCapacity(size_t ElementCountValue);
+    size_t GetIdealSlotIndex(const TKeyType& KeyValue) const;
+    bool TryFindSlotIndex(const TKeyType& KeyValue, size_t& OutSlotIndexValue) const;
+    size_t FindOrAddSlotIndex(const TKeyType& KeyValue, bool& bOutAddedValue);
+    size_t FindInsertionSlotIndex(const TKeyType& KeyValue) const;
+    void PrepareForInsertion();
+    void Grow(size_t CapacityValue);
+
+private:
+    std::vector<EFlatHashSlotState> SlotStates;
+    std::vector<TKeyType> SlotKeys;
+    std::vector<TValueType> SlotValues;
+    size_t OccupiedCount;
+    size_t TombstoneCount;
+    size_t CapacityMask;
+};
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::FFlatHashMap()
+    : OccupiedCount(0U),
+      TombstoneCount(0U),
+      CapacityMask(0U)
+{
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+void FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::Clear()
+{
+    if (OccupiedCount == 0U && TombstoneCount == 0U)
+    {
+        return;
+    }
+
+    std::fill(SlotStates.begin(), SlotStates.end(), EFlatHashSlotState::Empty);
+    OccupiedCount = 0U;
+    TombstoneCount = 0U;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+void FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::Reserve(const size_t ElementCountValue)
+{
+    const size_t RequiredCapacityValue = GetRequiredCapacity(ElementCountValue);
+    if (RequiredCapacityValue <= SlotStates.size())
+    {
+        return;
+    }
+
+    Grow(RequiredCapacityValue);
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+void FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::RehashInPlace()
+{
+    if (TombstoneCount == 0U)
+    {
+        return;
+    }
+
+    const size_t CapacityValue = SlotStates.size();
+    for (size_t SlotIndexValue = 0U; SlotIndexValue < CapacityValue; ++SlotIndexValue)
+    {
+        switch (SlotStates[SlotIndexValue])
+        {
+            case EFlatHashSlotState::Occupied:
+                SlotStates[SlotIndexValue] = EFlatHashSlotState::Relocating;
+                break;
+            case EFlatHashSlotState::Tombstone:
+                SlotStates[SlotIndexValue] = EFlatHashSlotState::Empty;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Every finalized slot keeps an unbroken run of occupied slots back to its ideal index, so lookups that
+    // stop at the first empty slot stay correct while relocating entries are swapped into place.
+    for (size_t SlotIndexValue = 0U; SlotIndexValue < CapacityValue; ++SlotIndexValue)
+    {
+        while (SlotStates[SlotIndexValue] == EFlatHashSlotState::Relocating)
+        {
+            size_t TargetSlotIndexValue = GetIdealSlotIndex(SlotKeys[SlotIndexValue]);
+            while (SlotStates[TargetSlotIndexValue] == EFlatHashSlotState::Occupied)
+            {
+                TargetSlotIndexValue = (TargetSlotIndexValue + 1U) & CapacityMask;
+            }
+
+            if (TargetSlotIndexValue == SlotIndexValue)
+            {
+                SlotStates[SlotIndexValue] = EFlatHashSlotState::Occupied;
+                break;
+            }
+
+            if (SlotStates[TargetSlotIndexValue] == EFlatHashSlotState::Empty)
+            {
+                SlotKeys[TargetSlotIndexValue] = std::move(SlotKeys[SlotIndexValue]);
+                SlotValues[TargetSlotIndexValue] = std::move(SlotValues[SlotIndexValue]);
+                SlotStates[TargetSlotIndexValue] = EFlatHashSlotState::Occupied;
+                SlotStates[SlotIndexValue] = EFlatHashSlotState::Empty;
+                break;
+            }
+
+            std::swap(SlotKeys[TargetSlotIndexValue], SlotKeys[SlotIndexValue]);
+            std::swap(SlotValues[TargetSlotIndexValue], SlotValues[SlotIndexValue]);
+            SlotStates[TargetSlotIndexValue] = EFlatHashSlotState::Occupied;
+        }
+    }
+
+    TombstoneCount = 0U;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+size_t FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::GetCount() const
+{
+    return OccupiedCount;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+size_t FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::GetCapacity() const
+{
+    return SlotStates.size();
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+size_t FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::GetTombstoneCount() const
+{
+    return TombstoneCount;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+size_t FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::GetRetainedBytes() const
+{
+    return sizeof(FFlatHashMap) + (SlotStates.capacity() * sizeof(EFlatHashSlotState)) +
+           (SlotKeys.capacity() * sizeof(TKeyType)) + (SlotValues.capacity() * sizeof(TValueType));
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+bool FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::IsEmpty() const
+{
+    return OccupiedCount == 0U;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+bool FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::Contains(const TKeyType& KeyValue) const
+{
+    size_t SlotIndexValue = 0U;
+    return TryFindSlotIndex(KeyValue, SlotIndexValue);
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+bool FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::TryGetValue(const TKeyType& KeyValue,
+                                                                                TValueType& OutValue) const
+{
+    size_t SlotIndexValue = 0U;
+    if (!TryFindSlotIndex(KeyValue, SlotIndexValue))
+    {
+        return false;
+    }
+
+    OutValue = SlotValues[SlotIndexValue];
+    return true;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+const TValueType* FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::FindValue(
+    const TKeyType& KeyValue) const
+{
+    size_t SlotIndexValue = 0U;
+    if (!TryFindSlotIndex(KeyValue, SlotIndexValue))
+    {
+        return nullptr;
+    }
+
+    return &SlotValues[SlotIndexValue];
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+TValueType* FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::FindValue(const TKeyType& KeyValue)
+{
+    size_t SlotIndexValue = 0U;
+    if (!TryFindSlotIndex(KeyValue, SlotIndexValue))
+    {
+        return nullptr;
+    }
+
+    return &SlotValues[SlotIndexValue];
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+bool FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::TryAdd(const TKeyType& KeyValue,
+                                                                           const TValueType& ValueValue)
+{
+    bool bAddedValue = false;
+    const size_t SlotIndexValue = FindOrAddSlotIndex(KeyValue, bAddedValue);
+    if (bAddedValue)
+    {
+        SlotValues[SlotIndexValue] = ValueValue;
+    }
+
+    return bAddedValue;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+void FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::Set(const TKeyType& KeyValue,
+                                                                        const TValueType& ValueValue)
+{
+    bool bAddedValue = false;
+    const size_t SlotIndexValue = FindOrAddSlotIndex(KeyValue, bAddedValue);
+    SlotValues[SlotIndexValue] = ValueValue;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+TValueType& FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::FindOrAdd(const TKeyType& KeyValue)
+{
+    bool bAddedValue = false;
+    const size_t SlotIndexValue = FindOrAddSlotIndex(KeyValue, bAddedValue);
+    if (bAddedValue)
+    {
+        SlotValues[SlotIndexValue] = TValueType();
+    }
+
+    return SlotValues[SlotIndexValue];
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+bool FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::Remove(const TKeyType& KeyValue)
+{
+    size_t SlotIndexValue = 0U;
+    if (!TryFindSlotIndex(KeyValue, SlotIndexValue))
+    {
+        return false;
+    }
+
+    // A slot followed by an empty slot ends every probe chain through it, so it can be released outright.
+    if (SlotStates[(SlotIndexValue + 1U) & CapacityMask] == EFlatHashSlotState::Empty)
+    {
+        SlotStates[SlotIndexValue] = EFlatHashSlotState::Empty;
+    }
+    else
+    {
+        SlotStates[SlotIndexValue] = EFlatHashSlotState::Tombstone;
+        ++TombstoneCount;
+    }
+
+    --OccupiedCount;
+    return true;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+template <typename TFunctorType>
+void FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::ForEach(TFunctorType&& FunctorValue) const
+{
+    const size_t CapacityValue = SlotStates.size();
+    for (size_t SlotIndexValue = 0U; SlotIndexValue < CapacityValue; ++SlotIndexValue)
+    {
+        if (SlotStates[SlotIndexValue] != EFlatHashSlotState::Occupied)
+        {
+            continue;
+        }
+
+        FunctorValue(SlotKeys[SlotIndexValue], SlotValues[SlotIndexValue]);
+    }
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+size_t FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::GetRequiredCapacity(
+    const size_t ElementCountValue)
+{
+    // Keep the combined occupied and tombstone load at or below seven eighths of the slot count.
+    const size_t MinimumSlotCountValue = ElementCountValue + (ElementCountValue / 7U) + 1U;
+    size_t CapacityValue = MinimumCapacityValue;
+    while (CapacityValue < MinimumSlotCountValue)
+    {
+        CapacityValue <<= 1U;
+    }
+
+    return CapacityValue;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+size_t FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::GetIdealSlotIndex(const TKeyType& KeyValue) const
+{
+    // Identity hashes such as std::hash<uint32_t> leave sequential ids clustered in the low bits, so mix before masking.
+    uint64_t MixedHashValue = static_cast<uint64_t>(THashType{}(KeyValue)) * 0x9E3779B97F4A7C15ULL;
+    MixedHashValue ^= MixedHashValue >> 32U;
+    return static_cast<size_t>(MixedHashValue) & CapacityMask;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+bool FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::TryFindSlotIndex(const TKeyType& KeyValue,
+                                                                                     size_t& OutSlotIndexValue) const
+{
+    if (OccupiedCount == 0U)
+    {
+        return false;
+    }
+
+    size_t SlotIndexValue = GetIdealSlotIndex(KeyValue);
+    while (SlotStates[SlotIndexValue] != EFlatHashSlotState::Empty)
+    {
+        if (SlotStates[SlotIndexValue] == EFlatHashSlotState::Occupied &&
+            TKeyEqualType{}(SlotKeys[SlotIndexValue], KeyValue))
+        {
+            OutSlotIndexValue = SlotIndexValue;
+            return true;
+        }
+
+        SlotIndexValue = (SlotIndexValue + 1U) & CapacityMask;
+    }
+
+    return false;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+size_t FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::FindOrAddSlotIndex(const TKeyType& KeyValue,
+                                                                                        bool& bOutAddedValue)
+{
+    size_t SlotIndexValue = 0U;
+    if (TryFindSlotIndex(KeyValue, SlotIndexValue))
+    {
+        bOutAddedValue = false;
+        return SlotIndexValue;
+    }
+
+    PrepareForInsertion();
+    SlotIndexValue = FindInsertionSlotIndex(KeyValue);
+    if (SlotStates[SlotIndexValue] == EFlatHashSlotState::Tombstone)
+    {
+        --TombstoneCount;
+    }
+
+    SlotStates[SlotIndexValue] = EFlatHashSlotState::Occupied;
+    SlotKeys[SlotIndexValue] = KeyValue;
+    ++OccupiedCount;
+    bOutAddedValue = true;
+    return SlotIndexValue;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+size_t FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::FindInsertionSlotIndex(
+    const TKeyType& KeyValue) const
+{
+    size_t SlotIndexValue = GetIdealSlotIndex(KeyValue);
+    while (SlotStates[SlotIndexValue] == EFlatHashSlotState::Occupied)
+    {
+        SlotIndexValue = (SlotIndexValue + 1U) & CapacityMask;
+    }
+
+    return SlotIndexValue;
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+void FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::PrepareForInsertion()
+{
+    const size_t CapacityValue = SlotStates.size();
+    const size_t MaximumLoadValue = CapacityValue - (CapacityValue / 8U);
+    if (CapacityValue != 0U && (OccupiedCount + TombstoneCount + 1U) <= MaximumLoadValue)
+    {
+        return;
+    }
+
+    if (CapacityValue != 0U && (OccupiedCount + 1U) <= (MaximumLoadValue / 2U))
+    {
+        RehashInPlace();
+        return;
+    }
+
+    Grow(GetRequiredCapacity(std::max<size_t>(OccupiedCount + 1U, CapacityValue)));
+}
+
+template <typename TKeyType, typename TValueType, typename THashType, typename TKeyEqualType>
+void FFlatHashMap<TKeyType, TValueType, THashType, TKeyEqualType>::Grow(const size_t CapacityValue)
+{
+    std::vector<EFlatHashSlotState> PreviousSlotStates(CapacityValue, EFlatHashSlotState::Empty);
+    std::vector<TKeyType> PreviousSlotKeys(CapacityValue);
+    std::vector<TValueType> PreviousSlotValues(CapacityValue);
+    PreviousSlotStates.swap(SlotStates);
+    PreviousSlotKeys.swap(SlotKeys);
+    PreviousSlotValues.swap(SlotValues);
+    CapacityMask = CapacityValue - 1U;
+    TombstoneCount = 0U;
+
+    const size_t PreviousCapacityValue = PreviousSlotStates.size();
+    for (size_t PreviousSlotIndexValue = 0U; PreviousSlotIndexValue < PreviousCapacityValue;
+         ++PreviousSlotIndexValue)
+    {
+        if (PreviousSlotStates[PreviousSlotIndexValue] != EFlatHashSlotState::Occupied)
+        {
+            continue;
+        }
+
+        const size_t SlotIndexValue = FindInsertionSlotIndex(PreviousSlotKeys[PreviousSlotIndexValue]);
+        SlotStates[SlotIndexValue] = EFlatHashSlotState::Occupied;
+        SlotKeys[SlotIndexValue] = std::move(PreviousSlotKeys[PreviousSlotIndexValue]);
+        SlotValues[SlotIndexValue] = std::move(PreviousSlotValues[PreviousSlotIndexValue]);
+    }
+}
+
+}  // namespace sc2
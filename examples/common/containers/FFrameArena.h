@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sc2
+{
+
+// Offset and count of one row's elements inside an FFrameArena. Ranges are plain values, so a container that copies
+// or swap-removes its rows keeps every range valid until the owning arena is reset.
+struct FFrameArenaRange
+{
+    uint32_t Offset = 0U;
+    uint32_t Count = 0U;
+};
+
+// Read-only view over one FFrameArenaRange. Views are only valid until the next append to or reset of the arena.
+template <typename TValueType>
+class FFrameArenaView
+{
+public:
+    FFrameArenaView();
+    FFrameArenaView(const TValueType* BeginPtrValue, size_t CountValue);
+
+    const TValueType* begin() const;
+    const TValueType* end() const;
+    size_t size() const;
+    bool empty() const;
+    const TValueType& operator[](size_t IndexValue) const;
+
+private:
+    const TValueType* BeginPtr;
+    size_t Count;
+};
+
+// Append-only storage for variable-length per-row data that is rebuilt every step.
+// Reset() never releases storage, so an arena that is refilled every step stops allocating once it reaches its
+// high-water mark.
+template <typename TValueType>
+class FFrameArena
+{
+public:
+    void Reset();
+    void Reserve(size_t ElementCountValue);
+    FFrameArenaRange Append(const std::vector<TValueType>& SourceValues);
+    FFrameArenaView<TValueType> GetView(const FFrameArenaRange& RangeValue) const;
+    size_t GetCount() const;
+    size_t GetCapacity() const;
+
+private:
+    std::vector<TValueType> Values;
+};
+
+template <typename TValueType>
+FFrameArenaView<TValueType>::FFrameArenaView() : BeginPtr(nullptr), Count(0U)
+{
+}
+
+template <typename TValueType>
+FFrameArenaView<TValueType>::FFrameArenaView(const TValueType* BeginPtrValue, size_t CountValue)
+    : BeginPtr(BeginPtrValue), Count(CountValue)
+{
+}
+
+template <typename TValueType>
+const TValueType* FFrameArenaView<TValueType>::begin() const
+{
+    return BeginPtr;
+}
+
+template <typename TValueType>
+const TValueType* FFrameArenaView<TValueType>::end() const
+{
+    return BeginPtr + Count;
+}
+
+template <typename TValueType>
+size_t FFrameArenaView<TValueType>::size() const
+{
+    return Count;
+}
+
+template <typename TValueType>
+bool FFrameArenaView<TValueType>::empty() const
+{
+    return Count == 0U;
+}
+
+template <typename TValueType>
+const TValueType& FFrameArenaView<TValueType>::operator[](size_t IndexValue) const
+{
+    return BeginPtr[IndexValue];
+}
+
+template <typename TValueType>
+void FFrameArena<TValueType>::Reset()
+{
+    Values.clear();
+}
+
+template <typename TValueType>
+void FFrameArena<TValueType>::Reserve(size_t ElementCountValue)
+{
+    Values.reserve(ElementCountValue);
+}
+
+template <typename TValueType>
+FFrameArenaRange FFrameArena<TValueType>::Append(const std::vector<TValueType>& SourceValues)
+{
+    FFrameArenaRange RangeValue;
+    RangeValue.Offset = static_cast<uint32_t>(Values.size());
+    RangeValue.Count = static_cast<uint32_t>(SourceValues.size());
+    if (!SourceValues.empty())
+    {
+        Values.insert(Values.end(), SourceValues.begin(), SourceValues.end());
+    }
+    return RangeValue;
+}
+
+template <typename TValueType>
+FFrameArenaView<TValueType> FFrameArena<TValueType>::GetView(const FFrameArenaRange& RangeValue) const
+{
+    if (RangeValue.Count == 0U || static_cast<size_t>(RangeValue.Offset) + RangeValue.Count > Values.size())
+    {
+        return FFrameArenaView<TValueType>();
+    }
+    return FFrameArenaView<TValueType>(Values.data() + RangeValue.Offset, RangeValue.Count);
+}
+
+template <typename TValueType>
+size_t FFrameArena<TValueType>::GetCount() const
+{
+    return Values.size();
+}
+
+template <typename TValueType>
+size_t FFrameArena<TValueType>::GetCapacity() const
+{
+    return Values.capacity();
+}
+
+}  // namespace sc2
@@ -1,5 +1,6 @@
 #include "common/descriptors/FEnemyObservationDescriptor.h"
 
+#include <algorithm>
 #include <string>
 
 #include "common/logging.h"
@@ -107,8 +108,12 @@ void FEnemyObservationDescriptor::Reset()
     IsStructure.clear();
     FirstSeenGameLoops.clear();
     LastSeenGameLoops.clear();
-    TagToIndexMap.clear();
+    TagToIndexMap.Clear();
+    LastSeenHeap.clear();
     CompositionSummary.Reset();
+    CombatPositionSumX = 0.0;
+    CombatPositionSumY = 0.0;
+    CombatPositionCount = 0U;
     LastFullObservationGameLoop = 0U;
     CurrentGameLoop = 0U;
 }
@@ -121,7 +126,7 @@ bool FEnemyObservationDescriptor::HasSynchronizedSizes() const
            LastSeenShield.size() == ExpectedSizeValue && LastSeenShieldMax.size() == ExpectedSizeValue &&
            IsFlying.size() == ExpectedSizeValue && IsStructure.size() == ExpectedSizeValue &&
            FirstSeenGameLoops.size() == ExpectedSizeValue && LastSeenGameLoops.size() == ExpectedSizeValue &&
-           TagToIndexMap.size() == ExpectedSizeValue;
+           TagToIndexMap.GetCount() == ExpectedSizeValue && LastSeenHeap.size() == ExpectedSizeValue;
 }
 
 size_t FEnemyObservationDescriptor::GetObservedUnitCount() const
@@ -131,44 +136,143 @@ size_t FEnemyObservationDescriptor::GetObservedUnitCount() const
 
 void FEnemyObservationDescriptor::AddOrUpdateUnit(const Unit& EnemyUnitValue, const uint64_t CurrentGameLoopValue)
 {
-    const std::unordered_map<Tag, size_t>::const_iterator FoundIterator = TagToIndexMap.find(EnemyUnitValue.tag);
-    if (FoundIterator != TagToIndexMap.end())
+    const UNIT_TYPEID UnitTypeIdValue = EnemyUnitValue.unit_type.ToType();
+    const Point2D PositionValue(EnemyUnitValue.pos);
+    const uint8_t IsFlyingValue = EnemyUnitValue.is_flying ? 1U : 0U;
+    const uint8_t IsStructureValue = EnemyUnitValue.is_building ? 1U : 0U;
+
+    const size_t* ExistingIndexPtrValue = TagToIndexMap.FindValue(EnemyUnitValue.tag);
+    if (ExistingIndexPtrValue != nullptr)
     {
-        const size_t ExistingIndexValue = FoundIterator->second;
-        UnitTypeIds[ExistingIndexValue] = EnemyUnitValue.unit_type.ToType();
-        LastSeenPositions[ExistingIndexValue] = Point2D(EnemyUnitValue.pos);
+        const size_t ExistingIndexValue = *ExistingIndexPtrValue;
+        LastSeenGameLoops[ExistingIndexValue] = CurrentGameLoopValue;
+        if (EnemyUnitValue.display_type == Unit::DisplayType::Snapshot)
+        {
+            return;
+        }
+
+        const bool bCompositionChangedValue = UnitTypeIds[ExistingIndexValue] != UnitTypeIdValue ||
+                                              LastSeenPositions[ExistingIndexValue] != PositionValue ||
+                                              IsFlying[ExistingIndexValue] != IsFlyingValue ||
+                                              IsStructure[ExistingIndexValue] != IsStructureValue;
+        if (bCompositionChangedValue)
+        {
+            ApplyCompositionContribution(ExistingIndexValue, false);
+        }
+
+        UnitTypeIds[ExistingIndexValue] = UnitTypeIdValue;
+        LastSeenPositions[ExistingIndexValue] = PositionValue;
         LastSeenHealth[ExistingIndexValue] = EnemyUnitValue.health;
         LastSeenHealthMax[ExistingIndexValue] = EnemyUnitValue.health_max;
         LastSeenShield[ExistingIndexValue] = EnemyUnitValue.shield;
         LastSeenShieldMax[ExistingIndexValue] = EnemyUnitValue.shield_max;
-        IsFlying[ExistingIndexValue] = EnemyUnitValue.is_flying ? 1U : 0U;
-        IsStructure[ExistingIndexValue] = EnemyUnitValue.is_building ? 1U : 0U;
-        LastSeenGameLoops[ExistingIndexValue] = CurrentGameLoopValue;
+        IsFlying[ExistingIndexValue] = IsFlyingValue;
+        IsStructure[ExistingIndexValue] = IsStructureValue;
+
+        if (bCompositionChangedValue)
+        {
+            ApplyCompositionContribution(ExistingIndexValue, true);
+            RefreshArmyCentroid();
+        }
         return;
     }
 
     const size_t NewIndexValue = UnitTags.size();
     UnitTags.push_back(EnemyUnitValue.tag);
-    UnitTypeIds.push_back(EnemyUnitValue.unit_type.ToType());
-    LastSeenPositions.push_back(Point2D(EnemyUnitValue.pos));
+    UnitTypeIds.push_back(UnitTypeIdValue);
+    LastSeenPositions.push_back(PositionValue);
     LastSeenHealth.push_back(EnemyUnitValue.health);
     LastSeenHealthMax.push_back(EnemyUnitValue.health_max);
     LastSeenShield.push_back(EnemyUnitValue.shield);
     LastSeenShieldMax.push_back(EnemyUnitValue.shield_max);
-    IsFlying.push_back(EnemyUnitValue.is_flying ? 1U : 0U);
-    IsStructure.push_back(EnemyUnitValue.is_building ? 1U : 0U);
+    IsFlying.push_back(IsFlyingValue);
+    IsStructure.push_back(IsStructureValue);
     FirstSeenGameLoops.push_back(CurrentGameLoopValue);
     LastSeenGameLoops.push_back(CurrentGameLoopValue);
-    TagToIndexMap[EnemyUnitValue.tag] = NewIndexValue;
+    TagToIndexMap.Set(EnemyUnitValue.tag, NewIndexValue);
+    PushLastSeenEntry(CurrentGameLoopValue, EnemyUnitValue.tag);
+    ApplyCompositionContribution(NewIndexValue, true);
+    RefreshArmyCentroid();
+}
+
+bool FEnemyObservationDescriptor::IsLaterLastSeenEntry(const FLastSeenHeapEntry& LeftEntryValue,
+                                                       const FLastSeenHeapEntry& RightEntryValue)
+{
+    return LeftEntryValue.LastSeenGameLoop > RightEntryValue.LastSeenGameLoop;
+}
+
+void FEnemyObservationDescriptor::PushLastSeenEntry(const uint64_t LastSeenGameLoopValue, const Tag UnitTagValue)
+{
+    FLastSeenHeapEntry LastSeenHeapEntryValue;
+    LastSeenHeapEntryValue.LastSeenGameLoop = LastSeenGameLoopValue;
+    LastSeenHeapEntryValue.UnitTag = UnitTagValue;
+    LastSeenHeap.push_back(LastSeenHeapEntryValue);
+    std::push_heap(LastSeenHeap.begin(), LastSeenHeap.end(), IsLaterLastSeenEntry);
+}
+
+void FEnemyObservationDescriptor::ApplyCompositionContribution(const size_t IndexValue, const bool bAddValue)
+{
+    const auto AdjustCount = [bAddValue](uint32_t& CountValue)
+    {
+        if (bAddValue)
+        {
+            ++CountValue;
+        }
+        else
+        {
+            --CountValue;
+        }
+    };
+
+    AdjustCount(CompositionSummary.TotalUnitCount);
+    if (IsStructure[IndexValue] != 0U)
+    {
+        AdjustCount(CompositionSummary.StructureCount);
+        return;
+    }
+
+    const UNIT_TYPEID UnitTypeIdValue = UnitTypeIds[IndexValue];
+    if (IsEnemyWorkerUnitType(UnitTypeIdValue))
+    {
+        AdjustCount(CompositionSummary.WorkerCount);
+        return;
+    }
+
+    const float SignValue = bAddValue ? 1.0f : -1.0f;
+    AdjustCount(CompositionSummary.CombatUnitCount);
+    CompositionSummary.EstimatedArmySupply += SignValue * EstimateUnitSupplyCost(UnitTypeIdValue);
+    AdjustCount(IsFlying[IndexValue] != 0U ? CompositionSummary.AirUnitCount : CompositionSummary.GroundUnitCount);
+
+    CombatPositionSumX += static_cast<double>(SignValue) * static_cast<double>(LastSeenPositions[IndexValue].x);
+    CombatPositionSumY += static_cast<double>(SignValue) * static_cast<double>(LastSeenPositions[IndexValue].y);
+    AdjustCount(CombatPositionCount);
+}
+
+void FEnemyObservationDescriptor::RefreshArmyCentroid()
+{
+    if (CombatPositionCount == 0U)
+    {
+        CompositionSummary.ArmyCentroid = Point2D(0.0f, 0.0f);
+        CompositionSummary.HasArmyCentroid = false;
+        return;
+    }
+
+    const double CombatPositionCountValue = static_cast<double>(CombatPositionCount);
+    CompositionSummary.ArmyCentroid = Point2D(static_cast<float>(CombatPositionSumX / CombatPositionCountValue),
+                                              static_cast<float>(CombatPositionSumY / CombatPositionCountValue));
+    CompositionSummary.HasArmyCentroid = true;
 }
 
 void FEnemyObservationDescriptor::RemoveAtIndex(const size_t IndexValue)
 {
+    ApplyCompositionContribution(IndexValue, false);
+
     const size_t LastIndexValue = UnitTags.size() - 1U;
+    const Tag RemovedTagValue = UnitTags[IndexValue];
 
     if (IndexValue != LastIndexValue)
     {
-        TagToIndexMap[UnitTags[LastIndexValue]] = IndexValue;
+        TagToIndexMap.Set(UnitTags[LastIndexValue], IndexValue);
         UnitTags[IndexValue] = UnitTags[LastIndexValue];
         UnitTypeIds[IndexValue] = UnitTypeIds[LastIndexValue];
         LastSeenPositions[IndexValue] = LastSeenPositions[LastIndexValue];
@@ -182,7 +286,7 @@ void FEnemyObservationDescriptor::RemoveAtIndex(const size_t IndexValue)
         LastSeenGameLoops[IndexValue] = LastSeenGameLoops[LastIndexValue];
     }
 
-    TagToIndexMap.erase(UnitTags[LastIndexValue]);
+    TagToIndexMap.Remove(RemovedTagValue);
     UnitTags.pop_back();
     UnitTypeIds.pop_back();
     LastSeenPositions.pop_back();
@@ -199,17 +303,34 @@ void FEnemyObservationDescriptor::RemoveAtIndex(const size_t IndexValue)
 void FEnemyObservationDescriptor::PruneStaleEntries(const uint64_t CurrentGameLoopValue,
                                                      const uint64_t MaxStaleGameLoopsValue)
 {
-    size_t EntryIndexValue = 0U;
-    while (EntryIndexValue < UnitTags.size())
+    bool bRemovedEntryValue = false;
+    while (!LastSeenHeap.empty() &&
+           LastSeenHeap.front().LastSeenGameLoop + MaxStaleGameLoopsValue < CurrentGameLoopValue)
     {
-        if (LastSeenGameLoops[EntryIndexValue] + MaxStaleGameLoopsValue < CurrentGameLoopValue)
+        std::pop_heap(LastSeenHeap.begin(), LastSeenHeap.end(), IsLaterLastSeenEntry);
+        const FLastSeenHeapEntry LastSeenHeapEntryValue = LastSeenHeap.back();
+        LastSeenHeap.pop_back();
+
+        const size_t* EntryIndexPtrValue = TagToIndexMap.FindValue(LastSeenHeapEntryValue.UnitTag);
+        if (EntryIndexPtrValue == nullptr)
         {
-            RemoveAtIndex(EntryIndexValue);
+            continue;
         }
-        else
+
+        const size_t EntryIndexValue = *EntryIndexPtrValue;
+        if (LastSeenGameLoops[EntryIndexValue] != LastSeenHeapEntryValue.LastSeenGameLoop)
         {
-            ++EntryIndexValue;
+            PushLastSeenEntry(LastSeenGameLoops[EntryIndexValue], LastSeenHeapEntryValue.UnitTag);
+            continue;
         }
+
+        RemoveAtIndex(EntryIndexValue);
+        bRemovedEntryValue = true;
+    }
+
+    if (bRemovedEntryValue)
+    {
+        RefreshArmyCentroid();
     }
 
     AssertSynchronizedSizes();
@@ -218,55 +339,17 @@ void FEnemyObservationDescriptor::PruneStaleEntries(const uint64_t CurrentGameLo
 void FEnemyObservationDescriptor::RebuildCompositionSummary()
 {
     CompositionSummary.Reset();
-
-    float CentroidSumX = 0.0f;
-    float CentroidSumY = 0.0f;
-    uint32_t CombatPositionCountValue = 0U;
+    CombatPositionSumX = 0.0;
+    CombatPositionSumY = 0.0;
+    CombatPositionCount = 0U;
 
     const size_t UnitCountValue = UnitTags.size();
     for (size_t UnitIndexValue = 0U; UnitIndexValue < UnitCountValue; ++UnitIndexValue)
     {
-        ++CompositionSummary.TotalUnitCount;
-
-        const bool IsStructureValue = IsStructure[UnitIndexValue] != 0U;
-        const bool IsFlyingValue = IsFlying[UnitIndexValue] != 0U;
-        const UNIT_TYPEID UnitTypeIdValue = UnitTypeIds[UnitIndexValue];
-
-        if (IsStructureValue)
-        {
-            ++CompositionSummary.StructureCount;
-            continue;
-        }
-
-        if (IsEnemyWorkerUnitType(UnitTypeIdValue))
-        {
-            ++CompositionSummary.WorkerCount;
-            continue;
-        }
-
-        ++CompositionSummary.CombatUnitCount;
-        CompositionSummary.EstimatedArmySupply += EstimateUnitSupplyCost(UnitTypeIdValue);
-
-        if (IsFlyingValue)
-        {
-            ++CompositionSummary.AirUnitCount;
-        }
-        else
-        {
-            ++CompositionSummary.GroundUnitCount;
-        }
-
-        CentroidSumX += LastSeenPositions[UnitIndexValue].x;
-        CentroidSumY += LastSeenPositions[UnitIndexValue].y;
-        ++CombatPositionCountValue;
+        ApplyCompositionContribution(UnitIndexValue, true);
     }
 
-    if (CombatPositionCountValue > 0U)
-    {
-        CompositionSummary.ArmyCentroid = Point2D(CentroidSumX / static_cast<float>(CombatPositionCountValue),
-                                                   CentroidSumY / static_cast<float>(CombatPositionCountValue));
-        CompositionSummary.HasArmyCentroid = true;
-    }
+    RefreshArmyCentroid();
 }
 
 void FEnemyObservationDescriptor::AssertSynchronizedSizes() const
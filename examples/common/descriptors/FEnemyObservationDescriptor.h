@@ -1,9 +1,9 @@
 #pragma once
 
 #include <cstdint>
-#include <unordered_map>
 #include <vector>
 
+#include "common/containers/FFlatHashMap.h"
 #include "sc2api/sc2_common.h"
 #include "sc2api/sc2_typeenums.h"
 #include "sc2api/sc2_unit.h"
@@ -50,14 +50,40 @@ public:
     void Reset();
     bool HasSynchronizedSizes() const;
     size_t GetObservedUnitCount() const;
+    // Adds or refreshes one unit and applies its change to CompositionSummary. Snapshots of already known units only
+    // refresh the last seen loop.
     void AddOrUpdateUnit(const Unit& EnemyUnitValue, uint64_t CurrentGameLoopValue);
+    // Recomputes CompositionSummary from every entry. AddOrUpdateUnit and PruneStaleEntries keep it current, so this
+    // is only needed after writing the columns directly.
     void RebuildCompositionSummary();
+    // Removes entries not seen for more than MaxStaleGameLoops. Cost scales with the entries that expire, not with
+    // the number of remembered units.
     void PruneStaleEntries(uint64_t CurrentGameLoopValue, uint64_t MaxStaleGameLoopsValue);
 
 private:
-    std::unordered_map<Tag, size_t> TagToIndexMap;
+    struct FLastSeenHeapEntry
+    {
+        uint64_t LastSeenGameLoop{0U};
+        Tag UnitTag{NullTag};
+    };
+
+    static bool IsLaterLastSeenEntry(const FLastSeenHeapEntry& LeftEntryValue,
+                                     const FLastSeenHeapEntry& RightEntryValue);
+    void PushLastSeenEntry(uint64_t LastSeenGameLoopValue, Tag UnitTagValue);
+    void ApplyCompositionContribution(size_t IndexValue, bool bAddValue);
+    void RefreshArmyCentroid();
     void RemoveAtIndex(size_t IndexValue);
     void AssertSynchronizedSizes() const;
+
+    FFlatHashMap<Tag, size_t> TagToIndexMap;
+    // Min-heap on last seen loop holding exactly one entry per unit. Entries are not touched when a unit is seen
+    // again; pruning re-pushes an entry with the unit's current loop when it reaches the top.
+    std::vector<FLastSeenHeapEntry> LastSeenHeap;
+    // Running centroid sums. Map coordinates are floats, so adding and removing them in double is exact and the
+    // sums never drift from a full rebuild.
+    double CombatPositionSumX{0.0};
+    double CombatPositionSumY{0.0};
+    uint32_t CombatPositionCount{0U};
 };
 
 }  // namespace sc2
@@ -10,10 +10,18 @@ void FTerranEnemyObservationBuilder::RebuildEnemyObservation(
     const ObservationInterface& ObservationValue,
     const uint64_t CurrentGameLoopValue,
     FEnemyObservationDescriptor& EnemyObservationDescriptorValue) const
+{
+    UpdateEnemyObservation(ObservationValue.GetUnits(Unit::Alliance::Enemy), CurrentGameLoopValue,
+                           EnemyObservationDescriptorValue);
+}
+
+void FTerranEnemyObservationBuilder::UpdateEnemyObservation(
+    const Units& EnemyUnitsValue,
+    const uint64_t CurrentGameLoopValue,
+    FEnemyObservationDescriptor& EnemyObservationDescriptorValue) const
 {
     EnemyObservationDescriptorValue.CurrentGameLoop = CurrentGameLoopValue;
 
-    const Units EnemyUnitsValue = ObservationValue.GetUnits(Unit::Alliance::Enemy);
     for (const Unit* EnemyUnitValue : EnemyUnitsValue)
     {
         if (EnemyUnitValue == nullptr)
@@ -29,9 +37,9 @@ void FTerranEnemyObservationBuilder::RebuildEnemyObservation(
         EnemyObservationDescriptorValue.LastFullObservationGameLoop = CurrentGameLoopValue;
     }
 
+    // The composition summary is kept current by AddOrUpdateUnit and PruneStaleEntries.
     EnemyObservationDescriptorValue.PruneStaleEntries(
         CurrentGameLoopValue, FEnemyObservationDescriptor::DefaultStaleEntryThresholdGameLoopsValue);
-    EnemyObservationDescriptorValue.RebuildCompositionSummary();
 }
 
 }  // namespace sc2
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cstdint>
+
 #include "common/descriptors/IEnemyObservationBuilder.h"
+#include "sc2api/sc2_unit.h"
 
 namespace sc2
 {
@@ -14,6 +17,10 @@ public:
     void RebuildEnemyObservation(const ObservationInterface& ObservationValue,
                                  uint64_t CurrentGameLoopValue,
                                  FEnemyObservationDescriptor& EnemyObservationDescriptorValue) const override;
+
+    // Same update as RebuildEnemyObservation from an already collected list of enemy units.
+    void UpdateEnemyObservation(const Units& EnemyUnitsValue, uint64_t CurrentGameLoopValue,
+                                FEnemyObservationDescriptor& EnemyObservationDescriptorValue) const;
 };
 
 }  // namespace sc2
@@ -162,7 +162,8 @@ bool HasActiveChildOrder(const FCommandAuthoritySchedulingState& CommandAuthorit
          ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue] != ParentOrderIdValue ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -382,7 +383,7 @@ void PopulateSchedulerOutlook(const FBuildPlanningState& BuildPlanningStateValue
          ++OrderIndexValue)
     {
         const EOrderLifecycleState LifecycleStateValue =
-            CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue];
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState;
         if (IsTerminalLifecycleState(LifecycleStateValue))
         {
             continue;
@@ -406,7 +407,8 @@ void PopulateSchedulerOutlook(const FBuildPlanningState& BuildPlanningStateValue
                 break;
         }
 
-        if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] == ECommandAuthorityLayer::UnitExecution &&
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer ==
+                ECommandAuthorityLayer::UnitExecution &&
             LifecycleStateValue == EOrderLifecycleState::Dispatched)
         {
             ++SchedulerOutlookDescriptorValue.InFlightOrderCount;
@@ -582,9 +584,12 @@ void PopulateProductionState(const FAgentState& AgentStateValue, const FEconomyD
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]) ||
-            CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::UnitExecution ||
-            CommandAuthoritySchedulingStateValue.IntentDomains[OrderIndexValue] != EIntentDomain::UnitProduction)
+        if (IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState) ||
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
+                ECommandAuthorityLayer::UnitExecution ||
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].IntentDomain !=
+                EIntentDomain::UnitProduction)
         {
             continue;
         }
@@ -1,6 +1,6 @@
 #include "common/economy/FEconomyDomainState.h"
 
-#include <algorithm>
+#include <cstddef>
 #include <string>
 
 #include "common/bot_status_models.h"
@@ -222,13 +222,17 @@ void FEconomyDomainState::Reset()
     CumulativeGrossVespeneIncome = 0U;
     CumulativeUnitCompletionCounts.fill(0U);
     CumulativeBuildingCompletionCounts.fill(0U);
-    SampleGameLoops.clear();
-    SampleMineralBanks.clear();
-    SampleVespeneBanks.clear();
-    SampleCumulativeGrossMineralIncome.clear();
-    SampleCumulativeGrossVespeneIncome.clear();
-    SampleCumulativeUnitCompletionCounts.clear();
-    SampleCumulativeBuildingCompletionCounts.clear();
+    Samples.assign(MaxSampleHistoryCountValue, FEconomySample());
+    FirstSampleSequence = 0U;
+    SampleCount = 0U;
+    CompletionDeltas.clear();
+    CompletionDeltaBase = 0U;
+    HorizonSampleSequences.fill(0U);
+    for (size_t HorizonIndexValue = 0U; HorizonIndexValue < ForecastHorizonCountValue; ++HorizonIndexValue)
+    {
+        HorizonUnitCompletionCounts[HorizonIndexValue].fill(0U);
+        HorizonBuildingCompletionCounts[HorizonIndexValue].fill(0U);
+    }
 }
 
 void FEconomyDomainState::Update(const FAgentState& AgentStateValue, const uint64_t CurrentGameLoopValue)
@@ -299,8 +303,10 @@ void FEconomyDomainState::Update(const FAgentState& AgentStateValue, const uint6
         const uint16_t LastObservedCountValue = LastObservedUnitCounts[UnitTypeIndexValue];
         if (CurrentObservedCountValue > LastObservedCountValue)
         {
-            CumulativeUnitCompletionCounts[UnitTypeIndexValue] +=
+            const uint64_t CompletedCountValue =
                 static_cast<uint64_t>(CurrentObservedCountValue - LastObservedCountValue);
+            CumulativeUnitCompletionCounts[UnitTypeIndexValue] += CompletedCountValue;
+            RecordCompletionDelta(UnitTypeIndexValue, CompletedCountValue, false);
         }
     }
 
@@ -316,8 +322,10 @@ void FEconomyDomainState::Update(const FAgentState& AgentStateValue, const uint6
         const uint16_t LastObservedCountValue = LastObservedBuildingCounts[BuildingTypeIndexValue];
         if (CurrentObservedCountValue > LastObservedCountValue)
         {
-            CumulativeBuildingCompletionCounts[BuildingTypeIndexValue] +=
+            const uint64_t CompletedCountValue =
                 static_cast<uint64_t>(CurrentObservedCountValue - LastObservedCountValue);
+            CumulativeBuildingCompletionCounts[BuildingTypeIndexValue] += CompletedCountValue;
+            RecordCompletionDelta(BuildingTypeIndexValue, CompletedCountValue, true);
         }
     }
 
@@ -331,23 +339,37 @@ void FEconomyDomainState::Update(const FAgentState& AgentStateValue, const uint6
     LastObservedCompletedUpgradeCounts = AgentStateValue.CompletedUpgradeCounts;
 
     RecordCurrentSample(CurrentMineralsValue, CurrentVespeneValue);
+    AdvanceHorizonCursors();
     TrimHistory();
 }
 
 size_t FEconomyDomainState::GetSampleCount() const
 {
-    return SampleGameLoops.size();
+    return SampleCount;
 }
 
 bool FEconomyDomainState::HasSynchronizedSampleSizes() const
 {
-    const size_t ExpectedSizeValue = SampleGameLoops.size();
-    return SampleMineralBanks.size() == ExpectedSizeValue &&
-           SampleVespeneBanks.size() == ExpectedSizeValue &&
-           SampleCumulativeGrossMineralIncome.size() == ExpectedSizeValue &&
-           SampleCumulativeGrossVespeneIncome.size() == ExpectedSizeValue &&
-           SampleCumulativeUnitCompletionCounts.size() == ExpectedSizeValue &&
-           SampleCumulativeBuildingCompletionCounts.size() == ExpectedSizeValue;
+    if (Samples.size() != MaxSampleHistoryCountValue || SampleCount > MaxSampleHistoryCountValue)
+    {
+        return false;
+    }
+    if (SampleCount == 0U)
+    {
+        return true;
+    }
+
+    const uint64_t LastSampleSequenceValue = FirstSampleSequence + SampleCount - 1U;
+    for (const uint64_t HorizonSampleSequenceValue : HorizonSampleSequences)
+    {
+        if (HorizonSampleSequenceValue < FirstSampleSequence || HorizonSampleSequenceValue > LastSampleSequenceValue)
+        {
+            return false;
+        }
+    }
+
+    return GetSample(LastSampleSequenceValue).CompletionDeltaEnd == CompletionDeltaBase + CompletionDeltas.size() &&
+           GetSample(FirstSampleSequence).CompletionDeltaEnd >= CompletionDeltaBase;
 }
 
 void FEconomyDomainState::AssertSynchronizedSampleSizes() const
@@ -355,69 +377,68 @@ void FEconomyDomainState::AssertSynchronizedSampleSizes() const
     if (!HasSynchronizedSampleSizes())
     {
         SCLOG(LoggingVerbosity::error,
-              "INVARIANT VIOLATION: FEconomyDomainState sample vector sizes desynchronized at SampleCount=" +
-                  std::to_string(SampleGameLoops.size()));
+              "INVARIANT VIOLATION: FEconomyDomainState sample history desynchronized at SampleCount=" +
+                  std::to_string(SampleCount));
     }
 }
 
 uint64_t FEconomyDomainState::GetElapsedGameLoopsForHorizon(const size_t HorizonIndexValue) const
 {
-    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleGameLoops.empty())
+    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleCount == 0U)
     {
         return 0U;
     }
 
-    const size_t SampleIndexValue = GetSampleIndexForHorizon(HorizonIndexValue);
-    return CurrentGameLoop >= SampleGameLoops[SampleIndexValue] ? CurrentGameLoop - SampleGameLoops[SampleIndexValue]
-                                                                : 0U;
+    const FEconomySample& SampleValue = GetHorizonSample(HorizonIndexValue);
+    return CurrentGameLoop >= SampleValue.GameLoop ? CurrentGameLoop - SampleValue.GameLoop : 0U;
 }
 
 uint64_t FEconomyDomainState::GetGrossMineralIncomeForHorizon(const size_t HorizonIndexValue) const
 {
-    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleGameLoops.empty())
+    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleCount == 0U)
     {
         return 0U;
     }
 
-    const size_t SampleIndexValue = GetSampleIndexForHorizon(HorizonIndexValue);
-    return CumulativeGrossMineralIncome >= SampleCumulativeGrossMineralIncome[SampleIndexValue]
-               ? CumulativeGrossMineralIncome - SampleCumulativeGrossMineralIncome[SampleIndexValue]
+    const FEconomySample& SampleValue = GetHorizonSample(HorizonIndexValue);
+    return CumulativeGrossMineralIncome >= SampleValue.CumulativeGrossMineralIncome
+               ? CumulativeGrossMineralIncome - SampleValue.CumulativeGrossMineralIncome
                : 0U;
 }
 
 uint64_t FEconomyDomainState::GetGrossVespeneIncomeForHorizon(const size_t HorizonIndexValue) const
 {
-    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleGameLoops.empty())
+    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleCount == 0U)
     {
         return 0U;
     }
 
-    const size_t SampleIndexValue = GetSampleIndexForHorizon(HorizonIndexValue);
-    return CumulativeGrossVespeneIncome >= SampleCumulativeGrossVespeneIncome[SampleIndexValue]
-               ? CumulativeGrossVespeneIncome - SampleCumulativeGrossVespeneIncome[SampleIndexValue]
+    const FEconomySample& SampleValue = GetHorizonSample(HorizonIndexValue);
+    return CumulativeGrossVespeneIncome >= SampleValue.CumulativeGrossVespeneIncome
+               ? CumulativeGrossVespeneIncome - SampleValue.CumulativeGrossVespeneIncome
                : 0U;
 }
 
 int64_t FEconomyDomainState::GetNetMineralDeltaForHorizon(const size_t HorizonIndexValue) const
 {
-    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleGameLoops.empty())
+    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleCount == 0U)
     {
         return 0;
     }
 
-    const size_t SampleIndexValue = GetSampleIndexForHorizon(HorizonIndexValue);
-    return static_cast<int64_t>(LastObservedMinerals) - static_cast<int64_t>(SampleMineralBanks[SampleIndexValue]);
+    const FEconomySample& SampleValue = GetHorizonSample(HorizonIndexValue);
+    return static_cast<int64_t>(LastObservedMinerals) - static_cast<int64_t>(SampleValue.MineralBank);
 }
 
 int64_t FEconomyDomainState::GetNetVespeneDeltaForHorizon(const size_t HorizonIndexValue) const
 {
-    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleGameLoops.empty())
+    if (HorizonIndexValue >= ForecastHorizonCountValue || SampleCount == 0U)
     {
         return 0;
     }
 
-    const size_t SampleIndexValue = GetSampleIndexForHorizon(HorizonIndexValue);
-    return static_cast<int64_t>(LastObservedVespene) - static_cast<int64_t>(SampleVespeneBanks[SampleIndexValue]);
+    const FEconomySample& SampleValue = GetHorizonSample(HorizonIndexValue);
+    return static_cast<int64_t>(LastObservedVespene) - static_cast<int64_t>(SampleValue.VespeneBank);
 }
 
 uint64_t FEconomyDomainState::GetUnitCompletionCountForHorizon(const UNIT_TYPEID UnitTypeIdValue,
@@ -425,17 +446,12 @@ uint64_t FEconomyDomainState::GetUnitCompletionCountForHorizon(const UNIT_TYPEID
 {
     const size_t UnitTypeIndexValue = GetTerranUnitTypeIndex(UnitTypeIdValue);
     if (!IsTerranUnitTypeIndexValid(UnitTypeIndexValue) || HorizonIndexValue >= ForecastHorizonCountValue ||
-        SampleGameLoops.empty())
+        SampleCount == 0U)
     {
         return 0U;
     }
 
-    const size_t SampleIndexValue = GetSampleIndexForHorizon(HorizonIndexValue);
-    return CumulativeUnitCompletionCounts[UnitTypeIndexValue] >=
-                   SampleCumulativeUnitCompletionCounts[SampleIndexValue][UnitTypeIndexValue]
-               ? CumulativeUnitCompletionCounts[UnitTypeIndexValue] -
-                     SampleCumulativeUnitCompletionCounts[SampleIndexValue][UnitTypeIndexValue]
-               : 0U;
+    return HorizonUnitCompletionCounts[HorizonIndexValue][UnitTypeIndexValue];
 }
 
 uint64_t FEconomyDomainState::GetBuildingCompletionCountForHorizon(const UNIT_TYPEID BuildingTypeIdValue,
@@ -443,95 +459,183 @@ uint64_t FEconomyDomainState::GetBuildingCompletionCountForHorizon(const UNIT_TY
 {
     const size_t BuildingTypeIndexValue = GetTerranBuildingTypeIndex(BuildingTypeIdValue);
     if (!IsTerranBuildingTypeIndexValid(BuildingTypeIndexValue) || HorizonIndexValue >= ForecastHorizonCountValue ||
-        SampleGameLoops.empty())
+        SampleCount == 0U)
     {
         return 0U;
     }
 
-    const size_t SampleIndexValue = GetSampleIndexForHorizon(HorizonIndexValue);
-    return CumulativeBuildingCompletionCounts[BuildingTypeIndexValue] >=
-                   SampleCumulativeBuildingCompletionCounts[SampleIndexValue][BuildingTypeIndexValue]
-               ? CumulativeBuildingCompletionCounts[BuildingTypeIndexValue] -
-                     SampleCumulativeBuildingCompletionCounts[SampleIndexValue][BuildingTypeIndexValue]
-               : 0U;
+    return HorizonBuildingCompletionCounts[HorizonIndexValue][BuildingTypeIndexValue];
+}
+
+const FEconomyDomainState::FEconomySample& FEconomyDomainState::GetSample(const uint64_t SampleSequenceValue) const
+{
+    return Samples[static_cast<size_t>(SampleSequenceValue % MaxSampleHistoryCountValue)];
+}
+
+const FEconomyDomainState::FEconomySample& FEconomyDomainState::GetHorizonSample(const size_t HorizonIndexValue) const
+{
+    return GetSample(HorizonSampleSequences[HorizonIndexValue]);
 }
 
-size_t FEconomyDomainState::GetSampleIndexForHorizon(const size_t HorizonIndexValue) const
+void FEconomyDomainState::TrimHistory()
 {
-    if (SampleGameLoops.empty())
+    const uint64_t MinimumRetainedGameLoopValue =
+        CurrentGameLoop > ForecastHorizonGameLoopsValue[LongForecastHorizonIndexValue]
+            ? CurrentGameLoop - ForecastHorizonGameLoopsValue[LongForecastHorizonIndexValue]
+            : 0U;
+
+    while (SampleCount > 1U && GetSample(FirstSampleSequence + 1U).GameLoop <= MinimumRetainedGameLoopValue)
     {
-        return 0U;
+        DropOldestSample();
     }
 
-    const uint64_t HorizonGameLoopsValue = ForecastHorizonGameLoopsValue[HorizonIndexValue];
-    const uint64_t TargetGameLoopValue =
-        CurrentGameLoop >= HorizonGameLoopsValue ? CurrentGameLoop - HorizonGameLoopsValue : 0U;
+    CompactCompletionDeltas();
+    AssertSynchronizedSampleSizes();
+}
 
-    for (size_t SampleIndexValue = SampleGameLoops.size(); SampleIndexValue > 0U; --SampleIndexValue)
+void FEconomyDomainState::RecordCompletionDelta(const size_t TypeIndexValue, const uint64_t CountValue,
+                                                const bool bIsBuildingValue)
+{
+    // The delta belongs to the sample this update records: the newest one when it shares the game loop, else the
+    // next one. Windows that start before that sample count it immediately.
+    const bool bReplacesNewestSampleValue =
+        SampleCount > 0U && GetSample(FirstSampleSequence + SampleCount - 1U).GameLoop == CurrentGameLoop;
+    const uint64_t SampleSequenceValue = FirstSampleSequence + SampleCount - (bReplacesNewestSampleValue ? 1U : 0U);
+
+    FCompletionDelta CompletionDeltaValue;
+    CompletionDeltaValue.TypeIndex = static_cast<uint16_t>(TypeIndexValue);
+    CompletionDeltaValue.Count = static_cast<uint16_t>(CountValue);
+    CompletionDeltaValue.bIsBuilding = bIsBuildingValue;
+    CompletionDeltas.push_back(CompletionDeltaValue);
+
+    for (size_t HorizonIndexValue = 0U; HorizonIndexValue < ForecastHorizonCountValue; ++HorizonIndexValue)
     {
-        const size_t CandidateSampleIndexValue = SampleIndexValue - 1U;
-        if (SampleGameLoops[CandidateSampleIndexValue] <= TargetGameLoopValue)
+        if (HorizonSampleSequences[HorizonIndexValue] >= SampleSequenceValue)
         {
-            return CandidateSampleIndexValue;
+            continue;
         }
-    }
 
-    return 0U;
+        if (bIsBuildingValue)
+        {
+            HorizonBuildingCompletionCounts[HorizonIndexValue][TypeIndexValue] += CountValue;
+        }
+        else
+        {
+            HorizonUnitCompletionCounts[HorizonIndexValue][TypeIndexValue] += CountValue;
+        }
+    }
 }
 
-void FEconomyDomainState::TrimHistory()
+void FEconomyDomainState::RecordCurrentSample(const uint32_t CurrentMineralsValue, const uint32_t CurrentVespeneValue)
 {
-    const uint64_t MinimumRetainedGameLoopValue =
-        CurrentGameLoop > ForecastHorizonGameLoopsValue[LongForecastHorizonIndexValue]
-            ? CurrentGameLoop - ForecastHorizonGameLoopsValue[LongForecastHorizonIndexValue]
-            : 0U;
+    FEconomySample SampleValue;
+    SampleValue.GameLoop = CurrentGameLoop;
+    SampleValue.MineralBank = CurrentMineralsValue;
+    SampleValue.VespeneBank = CurrentVespeneValue;
+    SampleValue.CumulativeGrossMineralIncome = CumulativeGrossMineralIncome;
+    SampleValue.CumulativeGrossVespeneIncome = CumulativeGrossVespeneIncome;
+    SampleValue.CompletionDeltaEnd = CompletionDeltaBase + CompletionDeltas.size();
+
+    if (SampleCount > 0U && GetSample(FirstSampleSequence + SampleCount - 1U).GameLoop == CurrentGameLoop)
+    {
+        Samples[static_cast<size_t>((FirstSampleSequence + SampleCount - 1U) % MaxSampleHistoryCountValue)] =
+            SampleValue;
+        return;
+    }
 
-    while (SampleGameLoops.size() > 1U && SampleGameLoops[1U] <= MinimumRetainedGameLoopValue)
+    if (SampleCount == MaxSampleHistoryCountValue)
     {
-        SampleGameLoops.erase(SampleGameLoops.begin());
-        SampleMineralBanks.erase(SampleMineralBanks.begin());
-        SampleVespeneBanks.erase(SampleVespeneBanks.begin());
-        SampleCumulativeGrossMineralIncome.erase(SampleCumulativeGrossMineralIncome.begin());
-        SampleCumulativeGrossVespeneIncome.erase(SampleCumulativeGrossVespeneIncome.begin());
-        SampleCumulativeUnitCompletionCounts.erase(SampleCumulativeUnitCompletionCounts.begin());
-        SampleCumulativeBuildingCompletionCounts.erase(SampleCumulativeBuildingCompletionCounts.begin());
+        DropOldestSample();
     }
 
-    while (SampleGameLoops.size() > MaxSampleHistoryCountValue)
+    if (SampleCount == 0U)
     {
-        SampleGameLoops.erase(SampleGameLoops.begin());
-        SampleMineralBanks.erase(SampleMineralBanks.begin());
-        SampleVespeneBanks.erase(SampleVespeneBanks.begin());
-        SampleCumulativeGrossMineralIncome.erase(SampleCumulativeGrossMineralIncome.begin());
-        SampleCumulativeGrossVespeneIncome.erase(SampleCumulativeGrossVespeneIncome.begin());
-        SampleCumulativeUnitCompletionCounts.erase(SampleCumulativeUnitCompletionCounts.begin());
-        SampleCumulativeBuildingCompletionCounts.erase(SampleCumulativeBuildingCompletionCounts.begin());
+        HorizonSampleSequences.fill(FirstSampleSequence);
+        for (size_t HorizonIndexValue = 0U; HorizonIndexValue < ForecastHorizonCountValue; ++HorizonIndexValue)
+        {
+            HorizonUnitCompletionCounts[HorizonIndexValue].fill(0U);
+            HorizonBuildingCompletionCounts[HorizonIndexValue].fill(0U);
+        }
     }
 
+    Samples[static_cast<size_t>((FirstSampleSequence + SampleCount) % MaxSampleHistoryCountValue)] = SampleValue;
+    ++SampleCount;
     AssertSynchronizedSampleSizes();
 }
 
-void FEconomyDomainState::RecordCurrentSample(const uint32_t CurrentMineralsValue, const uint32_t CurrentVespeneValue)
+void FEconomyDomainState::DropOldestSample()
+{
+    for (size_t HorizonIndexValue = 0U; HorizonIndexValue < ForecastHorizonCountValue; ++HorizonIndexValue)
+    {
+        if (HorizonSampleSequences[HorizonIndexValue] == FirstSampleSequence && SampleCount > 1U)
+        {
+            StepHorizonCursor(HorizonIndexValue);
+        }
+    }
+
+    ++FirstSampleSequence;
+    --SampleCount;
+}
+
+void FEconomyDomainState::AdvanceHorizonCursors()
 {
-    if (!SampleGameLoops.empty() && SampleGameLoops.back() == CurrentGameLoop)
-    {
-        SampleMineralBanks.back() = CurrentMineralsValue;
-        SampleVespeneBanks.back() = CurrentVespeneValue;
-        SampleCumulativeGrossMineralIncome.back() = CumulativeGrossMineralIncome;
-        SampleCumulativeGrossVespeneIncome.back() = CumulativeGrossVespeneIncome;
-        SampleCumulativeUnitCompletionCounts.back() = CumulativeUnitCompletionCounts;
-        SampleCumulativeBuildingCompletionCounts.back() = CumulativeBuildingCompletionCounts;
+    for (size_t HorizonIndexValue = 0U; HorizonIndexValue < ForecastHorizonCountValue; ++HorizonIndexValue)
+    {
+        const uint64_t HorizonGameLoopsValue = ForecastHorizonGameLoopsValue[HorizonIndexValue];
+        const uint64_t TargetGameLoopValue =
+            CurrentGameLoop >= HorizonGameLoopsValue ? CurrentGameLoop - HorizonGameLoopsValue : 0U;
+
+        // The window starts at the newest sample no later than the target, or the oldest retained sample.
+        const uint64_t LastSampleSequenceValue = FirstSampleSequence + SampleCount - 1U;
+        while (HorizonSampleSequences[HorizonIndexValue] < LastSampleSequenceValue &&
+               GetSample(HorizonSampleSequences[HorizonIndexValue] + 1U).GameLoop <= TargetGameLoopValue)
+        {
+            StepHorizonCursor(HorizonIndexValue);
+        }
+    }
+}
+
+void FEconomyDomainState::StepHorizonCursor(const size_t HorizonIndexValue)
+{
+    const uint64_t DeltaBeginValue = GetSample(HorizonSampleSequences[HorizonIndexValue]).CompletionDeltaEnd;
+    ++HorizonSampleSequences[HorizonIndexValue];
+    const uint64_t DeltaEndValue = GetSample(HorizonSampleSequences[HorizonIndexValue]).CompletionDeltaEnd;
+    for (uint64_t DeltaPositionValue = DeltaBeginValue; DeltaPositionValue < DeltaEndValue; ++DeltaPositionValue)
+    {
+        const FCompletionDelta& CompletionDeltaValue =
+            CompletionDeltas[static_cast<size_t>(DeltaPositionValue - CompletionDeltaBase)];
+        if (CompletionDeltaValue.bIsBuilding)
+        {
+            HorizonBuildingCompletionCounts[HorizonIndexValue][CompletionDeltaValue.TypeIndex] -=
+                CompletionDeltaValue.Count;
+        }
+        else
+        {
+            HorizonUnitCompletionCounts[HorizonIndexValue][CompletionDeltaValue.TypeIndex] -=
+                CompletionDeltaValue.Count;
+        }
+    }
+}
+
+void FEconomyDomainState::CompactCompletionDeltas()
+{
+    // Deltas up to the oldest sample are never subtracted again. Drop them once they make up half the log so the
+    // front erase stays amortized constant per delta.
+    if (SampleCount == 0U)
+    {
         return;
     }
 
-    SampleGameLoops.push_back(CurrentGameLoop);
-    SampleMineralBanks.push_back(CurrentMineralsValue);
-    SampleVespeneBanks.push_back(CurrentVespeneValue);
-    SampleCumulativeGrossMineralIncome.push_back(CumulativeGrossMineralIncome);
-    SampleCumulativeGrossVespeneIncome.push_back(CumulativeGrossVespeneIncome);
-    SampleCumulativeUnitCompletionCounts.push_back(CumulativeUnitCompletionCounts);
-    SampleCumulativeBuildingCompletionCounts.push_back(CumulativeBuildingCompletionCounts);
-    AssertSynchronizedSampleSizes();
+    const size_t StaleDeltaCountValue =
+        static_cast<size_t>(GetSample(FirstSampleSequence).CompletionDeltaEnd - CompletionDeltaBase);
+    if (StaleDeltaCountValue == 0U || StaleDeltaCountValue * 2U < CompletionDeltas.size())
+    {
+        return;
+    }
+
+    CompletionDeltas.erase(CompletionDeltas.begin(),
+                           CompletionDeltas.begin() + static_cast<std::ptrdiff_t>(StaleDeltaCountValue));
+    CompletionDeltaBase += StaleDeltaCountValue;
 }
 
 }  // namespace sc2
@@ -47,19 +47,55 @@ public:
     uint64_t CumulativeGrossVespeneIncome;
     std::array<uint64_t, NUM_TERRAN_UNITS> CumulativeUnitCompletionCounts;
     std::array<uint64_t, NUM_TERRAN_BUILDINGS> CumulativeBuildingCompletionCounts;
-    std::vector<uint64_t> SampleGameLoops;
-    std::vector<uint32_t> SampleMineralBanks;
-    std::vector<uint32_t> SampleVespeneBanks;
-    std::vector<uint64_t> SampleCumulativeGrossMineralIncome;
-    std::vector<uint64_t> SampleCumulativeGrossVespeneIncome;
-    std::vector<std::array<uint64_t, NUM_TERRAN_UNITS>> SampleCumulativeUnitCompletionCounts;
-    std::vector<std::array<uint64_t, NUM_TERRAN_BUILDINGS>> SampleCumulativeBuildingCompletionCounts;
 
 private:
-    size_t GetSampleIndexForHorizon(size_t HorizonIndexValue) const;
+    // One retained history sample. Completions observed at this sample are the delta log entries from the previous
+    // sample's CompletionDeltaEnd up to this one's.
+    struct FEconomySample
+    {
+        uint64_t GameLoop = 0U;
+        uint32_t MineralBank = 0U;
+        uint32_t VespeneBank = 0U;
+        uint64_t CumulativeGrossMineralIncome = 0U;
+        uint64_t CumulativeGrossVespeneIncome = 0U;
+        uint64_t CompletionDeltaEnd = 0U;
+    };
+
+    // A unit or building type whose observed count rose at one sample.
+    struct FCompletionDelta
+    {
+        uint16_t TypeIndex = 0U;
+        uint16_t Count = 0U;
+        bool bIsBuilding = false;
+    };
+
+    const FEconomySample& GetSample(uint64_t SampleSequenceValue) const;
+    const FEconomySample& GetHorizonSample(size_t HorizonIndexValue) const;
     void TrimHistory();
+    void RecordCompletionDelta(size_t TypeIndexValue, uint64_t CountValue, bool bIsBuildingValue);
     void RecordCurrentSample(uint32_t CurrentMineralsValue, uint32_t CurrentVespeneValue);
+    void DropOldestSample();
+    void AdvanceHorizonCursors();
+    // Moves one horizon window start to the next sample and forgets the completions recorded at it.
+    void StepHorizonCursor(size_t HorizonIndexValue);
+    void CompactCompletionDeltas();
     void AssertSynchronizedSampleSizes() const;
+
+    // Circular sample history; sample sequence N lives at slot N % MaxSampleHistoryCountValue.
+    std::vector<FEconomySample> Samples;
+    uint64_t FirstSampleSequence;
+    size_t SampleCount;
+
+    // Completion delta log shared by all retained samples; entry i has absolute position CompletionDeltaBase + i.
+    std::vector<FCompletionDelta> CompletionDeltas;
+    uint64_t CompletionDeltaBase;
+
+    // Per horizon, the sample the window starts at and the completions recorded after it. Game loops only move
+    // forward within a game, so each cursor only moves forward too.
+    std::array<uint64_t, ForecastHorizonCountValue> HorizonSampleSequences;
+    std::array<std::array<uint64_t, NUM_TERRAN_UNITS>, ForecastHorizonCountValue> HorizonUnitCompletionCounts;
+    std::array<std::array<uint64_t, NUM_TERRAN_BUILDINGS>, ForecastHorizonCountValue>
+        HorizonBuildingCompletionCounts;
 };
 
 }  // namespace sc2
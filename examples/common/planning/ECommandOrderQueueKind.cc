@@ -0,0 +1,31 @@
+#include "common/planning/ECommandOrderQueueKind.h"
+
+namespace sc2
+{
+
+const char* ToString(const ECommandOrderQueueKind CommandOrderQueueKindValue)
+{
+    switch (CommandOrderQueueKindValue)
+    {
+        case ECommandOrderQueueKind::None:
+            return "None";
+        case ECommandOrderQueueKind::Strategic:
+            return "Strategic";
+        case ECommandOrderQueueKind::Planning:
+            return "Planning";
+        case ECommandOrderQueueKind::Army:
+            return "Army";
+        case ECommandOrderQueueKind::Squad:
+            return "Squad";
+        case ECommandOrderQueueKind::ReadyIntent:
+            return "ReadyIntent";
+        case ECommandOrderQueueKind::Dispatched:
+            return "Dispatched";
+        case ECommandOrderQueueKind::Completed:
+            return "Completed";
+        default:
+            return "None";
+    }
+}
+
+}  // namespace sc2
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sc2
+{
+
+enum class ECommandOrderQueueKind : uint8_t
+{
+    None,
+    Strategic,
+    Planning,
+    Army,
+    Squad,
+    ReadyIntent,
+    Dispatched,
+    Completed,
+};
+
+const char* ToString(ECommandOrderQueueKind CommandOrderQueueKindValue);
+
+}  // namespace sc2
@@ -12,6 +12,7 @@
 #include "common/planning/FTerranCommandTaskAdmissionService.h"
 #include "common/planning/ICommandTaskAdmissionService.h"
 #include "common/terran_models.h"
+#include "sc2api/sc2_trace.h"
 
 namespace sc2
 {
@@ -778,9 +779,10 @@ bool HasOutstandingFlexibleOpeningSupplyTask(const FCommandAuthoritySchedulingSt
     const size_t OrderCountValue = CommandAuthoritySchedulingStateValue.OrderIds.size();
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] !=
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
                 ECommandAuthorityLayer::StrategicDirector ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]) ||
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState) ||
             CommandAuthoritySchedulingStateValue.TaskOrigins[OrderIndexValue] != ECommandTaskOrigin::Opening ||
             CommandAuthoritySchedulingStateValue.AbilityIds[OrderIndexValue] != ABILITY_ID::BUILD_SUPPLYDEPOT ||
             CommandAuthoritySchedulingStateValue.ExecutionGuarantees[OrderIndexValue] ==
@@ -1155,6 +1157,7 @@ void FCommandAuthorityProcessor::ProcessSchedulerStep(
     FGameStateDescriptor& GameStateDescriptorValue,
     const ICommandTaskAdmissionService& CommandTaskAdmissionServiceValue) const
 {
+    SC2_TRACE_ZONE("FCommandAuthorityProcessor::ProcessSchedulerStep");
     FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue =
         GameStateDescriptorValue.CommandAuthoritySchedulingState;
 
@@ -1186,6 +1189,7 @@ void FCommandAuthorityProcessor::InitializeOpeningPlan(FGameStateDescriptor& Gam
 
 void FCommandAuthorityProcessor::UpdateCompletedOpeningSteps(FGameStateDescriptor& GameStateDescriptorValue) const
 {
+    SC2_TRACE_ZONE("FCommandAuthorityProcessor::UpdateCompletedOpeningSteps");
     FOpeningPlanExecutionState& OpeningPlanExecutionStateValue = GameStateDescriptorValue.OpeningPlanExecutionState;
     const FOpeningPlanDescriptor& OpeningPlanDescriptorValue =
         FOpeningPlanRegistry::GetOpeningPlanDescriptor(OpeningPlanExecutionStateValue.ActivePlanId);
@@ -1262,9 +1266,10 @@ void FCommandAuthorityProcessor::UpdateCompletedOpeningSteps(FGameStateDescripto
             for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
             {
                 if (CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue] != StrategicOrderIdValue ||
-                    CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] !=
+                    CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
                         ECommandAuthorityLayer::EconomyAndProduction ||
-                    IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+                    IsTerminalLifecycleState(
+                        CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
                 {
                     continue;
                 }
@@ -1278,7 +1283,7 @@ void FCommandAuthorityProcessor::UpdateCompletedOpeningSteps(FGameStateDescripto
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size(); ++OrderIndexValue)
     {
         const EOrderLifecycleState LifecycleStateValue =
-            CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue];
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState;
         if (LifecycleStateValue == EOrderLifecycleState::Completed || LifecycleStateValue == EOrderLifecycleState::Expired ||
             LifecycleStateValue == EOrderLifecycleState::Aborted)
         {
@@ -1312,6 +1317,7 @@ void FCommandAuthorityProcessor::SeedReadyStrategicOrders(
     FGameStateDescriptor& GameStateDescriptorValue,
     const ICommandTaskAdmissionService& CommandTaskAdmissionServiceValue) const
 {
+    SC2_TRACE_ZONE("FCommandAuthorityProcessor::SeedReadyStrategicOrders");
     FOpeningPlanExecutionState& OpeningPlanExecutionStateValue = GameStateDescriptorValue.OpeningPlanExecutionState;
     const FOpeningPlanDescriptor& OpeningPlanDescriptorValue =
         FOpeningPlanRegistry::GetOpeningPlanDescriptor(OpeningPlanExecutionStateValue.ActivePlanId);
@@ -1383,6 +1389,7 @@ void FCommandAuthorityProcessor::SeedGoalDrivenStrategicOrders(
     FGameStateDescriptor& GameStateDescriptorValue,
     const ICommandTaskAdmissionService& CommandTaskAdmissionServiceValue) const
 {
+    SC2_TRACE_ZONE("FCommandAuthorityProcessor::SeedGoalDrivenStrategicOrders");
     FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue =
         GameStateDescriptorValue.CommandAuthoritySchedulingState;
     const FGoalDescriptor* ArmyMissionGoalDescriptorValue = SelectCurrentArmyMissionGoal(GameStateDescriptorValue);
@@ -1390,10 +1397,11 @@ void FCommandAuthorityProcessor::SeedGoalDrivenStrategicOrders(
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] !=
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
                 ECommandAuthorityLayer::StrategicDirector ||
             CommandAuthoritySchedulingStateValue.TaskTypes[OrderIndexValue] != ECommandTaskType::ArmyMission ||
-            !IsNonTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            !IsNonTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -1437,10 +1445,11 @@ void FCommandAuthorityProcessor::SeedGoalDrivenStrategicOrders(
         for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
              ++OrderIndexValue)
         {
-            if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] !=
+            if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
                     ECommandAuthorityLayer::StrategicDirector ||
                 CommandAuthoritySchedulingStateValue.TaskOrigins[OrderIndexValue] != ECommandTaskOrigin::Opening ||
-                IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+                IsTerminalLifecycleState(
+                    CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
             {
                 continue;
             }
@@ -1503,6 +1512,7 @@ void FCommandAuthorityProcessor::SeedGoalDrivenStrategicOrders(
 
 void FCommandAuthorityProcessor::EnsureStrategicChildOrders(FGameStateDescriptor& GameStateDescriptorValue) const
 {
+    SC2_TRACE_ZONE("FCommandAuthorityProcessor::EnsureStrategicChildOrders");
     FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue =
         GameStateDescriptorValue.CommandAuthoritySchedulingState;
     const std::vector<size_t> StrategicOrderIndicesValue = CommandAuthoritySchedulingStateValue.StrategicOrderIndices;
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "common/build_orders/FOpeningPlanExecutionState.h"
+#include "common/planning/FCommandOrderView.h"
 #include "common/logging.h"
 
 namespace sc2
@@ -14,28 +15,150 @@ namespace
 constexpr uint64_t RecentBlockedTaskCounterWindowStepCountValue = 120U;
 constexpr size_t CommandAuthorityLayerCountValue = 6U;
 
+// A mutation batch that touches more than 1/N of the stored orders falls back to a single full rebuild, which is
+// cheaper than that many individual bucket moves.
+constexpr size_t IncrementalDerivedQueueUpdateDivisorValue = 4U;
+
+constexpr std::array<ECommandAuthorityLayer, CommandAuthorityLayerCountValue> CommandAuthorityLayersValue =
+{
+    ECommandAuthorityLayer::Agent,
+    ECommandAuthorityLayer::StrategicDirector,
+    ECommandAuthorityLayer::EconomyAndProduction,
+    ECommandAuthorityLayer::Army,
+    ECommandAuthorityLayer::Squad,
+    ECommandAuthorityLayer::UnitExecution,
+};
+
 template <typename TValueType>
-std::vector<TValueType> BuildCompactedVector(const std::vector<TValueType>& SourceValues,
-                                             const std::vector<size_t>& RetainedOrderIndicesValue)
+void CompactVectorInPlace(std::vector<TValueType>& Values, const std::vector<size_t>& RetainedOrderIndicesValue)
+{
+    const size_t RetainedOrderCountValue = RetainedOrderIndicesValue.size();
+    for (size_t CompactedOrderIndexValue = 0U; CompactedOrderIndexValue < RetainedOrderCountValue;
+         ++CompactedOrderIndexValue)
+    {
+        Values[CompactedOrderIndexValue] = Values[RetainedOrderIndicesValue[CompactedOrderIndexValue]];
+    }
+
+    Values.resize(RetainedOrderCountValue);
+}
+
+template <typename TKeyType, typename TValueType, typename THashType>
+bool AreFlatHashMapsEqual(const FFlatHashMap<TKeyType, TValueType, THashType>& LeftMapValue,
+                          const FFlatHashMap<TKeyType, TValueType, THashType>& RightMapValue)
 {
-    std::vector<TValueType> CompactedValues;
-    CompactedValues.reserve(RetainedOrderIndicesValue.size());
-    for (const size_t RetainedOrderIndexValue : RetainedOrderIndicesValue)
+    if (LeftMapValue.GetCount() != RightMapValue.GetCount())
+    {
+        return false;
+    }
+
+    bool bEqualValue = true;
+    LeftMapValue.ForEach(
+        [&RightMapValue, &bEqualValue](const TKeyType& KeyValue, const TValueType& LeftValue)
+        {
+            const TValueType* RightValuePtrValue = RightMapValue.FindValue(KeyValue);
+            if (RightValuePtrValue == nullptr || !(*RightValuePtrValue == LeftValue))
+            {
+                bEqualValue = false;
+            }
+        });
+    return bEqualValue;
+}
+
+template <size_t TQueueCountValue>
+size_t GetTieredQueueOffset(const std::array<std::vector<size_t>, TQueueCountValue>& QueuesValue,
+                            const size_t QueueIndexValue)
+{
+    size_t QueueOffsetValue = 0U;
+    for (size_t PreviousQueueIndexValue = 0U; PreviousQueueIndexValue < QueueIndexValue; ++PreviousQueueIndexValue)
+    {
+        QueueOffsetValue += QueuesValue[PreviousQueueIndexValue].size();
+    }
+
+    return QueueOffsetValue;
+}
+
+template <typename TKeyType>
+void AddActiveOrderIndex(FFlatHashMap<TKeyType, size_t>& ActiveOrderIndexByKeyValue,
+                         FFlatHashMap<TKeyType, uint32_t>& ActiveOrderCountByKeyValue, const TKeyType& KeyValue,
+                         const size_t OrderIndexValue)
+{
+    ++ActiveOrderCountByKeyValue.FindOrAdd(KeyValue);
+
+    size_t* ActiveOrderIndexPtrValue = ActiveOrderIndexByKeyValue.FindValue(KeyValue);
+    if (ActiveOrderIndexPtrValue == nullptr)
+    {
+        ActiveOrderIndexByKeyValue.Set(KeyValue, OrderIndexValue);
+        return;
+    }
+
+    *ActiveOrderIndexPtrValue = std::min(*ActiveOrderIndexPtrValue, OrderIndexValue);
+}
+
+// The index tables keep the lowest active order index per key. When that order leaves the active set while other
+// active orders still share the key, the next one is found by scanning forward from the removed index.
+template <typename TKeyType, typename TMatchFunctorType>
+void RemoveActiveOrderIndex(FFlatHashMap<TKeyType, size_t>& ActiveOrderIndexByKeyValue,
+                            FFlatHashMap<TKeyType, uint32_t>& ActiveOrderCountByKeyValue, const TKeyType& KeyValue,
+                            const size_t OrderIndexValue, const size_t OrderCountValue,
+                            TMatchFunctorType&& MatchFunctorValue)
+{
+    uint32_t* ActiveOrderCountPtrValue = ActiveOrderCountByKeyValue.FindValue(KeyValue);
+    if (ActiveOrderCountPtrValue == nullptr || *ActiveOrderCountPtrValue == 0U)
+    {
+        return;
+    }
+
+    --(*ActiveOrderCountPtrValue);
+    if (*ActiveOrderCountPtrValue == 0U)
+    {
+        ActiveOrderCountByKeyValue.Remove(KeyValue);
+        ActiveOrderIndexByKeyValue.Remove(KeyValue);
+        return;
+    }
+
+    size_t* ActiveOrderIndexPtrValue = ActiveOrderIndexByKeyValue.FindValue(KeyValue);
+    if (ActiveOrderIndexPtrValue == nullptr || *ActiveOrderIndexPtrValue != OrderIndexValue)
+    {
+        return;
+    }
+
+    for (size_t CandidateOrderIndexValue = OrderIndexValue + 1U; CandidateOrderIndexValue < OrderCountValue;
+         ++CandidateOrderIndexValue)
     {
-        CompactedValues.push_back(SourceValues[RetainedOrderIndexValue]);
+        if (MatchFunctorValue(CandidateOrderIndexValue))
+        {
+            *ActiveOrderIndexPtrValue = CandidateOrderIndexValue;
+            return;
+        }
     }
 
-    return CompactedValues;
+    ActiveOrderIndexByKeyValue.Remove(KeyValue);
 }
 
 bool HasNonTerminalChildOrder(const FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue,
                               const uint32_t ParentOrderIdValue)
 {
+    if (!CommandAuthoritySchedulingStateValue.bDerivedQueuesDirty)
+    {
+        size_t ChildOrderIndexValue = 0U;
+        for (const ECommandAuthorityLayer CommandAuthorityLayerValue : CommandAuthorityLayersValue)
+        {
+            if (CommandAuthoritySchedulingStateValue.TryGetActiveChildOrderIndex(
+                    ParentOrderIdValue, CommandAuthorityLayerValue, ChildOrderIndexValue))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     const size_t OrderCountValue = CommandAuthoritySchedulingStateValue.OrderIds.size();
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue] != ParentOrderIdValue ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -50,7 +173,7 @@ bool ShouldCompactTerminalOrder(const FCommandAuthoritySchedulingState& CommandA
                                 const FOpeningPlanExecutionState* OpeningPlanExecutionStatePtrValue,
                                 const size_t OrderIndexValue)
 {
-    if (!IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+    if (!IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
     {
         return false;
     }
@@ -61,7 +184,8 @@ bool ShouldCompactTerminalOrder(const FCommandAuthoritySchedulingState& CommandA
         return false;
     }
 
-    if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] == ECommandAuthorityLayer::UnitExecution)
+    if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer ==
+            ECommandAuthorityLayer::UnitExecution)
     {
         return true;
     }
@@ -72,7 +196,8 @@ bool ShouldCompactTerminalOrder(const FCommandAuthoritySchedulingState& CommandA
         return true;
     }
 
-    if (CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue] == EOrderLifecycleState::Completed)
+    if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState ==
+            EOrderLifecycleState::Completed)
     {
         return true;
     }
@@ -134,6 +259,7 @@ FCommandTaskSignatureKey BuildTaskSignatureKeyForOrderIndex(
 
 FCommandAuthoritySchedulingState::FCommandAuthoritySchedulingState()
 {
+    bDiagnosticColumnsEnabled = true;
     Reset();
 }
 
@@ -166,14 +292,14 @@ void FCommandAuthoritySchedulingState::Reset()
     RecentReactivatedBlockedTaskCount = 0U;
     RecentRejectedMustRunBlockedTaskCount = 0U;
     bDerivedQueuesDirty = false;
+    bDerivedQueuesRebuildRequired = false;
     bPrioritiesDirty = false;
     SchedulerStimulusState.Reset();
 
     OrderIds.clear();
     ParentOrderIds.clear();
     SourceGoalIds.clear();
-    SourceLayers.clear();
-    LifecycleStates.clear();
+    OrderHotFields.clear();
     TaskPackageKinds.clear();
     TaskNeedKinds.clear();
     TaskTypes.clear();
@@ -182,22 +308,14 @@ void FCommandAuthoritySchedulingState::Reset()
     ExecutionGuarantees.clear();
     RetentionPolicies.clear();
     BlockedTaskWakeKinds.clear();
-    BasePriorityValues.clear();
-    EffectivePriorityValues.clear();
-    PriorityTiers.clear();
-    IntentDomains.clear();
     CreationSteps.clear();
     DeadlineSteps.clear();
     OwningArmyIndices.clear();
     OwningSquadIndices.clear();
-    ActorTags.clear();
     AbilityIds.clear();
     TargetKinds.clear();
     TargetPoints.clear();
     TargetUnitTags.clear();
-    QueuedValues.clear();
-    RequiresPlacementValidationValues.clear();
-    RequiresPathingValidationValues.clear();
     PlanStepIds.clear();
     TargetCounts.clear();
     RequestedQueueCounts.clear();
@@ -212,16 +330,20 @@ void FCommandAuthoritySchedulingState::Reset()
     ReservedPlacementSlotTypes.clear();
     ReservedPlacementSlotOrdinals.clear();
     LastDeferralReasons.clear();
-    LastDeferralSteps.clear();
-    LastDeferralGameLoops.clear();
     ConsecutiveDeferralCounts.clear();
-    DispatchSteps.clear();
     DispatchGameLoops.clear();
     ObservedCountsAtDispatch.clear();
     ObservedInConstructionCountsAtDispatch.clear();
     DispatchAttemptCounts.clear();
-
-    OrderIdToIndex.clear();
+    DiagnosticColumns.Reset();
+
+    OrderIdToIndex.Clear();
+    CompactionRetainedOrderIndices.clear();
+    DerivedQueueKinds.clear();
+    DerivedPriorityTierIndices.clear();
+    DerivedPriorityValues.clear();
+    PendingDerivedQueueFlags.clear();
+    PendingDerivedQueueOrderIndices.clear();
     StrategicOrderIndices.clear();
     PlanningProcessIndices.clear();
     ArmyOrderIndices.clear();
@@ -255,10 +377,13 @@ void FCommandAuthoritySchedulingState::Reset()
 
     BlockedStrategicTasks.Reset(MaxBlockedStrategicTasks);
     BlockedPlanningTasks.Reset(MaxBlockedPlanningTasks);
-    ActiveExecutionOrderIndexByActorTag.clear();
-    ActiveStrategicOrderIndexByGoalId.clear();
-    ActiveTaskSignatureCounts.clear();
-    ActiveChildOrderIndexByParentAndLayer.clear();
+    ActiveExecutionOrderIndexByActorTag.Clear();
+    ActiveStrategicOrderIndexByGoalId.Clear();
+    ActiveTaskSignatureCounts.Clear();
+    ActiveChildOrderIndexByParentAndLayer.Clear();
+    ActiveExecutionOrderCountsByActorTag.Clear();
+    ActiveStrategicOrderCountsByGoalId.Clear();
+    ActiveChildOrderCountsByParentAndLayer.Clear();
     ActiveOrderCountsByLayer.fill(0U);
     AssertSynchronizedSizes();
 }
@@ -266,37 +391,57 @@ void FCommandAuthoritySchedulingState::Reset()
 bool FCommandAuthoritySchedulingState::HasSynchronizedSizes() const
 {
     const size_t ExpectedSizeValue = OrderIds.size();
-    return ParentOrderIds.size() == ExpectedSizeValue && SourceGoalIds.size() == ExpectedSizeValue &&
-           SourceLayers.size() == ExpectedSizeValue && LifecycleStates.size() == ExpectedSizeValue &&
-           TaskPackageKinds.size() == ExpectedSizeValue && TaskNeedKinds.size() == ExpectedSizeValue &&
-           TaskTypes.size() == ExpectedSizeValue && TaskOrigins.size() == ExpectedSizeValue &&
-           CommitmentClasses.size() == ExpectedSizeValue && ExecutionGuarantees.size() == ExpectedSizeValue &&
-           RetentionPolicies.size() == ExpectedSizeValue && BlockedTaskWakeKinds.size() == ExpectedSizeValue &&
-           BasePriorityValues.size() == ExpectedSizeValue && EffectivePriorityValues.size() == ExpectedSizeValue &&
-           PriorityTiers.size() == ExpectedSizeValue && IntentDomains.size() == ExpectedSizeValue &&
-           CreationSteps.size() == ExpectedSizeValue && DeadlineSteps.size() == ExpectedSizeValue &&
-           OwningArmyIndices.size() == ExpectedSizeValue && OwningSquadIndices.size() == ExpectedSizeValue &&
-           ActorTags.size() == ExpectedSizeValue && AbilityIds.size() == ExpectedSizeValue &&
+    return OrderHotFields.size() == ExpectedSizeValue && ParentOrderIds.size() == ExpectedSizeValue &&
+           SourceGoalIds.size() == ExpectedSizeValue && TaskPackageKinds.size() == ExpectedSizeValue &&
+           TaskNeedKinds.size() == ExpectedSizeValue && TaskTypes.size() == ExpectedSizeValue &&
+           TaskOrigins.size() == ExpectedSizeValue && CommitmentClasses.size() == ExpectedSizeValue &&
+           ExecutionGuarantees.size() == ExpectedSizeValue && RetentionPolicies.size() == ExpectedSizeValue &&
+           BlockedTaskWakeKinds.size() == ExpectedSizeValue && CreationSteps.size() == ExpectedSizeValue &&
+           DeadlineSteps.size() == ExpectedSizeValue && OwningArmyIndices.size() == ExpectedSizeValue &&
+           OwningSquadIndices.size() == ExpectedSizeValue && AbilityIds.size() == ExpectedSizeValue &&
            TargetKinds.size() == ExpectedSizeValue && TargetPoints.size() == ExpectedSizeValue &&
-           TargetUnitTags.size() == ExpectedSizeValue && QueuedValues.size() == ExpectedSizeValue &&
-           RequiresPlacementValidationValues.size() == ExpectedSizeValue &&
-           RequiresPathingValidationValues.size() == ExpectedSizeValue &&
-           PlanStepIds.size() == ExpectedSizeValue && TargetCounts.size() == ExpectedSizeValue &&
-           RequestedQueueCounts.size() == ExpectedSizeValue && ProducerUnitTypeIds.size() == ExpectedSizeValue &&
-           ResultUnitTypeIds.size() == ExpectedSizeValue && UpgradeIds.size() == ExpectedSizeValue &&
-           PreferredPlacementSlotTypes.size() == ExpectedSizeValue &&
+           TargetUnitTags.size() == ExpectedSizeValue && PlanStepIds.size() == ExpectedSizeValue &&
+           TargetCounts.size() == ExpectedSizeValue && RequestedQueueCounts.size() == ExpectedSizeValue &&
+           ProducerUnitTypeIds.size() == ExpectedSizeValue && ResultUnitTypeIds.size() == ExpectedSizeValue &&
+           UpgradeIds.size() == ExpectedSizeValue && PreferredPlacementSlotTypes.size() == ExpectedSizeValue &&
            PreferredPlacementSlotIdTypes.size() == ExpectedSizeValue &&
            PreferredPlacementSlotIdOrdinals.size() == ExpectedSizeValue &&
            PreferredProducerPlacementSlotIdTypes.size() == ExpectedSizeValue &&
            PreferredProducerPlacementSlotIdOrdinals.size() == ExpectedSizeValue &&
            ReservedPlacementSlotTypes.size() == ExpectedSizeValue &&
            ReservedPlacementSlotOrdinals.size() == ExpectedSizeValue &&
-           LastDeferralReasons.size() == ExpectedSizeValue && LastDeferralSteps.size() == ExpectedSizeValue &&
-           LastDeferralGameLoops.size() == ExpectedSizeValue &&
-           ConsecutiveDeferralCounts.size() == ExpectedSizeValue && DispatchSteps.size() == ExpectedSizeValue &&
+           LastDeferralReasons.size() == ExpectedSizeValue &&
+           ConsecutiveDeferralCounts.size() == ExpectedSizeValue &&
            DispatchGameLoops.size() == ExpectedSizeValue && ObservedCountsAtDispatch.size() == ExpectedSizeValue &&
            ObservedInConstructionCountsAtDispatch.size() == ExpectedSizeValue &&
-           DispatchAttemptCounts.size() == ExpectedSizeValue;
+           DispatchAttemptCounts.size() == ExpectedSizeValue &&
+           DiagnosticColumns.HasSize(bDiagnosticColumnsEnabled ? ExpectedSizeValue : 0U);
+}
+
+void FCommandAuthoritySchedulingState::SetDiagnosticColumnsEnabled(const bool bEnabledValue)
+{
+    if (bEnabledValue == bDiagnosticColumnsEnabled)
+    {
+        return;
+    }
+
+    bDiagnosticColumnsEnabled = bEnabledValue;
+    if (!bDiagnosticColumnsEnabled)
+    {
+        DiagnosticColumns.Release();
+        return;
+    }
+
+    const size_t OrderCountValue = OrderIds.size();
+    DiagnosticColumns.Reserve(OrderIds.capacity());
+    DiagnosticColumns.LastDeferralSteps.assign(OrderCountValue, 0U);
+    DiagnosticColumns.LastDeferralGameLoops.assign(OrderCountValue, 0U);
+    DiagnosticColumns.DispatchSteps.assign(OrderCountValue, 0U);
+}
+
+bool FCommandAuthoritySchedulingState::HasDiagnosticColumns() const
+{
+    return bDiagnosticColumnsEnabled;
 }
 
 void FCommandAuthoritySchedulingState::AssertSynchronizedSizes() const
@@ -339,7 +484,15 @@ void FCommandAuthoritySchedulingState::EndMutationBatch()
     --MutationBatchDepth;
     if (MutationBatchDepth == 0U && bDerivedQueuesDirty)
     {
-        RebuildDerivedQueues();
+        if (bDerivedQueuesRebuildRequired || PendingDerivedQueueOrderIndices.empty() ||
+            (PendingDerivedQueueOrderIndices.size() * IncrementalDerivedQueueUpdateDivisorValue) > OrderIds.size())
+        {
+            RebuildDerivedQueues();
+        }
+        else
+        {
+            ApplyPendingDerivedQueueUpdates();
+        }
     }
     if (MutationBatchDepth == 0U)
     {
@@ -352,8 +505,7 @@ void FCommandAuthoritySchedulingState::Reserve(const size_t OrderCapacityValue)
     OrderIds.reserve(OrderCapacityValue);
     ParentOrderIds.reserve(OrderCapacityValue);
     SourceGoalIds.reserve(OrderCapacityValue);
-    SourceLayers.reserve(OrderCapacityValue);
-    LifecycleStates.reserve(OrderCapacityValue);
+    OrderHotFields.reserve(OrderCapacityValue);
     TaskPackageKinds.reserve(OrderCapacityValue);
     TaskNeedKinds.reserve(OrderCapacityValue);
     TaskTypes.reserve(OrderCapacityValue);
@@ -362,22 +514,14 @@ void FCommandAuthoritySchedulingState::Reserve(const size_t OrderCapacityValue)
     ExecutionGuarantees.reserve(OrderCapacityValue);
     RetentionPolicies.reserve(OrderCapacityValue);
     BlockedTaskWakeKinds.reserve(OrderCapacityValue);
-    BasePriorityValues.reserve(OrderCapacityValue);
-    EffectivePriorityValues.reserve(OrderCapacityValue);
-    PriorityTiers.reserve(OrderCapacityValue);
-    IntentDomains.reserve(OrderCapacityValue);
     CreationSteps.reserve(OrderCapacityValue);
     DeadlineSteps.reserve(OrderCapacityValue);
     OwningArmyIndices.reserve(OrderCapacityValue);
     OwningSquadIndices.reserve(OrderCapacityValue);
-    ActorTags.reserve(OrderCapacityValue);
     AbilityIds.reserve(OrderCapacityValue);
     TargetKinds.reserve(OrderCapacityValue);
     TargetPoints.reserve(OrderCapacityValue);
     TargetUnitTags.reserve(OrderCapacityValue);
-    QueuedValues.reserve(OrderCapacityValue);
-    RequiresPlacementValidationValues.reserve(OrderCapacityValue);
-    RequiresPathingValidationValues.reserve(OrderCapacityValue);
     PlanStepIds.reserve(OrderCapacityValue);
     TargetCounts.reserve(OrderCapacityValue);
     RequestedQueueCounts.reserve(OrderCapacityValue);
@@ -392,14 +536,30 @@ void FCommandAuthoritySchedulingState::Reserve(const size_t OrderCapacityValue)
     ReservedPlacementSlotTypes.reserve(OrderCapacityValue);
     ReservedPlacementSlotOrdinals.reserve(OrderCapacityValue);
     LastDeferralReasons.reserve(OrderCapacityValue);
-    LastDeferralSteps.reserve(OrderCapacityValue);
-    LastDeferralGameLoops.reserve(OrderCapacityValue);
     ConsecutiveDeferralCounts.reserve(OrderCapacityValue);
-    DispatchSteps.reserve(OrderCapacityValue);
     DispatchGameLoops.reserve(OrderCapacityValue);
     ObservedCountsAtDispatch.reserve(OrderCapacityValue);
     ObservedInConstructionCountsAtDispatch.reserve(OrderCapacityValue);
     DispatchAttemptCounts.reserve(OrderCapacityValue);
+    if (bDiagnosticColumnsEnabled)
+    {
+        DiagnosticColumns.Reserve(OrderCapacityValue);
+    }
+    CompactionRetainedOrderIndices.reserve(OrderCapacityValue);
+    DerivedQueueKinds.reserve(OrderCapacityValue);
+    DerivedPriorityTierIndices.reserve(OrderCapacityValue);
+    DerivedPriorityValues.reserve(OrderCapacityValue);
+    PendingDerivedQueueFlags.reserve(OrderCapacityValue);
+    PendingDerivedQueueOrderIndices.reserve(OrderCapacityValue);
+
+    OrderIdToIndex.Reserve(OrderCapacityValue);
+    ActiveExecutionOrderIndexByActorTag.Reserve(OrderCapacityValue);
+    ActiveStrategicOrderIndexByGoalId.Reserve(OrderCapacityValue);
+    ActiveTaskSignatureCounts.Reserve(OrderCapacityValue);
+    ActiveChildOrderIndexByParentAndLayer.Reserve(OrderCapacityValue);
+    ActiveExecutionOrderCountsByActorTag.Reserve(OrderCapacityValue);
+    ActiveStrategicOrderCountsByGoalId.Reserve(OrderCapacityValue);
+    ActiveChildOrderCountsByParentAndLayer.Reserve(OrderCapacityValue);
 }
 
 uint32_t FCommandAuthoritySchedulingState::EnqueueOrder(const FCommandOrderRecord& CommandOrderRecordValue)
@@ -415,12 +575,23 @@ uint32_t FCommandAuthoritySchedulingState::EnqueueOrder(const FCommandOrderRecor
         NextOrderId = std::max(NextOrderId, StoredOrderValue.OrderId + 1U);
     }
 
+    FCommandOrderHotFields HotFieldsValue;
+    HotFieldsValue.ActorTag = StoredOrderValue.ActorTag;
+    HotFieldsValue.BasePriorityValue = StoredOrderValue.BasePriorityValue;
+    HotFieldsValue.EffectivePriorityValue = StoredOrderValue.EffectivePriorityValue;
+    HotFieldsValue.SourceLayer = StoredOrderValue.SourceLayer;
+    HotFieldsValue.LifecycleState = StoredOrderValue.LifecycleState;
+    HotFieldsValue.PriorityTier = StoredOrderValue.PriorityTier;
+    HotFieldsValue.IntentDomain = StoredOrderValue.IntentDomain;
+    HotFieldsValue.bQueued = StoredOrderValue.Queued ? 1U : 0U;
+    HotFieldsValue.bRequiresPlacementValidation = StoredOrderValue.RequiresPlacementValidation ? 1U : 0U;
+    HotFieldsValue.bRequiresPathingValidation = StoredOrderValue.RequiresPathingValidation ? 1U : 0U;
+
     const size_t OrderIndexValue = OrderIds.size();
     OrderIds.push_back(StoredOrderValue.OrderId);
+    OrderHotFields.push_back(HotFieldsValue);
     ParentOrderIds.push_back(StoredOrderValue.ParentOrderId);
     SourceGoalIds.push_back(StoredOrderValue.SourceGoalId);
-    SourceLayers.push_back(StoredOrderValue.SourceLayer);
-    LifecycleStates.push_back(StoredOrderValue.LifecycleState);
     TaskPackageKinds.push_back(StoredOrderValue.TaskPackageKind);
     TaskNeedKinds.push_back(StoredOrderValue.TaskNeedKind);
     TaskTypes.push_back(StoredOrderValue.TaskType);
@@ -429,22 +600,14 @@ uint32_t FCommandAuthoritySchedulingState::EnqueueOrder(const FCommandOrderRecor
     ExecutionGuarantees.push_back(StoredOrderValue.ExecutionGuarantee);
     RetentionPolicies.push_back(StoredOrderValue.RetentionPolicy);
     BlockedTaskWakeKinds.push_back(StoredOrderValue.BlockedTaskWakeKind);
-    BasePriorityValues.push_back(StoredOrderValue.BasePriorityValue);
-    EffectivePriorityValues.push_back(StoredOrderValue.EffectivePriorityValue);
-    PriorityTiers.push_back(StoredOrderValue.PriorityTier);
-    IntentDomains.push_back(StoredOrderValue.IntentDomain);
     CreationSteps.push_back(StoredOrderValue.CreationStep);
     DeadlineSteps.push_back(StoredOrderValue.DeadlineStep);
     OwningArmyIndices.push_back(StoredOrderValue.OwningArmyIndex);
     OwningSquadIndices.push_back(StoredOrderValue.OwningSquadIndex);
-    ActorTags.push_back(StoredOrderValue.ActorTag);
     AbilityIds.push_back(StoredOrderValue.AbilityId);
     TargetKinds.push_back(StoredOrderValue.TargetKind);
     TargetPoints.push_back(StoredOrderValue.TargetPoint);
     TargetUnitTags.push_back(StoredOrderValue.TargetUnitTag);
-    QueuedValues.push_back(StoredOrderValue.Queued);
-    RequiresPlacementValidationValues.push_back(StoredOrderValue.RequiresPlacementValidation);
-    RequiresPathingValidationValues.push_back(StoredOrderValue.RequiresPathingValidation);
     PlanStepIds.push_back(StoredOrderValue.PlanStepId);
     TargetCounts.push_back(StoredOrderValue.TargetCount);
     RequestedQueueCounts.push_back(StoredOrderValue.RequestedQueueCount);
@@ -459,17 +622,25 @@ uint32_t FCommandAuthoritySchedulingState::EnqueueOrder(const FCommandOrderRecor
     ReservedPlacementSlotTypes.push_back(StoredOrderValue.ReservedPlacementSlotId.SlotType);
     ReservedPlacementSlotOrdinals.push_back(StoredOrderValue.ReservedPlacementSlotId.Ordinal);
     LastDeferralReasons.push_back(StoredOrderValue.LastDeferralReason);
-    LastDeferralSteps.push_back(StoredOrderValue.LastDeferralStep);
-    LastDeferralGameLoops.push_back(StoredOrderValue.LastDeferralGameLoop);
     ConsecutiveDeferralCounts.push_back(StoredOrderValue.ConsecutiveDeferralCount);
-    DispatchSteps.push_back(StoredOrderValue.DispatchStep);
     DispatchGameLoops.push_back(StoredOrderValue.DispatchGameLoop);
     ObservedCountsAtDispatch.push_back(StoredOrderValue.ObservedCountAtDispatch);
     ObservedInConstructionCountsAtDispatch.push_back(StoredOrderValue.ObservedInConstructionCountAtDispatch);
     DispatchAttemptCounts.push_back(StoredOrderValue.DispatchAttemptCount);
-    OrderIdToIndex[StoredOrderValue.OrderId] = OrderIndexValue;
+    if (bDiagnosticColumnsEnabled)
+    {
+        DiagnosticColumns.LastDeferralSteps.push_back(StoredOrderValue.LastDeferralStep);
+        DiagnosticColumns.LastDeferralGameLoops.push_back(StoredOrderValue.LastDeferralGameLoop);
+        DiagnosticColumns.DispatchSteps.push_back(StoredOrderValue.DispatchStep);
+    }
+    OrderIdToIndex.Set(StoredOrderValue.OrderId, OrderIndexValue);
+    DerivedQueueKinds.push_back(ECommandOrderQueueKind::None);
+    DerivedPriorityTierIndices.push_back(0U);
+    DerivedPriorityValues.push_back(0);
+    PendingDerivedQueueFlags.push_back(0U);
 
-    MarkDerivedQueuesDirty();
+    bPrioritiesDirty = true;
+    MarkOrderDerivedQueueDirty(OrderIndexValue);
     AssertSynchronizedSizes();
     return StoredOrderValue.OrderId;
 }
@@ -481,14 +652,7 @@ bool FCommandAuthoritySchedulingState::IsOrderIndexValid(const size_t OrderIndex
 
 bool FCommandAuthoritySchedulingState::TryGetOrderIndex(const uint32_t OrderIdValue, size_t& OutOrderIndexValue) const
 {
-    const std::unordered_map<uint32_t, size_t>::const_iterator FoundOrderIndexValue = OrderIdToIndex.find(OrderIdValue);
-    if (FoundOrderIndexValue == OrderIdToIndex.end())
-    {
-        return false;
-    }
-
-    OutOrderIndexValue = FoundOrderIndexValue->second;
-    return true;
+    return OrderIdToIndex.TryGetValue(OrderIdValue, OutOrderIndexValue);
 }
 
 bool FCommandAuthoritySchedulingState::TryGetChildOrderIndex(const uint32_t ParentOrderIdValue,
@@ -497,7 +661,8 @@ bool FCommandAuthoritySchedulingState::TryGetChildOrderIndex(const uint32_t Pare
 {
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderIds.size(); ++OrderIndexValue)
     {
-        if (ParentOrderIds[OrderIndexValue] == ParentOrderIdValue && SourceLayers[OrderIndexValue] == SourceLayerValue)
+        if (ParentOrderIds[OrderIndexValue] ==
+                ParentOrderIdValue && OrderHotFields[OrderIndexValue].SourceLayer == SourceLayerValue)
         {
             OutOrderIndexValue = OrderIndexValue;
             return true;
@@ -513,22 +678,15 @@ bool FCommandAuthoritySchedulingState::TryGetActiveChildOrderIndex(const uint32_
 {
     if (!bDerivedQueuesDirty)
     {
-        const std::unordered_map<uint64_t, size_t>::const_iterator FoundOrderIndexValue =
-            ActiveChildOrderIndexByParentAndLayer.find(BuildActiveChildOrderKey(ParentOrderIdValue, SourceLayerValue));
-        if (FoundOrderIndexValue != ActiveChildOrderIndexByParentAndLayer.end())
-        {
-            OutOrderIndexValue = FoundOrderIndexValue->second;
-            return true;
-        }
-
-        return false;
+        return ActiveChildOrderIndexByParentAndLayer.TryGetValue(
+            BuildActiveChildOrderKey(ParentOrderIdValue, SourceLayerValue), OutOrderIndexValue);
     }
 
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderIds.size(); ++OrderIndexValue)
     {
         if (ParentOrderIds[OrderIndexValue] != ParentOrderIdValue ||
-            SourceLayers[OrderIndexValue] != SourceLayerValue ||
-            IsTerminalLifecycleState(LifecycleStates[OrderIndexValue]))
+            OrderHotFields[OrderIndexValue].SourceLayer != SourceLayerValue ||
+            IsTerminalLifecycleState(OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -545,22 +703,14 @@ bool FCommandAuthoritySchedulingState::TryGetActiveExecutionOrderIndexForActor(c
 {
     if (!bDerivedQueuesDirty)
     {
-        const std::unordered_map<Tag, size_t>::const_iterator FoundOrderIndexValue =
-            ActiveExecutionOrderIndexByActorTag.find(ActorTagValue);
-        if (FoundOrderIndexValue != ActiveExecutionOrderIndexByActorTag.end())
-        {
-            OutOrderIndexValue = FoundOrderIndexValue->second;
-            return true;
-        }
-
-        return false;
+        return ActiveExecutionOrderIndexByActorTag.TryGetValue(ActorTagValue, OutOrderIndexValue);
     }
 
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderIds.size(); ++OrderIndexValue)
     {
-        if (SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::UnitExecution ||
-            ActorTags[OrderIndexValue] != ActorTagValue ||
-            IsTerminalLifecycleState(LifecycleStates[OrderIndexValue]))
+        if (OrderHotFields[OrderIndexValue].SourceLayer != ECommandAuthorityLayer::UnitExecution ||
+            OrderHotFields[OrderIndexValue].ActorTag != ActorTagValue ||
+            IsTerminalLifecycleState(OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -588,8 +738,8 @@ FCommandOrderRecord FCommandAuthoritySchedulingState::GetOrderRecord(const size_
     CommandOrderRecordValue.OrderId = OrderIds[OrderIndexValue];
     CommandOrderRecordValue.ParentOrderId = ParentOrderIds[OrderIndexValue];
     CommandOrderRecordValue.SourceGoalId = SourceGoalIds[OrderIndexValue];
-    CommandOrderRecordValue.SourceLayer = SourceLayers[OrderIndexValue];
-    CommandOrderRecordValue.LifecycleState = LifecycleStates[OrderIndexValue];
+    CommandOrderRecordValue.SourceLayer = OrderHotFields[OrderIndexValue].SourceLayer;
+    CommandOrderRecordValue.LifecycleState = OrderHotFields[OrderIndexValue].LifecycleState;
     CommandOrderRecordValue.TaskPackageKind = TaskPackageKinds[OrderIndexValue];
     CommandOrderRecordValue.TaskNeedKind = TaskNeedKinds[OrderIndexValue];
     CommandOrderRecordValue.TaskType = TaskTypes[OrderIndexValue];
@@ -598,22 +748,22 @@ FCommandOrderRecord FCommandAuthoritySchedulingState::GetOrderRecord(const size_
     CommandOrderRecordValue.ExecutionGuarantee = ExecutionGuarantees[OrderIndexValue];
     CommandOrderRecordValue.RetentionPolicy = RetentionPolicies[OrderIndexValue];
     CommandOrderRecordValue.BlockedTaskWakeKind = BlockedTaskWakeKinds[OrderIndexValue];
-    CommandOrderRecordValue.BasePriorityValue = BasePriorityValues[OrderIndexValue];
-    CommandOrderRecordValue.EffectivePriorityValue = EffectivePriorityValues[OrderIndexValue];
-    CommandOrderRecordValue.PriorityTier = PriorityTiers[OrderIndexValue];
-    CommandOrderRecordValue.IntentDomain = IntentDomains[OrderIndexValue];
+    CommandOrderRecordValue.BasePriorityValue = OrderHotFields[OrderIndexValue].BasePriorityValue;
+    CommandOrderRecordValue.EffectivePriorityValue = OrderHotFields[OrderIndexValue].EffectivePriorityValue;
+    CommandOrderRecordValue.PriorityTier = OrderHotFields[OrderIndexValue].PriorityTier;
+    CommandOrderRecordValue.IntentDomain = OrderHotFields[OrderIndexValue].IntentDomain;
     CommandOrderRecordValue.CreationStep = CreationSteps[OrderIndexValue];
     CommandOrderRecordValue.DeadlineStep = DeadlineSteps[OrderIndexValue];
     CommandOrderRecordValue.OwningArmyIndex = OwningArmyIndices[OrderIndexValue];
     CommandOrderRecordValue.OwningSquadIndex = OwningSquadIndices[OrderIndexValue];
-    CommandOrderRecordValue.ActorTag = ActorTags[OrderIndexValue];
+    CommandOrderRecordValue.ActorTag = OrderHotFields[OrderIndexValue].ActorTag;
     CommandOrderRecordValue.AbilityId = AbilityIds[OrderIndexValue];
     CommandOrderRecordValue.TargetKind = TargetKinds[OrderIndexValue];
     CommandOrderRecordValue.TargetPoint = TargetPoints[OrderIndexValue];
     CommandOrderRecordValue.TargetUnitTag = TargetUnitTags[OrderIndexValue];
-    CommandOrderRecordValue.Queued = QueuedValues[OrderIndexValue];
-    CommandOrderRecordValue.RequiresPlacementValidation = RequiresPlacementValidationValues[OrderIndexValue];
-    CommandOrderRecordValue.RequiresPathingValidation = RequiresPathingValidationValues[OrderIndexValue];
+    CommandOrderRecordValue.Queued = OrderHotFields[OrderIndexValue].bQueued;
+    CommandOrderRecordValue.RequiresPlacementValidation = OrderHotFields[OrderIndexValue].bRequiresPlacementValidation;
+    CommandOrderRecordValue.RequiresPathingValidation = OrderHotFields[OrderIndexValue].bRequiresPathingValidation;
     CommandOrderRecordValue.PlanStepId = PlanStepIds[OrderIndexValue];
     CommandOrderRecordValue.TargetCount = TargetCounts[OrderIndexValue];
     CommandOrderRecordValue.RequestedQueueCount = RequestedQueueCounts[OrderIndexValue];
@@ -630,18 +780,26 @@ FCommandOrderRecord FCommandAuthoritySchedulingState::GetOrderRecord(const size_
     CommandOrderRecordValue.ReservedPlacementSlotId.SlotType = ReservedPlacementSlotTypes[OrderIndexValue];
     CommandOrderRecordValue.ReservedPlacementSlotId.Ordinal = ReservedPlacementSlotOrdinals[OrderIndexValue];
     CommandOrderRecordValue.LastDeferralReason = LastDeferralReasons[OrderIndexValue];
-    CommandOrderRecordValue.LastDeferralStep = LastDeferralSteps[OrderIndexValue];
-    CommandOrderRecordValue.LastDeferralGameLoop = LastDeferralGameLoops[OrderIndexValue];
     CommandOrderRecordValue.ConsecutiveDeferralCount = ConsecutiveDeferralCounts[OrderIndexValue];
-    CommandOrderRecordValue.DispatchStep = DispatchSteps[OrderIndexValue];
     CommandOrderRecordValue.DispatchGameLoop = DispatchGameLoops[OrderIndexValue];
     CommandOrderRecordValue.ObservedCountAtDispatch = ObservedCountsAtDispatch[OrderIndexValue];
     CommandOrderRecordValue.ObservedInConstructionCountAtDispatch =
         ObservedInConstructionCountsAtDispatch[OrderIndexValue];
     CommandOrderRecordValue.DispatchAttemptCount = DispatchAttemptCounts[OrderIndexValue];
+    if (bDiagnosticColumnsEnabled)
+    {
+        CommandOrderRecordValue.LastDeferralStep = DiagnosticColumns.LastDeferralSteps[OrderIndexValue];
+        CommandOrderRecordValue.LastDeferralGameLoop = DiagnosticColumns.LastDeferralGameLoops[OrderIndexValue];
+        CommandOrderRecordValue.DispatchStep = DiagnosticColumns.DispatchSteps[OrderIndexValue];
+    }
     return CommandOrderRecordValue;
 }
 
+FCommandOrderView FCommandAuthoritySchedulingState::GetOrderView(const size_t OrderIndexValue) const
+{
+    return FCommandOrderView(*this, OrderIndexValue);
+}
+
 bool FCommandAuthoritySchedulingState::HasActiveStrategicOrderForGoalId(const uint32_t SourceGoalIdValue) const
 {
     if (SourceGoalIdValue == 0U)
@@ -651,14 +809,14 @@ bool FCommandAuthoritySchedulingState::HasActiveStrategicOrderForGoalId(const ui
 
     if (!bDerivedQueuesDirty)
     {
-        return ActiveStrategicOrderIndexByGoalId.find(SourceGoalIdValue) != ActiveStrategicOrderIndexByGoalId.end();
+        return ActiveStrategicOrderIndexByGoalId.Contains(SourceGoalIdValue);
     }
 
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderIds.size(); ++OrderIndexValue)
     {
-        if (SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::StrategicDirector ||
+        if (OrderHotFields[OrderIndexValue].SourceLayer != ECommandAuthorityLayer::StrategicDirector ||
             SourceGoalIds[OrderIndexValue] != SourceGoalIdValue ||
-            IsTerminalLifecycleState(LifecycleStates[OrderIndexValue]))
+            IsTerminalLifecycleState(OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -674,14 +832,13 @@ bool FCommandAuthoritySchedulingState::HasEquivalentActiveTaskSignature(
 {
     if (!bDerivedQueuesDirty)
     {
-        const std::unordered_map<FCommandTaskSignatureKey, uint32_t, FCommandTaskSignatureKeyHash>::const_iterator
-            FoundActiveSignatureValue = ActiveTaskSignatureCounts.find(CommandTaskSignatureKeyValue);
-        return FoundActiveSignatureValue != ActiveTaskSignatureCounts.end() && FoundActiveSignatureValue->second > 0U;
+        const uint32_t* ActiveSignatureCountPtrValue = ActiveTaskSignatureCounts.FindValue(CommandTaskSignatureKeyValue);
+        return ActiveSignatureCountPtrValue != nullptr && *ActiveSignatureCountPtrValue > 0U;
     }
 
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderIds.size(); ++OrderIndexValue)
     {
-        if (IsTerminalLifecycleState(LifecycleStates[OrderIndexValue]))
+        if (IsTerminalLifecycleState(OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -704,19 +861,19 @@ bool FCommandAuthoritySchedulingState::SetOrderLifecycleState(const uint32_t Ord
         return false;
     }
 
-    if (LifecycleStates[OrderIndexValue] == LifecycleStateValue)
+    if (OrderHotFields[OrderIndexValue].LifecycleState == LifecycleStateValue)
     {
         return true;
     }
 
-    LifecycleStates[OrderIndexValue] = LifecycleStateValue;
+    OrderHotFields[OrderIndexValue].LifecycleState = LifecycleStateValue;
     bPrioritiesDirty = true;
     if (IsTerminalLifecycleState(LifecycleStateValue))
     {
         ReservedPlacementSlotTypes[OrderIndexValue] = EBuildPlacementSlotType::Unknown;
         ReservedPlacementSlotOrdinals[OrderIndexValue] = 0U;
     }
-    MarkDerivedQueuesDirty();
+    MarkOrderDerivedQueueDirty(OrderIndexValue);
     return true;
 }
 
@@ -740,8 +897,11 @@ bool FCommandAuthoritySchedulingState::SetOrderDeferralState(const uint32_t Orde
         ConsecutiveDeferralCounts[OrderIndexValue] = 1U;
     }
     LastDeferralReasons[OrderIndexValue] = DeferralReasonValue;
-    LastDeferralSteps[OrderIndexValue] = CurrentStepValue;
-    LastDeferralGameLoops[OrderIndexValue] = CurrentGameLoopValue;
+    if (bDiagnosticColumnsEnabled)
+    {
+        DiagnosticColumns.LastDeferralSteps[OrderIndexValue] = CurrentStepValue;
+        DiagnosticColumns.LastDeferralGameLoops[OrderIndexValue] = CurrentGameLoopValue;
+    }
     bPrioritiesDirty = true;
     return true;
 }
@@ -755,13 +915,37 @@ bool FCommandAuthoritySchedulingState::ClearOrderDeferralState(const uint32_t Or
     }
 
     LastDeferralReasons[OrderIndexValue] = ECommandOrderDeferralReason::None;
-    LastDeferralSteps[OrderIndexValue] = 0U;
-    LastDeferralGameLoops[OrderIndexValue] = 0U;
     ConsecutiveDeferralCounts[OrderIndexValue] = 0U;
+    if (bDiagnosticColumnsEnabled)
+    {
+        DiagnosticColumns.LastDeferralSteps[OrderIndexValue] = 0U;
+        DiagnosticColumns.LastDeferralGameLoops[OrderIndexValue] = 0U;
+    }
     bPrioritiesDirty = true;
     return true;
 }
 
+bool FCommandAuthoritySchedulingState::SetOrderPriorityByIndex(const size_t OrderIndexValue,
+                                                               const int EffectivePriorityValue,
+                                                               const ECommandPriorityTier PriorityTierValue)
+{
+    if (!IsOrderIndexValid(OrderIndexValue))
+    {
+        return false;
+    }
+
+    if (OrderHotFields[OrderIndexValue].EffectivePriorityValue == EffectivePriorityValue &&
+        OrderHotFields[OrderIndexValue].PriorityTier == PriorityTierValue)
+    {
+        return true;
+    }
+
+    OrderHotFields[OrderIndexValue].EffectivePriorityValue = EffectivePriorityValue;
+    OrderHotFields[OrderIndexValue].PriorityTier = PriorityTierValue;
+    MarkOrderDerivedQueueDirty(OrderIndexValue);
+    return true;
+}
+
 bool FCommandAuthoritySchedulingState::SetOrderDispatchState(const uint32_t OrderIdValue,
                                                              const uint64_t DispatchStepValue,
                                                              const uint64_t DispatchGameLoopValue,
@@ -774,15 +958,18 @@ bool FCommandAuthoritySchedulingState::SetOrderDispatchState(const uint32_t Orde
         return false;
     }
 
-    DispatchSteps[OrderIndexValue] = DispatchStepValue;
     DispatchGameLoops[OrderIndexValue] = DispatchGameLoopValue;
     ObservedCountsAtDispatch[OrderIndexValue] = ObservedCountValue;
     ObservedInConstructionCountsAtDispatch[OrderIndexValue] = ObservedInConstructionCountValue;
     ++DispatchAttemptCounts[OrderIndexValue];
     LastDeferralReasons[OrderIndexValue] = ECommandOrderDeferralReason::None;
-    LastDeferralSteps[OrderIndexValue] = 0U;
-    LastDeferralGameLoops[OrderIndexValue] = 0U;
     ConsecutiveDeferralCounts[OrderIndexValue] = 0U;
+    if (bDiagnosticColumnsEnabled)
+    {
+        DiagnosticColumns.DispatchSteps[OrderIndexValue] = DispatchStepValue;
+        DiagnosticColumns.LastDeferralSteps[OrderIndexValue] = 0U;
+        DiagnosticColumns.LastDeferralGameLoops[OrderIndexValue] = 0U;
+    }
     return true;
 }
 
@@ -821,8 +1008,8 @@ bool FCommandAuthoritySchedulingState::CompactTerminalOrders(
         return false;
     }
 
-    std::vector<size_t> RetainedOrderIndicesValue;
-    RetainedOrderIndicesValue.reserve(OrderIds.size());
+    std::vector<size_t>& RetainedOrderIndicesValue = CompactionRetainedOrderIndices;
+    RetainedOrderIndicesValue.clear();
 
     bool bCompactedAnyOrderValue = false;
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderIds.size(); ++OrderIndexValue)
@@ -841,67 +1028,56 @@ bool FCommandAuthoritySchedulingState::CompactTerminalOrders(
         return false;
     }
 
-    OrderIds = BuildCompactedVector(OrderIds, RetainedOrderIndicesValue);
-    ParentOrderIds = BuildCompactedVector(ParentOrderIds, RetainedOrderIndicesValue);
-    SourceGoalIds = BuildCompactedVector(SourceGoalIds, RetainedOrderIndicesValue);
-    SourceLayers = BuildCompactedVector(SourceLayers, RetainedOrderIndicesValue);
-    LifecycleStates = BuildCompactedVector(LifecycleStates, RetainedOrderIndicesValue);
-    TaskPackageKinds = BuildCompactedVector(TaskPackageKinds, RetainedOrderIndicesValue);
-    TaskNeedKinds = BuildCompactedVector(TaskNeedKinds, RetainedOrderIndicesValue);
-    TaskTypes = BuildCompactedVector(TaskTypes, RetainedOrderIndicesValue);
-    TaskOrigins = BuildCompactedVector(TaskOrigins, RetainedOrderIndicesValue);
-    CommitmentClasses = BuildCompactedVector(CommitmentClasses, RetainedOrderIndicesValue);
-    ExecutionGuarantees = BuildCompactedVector(ExecutionGuarantees, RetainedOrderIndicesValue);
-    RetentionPolicies = BuildCompactedVector(RetentionPolicies, RetainedOrderIndicesValue);
-    BlockedTaskWakeKinds = BuildCompactedVector(BlockedTaskWakeKinds, RetainedOrderIndicesValue);
-    BasePriorityValues = BuildCompactedVector(BasePriorityValues, RetainedOrderIndicesValue);
-    EffectivePriorityValues = BuildCompactedVector(EffectivePriorityValues, RetainedOrderIndicesValue);
-    PriorityTiers = BuildCompactedVector(PriorityTiers, RetainedOrderIndicesValue);
-    IntentDomains = BuildCompactedVector(IntentDomains, RetainedOrderIndicesValue);
-    CreationSteps = BuildCompactedVector(CreationSteps, RetainedOrderIndicesValue);
-    DeadlineSteps = BuildCompactedVector(DeadlineSteps, RetainedOrderIndicesValue);
-    OwningArmyIndices = BuildCompactedVector(OwningArmyIndices, RetainedOrderIndicesValue);
-    OwningSquadIndices = BuildCompactedVector(OwningSquadIndices, RetainedOrderIndicesValue);
-    ActorTags = BuildCompactedVector(ActorTags, RetainedOrderIndicesValue);
-    AbilityIds = BuildCompactedVector(AbilityIds, RetainedOrderIndicesValue);
-    TargetKinds = BuildCompactedVector(TargetKinds, RetainedOrderIndicesValue);
-    TargetPoints = BuildCompactedVector(TargetPoints, RetainedOrderIndicesValue);
-    TargetUnitTags = BuildCompactedVector(TargetUnitTags, RetainedOrderIndicesValue);
-    QueuedValues = BuildCompactedVector(QueuedValues, RetainedOrderIndicesValue);
-    RequiresPlacementValidationValues =
-        BuildCompactedVector(RequiresPlacementValidationValues, RetainedOrderIndicesValue);
-    RequiresPathingValidationValues = BuildCompactedVector(RequiresPathingValidationValues, RetainedOrderIndicesValue);
-    PlanStepIds = BuildCompactedVector(PlanStepIds, RetainedOrderIndicesValue);
-    TargetCounts = BuildCompactedVector(TargetCounts, RetainedOrderIndicesValue);
-    RequestedQueueCounts = BuildCompactedVector(RequestedQueueCounts, RetainedOrderIndicesValue);
-    ProducerUnitTypeIds = BuildCompactedVector(ProducerUnitTypeIds, RetainedOrderIndicesValue);
-    ResultUnitTypeIds = BuildCompactedVector(ResultUnitTypeIds, RetainedOrderIndicesValue);
-    UpgradeIds = BuildCompactedVector(UpgradeIds, RetainedOrderIndicesValue);
-    PreferredPlacementSlotTypes = BuildCompactedVector(PreferredPlacementSlotTypes, RetainedOrderIndicesValue);
-    PreferredPlacementSlotIdTypes = BuildCompactedVector(PreferredPlacementSlotIdTypes, RetainedOrderIndicesValue);
-    PreferredPlacementSlotIdOrdinals =
-        BuildCompactedVector(PreferredPlacementSlotIdOrdinals, RetainedOrderIndicesValue);
-    PreferredProducerPlacementSlotIdTypes =
-        BuildCompactedVector(PreferredProducerPlacementSlotIdTypes, RetainedOrderIndicesValue);
-    PreferredProducerPlacementSlotIdOrdinals =
-        BuildCompactedVector(PreferredProducerPlacementSlotIdOrdinals, RetainedOrderIndicesValue);
-    ReservedPlacementSlotTypes = BuildCompactedVector(ReservedPlacementSlotTypes, RetainedOrderIndicesValue);
-    ReservedPlacementSlotOrdinals = BuildCompactedVector(ReservedPlacementSlotOrdinals, RetainedOrderIndicesValue);
-    LastDeferralReasons = BuildCompactedVector(LastDeferralReasons, RetainedOrderIndicesValue);
-    LastDeferralSteps = BuildCompactedVector(LastDeferralSteps, RetainedOrderIndicesValue);
-    LastDeferralGameLoops = BuildCompactedVector(LastDeferralGameLoops, RetainedOrderIndicesValue);
-    ConsecutiveDeferralCounts = BuildCompactedVector(ConsecutiveDeferralCounts, RetainedOrderIndicesValue);
-    DispatchSteps = BuildCompactedVector(DispatchSteps, RetainedOrderIndicesValue);
-    DispatchGameLoops = BuildCompactedVector(DispatchGameLoops, RetainedOrderIndicesValue);
-    ObservedCountsAtDispatch = BuildCompactedVector(ObservedCountsAtDispatch, RetainedOrderIndicesValue);
-    ObservedInConstructionCountsAtDispatch =
-        BuildCompactedVector(ObservedInConstructionCountsAtDispatch, RetainedOrderIndicesValue);
-    DispatchAttemptCounts = BuildCompactedVector(DispatchAttemptCounts, RetainedOrderIndicesValue);
-
-    OrderIdToIndex.clear();
+    CompactVectorInPlace(OrderIds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(ParentOrderIds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(SourceGoalIds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(OrderHotFields, RetainedOrderIndicesValue);
+    CompactVectorInPlace(TaskPackageKinds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(TaskNeedKinds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(TaskTypes, RetainedOrderIndicesValue);
+    CompactVectorInPlace(TaskOrigins, RetainedOrderIndicesValue);
+    CompactVectorInPlace(CommitmentClasses, RetainedOrderIndicesValue);
+    CompactVectorInPlace(ExecutionGuarantees, RetainedOrderIndicesValue);
+    CompactVectorInPlace(RetentionPolicies, RetainedOrderIndicesValue);
+    CompactVectorInPlace(BlockedTaskWakeKinds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(CreationSteps, RetainedOrderIndicesValue);
+    CompactVectorInPlace(DeadlineSteps, RetainedOrderIndicesValue);
+    CompactVectorInPlace(OwningArmyIndices, RetainedOrderIndicesValue);
+    CompactVectorInPlace(OwningSquadIndices, RetainedOrderIndicesValue);
+    CompactVectorInPlace(AbilityIds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(TargetKinds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(TargetPoints, RetainedOrderIndicesValue);
+    CompactVectorInPlace(TargetUnitTags, RetainedOrderIndicesValue);
+    CompactVectorInPlace(PlanStepIds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(TargetCounts, RetainedOrderIndicesValue);
+    CompactVectorInPlace(RequestedQueueCounts, RetainedOrderIndicesValue);
+    CompactVectorInPlace(ProducerUnitTypeIds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(ResultUnitTypeIds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(UpgradeIds, RetainedOrderIndicesValue);
+    CompactVectorInPlace(PreferredPlacementSlotTypes, RetainedOrderIndicesValue);
+    CompactVectorInPlace(PreferredPlacementSlotIdTypes, RetainedOrderIndicesValue);
+    CompactVectorInPlace(PreferredPlacementSlotIdOrdinals, RetainedOrderIndicesValue);
+    CompactVectorInPlace(PreferredProducerPlacementSlotIdTypes, RetainedOrderIndicesValue);
+    CompactVectorInPlace(PreferredProducerPlacementSlotIdOrdinals, RetainedOrderIndicesValue);
+    CompactVectorInPlace(ReservedPlacementSlotTypes, RetainedOrderIndicesValue);
+    CompactVectorInPlace(ReservedPlacementSlotOrdinals, RetainedOrderIndicesValue);
+    CompactVectorInPlace(LastDeferralReasons, RetainedOrderIndicesValue);
+    CompactVectorInPlace(ConsecutiveDeferralCounts, RetainedOrderIndicesValue);
+    CompactVectorInPlace(DispatchGameLoops, RetainedOrderIndicesValue);
+    CompactVectorInPlace(ObservedCountsAtDispatch, RetainedOrderIndicesValue);
+    CompactVectorInPlace(ObservedInConstructionCountsAtDispatch, RetainedOrderIndicesValue);
+    CompactVectorInPlace(DispatchAttemptCounts, RetainedOrderIndicesValue);
+    if (bDiagnosticColumnsEnabled)
+    {
+        CompactVectorInPlace(DiagnosticColumns.LastDeferralSteps, RetainedOrderIndicesValue);
+        CompactVectorInPlace(DiagnosticColumns.LastDeferralGameLoops, RetainedOrderIndicesValue);
+        CompactVectorInPlace(DiagnosticColumns.DispatchSteps, RetainedOrderIndicesValue);
+    }
+
+    OrderIdToIndex.Clear();
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderIds.size(); ++OrderIndexValue)
     {
-        OrderIdToIndex.emplace(OrderIds[OrderIndexValue], OrderIndexValue);
+        OrderIdToIndex.Set(OrderIds[OrderIndexValue], OrderIndexValue);
     }
 
     MarkDerivedQueuesDirty();
@@ -921,8 +1097,8 @@ size_t FCommandAuthoritySchedulingState::GetActiveOrderCountForLayer(
 
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderIds.size(); ++OrderIndexValue)
     {
-        if (SourceLayers[OrderIndexValue] != SourceLayerValue ||
-            IsTerminalLifecycleState(LifecycleStates[OrderIndexValue]))
+        if (OrderHotFields[OrderIndexValue].SourceLayer != SourceLayerValue ||
+            IsTerminalLifecycleState(OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -936,6 +1112,13 @@ size_t FCommandAuthoritySchedulingState::GetActiveOrderCountForLayer(
 void FCommandAuthoritySchedulingState::RebuildDerivedQueues()
 {
     bDerivedQueuesDirty = false;
+    bDerivedQueuesRebuildRequired = false;
+    const size_t OrderCountValue = OrderIds.size();
+    DerivedQueueKinds.resize(OrderCountValue);
+    DerivedPriorityTierIndices.resize(OrderCountValue);
+    DerivedPriorityValues.resize(OrderCountValue);
+    PendingDerivedQueueFlags.assign(OrderCountValue, 0U);
+    PendingDerivedQueueOrderIndices.clear();
     StrategicOrderIndices.clear();
     PlanningProcessIndices.clear();
     ArmyOrderIndices.clear();
@@ -943,10 +1126,13 @@ void FCommandAuthoritySchedulingState::RebuildDerivedQueues()
     ReadyIntentIndices.clear();
     DispatchedOrderIndices.clear();
     CompletedOrderIndices.clear();
-    ActiveExecutionOrderIndexByActorTag.clear();
-    ActiveStrategicOrderIndexByGoalId.clear();
-    ActiveTaskSignatureCounts.clear();
-    ActiveChildOrderIndexByParentAndLayer.clear();
+    ActiveExecutionOrderIndexByActorTag.Clear();
+    ActiveStrategicOrderIndexByGoalId.Clear();
+    ActiveTaskSignatureCounts.Clear();
+    ActiveChildOrderIndexByParentAndLayer.Clear();
+    ActiveExecutionOrderCountsByActorTag.Clear();
+    ActiveStrategicOrderCountsByGoalId.Clear();
+    ActiveChildOrderCountsByParentAndLayer.Clear();
     ActiveOrderCountsByLayer.fill(0U);
     for (std::vector<size_t>& StrategicQueueValue : StrategicQueues)
     {
@@ -972,53 +1158,54 @@ void FCommandAuthoritySchedulingState::RebuildDerivedQueues()
         }
     }
 
-    for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderIds.size(); ++OrderIndexValue)
+    for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
     {
-        if (!IsTerminalLifecycleState(LifecycleStates[OrderIndexValue]))
+        DerivedQueueKinds[OrderIndexValue] = GetCurrentQueueKind(OrderIndexValue);
+        DerivedPriorityTierIndices[OrderIndexValue] =
+            static_cast<uint8_t>(GetCommandPriorityTierIndex(OrderHotFields[OrderIndexValue].PriorityTier));
+        DerivedPriorityValues[OrderIndexValue] = OrderHotFields[OrderIndexValue].EffectivePriorityValue;
+
+        if (!IsTerminalLifecycleState(OrderHotFields[OrderIndexValue].LifecycleState))
         {
-            ++ActiveOrderCountsByLayer[GetCommandAuthorityLayerIndex(SourceLayers[OrderIndexValue])];
-            ++ActiveTaskSignatureCounts[BuildTaskSignatureKeyForOrderIndex(*this, OrderIndexValue)];
+            ++ActiveOrderCountsByLayer[GetCommandAuthorityLayerIndex(OrderHotFields[OrderIndexValue].SourceLayer)];
+            ++ActiveTaskSignatureCounts.FindOrAdd(BuildTaskSignatureKeyForOrderIndex(*this, OrderIndexValue));
 
-            if (SourceLayers[OrderIndexValue] == ECommandAuthorityLayer::StrategicDirector &&
-                SourceGoalIds[OrderIndexValue] != 0U &&
-                ActiveStrategicOrderIndexByGoalId.find(SourceGoalIds[OrderIndexValue]) ==
-                    ActiveStrategicOrderIndexByGoalId.end())
+            if (OrderHotFields[OrderIndexValue].SourceLayer == ECommandAuthorityLayer::StrategicDirector &&
+                SourceGoalIds[OrderIndexValue] != 0U)
             {
-                ActiveStrategicOrderIndexByGoalId.emplace(SourceGoalIds[OrderIndexValue], OrderIndexValue);
+                ActiveStrategicOrderIndexByGoalId.TryAdd(SourceGoalIds[OrderIndexValue], OrderIndexValue);
+                ++ActiveStrategicOrderCountsByGoalId.FindOrAdd(SourceGoalIds[OrderIndexValue]);
             }
 
-            if (SourceLayers[OrderIndexValue] == ECommandAuthorityLayer::UnitExecution &&
-                ActorTags[OrderIndexValue] != NullTag &&
-                ActiveExecutionOrderIndexByActorTag.find(ActorTags[OrderIndexValue]) ==
-                    ActiveExecutionOrderIndexByActorTag.end())
+            if (OrderHotFields[OrderIndexValue].SourceLayer == ECommandAuthorityLayer::UnitExecution &&
+                OrderHotFields[OrderIndexValue].ActorTag != NullTag)
             {
-                ActiveExecutionOrderIndexByActorTag.emplace(ActorTags[OrderIndexValue], OrderIndexValue);
+                ActiveExecutionOrderIndexByActorTag.TryAdd(OrderHotFields[OrderIndexValue].ActorTag, OrderIndexValue);
+                ++ActiveExecutionOrderCountsByActorTag.FindOrAdd(OrderHotFields[OrderIndexValue].ActorTag);
             }
 
             if (ParentOrderIds[OrderIndexValue] != 0U)
             {
-                const uint64_t ActiveChildOrderKeyValue =
-                    BuildActiveChildOrderKey(ParentOrderIds[OrderIndexValue], SourceLayers[OrderIndexValue]);
-                if (ActiveChildOrderIndexByParentAndLayer.find(ActiveChildOrderKeyValue) ==
-                    ActiveChildOrderIndexByParentAndLayer.end())
-                {
-                    ActiveChildOrderIndexByParentAndLayer.emplace(ActiveChildOrderKeyValue, OrderIndexValue);
-                }
+                const uint64_t ActiveChildOrderKeyValue = BuildActiveChildOrderKey(
+                    ParentOrderIds[OrderIndexValue], OrderHotFields[OrderIndexValue].SourceLayer);
+                ActiveChildOrderIndexByParentAndLayer.TryAdd(ActiveChildOrderKeyValue, OrderIndexValue);
+                ++ActiveChildOrderCountsByParentAndLayer.FindOrAdd(ActiveChildOrderKeyValue);
             }
         }
 
-        switch (LifecycleStates[OrderIndexValue])
+        switch (OrderHotFields[OrderIndexValue].LifecycleState)
         {
             case EOrderLifecycleState::Queued:
                 AppendQueuedOrderIndex(OrderIndexValue);
                 break;
             case EOrderLifecycleState::Preprocessing:
                 PlanningProcessIndices.push_back(OrderIndexValue);
-                PlanningQueues[GetCommandPriorityTierIndex(PriorityTiers[OrderIndexValue])].push_back(OrderIndexValue);
+                PlanningQueues[GetCommandPriorityTierIndex(OrderHotFields[OrderIndexValue].PriorityTier)].push_back(
+                    OrderIndexValue);
                 break;
             case EOrderLifecycleState::Ready:
-                ReadyIntentQueues[GetCommandPriorityTierIndex(PriorityTiers[OrderIndexValue])]
-                                 [GetIntentDomainIndex(IntentDomains[OrderIndexValue])]
+                ReadyIntentQueues[GetCommandPriorityTierIndex(OrderHotFields[OrderIndexValue].PriorityTier)]
+                                 [GetIntentDomainIndex(OrderHotFields[OrderIndexValue].IntentDomain)]
                                      .push_back(OrderIndexValue);
                 break;
             case EOrderLifecycleState::Dispatched:
@@ -1083,8 +1270,8 @@ void FCommandAuthoritySchedulingState::RebuildPlaybackState()
 
 void FCommandAuthoritySchedulingState::AppendQueuedOrderIndex(const size_t OrderIndexValue)
 {
-    const size_t PriorityTierIndexValue = GetCommandPriorityTierIndex(PriorityTiers[OrderIndexValue]);
-    switch (SourceLayers[OrderIndexValue])
+    const size_t PriorityTierIndexValue = GetCommandPriorityTierIndex(OrderHotFields[OrderIndexValue].PriorityTier);
+    switch (OrderHotFields[OrderIndexValue].SourceLayer)
     {
         case ECommandAuthorityLayer::Agent:
         case ECommandAuthorityLayer::StrategicDirector:
@@ -1112,21 +1299,7 @@ void FCommandAuthoritySchedulingState::SortDerivedQueues()
     const auto OrderPriorityComparatorValue =
         [this](const size_t LeftOrderIndexValue, const size_t RightOrderIndexValue)
         {
-            if (EffectivePriorityValues[LeftOrderIndexValue] != EffectivePriorityValues[RightOrderIndexValue])
-            {
-                return EffectivePriorityValues[LeftOrderIndexValue] > EffectivePriorityValues[RightOrderIndexValue];
-            }
-            if (GetIntentDomainOrder(IntentDomains[LeftOrderIndexValue]) !=
-                GetIntentDomainOrder(IntentDomains[RightOrderIndexValue]))
-            {
-                return GetIntentDomainOrder(IntentDomains[LeftOrderIndexValue]) <
-                       GetIntentDomainOrder(IntentDomains[RightOrderIndexValue]);
-            }
-            if (CreationSteps[LeftOrderIndexValue] != CreationSteps[RightOrderIndexValue])
-            {
-                return CreationSteps[LeftOrderIndexValue] < CreationSteps[RightOrderIndexValue];
-            }
-            return OrderIds[LeftOrderIndexValue] < OrderIds[RightOrderIndexValue];
+            return IsDerivedQueueOrderBefore(LeftOrderIndexValue, RightOrderIndexValue);
         };
 
     StrategicOrderIndices.clear();
@@ -1175,9 +1348,377 @@ void FCommandAuthoritySchedulingState::SortDerivedQueues()
     std::stable_sort(CompletedOrderIndices.begin(), CompletedOrderIndices.end(), OrderPriorityComparatorValue);
 }
 
+bool FCommandAuthoritySchedulingState::IsDerivedQueueOrderBefore(const size_t LeftOrderIndexValue,
+                                                                 const size_t RightOrderIndexValue) const
+{
+    if (DerivedPriorityValues[LeftOrderIndexValue] != DerivedPriorityValues[RightOrderIndexValue])
+    {
+        return DerivedPriorityValues[LeftOrderIndexValue] > DerivedPriorityValues[RightOrderIndexValue];
+    }
+    if (GetIntentDomainOrder(OrderHotFields[LeftOrderIndexValue].IntentDomain) !=
+        GetIntentDomainOrder(OrderHotFields[RightOrderIndexValue].IntentDomain))
+    {
+        return GetIntentDomainOrder(OrderHotFields[LeftOrderIndexValue].IntentDomain) <
+               GetIntentDomainOrder(OrderHotFields[RightOrderIndexValue].IntentDomain);
+    }
+    if (CreationSteps[LeftOrderIndexValue] != CreationSteps[RightOrderIndexValue])
+    {
+        return CreationSteps[LeftOrderIndexValue] < CreationSteps[RightOrderIndexValue];
+    }
+    return OrderIds[LeftOrderIndexValue] < OrderIds[RightOrderIndexValue];
+}
+
+bool FCommandAuthoritySchedulingState::IsDerivedActiveOrder(const size_t OrderIndexValue) const
+{
+    return DerivedQueueKinds[OrderIndexValue] != ECommandOrderQueueKind::None &&
+           DerivedQueueKinds[OrderIndexValue] != ECommandOrderQueueKind::Completed;
+}
+
+ECommandOrderQueueKind FCommandAuthoritySchedulingState::GetCurrentQueueKind(const size_t OrderIndexValue) const
+{
+    switch (OrderHotFields[OrderIndexValue].LifecycleState)
+    {
+        case EOrderLifecycleState::Queued:
+            switch (OrderHotFields[OrderIndexValue].SourceLayer)
+            {
+                case ECommandAuthorityLayer::Agent:
+                case ECommandAuthorityLayer::StrategicDirector:
+                    return ECommandOrderQueueKind::Strategic;
+                case ECommandAuthorityLayer::EconomyAndProduction:
+                case ECommandAuthorityLayer::UnitExecution:
+                    return ECommandOrderQueueKind::Planning;
+                case ECommandAuthorityLayer::Army:
+                    return ECommandOrderQueueKind::Army;
+                case ECommandAuthorityLayer::Squad:
+                    return ECommandOrderQueueKind::Squad;
+                default:
+                    return ECommandOrderQueueKind::None;
+            }
+        case EOrderLifecycleState::Preprocessing:
+            return ECommandOrderQueueKind::Planning;
+        case EOrderLifecycleState::Ready:
+            return ECommandOrderQueueKind::ReadyIntent;
+        case EOrderLifecycleState::Dispatched:
+            return ECommandOrderQueueKind::Dispatched;
+        case EOrderLifecycleState::Completed:
+        case EOrderLifecycleState::Aborted:
+        case EOrderLifecycleState::Expired:
+            return ECommandOrderQueueKind::Completed;
+        default:
+            return ECommandOrderQueueKind::None;
+    }
+}
+
+std::vector<size_t>* FCommandAuthoritySchedulingState::GetDerivedQueueBucket(
+    const size_t OrderIndexValue, std::vector<size_t>*& OutFlatQueuePtrValue, size_t& OutFlatQueueOffsetValue)
+{
+    const size_t PriorityTierIndexValue = DerivedPriorityTierIndices[OrderIndexValue];
+    OutFlatQueuePtrValue = nullptr;
+    OutFlatQueueOffsetValue = 0U;
+
+    switch (DerivedQueueKinds[OrderIndexValue])
+    {
+        case ECommandOrderQueueKind::Strategic:
+            OutFlatQueuePtrValue = &StrategicOrderIndices;
+            OutFlatQueueOffsetValue = GetTieredQueueOffset(StrategicQueues, PriorityTierIndexValue);
+            return &StrategicQueues[PriorityTierIndexValue];
+        case ECommandOrderQueueKind::Planning:
+            OutFlatQueuePtrValue = &PlanningProcessIndices;
+            OutFlatQueueOffsetValue = GetTieredQueueOffset(PlanningQueues, PriorityTierIndexValue);
+            return &PlanningQueues[PriorityTierIndexValue];
+        case ECommandOrderQueueKind::Army:
+            OutFlatQueuePtrValue = &ArmyOrderIndices;
+            OutFlatQueueOffsetValue = GetTieredQueueOffset(ArmyQueues, PriorityTierIndexValue);
+            return &ArmyQueues[PriorityTierIndexValue];
+        case ECommandOrderQueueKind::Squad:
+            OutFlatQueuePtrValue = &SquadOrderIndices;
+            OutFlatQueueOffsetValue = GetTieredQueueOffset(SquadQueues, PriorityTierIndexValue);
+            return &SquadQueues[PriorityTierIndexValue];
+        case ECommandOrderQueueKind::ReadyIntent:
+        {
+            const size_t IntentDomainIndexValue = GetIntentDomainIndex(OrderHotFields[OrderIndexValue].IntentDomain);
+            OutFlatQueuePtrValue = &ReadyIntentIndices;
+            for (size_t PreviousTierIndexValue = 0U; PreviousTierIndexValue < PriorityTierIndexValue;
+                 ++PreviousTierIndexValue)
+            {
+                OutFlatQueueOffsetValue +=
+                    GetTieredQueueOffset(ReadyIntentQueues[PreviousTierIndexValue], IntentDomainCountValue);
+            }
+            OutFlatQueueOffsetValue +=
+                GetTieredQueueOffset(ReadyIntentQueues[PriorityTierIndexValue], IntentDomainIndexValue);
+            return &ReadyIntentQueues[PriorityTierIndexValue][IntentDomainIndexValue];
+        }
+        case ECommandOrderQueueKind::Dispatched:
+            return &DispatchedOrderIndices;
+        case ECommandOrderQueueKind::Completed:
+            return &CompletedOrderIndices;
+        case ECommandOrderQueueKind::None:
+        default:
+            return nullptr;
+    }
+}
+
+void FCommandAuthoritySchedulingState::InsertOrderIntoDerivedQueue(const size_t OrderIndexValue)
+{
+    std::vector<size_t>* FlatQueuePtrValue = nullptr;
+    size_t FlatQueueOffsetValue = 0U;
+    std::vector<size_t>* QueueBucketPtrValue =
+        GetDerivedQueueBucket(OrderIndexValue, FlatQueuePtrValue, FlatQueueOffsetValue);
+    if (QueueBucketPtrValue == nullptr)
+    {
+        return;
+    }
+
+    const std::vector<size_t>::iterator InsertIteratorValue = std::lower_bound(
+        QueueBucketPtrValue->begin(), QueueBucketPtrValue->end(), OrderIndexValue,
+        [this](const size_t LeftOrderIndexValue, const size_t RightOrderIndexValue)
+        {
+            return IsDerivedQueueOrderBefore(LeftOrderIndexValue, RightOrderIndexValue);
+        });
+    const size_t BucketPositionValue = static_cast<size_t>(InsertIteratorValue - QueueBucketPtrValue->begin());
+    QueueBucketPtrValue->insert(InsertIteratorValue, OrderIndexValue);
+    if (FlatQueuePtrValue != nullptr)
+    {
+        FlatQueuePtrValue->insert(FlatQueuePtrValue->begin() +
+                                      static_cast<std::ptrdiff_t>(FlatQueueOffsetValue + BucketPositionValue),
+                                  OrderIndexValue);
+    }
+}
+
+void FCommandAuthoritySchedulingState::RemoveOrderFromDerivedQueue(const size_t OrderIndexValue)
+{
+    std::vector<size_t>* FlatQueuePtrValue = nullptr;
+    size_t FlatQueueOffsetValue = 0U;
+    std::vector<size_t>* QueueBucketPtrValue =
+        GetDerivedQueueBucket(OrderIndexValue, FlatQueuePtrValue, FlatQueueOffsetValue);
+    if (QueueBucketPtrValue == nullptr)
+    {
+        return;
+    }
+
+    const std::vector<size_t>::iterator OrderIteratorValue = std::lower_bound(
+        QueueBucketPtrValue->begin(), QueueBucketPtrValue->end(), OrderIndexValue,
+        [this](const size_t LeftOrderIndexValue, const size_t RightOrderIndexValue)
+        {
+            return IsDerivedQueueOrderBefore(LeftOrderIndexValue, RightOrderIndexValue);
+        });
+    if (OrderIteratorValue == QueueBucketPtrValue->end() || *OrderIteratorValue != OrderIndexValue)
+    {
+        SCLOG(LoggingVerbosity::error,
+              "INVARIANT VIOLATION: FCommandAuthoritySchedulingState derived queue is missing OrderIndex=" +
+                  std::to_string(OrderIndexValue) + " QueueKind=" + ToString(DerivedQueueKinds[OrderIndexValue]));
+        return;
+    }
+
+    const size_t BucketPositionValue = static_cast<size_t>(OrderIteratorValue - QueueBucketPtrValue->begin());
+    QueueBucketPtrValue->erase(OrderIteratorValue);
+    if (FlatQueuePtrValue != nullptr)
+    {
+        FlatQueuePtrValue->erase(FlatQueuePtrValue->begin() +
+                                 static_cast<std::ptrdiff_t>(FlatQueueOffsetValue + BucketPositionValue));
+    }
+}
+
+void FCommandAuthoritySchedulingState::AddActiveOrderIndexes(const size_t OrderIndexValue)
+{
+    ++ActiveOrderCountsByLayer[GetCommandAuthorityLayerIndex(OrderHotFields[OrderIndexValue].SourceLayer)];
+    ++ActiveTaskSignatureCounts.FindOrAdd(BuildTaskSignatureKeyForOrderIndex(*this, OrderIndexValue));
+
+    if (OrderHotFields[OrderIndexValue].SourceLayer == ECommandAuthorityLayer::StrategicDirector &&
+        SourceGoalIds[OrderIndexValue] != 0U)
+    {
+        AddActiveOrderIndex(ActiveStrategicOrderIndexByGoalId, ActiveStrategicOrderCountsByGoalId,
+                            SourceGoalIds[OrderIndexValue], OrderIndexValue);
+    }
+
+    if (OrderHotFields[OrderIndexValue].SourceLayer ==
+            ECommandAuthorityLayer::UnitExecution && OrderHotFields[OrderIndexValue].ActorTag != NullTag)
+    {
+        AddActiveOrderIndex(ActiveExecutionOrderIndexByActorTag, ActiveExecutionOrderCountsByActorTag,
+                            OrderHotFields[OrderIndexValue].ActorTag, OrderIndexValue);
+    }
+
+    if (ParentOrderIds[OrderIndexValue] != 0U)
+    {
+        AddActiveOrderIndex(ActiveChildOrderIndexByParentAndLayer, ActiveChildOrderCountsByParentAndLayer,
+                            BuildActiveChildOrderKey(ParentOrderIds[OrderIndexValue],
+                                                     OrderHotFields[OrderIndexValue].SourceLayer),
+                            OrderIndexValue);
+    }
+}
+
+void FCommandAuthoritySchedulingState::RemoveActiveOrderIndexes(const size_t OrderIndexValue)
+{
+    const size_t OrderCountValue = OrderIds.size();
+    uint32_t& ActiveLayerCountValue =
+        ActiveOrderCountsByLayer[GetCommandAuthorityLayerIndex(OrderHotFields[OrderIndexValue].SourceLayer)];
+    if (ActiveLayerCountValue > 0U)
+    {
+        --ActiveLayerCountValue;
+    }
+
+    const FCommandTaskSignatureKey TaskSignatureKeyValue = BuildTaskSignatureKeyForOrderIndex(*this, OrderIndexValue);
+    uint32_t* ActiveSignatureCountPtrValue = ActiveTaskSignatureCounts.FindValue(TaskSignatureKeyValue);
+    if (ActiveSignatureCountPtrValue != nullptr)
+    {
+        --(*ActiveSignatureCountPtrValue);
+        if (*ActiveSignatureCountPtrValue == 0U)
+        {
+            ActiveTaskSignatureCounts.Remove(TaskSignatureKeyValue);
+        }
+    }
+
+    if (OrderHotFields[OrderIndexValue].SourceLayer == ECommandAuthorityLayer::StrategicDirector &&
+        SourceGoalIds[OrderIndexValue] != 0U)
+    {
+        const uint32_t SourceGoalIdValue = SourceGoalIds[OrderIndexValue];
+        RemoveActiveOrderIndex(ActiveStrategicOrderIndexByGoalId, ActiveStrategicOrderCountsByGoalId,
+                               SourceGoalIdValue, OrderIndexValue, OrderCountValue,
+                               [this, SourceGoalIdValue](const size_t CandidateOrderIndexValue)
+                               {
+                                   return IsDerivedActiveOrder(CandidateOrderIndexValue) &&
+                                          OrderHotFields[CandidateOrderIndexValue].SourceLayer ==
+                                              ECommandAuthorityLayer::StrategicDirector &&
+                                          SourceGoalIds[CandidateOrderIndexValue] == SourceGoalIdValue;
+                               });
+    }
+
+    if (OrderHotFields[OrderIndexValue].SourceLayer ==
+            ECommandAuthorityLayer::UnitExecution && OrderHotFields[OrderIndexValue].ActorTag != NullTag)
+    {
+        const Tag ActorTagValue = OrderHotFields[OrderIndexValue].ActorTag;
+        RemoveActiveOrderIndex(ActiveExecutionOrderIndexByActorTag, ActiveExecutionOrderCountsByActorTag,
+                               ActorTagValue, OrderIndexValue, OrderCountValue,
+                               [this, ActorTagValue](const size_t CandidateOrderIndexValue)
+                               {
+                                   return IsDerivedActiveOrder(CandidateOrderIndexValue) &&
+                                          OrderHotFields[CandidateOrderIndexValue].SourceLayer ==
+                                              ECommandAuthorityLayer::UnitExecution &&
+                                          OrderHotFields[CandidateOrderIndexValue].ActorTag == ActorTagValue;
+                               });
+    }
+
+    if (ParentOrderIds[OrderIndexValue] != 0U)
+    {
+        const uint32_t ParentOrderIdValue = ParentOrderIds[OrderIndexValue];
+        const ECommandAuthorityLayer SourceLayerValue = OrderHotFields[OrderIndexValue].SourceLayer;
+        RemoveActiveOrderIndex(ActiveChildOrderIndexByParentAndLayer, ActiveChildOrderCountsByParentAndLayer,
+                               BuildActiveChildOrderKey(ParentOrderIdValue, SourceLayerValue), OrderIndexValue,
+                               OrderCountValue,
+                               [this, ParentOrderIdValue, SourceLayerValue](const size_t CandidateOrderIndexValue)
+                               {
+                                   return IsDerivedActiveOrder(CandidateOrderIndexValue) &&
+                                          ParentOrderIds[CandidateOrderIndexValue] == ParentOrderIdValue &&
+                                          OrderHotFields[CandidateOrderIndexValue].SourceLayer == SourceLayerValue;
+                               });
+    }
+}
+
+void FCommandAuthoritySchedulingState::UpdateDerivedQueuesForOrder(const size_t OrderIndexValue)
+{
+    const ECommandOrderQueueKind QueueKindValue = GetCurrentQueueKind(OrderIndexValue);
+    const uint8_t PriorityTierIndexValue =
+        static_cast<uint8_t>(GetCommandPriorityTierIndex(OrderHotFields[OrderIndexValue].PriorityTier));
+    if (DerivedQueueKinds[OrderIndexValue] == QueueKindValue &&
+        DerivedPriorityTierIndices[OrderIndexValue] == PriorityTierIndexValue &&
+        DerivedPriorityValues[OrderIndexValue] == OrderHotFields[OrderIndexValue].EffectivePriorityValue)
+    {
+        return;
+    }
+
+    const bool bWasActiveValue = IsDerivedActiveOrder(OrderIndexValue);
+    RemoveOrderFromDerivedQueue(OrderIndexValue);
+    DerivedQueueKinds[OrderIndexValue] = QueueKindValue;
+    DerivedPriorityTierIndices[OrderIndexValue] = PriorityTierIndexValue;
+    DerivedPriorityValues[OrderIndexValue] = OrderHotFields[OrderIndexValue].EffectivePriorityValue;
+
+    const bool bIsActiveValue = IsDerivedActiveOrder(OrderIndexValue);
+    if (bWasActiveValue && !bIsActiveValue)
+    {
+        RemoveActiveOrderIndexes(OrderIndexValue);
+    }
+    else if (!bWasActiveValue && bIsActiveValue)
+    {
+        AddActiveOrderIndexes(OrderIndexValue);
+    }
+
+    InsertOrderIntoDerivedQueue(OrderIndexValue);
+}
+
+void FCommandAuthoritySchedulingState::ApplyPendingDerivedQueueUpdates()
+{
+    for (const size_t PendingOrderIndexValue : PendingDerivedQueueOrderIndices)
+    {
+        PendingDerivedQueueFlags[PendingOrderIndexValue] = 0U;
+        UpdateDerivedQueuesForOrder(PendingOrderIndexValue);
+    }
+
+    PendingDerivedQueueOrderIndices.clear();
+    bDerivedQueuesDirty = false;
+    RebuildProcessorState();
+    RebuildPlaybackState();
+    AssertConsistentDerivedQueues();
+}
+
+bool FCommandAuthoritySchedulingState::HasConsistentDerivedQueues() const
+{
+    if (bDerivedQueuesDirty)
+    {
+        return true;
+    }
+
+    FCommandAuthoritySchedulingState RebuiltSchedulingStateValue = *this;
+    RebuiltSchedulingStateValue.RebuildDerivedQueues();
+    return DerivedQueueKinds == RebuiltSchedulingStateValue.DerivedQueueKinds &&
+           DerivedPriorityTierIndices == RebuiltSchedulingStateValue.DerivedPriorityTierIndices &&
+           DerivedPriorityValues == RebuiltSchedulingStateValue.DerivedPriorityValues &&
+           StrategicOrderIndices == RebuiltSchedulingStateValue.StrategicOrderIndices &&
+           PlanningProcessIndices == RebuiltSchedulingStateValue.PlanningProcessIndices &&
+           ArmyOrderIndices == RebuiltSchedulingStateValue.ArmyOrderIndices &&
+           SquadOrderIndices == RebuiltSchedulingStateValue.SquadOrderIndices &&
+           ReadyIntentIndices == RebuiltSchedulingStateValue.ReadyIntentIndices &&
+           DispatchedOrderIndices == RebuiltSchedulingStateValue.DispatchedOrderIndices &&
+           CompletedOrderIndices == RebuiltSchedulingStateValue.CompletedOrderIndices &&
+           StrategicQueues == RebuiltSchedulingStateValue.StrategicQueues &&
+           PlanningQueues == RebuiltSchedulingStateValue.PlanningQueues &&
+           ArmyQueues == RebuiltSchedulingStateValue.ArmyQueues &&
+           SquadQueues == RebuiltSchedulingStateValue.SquadQueues &&
+           ReadyIntentQueues == RebuiltSchedulingStateValue.ReadyIntentQueues &&
+           ActiveOrderCountsByLayer == RebuiltSchedulingStateValue.ActiveOrderCountsByLayer &&
+           AreFlatHashMapsEqual(ActiveExecutionOrderIndexByActorTag,
+                                RebuiltSchedulingStateValue.ActiveExecutionOrderIndexByActorTag) &&
+           AreFlatHashMapsEqual(ActiveStrategicOrderIndexByGoalId,
+                                RebuiltSchedulingStateValue.ActiveStrategicOrderIndexByGoalId) &&
+           AreFlatHashMapsEqual(ActiveTaskSignatureCounts, RebuiltSchedulingStateValue.ActiveTaskSignatureCounts) &&
+           AreFlatHashMapsEqual(ActiveChildOrderIndexByParentAndLayer,
+                                RebuiltSchedulingStateValue.ActiveChildOrderIndexByParentAndLayer) &&
+           AreFlatHashMapsEqual(ActiveExecutionOrderCountsByActorTag,
+                                RebuiltSchedulingStateValue.ActiveExecutionOrderCountsByActorTag) &&
+           AreFlatHashMapsEqual(ActiveStrategicOrderCountsByGoalId,
+                                RebuiltSchedulingStateValue.ActiveStrategicOrderCountsByGoalId) &&
+           AreFlatHashMapsEqual(ActiveChildOrderCountsByParentAndLayer,
+                                RebuiltSchedulingStateValue.ActiveChildOrderCountsByParentAndLayer) &&
+           ProcessorState == RebuiltSchedulingStateValue.ProcessorState &&
+           PlaybackState == RebuiltSchedulingStateValue.PlaybackState;
+}
+
+void FCommandAuthoritySchedulingState::AssertConsistentDerivedQueues() const
+{
+#if _DEBUG
+    if (!HasConsistentDerivedQueues())
+    {
+        SCLOG(LoggingVerbosity::error,
+              "INVARIANT VIOLATION: FCommandAuthoritySchedulingState incremental derived queues diverged from a full "
+              "rebuild at OrderCount=" +
+                  std::to_string(OrderIds.size()));
+    }
+#endif
+}
+
 void FCommandAuthoritySchedulingState::MarkDerivedQueuesDirty()
 {
     bDerivedQueuesDirty = true;
+    bDerivedQueuesRebuildRequired = true;
     bPrioritiesDirty = true;
     if (MutationBatchDepth == 0U)
     {
@@ -1185,4 +1726,33 @@ void FCommandAuthoritySchedulingState::MarkDerivedQueuesDirty()
     }
 }
 
+void FCommandAuthoritySchedulingState::MarkOrderDerivedQueueDirty(const size_t OrderIndexValue)
+{
+    if (bDerivedQueuesDirty && PendingDerivedQueueOrderIndices.empty())
+    {
+        bDerivedQueuesRebuildRequired = true;
+    }
+
+    bDerivedQueuesDirty = true;
+    if (bDerivedQueuesRebuildRequired)
+    {
+        if (MutationBatchDepth == 0U)
+        {
+            RebuildDerivedQueues();
+        }
+        return;
+    }
+
+    if (PendingDerivedQueueFlags[OrderIndexValue] == 0U)
+    {
+        PendingDerivedQueueFlags[OrderIndexValue] = 1U;
+        PendingDerivedQueueOrderIndices.push_back(OrderIndexValue);
+    }
+
+    if (MutationBatchDepth == 0U)
+    {
+        ApplyPendingDerivedQueueUpdates();
+    }
+}
+
 }  // namespace sc2
@@ -3,14 +3,15 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <vector>
 
+#include "common/containers/FFlatHashMap.h"
 #include "common/planning/EBlockedTaskWakeKind.h"
 #include "common/planning/ECommandAuthorityLayer.h"
 #include "common/planning/ECommandCommitmentClass.h"
 #include "common/planning/ECommandPriorityTier.h"
 #include "common/planning/ECommandOrderDeferralReason.h"
+#include "common/planning/ECommandOrderQueueKind.h"
 #include "common/planning/ECommandTaskOrigin.h"
 #include "common/planning/ECommandTaskExecutionGuarantee.h"
 #include "common/planning/ECommandTaskRetentionPolicy.h"
@@ -20,6 +21,8 @@
 #include "common/planning/EIntentPlaybackState.h"
 #include "common/planning/EOrderLifecycleState.h"
 #include "common/planning/EPlanningProcessorState.h"
+#include "common/planning/FCommandOrderDiagnosticColumns.h"
+#include "common/planning/FCommandOrderHotFields.h"
 #include "common/planning/FCommandOrderRecord.h"
 #include "common/planning/FSchedulerStimulusState.h"
 #include "common/services/FBuildPlacementSlotId.h"
@@ -28,6 +31,7 @@ namespace sc2
 {
 
 enum class EIntentTargetKind : uint8_t;
+class FCommandOrderView;
 struct FOpeningPlanExecutionState;
 
 struct FCommandAuthoritySchedulingState
@@ -50,12 +54,20 @@ public:
     bool TryGetActiveExecutionOrderIndexForActor(Tag ActorTagValue, size_t& OutOrderIndexValue) const;
     size_t GetOrderCount() const;
     FCommandOrderRecord GetOrderRecord(size_t OrderIndexValue) const;
+    // Lazy per-column access to one row; see FCommandOrderView. Prefer this over GetOrderRecord in per-step loops.
+    FCommandOrderView GetOrderView(size_t OrderIndexValue) const;
+    // Calls VisitorValue(OrderIndex, LifecycleState, EffectivePriorityValue, ActorTag) for every non-terminal order of
+    // one layer in storage order. Only OrderHotFields is read.
+    template <typename TVisitor>
+    void ForEachActiveOrderInLayer(ECommandAuthorityLayer SourceLayerValue, TVisitor&& VisitorValue) const;
     bool HasActiveStrategicOrderForGoalId(uint32_t SourceGoalIdValue) const;
     bool HasEquivalentActiveTaskSignature(const FCommandTaskSignatureKey& CommandTaskSignatureKeyValue) const;
     bool SetOrderLifecycleState(uint32_t OrderIdValue, EOrderLifecycleState LifecycleStateValue);
     bool SetOrderDeferralState(uint32_t OrderIdValue, ECommandOrderDeferralReason DeferralReasonValue,
                                uint64_t CurrentStepValue, uint64_t CurrentGameLoopValue);
     bool ClearOrderDeferralState(uint32_t OrderIdValue);
+    bool SetOrderPriorityByIndex(size_t OrderIndexValue, int EffectivePriorityValue,
+                                 ECommandPriorityTier PriorityTierValue);
     bool SetOrderDispatchState(uint32_t OrderIdValue, uint64_t DispatchStepValue, uint64_t DispatchGameLoopValue,
                                uint32_t ObservedCountValue, uint32_t ObservedInConstructionCountValue);
     bool SetOrderReservedPlacementSlot(uint32_t OrderIdValue, const FBuildPlacementSlotId& BuildPlacementSlotIdValue);
@@ -64,6 +76,11 @@ public:
     void RebuildDerivedQueues();
     size_t GetActiveOrderCountForLayer(ECommandAuthorityLayer SourceLayerValue) const;
     bool HasSynchronizedSizes() const;
+    // Diagnostic columns (deferral and dispatch timestamps) are enabled by default. Disabling them frees their storage
+    // and GetOrderRecord reports zero for those fields; the setting survives Reset.
+    void SetDiagnosticColumnsEnabled(bool bEnabledValue);
+    bool HasDiagnosticColumns() const;
+    bool HasConsistentDerivedQueues() const;
 
 public:
     uint32_t NextOrderId;
@@ -97,10 +114,10 @@ public:
     FSchedulerStimulusState SchedulerStimulusState;
 
     std::vector<uint32_t> OrderIds;
+    // Fields read by every layer scan and queue rebuild, one packed row per order.
+    std::vector<FCommandOrderHotFields> OrderHotFields;
     std::vector<uint32_t> ParentOrderIds;
     std::vector<uint32_t> SourceGoalIds;
-    std::vector<ECommandAuthorityLayer> SourceLayers;
-    std::vector<EOrderLifecycleState> LifecycleStates;
     std::vector<ECommandTaskPackageKind> TaskPackageKinds;
     std::vector<ECommandTaskNeedKind> TaskNeedKinds;
     std::vector<ECommandTaskType> TaskTypes;
@@ -109,22 +126,14 @@ public:
     std::vector<ECommandTaskExecutionGuarantee> ExecutionGuarantees;
     std::vector<ECommandTaskRetentionPolicy> RetentionPolicies;
     std::vector<EBlockedTaskWakeKind> BlockedTaskWakeKinds;
-    std::vector<int> BasePriorityValues;
-    std::vector<int> EffectivePriorityValues;
-    std::vector<ECommandPriorityTier> PriorityTiers;
-    std::vector<EIntentDomain> IntentDomains;
     std::vector<uint64_t> CreationSteps;
     std::vector<uint64_t> DeadlineSteps;
     std::vector<int32_t> OwningArmyIndices;
     std::vector<int32_t> OwningSquadIndices;
-    std::vector<Tag> ActorTags;
     std::vector<AbilityID> AbilityIds;
     std::vector<EIntentTargetKind> TargetKinds;
     std::vector<Point2D> TargetPoints;
     std::vector<Tag> TargetUnitTags;
-    std::vector<bool> QueuedValues;
-    std::vector<bool> RequiresPlacementValidationValues;
-    std::vector<bool> RequiresPathingValidationValues;
     std::vector<uint32_t> PlanStepIds;
     std::vector<uint32_t> TargetCounts;
     std::vector<uint32_t> RequestedQueueCounts;
@@ -139,20 +148,19 @@ public:
     std::vector<EBuildPlacementSlotType> ReservedPlacementSlotTypes;
     std::vector<uint8_t> ReservedPlacementSlotOrdinals;
     std::vector<ECommandOrderDeferralReason> LastDeferralReasons;
-    std::vector<uint64_t> LastDeferralSteps;
-    std::vector<uint64_t> LastDeferralGameLoops;
     std::vector<uint32_t> ConsecutiveDeferralCounts;
-    std::vector<uint64_t> DispatchSteps;
     std::vector<uint64_t> DispatchGameLoops;
     std::vector<uint32_t> ObservedCountsAtDispatch;
     std::vector<uint32_t> ObservedInConstructionCountsAtDispatch;
     std::vector<uint32_t> DispatchAttemptCounts;
+    // Telemetry-only columns; empty while diagnostic columns are disabled.
+    FCommandOrderDiagnosticColumns DiagnosticColumns;
 
-    std::unordered_map<uint32_t, size_t> OrderIdToIndex;
-    std::unordered_map<Tag, size_t> ActiveExecutionOrderIndexByActorTag;
-    std::unordered_map<uint32_t, size_t> ActiveStrategicOrderIndexByGoalId;
-    std::unordered_map<FCommandTaskSignatureKey, uint32_t, FCommandTaskSignatureKeyHash> ActiveTaskSignatureCounts;
-    std::unordered_map<uint64_t, size_t> ActiveChildOrderIndexByParentAndLayer;
+    FFlatHashMap<uint32_t, size_t> OrderIdToIndex;
+    FFlatHashMap<Tag, size_t> ActiveExecutionOrderIndexByActorTag;
+    FFlatHashMap<uint32_t, size_t> ActiveStrategicOrderIndexByGoalId;
+    FFlatHashMap<FCommandTaskSignatureKey, uint32_t, FCommandTaskSignatureKeyHash> ActiveTaskSignatureCounts;
+    FFlatHashMap<uint64_t, size_t> ActiveChildOrderIndexByParentAndLayer;
     std::array<uint32_t, 6U> ActiveOrderCountsByLayer;
     std::vector<size_t> StrategicOrderIndices;
     std::vector<size_t> PlanningProcessIndices;
@@ -172,11 +180,58 @@ public:
 
 private:
     void MarkDerivedQueuesDirty();
+    void MarkOrderDerivedQueueDirty(size_t OrderIndexValue);
+    void ApplyPendingDerivedQueueUpdates();
+    void UpdateDerivedQueuesForOrder(size_t OrderIndexValue);
+    void InsertOrderIntoDerivedQueue(size_t OrderIndexValue);
+    void RemoveOrderFromDerivedQueue(size_t OrderIndexValue);
+    void AddActiveOrderIndexes(size_t OrderIndexValue);
+    void RemoveActiveOrderIndexes(size_t OrderIndexValue);
+    bool IsDerivedQueueOrderBefore(size_t LeftOrderIndexValue, size_t RightOrderIndexValue) const;
+    bool IsDerivedActiveOrder(size_t OrderIndexValue) const;
+    ECommandOrderQueueKind GetCurrentQueueKind(size_t OrderIndexValue) const;
+    std::vector<size_t>* GetDerivedQueueBucket(size_t OrderIndexValue, std::vector<size_t>*& OutFlatQueuePtrValue,
+                                               size_t& OutFlatQueueOffsetValue);
     void RebuildProcessorState();
     void RebuildPlaybackState();
     void AppendQueuedOrderIndex(size_t OrderIndexValue);
     void SortDerivedQueues();
     void AssertSynchronizedSizes() const;
+    void AssertConsistentDerivedQueues() const;
+
+private:
+    std::vector<size_t> CompactionRetainedOrderIndices;
+
+    // Derived queue placement recorded when each order was last routed. Bucket searches use these snapshots so an
+    // order can be located and moved after its live lifecycle, tier, or priority columns have changed.
+    std::vector<ECommandOrderQueueKind> DerivedQueueKinds;
+    std::vector<uint8_t> DerivedPriorityTierIndices;
+    std::vector<int> DerivedPriorityValues;
+    std::vector<uint8_t> PendingDerivedQueueFlags;
+    std::vector<size_t> PendingDerivedQueueOrderIndices;
+    FFlatHashMap<Tag, uint32_t> ActiveExecutionOrderCountsByActorTag;
+    FFlatHashMap<uint32_t, uint32_t> ActiveStrategicOrderCountsByGoalId;
+    FFlatHashMap<uint64_t, uint32_t> ActiveChildOrderCountsByParentAndLayer;
+    bool bDerivedQueuesRebuildRequired;
+    bool bDiagnosticColumnsEnabled;
 };
 
+template <typename TVisitor>
+void FCommandAuthoritySchedulingState::ForEachActiveOrderInLayer(const ECommandAuthorityLayer SourceLayerValue,
+                                                                 TVisitor&& VisitorValue) const
+{
+    const size_t OrderCountValue = OrderHotFields.size();
+    for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
+    {
+        const FCommandOrderHotFields& HotFieldsValue = OrderHotFields[OrderIndexValue];
+        if (HotFieldsValue.SourceLayer != SourceLayerValue || IsTerminalLifecycleState(HotFieldsValue.LifecycleState))
+        {
+            continue;
+        }
+
+        VisitorValue(OrderIndexValue, HotFieldsValue.LifecycleState, HotFieldsValue.EffectivePriorityValue,
+                     HotFieldsValue.ActorTag);
+    }
+}
+
 }  // namespace sc2
@@ -0,0 +1,38 @@
+#include "common/planning/FCommandOrderDiagnosticColumns.h"
+
+namespace sc2
+{
+
+FCommandOrderDiagnosticColumns::FCommandOrderDiagnosticColumns()
+{
+    Reset();
+}
+
+void FCommandOrderDiagnosticColumns::Reset()
+{
+    LastDeferralSteps.clear();
+    LastDeferralGameLoops.clear();
+    DispatchSteps.clear();
+}
+
+void FCommandOrderDiagnosticColumns::Release()
+{
+    std::vector<uint64_t>().swap(LastDeferralSteps);
+    std::vector<uint64_t>().swap(LastDeferralGameLoops);
+    std::vector<uint64_t>().swap(DispatchSteps);
+}
+
+void FCommandOrderDiagnosticColumns::Reserve(const size_t OrderCapacityValue)
+{
+    LastDeferralSteps.reserve(OrderCapacityValue);
+    LastDeferralGameLoops.reserve(OrderCapacityValue);
+    DispatchSteps.reserve(OrderCapacityValue);
+}
+
+bool FCommandOrderDiagnosticColumns::HasSize(const size_t OrderCountValue) const
+{
+    return LastDeferralSteps.size() == OrderCountValue && LastDeferralGameLoops.size() == OrderCountValue &&
+           DispatchSteps.size() == OrderCountValue;
+}
+
+}  // namespace sc2
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sc2
+{
+
+// Order columns that no scheduling decision reads; only telemetry and GetOrderRecord consume them. They are kept in
+// step with the main order table while enabled and stay empty, with no storage, while disabled.
+struct FCommandOrderDiagnosticColumns
+{
+public:
+    FCommandOrderDiagnosticColumns();
+
+    void Reset();
+    void Release();
+    void Reserve(size_t OrderCapacityValue);
+    bool HasSize(size_t OrderCountValue) const;
+
+public:
+    std::vector<uint64_t> LastDeferralSteps;
+    std::vector<uint64_t> LastDeferralGameLoops;
+    std::vector<uint64_t> DispatchSteps;
+};
+
+}  // namespace sc2
@@ -0,0 +1,25 @@
+#include "common/planning/FCommandOrderHotFields.h"
+
+namespace sc2
+{
+
+FCommandOrderHotFields::FCommandOrderHotFields()
+{
+    Reset();
+}
+
+void FCommandOrderHotFields::Reset()
+{
+    ActorTag = NullTag;
+    BasePriorityValue = 0;
+    EffectivePriorityValue = 0;
+    SourceLayer = ECommandAuthorityLayer::Agent;
+    LifecycleState = EOrderLifecycleState::Queued;
+    PriorityTier = ECommandPriorityTier::Normal;
+    IntentDomain = EIntentDomain::Recovery;
+    bQueued = 0U;
+    bRequiresPlacementValidation = 0U;
+    bRequiresPathingValidation = 0U;
+}
+
+}  // namespace sc2
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/planning/ECommandAuthorityLayer.h"
+#include "common/planning/ECommandPriorityTier.h"
+#include "common/planning/EIntentDomain.h"
+#include "common/planning/EOrderLifecycleState.h"
+#include "sc2api/sc2_gametypes.h"
+
+namespace sc2
+{
+
+// Per-order fields read by every layer scan, queue rebuild and priority pass, packed into one 24-byte row so a scan
+// pulls two or three orders per cache line instead of one line per column.
+struct FCommandOrderHotFields
+{
+public:
+    FCommandOrderHotFields();
+
+    void Reset();
+
+public:
+    Tag ActorTag;
+    int BasePriorityValue;
+    int EffectivePriorityValue;
+    ECommandAuthorityLayer SourceLayer;
+    EOrderLifecycleState LifecycleState;
+    ECommandPriorityTier PriorityTier;
+    EIntentDomain IntentDomain;
+    uint8_t bQueued : 1;
+    uint8_t bRequiresPlacementValidation : 1;
+    uint8_t bRequiresPathingValidation : 1;
+};
+
+}  // namespace sc2
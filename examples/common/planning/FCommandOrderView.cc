@@ -0,0 +1,36 @@
+#include "common/planning/FCommandOrderView.h"
+
+namespace sc2
+{
+
+FCommandOrderView::FCommandOrderView() : SchedulingState(nullptr), OrderIndex(0U)
+{
+}
+
+FCommandOrderView::FCommandOrderView(const FCommandAuthoritySchedulingState& SchedulingStateValue,
+                                     const size_t OrderIndexValue)
+    : SchedulingState(&SchedulingStateValue), OrderIndex(OrderIndexValue)
+{
+}
+
+bool FCommandOrderView::IsValid() const
+{
+    return SchedulingState != nullptr && SchedulingState->IsOrderIndexValid(OrderIndex);
+}
+
+size_t FCommandOrderView::GetOrderIndex() const
+{
+    return OrderIndex;
+}
+
+FCommandOrderRecord FCommandOrderView::ToRecord() const
+{
+    if (SchedulingState == nullptr)
+    {
+        return FCommandOrderRecord();
+    }
+
+    return SchedulingState->GetOrderRecord(OrderIndex);
+}
+
+}  // namespace sc2
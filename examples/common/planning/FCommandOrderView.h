@@ -0,0 +1,346 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/planning/FCommandAuthoritySchedulingState.h"
+#include "common/planning/FCommandOrderRecord.h"
+
+namespace sc2
+{
+
+// Non-owning handle to one order row of an FCommandAuthoritySchedulingState. Each getter reads a single column when it
+// is called, so a loop that only needs the layer, lifecycle and actor of an order does not pay for copying the whole
+// row the way GetOrderRecord does. Getters always see the live column values; a view stays valid across appends and
+// lifecycle changes, but not across CompactTerminalOrders or Reset, which move or drop rows. Getters require IsValid().
+// Diagnostic getters return zero when the state's diagnostic columns are disabled.
+class FCommandOrderView
+{
+public:
+    FCommandOrderView();
+    FCommandOrderView(const FCommandAuthoritySchedulingState& SchedulingStateValue, size_t OrderIndexValue);
+
+    bool IsValid() const;
+    size_t GetOrderIndex() const;
+    // Copies every column of the row, for callers that need a snapshot or a record to enqueue.
+    FCommandOrderRecord ToRecord() const;
+
+    uint32_t GetOrderId() const;
+    uint32_t GetParentOrderId() const;
+    uint32_t GetSourceGoalId() const;
+    ECommandAuthorityLayer GetSourceLayer() const;
+    EOrderLifecycleState GetLifecycleState() const;
+    ECommandTaskPackageKind GetTaskPackageKind() const;
+    ECommandTaskNeedKind GetTaskNeedKind() const;
+    ECommandTaskType GetTaskType() const;
+    ECommandTaskOrigin GetOrigin() const;
+    ECommandCommitmentClass GetCommitmentClass() const;
+    ECommandTaskExecutionGuarantee GetExecutionGuarantee() const;
+    ECommandTaskRetentionPolicy GetRetentionPolicy() const;
+    EBlockedTaskWakeKind GetBlockedTaskWakeKind() const;
+    int GetBasePriorityValue() const;
+    int GetEffectivePriorityValue() const;
+    ECommandPriorityTier GetPriorityTier() const;
+    EIntentDomain GetIntentDomain() const;
+    uint64_t GetCreationStep() const;
+    uint64_t GetDeadlineStep() const;
+    int32_t GetOwningArmyIndex() const;
+    int32_t GetOwningSquadIndex() const;
+    Tag GetActorTag() const;
+    AbilityID GetAbilityId() const;
+    EIntentTargetKind GetTargetKind() const;
+    const Point2D& GetTargetPoint() const;
+    Tag GetTargetUnitTag() const;
+    bool GetQueued() const;
+    bool GetRequiresPlacementValidation() const;
+    bool GetRequiresPathingValidation() const;
+    uint32_t GetPlanStepId() const;
+    uint32_t GetTargetCount() const;
+    uint32_t GetRequestedQueueCount() const;
+    UNIT_TYPEID GetProducerUnitTypeId() const;
+    UNIT_TYPEID GetResultUnitTypeId() const;
+    UpgradeID GetUpgradeId() const;
+    EBuildPlacementSlotType GetPreferredPlacementSlotType() const;
+    FBuildPlacementSlotId GetPreferredPlacementSlotId() const;
+    FBuildPlacementSlotId GetPreferredProducerPlacementSlotId() const;
+    FBuildPlacementSlotId GetReservedPlacementSlotId() const;
+    ECommandOrderDeferralReason GetLastDeferralReason() const;
+    uint64_t GetLastDeferralStep() const;
+    uint64_t GetLastDeferralGameLoop() const;
+    uint32_t GetConsecutiveDeferralCount() const;
+    uint64_t GetDispatchStep() const;
+    uint64_t GetDispatchGameLoop() const;
+    uint32_t GetObservedCountAtDispatch() const;
+    uint32_t GetObservedInConstructionCountAtDispatch() const;
+    uint32_t GetDispatchAttemptCount() const;
+
+private:
+    const FCommandAuthoritySchedulingState* SchedulingState;
+    size_t OrderIndex;
+};
+
+inline uint32_t FCommandOrderView::GetOrderId() const
+{
+    return SchedulingState->OrderIds[OrderIndex];
+}
+
+inline uint32_t FCommandOrderView::GetParentOrderId() const
+{
+    return SchedulingState->ParentOrderIds[OrderIndex];
+}
+
+inline uint32_t FCommandOrderView::GetSourceGoalId() const
+{
+    return SchedulingState->SourceGoalIds[OrderIndex];
+}
+
+inline ECommandAuthorityLayer FCommandOrderView::GetSourceLayer() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].SourceLayer;
+}
+
+inline EOrderLifecycleState FCommandOrderView::GetLifecycleState() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].LifecycleState;
+}
+
+inline ECommandTaskPackageKind FCommandOrderView::GetTaskPackageKind() const
+{
+    return SchedulingState->TaskPackageKinds[OrderIndex];
+}
+
+inline ECommandTaskNeedKind FCommandOrderView::GetTaskNeedKind() const
+{
+    return SchedulingState->TaskNeedKinds[OrderIndex];
+}
+
+inline ECommandTaskType FCommandOrderView::GetTaskType() const
+{
+    return SchedulingState->TaskTypes[OrderIndex];
+}
+
+inline ECommandTaskOrigin FCommandOrderView::GetOrigin() const
+{
+    return SchedulingState->TaskOrigins[OrderIndex];
+}
+
+inline ECommandCommitmentClass FCommandOrderView::GetCommitmentClass() const
+{
+    return SchedulingState->CommitmentClasses[OrderIndex];
+}
+
+inline ECommandTaskExecutionGuarantee FCommandOrderView::GetExecutionGuarantee() const
+{
+    return SchedulingState->ExecutionGuarantees[OrderIndex];
+}
+
+inline ECommandTaskRetentionPolicy FCommandOrderView::GetRetentionPolicy() const
+{
+    return SchedulingState->RetentionPolicies[OrderIndex];
+}
+
+inline EBlockedTaskWakeKind FCommandOrderView::GetBlockedTaskWakeKind() const
+{
+    return SchedulingState->BlockedTaskWakeKinds[OrderIndex];
+}
+
+inline int FCommandOrderView::GetBasePriorityValue() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].BasePriorityValue;
+}
+
+inline int FCommandOrderView::GetEffectivePriorityValue() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].EffectivePriorityValue;
+}
+
+inline ECommandPriorityTier FCommandOrderView::GetPriorityTier() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].PriorityTier;
+}
+
+inline EIntentDomain FCommandOrderView::GetIntentDomain() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].IntentDomain;
+}
+
+inline uint64_t FCommandOrderView::GetCreationStep() const
+{
+    return SchedulingState->CreationSteps[OrderIndex];
+}
+
+inline uint64_t FCommandOrderView::GetDeadlineStep() const
+{
+    return SchedulingState->DeadlineSteps[OrderIndex];
+}
+
+inline int32_t FCommandOrderView::GetOwningArmyIndex() const
+{
+    return SchedulingState->OwningArmyIndices[OrderIndex];
+}
+
+inline int32_t FCommandOrderView::GetOwningSquadIndex() const
+{
+    return SchedulingState->OwningSquadIndices[OrderIndex];
+}
+
+inline Tag FCommandOrderView::GetActorTag() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].ActorTag;
+}
+
+inline AbilityID FCommandOrderView::GetAbilityId() const
+{
+    return SchedulingState->AbilityIds[OrderIndex];
+}
+
+inline EIntentTargetKind FCommandOrderView::GetTargetKind() const
+{
+    return SchedulingState->TargetKinds[OrderIndex];
+}
+
+inline const Point2D& FCommandOrderView::GetTargetPoint() const
+{
+    return SchedulingState->TargetPoints[OrderIndex];
+}
+
+inline Tag FCommandOrderView::GetTargetUnitTag() const
+{
+    return SchedulingState->TargetUnitTags[OrderIndex];
+}
+
+inline bool FCommandOrderView::GetQueued() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].bQueued;
+}
+
+inline bool FCommandOrderView::GetRequiresPlacementValidation() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].bRequiresPlacementValidation;
+}
+
+inline bool FCommandOrderView::GetRequiresPathingValidation() const
+{
+    return SchedulingState->OrderHotFields[OrderIndex].bRequiresPathingValidation;
+}
+
+inline uint32_t FCommandOrderView::GetPlanStepId() const
+{
+    return SchedulingState->PlanStepIds[OrderIndex];
+}
+
+inline uint32_t FCommandOrderView::GetTargetCount() const
+{
+    return SchedulingState->TargetCounts[OrderIndex];
+}
+
+inline uint32_t FCommandOrderView::GetRequestedQueueCount() const
+{
+    return SchedulingState->RequestedQueueCounts[OrderIndex];
+}
+
+inline UNIT_TYPEID FCommandOrderView::GetProducerUnitTypeId() const
+{
+    return SchedulingState->ProducerUnitTypeIds[OrderIndex];
+}
+
+inline UNIT_TYPEID FCommandOrderView::GetResultUnitTypeId() const
+{
+    return SchedulingState->ResultUnitTypeIds[OrderIndex];
+}
+
+inline UpgradeID FCommandOrderView::GetUpgradeId() const
+{
+    return SchedulingState->UpgradeIds[OrderIndex];
+}
+
+inline EBuildPlacementSlotType FCommandOrderView::GetPreferredPlacementSlotType() const
+{
+    return SchedulingState->PreferredPlacementSlotTypes[OrderIndex];
+}
+
+inline FBuildPlacementSlotId FCommandOrderView::GetPreferredPlacementSlotId() const
+{
+    FBuildPlacementSlotId BuildPlacementSlotIdValue;
+    BuildPlacementSlotIdValue.SlotType = SchedulingState->PreferredPlacementSlotIdTypes[OrderIndex];
+    BuildPlacementSlotIdValue.Ordinal = SchedulingState->PreferredPlacementSlotIdOrdinals[OrderIndex];
+    return BuildPlacementSlotIdValue;
+}
+
+inline FBuildPlacementSlotId FCommandOrderView::GetPreferredProducerPlacementSlotId() const
+{
+    FBuildPlacementSlotId BuildPlacementSlotIdValue;
+    BuildPlacementSlotIdValue.SlotType = SchedulingState->PreferredProducerPlacementSlotIdTypes[OrderIndex];
+    BuildPlacementSlotIdValue.Ordinal = SchedulingState->PreferredProducerPlacementSlotIdOrdinals[OrderIndex];
+    return BuildPlacementSlotIdValue;
+}
+
+inline FBuildPlacementSlotId FCommandOrderView::GetReservedPlacementSlotId() const
+{
+    FBuildPlacementSlotId BuildPlacementSlotIdValue;
+    BuildPlacementSlotIdValue.SlotType = SchedulingState->ReservedPlacementSlotTypes[OrderIndex];
+    BuildPlacementSlotIdValue.Ordinal = SchedulingState->ReservedPlacementSlotOrdinals[OrderIndex];
+    return BuildPlacementSlotIdValue;
+}
+
+inline ECommandOrderDeferralReason FCommandOrderView::GetLastDeferralReason() const
+{
+    return SchedulingState->LastDeferralReasons[OrderIndex];
+}
+
+inline uint64_t FCommandOrderView::GetLastDeferralStep() const
+{
+    if (!SchedulingState->HasDiagnosticColumns())
+    {
+        return 0U;
+    }
+
+    return SchedulingState->DiagnosticColumns.LastDeferralSteps[OrderIndex];
+}
+
+inline uint64_t FCommandOrderView::GetLastDeferralGameLoop() const
+{
+    if (!SchedulingState->HasDiagnosticColumns())
+    {
+        return 0U;
+    }
+
+    return SchedulingState->DiagnosticColumns.LastDeferralGameLoops[OrderIndex];
+}
+
+inline uint32_t FCommandOrderView::GetConsecutiveDeferralCount() const
+{
+    return SchedulingState->ConsecutiveDeferralCounts[OrderIndex];
+}
+
+inline uint64_t FCommandOrderView::GetDispatchStep() const
+{
+    if (!SchedulingState->HasDiagnosticColumns())
+    {
+        return 0U;
+    }
+
+    return SchedulingState->DiagnosticColumns.DispatchSteps[OrderIndex];
+}
+
+inline uint64_t FCommandOrderView::GetDispatchGameLoop() const
+{
+    return SchedulingState->DispatchGameLoops[OrderIndex];
+}
+
+inline uint32_t FCommandOrderView::GetObservedCountAtDispatch() const
+{
+    return SchedulingState->ObservedCountsAtDispatch[OrderIndex];
+}
+
+inline uint32_t FCommandOrderView::GetObservedInConstructionCountAtDispatch() const
+{
+    return SchedulingState->ObservedInConstructionCountsAtDispatch[OrderIndex];
+}
+
+inline uint32_t FCommandOrderView::GetDispatchAttemptCount() const
+{
+    return SchedulingState->DispatchAttemptCounts[OrderIndex];
+}
+
+}  // namespace sc2
@@ -80,6 +80,11 @@ size_t FCommandTaskSignatureKeyHash::operator()(
     const FCommandTaskSignatureKey& CommandTaskSignatureKeyValue) const
 {
     size_t HashValue = std::hash<uint32_t>{}(CommandTaskSignatureKeyValue.TaskId);
+    if (CommandTaskSignatureKeyValue.TaskId != 0U)
+    {
+        return HashValue;
+    }
+
     HashValue = CombineHash(HashValue, std::hash<uint32_t>{}(CommandTaskSignatureKeyValue.SourceGoalId));
     HashValue = CombineHash(
         HashValue, std::hash<int>{}(static_cast<int>(CommandTaskSignatureKeyValue.AbilityId.ToType())));
@@ -8,6 +8,7 @@
 #include "common/armies/FArmyMissionDescriptor.h"
 #include "common/bot_status_models.h"
 #include "sc2api/sc2_interfaces.h"
+#include "sc2api/sc2_trace.h"
 #include "sc2api/sc2_unit_filters.h"
 
 namespace sc2
@@ -252,6 +253,7 @@ void FTerranArmyOrderExpander::ExpandArmyOrders(
     const std::vector<Point2D>& ExpansionLocationsValue, const Point2D& RallyPointValue,
     FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue) const
 {
+    SC2_TRACE_ZONE("FTerranArmyOrderExpander::ExpandArmyOrders");
     if (FrameValue.Observation == nullptr)
     {
         return;
@@ -8,7 +8,9 @@
 #include "common/armies/EArmyMissionType.h"
 #include "common/armies/FArmyMissionDescriptor.h"
 #include "common/bot_status_models.h"
+#include "common/planning/FCommandOrderView.h"
 #include "common/planning/FTacticalBehaviorScore.h"
+#include "common/spatial/FUnitSpatialIndex.h"
 
 namespace sc2
 {
@@ -135,118 +137,50 @@ const FArmyMissionDescriptor* GetMissionDescriptorForArmyIndex(const FGameStateD
     return &GameStateDescriptorValue.ArmyState.ArmyMissions[ArmyIndexValue];
 }
 
-const Unit* FindNearestEnemyThreat(const Point2D& OriginPointValue, const Units& EnemyUnitsValue)
+const Unit* FindNearestEnemyThreat(const Point2D& OriginPointValue, const FUnitSpatialIndex& UnitSpatialIndexValue)
 {
-    const Unit* BestEnemyUnitValue = nullptr;
-    float BestDistanceSquaredValue = std::numeric_limits<float>::max();
-
-    for (const Unit* EnemyUnitValue : EnemyUnitsValue)
-    {
-        if (EnemyUnitValue == nullptr || !IsEnemyCombatThreat(*EnemyUnitValue))
-        {
-            continue;
-        }
-
-        const float DistanceSquaredValue = DistanceSquared2D(OriginPointValue, Point2D(EnemyUnitValue->pos));
-        if (DistanceSquaredValue >= BestDistanceSquaredValue)
-        {
-            continue;
-        }
-
-        BestDistanceSquaredValue = DistanceSquaredValue;
-        BestEnemyUnitValue = EnemyUnitValue;
-    }
-
-    return BestEnemyUnitValue;
+    return UnitSpatialIndexValue.FindNearest(OriginPointValue, Unit::Alliance::Enemy, IsEnemyCombatThreat);
 }
 
-const Unit* FindNearestEnemyStructure(const Point2D& OriginPointValue, const Units& EnemyUnitsValue)
+const Unit* FindNearestEnemyStructure(const Point2D& OriginPointValue, const FUnitSpatialIndex& UnitSpatialIndexValue)
 {
-    const Unit* BestEnemyUnitValue = nullptr;
-    float BestDistanceSquaredValue = std::numeric_limits<float>::max();
-
-    for (const Unit* EnemyUnitValue : EnemyUnitsValue)
-    {
-        if (EnemyUnitValue == nullptr || EnemyUnitValue->build_progress < 1.0f || !EnemyUnitValue->is_building)
-        {
-            continue;
-        }
-
-        const float DistanceSquaredValue = DistanceSquared2D(OriginPointValue, Point2D(EnemyUnitValue->pos));
-        if (DistanceSquaredValue >= BestDistanceSquaredValue)
-        {
-            continue;
-        }
-
-        BestDistanceSquaredValue = DistanceSquaredValue;
-        BestEnemyUnitValue = EnemyUnitValue;
-    }
-
-    return BestEnemyUnitValue;
+    return UnitSpatialIndexValue.FindNearest(OriginPointValue, Unit::Alliance::Enemy,
+                                             [](const Unit& EnemyUnitValue)
+                                             {
+                                                 return EnemyUnitValue.build_progress >= 1.0f &&
+                                                        EnemyUnitValue.is_building;
+                                             });
 }
 
-const Unit* FindNearestEnemyGroundThreat(const Point2D& OriginPointValue, const Units& EnemyUnitsValue)
+const Unit* FindNearestEnemyGroundThreat(const Point2D& OriginPointValue,
+                                         const FUnitSpatialIndex& UnitSpatialIndexValue)
 {
-    const Unit* BestEnemyUnitValue = nullptr;
-    float BestDistanceSquaredValue = std::numeric_limits<float>::max();
-
-    for (const Unit* EnemyUnitValue : EnemyUnitsValue)
-    {
-        if (EnemyUnitValue == nullptr || !IsEnemyGroundThreat(*EnemyUnitValue))
-        {
-            continue;
-        }
-
-        const float DistanceSquaredValue = DistanceSquared2D(OriginPointValue, Point2D(EnemyUnitValue->pos));
-        if (DistanceSquaredValue >= BestDistanceSquaredValue)
-        {
-            continue;
-        }
-
-        BestDistanceSquaredValue = DistanceSquaredValue;
-        BestEnemyUnitValue = EnemyUnitValue;
-    }
-
-    return BestEnemyUnitValue;
+    return UnitSpatialIndexValue.FindNearest(OriginPointValue, Unit::Alliance::Enemy, IsEnemyGroundThreat);
 }
 
-const Unit* FindNearestEnemyGroundTargetOrStructure(const Point2D& OriginPointValue, const Units& EnemyUnitsValue)
+const Unit* FindNearestEnemyGroundTargetOrStructure(const Point2D& OriginPointValue,
+                                                    const FUnitSpatialIndex& UnitSpatialIndexValue)
 {
-    const Unit* EnemyGroundThreatUnitPtrValue = FindNearestEnemyGroundThreat(OriginPointValue, EnemyUnitsValue);
+    const Unit* EnemyGroundThreatUnitPtrValue = FindNearestEnemyGroundThreat(OriginPointValue, UnitSpatialIndexValue);
     if (EnemyGroundThreatUnitPtrValue != nullptr)
     {
         return EnemyGroundThreatUnitPtrValue;
     }
 
-    return FindNearestEnemyStructure(OriginPointValue, EnemyUnitsValue);
+    return FindNearestEnemyStructure(OriginPointValue, UnitSpatialIndexValue);
 }
 
-const Unit* FindNearestWoundedBioSupportTarget(const Point2D& OriginPointValue, const Units& ControlledUnitsValue)
+const Unit* FindNearestWoundedBioSupportTarget(const Point2D& OriginPointValue,
+                                               const FUnitSpatialIndex& UnitSpatialIndexValue)
 {
-    const Unit* BestBioSupportUnitValue = nullptr;
-    float BestDistanceSquaredValue = std::numeric_limits<float>::max();
-
-    for (const Unit* ControlledUnitPtrValue : ControlledUnitsValue)
-    {
-        if (ControlledUnitPtrValue == nullptr || ControlledUnitPtrValue->build_progress < 1.0f ||
-            !IsTerranBioSupportUnitType(ControlledUnitPtrValue->unit_type.ToType()) ||
-            ControlledUnitPtrValue->health >= ControlledUnitPtrValue->health_max)
-        {
-            continue;
-        }
-
-        const float DistanceSquaredValue =
-            DistanceSquared2D(OriginPointValue, Point2D(ControlledUnitPtrValue->pos));
-        if (DistanceSquaredValue >= BestDistanceSquaredValue)
-        {
-            continue;
-        }
-
-        BestDistanceSquaredValue = DistanceSquaredValue;
-        BestBioSupportUnitValue = ControlledUnitPtrValue;
-    }
-
-    return BestBioSupportUnitValue;
+    return UnitSpatialIndexValue.FindNearest(OriginPointValue, Unit::Alliance::Self,
+                                             [](const Unit& ControlledUnitValue)
+                                             {
+                                                 return ControlledUnitValue.build_progress >= 1.0f &&
+                                                        IsTerranBioSupportUnitType(
+                                                            ControlledUnitValue.unit_type.ToType()) &&
+                                                        ControlledUnitValue.health < ControlledUnitValue.health_max;
+                                             });
 }
 
 bool TryComputeBioSupportAnchor(const Point2D& OriginPointValue, const Units& ControlledUnitsValue,
@@ -366,8 +300,10 @@ bool ShouldRefreshHoldPosition(const Unit& ActorUnitValue)
 bool IsActiveUnitExecutionOrder(const FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue,
                                 const size_t OrderIndexValue)
 {
-    return CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] == ECommandAuthorityLayer::UnitExecution &&
-           !IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]);
+    return CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer ==
+               ECommandAuthorityLayer::UnitExecution &&
+           !IsTerminalLifecycleState(
+               CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState);
 }
 
 bool DoesExecutionOrderMatchDesiredOrder(const FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue,
@@ -375,7 +311,8 @@ bool DoesExecutionOrderMatchDesiredOrder(const FCommandAuthoritySchedulingState&
                                          const FCommandOrderRecord& DesiredExecutionOrderValue)
 {
     if (!IsActiveUnitExecutionOrder(CommandAuthoritySchedulingStateValue, OrderIndexValue) ||
-        CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue] != DesiredExecutionOrderValue.ActorTag ||
+        CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag !=
+            DesiredExecutionOrderValue.ActorTag ||
         CommandAuthoritySchedulingStateValue.AbilityIds[OrderIndexValue] != DesiredExecutionOrderValue.AbilityId ||
         CommandAuthoritySchedulingStateValue.TargetKinds[OrderIndexValue] != DesiredExecutionOrderValue.TargetKind)
     {
@@ -474,7 +411,34 @@ void UpdateUnitExecutionCacheEntry(FUnitExecutionCacheEntry& UnitExecutionCacheE
     UnitExecutionCacheEntryValue.bInsideAssemblyRadius = bInsideAssemblyRadiusValue;
 }
 
-FTacticalBehaviorScore BuildAdvanceScore(const Unit& ControlledUnitValue, const FArmyMissionDescriptor& MissionDescriptorValue,
+// Ground units measure the rally point and mission objectives such as the enemy main along the cached flow field
+// toward them, so a unit across a cliff or a wall from the point has not arrived, and neither has one that cannot
+// reach it at all. Without a flow field answer, for a blocked point or once this step's flow field builds are spent,
+// the straight-line check decides.
+bool IsWithinObjectiveReach(const FFrameContext& FrameValue, const Unit& ControlledUnitValue,
+                            const Point2D& ObjectivePointValue)
+{
+    const Point2D ControlledUnitPointValue(ControlledUnitValue.pos);
+    if (DistanceSquared2D(ControlledUnitPointValue, ObjectivePointValue) > ObjectiveReachedDistanceSquaredValue)
+    {
+        return false;
+    }
+    if (ControlledUnitValue.is_flying || !HasLocalGroundPathing(FrameValue))
+    {
+        return true;
+    }
+
+    float GroundDistanceValue = 0.0f;
+    if (!FrameValue.GroundPathfinder->TryGetFlowFieldDistance(ObjectivePointValue, ControlledUnitPointValue,
+                                                             GroundDistanceValue, ControlledUnitValue.radius))
+    {
+        return true;
+    }
+    return GroundDistanceValue * GroundDistanceValue <= ObjectiveReachedDistanceSquaredValue;
+}
+
+FTacticalBehaviorScore BuildAdvanceScore(const FFrameContext& FrameValue, const Unit& ControlledUnitValue,
+                                         const FArmyMissionDescriptor& MissionDescriptorValue,
                                          const Point2D& RallyPointValue)
 {
     FTacticalBehaviorScore TacticalBehaviorScoreValue;
@@ -489,9 +453,7 @@ FTacticalBehaviorScore BuildAdvanceScore(const Unit& ControlledUnitValue, const
         TacticalBehaviorScoreValue.ScoreValue = 500;
     }
 
-    const float ObjectiveDistanceSquaredValue = DistanceSquared2D(Point2D(ControlledUnitValue.pos),
-                                                                  TacticalBehaviorScoreValue.TargetPoint);
-    if (ObjectiveDistanceSquaredValue > ObjectiveReachedDistanceSquaredValue)
+    if (!IsWithinObjectiveReach(FrameValue, ControlledUnitValue, TacticalBehaviorScoreValue.TargetPoint))
     {
         TacticalBehaviorScoreValue.ScoreValue += 250;
     }
@@ -553,7 +515,8 @@ FTacticalBehaviorScore BuildClearStructureScore(const Unit* EnemyStructureUnitPt
     }
 }
 
-FTacticalBehaviorScore BuildRegroupScore(const Unit& ControlledUnitValue, const Point2D& RallyPointValue,
+FTacticalBehaviorScore BuildRegroupScore(const FFrameContext& FrameValue, const Unit& ControlledUnitValue,
+                                         const Point2D& RallyPointValue,
                                          const FArmyMissionDescriptor& MissionDescriptorValue)
 {
     FTacticalBehaviorScore TacticalBehaviorScoreValue;
@@ -568,7 +531,7 @@ FTacticalBehaviorScore BuildRegroupScore(const Unit& ControlledUnitValue, const
     }
 
     TacticalBehaviorScoreValue.ScoreValue = 950;
-    if (DistanceSquared2D(Point2D(ControlledUnitValue.pos), RallyPointValue) <= ObjectiveReachedDistanceSquaredValue)
+    if (IsWithinObjectiveReach(FrameValue, ControlledUnitValue, RallyPointValue))
     {
         TacticalBehaviorScoreValue.ScoreValue = 300;
     }
@@ -602,7 +565,7 @@ FTacticalBehaviorScore BuildRetreatScore(const Unit& ControlledUnitValue, const
     return TacticalBehaviorScoreValue;
 }
 
-FTacticalBehaviorScore BuildHoldPositionScore(const Unit& ControlledUnitValue,
+FTacticalBehaviorScore BuildHoldPositionScore(const FFrameContext& FrameValue, const Unit& ControlledUnitValue,
                                               const FArmyMissionDescriptor& MissionDescriptorValue)
 {
     FTacticalBehaviorScore TacticalBehaviorScoreValue;
@@ -615,8 +578,7 @@ FTacticalBehaviorScore BuildHoldPositionScore(const Unit& ControlledUnitValue,
         case EArmyMissionType::DefendOwnedBase:
         case EArmyMissionType::AssembleAtRally:
         case EArmyMissionType::Regroup:
-            if (DistanceSquared2D(Point2D(ControlledUnitValue.pos), MissionDescriptorValue.ObjectivePoint) <=
-                ObjectiveReachedDistanceSquaredValue)
+            if (IsWithinObjectiveReach(FrameValue, ControlledUnitValue, MissionDescriptorValue.ObjectivePoint))
             {
                 TacticalBehaviorScoreValue.ScoreValue = 700;
             }
@@ -627,7 +589,7 @@ FTacticalBehaviorScore BuildHoldPositionScore(const Unit& ControlledUnitValue,
 }
 
 FTacticalBehaviorScore BuildMedivacSupportScore(const Unit& ControlledUnitValue, const Units& ControlledUnitsValue,
-                                                const Units& EnemyUnitsValue,
+                                                const FUnitSpatialIndex& UnitSpatialIndexValue,
                                                 const FArmyMissionDescriptor& MissionDescriptorValue,
                                                 const Point2D& RallyPointValue)
 {
@@ -640,7 +602,7 @@ FTacticalBehaviorScore BuildMedivacSupportScore(const Unit& ControlledUnitValue,
     TacticalBehaviorScoreValue.ScoreValue = std::numeric_limits<int>::min();
     const Point2D ControlledUnitPointValue = Point2D(ControlledUnitValue.pos);
     const Unit* WoundedBioSupportUnitPtrValue =
-        FindNearestWoundedBioSupportTarget(ControlledUnitPointValue, ControlledUnitsValue);
+        FindNearestWoundedBioSupportTarget(ControlledUnitPointValue, UnitSpatialIndexValue);
 
     if (WoundedBioSupportUnitPtrValue != nullptr &&
         DistanceSquared2D(ControlledUnitPointValue, Point2D(WoundedBioSupportUnitPtrValue->pos)) <=
@@ -659,7 +621,7 @@ FTacticalBehaviorScore BuildMedivacSupportScore(const Unit& ControlledUnitValue,
         return TacticalBehaviorScoreValue;
     }
 
-    const Unit* EnemyThreatUnitPtrValue = FindNearestEnemyThreat(BioSupportAnchorPointValue, EnemyUnitsValue);
+    const Unit* EnemyThreatUnitPtrValue = FindNearestEnemyThreat(BioSupportAnchorPointValue, UnitSpatialIndexValue);
     if (EnemyThreatUnitPtrValue != nullptr)
     {
         const Point2D EnemyThreatPointValue = Point2D(EnemyThreatUnitPtrValue->pos);
@@ -694,7 +656,8 @@ FTacticalBehaviorScore BuildMedivacSupportScore(const Unit& ControlledUnitValue,
     return TacticalBehaviorScoreValue;
 }
 
-FTacticalBehaviorScore BuildWidowMineControlScore(const Unit& ControlledUnitValue, const Units& EnemyUnitsValue,
+FTacticalBehaviorScore BuildWidowMineControlScore(const Unit& ControlledUnitValue,
+                                                  const FUnitSpatialIndex& UnitSpatialIndexValue,
                                                   const FArmyMissionDescriptor& MissionDescriptorValue)
 {
     constexpr float MineThreatTriggerDistanceSquaredValue = 49.0f;
@@ -704,7 +667,8 @@ FTacticalBehaviorScore BuildWidowMineControlScore(const Unit& ControlledUnitValu
     FTacticalBehaviorScore TacticalBehaviorScoreValue;
     TacticalBehaviorScoreValue.ScoreValue = std::numeric_limits<int>::min();
     const Point2D ControlledUnitPointValue = Point2D(ControlledUnitValue.pos);
-    const Unit* EnemyGroundThreatUnitPtrValue = FindNearestEnemyGroundThreat(ControlledUnitPointValue, EnemyUnitsValue);
+    const Unit* EnemyGroundThreatUnitPtrValue =
+        FindNearestEnemyGroundThreat(ControlledUnitPointValue, UnitSpatialIndexValue);
     const bool IsNearMissionAnchorValue =
         DistanceSquared2D(ControlledUnitPointValue, MissionDescriptorValue.ObjectivePoint) <=
         MineAnchorDistanceSquaredValue;
@@ -740,7 +704,8 @@ FTacticalBehaviorScore BuildWidowMineControlScore(const Unit& ControlledUnitValu
     return TacticalBehaviorScoreValue;
 }
 
-FTacticalBehaviorScore BuildSiegeTankControlScore(const Unit& ControlledUnitValue, const Units& EnemyUnitsValue,
+FTacticalBehaviorScore BuildSiegeTankControlScore(const Unit& ControlledUnitValue,
+                                                  const FUnitSpatialIndex& UnitSpatialIndexValue,
                                                   const FArmyMissionDescriptor& MissionDescriptorValue)
 {
     constexpr float SiegeTankEngageDistanceSquaredValue = 121.0f;
@@ -751,7 +716,7 @@ FTacticalBehaviorScore BuildSiegeTankControlScore(const Unit& ControlledUnitValu
     TacticalBehaviorScoreValue.ScoreValue = std::numeric_limits<int>::min();
     const Point2D ControlledUnitPointValue = Point2D(ControlledUnitValue.pos);
     const Unit* EnemyGroundTargetUnitPtrValue =
-        FindNearestEnemyGroundTargetOrStructure(ControlledUnitPointValue, EnemyUnitsValue);
+        FindNearestEnemyGroundTargetOrStructure(ControlledUnitPointValue, UnitSpatialIndexValue);
     const bool IsNearMissionAnchorValue =
         DistanceSquared2D(ControlledUnitPointValue, MissionDescriptorValue.ObjectivePoint) <=
         SiegeTankAnchorDistanceSquaredValue;
@@ -787,43 +752,45 @@ FTacticalBehaviorScore BuildSiegeTankControlScore(const Unit& ControlledUnitValu
 }
 
 FTacticalBehaviorScore SelectSpecializedBehaviorScore(const Unit& ControlledUnitValue, const Units& ControlledUnitsValue,
-                                                      const Units& EnemyUnitsValue,
+                                                      const FUnitSpatialIndex& UnitSpatialIndexValue,
                                                       const FArmyMissionDescriptor& MissionDescriptorValue,
                                                       const Point2D& RallyPointValue)
 {
     switch (ControlledUnitValue.unit_type.ToType())
     {
         case UNIT_TYPEID::TERRAN_MEDIVAC:
-            return BuildMedivacSupportScore(ControlledUnitValue, ControlledUnitsValue, EnemyUnitsValue,
+            return BuildMedivacSupportScore(ControlledUnitValue, ControlledUnitsValue, UnitSpatialIndexValue,
                                             MissionDescriptorValue, RallyPointValue);
         case UNIT_TYPEID::TERRAN_WIDOWMINE:
         case UNIT_TYPEID::TERRAN_WIDOWMINEBURROWED:
-            return BuildWidowMineControlScore(ControlledUnitValue, EnemyUnitsValue, MissionDescriptorValue);
+            return BuildWidowMineControlScore(ControlledUnitValue, UnitSpatialIndexValue, MissionDescriptorValue);
         case UNIT_TYPEID::TERRAN_SIEGETANK:
         case UNIT_TYPEID::TERRAN_SIEGETANKSIEGED:
-            return BuildSiegeTankControlScore(ControlledUnitValue, EnemyUnitsValue, MissionDescriptorValue);
+            return BuildSiegeTankControlScore(ControlledUnitValue, UnitSpatialIndexValue, MissionDescriptorValue);
         default:
             return FTacticalBehaviorScore();
     }
 }
 
-FTacticalBehaviorScore SelectBestBehaviorScore(const Unit& ControlledUnitValue, const Units& EnemyUnitsValue,
+FTacticalBehaviorScore SelectBestBehaviorScore(const FFrameContext& FrameValue, const Unit& ControlledUnitValue,
+                                               const FUnitSpatialIndex& UnitSpatialIndexValue,
                                                const FArmyMissionDescriptor& MissionDescriptorValue,
                                                const Point2D& RallyPointValue)
 {
-    const Unit* EnemyThreatUnitPtrValue = FindNearestEnemyThreat(Point2D(ControlledUnitValue.pos), EnemyUnitsValue);
+    const Unit* EnemyThreatUnitPtrValue =
+        FindNearestEnemyThreat(Point2D(ControlledUnitValue.pos), UnitSpatialIndexValue);
     const Unit* EnemyStructureUnitPtrValue =
-        FindNearestEnemyStructure(MissionDescriptorValue.ObjectivePoint, EnemyUnitsValue);
+        FindNearestEnemyStructure(MissionDescriptorValue.ObjectivePoint, UnitSpatialIndexValue);
 
-    FTacticalBehaviorScore BestBehaviorScoreValue = BuildAdvanceScore(ControlledUnitValue, MissionDescriptorValue,
-                                                                      RallyPointValue);
+    FTacticalBehaviorScore BestBehaviorScoreValue =
+        BuildAdvanceScore(FrameValue, ControlledUnitValue, MissionDescriptorValue, RallyPointValue);
 
     const std::array<FTacticalBehaviorScore, 5U> CandidateScoresValue = {
         BuildAttackThreatScore(ControlledUnitValue, EnemyThreatUnitPtrValue, MissionDescriptorValue),
         BuildClearStructureScore(EnemyStructureUnitPtrValue, MissionDescriptorValue),
-        BuildRegroupScore(ControlledUnitValue, RallyPointValue, MissionDescriptorValue),
+        BuildRegroupScore(FrameValue, ControlledUnitValue, RallyPointValue, MissionDescriptorValue),
         BuildRetreatScore(ControlledUnitValue, EnemyThreatUnitPtrValue, RallyPointValue),
-        BuildHoldPositionScore(ControlledUnitValue, MissionDescriptorValue)};
+        BuildHoldPositionScore(FrameValue, ControlledUnitValue, MissionDescriptorValue)};
 
     for (const FTacticalBehaviorScore& CandidateScoreValue : CandidateScoresValue)
     {
@@ -838,7 +805,7 @@ FTacticalBehaviorScore SelectBestBehaviorScore(const Unit& ControlledUnitValue,
 
 FCommandOrderRecord CreateBehaviorExecutionOrder(const Unit& ControlledUnitValue,
                                                  const FTacticalBehaviorScore& TacticalBehaviorScoreValue,
-                                                 const FCommandOrderRecord& SquadOrderValue,
+                                                 const FCommandOrderView& SquadOrderValue,
                                                  const uint64_t CurrentGameLoopValue)
 {
     switch (TacticalBehaviorScoreValue.Behavior)
@@ -848,9 +815,9 @@ FCommandOrderRecord CreateBehaviorExecutionOrder(const Unit& ControlledUnitValue
             {
                 return FCommandOrderRecord::CreateUnitTarget(
                     ECommandAuthorityLayer::UnitExecution, ControlledUnitValue.tag, ABILITY_ID::EFFECT_HEAL,
-                    TacticalBehaviorScoreValue.TargetUnitTag, SquadOrderValue.BasePriorityValue,
-                    EIntentDomain::ArmyCombat, CurrentGameLoopValue, 0U, SquadOrderValue.OrderId,
-                    SquadOrderValue.OwningArmyIndex, SquadOrderValue.OwningSquadIndex, false);
+                    TacticalBehaviorScoreValue.TargetUnitTag, SquadOrderValue.GetBasePriorityValue(),
+                    EIntentDomain::ArmyCombat, CurrentGameLoopValue, 0U, SquadOrderValue.GetOrderId(),
+                    SquadOrderValue.GetOwningArmyIndex(), SquadOrderValue.GetOwningSquadIndex(), false);
             }
             break;
         case EUnitTacticalBehavior::AttackLocalThreat:
@@ -860,53 +827,59 @@ FCommandOrderRecord CreateBehaviorExecutionOrder(const Unit& ControlledUnitValue
             {
                 return FCommandOrderRecord::CreateUnitTarget(
                     ECommandAuthorityLayer::UnitExecution, ControlledUnitValue.tag, ABILITY_ID::ATTACK_ATTACK,
-                    TacticalBehaviorScoreValue.TargetUnitTag, SquadOrderValue.BasePriorityValue,
-                    EIntentDomain::ArmyCombat, CurrentGameLoopValue, 0U, SquadOrderValue.OrderId,
-                    SquadOrderValue.OwningArmyIndex, SquadOrderValue.OwningSquadIndex, false);
+                    TacticalBehaviorScoreValue.TargetUnitTag, SquadOrderValue.GetBasePriorityValue(),
+                    EIntentDomain::ArmyCombat, CurrentGameLoopValue, 0U, SquadOrderValue.GetOrderId(),
+                    SquadOrderValue.GetOwningArmyIndex(), SquadOrderValue.GetOwningSquadIndex(), false);
             }
             break;
         case EUnitTacticalBehavior::HoldPosition:
             return FCommandOrderRecord::CreateNoTarget(ECommandAuthorityLayer::UnitExecution, ControlledUnitValue.tag,
                                                        ABILITY_ID::GENERAL_HOLDPOSITION,
-                                                       SquadOrderValue.BasePriorityValue, EIntentDomain::ArmyCombat,
-                                                       CurrentGameLoopValue, 0U, SquadOrderValue.OrderId,
-                                                       SquadOrderValue.OwningArmyIndex,
-                                                       SquadOrderValue.OwningSquadIndex, false);
+                                                       SquadOrderValue.GetBasePriorityValue(),
+                                                       EIntentDomain::ArmyCombat,
+                                                       CurrentGameLoopValue, 0U, SquadOrderValue.GetOrderId(),
+                                                       SquadOrderValue.GetOwningArmyIndex(),
+                                                       SquadOrderValue.GetOwningSquadIndex(), false);
         case EUnitTacticalBehavior::BurrowDownForAmbush:
             return FCommandOrderRecord::CreateNoTarget(ECommandAuthorityLayer::UnitExecution, ControlledUnitValue.tag,
                                                        ABILITY_ID::BURROWDOWN,
-                                                       SquadOrderValue.BasePriorityValue, EIntentDomain::ArmyCombat,
-                                                       CurrentGameLoopValue, 0U, SquadOrderValue.OrderId,
-                                                       SquadOrderValue.OwningArmyIndex,
-                                                       SquadOrderValue.OwningSquadIndex, false);
+                                                       SquadOrderValue.GetBasePriorityValue(),
+                                                       EIntentDomain::ArmyCombat,
+                                                       CurrentGameLoopValue, 0U, SquadOrderValue.GetOrderId(),
+                                                       SquadOrderValue.GetOwningArmyIndex(),
+                                                       SquadOrderValue.GetOwningSquadIndex(), false);
         case EUnitTacticalBehavior::BurrowUpForAdvance:
             return FCommandOrderRecord::CreateNoTarget(ECommandAuthorityLayer::UnitExecution, ControlledUnitValue.tag,
                                                        ABILITY_ID::BURROWUP,
-                                                       SquadOrderValue.BasePriorityValue, EIntentDomain::ArmyCombat,
-                                                       CurrentGameLoopValue, 0U, SquadOrderValue.OrderId,
-                                                       SquadOrderValue.OwningArmyIndex,
-                                                       SquadOrderValue.OwningSquadIndex, false);
+                                                       SquadOrderValue.GetBasePriorityValue(),
+                                                       EIntentDomain::ArmyCombat,
+                                                       CurrentGameLoopValue, 0U, SquadOrderValue.GetOrderId(),
+                                                       SquadOrderValue.GetOwningArmyIndex(),
+                                                       SquadOrderValue.GetOwningSquadIndex(), false);
         case EUnitTacticalBehavior::SiegeForAnchor:
             return FCommandOrderRecord::CreateNoTarget(ECommandAuthorityLayer::UnitExecution, ControlledUnitValue.tag,
                                                        ABILITY_ID::MORPH_SIEGEMODE,
-                                                       SquadOrderValue.BasePriorityValue, EIntentDomain::ArmyCombat,
-                                                       CurrentGameLoopValue, 0U, SquadOrderValue.OrderId,
-                                                       SquadOrderValue.OwningArmyIndex,
-                                                       SquadOrderValue.OwningSquadIndex, false);
+                                                       SquadOrderValue.GetBasePriorityValue(),
+                                                       EIntentDomain::ArmyCombat,
+                                                       CurrentGameLoopValue, 0U, SquadOrderValue.GetOrderId(),
+                                                       SquadOrderValue.GetOwningArmyIndex(),
+                                                       SquadOrderValue.GetOwningSquadIndex(), false);
         case EUnitTacticalBehavior::UnsiegeForAdvance:
             return FCommandOrderRecord::CreateNoTarget(ECommandAuthorityLayer::UnitExecution, ControlledUnitValue.tag,
                                                        ABILITY_ID::MORPH_UNSIEGE,
-                                                       SquadOrderValue.BasePriorityValue, EIntentDomain::ArmyCombat,
-                                                       CurrentGameLoopValue, 0U, SquadOrderValue.OrderId,
-                                                       SquadOrderValue.OwningArmyIndex,
-                                                       SquadOrderValue.OwningSquadIndex, false);
+                                                       SquadOrderValue.GetBasePriorityValue(),
+                                                       EIntentDomain::ArmyCombat,
+                                                       CurrentGameLoopValue, 0U, SquadOrderValue.GetOrderId(),
+                                                       SquadOrderValue.GetOwningArmyIndex(),
+                                                       SquadOrderValue.GetOwningSquadIndex(), false);
         case EUnitTacticalBehavior::SupportBioAnchor:
             return FCommandOrderRecord::CreatePointTarget(ECommandAuthorityLayer::UnitExecution, ControlledUnitValue.tag,
                                                           ABILITY_ID::MOVE_MOVE, TacticalBehaviorScoreValue.TargetPoint,
-                                                          SquadOrderValue.BasePriorityValue, EIntentDomain::ArmyCombat,
-                                                          CurrentGameLoopValue, 0U, SquadOrderValue.OrderId,
-                                                          SquadOrderValue.OwningArmyIndex,
-                                                          SquadOrderValue.OwningSquadIndex, true, false, false);
+                                                          SquadOrderValue.GetBasePriorityValue(),
+                                                          EIntentDomain::ArmyCombat,
+                                                          CurrentGameLoopValue, 0U, SquadOrderValue.GetOrderId(),
+                                                          SquadOrderValue.GetOwningArmyIndex(),
+                                                          SquadOrderValue.GetOwningSquadIndex(), true, false, false);
         case EUnitTacticalBehavior::AdvanceToMissionAnchor:
         case EUnitTacticalBehavior::RegroupToSquadAnchor:
         case EUnitTacticalBehavior::RetreatToSafeAnchor:
@@ -918,10 +891,11 @@ FCommandOrderRecord CreateBehaviorExecutionOrder(const Unit& ControlledUnitValue
     const ABILITY_ID AbilityIdValue = IsSupportUnitValue ? ABILITY_ID::MOVE_MOVE : ABILITY_ID::ATTACK_ATTACK;
     return FCommandOrderRecord::CreatePointTarget(ECommandAuthorityLayer::UnitExecution, ControlledUnitValue.tag,
                                                   AbilityIdValue, TacticalBehaviorScoreValue.TargetPoint,
-                                                  SquadOrderValue.BasePriorityValue, EIntentDomain::ArmyCombat,
-                                                  CurrentGameLoopValue, 0U, SquadOrderValue.OrderId,
-                                                  SquadOrderValue.OwningArmyIndex, SquadOrderValue.OwningSquadIndex,
-                                                  true, false, false);
+                                                  SquadOrderValue.GetBasePriorityValue(),
+                                                  EIntentDomain::ArmyCombat,
+                                                  CurrentGameLoopValue, 0U, SquadOrderValue.GetOrderId(),
+                                                  SquadOrderValue.GetOwningArmyIndex(),
+                                                  SquadOrderValue.GetOwningSquadIndex(), true, false, false);
 }
 
 bool ShouldCreateExecutionOrder(const Unit& ControlledUnitValue, const FTacticalBehaviorScore& TacticalBehaviorScoreValue)
@@ -981,7 +955,12 @@ uint32_t FTerranArmyUnitExecutionPlanner::ExpandUnitExecutionOrders(
     uint32_t CreatedExecutionOrderCountValue = 0U;
     uint32_t ActiveUnitExecutionOrderCountValue =
         CountActiveUnitExecutionOrders(CommandAuthoritySchedulingStateValue);
-    const Units EnemyUnitsValue = FrameValue.Observation->GetUnits(Unit::Alliance::Enemy);
+    const FUnitSpatialIndex* UnitSpatialIndexPtrValue = FrameValue.UnitSpatialIndex;
+    if (UnitSpatialIndexPtrValue == nullptr)
+    {
+        FallbackUnitSpatialIndex.Build(FrameValue.Observation->GetUnits());
+        UnitSpatialIndexPtrValue = &FallbackUnitSpatialIndex;
+    }
     const std::vector<size_t> SquadOrderIndicesValue = CommandAuthoritySchedulingStateValue.SquadOrderIndices;
     std::unordered_set<Tag> ActiveCombatUnitTagsValue;
 
@@ -992,18 +971,18 @@ uint32_t FTerranArmyUnitExecutionPlanner::ExpandUnitExecutionOrders(
             break;
         }
 
-        const FCommandOrderRecord SquadOrderValue = CommandAuthoritySchedulingStateValue.GetOrderRecord(SquadOrderIndexValue);
-        if (SquadOrderValue.SourceLayer != ECommandAuthorityLayer::Squad ||
-            IsTerminalLifecycleState(SquadOrderValue.LifecycleState))
+        const FCommandOrderView SquadOrderValue = CommandAuthoritySchedulingStateValue.GetOrderView(SquadOrderIndexValue);
+        if (SquadOrderValue.GetSourceLayer() != ECommandAuthorityLayer::Squad ||
+            IsTerminalLifecycleState(SquadOrderValue.GetLifecycleState()))
         {
             continue;
         }
 
         const FArmyMissionDescriptor* MissionDescriptorPtrValue =
-            GetMissionDescriptorForArmyIndex(GameStateDescriptorValue, SquadOrderValue.OwningArmyIndex);
+            GetMissionDescriptorForArmyIndex(GameStateDescriptorValue, SquadOrderValue.GetOwningArmyIndex());
         if (MissionDescriptorPtrValue == nullptr)
         {
-            CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(SquadOrderValue.OrderId,
+            CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(SquadOrderValue.GetOrderId(),
                                                                        EOrderLifecycleState::Aborted);
             continue;
         }
@@ -1024,12 +1003,13 @@ uint32_t FTerranArmyUnitExecutionPlanner::ExpandUnitExecutionOrders(
 
             ActiveCombatUnitTagsValue.insert(ControlledUnitPtrValue->tag);
             FTacticalBehaviorScore TacticalBehaviorScoreValue = SelectSpecializedBehaviorScore(
-                *ControlledUnitPtrValue, AgentStateValue.UnitContainer.ControlledUnits, EnemyUnitsValue,
+                *ControlledUnitPtrValue, AgentStateValue.UnitContainer.ControlledUnits, *UnitSpatialIndexPtrValue,
                 *MissionDescriptorPtrValue, RallyPointValue);
             if (TacticalBehaviorScoreValue.ScoreValue == std::numeric_limits<int>::min())
             {
-                TacticalBehaviorScoreValue = SelectBestBehaviorScore(*ControlledUnitPtrValue, EnemyUnitsValue,
-                                                                     *MissionDescriptorPtrValue, RallyPointValue);
+                TacticalBehaviorScoreValue =
+                    SelectBestBehaviorScore(FrameValue, *ControlledUnitPtrValue, *UnitSpatialIndexPtrValue,
+                                            *MissionDescriptorPtrValue, RallyPointValue);
             }
             if (TacticalBehaviorScoreValue.ScoreValue == std::numeric_limits<int>::min())
             {
@@ -1039,8 +1019,7 @@ uint32_t FTerranArmyUnitExecutionPlanner::ExpandUnitExecutionOrders(
             FCommandOrderRecord UnitExecutionOrderValue = CreateBehaviorExecutionOrder(
                 *ControlledUnitPtrValue, TacticalBehaviorScoreValue, SquadOrderValue, FrameValue.GameLoop);
             const bool bInsideAssemblyRadiusValue =
-                DistanceSquared2D(Point2D(ControlledUnitPtrValue->pos), RallyPointValue) <=
-                ObjectiveReachedDistanceSquaredValue;
+                IsWithinObjectiveReach(FrameValue, *ControlledUnitPtrValue, RallyPointValue);
             FUnitExecutionCacheEntry& UnitExecutionCacheEntryValue =
                 UnitExecutionCacheEntries[ControlledUnitPtrValue->tag];
             const bool bShouldCreateExecutionOrderValue =
@@ -1088,13 +1067,13 @@ uint32_t FTerranArmyUnitExecutionPlanner::ExpandUnitExecutionOrders(
                 continue;
             }
 
-            UnitExecutionOrderValue.SourceGoalId = SquadOrderValue.SourceGoalId;
-            UnitExecutionOrderValue.TaskPackageKind = SquadOrderValue.TaskPackageKind;
-            UnitExecutionOrderValue.TaskNeedKind = SquadOrderValue.TaskNeedKind;
-            UnitExecutionOrderValue.TaskType = SquadOrderValue.TaskType;
-            UnitExecutionOrderValue.Origin = SquadOrderValue.Origin;
-            UnitExecutionOrderValue.EffectivePriorityValue = SquadOrderValue.EffectivePriorityValue;
-            UnitExecutionOrderValue.PriorityTier = SquadOrderValue.PriorityTier;
+            UnitExecutionOrderValue.SourceGoalId = SquadOrderValue.GetSourceGoalId();
+            UnitExecutionOrderValue.TaskPackageKind = SquadOrderValue.GetTaskPackageKind();
+            UnitExecutionOrderValue.TaskNeedKind = SquadOrderValue.GetTaskNeedKind();
+            UnitExecutionOrderValue.TaskType = SquadOrderValue.GetTaskType();
+            UnitExecutionOrderValue.Origin = SquadOrderValue.GetOrigin();
+            UnitExecutionOrderValue.EffectivePriorityValue = SquadOrderValue.GetEffectivePriorityValue();
+            UnitExecutionOrderValue.PriorityTier = SquadOrderValue.GetPriorityTier();
             UnitExecutionOrderValue.LifecycleState = EOrderLifecycleState::Ready;
             CommandAuthoritySchedulingStateValue.EnqueueOrder(UnitExecutionOrderValue);
             UpdateUnitExecutionCacheEntry(UnitExecutionCacheEntryValue, MissionRevisionValue,
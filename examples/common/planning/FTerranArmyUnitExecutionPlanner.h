@@ -4,6 +4,7 @@
 
 #include "common/planning/FUnitExecutionCacheEntry.h"
 #include "common/planning/IUnitExecutionPlanner.h"
+#include "common/spatial/FUnitSpatialIndex.h"
 
 namespace sc2
 {
@@ -18,6 +19,8 @@ public:
 
 private:
     mutable std::unordered_map<Tag, FUnitExecutionCacheEntry> UnitExecutionCacheEntries;
+    // Used only when the frame carries no shared index.
+    mutable FUnitSpatialIndex FallbackUnitSpatialIndex;
 };
 
 }  // namespace sc2
@@ -9,6 +9,7 @@
 #include "common/planning/FBlockedTaskRecord.h"
 #include "common/planning/FCommandAuthoritySchedulingState.h"
 #include "common/planning/FCommandOrderRecord.h"
+#include "common/planning/FCommandOrderView.h"
 #include "common/planning/FCommandTaskSignatureKey.h"
 
 namespace sc2
@@ -545,32 +546,38 @@ FBlockedTaskRecord CreateBlockedTaskRecord(const FCommandOrderRecord& CommandOrd
     return BlockedTaskRecordValue;
 }
 
+bool IsGoalDrivenContinuousProductionOrder(const ECommandTaskOrigin OriginValue, const ECommandTaskType TaskTypeValue)
+{
+    return OriginValue == ECommandTaskOrigin::GoalMacro &&
+           (TaskTypeValue == ECommandTaskType::UnitProduction || TaskTypeValue == ECommandTaskType::AddOn ||
+            TaskTypeValue == ECommandTaskType::ProductionStructure);
+}
+
 bool IsGoalDrivenContinuousProductionOrder(const FCommandOrderRecord& CommandOrderRecordValue)
 {
-    return CommandOrderRecordValue.Origin == ECommandTaskOrigin::GoalMacro &&
-           (CommandOrderRecordValue.TaskType == ECommandTaskType::UnitProduction ||
-            CommandOrderRecordValue.TaskType == ECommandTaskType::AddOn ||
-            CommandOrderRecordValue.TaskType == ECommandTaskType::ProductionStructure);
+    return IsGoalDrivenContinuousProductionOrder(CommandOrderRecordValue.Origin, CommandOrderRecordValue.TaskType);
 }
 
-bool ShouldParkDeferredOrder(const FCommandOrderRecord& CommandOrderRecordValue)
+bool ShouldParkDeferredOrder(const FCommandOrderView& CommandOrderViewValue)
 {
-    switch (CommandOrderRecordValue.LastDeferralReason)
+    const bool IsGoalDrivenValue =
+        IsGoalDrivenContinuousProductionOrder(CommandOrderViewValue.GetOrigin(), CommandOrderViewValue.GetTaskType());
+    switch (CommandOrderViewValue.GetLastDeferralReason())
     {
         case ECommandOrderDeferralReason::NoProducer:
-            return !IsGoalDrivenContinuousProductionOrder(CommandOrderRecordValue);
+            return !IsGoalDrivenValue;
         case ECommandOrderDeferralReason::InsufficientResources:
-            return !IsGoalDrivenContinuousProductionOrder(CommandOrderRecordValue);
+            return !IsGoalDrivenValue;
         case ECommandOrderDeferralReason::NoValidPlacement:
         case ECommandOrderDeferralReason::ReservedSlotOccupied:
         case ECommandOrderDeferralReason::ReservedSlotInvalidated:
             return true;
         case ECommandOrderDeferralReason::ProducerBusy:
-            if (IsGoalDrivenContinuousProductionOrder(CommandOrderRecordValue))
+            if (IsGoalDrivenValue)
             {
                 return false;
             }
-            return CommandOrderRecordValue.ConsecutiveDeferralCount >= 3U;
+            return CommandOrderViewValue.GetConsecutiveDeferralCount() >= 3U;
         default:
             return false;
     }
@@ -874,24 +881,30 @@ void FTerranCommandTaskAdmissionService::ParkDeferredOrders(FGameStateDescriptor
 
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
     {
-        if (IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+        if (IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
 
-        const ECommandAuthorityLayer SourceLayerValue = CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue];
-        if (SourceLayerValue != ECommandAuthorityLayer::EconomyAndProduction &&
-            SourceLayerValue != ECommandAuthorityLayer::StrategicDirector)
+        const ECommandAuthorityLayer SourceLayerValue =
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer;
+        if ((SourceLayerValue != ECommandAuthorityLayer::EconomyAndProduction &&
+             SourceLayerValue != ECommandAuthorityLayer::StrategicDirector) ||
+            CommandAuthoritySchedulingStateValue.LastDeferralReasons[OrderIndexValue] ==
+                ECommandOrderDeferralReason::None)
         {
             continue;
         }
 
-        const FCommandOrderRecord DeferredOrderValue = CommandAuthoritySchedulingStateValue.GetOrderRecord(OrderIndexValue);
-        if (!ShouldParkDeferredOrder(DeferredOrderValue))
+        // Most live orders are not parked, so decide from the few columns involved before copying the whole record.
+        if (!ShouldParkDeferredOrder(CommandAuthoritySchedulingStateValue.GetOrderView(OrderIndexValue)))
         {
             continue;
         }
 
+        const FCommandOrderRecord DeferredOrderValue = CommandAuthoritySchedulingStateValue.GetOrderRecord(OrderIndexValue);
+
         FCommandOrderRecord RootOrderValue = DeferredOrderValue;
         if (DeferredOrderValue.SourceLayer == ECommandAuthorityLayer::EconomyAndProduction &&
             DeferredOrderValue.ParentOrderId != 0U)
@@ -899,8 +912,10 @@ void FTerranCommandTaskAdmissionService::ParkDeferredOrders(FGameStateDescriptor
             size_t ParentOrderIndexValue = 0U;
             if (CommandAuthoritySchedulingStateValue.TryGetOrderIndex(DeferredOrderValue.ParentOrderId,
                                                                       ParentOrderIndexValue) &&
-                !IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[ParentOrderIndexValue]) &&
-                IsStrategicBufferLayer(CommandAuthoritySchedulingStateValue.SourceLayers[ParentOrderIndexValue]))
+                !IsTerminalLifecycleState(
+                    CommandAuthoritySchedulingStateValue.OrderHotFields[ParentOrderIndexValue].LifecycleState) &&
+                IsStrategicBufferLayer(
+                    CommandAuthoritySchedulingStateValue.OrderHotFields[ParentOrderIndexValue].SourceLayer))
             {
                 RootOrderValue = CommandAuthoritySchedulingStateValue.GetOrderRecord(ParentOrderIndexValue);
             }
@@ -176,22 +176,20 @@ void FTerranCommandTaskPriorityService::UpdateTaskPriorities(FGameStateDescripto
         const int FocusWeightValue =
             GetFocusWeight(GameStateDescriptorValue.MacroState.PrimaryProductionFocus,
                            CommandAuthoritySchedulingStateValue.TaskTypes[OrderIndexValue]);
-        const int EffectivePriorityValue = CommandAuthoritySchedulingStateValue.BasePriorityValues[OrderIndexValue] +
-                                           GetTaskTypeWeight(CommandAuthoritySchedulingStateValue.TaskTypes[OrderIndexValue]) +
-                                           FocusWeightValue +
-                                           GetEmergencyWeight(GameStateDescriptorValue,
-                                                              CommandAuthoritySchedulingStateValue,
-                                                              OrderIndexValue);
-        CommandAuthoritySchedulingStateValue.EffectivePriorityValues[OrderIndexValue] = EffectivePriorityValue;
+        const int EffectivePriorityValue =
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].BasePriorityValue +
+            GetTaskTypeWeight(CommandAuthoritySchedulingStateValue.TaskTypes[OrderIndexValue]) + FocusWeightValue +
+            GetEmergencyWeight(GameStateDescriptorValue, CommandAuthoritySchedulingStateValue, OrderIndexValue);
         const ECommandPriorityTier RawPriorityTierValue =
             DeterminePriorityTier(GameStateDescriptorValue, CommandAuthoritySchedulingStateValue, OrderIndexValue,
                                   EffectivePriorityValue);
-        CommandAuthoritySchedulingStateValue.PriorityTiers[OrderIndexValue] =
+        const ECommandPriorityTier PriorityTierValue =
             ApplyOpeningBlendPriorityTierClamp(GameStateDescriptorValue, CommandAuthoritySchedulingStateValue,
                                                OrderIndexValue, RawPriorityTierValue);
+        CommandAuthoritySchedulingStateValue.SetOrderPriorityByIndex(OrderIndexValue, EffectivePriorityValue,
+                                                                     PriorityTierValue);
     }
 
-    CommandAuthoritySchedulingStateValue.bDerivedQueuesDirty = true;
     CommandAuthoritySchedulingStateValue.bPrioritiesDirty = false;
     CommandAuthoritySchedulingStateValue.EndMutationBatch();
 }
@@ -10,7 +10,10 @@
 #include "common/catalogs/FTerranGoalRuleLibrary.h"
 #include "common/economic_models.h"
 #include "common/economy/EconomyForecastConstants.h"
+#include "common/services/FPlacementFootprintEvaluator.h"
+#include "common/services/FStructureFootprintHelper.h"
 #include "sc2api/sc2_map_info.h"
+#include "sc2api/sc2_trace.h"
 #include "sc2api/sc2_unit_filters.h"
 
 namespace sc2
@@ -186,7 +189,8 @@ void ExpireOpeningStepOrders(FGameStateDescriptor& GameStateDescriptorValue, con
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue] != StrategicOrderIdValue ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -301,10 +305,6 @@ bool DoesPlacementSlotSatisfyFootprintPolicy(const FFrameContext& FrameValue,
                                              const FBuildPlacementSlot& BuildPlacementSlotValue,
                                              const ABILITY_ID StructureAbilityIdValue);
 
-Point2D GetStructureFootprintHalfExtentsForAbility(const ABILITY_ID StructureAbilityIdValue);
-
-Point2D GetStructureFootprintHalfExtentsForUnitType(const UNIT_TYPEID UnitTypeIdValue);
-
 bool DoAxisAlignedFootprintsOverlap(const Point2D& CenterPointOneValue, const Point2D& HalfExtentsOneValue,
                                     const Point2D& CenterPointTwoValue, const Point2D& HalfExtentsTwoValue);
 
@@ -312,7 +312,8 @@ bool DoesStructureAbilityRequireAddonClearance(const ABILITY_ID StructureAbility
 
 Point2D GetAddonFootprintCenter(const Point2D& StructureBuildPointValue);
 
-bool DoesAddonFootprintSupportTerrain(const GameInfo& GameInfoValue, const Point2D& StructureBuildPointValue);
+bool DoesAddonFootprintSupportTerrain(const GameInfo& GameInfoValue, const Point2D& StructureBuildPointValue,
+                                      const MapGrids* MapGridsPtrValue = nullptr);
 
 bool DoesAddonFootprintAvoidObservedStructures(const ObservationInterface& ObservationValue,
                                                const Point2D& StructureBuildPointValue);
@@ -520,9 +521,10 @@ uint32_t CountPendingSchedulerOrdersForAbility(const FCommandAuthorityScheduling
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::UnitExecution ||
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
+                ECommandAuthorityLayer::UnitExecution ||
             CommandAuthoritySchedulingStateValue.AbilityIds[OrderIndexValue] != AbilityIdValue ||
-            IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -559,8 +561,8 @@ bool HasActiveSchedulerOrderForActor(const FCommandAuthoritySchedulingState& Com
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue] != ActorTagValue ||
-            IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag != ActorTagValue ||
+            IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -580,8 +582,8 @@ bool HasActiveSchedulerOrderForActorExcludingOrder(
          ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.OrderIds[OrderIndexValue] == IgnoredOrderIdValue ||
-            CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue] != ActorTagValue ||
-            IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag != ActorTagValue ||
+            IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -607,8 +609,8 @@ uint32_t CountActiveSchedulerOrdersForActor(const FCommandAuthoritySchedulingSta
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue] == ActorTagValue &&
-            !IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag == ActorTagValue &&
+            !IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             ++OrderCountValue;
         }
@@ -624,11 +626,14 @@ uint32_t CountActiveUnitProductionSchedulerOrdersForActor(
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue] != ActorTagValue ||
-            IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]) ||
-            CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue] == EOrderLifecycleState::Dispatched ||
-            CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::UnitExecution ||
-            CommandAuthoritySchedulingStateValue.IntentDomains[OrderIndexValue] != EIntentDomain::UnitProduction)
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag != ActorTagValue ||
+            IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState) ||
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState ==
+                EOrderLifecycleState::Dispatched ||
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
+                ECommandAuthorityLayer::UnitExecution ||
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].IntentDomain !=
+                EIntentDomain::UnitProduction)
         {
             continue;
         }
@@ -646,8 +651,8 @@ bool HasPendingMorphOrderForActor(
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue] != ActorTagValue ||
-            IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag != ActorTagValue ||
+            IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -669,7 +674,7 @@ uint32_t CountPendingMorphOrders(
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+        if (IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -689,20 +694,24 @@ bool HasConflictingSchedulerOrderForProductionActor(
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue] != ActorTagValue ||
-            IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag != ActorTagValue ||
+            IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
 
-        if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] == ECommandAuthorityLayer::UnitExecution &&
-            CommandAuthoritySchedulingStateValue.IntentDomains[OrderIndexValue] == EIntentDomain::UnitProduction)
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer ==
+                ECommandAuthorityLayer::UnitExecution &&
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].IntentDomain ==
+                EIntentDomain::UnitProduction)
         {
             continue;
         }
 
-        if (CommandAuthoritySchedulingStateValue.IntentDomains[OrderIndexValue] == EIntentDomain::StructureBuild &&
-            CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue] != EOrderLifecycleState::Dispatched)
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].IntentDomain ==
+                EIntentDomain::StructureBuild &&
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState !=
+                EOrderLifecycleState::Dispatched)
         {
             continue;
         }
@@ -720,8 +729,9 @@ bool HasActiveUnitExecutionChild(const FCommandAuthoritySchedulingState& Command
          ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue] == ParentOrderIdValue &&
-            CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] == ECommandAuthorityLayer::UnitExecution &&
-            !IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer ==
+                ECommandAuthorityLayer::UnitExecution &&
+            !IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             return true;
         }
@@ -738,8 +748,9 @@ uint32_t CountActiveUnitExecutionChildrenForParent(
          ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue] != ParentOrderIdValue ||
-            CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::UnitExecution ||
-            IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
+                ECommandAuthorityLayer::UnitExecution ||
+            IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -812,7 +823,8 @@ bool TryGetLatestUnitExecutionChildDispatchGameLoop(
          ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue] != ParentOrderIdValue ||
-            CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::UnitExecution)
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
+                ECommandAuthorityLayer::UnitExecution)
         {
             continue;
         }
@@ -890,7 +902,7 @@ bool DoesFootprintContainFriendlyBuilding(const ObservationInterface& Observatio
         }
 
         const Point2D StructureHalfExtentsValue =
-            GetStructureFootprintHalfExtentsForUnitType(SelfUnitValue->unit_type.ToType());
+            FStructureFootprintHelper::GetStructureFootprintHalfExtentsForUnitType(SelfUnitValue->unit_type.ToType());
         if (DoAxisAlignedFootprintsOverlap(Point2D(SelfUnitValue->pos), StructureHalfExtentsValue,
                                            FootprintCenterValue, FootprintHalfExtentsValue))
         {
@@ -948,7 +960,7 @@ bool TryFindDisplacementTargetPoint(const FFrameContext& FrameValue, const Unit&
                                     const Point2D& FootprintHalfExtentsValue,
                                     Point2D& OutDisplacementTargetPointValue)
 {
-    if (FrameValue.GameInfo == nullptr || FrameValue.Query == nullptr || FrameValue.Observation == nullptr)
+    if (FrameValue.GameInfo == nullptr || !CanValidateGroundPathing(FrameValue) || FrameValue.Observation == nullptr)
     {
         return false;
     }
@@ -983,7 +995,7 @@ bool TryFindDisplacementTargetPoint(const FFrameContext& FrameValue, const Unit&
             continue;
         }
 
-        const float PathingDistanceValue = FrameValue.Query->PathingDistance(&BlockerUnitValue, CandidatePointValue);
+        const float PathingDistanceValue = GetGroundPathingDistance(FrameValue, BlockerUnitValue, CandidatePointValue);
         if (!IsGroundPathingResultValid(BlockerUnitValue, CandidatePointValue, PathingDistanceValue))
         {
             continue;
@@ -1010,7 +1022,7 @@ bool TryFindPreferredBlockerReliefTargetPoint(const FFrameContext& FrameValue, c
                                               const Point2D& PreferredTargetPointValue,
                                               Point2D& OutDisplacementTargetPointValue)
 {
-    if (FrameValue.Observation == nullptr || FrameValue.Query == nullptr)
+    if (FrameValue.Observation == nullptr || !CanValidateGroundPathing(FrameValue))
     {
         return false;
     }
@@ -1022,7 +1034,8 @@ bool TryFindPreferredBlockerReliefTargetPoint(const FFrameContext& FrameValue, c
         return false;
     }
 
-    const float PathingDistanceValue = FrameValue.Query->PathingDistance(&BlockerUnitValue, PreferredTargetPointValue);
+    const float PathingDistanceValue =
+        GetGroundPathingDistance(FrameValue, BlockerUnitValue, PreferredTargetPointValue);
     if (!IsGroundPathingResultValid(BlockerUnitValue, PreferredTargetPointValue, PathingDistanceValue))
     {
         return false;
@@ -1066,7 +1079,7 @@ EProductionBlockerKind ClassifyAddonFootprintBlocker(const FFrameContext& FrameV
         return EProductionBlockerKind::Terrain;
     }
 
-    if (!DoesAddonFootprintSupportTerrain(*FrameValue.GameInfo, StructureBuildPointValue))
+    if (!DoesAddonFootprintSupportTerrain(*FrameValue.GameInfo, StructureBuildPointValue, FrameValue.DecodedMapGrids))
     {
         return EProductionBlockerKind::Terrain;
     }
@@ -1087,7 +1100,8 @@ EProductionBlockerKind ClassifyAddonFootprintBlocker(const FFrameContext& FrameV
         const bool IsOverlappingValue = CandidateUnitValue->is_building
             ? DoAxisAlignedFootprintsOverlap(
                   Point2D(CandidateUnitValue->pos),
-                  GetStructureFootprintHalfExtentsForUnitType(CandidateUnitValue->unit_type.ToType()),
+                  FStructureFootprintHelper::GetStructureFootprintHalfExtentsForUnitType(
+                      CandidateUnitValue->unit_type.ToType()),
                   AddonFootprintCenterValue, AddonHalfExtentsValue)
             : DoesUnitOverlapFootprint(*CandidateUnitValue, AddonFootprintCenterValue, AddonHalfExtentsValue);
 
@@ -1215,7 +1229,7 @@ bool TryIssueFriendlyBlockerReliefForStructurePlacement(const FFrameContext& Fra
                                                         FIntentBuffer& IntentBufferValue)
 {
     const Point2D StructureHalfExtentsValue =
-        GetStructureFootprintHalfExtentsForAbility(EconomyOrderValue.AbilityId);
+        FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(EconomyOrderValue.AbilityId);
     uint32_t AddedIntentCountValue = AddFriendlyBlockerReliefIntentsForFootprint(
         FrameValue, WorkerUnitValue.tag, BuildPlacementSlotValue.BuildPoint, StructureHalfExtentsValue,
         PreferredTargetPointValue,
@@ -1242,7 +1256,7 @@ bool DoesStructurePlacementHaveFriendlyMovableBlocker(const FFrameContext& Frame
     }
 
     const Point2D StructureHalfExtentsValue =
-        GetStructureFootprintHalfExtentsForAbility(EconomyOrderValue.AbilityId);
+        FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(EconomyOrderValue.AbilityId);
     if (DoesFootprintContainFriendlyMovableBlocker(*FrameValue.Observation, WorkerUnitValue.tag,
                                                    BuildPlacementSlotValue.BuildPoint,
                                                    StructureHalfExtentsValue))
@@ -1268,7 +1282,7 @@ bool DoesAddonFootprintHaveHardBlocker(const FFrameContext& FrameValue, const Ta
         return true;
     }
 
-    if (!DoesAddonFootprintSupportTerrain(*FrameValue.GameInfo, StructureBuildPointValue) ||
+    if (!DoesAddonFootprintSupportTerrain(*FrameValue.GameInfo, StructureBuildPointValue, FrameValue.DecodedMapGrids) ||
         !DoesAddonFootprintAvoidObservedStructures(*FrameValue.Observation, StructureBuildPointValue))
     {
         return true;
@@ -1924,7 +1938,7 @@ bool DoesStructurePlacementOverlapObservedProtectedAddonLane(const FFrameContext
     }
 
     const Point2D CandidateFootprintHalfExtentsValue =
-        GetStructureFootprintHalfExtentsForAbility(EconomyOrderValue.AbilityId);
+        FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(EconomyOrderValue.AbilityId);
     static const Point2D AddonFootprintHalfExtentsValue(1.0f, 1.0f);
     const Units ProtectedProducerUnitsValue =
         FrameValue.Observation->GetUnits(Unit::Alliance::Self, IsUnit(ProtectedProducerUnitTypeIdValue));
@@ -1984,7 +1998,8 @@ bool DoesMandatoryOpeningAddonReserveProducer(
          ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.OrderIds[OrderIndexValue] == IgnoredOrderIdValue ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]) ||
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState) ||
             CommandAuthoritySchedulingStateValue.TaskTypes[OrderIndexValue] != ECommandTaskType::AddOn ||
             CommandAuthoritySchedulingStateValue.PreferredProducerPlacementSlotIdTypes[OrderIndexValue] ==
                 EBuildPlacementSlotType::Unknown)
@@ -2100,7 +2115,8 @@ uint32_t CountPendingAddonOrdersForProducerType(
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+        if (IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -2180,50 +2196,6 @@ float GetPlacementSlotOccupancyRadiusSquared(const FBuildPlacementSlot& BuildPla
     }
 }
 
-Point2D GetStructureFootprintHalfExtentsForUnitType(const UNIT_TYPEID UnitTypeIdValue)
-{
-    switch (UnitTypeIdValue)
-    {
-        case UNIT_TYPEID::TERRAN_SUPPLYDEPOT:
-        case UNIT_TYPEID::TERRAN_SUPPLYDEPOTLOWERED:
-        case UNIT_TYPEID::TERRAN_REACTOR:
-        case UNIT_TYPEID::TERRAN_BARRACKSREACTOR:
-        case UNIT_TYPEID::TERRAN_FACTORYREACTOR:
-        case UNIT_TYPEID::TERRAN_STARPORTREACTOR:
-        case UNIT_TYPEID::TERRAN_TECHLAB:
-        case UNIT_TYPEID::TERRAN_BARRACKSTECHLAB:
-        case UNIT_TYPEID::TERRAN_FACTORYTECHLAB:
-        case UNIT_TYPEID::TERRAN_STARPORTTECHLAB:
-            return Point2D(1.0f, 1.0f);
-        case UNIT_TYPEID::TERRAN_COMMANDCENTER:
-        case UNIT_TYPEID::TERRAN_ORBITALCOMMAND:
-        case UNIT_TYPEID::TERRAN_PLANETARYFORTRESS:
-            return Point2D(2.5f, 2.5f);
-        case UNIT_TYPEID::TERRAN_REFINERY:
-        case UNIT_TYPEID::TERRAN_REFINERYRICH:
-            return Point2D(1.5f, 1.5f);
-        default:
-            return Point2D(1.5f, 1.5f);
-    }
-}
-
-Point2D GetStructureFootprintHalfExtentsForAbility(const ABILITY_ID StructureAbilityIdValue)
-{
-    switch (StructureAbilityIdValue)
-    {
-        case ABILITY_ID::BUILD_SUPPLYDEPOT:
-            return Point2D(1.0f, 1.0f);
-        case ABILITY_ID::BUILD_COMMANDCENTER:
-            return Point2D(2.5f, 2.5f);
-        case ABILITY_ID::BUILD_BARRACKS:
-        case ABILITY_ID::BUILD_FACTORY:
-        case ABILITY_ID::BUILD_STARPORT:
-        case ABILITY_ID::BUILD_REFINERY:
-        default:
-            return Point2D(1.5f, 1.5f);
-    }
-}
-
 bool DoAxisAlignedFootprintsOverlap(const Point2D& CenterPointOneValue, const Point2D& HalfExtentsOneValue,
                                     const Point2D& CenterPointTwoValue, const Point2D& HalfExtentsTwoValue)
 {
@@ -2241,7 +2213,7 @@ const Unit* FindObservedStructureOccupyingPlacementSlot(const ObservationInterfa
     const Units SelfUnitsValue = ObservationValue.GetUnits(Unit::Alliance::Self);
     const Point2D SlotBuildPointValue = BuildPlacementSlotValue.BuildPoint;
     const Point2D SlotFootprintHalfExtentsValue =
-        GetStructureFootprintHalfExtentsForAbility(StructureAbilityIdValue);
+        FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(StructureAbilityIdValue);
 
     const Unit* BestOccupyingUnitValue = nullptr;
     float BestDistanceSquaredValue = std::numeric_limits<float>::max();
@@ -2253,7 +2225,7 @@ const Unit* FindObservedStructureOccupyingPlacementSlot(const ObservationInterfa
         }
 
         const Point2D ObservedStructureHalfExtentsValue =
-            GetStructureFootprintHalfExtentsForUnitType(SelfUnitValue->unit_type.ToType());
+            FStructureFootprintHelper::GetStructureFootprintHalfExtentsForUnitType(SelfUnitValue->unit_type.ToType());
         if (!DoAxisAlignedFootprintsOverlap(Point2D(SelfUnitValue->pos), ObservedStructureHalfExtentsValue,
                                             SlotBuildPointValue, SlotFootprintHalfExtentsValue))
         {
@@ -2315,7 +2287,7 @@ bool IsPlacementSlotClaimedByOtherOrder(const FCommandAuthoritySchedulingState&
          ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.OrderIds[OrderIndexValue] == IgnoredOrderIdValue ||
-            IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            IsOrderTerminal(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -2704,10 +2676,17 @@ Point2D GetAddonFootprintCenter(const Point2D& StructureBuildPointValue)
     return Point2D(StructureBuildPointValue.x + 2.5f, StructureBuildPointValue.y - 0.5f);
 }
 
-bool DoesAddonFootprintSupportTerrain(const GameInfo& GameInfoValue, const Point2D& StructureBuildPointValue)
+bool DoesAddonFootprintSupportTerrain(const GameInfo& GameInfoValue, const Point2D& StructureBuildPointValue,
+                                      const MapGrids* MapGridsPtrValue)
 {
-    const PlacementGrid PlacementGridValue(GameInfoValue);
     const Point2D AddonCenterValue = GetAddonFootprintCenter(StructureBuildPointValue);
+    if (MapGridsPtrValue != nullptr && MapGridsPtrValue->HasTerrain())
+    {
+        return MapGridsPtrValue->IsAreaPlacable(Point2DI(AddonCenterValue - Point2D(0.5f, 0.5f)),
+                                                Point2DI(AddonCenterValue + Point2D(0.5f, 0.5f)));
+    }
+
+    const PlacementGrid PlacementGridValue(GameInfoValue);
 
     static const std::array<Point2D, 5> AddonSampleOffsetsValue =
     {{
@@ -2747,7 +2726,7 @@ bool DoesAddonFootprintAvoidObservedStructures(const ObservationInterface& Obser
         }
 
         const Point2D ObservedStructureHalfExtentsValue =
-            GetStructureFootprintHalfExtentsForUnitType(SelfUnitValue->unit_type.ToType());
+            FStructureFootprintHelper::GetStructureFootprintHalfExtentsForUnitType(SelfUnitValue->unit_type.ToType());
         if (DoAxisAlignedFootprintsOverlap(Point2D(SelfUnitValue->pos), ObservedStructureHalfExtentsValue,
                                            AddonCenterValue, AddonFootprintHalfExtentsValue))
         {
@@ -2775,7 +2754,8 @@ bool DoesPlacementSlotSatisfyFootprintPolicy(const FFrameContext& FrameValue,
 
             {
                 const bool bTerrainSupportedValue =
-                    DoesAddonFootprintSupportTerrain(*FrameValue.GameInfo, BuildPlacementSlotValue.BuildPoint);
+                    DoesAddonFootprintSupportTerrain(*FrameValue.GameInfo, BuildPlacementSlotValue.BuildPoint,
+                                                     FrameValue.DecodedMapGrids);
                 const bool bStructureAvoidedValue =
                     DoesAddonFootprintAvoidObservedStructures(*FrameValue.Observation,
                                                               BuildPlacementSlotValue.BuildPoint);
@@ -2943,6 +2923,8 @@ bool TryGetStructureBuildPoint(const FFrameContext& FrameValue, const FGameState
                                                               BuildPlacementContextValue);
     const GameInfo& GameInfoValue = FrameValue.Observation->GetGameInfo();
 
+    std::vector<FPlacementCandidate> PlacementCandidatesValue;
+    PlacementCandidatesValue.reserve(BuildPlacementSlotsValue.size());
     for (const FBuildPlacementSlot& BuildPlacementSlotValue : BuildPlacementSlotsValue)
     {
         const Point2D ClampedCandidateValue = ClampToPlayable(GameInfoValue, BuildPlacementSlotValue.BuildPoint);
@@ -2955,14 +2937,24 @@ bool TryGetStructureBuildPoint(const FFrameContext& FrameValue, const FGameState
             continue;
         }
 
-        if (FrameValue.Query->Placement(StructureAbilityIdValue, ClampedCandidateValue, &WorkerUnitValue))
-        {
-            OutBuildPointValue = ClampedCandidateValue;
-            return true;
-        }
+        FPlacementCandidate PlacementCandidateValue;
+        PlacementCandidateValue.StructureAbilityId = StructureAbilityIdValue;
+        PlacementCandidateValue.BuildPoint = ClampedCandidateValue;
+        PlacementCandidateValue.bRequiresAddonClearance =
+            NormalizedBuildPlacementSlotValue.FootprintPolicy == EBuildPlacementFootprintPolicy::RequiresAddonClearance;
+        PlacementCandidatesValue.push_back(PlacementCandidateValue);
     }
 
-    return false;
+    const FPlacementFootprintEvaluator PlacementFootprintEvaluatorValue(FrameValue, &WorkerUnitValue);
+    const int32_t ConfirmedCandidateIndexValue =
+        PlacementFootprintEvaluatorValue.SelectFirstConfirmedCandidate(PlacementCandidatesValue);
+    if (ConfirmedCandidateIndexValue < 0)
+    {
+        return false;
+    }
+
+    OutBuildPointValue = PlacementCandidatesValue[static_cast<size_t>(ConfirmedCandidateIndexValue)].BuildPoint;
+    return true;
 }
 
 Point2D GetNextExpansionLocation(const FFrameContext& FrameValue, const std::vector<Point2D>& ExpansionLocationsValue)
@@ -2978,6 +2970,8 @@ Point2D GetNextExpansionLocation(const FFrameContext& FrameValue, const std::vec
     Point2D BestExpansionLocationValue(std::numeric_limits<float>::quiet_NaN(),
                                        std::numeric_limits<float>::quiet_NaN());
 
+    std::vector<FPlacementCandidate> PlacementCandidatesValue;
+    PlacementCandidatesValue.reserve(ExpansionLocationsValue.size());
     for (const Point2D& ExpansionLocationValue : ExpansionLocationsValue)
     {
         if (Distance2D(StartLocationValue, ExpansionLocationValue) < 4.0f)
@@ -2996,11 +2990,29 @@ Point2D GetNextExpansionLocation(const FFrameContext& FrameValue, const std::vec
             }
         }
 
-        if (IsOccupiedValue || !FrameValue.Query->Placement(ABILITY_ID::BUILD_COMMANDCENTER, ExpansionLocationValue))
+        if (IsOccupiedValue)
+        {
+            continue;
+        }
+
+        FPlacementCandidate PlacementCandidateValue;
+        PlacementCandidateValue.StructureAbilityId = ABILITY_ID::BUILD_COMMANDCENTER;
+        PlacementCandidateValue.BuildPoint = ExpansionLocationValue;
+        PlacementCandidatesValue.push_back(PlacementCandidateValue);
+    }
+
+    const FPlacementFootprintEvaluator PlacementFootprintEvaluatorValue(FrameValue);
+    const std::vector<bool> ConfirmedCandidatesValue =
+        PlacementFootprintEvaluatorValue.ConfirmCandidates(PlacementCandidatesValue);
+    for (size_t CandidateIndexValue = 0U; CandidateIndexValue < PlacementCandidatesValue.size();
+         ++CandidateIndexValue)
+    {
+        if (!ConfirmedCandidatesValue[CandidateIndexValue])
         {
             continue;
         }
 
+        const Point2D& ExpansionLocationValue = PlacementCandidatesValue[CandidateIndexValue].BuildPoint;
         const float DistanceValue = DistanceSquared2D(StartLocationValue, ExpansionLocationValue);
         if (DistanceValue < BestDistanceValue)
         {
@@ -3019,6 +3031,7 @@ void FTerranEconomyProductionOrderExpander::ExpandEconomyAndProductionOrders(
     FIntentBuffer& IntentBufferValue, const IBuildPlacementService& BuildPlacementServiceValue,
     const std::vector<Point2D>& ExpansionLocationsValue) const
 {
+    SC2_TRACE_ZONE("FTerranEconomyProductionOrderExpander::ExpandEconomyAndProductionOrders");
     if (FrameValue.Observation == nullptr)
     {
         return;
@@ -3096,14 +3109,15 @@ void FTerranEconomyProductionOrderExpander::ExpandEconomyAndProductionOrders(
             {
                 if (CommandAuthoritySchedulingStateValue.ParentOrderIds[ChildOrderIndexValue] !=
                         static_cast<int>(EconomyOrderValue.OrderId) ||
-                    CommandAuthoritySchedulingStateValue.SourceLayers[ChildOrderIndexValue] !=
+                    CommandAuthoritySchedulingStateValue.OrderHotFields[ChildOrderIndexValue].SourceLayer !=
                         ECommandAuthorityLayer::UnitExecution ||
-                    IsOrderTerminal(CommandAuthoritySchedulingStateValue.LifecycleStates[ChildOrderIndexValue]))
+                    IsOrderTerminal(
+                        CommandAuthoritySchedulingStateValue.OrderHotFields[ChildOrderIndexValue].LifecycleState))
                 {
                     continue;
                 }
 
-                if (CommandAuthoritySchedulingStateValue.LifecycleStates[ChildOrderIndexValue] ==
+                if (CommandAuthoritySchedulingStateValue.OrderHotFields[ChildOrderIndexValue].LifecycleState ==
                         EOrderLifecycleState::Dispatched &&
                     CommandAuthoritySchedulingStateValue.DispatchGameLoops[ChildOrderIndexValue] > 0U &&
                     CurrentGameLoopValue - CommandAuthoritySchedulingStateValue.DispatchGameLoops[ChildOrderIndexValue] >
@@ -3298,6 +3312,7 @@ void FTerranEconomyProductionOrderExpander::ExpandEconomyAndProductionOrders(
                                                               StartLocationValue);
                                  });
 
+                const FPlacementFootprintEvaluator RefineryFootprintEvaluatorValue(FrameValue);
                 for (const Unit* TownHallUnitValue : SortedTownHallUnitsValue)
                 {
                     Units NearbyGeyserUnitsValue;
@@ -3323,10 +3338,23 @@ void FTerranEconomyProductionOrderExpander::ExpandEconomyAndProductionOrders(
                                                                   Point2D(TownHallUnitValue->pos));
                                      });
 
+                    std::vector<FPlacementCandidate> RefineryCandidatesValue;
+                    RefineryCandidatesValue.reserve(NearbyGeyserUnitsValue.size());
                     for (const Unit* GeyserUnitValue : NearbyGeyserUnitsValue)
                     {
+                        FPlacementCandidate RefineryCandidateValue;
+                        RefineryCandidateValue.StructureAbilityId = ABILITY_ID::BUILD_REFINERY;
+                        RefineryCandidateValue.BuildPoint = Point2D(GeyserUnitValue->pos);
+                        RefineryCandidatesValue.push_back(RefineryCandidateValue);
+                    }
 
-                        if (!FrameValue.Query->Placement(ABILITY_ID::BUILD_REFINERY, GeyserUnitValue->pos))
+                    const std::vector<bool> ConfirmedRefineryCandidatesValue =
+                        RefineryFootprintEvaluatorValue.ConfirmCandidates(RefineryCandidatesValue);
+                    for (size_t GeyserIndexValue = 0U; GeyserIndexValue < NearbyGeyserUnitsValue.size();
+                         ++GeyserIndexValue)
+                    {
+                        const Unit* GeyserUnitValue = NearbyGeyserUnitsValue[GeyserIndexValue];
+                        if (!ConfirmedRefineryCandidatesValue[GeyserIndexValue])
                         {
                             continue;
                         }
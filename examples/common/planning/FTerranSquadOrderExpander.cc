@@ -1,6 +1,7 @@
 #include "common/planning/FTerranSquadOrderExpander.h"
 
 #include "common/armies/FArmyMissionDescriptor.h"
+#include "sc2api/sc2_trace.h"
 
 namespace sc2
 {
@@ -32,9 +33,10 @@ bool DoesExistingSquadOrderMatchMission(const FCommandAuthoritySchedulingState&
                                         const Point2D& ObjectivePointValue)
 {
     if (!CommandAuthoritySchedulingStateValue.IsOrderIndexValid(ExistingSquadOrderIndexValue) ||
-        CommandAuthoritySchedulingStateValue.SourceLayers[ExistingSquadOrderIndexValue] !=
+        CommandAuthoritySchedulingStateValue.OrderHotFields[ExistingSquadOrderIndexValue].SourceLayer !=
             ECommandAuthorityLayer::Squad ||
-        IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[ExistingSquadOrderIndexValue]))
+        IsTerminalLifecycleState(
+            CommandAuthoritySchedulingStateValue.OrderHotFields[ExistingSquadOrderIndexValue].LifecycleState))
     {
         return false;
     }
@@ -52,6 +54,7 @@ void FTerranSquadOrderExpander::ExpandSquadOrders(
     const FGameStateDescriptor& GameStateDescriptorValue, const Point2D& RallyPointValue,
     FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue) const
 {
+    SC2_TRACE_ZONE("FTerranSquadOrderExpander::ExpandSquadOrders");
     (void)AgentStateValue;
 
     uint32_t ExpandedSquadOrderCountValue = 0U;
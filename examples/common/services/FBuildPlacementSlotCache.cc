@@ -0,0 +1,654 @@
+#include "common/services/FBuildPlacementSlotCache.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "common/catalogs/FMapQueryHelper.h"
+#include "sc2api/sc2_map_info.h"
+
+namespace sc2
+{
+namespace
+{
+
+constexpr uint64_t FnvOffsetBasisValue = 1469598103934665603ULL;
+constexpr uint64_t FnvPrimeValue = 1099511628211ULL;
+
+// Header: magic, format version, reserved, layout version, entry count.
+constexpr size_t FileHeaderByteCountValue = 16U;
+constexpr size_t FileHeaderEntryCountOffsetValue = 12U;
+// Entry header: grid hash, map id, spawn id, base tile x and y, payload byte count.
+constexpr size_t EntryHeaderByteCountValue = 18U;
+
+uint64_t HashBytes(const void* BytesValue, const size_t ByteCountValue, uint64_t HashValue)
+{
+    const uint8_t* BytePtrValue = static_cast<const uint8_t*>(BytesValue);
+    for (size_t ByteIndexValue = 0U; ByteIndexValue < ByteCountValue; ++ByteIndexValue)
+    {
+        HashValue ^= BytePtrValue[ByteIndexValue];
+        HashValue *= FnvPrimeValue;
+    }
+
+    return HashValue;
+}
+
+class FByteWriter
+{
+public:
+    explicit FByteWriter(std::vector<uint8_t>& BytesValue)
+        : Bytes(BytesValue)
+    {
+    }
+
+    template <typename TValue>
+    void Write(const TValue& Value)
+    {
+        const size_t OffsetValue = Bytes.size();
+        Bytes.resize(OffsetValue + sizeof(TValue));
+        std::memcpy(Bytes.data() + OffsetValue, &Value, sizeof(TValue));
+    }
+
+    void WritePoint(const Point2D& PointValue)
+    {
+        Write(PointValue.x);
+        Write(PointValue.y);
+    }
+
+    void WriteSlot(const FBuildPlacementSlot& SlotValue)
+    {
+        Write(static_cast<uint8_t>(SlotValue.SlotId.SlotType));
+        Write(SlotValue.SlotId.Ordinal);
+        Write(static_cast<uint8_t>(SlotValue.FootprintPolicy));
+        WritePoint(SlotValue.BuildPoint);
+    }
+
+    void WriteSlots(const std::vector<FBuildPlacementSlot>& SlotsValue)
+    {
+        Write(static_cast<uint16_t>(SlotsValue.size()));
+        for (const FBuildPlacementSlot& SlotValue : SlotsValue)
+        {
+            WriteSlot(SlotValue);
+        }
+    }
+
+private:
+    std::vector<uint8_t>& Bytes;
+};
+
+// Bounds-checked reader; every read fails once any read has run past the end.
+class FByteReader
+{
+public:
+    FByteReader(const uint8_t* BytesValue, const size_t ByteCountValue)
+        : Bytes(BytesValue),
+          ByteCount(ByteCountValue),
+          Offset(0U),
+          bFailed(false)
+    {
+    }
+
+    template <typename TValue>
+    bool Read(TValue& OutValue)
+    {
+        if (bFailed || ByteCount - Offset < sizeof(TValue))
+        {
+            bFailed = true;
+            return false;
+        }
+
+        std::memcpy(&OutValue, Bytes + Offset, sizeof(TValue));
+        Offset += sizeof(TValue);
+        return true;
+    }
+
+    bool ReadPoint(Point2D& OutPointValue)
+    {
+        return Read(OutPointValue.x) && Read(OutPointValue.y);
+    }
+
+    bool ReadSlot(FBuildPlacementSlot& OutSlotValue)
+    {
+        uint8_t SlotTypeValue = 0U;
+        uint8_t FootprintPolicyValue = 0U;
+        if (!Read(SlotTypeValue) || !Read(OutSlotValue.SlotId.Ordinal) || !Read(FootprintPolicyValue) ||
+            !ReadPoint(OutSlotValue.BuildPoint))
+        {
+            return false;
+        }
+
+        OutSlotValue.SlotId.SlotType = static_cast<EBuildPlacementSlotType>(SlotTypeValue);
+        OutSlotValue.FootprintPolicy = static_cast<EBuildPlacementFootprintPolicy>(FootprintPolicyValue);
+        return true;
+    }
+
+    bool ReadSlots(std::vector<FBuildPlacementSlot>& OutSlotsValue)
+    {
+        uint16_t SlotCountValue = 0U;
+        if (!Read(SlotCountValue))
+        {
+            return false;
+        }
+
+        OutSlotsValue.clear();
+        OutSlotsValue.resize(SlotCountValue);
+        for (FBuildPlacementSlot& SlotValue : OutSlotsValue)
+        {
+            if (!ReadSlot(SlotValue))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool IsAtEnd() const
+    {
+        return !bFailed && Offset == ByteCount;
+    }
+
+private:
+    const uint8_t* Bytes;
+    size_t ByteCount;
+    size_t Offset;
+    bool bFailed;
+};
+
+std::vector<uint8_t> EncodeLayout(const FRampWallDescriptor& RampWallDescriptorValue,
+                                  const FMainBaseLayoutDescriptor& MainBaseLayoutDescriptorValue)
+{
+    std::vector<uint8_t> PayloadValue;
+    FByteWriter WriterValue(PayloadValue);
+
+    WriterValue.Write(static_cast<uint8_t>(RampWallDescriptorValue.bIsValid ? 1U : 0U));
+    WriterValue.WritePoint(RampWallDescriptorValue.WallCenterPoint);
+    WriterValue.WritePoint(RampWallDescriptorValue.InsideStagingPoint);
+    WriterValue.WritePoint(RampWallDescriptorValue.OutsideStagingPoint);
+    WriterValue.WriteSlot(RampWallDescriptorValue.LeftDepotSlot);
+    WriterValue.WriteSlot(RampWallDescriptorValue.BarracksSlot);
+    WriterValue.WriteSlot(RampWallDescriptorValue.RightDepotSlot);
+
+    WriterValue.Write(static_cast<uint8_t>((MainBaseLayoutDescriptorValue.bIsValid ? 1U : 0U) |
+                                           (MainBaseLayoutDescriptorValue.bUsesAuthoredProductionLayout ? 2U : 0U)));
+    WriterValue.WritePoint(MainBaseLayoutDescriptorValue.LayoutAnchorPoint);
+    WriterValue.WritePoint(MainBaseLayoutDescriptorValue.ArmyAssemblyAnchorPoint);
+    WriterValue.WritePoint(MainBaseLayoutDescriptorValue.NaturalEntranceArmyRallyAnchorPoint);
+    WriterValue.WritePoint(MainBaseLayoutDescriptorValue.ProductionClearanceAnchorPoint);
+    WriterValue.WriteSlots(MainBaseLayoutDescriptorValue.NaturalEntranceWallDepotSlots);
+    WriterValue.WriteSlots(MainBaseLayoutDescriptorValue.NaturalEntranceBunkerSlots);
+    WriterValue.WriteSlots(MainBaseLayoutDescriptorValue.NaturalApproachDepotSlots);
+    WriterValue.WriteSlots(MainBaseLayoutDescriptorValue.SupportDepotSlots);
+    WriterValue.WriteSlots(MainBaseLayoutDescriptorValue.PeripheralDepotSlots);
+    WriterValue.WriteSlots(MainBaseLayoutDescriptorValue.ProductionRailWithAddonSlots);
+    WriterValue.WriteSlots(MainBaseLayoutDescriptorValue.BarracksWithAddonSlots);
+    WriterValue.WriteSlots(MainBaseLayoutDescriptorValue.FactoryWithAddonSlots);
+    WriterValue.WriteSlots(MainBaseLayoutDescriptorValue.StarportWithAddonSlots);
+    return PayloadValue;
+}
+
+bool DecodeLayout(const uint8_t* PayloadValue, const size_t PayloadByteCountValue,
+                  FRampWallDescriptor& OutRampWallDescriptorValue,
+                  FMainBaseLayoutDescriptor& OutMainBaseLayoutDescriptorValue)
+{
+    FRampWallDescriptor RampWallDescriptorValue;
+    FMainBaseLayoutDescriptor MainBaseLayoutDescriptorValue;
+    FByteReader ReaderValue(PayloadValue, PayloadByteCountValue);
+
+    uint8_t RampWallFlagsValue = 0U;
+    uint8_t MainBaseLayoutFlagsValue = 0U;
+    const bool bDecodedValue =
+        ReaderValue.Read(RampWallFlagsValue) && ReaderValue.ReadPoint(RampWallDescriptorValue.WallCenterPoint) &&
+        ReaderValue.ReadPoint(RampWallDescriptorValue.InsideStagingPoint) &&
+        ReaderValue.ReadPoint(RampWallDescriptorValue.OutsideStagingPoint) &&
+        ReaderValue.ReadSlot(RampWallDescriptorValue.LeftDepotSlot) &&
+        ReaderValue.ReadSlot(RampWallDescriptorValue.BarracksSlot) &&
+        ReaderValue.ReadSlot(RampWallDescriptorValue.RightDepotSlot) && ReaderValue.Read(MainBaseLayoutFlagsValue) &&
+        ReaderValue.ReadPoint(MainBaseLayoutDescriptorValue.LayoutAnchorPoint) &&
+        ReaderValue.ReadPoint(MainBaseLayoutDescriptorValue.ArmyAssemblyAnchorPoint) &&
+        ReaderValue.ReadPoint(MainBaseLayoutDescriptorValue.NaturalEntranceArmyRallyAnchorPoint) &&
+        ReaderValue.ReadPoint(MainBaseLayoutDescriptorValue.ProductionClearanceAnchorPoint) &&
+        ReaderValue.ReadSlots(MainBaseLayoutDescriptorValue.NaturalEntranceWallDepotSlots) &&
+        ReaderValue.ReadSlots(MainBaseLayoutDescriptorValue.NaturalEntranceBunkerSlots) &&
+        ReaderValue.ReadSlots(MainBaseLayoutDescriptorValue.NaturalApproachDepotSlots) &&
+        ReaderValue.ReadSlots(MainBaseLayoutDescriptorValue.SupportDepotSlots) &&
+        ReaderValue.ReadSlots(MainBaseLayoutDescriptorValue.PeripheralDepotSlots) &&
+        ReaderValue.ReadSlots(MainBaseLayoutDescriptorValue.ProductionRailWithAddonSlots) &&
+        ReaderValue.ReadSlots(MainBaseLayoutDescriptorValue.BarracksWithAddonSlots) &&
+        ReaderValue.ReadSlots(MainBaseLayoutDescriptorValue.FactoryWithAddonSlots) &&
+        ReaderValue.ReadSlots(MainBaseLayoutDescriptorValue.StarportWithAddonSlots);
+    if (!bDecodedValue || !ReaderValue.IsAtEnd())
+    {
+        return false;
+    }
+
+    RampWallDescriptorValue.bIsValid = (RampWallFlagsValue & 1U) != 0U;
+    MainBaseLayoutDescriptorValue.bIsValid = (MainBaseLayoutFlagsValue & 1U) != 0U;
+    MainBaseLayoutDescriptorValue.bUsesAuthoredProductionLayout = (MainBaseLayoutFlagsValue & 2U) != 0U;
+    OutRampWallDescriptorValue = RampWallDescriptorValue;
+    OutMainBaseLayoutDescriptorValue = MainBaseLayoutDescriptorValue;
+    return true;
+}
+
+// Unique among the processes and threads writing next to FilePathValue at the same time.
+std::string GetTemporaryFilePath(const std::string& FilePathValue)
+{
+    static std::atomic<uint32_t> SaveCountValue(0U);
+#if defined(_WIN32)
+    const unsigned long ProcessIdValue = GetCurrentProcessId();
+#else
+    const unsigned long ProcessIdValue = static_cast<unsigned long>(getpid());
+#endif
+    return FilePathValue + "." + std::to_string(ProcessIdValue) + "." +
+           std::to_string(SaveCountValue.fetch_add(1U, std::memory_order_relaxed)) + ".tmp";
+}
+
+void WriteEntry(const FBuildPlacementSlotCacheKey& KeyValue, const uint8_t* PayloadValue,
+                const size_t PayloadByteCountValue, std::vector<uint8_t>& OutBytesValue)
+{
+    FByteWriter WriterValue(OutBytesValue);
+    WriterValue.Write(KeyValue.PlacementGridHash);
+    WriterValue.Write(static_cast<uint8_t>(KeyValue.MapId));
+    WriterValue.Write(static_cast<uint8_t>(KeyValue.SpawnId));
+    WriterValue.Write(KeyValue.BaseTileX);
+    WriterValue.Write(KeyValue.BaseTileY);
+    WriterValue.Write(static_cast<uint32_t>(PayloadByteCountValue));
+    OutBytesValue.insert(OutBytesValue.end(), PayloadValue, PayloadValue + PayloadByteCountValue);
+}
+
+}  // namespace
+
+FBuildPlacementSlotCacheKey::FBuildPlacementSlotCacheKey()
+    : PlacementGridHash(0U),
+      MapId(EMapId::Invalid),
+      SpawnId(ESpawnId::Invalid),
+      BaseTileX(0),
+      BaseTileY(0)
+{
+}
+
+FBuildPlacementSlotCacheKey FBuildPlacementSlotCacheKey::Create(
+    const GameInfo& GameInfoValue, const FBuildPlacementContext& BuildPlacementContextValue)
+{
+    FBuildPlacementSlotCacheKey KeyValue;
+
+    const ImageData& PlacementGridValue = GameInfoValue.placement_grid;
+    uint64_t HashValue = FnvOffsetBasisValue;
+    HashValue = HashBytes(&PlacementGridValue.width, sizeof(PlacementGridValue.width), HashValue);
+    HashValue = HashBytes(&PlacementGridValue.height, sizeof(PlacementGridValue.height), HashValue);
+    HashValue = HashBytes(&PlacementGridValue.bits_per_pixel, sizeof(PlacementGridValue.bits_per_pixel), HashValue);
+    HashValue = HashBytes(PlacementGridValue.data.data(), PlacementGridValue.data.size(), HashValue);
+    KeyValue.PlacementGridHash = HashValue;
+
+    if (BuildPlacementContextValue.MapDescriptorPtr != nullptr)
+    {
+        KeyValue.MapId = FMapQueryHelper::GetMapId(*BuildPlacementContextValue.MapDescriptorPtr);
+    }
+    if (BuildPlacementContextValue.SpawnLayoutPtr != nullptr)
+    {
+        KeyValue.SpawnId = BuildPlacementContextValue.SpawnLayoutPtr->SpawnId;
+    }
+
+    KeyValue.BaseTileX = static_cast<int16_t>(std::floor(BuildPlacementContextValue.BaseLocation.x));
+    KeyValue.BaseTileY = static_cast<int16_t>(std::floor(BuildPlacementContextValue.BaseLocation.y));
+    return KeyValue;
+}
+
+bool operator==(const FBuildPlacementSlotCacheKey& LeftValue, const FBuildPlacementSlotCacheKey& RightValue)
+{
+    return LeftValue.PlacementGridHash == RightValue.PlacementGridHash && LeftValue.MapId == RightValue.MapId &&
+           LeftValue.SpawnId == RightValue.SpawnId && LeftValue.BaseTileX == RightValue.BaseTileX &&
+           LeftValue.BaseTileY == RightValue.BaseTileY;
+}
+
+FBuildPlacementSlotCache::FBuildPlacementSlotCache(const uint32_t LayoutVersionValue)
+    : LayoutVersion(LayoutVersionValue),
+      MappedBytes(nullptr),
+      MappedByteCount(0U),
+      FileHandle(-1),
+      MappingHandle(-1)
+{
+}
+
+FBuildPlacementSlotCache::~FBuildPlacementSlotCache()
+{
+    UnmapFile();
+}
+
+bool FBuildPlacementSlotCache::LoadFromFile(const std::string& FilePathValue)
+{
+    Clear();
+    if (!MapFile(FilePathValue))
+    {
+        return false;
+    }
+
+    if (!IndexMappedEntries())
+    {
+        Clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool FBuildPlacementSlotCache::SaveToFile(const std::string& FilePathValue)
+{
+    std::vector<uint8_t> BytesValue;
+    FByteWriter WriterValue(BytesValue);
+    WriterValue.Write(FileMagicValue);
+    WriterValue.Write(FileFormatVersionValue);
+    WriterValue.Write(static_cast<uint16_t>(0U));
+    WriterValue.Write(LayoutVersion);
+    WriterValue.Write(static_cast<uint32_t>(0U));
+
+    uint32_t EntryCountValue = 0U;
+    for (const FMappedEntry& MappedEntryValue : MappedEntries)
+    {
+        if (IsMappedEntryReplaced(MappedEntryValue))
+        {
+            continue;
+        }
+
+        WriteEntry(MappedEntryValue.Key, MappedBytes + MappedEntryValue.PayloadOffset,
+                   MappedEntryValue.PayloadByteCount, BytesValue);
+        ++EntryCountValue;
+    }
+    for (const FStoredEntry& StoredEntryValue : StoredEntries)
+    {
+        WriteEntry(StoredEntryValue.Key, StoredEntryValue.Payload.data(), StoredEntryValue.Payload.size(), BytesValue);
+        ++EntryCountValue;
+    }
+    std::memcpy(BytesValue.data() + FileHeaderEntryCountOffsetValue, &EntryCountValue, sizeof(EntryCountValue));
+
+    const std::string TemporaryFilePathValue = GetTemporaryFilePath(FilePathValue);
+    {
+        std::ofstream OutputStreamValue(TemporaryFilePathValue, std::ios::binary | std::ios::trunc);
+        if (!OutputStreamValue)
+        {
+            return false;
+        }
+
+        OutputStreamValue.write(reinterpret_cast<const char*>(BytesValue.data()),
+                                static_cast<std::streamsize>(BytesValue.size()));
+        if (!OutputStreamValue)
+        {
+            OutputStreamValue.close();
+            std::remove(TemporaryFilePathValue.c_str());
+            return false;
+        }
+    }
+
+    // The mapped view may be of the file being replaced; release it and keep the entries in memory instead.
+    for (const FMappedEntry& MappedEntryValue : MappedEntries)
+    {
+        if (!IsMappedEntryReplaced(MappedEntryValue))
+        {
+            FStoredEntry StoredEntryValue;
+            StoredEntryValue.Key = MappedEntryValue.Key;
+            StoredEntryValue.Payload.assign(MappedBytes + MappedEntryValue.PayloadOffset,
+                                            MappedBytes + MappedEntryValue.PayloadOffset +
+                                                MappedEntryValue.PayloadByteCount);
+            StoredEntries.push_back(StoredEntryValue);
+        }
+    }
+    MappedEntries.clear();
+    UnmapFile();
+
+#if defined(_WIN32)
+    const bool bRenamedValue =
+        MoveFileExA(TemporaryFilePathValue.c_str(), FilePathValue.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    const bool bRenamedValue = std::rename(TemporaryFilePathValue.c_str(), FilePathValue.c_str()) == 0;
+#endif
+    if (!bRenamedValue)
+    {
+        std::remove(TemporaryFilePathValue.c_str());
+    }
+
+    return bRenamedValue;
+}
+
+void FBuildPlacementSlotCache::Clear()
+{
+    MappedEntries.clear();
+    StoredEntries.clear();
+    UnmapFile();
+}
+
+bool FBuildPlacementSlotCache::TryGetLayout(const FBuildPlacementSlotCacheKey& KeyValue,
+                                            FRampWallDescriptor& OutRampWallDescriptorValue,
+                                            FMainBaseLayoutDescriptor& OutMainBaseLayoutDescriptorValue) const
+{
+    for (const FStoredEntry& StoredEntryValue : StoredEntries)
+    {
+        if (StoredEntryValue.Key == KeyValue)
+        {
+            return DecodeLayout(StoredEntryValue.Payload.data(), StoredEntryValue.Payload.size(),
+                                OutRampWallDescriptorValue, OutMainBaseLayoutDescriptorValue);
+        }
+    }
+
+    for (const FMappedEntry& MappedEntryValue : MappedEntries)
+    {
+        if (MappedEntryValue.Key == KeyValue)
+        {
+            return DecodeLayout(MappedBytes + MappedEntryValue.PayloadOffset, MappedEntryValue.PayloadByteCount,
+                                OutRampWallDescriptorValue, OutMainBaseLayoutDescriptorValue);
+        }
+    }
+
+    return false;
+}
+
+void FBuildPlacementSlotCache::StoreLayout(const FBuildPlacementSlotCacheKey& KeyValue,
+                                           const FRampWallDescriptor& RampWallDescriptorValue,
+                                           const FMainBaseLayoutDescriptor& MainBaseLayoutDescriptorValue)
+{
+    std::vector<uint8_t> PayloadValue = EncodeLayout(RampWallDescriptorValue, MainBaseLayoutDescriptorValue);
+    for (FStoredEntry& StoredEntryValue : StoredEntries)
+    {
+        if (StoredEntryValue.Key == KeyValue)
+        {
+            StoredEntryValue.Payload = std::move(PayloadValue);
+            return;
+        }
+    }
+
+    FStoredEntry StoredEntryValue;
+    StoredEntryValue.Key = KeyValue;
+    StoredEntryValue.Payload = std::move(PayloadValue);
+    StoredEntries.push_back(std::move(StoredEntryValue));
+}
+
+size_t FBuildPlacementSlotCache::GetEntryCount() const
+{
+    size_t EntryCountValue = StoredEntries.size();
+    for (const FMappedEntry& MappedEntryValue : MappedEntries)
+    {
+        EntryCountValue += IsMappedEntryReplaced(MappedEntryValue) ? 0U : 1U;
+    }
+
+    return EntryCountValue;
+}
+
+bool FBuildPlacementSlotCache::IsMapped() const
+{
+    return MappedBytes != nullptr;
+}
+
+bool FBuildPlacementSlotCache::IsMappedEntryReplaced(const FMappedEntry& MappedEntryValue) const
+{
+    for (const FStoredEntry& StoredEntryValue : StoredEntries)
+    {
+        if (StoredEntryValue.Key == MappedEntryValue.Key)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool FBuildPlacementSlotCache::MapFile(const std::string& FilePathValue)
+{
+#if defined(_WIN32)
+    const HANDLE FileHandleValue = CreateFileA(FilePathValue.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (FileHandleValue == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER FileSizeValue;
+    if (!GetFileSizeEx(FileHandleValue, &FileSizeValue) || FileSizeValue.QuadPart <= 0)
+    {
+        CloseHandle(FileHandleValue);
+        return false;
+    }
+
+    const HANDLE MappingHandleValue = CreateFileMappingA(FileHandleValue, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (MappingHandleValue == nullptr)
+    {
+        CloseHandle(FileHandleValue);
+        return false;
+    }
+
+    const void* ViewValue = MapViewOfFile(MappingHandleValue, FILE_MAP_READ, 0, 0, 0);
+    if (ViewValue == nullptr)
+    {
+        CloseHandle(MappingHandleValue);
+        CloseHandle(FileHandleValue);
+        return false;
+    }
+
+    FileHandle = reinterpret_cast<intptr_t>(FileHandleValue);
+    MappingHandle = reinterpret_cast<intptr_t>(MappingHandleValue);
+    MappedBytes = static_cast<const uint8_t*>(ViewValue);
+    MappedByteCount = static_cast<size_t>(FileSizeValue.QuadPart);
+    return true;
+#else
+    const int FileDescriptorValue = open(FilePathValue.c_str(), O_RDONLY);
+    if (FileDescriptorValue < 0)
+    {
+        return false;
+    }
+
+    struct stat FileStatusValue;
+    if (fstat(FileDescriptorValue, &FileStatusValue) != 0 || FileStatusValue.st_size <= 0)
+    {
+        close(FileDescriptorValue);
+        return false;
+    }
+
+    void* ViewValue =
+        mmap(nullptr, static_cast<size_t>(FileStatusValue.st_size), PROT_READ, MAP_PRIVATE, FileDescriptorValue, 0);
+    close(FileDescriptorValue);
+    if (ViewValue == MAP_FAILED)
+    {
+        return false;
+    }
+
+    MappedBytes = static_cast<const uint8_t*>(ViewValue);
+    MappedByteCount = static_cast<size_t>(FileStatusValue.st_size);
+    return true;
+#endif
+}
+
+void FBuildPlacementSlotCache::UnmapFile()
+{
+    if (MappedBytes == nullptr)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(MappedBytes);
+    CloseHandle(reinterpret_cast<HANDLE>(MappingHandle));
+    CloseHandle(reinterpret_cast<HANDLE>(FileHandle));
+#else
+    munmap(const_cast<uint8_t*>(MappedBytes), MappedByteCount);
+#endif
+
+    MappedBytes = nullptr;
+    MappedByteCount = 0U;
+    FileHandle = -1;
+    MappingHandle = -1;
+}
+
+bool FBuildPlacementSlotCache::IndexMappedEntries()
+{
+    FByteReader HeaderReaderValue(MappedBytes, MappedByteCount);
+    uint32_t MagicValue = 0U;
+    uint16_t FormatVersionValue = 0U;
+    uint16_t ReservedValue = 0U;
+    uint32_t LayoutVersionValue = 0U;
+    uint32_t EntryCountValue = 0U;
+    if (!HeaderReaderValue.Read(MagicValue) || !HeaderReaderValue.Read(FormatVersionValue) ||
+        !HeaderReaderValue.Read(ReservedValue) || !HeaderReaderValue.Read(LayoutVersionValue) ||
+        !HeaderReaderValue.Read(EntryCountValue) || MagicValue != FileMagicValue ||
+        FormatVersionValue != FileFormatVersionValue || LayoutVersionValue != LayoutVersion)
+    {
+        return false;
+    }
+
+    // The count comes from the file, so it is checked against what the file could hold before reserving for it.
+    const size_t MaxEntryCountValue = (MappedByteCount - FileHeaderByteCountValue) / EntryHeaderByteCountValue;
+    if (EntryCountValue > MaxEntryCountValue)
+    {
+        return false;
+    }
+
+    size_t OffsetValue = FileHeaderByteCountValue;
+    MappedEntries.reserve(EntryCountValue);
+    for (uint32_t EntryIndexValue = 0U; EntryIndexValue < EntryCountValue; ++EntryIndexValue)
+    {
+        if (MappedByteCount - OffsetValue < EntryHeaderByteCountValue)
+        {
+            return false;
+        }
+
+        FByteReader EntryReaderValue(MappedBytes + OffsetValue, EntryHeaderByteCountValue);
+        FMappedEntry MappedEntryValue;
+        uint8_t MapIdValue = 0U;
+        uint8_t SpawnIdValue = 0U;
+        uint32_t PayloadByteCountValue = 0U;
+        EntryReaderValue.Read(MappedEntryValue.Key.PlacementGridHash);
+        EntryReaderValue.Read(MapIdValue);
+        EntryReaderValue.Read(SpawnIdValue);
+        EntryReaderValue.Read(MappedEntryValue.Key.BaseTileX);
+        EntryReaderValue.Read(MappedEntryValue.Key.BaseTileY);
+        EntryReaderValue.Read(PayloadByteCountValue);
+        OffsetValue += EntryHeaderByteCountValue;
+        if (MappedByteCount - OffsetValue < PayloadByteCountValue)
+        {
+            return false;
+        }
+
+        MappedEntryValue.Key.MapId = static_cast<EMapId>(MapIdValue);
+        MappedEntryValue.Key.SpawnId = static_cast<ESpawnId>(SpawnIdValue);
+        MappedEntryValue.PayloadOffset = OffsetValue;
+        MappedEntryValue.PayloadByteCount = PayloadByteCountValue;
+        MappedEntries.push_back(MappedEntryValue);
+        OffsetValue += PayloadByteCountValue;
+    }
+
+    return true;
+}
+
+}  // namespace sc2
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/catalogs/generated/EMapId.generated.h"
+#include "common/catalogs/generated/ESpawnId.generated.h"
+#include "common/services/FBuildPlacementContext.h"
+#include "common/services/FMainBaseLayoutDescriptor.h"
+#include "common/services/FRampWallDescriptor.h"
+
+namespace sc2
+{
+
+struct GameInfo;
+
+// Identifies one resolved layout: the map by its placement grid hash, which changes whenever the map is edited, and
+// the spawn by its authored id when known and by its start tile otherwise.
+struct FBuildPlacementSlotCacheKey
+{
+public:
+    FBuildPlacementSlotCacheKey();
+
+    static FBuildPlacementSlotCacheKey Create(const GameInfo& GameInfoValue,
+                                              const FBuildPlacementContext& BuildPlacementContextValue);
+
+public:
+    uint64_t PlacementGridHash;
+    EMapId MapId;
+    ESpawnId SpawnId;
+    int16_t BaseTileX;
+    int16_t BaseTileY;
+};
+
+bool operator==(const FBuildPlacementSlotCacheKey& LeftValue, const FBuildPlacementSlotCacheKey& RightValue);
+
+// Persistent cache of the ramp wall and main base layout descriptors resolved at game start. The file is memory
+// mapped on load and only the entry matching the current map and spawn is decoded; layouts stored during the game are
+// kept in memory and written back together with the mapped entries. The format is native-endian and versioned, so a
+// file from another build or platform is ignored rather than misread. The header also records the layout version
+// that resolved its entries, and a file written by another layout version is ignored the same way.
+class FBuildPlacementSlotCache
+{
+public:
+    static constexpr uint32_t FileMagicValue = 0x31435350U;
+    static constexpr uint16_t FileFormatVersionValue = 2U;
+    // Bump whenever FTerranMainBaseLayoutRegistry, the authored layouts in FMapLayoutDictionaryData or the layout
+    // resolution in FTerranBuildPlacementService change what a game start resolves.
+    static constexpr uint32_t CurrentLayoutVersionValue = 1U;
+
+    explicit FBuildPlacementSlotCache(uint32_t LayoutVersionValue = CurrentLayoutVersionValue);
+    ~FBuildPlacementSlotCache();
+
+    FBuildPlacementSlotCache(const FBuildPlacementSlotCache&) = delete;
+    FBuildPlacementSlotCache& operator=(const FBuildPlacementSlotCache&) = delete;
+
+    // Maps the file and indexes its entries. A missing, truncated or foreign file, or one written for another layout
+    // version, leaves the cache empty.
+    bool LoadFromFile(const std::string& FilePathValue);
+    // Writes every mapped and stored entry to a temporary file named for this process and renames it over
+    // FilePathValue, so concurrent writers never share a partial file.
+    bool SaveToFile(const std::string& FilePathValue);
+    void Clear();
+
+    bool TryGetLayout(const FBuildPlacementSlotCacheKey& KeyValue, FRampWallDescriptor& OutRampWallDescriptorValue,
+                      FMainBaseLayoutDescriptor& OutMainBaseLayoutDescriptorValue) const;
+    void StoreLayout(const FBuildPlacementSlotCacheKey& KeyValue, const FRampWallDescriptor& RampWallDescriptorValue,
+                     const FMainBaseLayoutDescriptor& MainBaseLayoutDescriptorValue);
+
+    size_t GetEntryCount() const;
+    bool IsMapped() const;
+
+private:
+    // Entry payload located in the mapped file.
+    struct FMappedEntry
+    {
+        FBuildPlacementSlotCacheKey Key;
+        size_t PayloadOffset = 0U;
+        size_t PayloadByteCount = 0U;
+    };
+
+    // Entry stored this session, already encoded.
+    struct FStoredEntry
+    {
+        FBuildPlacementSlotCacheKey Key;
+        std::vector<uint8_t> Payload;
+    };
+
+    bool IsMappedEntryReplaced(const FMappedEntry& MappedEntryValue) const;
+    bool MapFile(const std::string& FilePathValue);
+    void UnmapFile();
+    bool IndexMappedEntries();
+
+    std::vector<FMappedEntry> MappedEntries;
+    std::vector<FStoredEntry> StoredEntries;
+
+    uint32_t LayoutVersion;
+    const uint8_t* MappedBytes;
+    size_t MappedByteCount;
+    intptr_t FileHandle;
+    intptr_t MappingHandle;
+};
+
+}  // namespace sc2
@@ -0,0 +1,378 @@
+#include "common/services/FPlacementFootprintEvaluator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/services/FStructureFootprintHelper.h"
+#include "sc2api/sc2_interfaces.h"
+#include "sc2api/sc2_map_info.h"
+#include "sc2api/sc2_unit_filters.h"
+
+namespace sc2
+{
+namespace
+{
+
+// Town halls may not be placed within this many tiles of a mineral field or geyser.
+constexpr int32_t TownHallResourceExclusionTilesValue = 3;
+
+void GetFootprintTileBounds(const Point2D& CenterPointValue, const Point2D& HalfExtentsValue, int32_t& OutMinXValue,
+                            int32_t& OutMinYValue, int32_t& OutMaxXValue, int32_t& OutMaxYValue)
+{
+    OutMinXValue = static_cast<int32_t>(std::floor(CenterPointValue.x - HalfExtentsValue.x + 0.5f));
+    OutMinYValue = static_cast<int32_t>(std::floor(CenterPointValue.y - HalfExtentsValue.y + 0.5f));
+    OutMaxXValue = static_cast<int32_t>(std::floor(CenterPointValue.x + HalfExtentsValue.x - 0.5f));
+    OutMaxYValue = static_cast<int32_t>(std::floor(CenterPointValue.y + HalfExtentsValue.y - 0.5f));
+}
+
+bool DoTileBoundsOverlap(const int32_t MinXOneValue, const int32_t MinYOneValue, const int32_t MaxXOneValue,
+                         const int32_t MaxYOneValue, const int32_t MinXTwoValue, const int32_t MinYTwoValue,
+                         const int32_t MaxXTwoValue, const int32_t MaxYTwoValue)
+{
+    return MinXOneValue <= MaxXTwoValue && MinXTwoValue <= MaxXOneValue && MinYOneValue <= MaxYTwoValue &&
+           MinYTwoValue <= MaxYOneValue;
+}
+
+}  // namespace
+
+FPlacementFootprintEvaluator::FPlacementFootprintEvaluator(const FFrameContext& FrameValue,
+                                                           const Unit* BuilderUnitPtrValue)
+    : Frame(FrameValue),
+      BuilderUnitPtr(BuilderUnitPtrValue),
+      LocalRejectionCount(0U),
+      ConfirmationQueryCount(0U),
+      ConfirmedCandidateQueryCount(0U)
+{
+    if (Frame.Observation == nullptr)
+    {
+        return;
+    }
+
+    static const IsMineralPatch MineralPatchFilterValue;
+    static const IsGeyser GeyserFilterValue;
+
+    const Units UnitsValue = Frame.Observation->GetUnits();
+    BlockingFootprints.reserve(UnitsValue.size());
+    for (const Unit* UnitPtrValue : UnitsValue)
+    {
+        if (UnitPtrValue == nullptr || UnitPtrValue == BuilderUnitPtr || UnitPtrValue->is_flying)
+        {
+            continue;
+        }
+
+        const Unit& UnitValue = *UnitPtrValue;
+        const Point2D UnitPointValue(UnitValue.pos);
+        FBlockingFootprint BlockingFootprintValue;
+        if (MineralPatchFilterValue(UnitValue))
+        {
+            BlockingFootprintValue.bResource = true;
+            GetFootprintTileBounds(UnitPointValue, Point2D(1.0f, 0.5f), BlockingFootprintValue.MinX,
+                                   BlockingFootprintValue.MinY, BlockingFootprintValue.MaxX,
+                                   BlockingFootprintValue.MaxY);
+        }
+        else if (GeyserFilterValue(UnitValue))
+        {
+            BlockingFootprintValue.bResource = true;
+            BlockingFootprintValue.bGeyser = true;
+            GetFootprintTileBounds(UnitPointValue, Point2D(1.5f, 1.5f), BlockingFootprintValue.MinX,
+                                   BlockingFootprintValue.MinY, BlockingFootprintValue.MaxX,
+                                   BlockingFootprintValue.MaxY);
+        }
+        else if (UnitValue.is_building)
+        {
+            // Structure footprints are whole tiles; the unit radius rounds down onto them (5x5 town hall, 2x2 depot).
+            const float HalfExtentValue = std::max(0.5f, std::floor(UnitValue.radius * 2.0f) * 0.5f);
+            GetFootprintTileBounds(UnitPointValue, Point2D(HalfExtentValue, HalfExtentValue),
+                                   BlockingFootprintValue.MinX, BlockingFootprintValue.MinY,
+                                   BlockingFootprintValue.MaxX, BlockingFootprintValue.MaxY);
+        }
+        else if (UnitValue.alliance != Unit::Alliance::Self)
+        {
+            BlockingFootprintValue.MinX = static_cast<int32_t>(std::floor(UnitPointValue.x - UnitValue.radius));
+            BlockingFootprintValue.MinY = static_cast<int32_t>(std::floor(UnitPointValue.y - UnitValue.radius));
+            BlockingFootprintValue.MaxX = static_cast<int32_t>(std::floor(UnitPointValue.x + UnitValue.radius));
+            BlockingFootprintValue.MaxY = static_cast<int32_t>(std::floor(UnitPointValue.y + UnitValue.radius));
+        }
+        else
+        {
+            continue;
+        }
+
+        BlockingFootprints.push_back(BlockingFootprintValue);
+    }
+}
+
+bool FPlacementFootprintEvaluator::IsCandidateLocallyPlaceable(const FPlacementCandidate& CandidateValue) const
+{
+    if (CandidateValue.StructureAbilityId == ABILITY_ID::BUILD_REFINERY)
+    {
+        return IsRefineryCandidateLocallyPlaceable(CandidateValue.BuildPoint);
+    }
+
+    const Point2D HalfExtentsValue =
+        FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(CandidateValue.StructureAbilityId);
+    if (!DoesFootprintSupportTerrain(CandidateValue.BuildPoint, HalfExtentsValue) ||
+        !IsFootprintUnoccupied(CandidateValue.BuildPoint, HalfExtentsValue))
+    {
+        return false;
+    }
+
+    if (CandidateValue.StructureAbilityId == ABILITY_ID::BUILD_COMMANDCENTER &&
+        !DoesTownHallRespectResourceExclusion(CandidateValue.BuildPoint))
+    {
+        return false;
+    }
+
+    if (CandidateValue.bRequiresAddonClearance)
+    {
+        const Point2D AddonCenterValue(CandidateValue.BuildPoint.x + 2.5f, CandidateValue.BuildPoint.y - 0.5f);
+        const Point2D AddonHalfExtentsValue(1.0f, 1.0f);
+        if (!DoesFootprintSupportTerrain(AddonCenterValue, AddonHalfExtentsValue) ||
+            !IsFootprintUnoccupied(AddonCenterValue, AddonHalfExtentsValue))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int32_t FPlacementFootprintEvaluator::SelectFirstConfirmedCandidate(
+    const std::vector<FPlacementCandidate>& CandidatesValue, const size_t MaxConfirmationCountValue) const
+{
+    const size_t BatchSizeValue = std::max<size_t>(MaxConfirmationCountValue, 1U);
+    std::vector<size_t> SurvivorIndicesValue;
+    std::vector<QueryInterface::PlacementQuery> PlacementQueriesValue;
+    SurvivorIndicesValue.reserve(BatchSizeValue);
+    PlacementQueriesValue.reserve(BatchSizeValue);
+
+    size_t NextCandidateIndexValue = 0U;
+    while (NextCandidateIndexValue < CandidatesValue.size())
+    {
+        SurvivorIndicesValue.clear();
+        for (; NextCandidateIndexValue < CandidatesValue.size() && SurvivorIndicesValue.size() < BatchSizeValue;
+             ++NextCandidateIndexValue)
+        {
+            if (!IsCandidateLocallyPlaceable(CandidatesValue[NextCandidateIndexValue]))
+            {
+                ++LocalRejectionCount;
+                continue;
+            }
+
+            SurvivorIndicesValue.push_back(NextCandidateIndexValue);
+        }
+
+        if (SurvivorIndicesValue.empty())
+        {
+            return -1;
+        }
+
+        if (Frame.Query == nullptr)
+        {
+            return static_cast<int32_t>(SurvivorIndicesValue.front());
+        }
+
+        PlacementQueriesValue.clear();
+        for (const size_t SurvivorIndexValue : SurvivorIndicesValue)
+        {
+            QueryInterface::PlacementQuery PlacementQueryValue(CandidatesValue[SurvivorIndexValue].StructureAbilityId,
+                                                               CandidatesValue[SurvivorIndexValue].BuildPoint);
+            PlacementQueryValue.placing_unit_tag = BuilderUnitPtr != nullptr ? BuilderUnitPtr->tag : NullTag;
+            PlacementQueriesValue.push_back(PlacementQueryValue);
+        }
+
+        ++ConfirmationQueryCount;
+        ConfirmedCandidateQueryCount += static_cast<uint32_t>(PlacementQueriesValue.size());
+        const std::vector<bool> PlacementResultsValue = Frame.Query->Placement(PlacementQueriesValue);
+        const size_t ResultCountValue = std::min(PlacementResultsValue.size(), SurvivorIndicesValue.size());
+        for (size_t ResultIndexValue = 0U; ResultIndexValue < ResultCountValue; ++ResultIndexValue)
+        {
+            if (PlacementResultsValue[ResultIndexValue])
+            {
+                return static_cast<int32_t>(SurvivorIndicesValue[ResultIndexValue]);
+            }
+        }
+    }
+
+    return -1;
+}
+
+std::vector<bool> FPlacementFootprintEvaluator::ConfirmCandidates(
+    const std::vector<FPlacementCandidate>& CandidatesValue) const
+{
+    std::vector<bool> ConfirmedValue(CandidatesValue.size(), false);
+    std::vector<size_t> SurvivorIndicesValue;
+    std::vector<QueryInterface::PlacementQuery> PlacementQueriesValue;
+    for (size_t CandidateIndexValue = 0U; CandidateIndexValue < CandidatesValue.size(); ++CandidateIndexValue)
+    {
+        const FPlacementCandidate& CandidateValue = CandidatesValue[CandidateIndexValue];
+        if (!IsCandidateLocallyPlaceable(CandidateValue))
+        {
+            ++LocalRejectionCount;
+            continue;
+        }
+
+        SurvivorIndicesValue.push_back(CandidateIndexValue);
+        QueryInterface::PlacementQuery PlacementQueryValue(CandidateValue.StructureAbilityId,
+                                                           CandidateValue.BuildPoint);
+        PlacementQueryValue.placing_unit_tag = BuilderUnitPtr != nullptr ? BuilderUnitPtr->tag : NullTag;
+        PlacementQueriesValue.push_back(PlacementQueryValue);
+    }
+
+    if (SurvivorIndicesValue.empty())
+    {
+        return ConfirmedValue;
+    }
+
+    if (Frame.Query == nullptr)
+    {
+        for (const size_t SurvivorIndexValue : SurvivorIndicesValue)
+        {
+            ConfirmedValue[SurvivorIndexValue] = true;
+        }
+        return ConfirmedValue;
+    }
+
+    ++ConfirmationQueryCount;
+    ConfirmedCandidateQueryCount += static_cast<uint32_t>(PlacementQueriesValue.size());
+    const std::vector<bool> PlacementResultsValue = Frame.Query->Placement(PlacementQueriesValue);
+    const size_t ResultCountValue = std::min(PlacementResultsValue.size(), SurvivorIndicesValue.size());
+    for (size_t ResultIndexValue = 0U; ResultIndexValue < ResultCountValue; ++ResultIndexValue)
+    {
+        ConfirmedValue[SurvivorIndicesValue[ResultIndexValue]] = PlacementResultsValue[ResultIndexValue];
+    }
+
+    return ConfirmedValue;
+}
+
+uint32_t FPlacementFootprintEvaluator::GetLocalRejectionCount() const
+{
+    return LocalRejectionCount;
+}
+
+uint32_t FPlacementFootprintEvaluator::GetConfirmationQueryCount() const
+{
+    return ConfirmationQueryCount;
+}
+
+uint32_t FPlacementFootprintEvaluator::GetConfirmedCandidateQueryCount() const
+{
+    return ConfirmedCandidateQueryCount;
+}
+
+bool FPlacementFootprintEvaluator::DoesFootprintSupportTerrain(const Point2D& CenterPointValue,
+                                                              const Point2D& HalfExtentsValue) const
+{
+    int32_t MinXValue = 0;
+    int32_t MinYValue = 0;
+    int32_t MaxXValue = 0;
+    int32_t MaxYValue = 0;
+    GetFootprintTileBounds(CenterPointValue, HalfExtentsValue, MinXValue, MinYValue, MaxXValue, MaxYValue);
+
+    if (Frame.DecodedMapGrids != nullptr && Frame.DecodedMapGrids->HasTerrain())
+    {
+        return Frame.DecodedMapGrids->IsAreaPlacable(Point2DI(MinXValue, MinYValue), Point2DI(MaxXValue, MaxYValue));
+    }
+
+    if (Frame.GameInfo == nullptr)
+    {
+        return true;
+    }
+
+    const PlacementGrid PlacementGridValue(*Frame.GameInfo);
+    for (int32_t TileYValue = MinYValue; TileYValue <= MaxYValue; ++TileYValue)
+    {
+        for (int32_t TileXValue = MinXValue; TileXValue <= MaxXValue; ++TileXValue)
+        {
+            if (!PlacementGridValue.IsPlacable(Point2DI(TileXValue, TileYValue)))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FPlacementFootprintEvaluator::IsFootprintUnoccupied(const Point2D& CenterPointValue,
+                                                        const Point2D& HalfExtentsValue) const
+{
+    int32_t MinXValue = 0;
+    int32_t MinYValue = 0;
+    int32_t MaxXValue = 0;
+    int32_t MaxYValue = 0;
+    GetFootprintTileBounds(CenterPointValue, HalfExtentsValue, MinXValue, MinYValue, MaxXValue, MaxYValue);
+
+    for (const FBlockingFootprint& BlockingFootprintValue : BlockingFootprints)
+    {
+        if (DoTileBoundsOverlap(MinXValue, MinYValue, MaxXValue, MaxYValue, BlockingFootprintValue.MinX,
+                                BlockingFootprintValue.MinY, BlockingFootprintValue.MaxX,
+                                BlockingFootprintValue.MaxY))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FPlacementFootprintEvaluator::DoesTownHallRespectResourceExclusion(const Point2D& CenterPointValue) const
+{
+    int32_t MinXValue = 0;
+    int32_t MinYValue = 0;
+    int32_t MaxXValue = 0;
+    int32_t MaxYValue = 0;
+    GetFootprintTileBounds(CenterPointValue,
+                           FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(
+                               ABILITY_ID::BUILD_COMMANDCENTER),
+                           MinXValue, MinYValue, MaxXValue, MaxYValue);
+
+    for (const FBlockingFootprint& BlockingFootprintValue : BlockingFootprints)
+    {
+        if (BlockingFootprintValue.bResource &&
+            DoTileBoundsOverlap(MinXValue - TownHallResourceExclusionTilesValue,
+                                MinYValue - TownHallResourceExclusionTilesValue,
+                                MaxXValue + TownHallResourceExclusionTilesValue,
+                                MaxYValue + TownHallResourceExclusionTilesValue, BlockingFootprintValue.MinX,
+                                BlockingFootprintValue.MinY, BlockingFootprintValue.MaxX,
+                                BlockingFootprintValue.MaxY))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FPlacementFootprintEvaluator::IsRefineryCandidateLocallyPlaceable(const Point2D& GeyserPointValue) const
+{
+    // Refineries go on a geyser rather than on placeable terrain; the geyser must be known and not already built on.
+    if (Frame.Observation == nullptr)
+    {
+        return true;
+    }
+
+    const int32_t TileXValue = static_cast<int32_t>(std::floor(GeyserPointValue.x));
+    const int32_t TileYValue = static_cast<int32_t>(std::floor(GeyserPointValue.y));
+    bool bFoundGeyserValue = false;
+    for (const FBlockingFootprint& BlockingFootprintValue : BlockingFootprints)
+    {
+        if (!DoTileBoundsOverlap(TileXValue, TileYValue, TileXValue, TileYValue, BlockingFootprintValue.MinX,
+                                 BlockingFootprintValue.MinY, BlockingFootprintValue.MaxX,
+                                 BlockingFootprintValue.MaxY))
+        {
+            continue;
+        }
+
+        if (!BlockingFootprintValue.bGeyser)
+        {
+            return false;
+        }
+
+        bFoundGeyserValue = true;
+    }
+
+    return bFoundGeyserValue;
+}
+
+}  // namespace sc2
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/agent_framework.h"
+
+namespace sc2
+{
+
+struct FPlacementCandidate
+{
+    ABILITY_ID StructureAbilityId = ABILITY_ID::INVALID;
+    Point2D BuildPoint;
+    bool bRequiresAddonClearance = false;
+};
+
+// Placement pre-filter that needs no game round trip. A candidate footprint is checked against the static placement
+// grid, observed structures, non-friendly ground units, its addon footprint and, for town halls, the resource
+// exclusion zone. Candidates that survive are confirmed in order with one batched QueryInterface::Placement call.
+// Friendly ground units are not treated as blockers because the planners move them out of the way.
+class FPlacementFootprintEvaluator
+{
+public:
+    static constexpr size_t DefaultMaxConfirmationCountValue = 8U;
+
+    // Collects blocking footprints from the frame's observation once; the evaluator is meant to live for one search.
+    // The builder is ignored as a blocker and is passed to the confirmation query.
+    explicit FPlacementFootprintEvaluator(const FFrameContext& FrameValue, const Unit* BuilderUnitPtrValue = nullptr);
+
+    bool IsCandidateLocallyPlaceable(const FPlacementCandidate& CandidateValue) const;
+
+    // Returns the index of the first candidate, in order, that passes the local checks and is confirmed by the game,
+    // or -1. Survivors are confirmed MaxConfirmationCountValue at a time, so a search issues one Placement call unless
+    // every survivor of the first batch is rejected. Without a query interface the first local survivor is returned.
+    int32_t SelectFirstConfirmedCandidate(const std::vector<FPlacementCandidate>& CandidatesValue,
+                                          size_t MaxConfirmationCountValue = DefaultMaxConfirmationCountValue) const;
+
+    // Runs the local checks on every candidate and confirms all survivors with one Placement call. Entry i is true
+    // when candidate i passed both.
+    std::vector<bool> ConfirmCandidates(const std::vector<FPlacementCandidate>& CandidatesValue) const;
+
+    uint32_t GetLocalRejectionCount() const;
+    uint32_t GetConfirmationQueryCount() const;
+    uint32_t GetConfirmedCandidateQueryCount() const;
+
+private:
+    // Inclusive tile bounds of one blocking footprint.
+    struct FBlockingFootprint
+    {
+        int32_t MinX = 0;
+        int32_t MinY = 0;
+        int32_t MaxX = -1;
+        int32_t MaxY = -1;
+        bool bResource = false;
+        bool bGeyser = false;
+    };
+
+    bool DoesFootprintSupportTerrain(const Point2D& CenterPointValue, const Point2D& HalfExtentsValue) const;
+    bool IsFootprintUnoccupied(const Point2D& CenterPointValue, const Point2D& HalfExtentsValue) const;
+    bool DoesTownHallRespectResourceExclusion(const Point2D& CenterPointValue) const;
+    bool IsRefineryCandidateLocallyPlaceable(const Point2D& GeyserPointValue) const;
+
+    const FFrameContext& Frame;
+    const Unit* BuilderUnitPtr;
+    std::vector<FBlockingFootprint> BlockingFootprints;
+
+    mutable uint32_t LocalRejectionCount;
+    mutable uint32_t ConfirmationQueryCount;
+    mutable uint32_t ConfirmedCandidateQueryCount;
+};
+
+}  // namespace sc2
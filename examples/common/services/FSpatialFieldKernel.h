@@ -0,0 +1,16 @@
+#pragma once
+
+namespace sc2
+{
+
+// Threat splat for one unit: full weight inside CoreRadius, falling to zero at OuterRadius.
+struct FSpatialFieldKernel
+{
+    float CenterX = 0.0f;
+    float CenterY = 0.0f;
+    float CoreRadius = 0.0f;
+    float OuterRadius = 0.0f;
+    float Weight = 0.0f;
+};
+
+}  // namespace sc2
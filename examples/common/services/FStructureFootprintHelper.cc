@@ -0,0 +1,55 @@
+#include "common/services/FStructureFootprintHelper.h"
+
+namespace sc2
+{
+
+Point2D FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(const ABILITY_ID StructureAbilityIdValue)
+{
+    switch (StructureAbilityIdValue)
+    {
+        case ABILITY_ID::BUILD_SENSORTOWER:
+            return Point2D(0.5f, 0.5f);
+        case ABILITY_ID::BUILD_SUPPLYDEPOT:
+        case ABILITY_ID::BUILD_MISSILETURRET:
+            return Point2D(1.0f, 1.0f);
+        case ABILITY_ID::BUILD_COMMANDCENTER:
+            return Point2D(2.5f, 2.5f);
+        case ABILITY_ID::BUILD_BARRACKS:
+        case ABILITY_ID::BUILD_FACTORY:
+        case ABILITY_ID::BUILD_STARPORT:
+        case ABILITY_ID::BUILD_REFINERY:
+        default:
+            return Point2D(1.5f, 1.5f);
+    }
+}
+
+Point2D FStructureFootprintHelper::GetStructureFootprintHalfExtentsForUnitType(const UNIT_TYPEID UnitTypeIdValue)
+{
+    switch (UnitTypeIdValue)
+    {
+        case UNIT_TYPEID::TERRAN_SENSORTOWER:
+            return Point2D(0.5f, 0.5f);
+        case UNIT_TYPEID::TERRAN_SUPPLYDEPOT:
+        case UNIT_TYPEID::TERRAN_SUPPLYDEPOTLOWERED:
+        case UNIT_TYPEID::TERRAN_MISSILETURRET:
+        case UNIT_TYPEID::TERRAN_REACTOR:
+        case UNIT_TYPEID::TERRAN_BARRACKSREACTOR:
+        case UNIT_TYPEID::TERRAN_FACTORYREACTOR:
+        case UNIT_TYPEID::TERRAN_STARPORTREACTOR:
+        case UNIT_TYPEID::TERRAN_TECHLAB:
+        case UNIT_TYPEID::TERRAN_BARRACKSTECHLAB:
+        case UNIT_TYPEID::TERRAN_FACTORYTECHLAB:
+        case UNIT_TYPEID::TERRAN_STARPORTTECHLAB:
+            return Point2D(1.0f, 1.0f);
+        case UNIT_TYPEID::TERRAN_COMMANDCENTER:
+        case UNIT_TYPEID::TERRAN_ORBITALCOMMAND:
+        case UNIT_TYPEID::TERRAN_PLANETARYFORTRESS:
+            return Point2D(2.5f, 2.5f);
+        case UNIT_TYPEID::TERRAN_REFINERY:
+        case UNIT_TYPEID::TERRAN_REFINERYRICH:
+        default:
+            return Point2D(1.5f, 1.5f);
+    }
+}
+
+}  // namespace sc2
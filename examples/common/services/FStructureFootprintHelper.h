@@ -0,0 +1,21 @@
+#pragma once
+
+#include "sc2api/sc2_common.h"
+#include "sc2api/sc2_typeenums.h"
+
+namespace sc2
+{
+
+// The one table of Terran structure footprints, shared by placement, the footprint evaluator and order expansion.
+// Half extents are in world units, so a 3x3 structure reports (1.5, 1.5).
+struct FStructureFootprintHelper
+{
+public:
+    // Returns the half extents of the structure a build ability places; unlisted abilities get a 3x3 footprint.
+    static Point2D GetStructureFootprintHalfExtentsForAbility(ABILITY_ID StructureAbilityIdValue);
+
+    // Returns the half extents of an observed structure; unlisted unit types get a 3x3 footprint.
+    static Point2D GetStructureFootprintHalfExtentsForUnitType(UNIT_TYPEID UnitTypeIdValue);
+};
+
+}  // namespace sc2
@@ -6,8 +6,11 @@
 #include <limits>
 
 #include "common/terran_models.h"
+#include "common/services/FPlacementFootprintEvaluator.h"
+#include "common/services/FStructureFootprintHelper.h"
 #include "common/services/FTerranMainBaseLayoutRegistry.h"
 #include "sc2api/sc2_map_info.h"
+#include "sc2api/sc2_trace.h"
 #include "sc2api/sc2_unit_filters.h"
 
 namespace sc2
@@ -18,6 +21,9 @@ namespace
 enum class EPlacementCandidateValidationMode : uint8_t
 {
     StaticLayout,
+    // Only the layout checks. FPlacementFootprintEvaluator then checks each footprint once and confirms the survivors
+    // in one batch.
+    LocalPrefilter,
     RuntimeQuery,
 };
 
@@ -35,7 +41,8 @@ struct FResolvedLayoutPlacementSlot
 
 bool DoesStructureAbilityRequireAddonClearance(const ABILITY_ID StructureAbilityIdValue);
 Point2D GetAddonFootprintCenter(const Point2D& StructureBuildPointValue);
-bool DoesAddonFootprintSupportTerrain(const GameInfo& GameInfoValue, const Point2D& StructureBuildPointValue);
+bool DoesAddonFootprintSupportTerrain(const GameInfo& GameInfoValue, const Point2D& StructureBuildPointValue,
+                                      const MapGrids* MapGridsPtrValue = nullptr);
 bool IsPlacementCandidateValid(const FFrameContext& FrameValue, const ABILITY_ID StructureAbilityIdValue,
                                const EBuildPlacementFootprintPolicy BuildPlacementFootprintPolicyValue,
                                const Point2D& CandidatePointValue,
@@ -377,23 +384,6 @@ void AppendPlacementSlots(const Point2D& AnchorValue, const Point2D& ForwardDire
     }
 }
 
-Point2D GetStructureFootprintHalfExtentsForAbility(const ABILITY_ID StructureAbilityIdValue)
-{
-    switch (StructureAbilityIdValue)
-    {
-        case ABILITY_ID::BUILD_SUPPLYDEPOT:
-            return Point2D(1.0f, 1.0f);
-        case ABILITY_ID::BUILD_COMMANDCENTER:
-            return Point2D(2.5f, 2.5f);
-        case ABILITY_ID::BUILD_BARRACKS:
-        case ABILITY_ID::BUILD_FACTORY:
-        case ABILITY_ID::BUILD_STARPORT:
-        case ABILITY_ID::BUILD_REFINERY:
-        default:
-            return Point2D(1.5f, 1.5f);
-    }
-}
-
 bool DoAxisAlignedFootprintsOverlap(const Point2D& CenterPointOneValue, const Point2D& HalfExtentsOneValue,
                                     const Point2D& CenterPointTwoValue, const Point2D& HalfExtentsTwoValue)
 {
@@ -409,7 +399,7 @@ bool DoesPlacementSlotOverlapProtectedAddonFootprints(
     const std::vector<FBuildPlacementSlot>& ProtectedProducerBuildPlacementSlotsValue)
 {
     const Point2D CandidateFootprintHalfExtentsValue =
-        GetStructureFootprintHalfExtentsForAbility(StructureAbilityIdValue);
+        FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(StructureAbilityIdValue);
     static const Point2D AddonFootprintHalfExtentsValue(1.0f, 1.0f);
 
     for (const FBuildPlacementSlot& ProtectedProducerBuildPlacementSlotValue :
@@ -658,7 +648,8 @@ bool DoesCandidateAddonFootprintOverlapSlot(const Point2D& CandidateBuildPointVa
         GetAddonFootprintCenter(ResolvedLayoutPlacementSlotValue.BuildPlacementSlot.BuildPoint);
     const Point2D AddonHalfExtentsValue(1.0f, 1.0f);
     const Point2D ExistingStructureHalfExtentsValue =
-        GetStructureFootprintHalfExtentsForAbility(ResolvedLayoutPlacementSlotValue.StructureAbilityId);
+        FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(
+            ResolvedLayoutPlacementSlotValue.StructureAbilityId);
 
     return DoAxisAlignedFootprintsOverlap(CandidateAddonCenterValue, AddonHalfExtentsValue,
                                           ResolvedLayoutPlacementSlotValue.BuildPlacementSlot.BuildPoint,
@@ -707,7 +698,7 @@ bool DoesCandidatePlacementSlotConflictWithResolvedLayout(
     const std::vector<FResolvedLayoutPlacementSlot>& ResolvedLayoutPlacementSlotsValue)
 {
     const Point2D CandidateStructureHalfExtentsValue =
-        GetStructureFootprintHalfExtentsForAbility(StructureAbilityIdValue);
+        FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(StructureAbilityIdValue);
     const bool RequiresAddonClearanceValue = DoesStructureAbilityRequireAddonClearance(StructureAbilityIdValue);
 
     for (const FResolvedLayoutPlacementSlot& ResolvedLayoutPlacementSlotValue : ResolvedLayoutPlacementSlotsValue)
@@ -719,7 +710,8 @@ bool DoesCandidatePlacementSlotConflictWithResolvedLayout(
         }
 
         const Point2D ExistingStructureHalfExtentsValue =
-            GetStructureFootprintHalfExtentsForAbility(ResolvedLayoutPlacementSlotValue.StructureAbilityId);
+            FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(
+                ResolvedLayoutPlacementSlotValue.StructureAbilityId);
         if (DoAxisAlignedFootprintsOverlap(CandidateBuildPlacementSlotValue.BuildPoint, CandidateStructureHalfExtentsValue,
                                            ResolvedLayoutPlacementSlotValue.BuildPlacementSlot.BuildPoint,
                                            ExistingStructureHalfExtentsValue))
@@ -856,7 +848,7 @@ bool TryResolveExactPlacementSlot(
     FBuildPlacementSlot CandidateBuildPlacementSlotValue = TemplateBuildPlacementSlotValue;
     CandidateBuildPlacementSlotValue.BuildPoint = CandidatePointValue;
 
-    if (FrameValue.GameInfo != nullptr &&
+    if (FrameValue.GameInfo != nullptr && ValidationModeValue != EPlacementCandidateValidationMode::LocalPrefilter &&
         !IsPlacementCandidateValid(FrameValue, StructureAbilityIdValue,
                                    CandidateBuildPlacementSlotValue.FootprintPolicy, CandidatePointValue,
                                    ValidationModeValue))
@@ -875,28 +867,16 @@ bool TryResolveExactPlacementSlot(
     return true;
 }
 
-bool TryResolveAuthoredPlacementSlot(
-    const FFrameContext& FrameValue, const FBuildPlacementContext& BuildPlacementContextValue,
-    const FBuildPlacementSlot& TemplateBuildPlacementSlotValue, const ABILITY_ID StructureAbilityIdValue,
-    const std::vector<FResolvedLayoutPlacementSlot>& ResolvedLayoutPlacementSlotsValue,
-    FBuildPlacementSlot& OutResolvedBuildPlacementSlotValue,
-    const EPlacementCandidateValidationMode ValidationModeValue =
-        EPlacementCandidateValidationMode::RuntimeQuery)
+// Template slot first, then the template shifted by each search offset in order.
+std::vector<FBuildPlacementSlot> CreateTemplateSearchCandidateSlots(
+    const FBuildPlacementSlot& TemplateBuildPlacementSlotValue, const size_t SearchOffsetCountValue)
 {
-    if (TryResolveExactPlacementSlot(FrameValue, BuildPlacementContextValue, TemplateBuildPlacementSlotValue,
-                                     StructureAbilityIdValue, ResolvedLayoutPlacementSlotsValue,
-                                     OutResolvedBuildPlacementSlotValue, ValidationModeValue))
-    {
-        return true;
-    }
-
-    if (FrameValue.GameInfo == nullptr)
-    {
-        return false;
-    }
-
     const std::array<Point2DI, 25>& SearchOffsetsValue = GetTemplateSearchOffsets();
-    for (size_t SearchOffsetIndexValue = 1U; SearchOffsetIndexValue < SearchOffsetsValue.size();
+    std::vector<FBuildPlacementSlot> CandidateBuildPlacementSlotsValue;
+    CandidateBuildPlacementSlotsValue.reserve(std::min(SearchOffsetCountValue, SearchOffsetsValue.size()));
+    CandidateBuildPlacementSlotsValue.push_back(TemplateBuildPlacementSlotValue);
+    for (size_t SearchOffsetIndexValue = 1U;
+         SearchOffsetIndexValue < std::min(SearchOffsetCountValue, SearchOffsetsValue.size());
          ++SearchOffsetIndexValue)
     {
         const Point2DI& SearchOffsetValue = SearchOffsetsValue[SearchOffsetIndexValue];
@@ -904,48 +884,78 @@ bool TryResolveAuthoredPlacementSlot(
         CandidateBuildPlacementSlotValue.BuildPoint =
             Point2D(TemplateBuildPlacementSlotValue.BuildPoint.x + static_cast<float>(SearchOffsetValue.x),
                     TemplateBuildPlacementSlotValue.BuildPoint.y + static_cast<float>(SearchOffsetValue.y));
-        if (TryResolveExactPlacementSlot(FrameValue, BuildPlacementContextValue, CandidateBuildPlacementSlotValue,
-                                         StructureAbilityIdValue, ResolvedLayoutPlacementSlotsValue,
-                                         OutResolvedBuildPlacementSlotValue, ValidationModeValue))
-        {
-            return true;
-        }
+        CandidateBuildPlacementSlotsValue.push_back(CandidateBuildPlacementSlotValue);
     }
 
-    return false;
+    return CandidateBuildPlacementSlotsValue;
 }
 
-bool TryResolveTemplatePlacementSlot(
+// Resolves the first candidate, in order, that passes every check. For runtime validation the candidates are
+// filtered without game queries and the survivors are confirmed in batches, so a search usually costs one
+// Placement round trip instead of one per candidate.
+bool TryResolveFirstConfirmedPlacementSlot(
     const FFrameContext& FrameValue, const FBuildPlacementContext& BuildPlacementContextValue,
-    const FBuildPlacementSlot& TemplateBuildPlacementSlotValue, const ABILITY_ID StructureAbilityIdValue,
+    const std::vector<FBuildPlacementSlot>& CandidateBuildPlacementSlotsValue,
+    const ABILITY_ID StructureAbilityIdValue,
     const std::vector<FResolvedLayoutPlacementSlot>& ResolvedLayoutPlacementSlotsValue,
-    const bool AllowTemplateSearchValue, FBuildPlacementSlot& OutResolvedBuildPlacementSlotValue)
+    FBuildPlacementSlot& OutResolvedBuildPlacementSlotValue,
+    const EPlacementCandidateValidationMode ValidationModeValue)
 {
-    if (TryResolveExactPlacementSlot(FrameValue, BuildPlacementContextValue, TemplateBuildPlacementSlotValue,
-                                     StructureAbilityIdValue, ResolvedLayoutPlacementSlotsValue,
-                                     OutResolvedBuildPlacementSlotValue))
+    if (ValidationModeValue != EPlacementCandidateValidationMode::RuntimeQuery || FrameValue.GameInfo == nullptr ||
+        FrameValue.Query == nullptr)
     {
-        return true;
-    }
+        for (const FBuildPlacementSlot& CandidateBuildPlacementSlotValue : CandidateBuildPlacementSlotsValue)
+        {
+            if (TryResolveExactPlacementSlot(FrameValue, BuildPlacementContextValue, CandidateBuildPlacementSlotValue,
+                                             StructureAbilityIdValue, ResolvedLayoutPlacementSlotsValue,
+                                             OutResolvedBuildPlacementSlotValue, ValidationModeValue))
+            {
+                return true;
+            }
+        }
 
-    if (!AllowTemplateSearchValue || FrameValue.GameInfo == nullptr)
-    {
         return false;
     }
 
-    const std::array<Point2DI, 25>& SearchOffsetsValue = GetTemplateSearchOffsets();
-    for (size_t SearchOffsetIndexValue = 1U; SearchOffsetIndexValue < SearchOffsetsValue.size();
-         ++SearchOffsetIndexValue)
+    const FPlacementFootprintEvaluator PlacementFootprintEvaluatorValue(FrameValue);
+
+    std::vector<FBuildPlacementSlot> LocallyResolvedSlotsValue;
+    std::vector<FPlacementCandidate> PlacementCandidatesValue;
+    size_t NextCandidateIndexValue = 0U;
+    while (NextCandidateIndexValue < CandidateBuildPlacementSlotsValue.size())
     {
-        const Point2DI& SearchOffsetValue = SearchOffsetsValue[SearchOffsetIndexValue];
-        FBuildPlacementSlot CandidateBuildPlacementSlotValue = TemplateBuildPlacementSlotValue;
-        CandidateBuildPlacementSlotValue.BuildPoint =
-            Point2D(TemplateBuildPlacementSlotValue.BuildPoint.x + static_cast<float>(SearchOffsetValue.x),
-                    TemplateBuildPlacementSlotValue.BuildPoint.y + static_cast<float>(SearchOffsetValue.y));
-        if (TryResolveExactPlacementSlot(FrameValue, BuildPlacementContextValue, CandidateBuildPlacementSlotValue,
-                                         StructureAbilityIdValue, ResolvedLayoutPlacementSlotsValue,
-                                         OutResolvedBuildPlacementSlotValue))
+        LocallyResolvedSlotsValue.clear();
+        PlacementCandidatesValue.clear();
+        for (; NextCandidateIndexValue < CandidateBuildPlacementSlotsValue.size() &&
+               LocallyResolvedSlotsValue.size() < FPlacementFootprintEvaluator::DefaultMaxConfirmationCountValue;
+             ++NextCandidateIndexValue)
+        {
+            FBuildPlacementSlot ResolvedBuildPlacementSlotValue;
+            if (!TryResolveExactPlacementSlot(FrameValue, BuildPlacementContextValue,
+                                              CandidateBuildPlacementSlotsValue[NextCandidateIndexValue],
+                                              StructureAbilityIdValue, ResolvedLayoutPlacementSlotsValue,
+                                              ResolvedBuildPlacementSlotValue,
+                                              EPlacementCandidateValidationMode::LocalPrefilter))
+            {
+                continue;
+            }
+
+            FPlacementCandidate PlacementCandidateValue;
+            PlacementCandidateValue.StructureAbilityId = StructureAbilityIdValue;
+            PlacementCandidateValue.BuildPoint = ResolvedBuildPlacementSlotValue.BuildPoint;
+            PlacementCandidateValue.bRequiresAddonClearance =
+                ResolvedBuildPlacementSlotValue.FootprintPolicy ==
+                EBuildPlacementFootprintPolicy::RequiresAddonClearance;
+            LocallyResolvedSlotsValue.push_back(ResolvedBuildPlacementSlotValue);
+            PlacementCandidatesValue.push_back(PlacementCandidateValue);
+        }
+
+        const int32_t ConfirmedCandidateIndexValue = PlacementFootprintEvaluatorValue.SelectFirstConfirmedCandidate(
+            PlacementCandidatesValue, PlacementCandidatesValue.size());
+        if (ConfirmedCandidateIndexValue >= 0)
         {
+            OutResolvedBuildPlacementSlotValue =
+                LocallyResolvedSlotsValue[static_cast<size_t>(ConfirmedCandidateIndexValue)];
             return true;
         }
     }
@@ -953,6 +963,39 @@ bool TryResolveTemplatePlacementSlot(
     return false;
 }
 
+bool TryResolveAuthoredPlacementSlot(
+    const FFrameContext& FrameValue, const FBuildPlacementContext& BuildPlacementContextValue,
+    const FBuildPlacementSlot& TemplateBuildPlacementSlotValue, const ABILITY_ID StructureAbilityIdValue,
+    const std::vector<FResolvedLayoutPlacementSlot>& ResolvedLayoutPlacementSlotsValue,
+    FBuildPlacementSlot& OutResolvedBuildPlacementSlotValue,
+    const EPlacementCandidateValidationMode ValidationModeValue =
+        EPlacementCandidateValidationMode::RuntimeQuery)
+{
+    const size_t SearchOffsetCountValue =
+        FrameValue.GameInfo != nullptr ? GetTemplateSearchOffsets().size() : static_cast<size_t>(1U);
+    return TryResolveFirstConfirmedPlacementSlot(
+        FrameValue, BuildPlacementContextValue,
+        CreateTemplateSearchCandidateSlots(TemplateBuildPlacementSlotValue, SearchOffsetCountValue),
+        StructureAbilityIdValue, ResolvedLayoutPlacementSlotsValue, OutResolvedBuildPlacementSlotValue,
+        ValidationModeValue);
+}
+
+bool TryResolveTemplatePlacementSlot(
+    const FFrameContext& FrameValue, const FBuildPlacementContext& BuildPlacementContextValue,
+    const FBuildPlacementSlot& TemplateBuildPlacementSlotValue, const ABILITY_ID StructureAbilityIdValue,
+    const std::vector<FResolvedLayoutPlacementSlot>& ResolvedLayoutPlacementSlotsValue,
+    const bool AllowTemplateSearchValue, FBuildPlacementSlot& OutResolvedBuildPlacementSlotValue)
+{
+    const size_t SearchOffsetCountValue = AllowTemplateSearchValue && FrameValue.GameInfo != nullptr
+                                              ? GetTemplateSearchOffsets().size()
+                                              : static_cast<size_t>(1U);
+    return TryResolveFirstConfirmedPlacementSlot(
+        FrameValue, BuildPlacementContextValue,
+        CreateTemplateSearchCandidateSlots(TemplateBuildPlacementSlotValue, SearchOffsetCountValue),
+        StructureAbilityIdValue, ResolvedLayoutPlacementSlotsValue, OutResolvedBuildPlacementSlotValue,
+        EPlacementCandidateValidationMode::RuntimeQuery);
+}
+
 bool TryGetPlacementPlayableBounds(const FFrameContext& FrameValue,
                                    const FBuildPlacementContext& BuildPlacementContextValue,
                                    Point2D& OutPlayableMinValue, Point2D& OutPlayableMaxValue)
@@ -1041,6 +1084,8 @@ bool TryResolveChainedPlacementSlotFromReference(
         FrameValue.GameInfo != nullptr ? SearchOffsetsValue.size() : static_cast<size_t>(1U);
     constexpr int MaximumSearchDistanceValue = 6;
 
+    std::vector<FBuildPlacementSlot> CandidateBuildPlacementSlotsValue;
+    CandidateBuildPlacementSlotsValue.reserve(SearchOffsetCountValue);
     for (size_t SearchOffsetIndexValue = 0U; SearchOffsetIndexValue < SearchOffsetCountValue;
          ++SearchOffsetIndexValue)
     {
@@ -1055,18 +1100,14 @@ bool TryResolveChainedPlacementSlotFromReference(
         CandidateBuildPlacementSlotValue.BuildPoint =
             TemplateBuildPlacementSlotValue.BuildPoint +
             Point2D(static_cast<float>(SearchOffsetValue.x), static_cast<float>(SearchOffsetValue.y));
-        if (TryResolveExactPlacementSlot(FrameValue, BuildPlacementContextValue,
-                                         CandidateBuildPlacementSlotValue,
-                                         StructureAbilityIdValue,
-                                         ResolvedLayoutPlacementSlotsValue,
-                                         OutResolvedBuildPlacementSlotValue,
-                                         EPlacementCandidateValidationMode::RuntimeQuery))
-        {
-            return true;
-        }
+        CandidateBuildPlacementSlotsValue.push_back(CandidateBuildPlacementSlotValue);
     }
 
-    return false;
+    return TryResolveFirstConfirmedPlacementSlot(FrameValue, BuildPlacementContextValue,
+                                                 CandidateBuildPlacementSlotsValue, StructureAbilityIdValue,
+                                                 ResolvedLayoutPlacementSlotsValue,
+                                                 OutResolvedBuildPlacementSlotValue,
+                                                 EPlacementCandidateValidationMode::RuntimeQuery);
 }
 
 void TranslatePlacementSlots(const std::vector<FBuildPlacementSlot>& SourcePlacementSlotsValue,
@@ -1965,10 +2006,18 @@ Point2D GetAddonFootprintCenter(const Point2D& StructureBuildPointValue)
     return Point2D(StructureBuildPointValue.x + 2.5f, StructureBuildPointValue.y - 0.5f);
 }
 
-bool DoesAddonFootprintSupportTerrain(const GameInfo& GameInfoValue, const Point2D& StructureBuildPointValue)
+bool DoesAddonFootprintSupportTerrain(const GameInfo& GameInfoValue, const Point2D& StructureBuildPointValue,
+                                      const MapGrids* MapGridsPtrValue)
 {
-    const PlacementGrid PlacementGridValue(GameInfoValue);
     const Point2D AddonCenterValue = GetAddonFootprintCenter(StructureBuildPointValue);
+    if (MapGridsPtrValue != nullptr && MapGridsPtrValue->HasTerrain())
+    {
+        // The five samples below cover exactly the tiles between the two corner samples.
+        return MapGridsPtrValue->IsAreaPlacable(Point2DI(AddonCenterValue - Point2D(0.5f, 0.5f)),
+                                                Point2DI(AddonCenterValue + Point2D(0.5f, 0.5f)));
+    }
+
+    const PlacementGrid PlacementGridValue(GameInfoValue);
 
     static const std::array<Point2D, 5> AddonSampleOffsetsValue =
     {{
@@ -2004,13 +2053,33 @@ bool DoesAddonFootprintOverlapDepot(const Point2D& BarracksPositionValue, const
 }
 
 bool DoesStructureFootprintSupportTerrain(const GameInfo& GameInfoValue, const ABILITY_ID StructureAbilityIdValue,
-                                          const Point2D& StructureBuildPointValue)
+                                          const Point2D& StructureBuildPointValue,
+                                          const MapGrids* MapGridsPtrValue = nullptr)
 {
-    const PlacementGrid PlacementGridValue(GameInfoValue);
     const Point2D StructureFootprintHalfExtentsValue =
-        GetStructureFootprintHalfExtentsForAbility(StructureAbilityIdValue);
+        FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(StructureAbilityIdValue);
 
     constexpr float SampleEpsilonValue = 0.001f;
+    if (MapGridsPtrValue != nullptr && MapGridsPtrValue->HasTerrain())
+    {
+        // Same tile-center samples as the loop below, which step one tile at a time and so form one rectangle.
+        const Point2D FirstSamplePointValue =
+            StructureBuildPointValue - StructureFootprintHalfExtentsValue + Point2D(0.5f, 0.5f);
+        const float XSampleSpanValue =
+            std::floor(2.0f * StructureFootprintHalfExtentsValue.x - 1.0f + SampleEpsilonValue);
+        const float YSampleSpanValue =
+            std::floor(2.0f * StructureFootprintHalfExtentsValue.y - 1.0f + SampleEpsilonValue);
+        if (XSampleSpanValue < 0.0f || YSampleSpanValue < 0.0f)
+        {
+            return true;
+        }
+
+        return MapGridsPtrValue->IsAreaPlacable(
+            Point2DI(FirstSamplePointValue),
+            Point2DI(FirstSamplePointValue + Point2D(XSampleSpanValue, YSampleSpanValue)));
+    }
+
+    const PlacementGrid PlacementGridValue(GameInfoValue);
     for (float XOffsetValue = (-StructureFootprintHalfExtentsValue.x + 0.5f);
          XOffsetValue <= (StructureFootprintHalfExtentsValue.x - 0.5f + SampleEpsilonValue);
          XOffsetValue += 1.0f)
@@ -2038,7 +2107,8 @@ bool DoesPointSatisfyFootprintPolicy(const FFrameContext& FrameValue, const Poin
                                          EPlacementCandidateValidationMode::RuntimeQuery)
 {
     if (FrameValue.GameInfo == nullptr ||
-        !DoesStructureFootprintSupportTerrain(*FrameValue.GameInfo, StructureAbilityIdValue, BuildPointValue))
+        !DoesStructureFootprintSupportTerrain(*FrameValue.GameInfo, StructureAbilityIdValue, BuildPointValue,
+                                              FrameValue.DecodedMapGrids))
     {
         return false;
     }
@@ -2058,7 +2128,8 @@ bool DoesPointSatisfyFootprintPolicy(const FFrameContext& FrameValue, const Poin
                 return true;
             }
 
-            return DoesAddonFootprintSupportTerrain(*FrameValue.GameInfo, BuildPointValue);
+            return DoesAddonFootprintSupportTerrain(*FrameValue.GameInfo, BuildPointValue,
+                                                    FrameValue.DecodedMapGrids);
         default:
             return false;
     }
@@ -2843,11 +2914,86 @@ FRampWallDescriptor CreateDiscoveredRampWallDescriptor(const FFrameContext& Fram
     return RampWallDescriptorValue;
 }
 
+void HashFingerprintBytes(const void* BytesValue, const size_t ByteCountValue, uint64_t& HashValue)
+{
+    const uint8_t* BytePtrValue = static_cast<const uint8_t*>(BytesValue);
+    for (size_t ByteIndexValue = 0U; ByteIndexValue < ByteCountValue; ++ByteIndexValue)
+    {
+        HashValue ^= BytePtrValue[ByteIndexValue];
+        HashValue *= 1099511628211ULL;
+    }
+}
+
+void HashFingerprintPoint(const Point2D& PointValue, uint64_t& HashValue)
+{
+    HashFingerprintBytes(&PointValue.x, sizeof(PointValue.x), HashValue);
+    HashFingerprintBytes(&PointValue.y, sizeof(PointValue.y), HashValue);
+}
+
+void HashFingerprintSlot(const FBuildPlacementSlot& BuildPlacementSlotValue, uint64_t& HashValue)
+{
+    const uint8_t SlotFieldsValue[3] =
+    {
+        static_cast<uint8_t>(BuildPlacementSlotValue.SlotId.SlotType),
+        BuildPlacementSlotValue.SlotId.Ordinal,
+        static_cast<uint8_t>(BuildPlacementSlotValue.FootprintPolicy),
+    };
+    HashFingerprintBytes(SlotFieldsValue, sizeof(SlotFieldsValue), HashValue);
+    HashFingerprintPoint(BuildPlacementSlotValue.BuildPoint, HashValue);
+}
+
+void HashFingerprintSlots(const std::vector<FBuildPlacementSlot>& BuildPlacementSlotsValue, uint64_t& HashValue)
+{
+    const uint64_t SlotCountValue = BuildPlacementSlotsValue.size();
+    HashFingerprintBytes(&SlotCountValue, sizeof(SlotCountValue), HashValue);
+    for (const FBuildPlacementSlot& BuildPlacementSlotValue : BuildPlacementSlotsValue)
+    {
+        HashFingerprintSlot(BuildPlacementSlotValue, HashValue);
+    }
+}
+
+// Hash of every context field GetStructurePlacementSlots reads; never zero, so it never matches an empty table.
+uint64_t GetBuildPlacementContextFingerprint(const FBuildPlacementContext& BuildPlacementContextValue)
+{
+    uint64_t HashValue = 1469598103934665603ULL;
+    HashFingerprintPoint(BuildPlacementContextValue.BaseLocation, HashValue);
+    HashFingerprintPoint(BuildPlacementContextValue.NaturalLocation, HashValue);
+    HashFingerprintPoint(BuildPlacementContextValue.PlayableMin, HashValue);
+    HashFingerprintPoint(BuildPlacementContextValue.PlayableMax, HashValue);
+    HashFingerprintBytes(&BuildPlacementContextValue.MapDescriptorPtr,
+                         sizeof(BuildPlacementContextValue.MapDescriptorPtr), HashValue);
+    HashFingerprintBytes(&BuildPlacementContextValue.SpawnLayoutPtr,
+                         sizeof(BuildPlacementContextValue.SpawnLayoutPtr), HashValue);
+
+    const FRampWallDescriptor& RampWallDescriptorValue = BuildPlacementContextValue.RampWallDescriptor;
+    const uint8_t RampWallValidValue = RampWallDescriptorValue.bIsValid ? 1U : 0U;
+    HashFingerprintBytes(&RampWallValidValue, sizeof(RampWallValidValue), HashValue);
+    HashFingerprintSlot(RampWallDescriptorValue.LeftDepotSlot, HashValue);
+    HashFingerprintSlot(RampWallDescriptorValue.BarracksSlot, HashValue);
+    HashFingerprintSlot(RampWallDescriptorValue.RightDepotSlot, HashValue);
+
+    const FMainBaseLayoutDescriptor& MainBaseLayoutDescriptorValue =
+        BuildPlacementContextValue.MainBaseLayoutDescriptor;
+    const uint8_t MainBaseLayoutValidValue = MainBaseLayoutDescriptorValue.bIsValid ? 1U : 0U;
+    HashFingerprintBytes(&MainBaseLayoutValidValue, sizeof(MainBaseLayoutValidValue), HashValue);
+    HashFingerprintSlots(MainBaseLayoutDescriptorValue.NaturalEntranceWallDepotSlots, HashValue);
+    HashFingerprintSlots(MainBaseLayoutDescriptorValue.NaturalEntranceBunkerSlots, HashValue);
+    HashFingerprintSlots(MainBaseLayoutDescriptorValue.NaturalApproachDepotSlots, HashValue);
+    HashFingerprintSlots(MainBaseLayoutDescriptorValue.SupportDepotSlots, HashValue);
+    HashFingerprintSlots(MainBaseLayoutDescriptorValue.PeripheralDepotSlots, HashValue);
+    HashFingerprintSlots(MainBaseLayoutDescriptorValue.ProductionRailWithAddonSlots, HashValue);
+    HashFingerprintSlots(MainBaseLayoutDescriptorValue.BarracksWithAddonSlots, HashValue);
+    HashFingerprintSlots(MainBaseLayoutDescriptorValue.FactoryWithAddonSlots, HashValue);
+    HashFingerprintSlots(MainBaseLayoutDescriptorValue.StarportWithAddonSlots, HashValue);
+    return HashValue != 0U ? HashValue : 1U;
+}
+
 }  // namespace
 
 FRampWallDescriptor FTerranBuildPlacementService::GetRampWallDescriptor(
     const FFrameContext& FrameValue, const FBuildPlacementContext& BuildPlacementContextValue) const
 {
+    SC2_TRACE_ZONE("FTerranBuildPlacementService::GetRampWallDescriptor");
     if (!BuildPlacementContextValue.HasNaturalLocation())
     {
         return FRampWallDescriptor();
@@ -2864,6 +3010,7 @@ FRampWallDescriptor FTerranBuildPlacementService::GetRampWallDescriptor(
 FMainBaseLayoutDescriptor FTerranBuildPlacementService::GetMainBaseLayoutDescriptor(
     const FFrameContext& FrameValue, const FBuildPlacementContext& BuildPlacementContextValue) const
 {
+    SC2_TRACE_ZONE("FTerranBuildPlacementService::GetMainBaseLayoutDescriptor");
     FMainBaseLayoutDescriptor MainBaseLayoutDescriptorValue;
     const Point2D MainBaseDepthDirectionValue = GetMainBaseDepthDirection(BuildPlacementContextValue);
     Point2D MainBaseLateralDirectionValue =
@@ -3196,6 +3343,34 @@ Point2D FTerranBuildPlacementService::GetProductionRallyPoint(
 std::vector<FBuildPlacementSlot> FTerranBuildPlacementService::GetStructurePlacementSlots(
     const FGameStateDescriptor& GameStateDescriptorValue, const ABILITY_ID StructureAbilityId,
     const FBuildPlacementContext& BuildPlacementContextValue) const
+{
+    SC2_TRACE_ZONE("FTerranBuildPlacementService::GetStructurePlacementSlots");
+    const uint64_t ContextFingerprintValue = GetBuildPlacementContextFingerprint(BuildPlacementContextValue);
+    if (ContextFingerprintValue != StructurePlacementSlotTableFingerprint)
+    {
+        StructurePlacementSlotTable.clear();
+        StructurePlacementSlotTableFingerprint = ContextFingerprintValue;
+    }
+
+    for (const FStructurePlacementSlotTableEntry& TableEntryValue : StructurePlacementSlotTable)
+    {
+        if (TableEntryValue.StructureAbilityId == StructureAbilityId)
+        {
+            return TableEntryValue.PlacementSlots;
+        }
+    }
+
+    FStructurePlacementSlotTableEntry TableEntryValue;
+    TableEntryValue.StructureAbilityId = StructureAbilityId;
+    TableEntryValue.PlacementSlots =
+        CreateStructurePlacementSlots(GameStateDescriptorValue, StructureAbilityId, BuildPlacementContextValue);
+    StructurePlacementSlotTable.push_back(TableEntryValue);
+    return TableEntryValue.PlacementSlots;
+}
+
+std::vector<FBuildPlacementSlot> FTerranBuildPlacementService::CreateStructurePlacementSlots(
+    const FGameStateDescriptor& GameStateDescriptorValue, const ABILITY_ID StructureAbilityId,
+    const FBuildPlacementContext& BuildPlacementContextValue) const
 {
     const Point2D PrimaryAnchorValue = GetPrimaryStructureAnchor(GameStateDescriptorValue, BuildPlacementContextValue);
     const FRampWallDescriptor RampWallDescriptorValue =
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "common/services/IBuildPlacementService.h"
@@ -23,6 +24,22 @@ public:
     std::vector<FBuildPlacementSlot> GetStructurePlacementSlots(
         const FGameStateDescriptor& GameStateDescriptorValue, ABILITY_ID StructureAbilityId,
         const FBuildPlacementContext& BuildPlacementContextValue) const final;
+
+private:
+    struct FStructurePlacementSlotTableEntry
+    {
+        ABILITY_ID StructureAbilityId = ABILITY_ID::INVALID;
+        std::vector<FBuildPlacementSlot> PlacementSlots;
+    };
+
+    std::vector<FBuildPlacementSlot> CreateStructurePlacementSlots(
+        const FGameStateDescriptor& GameStateDescriptorValue, ABILITY_ID StructureAbilityId,
+        const FBuildPlacementContext& BuildPlacementContextValue) const;
+
+    // Per-game slot table: slot lists depend only on the placement context, so they are built once per ability and
+    // reused until the context fingerprint changes.
+    mutable uint64_t StructurePlacementSlotTableFingerprint{0U};
+    mutable std::vector<FStructurePlacementSlotTableEntry> StructurePlacementSlotTable;
 };
 
 }  // namespace sc2
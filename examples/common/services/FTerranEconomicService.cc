@@ -67,12 +67,12 @@ FCommandResourceCost GetCommandResourceCostFromBlockedTask(const FBlockedTaskRec
 bool ShouldCountCommittedBudgetForOrder(const FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue,
                                         const size_t OrderIndexValue)
 {
-    if (IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+    if (IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
     {
         return false;
     }
 
-    switch (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue])
+    switch (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer)
     {
         case ECommandAuthorityLayer::Army:
         case ECommandAuthorityLayer::Squad:
@@ -82,13 +82,15 @@ bool ShouldCountCommittedBudgetForOrder(const FCommandAuthoritySchedulingState&
             break;
     }
 
-    if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] == ECommandAuthorityLayer::EconomyAndProduction &&
+    if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer ==
+            ECommandAuthorityLayer::EconomyAndProduction &&
         CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue] != 0U)
     {
         size_t ParentOrderIndexValue = 0U;
         if (CommandAuthoritySchedulingStateValue.TryGetOrderIndex(
                 CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue], ParentOrderIndexValue) &&
-            !IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[ParentOrderIndexValue]))
+            !IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[ParentOrderIndexValue].LifecycleState))
         {
             return false;
         }
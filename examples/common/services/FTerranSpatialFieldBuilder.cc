@@ -0,0 +1,507 @@
+#include "common/services/FTerranSpatialFieldBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "sc2api/sc2_interfaces.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SC2_SPATIAL_FIELD_SSE2 1
+#else
+#define SC2_SPATIAL_FIELD_SSE2 0
+#endif
+
+namespace sc2
+{
+namespace
+{
+
+// Distance past weapon range over which threat fades to zero, so units about to step into range still see it.
+constexpr float ThreatFalloffDistanceValue = 3.0f;
+// Movement below this many tiles keeps the previously splatted kernel; the next periodic rebuild absorbs it.
+constexpr float KernelMoveToleranceSquaredValue = 0.25f;
+constexpr float KernelShapeToleranceValue = 0.01f;
+constexpr float ResidueValue = 1.0e-3f;
+
+float GetGroundDamagePerSecond(const UnitTypeData& UnitTypeDataValue, float& OutMaxRangeValue)
+{
+    float DamagePerSecondValue = 0.0f;
+    OutMaxRangeValue = 0.0f;
+    for (const Weapon& WeaponValue : UnitTypeDataValue.weapons)
+    {
+        if (WeaponValue.type == Weapon::TargetType::Air || WeaponValue.speed <= 0.0f)
+        {
+            continue;
+        }
+
+        DamagePerSecondValue +=
+            WeaponValue.damage_ * static_cast<float>(std::max(WeaponValue.attacks, 1U)) / WeaponValue.speed;
+        OutMaxRangeValue = std::max(OutMaxRangeValue, WeaponValue.range);
+    }
+    return DamagePerSecondValue;
+}
+
+bool TryBuildUnitKernel(const Unit& UnitValue, const UnitTypes& UnitTypesValue, FSpatialFieldKernel& OutKernelValue)
+{
+    if (UnitValue.build_progress < 1.0f)
+    {
+        return false;
+    }
+
+    const size_t UnitTypeIndexValue = static_cast<size_t>(static_cast<uint32_t>(UnitValue.unit_type));
+    if (UnitTypeIndexValue >= UnitTypesValue.size())
+    {
+        return false;
+    }
+
+    float MaxRangeValue = 0.0f;
+    const float DamagePerSecondValue = GetGroundDamagePerSecond(UnitTypesValue[UnitTypeIndexValue], MaxRangeValue);
+    if (DamagePerSecondValue <= 0.0f)
+    {
+        return false;
+    }
+
+    OutKernelValue.CenterX = UnitValue.pos.x;
+    OutKernelValue.CenterY = UnitValue.pos.y;
+    OutKernelValue.CoreRadius = MaxRangeValue + UnitValue.radius;
+    OutKernelValue.OuterRadius = OutKernelValue.CoreRadius + ThreatFalloffDistanceValue;
+    OutKernelValue.Weight = DamagePerSecondValue;
+    return true;
+}
+
+bool HasKernelChanged(const FSpatialFieldKernel& AppliedKernelValue, const FSpatialFieldKernel& DesiredKernelValue)
+{
+    const float DeltaXValue = DesiredKernelValue.CenterX - AppliedKernelValue.CenterX;
+    const float DeltaYValue = DesiredKernelValue.CenterY - AppliedKernelValue.CenterY;
+    if (DeltaXValue * DeltaXValue + DeltaYValue * DeltaYValue > KernelMoveToleranceSquaredValue)
+    {
+        return true;
+    }
+
+    return std::fabs(DesiredKernelValue.OuterRadius - AppliedKernelValue.OuterRadius) > KernelShapeToleranceValue ||
+           std::fabs(DesiredKernelValue.CoreRadius - AppliedKernelValue.CoreRadius) > KernelShapeToleranceValue ||
+           std::fabs(DesiredKernelValue.Weight - AppliedKernelValue.Weight) > KernelShapeToleranceValue;
+}
+
+// Adds Scale * clamp((OuterSquared - d^2) * InverseSpan, 0, 1) to each tile centre in [FirstColumn, LastColumn].
+// Subtractions snap values below ResidueValue to zero so float residue from removed kernels never reads as threat.
+void SplatKernelRow(float* RowValues, const int32_t FirstColumnValue, const int32_t LastColumnValue,
+                    const float CenterXValue, const float DeltaYSquaredValue, const float OuterSquaredValue,
+                    const float InverseSpanValue, const float ScaleValue)
+{
+    int32_t ColumnValue = FirstColumnValue;
+#if SC2_SPATIAL_FIELD_SSE2
+    const __m128 LaneOffsetsValue = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+    const __m128 CenterXVector = _mm_set1_ps(CenterXValue);
+    const __m128 OuterMinusDeltaYVector = _mm_set1_ps(OuterSquaredValue - DeltaYSquaredValue);
+    const __m128 InverseSpanVector = _mm_set1_ps(InverseSpanValue);
+    const __m128 ScaleVector = _mm_set1_ps(ScaleValue);
+    const __m128 ZeroVector = _mm_setzero_ps();
+    const __m128 OneVector = _mm_set1_ps(1.0f);
+    const __m128 ResidueVector = _mm_set1_ps(ResidueValue);
+    const bool bClampToZeroValue = ScaleValue < 0.0f;
+    for (; ColumnValue + 3 <= LastColumnValue; ColumnValue += 4)
+    {
+        const __m128 TileXVector = _mm_add_ps(_mm_set1_ps(static_cast<float>(ColumnValue)), LaneOffsetsValue);
+        const __m128 DeltaXVector = _mm_sub_ps(TileXVector, CenterXVector);
+        const __m128 FalloffVector = _mm_mul_ps(
+            _mm_sub_ps(OuterMinusDeltaYVector, _mm_mul_ps(DeltaXVector, DeltaXVector)), InverseSpanVector);
+        const __m128 ContributionVector =
+            _mm_mul_ps(_mm_min_ps(_mm_max_ps(FalloffVector, ZeroVector), OneVector), ScaleVector);
+        __m128 FieldVector = _mm_add_ps(_mm_loadu_ps(RowValues + ColumnValue), ContributionVector);
+        if (bClampToZeroValue)
+        {
+            FieldVector = _mm_and_ps(_mm_cmpgt_ps(FieldVector, ResidueVector), FieldVector);
+        }
+        _mm_storeu_ps(RowValues + ColumnValue, FieldVector);
+    }
+#endif
+    for (; ColumnValue <= LastColumnValue; ++ColumnValue)
+    {
+        const float DeltaXValue = static_cast<float>(ColumnValue) + 0.5f - CenterXValue;
+        const float FalloffValue =
+            (OuterSquaredValue - DeltaYSquaredValue - DeltaXValue * DeltaXValue) * InverseSpanValue;
+        const float FieldValue =
+            RowValues[ColumnValue] + std::min(std::max(FalloffValue, 0.0f), 1.0f) * ScaleValue;
+        RowValues[ColumnValue] = ScaleValue < 0.0f && FieldValue <= ResidueValue ? 0.0f : FieldValue;
+    }
+}
+
+// RetreatSafety = (1 + F) / (1 + F + E), EngageOpportunity = E > Residue ? max(F - E, 0) : 0.
+void DeriveFieldRange(const float* EnemyValues, const float* FriendlyValues, float* RetreatValues,
+                      float* EngageValues, const size_t BeginIndexValue, const size_t EndIndexValue)
+{
+    size_t IndexValue = BeginIndexValue;
+#if SC2_SPATIAL_FIELD_SSE2
+    const __m128 ZeroVector = _mm_setzero_ps();
+    const __m128 OneVector = _mm_set1_ps(1.0f);
+    const __m128 ResidueVector = _mm_set1_ps(ResidueValue);
+    for (; IndexValue + 4U <= EndIndexValue; IndexValue += 4U)
+    {
+        const __m128 EnemyVector = _mm_loadu_ps(EnemyValues + IndexValue);
+        const __m128 FriendlyVector = _mm_loadu_ps(FriendlyValues + IndexValue);
+        const __m128 SafeNumeratorVector = _mm_add_ps(OneVector, FriendlyVector);
+        _mm_storeu_ps(RetreatValues + IndexValue,
+                      _mm_div_ps(SafeNumeratorVector, _mm_add_ps(SafeNumeratorVector, EnemyVector)));
+        const __m128 HasEnemyMask = _mm_cmpgt_ps(EnemyVector, ResidueVector);
+        const __m128 AdvantageVector = _mm_max_ps(_mm_sub_ps(FriendlyVector, EnemyVector), ZeroVector);
+        _mm_storeu_ps(EngageValues + IndexValue, _mm_and_ps(HasEnemyMask, AdvantageVector));
+    }
+#endif
+    for (; IndexValue < EndIndexValue; ++IndexValue)
+    {
+        const float EnemyValue = EnemyValues[IndexValue];
+        const float FriendlyValue = FriendlyValues[IndexValue];
+        RetreatValues[IndexValue] = (1.0f + FriendlyValue) / (1.0f + FriendlyValue + EnemyValue);
+        EngageValues[IndexValue] = EnemyValue > ResidueValue ? std::max(FriendlyValue - EnemyValue, 0.0f) : 0.0f;
+    }
+}
+
+}  // namespace
+
+FTerranSpatialFieldBuilder::FTerranSpatialFieldBuilder()
+    : MaxKernelUpdatesPerStep(DefaultMaxKernelUpdatesPerStepValue),
+      FullRebuildInterval(DefaultFullRebuildIntervalValue),
+      Width(0U),
+      Height(0U),
+      bNeedsFullRebuild(true),
+      UpdatesSinceFullRebuild(0U),
+      UpdateCursor(0U),
+      bLastUpdateFullRebuild(false),
+      LastKernelUpdateCount(0U),
+      LastDeferredKernelCount(0U),
+      LastDerivedTileCount(0U)
+{
+}
+
+void FTerranSpatialFieldBuilder::RebuildSpatialFieldSet(const FFrameContext& FrameContextValue,
+                                                        FSpatialFieldSet& SpatialFieldSetValue) const
+{
+    if (!FrameContextValue.IsValid())
+    {
+        return;
+    }
+
+    const uint32_t WidthValue = static_cast<uint32_t>(std::max(FrameContextValue.GameInfo->width, 0));
+    const uint32_t HeightValue = static_cast<uint32_t>(std::max(FrameContextValue.GameInfo->height, 0));
+    UpdateSpatialFieldSet(FrameContextValue.Observation->GetUnits(), FrameContextValue.Observation->GetUnitTypeData(),
+                          WidthValue, HeightValue, SpatialFieldSetValue);
+}
+
+void FTerranSpatialFieldBuilder::UpdateSpatialFieldSet(const Units& UnitsValue, const UnitTypes& UnitTypesValue,
+                                                       const uint32_t WidthValue, const uint32_t HeightValue,
+                                                       FSpatialFieldSet& SpatialFieldSetValue) const
+{
+    bLastUpdateFullRebuild = false;
+    LastKernelUpdateCount = 0U;
+    LastDeferredKernelCount = 0U;
+    LastDerivedTileCount = 0U;
+    if (WidthValue == 0U || HeightValue == 0U)
+    {
+        SpatialFieldSetValue.Reset();
+        AppliedKernels.clear();
+        Width = 0U;
+        Height = 0U;
+        bNeedsFullRebuild = true;
+        return;
+    }
+
+    CollectDesiredKernels(UnitsValue, UnitTypesValue);
+
+    // The descriptor owning the field set may have been reset or replaced since the last update, in which case the
+    // applied records no longer describe its contents.
+    const bool bDimensionsChangedValue = WidthValue != Width || HeightValue != Height ||
+                                         SpatialFieldSetValue.Width != WidthValue ||
+                                         SpatialFieldSetValue.Height != HeightValue ||
+                                         !SpatialFieldSetValue.IsValid();
+    const bool bRebuildDueValue = FullRebuildInterval > 0U && UpdatesSinceFullRebuild >= FullRebuildInterval;
+    if (bNeedsFullRebuild || bDimensionsChangedValue || bRebuildDueValue)
+    {
+        Width = WidthValue;
+        Height = HeightValue;
+        RebuildAll(SpatialFieldSetValue);
+        return;
+    }
+
+    ApplyIncrementalUpdates(SpatialFieldSetValue);
+    ++UpdatesSinceFullRebuild;
+}
+
+void FTerranSpatialFieldBuilder::SetMaxKernelUpdatesPerStep(const uint32_t MaxKernelUpdatesPerStepValue)
+{
+    MaxKernelUpdatesPerStep = MaxKernelUpdatesPerStepValue;
+}
+
+void FTerranSpatialFieldBuilder::SetFullRebuildInterval(const uint32_t FullRebuildIntervalValue)
+{
+    FullRebuildInterval = FullRebuildIntervalValue;
+}
+
+void FTerranSpatialFieldBuilder::Invalidate()
+{
+    bNeedsFullRebuild = true;
+}
+
+bool FTerranSpatialFieldBuilder::WasLastUpdateFullRebuild() const
+{
+    return bLastUpdateFullRebuild;
+}
+
+uint32_t FTerranSpatialFieldBuilder::GetLastKernelUpdateCount() const
+{
+    return LastKernelUpdateCount;
+}
+
+uint32_t FTerranSpatialFieldBuilder::GetLastDeferredKernelCount() const
+{
+    return LastDeferredKernelCount;
+}
+
+uint64_t FTerranSpatialFieldBuilder::GetLastDerivedTileCount() const
+{
+    return LastDerivedTileCount;
+}
+
+void FTerranSpatialFieldBuilder::CollectDesiredKernels(const Units& UnitsValue,
+                                                       const UnitTypes& UnitTypesValue) const
+{
+    DesiredKernels.clear();
+    for (const Unit* UnitPtr : UnitsValue)
+    {
+        if (UnitPtr == nullptr ||
+            (UnitPtr->alliance != Unit::Alliance::Self && UnitPtr->alliance != Unit::Alliance::Enemy))
+        {
+            continue;
+        }
+
+        FUnitKernelRecord RecordValue;
+        if (!TryBuildUnitKernel(*UnitPtr, UnitTypesValue, RecordValue.Kernel))
+        {
+            continue;
+        }
+
+        RecordValue.UnitTag = UnitPtr->tag;
+        RecordValue.bEnemy = UnitPtr->alliance == Unit::Alliance::Enemy;
+        DesiredKernels.push_back(RecordValue);
+    }
+
+    std::sort(DesiredKernels.begin(), DesiredKernels.end(),
+              [](const FUnitKernelRecord& LeftValue, const FUnitKernelRecord& RightValue)
+              {
+                  return LeftValue.UnitTag < RightValue.UnitTag;
+              });
+}
+
+void FTerranSpatialFieldBuilder::RebuildAll(FSpatialFieldSet& SpatialFieldSetValue) const
+{
+    if (SpatialFieldSetValue.Width != Width || SpatialFieldSetValue.Height != Height ||
+        !SpatialFieldSetValue.IsValid())
+    {
+        SpatialFieldSetValue.Resize(Width, Height);
+    }
+    else
+    {
+        std::fill(SpatialFieldSetValue.EnemyGroundThreat.begin(), SpatialFieldSetValue.EnemyGroundThreat.end(), 0.0f);
+        std::fill(SpatialFieldSetValue.FriendlyGroundInfluence.begin(),
+                  SpatialFieldSetValue.FriendlyGroundInfluence.end(), 0.0f);
+    }
+
+    DirtyRowMinColumns.assign(Height, std::numeric_limits<int32_t>::max());
+    DirtyRowMaxColumns.assign(Height, -1);
+    for (const FUnitKernelRecord& RecordValue : DesiredKernels)
+    {
+        SplatKernel(RecordValue, 1.0f, SpatialFieldSetValue);
+    }
+
+    // Every tile is rederived, so the spans marked by the splats above are discarded.
+    std::fill(DirtyRowMinColumns.begin(), DirtyRowMinColumns.end(), std::numeric_limits<int32_t>::max());
+    std::fill(DirtyRowMaxColumns.begin(), DirtyRowMaxColumns.end(), -1);
+    const size_t TileCountValue = static_cast<size_t>(Width) * static_cast<size_t>(Height);
+    DeriveFieldRange(SpatialFieldSetValue.EnemyGroundThreat.data(),
+                     SpatialFieldSetValue.FriendlyGroundInfluence.data(), SpatialFieldSetValue.RetreatSafety.data(),
+                     SpatialFieldSetValue.EngageOpportunity.data(), 0U, TileCountValue);
+
+    AppliedKernels.swap(DesiredKernels);
+    DesiredKernels.clear();
+    bNeedsFullRebuild = false;
+    UpdatesSinceFullRebuild = 0U;
+    UpdateCursor = 0U;
+    bLastUpdateFullRebuild = true;
+    LastKernelUpdateCount = static_cast<uint32_t>(AppliedKernels.size());
+    LastDerivedTileCount = TileCountValue;
+}
+
+void FTerranSpatialFieldBuilder::ApplyIncrementalUpdates(FSpatialFieldSet& SpatialFieldSetValue) const
+{
+    // Merge the two tag-sorted lists into one entry per tag, remembering which entries need their splat changed.
+    PendingUpdates.clear();
+    size_t ChangedCountValue = 0U;
+    size_t AppliedIndexValue = 0U;
+    size_t DesiredIndexValue = 0U;
+    while (AppliedIndexValue < AppliedKernels.size() || DesiredIndexValue < DesiredKernels.size())
+    {
+        FKernelUpdate UpdateValue;
+        if (DesiredIndexValue >= DesiredKernels.size() ||
+            (AppliedIndexValue < AppliedKernels.size() &&
+             AppliedKernels[AppliedIndexValue].UnitTag < DesiredKernels[DesiredIndexValue].UnitTag))
+        {
+            UpdateValue.AppliedIndex = static_cast<int32_t>(AppliedIndexValue++);
+            UpdateValue.bChanged = true;
+        }
+        else if (AppliedIndexValue >= AppliedKernels.size() ||
+                 DesiredKernels[DesiredIndexValue].UnitTag < AppliedKernels[AppliedIndexValue].UnitTag)
+        {
+            UpdateValue.DesiredIndex = static_cast<int32_t>(DesiredIndexValue++);
+            UpdateValue.bChanged = true;
+        }
+        else
+        {
+            const FUnitKernelRecord& AppliedRecordValue = AppliedKernels[AppliedIndexValue];
+            const FUnitKernelRecord& DesiredRecordValue = DesiredKernels[DesiredIndexValue];
+            UpdateValue.AppliedIndex = static_cast<int32_t>(AppliedIndexValue++);
+            UpdateValue.DesiredIndex = static_cast<int32_t>(DesiredIndexValue++);
+            UpdateValue.bChanged = AppliedRecordValue.bEnemy != DesiredRecordValue.bEnemy ||
+                                   HasKernelChanged(AppliedRecordValue.Kernel, DesiredRecordValue.Kernel);
+        }
+
+        ChangedCountValue += UpdateValue.bChanged ? 1U : 0U;
+        PendingUpdates.push_back(UpdateValue);
+    }
+
+    // Over budget, start from a cursor that advances each step so the same units are not deferred every time.
+    const size_t BudgetValue = std::min<size_t>(ChangedCountValue, MaxKernelUpdatesPerStep);
+    const size_t FirstChangedValue = ChangedCountValue > 0U ? UpdateCursor % ChangedCountValue : 0U;
+    const size_t LastChangedValue = FirstChangedValue + BudgetValue;
+    size_t ChangedOrdinalValue = 0U;
+    for (FKernelUpdate& UpdateValue : PendingUpdates)
+    {
+        if (!UpdateValue.bChanged)
+        {
+            continue;
+        }
+
+        const size_t OrdinalValue = ChangedOrdinalValue++;
+        UpdateValue.bApply = (OrdinalValue >= FirstChangedValue && OrdinalValue < LastChangedValue) ||
+                             OrdinalValue + ChangedCountValue < LastChangedValue;
+        if (!UpdateValue.bApply)
+        {
+            continue;
+        }
+
+        if (UpdateValue.AppliedIndex >= 0)
+        {
+            SplatKernel(AppliedKernels[static_cast<size_t>(UpdateValue.AppliedIndex)], -1.0f, SpatialFieldSetValue);
+        }
+        if (UpdateValue.DesiredIndex >= 0)
+        {
+            SplatKernel(DesiredKernels[static_cast<size_t>(UpdateValue.DesiredIndex)], 1.0f, SpatialFieldSetValue);
+        }
+    }
+
+    NextAppliedKernels.clear();
+    for (const FKernelUpdate& UpdateValue : PendingUpdates)
+    {
+        if (UpdateValue.bApply)
+        {
+            if (UpdateValue.DesiredIndex >= 0)
+            {
+                NextAppliedKernels.push_back(DesiredKernels[static_cast<size_t>(UpdateValue.DesiredIndex)]);
+            }
+        }
+        else if (UpdateValue.AppliedIndex >= 0)
+        {
+            NextAppliedKernels.push_back(AppliedKernels[static_cast<size_t>(UpdateValue.AppliedIndex)]);
+        }
+    }
+    AppliedKernels.swap(NextAppliedKernels);
+
+    UpdateCursor = static_cast<uint32_t>(LastChangedValue);
+    LastKernelUpdateCount = static_cast<uint32_t>(BudgetValue);
+    LastDeferredKernelCount = static_cast<uint32_t>(ChangedCountValue - BudgetValue);
+    RederiveDirtyRows(SpatialFieldSetValue);
+}
+
+void FTerranSpatialFieldBuilder::SplatKernel(const FUnitKernelRecord& RecordValue, const float SignValue,
+                                             FSpatialFieldSet& SpatialFieldSetValue) const
+{
+    const FSpatialFieldKernel& KernelValue = RecordValue.Kernel;
+    const float OuterRadiusValue = KernelValue.OuterRadius;
+    const float OuterSquaredValue = OuterRadiusValue * OuterRadiusValue;
+    const float CoreSquaredValue = KernelValue.CoreRadius * KernelValue.CoreRadius;
+    if (OuterRadiusValue <= 0.0f || OuterSquaredValue <= CoreSquaredValue)
+    {
+        return;
+    }
+
+    const float InverseSpanValue = 1.0f / (OuterSquaredValue - CoreSquaredValue);
+    const float ScaleValue = SignValue * KernelValue.Weight;
+    std::vector<float>& FieldValues =
+        RecordValue.bEnemy ? SpatialFieldSetValue.EnemyGroundThreat : SpatialFieldSetValue.FriendlyGroundInfluence;
+
+    const int32_t MaxRowValue = static_cast<int32_t>(Height) - 1;
+    const int32_t MaxColumnValue = static_cast<int32_t>(Width) - 1;
+    const int32_t FirstRowValue =
+        std::max(static_cast<int32_t>(std::floor(KernelValue.CenterY - OuterRadiusValue)), 0);
+    const int32_t LastRowValue =
+        std::min(static_cast<int32_t>(std::floor(KernelValue.CenterY + OuterRadiusValue)), MaxRowValue);
+    for (int32_t RowValue = FirstRowValue; RowValue <= LastRowValue; ++RowValue)
+    {
+        const float DeltaYValue = static_cast<float>(RowValue) + 0.5f - KernelValue.CenterY;
+        const float DeltaYSquaredValue = DeltaYValue * DeltaYValue;
+        if (DeltaYSquaredValue >= OuterSquaredValue)
+        {
+            continue;
+        }
+
+        const float HalfSpanValue = std::sqrt(OuterSquaredValue - DeltaYSquaredValue);
+        const int32_t FirstColumnValue =
+            std::max(static_cast<int32_t>(std::floor(KernelValue.CenterX - HalfSpanValue)), 0);
+        const int32_t LastColumnValue =
+            std::min(static_cast<int32_t>(std::floor(KernelValue.CenterX + HalfSpanValue)), MaxColumnValue);
+        if (FirstColumnValue > LastColumnValue)
+        {
+            continue;
+        }
+
+        float* RowValues = FieldValues.data() + static_cast<size_t>(RowValue) * Width;
+        SplatKernelRow(RowValues, FirstColumnValue, LastColumnValue, KernelValue.CenterX, DeltaYSquaredValue,
+                       OuterSquaredValue, InverseSpanValue, ScaleValue);
+        MarkDirtySpan(RowValue, FirstColumnValue, LastColumnValue);
+    }
+}
+
+void FTerranSpatialFieldBuilder::MarkDirtySpan(const int32_t RowValue, const int32_t MinColumnValue,
+                                               const int32_t MaxColumnValue) const
+{
+    const size_t RowIndexValue = static_cast<size_t>(RowValue);
+    DirtyRowMinColumns[RowIndexValue] = std::min(DirtyRowMinColumns[RowIndexValue], MinColumnValue);
+    DirtyRowMaxColumns[RowIndexValue] = std::max(DirtyRowMaxColumns[RowIndexValue], MaxColumnValue);
+}
+
+void FTerranSpatialFieldBuilder::RederiveDirtyRows(FSpatialFieldSet& SpatialFieldSetValue) const
+{
+    for (uint32_t RowValue = 0U; RowValue < Height; ++RowValue)
+    {
+        const int32_t MinColumnValue = DirtyRowMinColumns[RowValue];
+        const int32_t MaxColumnValue = DirtyRowMaxColumns[RowValue];
+        if (MaxColumnValue < MinColumnValue)
+        {
+            continue;
+        }
+
+        const size_t RowOffsetValue = static_cast<size_t>(RowValue) * Width;
+        DeriveFieldRange(SpatialFieldSetValue.EnemyGroundThreat.data(),
+                         SpatialFieldSetValue.FriendlyGroundInfluence.data(),
+                         SpatialFieldSetValue.RetreatSafety.data(), SpatialFieldSetValue.EngageOpportunity.data(),
+                         RowOffsetValue + static_cast<size_t>(MinColumnValue),
+                         RowOffsetValue + static_cast<size_t>(MaxColumnValue) + 1U);
+        LastDerivedTileCount += static_cast<uint64_t>(MaxColumnValue - MinColumnValue + 1);
+        DirtyRowMinColumns[RowValue] = std::numeric_limits<int32_t>::max();
+        DirtyRowMaxColumns[RowValue] = -1;
+    }
+}
+
+}  // namespace sc2
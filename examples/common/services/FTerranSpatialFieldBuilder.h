@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/services/FSpatialFieldKernel.h"
+#include "common/services/ISpatialFieldBuilder.h"
+#include "sc2api/sc2_data.h"
+#include "sc2api/sc2_unit.h"
+
+namespace sc2
+{
+
+// Influence-map builder for FSpatialFieldSet. EnemyGroundThreat and FriendlyGroundInfluence are sums of per-unit
+// ground-weapon DPS kernels; RetreatSafety and EngageOpportunity are derived per tile from those two fields.
+// Between full rebuilds only units that appeared, died, moved or changed weapons are re-splatted, and only the
+// tiles under their old and new kernels are rederived.
+class FTerranSpatialFieldBuilder final : public ISpatialFieldBuilder
+{
+public:
+    static constexpr uint32_t DefaultMaxKernelUpdatesPerStepValue = 256U;
+    static constexpr uint32_t DefaultFullRebuildIntervalValue = 224U;
+
+    FTerranSpatialFieldBuilder();
+    ~FTerranSpatialFieldBuilder() override = default;
+
+    void RebuildSpatialFieldSet(const FFrameContext& FrameContextValue,
+                                FSpatialFieldSet& SpatialFieldSetValue) const override;
+
+    // Same update as RebuildSpatialFieldSet without an ObservationInterface.
+    void UpdateSpatialFieldSet(const Units& UnitsValue, const UnitTypes& UnitTypesValue, uint32_t WidthValue,
+                               uint32_t HeightValue, FSpatialFieldSet& SpatialFieldSetValue) const;
+
+    // Work budget: at most this many kernel removals, moves or additions are applied per incremental update.
+    // Units over budget keep their previous splat and are picked up first on the next update.
+    void SetMaxKernelUpdatesPerStep(uint32_t MaxKernelUpdatesPerStepValue);
+    // Number of incremental updates between full rebuilds, which bound float drift; 0 disables periodic rebuilds.
+    void SetFullRebuildInterval(uint32_t FullRebuildIntervalValue);
+    // Forces the next update to rebuild every field from scratch.
+    void Invalidate();
+
+    bool WasLastUpdateFullRebuild() const;
+    uint32_t GetLastKernelUpdateCount() const;
+    uint32_t GetLastDeferredKernelCount() const;
+    uint64_t GetLastDerivedTileCount() const;
+
+private:
+    struct FUnitKernelRecord
+    {
+        Tag UnitTag = NullTag;
+        bool bEnemy = false;
+        FSpatialFieldKernel Kernel;
+    };
+
+    struct FKernelUpdate
+    {
+        int32_t AppliedIndex = -1;
+        int32_t DesiredIndex = -1;
+        bool bChanged = false;
+        bool bApply = false;
+    };
+
+    void CollectDesiredKernels(const Units& UnitsValue, const UnitTypes& UnitTypesValue) const;
+    void RebuildAll(FSpatialFieldSet& SpatialFieldSetValue) const;
+    void ApplyIncrementalUpdates(FSpatialFieldSet& SpatialFieldSetValue) const;
+    void SplatKernel(const FUnitKernelRecord& RecordValue, float SignValue,
+                     FSpatialFieldSet& SpatialFieldSetValue) const;
+    void MarkDirtySpan(int32_t RowValue, int32_t MinColumnValue, int32_t MaxColumnValue) const;
+    void RederiveDirtyRows(FSpatialFieldSet& SpatialFieldSetValue) const;
+
+    uint32_t MaxKernelUpdatesPerStep;
+    uint32_t FullRebuildInterval;
+
+    mutable uint32_t Width;
+    mutable uint32_t Height;
+    mutable bool bNeedsFullRebuild;
+    mutable uint32_t UpdatesSinceFullRebuild;
+    mutable uint32_t UpdateCursor;
+
+    // Both sorted by tag. Applied holds exactly what is currently splatted into the fields.
+    mutable std::vector<FUnitKernelRecord> AppliedKernels;
+    mutable std::vector<FUnitKernelRecord> DesiredKernels;
+    mutable std::vector<FKernelUpdate> PendingUpdates;
+    mutable std::vector<FUnitKernelRecord> NextAppliedKernels;
+    mutable std::vector<int32_t> DirtyRowMinColumns;
+    mutable std::vector<int32_t> DirtyRowMaxColumns;
+
+    mutable bool bLastUpdateFullRebuild;
+    mutable uint32_t LastKernelUpdateCount;
+    mutable uint32_t LastDeferredKernelCount;
+    mutable uint64_t LastDerivedTileCount;
+};
+
+}  // namespace sc2
@@ -146,8 +146,9 @@ bool HasActiveSchedulerOrderForActorTag(const FCommandAuthoritySchedulingState&
     const size_t OrderCountValue = CommandAuthoritySchedulingStateValue.OrderIds.size();
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue] != ActorTagValue ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag != ActorTagValue ||
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
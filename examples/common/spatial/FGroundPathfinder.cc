@@ -0,0 +1,950 @@
+#include "common/spatial/FGroundPathfinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+#include "sc2api/sc2_map_info.h"
+
+namespace sc2
+{
+namespace
+{
+
+constexpr float UnreachableDistanceValue = std::numeric_limits<float>::max();
+constexpr float DiagonalStepCostValue = 1.41421356f;
+// Every run of open border cells gets a transition at each end; runs at least this long also get one in the middle.
+constexpr int32_t LongBorderRunLengthValue = 8;
+
+constexpr int32_t StepOffsetsValue[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+
+// Inclusive cell bounds a search may not leave.
+struct FCellBounds
+{
+    int32_t MinX = 0;
+    int32_t MinY = 0;
+    int32_t MaxX = -1;
+    int32_t MaxY = -1;
+
+    bool Contains(const int32_t XValue, const int32_t YValue) const
+    {
+        return XValue >= MinX && YValue >= MinY && XValue <= MaxX && YValue <= MaxY;
+    }
+};
+
+float GetOctileDistance(const int32_t DeltaXValue, const int32_t DeltaYValue)
+{
+    const int32_t AbsoluteXValue = std::abs(DeltaXValue);
+    const int32_t AbsoluteYValue = std::abs(DeltaYValue);
+    const int32_t DiagonalStepCountValue = std::min(AbsoluteXValue, AbsoluteYValue);
+    const int32_t StraightStepCountValue = std::max(AbsoluteXValue, AbsoluteYValue) - DiagonalStepCountValue;
+    return static_cast<float>(DiagonalStepCountValue) * DiagonalStepCostValue +
+           static_cast<float>(StraightStepCountValue);
+}
+
+// Dijkstra from one cell inside the bounds. Cells outside the bounds are left untouched in DistancesValue, so the
+// caller resets only what it searched.
+template <typename TWalkable>
+void RunBoundedSearch(const int32_t WidthValue, const FCellBounds& BoundsValue, const int32_t SourceCellValue,
+                      const TWalkable& IsWalkableValue, std::vector<float>& DistancesValue)
+{
+    using FQueueEntry = std::pair<float, int32_t>;
+    std::priority_queue<FQueueEntry, std::vector<FQueueEntry>, std::greater<FQueueEntry>> PendingCellsValue;
+    DistancesValue[static_cast<size_t>(SourceCellValue)] = 0.0f;
+    PendingCellsValue.emplace(0.0f, SourceCellValue);
+    while (!PendingCellsValue.empty())
+    {
+        const FQueueEntry EntryValue = PendingCellsValue.top();
+        PendingCellsValue.pop();
+        if (EntryValue.first > DistancesValue[static_cast<size_t>(EntryValue.second)])
+        {
+            continue;
+        }
+
+        const int32_t XValue = EntryValue.second % WidthValue;
+        const int32_t YValue = EntryValue.second / WidthValue;
+        for (const auto& StepOffsetValue : StepOffsetsValue)
+        {
+            const int32_t NeighborXValue = XValue + StepOffsetValue[0];
+            const int32_t NeighborYValue = YValue + StepOffsetValue[1];
+            if (!BoundsValue.Contains(NeighborXValue, NeighborYValue) ||
+                !IsWalkableValue(NeighborXValue, NeighborYValue))
+            {
+                continue;
+            }
+
+            const bool bDiagonalValue = StepOffsetValue[0] != 0 && StepOffsetValue[1] != 0;
+            if (bDiagonalValue &&
+                (!IsWalkableValue(NeighborXValue, YValue) || !IsWalkableValue(XValue, NeighborYValue)))
+            {
+                continue;
+            }
+
+            const float CandidateDistanceValue = EntryValue.first + (bDiagonalValue ? DiagonalStepCostValue : 1.0f);
+            const int32_t NeighborCellValue = NeighborXValue + NeighborYValue * WidthValue;
+            if (CandidateDistanceValue < DistancesValue[static_cast<size_t>(NeighborCellValue)])
+            {
+                DistancesValue[static_cast<size_t>(NeighborCellValue)] = CandidateDistanceValue;
+                PendingCellsValue.emplace(CandidateDistanceValue, NeighborCellValue);
+            }
+        }
+    }
+}
+
+int32_t FindNodeIndex(const std::vector<int32_t>& NodeCellsValue, const int32_t CellValue)
+{
+    const auto NodeIteratorValue = std::find(NodeCellsValue.begin(), NodeCellsValue.end(), CellValue);
+    return NodeIteratorValue == NodeCellsValue.end() ? -1
+                                                     : static_cast<int32_t>(NodeIteratorValue - NodeCellsValue.begin());
+}
+
+}  // namespace
+
+FGroundPathfinder::FGroundPathfinder()
+    : Width(0),
+      Height(0),
+      ClusterCountX(0),
+      ClusterCountY(0),
+      StructureUpdateIndex(0U),
+      bAbstractGraphDirty(false),
+      FlowFieldUseCounter(0U),
+      FlowFieldBuildsSinceUpdate(0U),
+      bQueryVerificationEnabled(false),
+      VerifiedQueryCount(0U),
+      VerificationMismatchCount(0U),
+      ClusterRebuildCount(0U),
+      FlowFieldBuildCount(0U)
+{
+}
+
+void FGroundPathfinder::Reset()
+{
+    Width = 0;
+    Height = 0;
+    ClusterCountX = 0;
+    ClusterCountY = 0;
+    StaticPathableCells.clear();
+    StructureCoverCounts.clear();
+    StructureFootprints.clear();
+    StructureUpdateIndex = 0U;
+    HorizontalBorders.clear();
+    VerticalBorders.clear();
+    Clusters.clear();
+    bAbstractGraphDirty = false;
+    FlowFields.clear();
+    FlowFieldUseCounter = 0U;
+    FlowFieldBuildsSinceUpdate = 0U;
+    DistanceScratch.clear();
+    VerifiedQueryCount = 0U;
+    VerificationMismatchCount = 0U;
+    ClusterRebuildCount = 0U;
+    FlowFieldBuildCount = 0U;
+}
+
+void FGroundPathfinder::Initialize(const MapGrids& MapGridsValue)
+{
+    Reset();
+
+    const BitGrid& PathingGridValue = MapGridsValue.Pathing();
+    Width = PathingGridValue.Width();
+    Height = PathingGridValue.Height();
+    if (Width <= 0 || Height <= 0)
+    {
+        Width = 0;
+        Height = 0;
+        return;
+    }
+
+    const size_t CellCountValue = static_cast<size_t>(Width) * static_cast<size_t>(Height);
+    StaticPathableCells.resize(CellCountValue);
+    for (int32_t YValue = 0; YValue < Height; ++YValue)
+    {
+        for (int32_t XValue = 0; XValue < Width; ++XValue)
+        {
+            StaticPathableCells[static_cast<size_t>(XValue + YValue * Width)] =
+                MapGridsValue.IsPathable(Point2DI(XValue, YValue)) ? 1U : 0U;
+        }
+    }
+    StructureCoverCounts.assign(CellCountValue, 0U);
+    DistanceScratch.assign(CellCountValue, UnreachableDistanceValue);
+
+    ClusterCountX = (Width + ClusterSizeValue - 1) / ClusterSizeValue;
+    ClusterCountY = (Height + ClusterSizeValue - 1) / ClusterSizeValue;
+    HorizontalBorders.assign(static_cast<size_t>(ClusterCountX * ClusterCountY), {});
+    VerticalBorders.assign(static_cast<size_t>(ClusterCountX * ClusterCountY), {});
+    Clusters.assign(static_cast<size_t>(ClusterCountX * ClusterCountY), FCluster());
+    bAbstractGraphDirty = true;
+}
+
+bool FGroundPathfinder::IsReady() const
+{
+    return Width > 0 && Height > 0;
+}
+
+void FGroundPathfinder::UpdateStructures(const Units& UnitsValue)
+{
+    if (!IsReady())
+    {
+        return;
+    }
+
+    ++StructureUpdateIndex;
+    FlowFieldBuildsSinceUpdate = 0U;
+    for (const Unit* UnitPtrValue : UnitsValue)
+    {
+        if (UnitPtrValue == nullptr || !UnitPtrValue->is_building || UnitPtrValue->is_flying ||
+            UnitPtrValue->alliance == Unit::Alliance::Neutral ||
+            UnitPtrValue->unit_type == UNIT_TYPEID::TERRAN_SUPPLYDEPOTLOWERED)
+        {
+            continue;
+        }
+
+        // Structure footprints are whole tiles; the unit radius rounds down onto them (5x5 town hall, 2x2 depot).
+        const Unit& UnitValue = *UnitPtrValue;
+        const float HalfExtentValue = std::max(0.5f, std::floor(UnitValue.radius * 2.0f) * 0.5f);
+        FStructureFootprint FootprintValue;
+        FootprintValue.MinX = static_cast<int32_t>(std::floor(UnitValue.pos.x - HalfExtentValue + 0.5f));
+        FootprintValue.MinY = static_cast<int32_t>(std::floor(UnitValue.pos.y - HalfExtentValue + 0.5f));
+        FootprintValue.MaxX = static_cast<int32_t>(std::floor(UnitValue.pos.x + HalfExtentValue - 0.5f));
+        FootprintValue.MaxY = static_cast<int32_t>(std::floor(UnitValue.pos.y + HalfExtentValue - 0.5f));
+        FootprintValue.LastSeenUpdate = StructureUpdateIndex;
+
+        const auto FootprintIteratorValue = StructureFootprints.find(UnitValue.tag);
+        if (FootprintIteratorValue == StructureFootprints.end())
+        {
+            ApplyFootprint(FootprintValue, 1);
+            StructureFootprints.emplace(UnitValue.tag, FootprintValue);
+            continue;
+        }
+
+        FStructureFootprint& KnownFootprintValue = FootprintIteratorValue->second;
+        if (std::tie(KnownFootprintValue.MinX, KnownFootprintValue.MinY, KnownFootprintValue.MaxX,
+                     KnownFootprintValue.MaxY) !=
+            std::tie(FootprintValue.MinX, FootprintValue.MinY, FootprintValue.MaxX, FootprintValue.MaxY))
+        {
+            ApplyFootprint(KnownFootprintValue, -1);
+            ApplyFootprint(FootprintValue, 1);
+        }
+        KnownFootprintValue = FootprintValue;
+    }
+
+    auto FootprintIteratorValue = StructureFootprints.begin();
+    while (FootprintIteratorValue != StructureFootprints.end())
+    {
+        if (FootprintIteratorValue->second.LastSeenUpdate == StructureUpdateIndex)
+        {
+            ++FootprintIteratorValue;
+            continue;
+        }
+
+        ApplyFootprint(FootprintIteratorValue->second, -1);
+        FootprintIteratorValue = StructureFootprints.erase(FootprintIteratorValue);
+    }
+}
+
+float FGroundPathfinder::GetDistance(const Point2D& StartPointValue, const Point2D& EndPointValue,
+                                     const float StartRadiusValue)
+{
+    int32_t StartCellValue = 0;
+    int32_t EndCellValue = 0;
+    if (!TryGetCell(StartPointValue, StartRadiusValue, StartCellValue) ||
+        !TryGetCell(EndPointValue, 0.0f, EndCellValue))
+    {
+        return 0.0f;
+    }
+    if (StartCellValue == EndCellValue)
+    {
+        return Distance2D(StartPointValue, EndPointValue);
+    }
+
+    RefreshAbstractGraph();
+    return FindAbstractDistance(StartCellValue, EndCellValue);
+}
+
+void FGroundPathfinder::GetDistances(const std::vector<QueryInterface::PathingQuery>& QueriesValue,
+                                     std::vector<float>& OutDistancesValue)
+{
+    GetDistances(QueriesValue, std::vector<float>(), OutDistancesValue);
+}
+
+void FGroundPathfinder::GetDistances(const std::vector<QueryInterface::PathingQuery>& QueriesValue,
+                                     const std::vector<float>& StartRadiiValue, std::vector<float>& OutDistancesValue)
+{
+    OutDistancesValue.assign(QueriesValue.size(), 0.0f);
+    if (!IsReady())
+    {
+        return;
+    }
+
+    std::unordered_map<int32_t, size_t> QueryCountsByEndCellValue;
+    std::vector<int32_t> EndCellsValue(QueriesValue.size(), -1);
+    for (size_t QueryIndexValue = 0U; QueryIndexValue < QueriesValue.size(); ++QueryIndexValue)
+    {
+        if (TryGetCell(QueriesValue[QueryIndexValue].end_, 0.0f, EndCellsValue[QueryIndexValue]))
+        {
+            ++QueryCountsByEndCellValue[EndCellsValue[QueryIndexValue]];
+        }
+    }
+
+    for (size_t QueryIndexValue = 0U; QueryIndexValue < QueriesValue.size(); ++QueryIndexValue)
+    {
+        const QueryInterface::PathingQuery& QueryValue = QueriesValue[QueryIndexValue];
+        const int32_t EndCellValue = EndCellsValue[QueryIndexValue];
+        const float StartRadiusValue =
+            QueryIndexValue < StartRadiiValue.size() ? StartRadiiValue[QueryIndexValue] : 0.0f;
+        int32_t StartCellValue = 0;
+        if (EndCellValue < 0 || !TryGetCell(QueryValue.start_, StartRadiusValue, StartCellValue))
+        {
+            continue;
+        }
+
+        if (StartCellValue == EndCellValue || (!HasCurrentFlowField(EndCellValue) &&
+                                               QueryCountsByEndCellValue[EndCellValue] < FlowFieldBatchThresholdValue))
+        {
+            OutDistancesValue[QueryIndexValue] = GetDistance(QueryValue.start_, QueryValue.end_, StartRadiusValue);
+            continue;
+        }
+
+        const float DistanceValue = GetFlowField(EndCellValue).Distances[static_cast<size_t>(StartCellValue)];
+        OutDistancesValue[QueryIndexValue] = DistanceValue == UnreachableDistanceValue ? 0.0f : DistanceValue;
+    }
+}
+
+float FGroundPathfinder::GetFlowFieldDistance(const Point2D& DestinationPointValue, const Point2D& StartPointValue,
+                                              const float StartRadiusValue)
+{
+    int32_t DestinationCellValue = 0;
+    int32_t StartCellValue = 0;
+    if (!TryGetCell(DestinationPointValue, 0.0f, DestinationCellValue) ||
+        !TryGetCell(StartPointValue, StartRadiusValue, StartCellValue))
+    {
+        return 0.0f;
+    }
+
+    const float DistanceValue = GetFlowField(DestinationCellValue).Distances[static_cast<size_t>(StartCellValue)];
+    return DistanceValue == UnreachableDistanceValue ? 0.0f : DistanceValue;
+}
+
+bool FGroundPathfinder::TryGetFlowFieldDistance(const Point2D& DestinationPointValue, const Point2D& StartPointValue,
+                                                float& OutDistanceValue, const float StartRadiusValue)
+{
+    int32_t DestinationCellValue = 0;
+    int32_t StartCellValue = 0;
+    if (!TryGetCell(DestinationPointValue, 0.0f, DestinationCellValue) ||
+        !TryGetCell(StartPointValue, StartRadiusValue, StartCellValue))
+    {
+        return false;
+    }
+    if (!HasCurrentFlowField(DestinationCellValue) && FlowFieldBuildsSinceUpdate >= MaxFlowFieldBuildsPerUpdateValue)
+    {
+        return false;
+    }
+
+    OutDistanceValue = GetFlowField(DestinationCellValue).Distances[static_cast<size_t>(StartCellValue)];
+    return true;
+}
+
+bool FGroundPathfinder::TryGetFlowFieldStep(const Point2D& DestinationPointValue, const Point2D& StartPointValue,
+                                            Point2D& OutNextPointValue, const float StartRadiusValue)
+{
+    int32_t DestinationCellValue = 0;
+    int32_t StartCellValue = 0;
+    if (!TryGetCell(DestinationPointValue, 0.0f, DestinationCellValue) ||
+        !TryGetCell(StartPointValue, StartRadiusValue, StartCellValue))
+    {
+        return false;
+    }
+
+    const std::vector<float>& DistancesValue = GetFlowField(DestinationCellValue).Distances;
+    float BestDistanceValue = DistancesValue[static_cast<size_t>(StartCellValue)];
+    if (BestDistanceValue == UnreachableDistanceValue)
+    {
+        return false;
+    }
+    if (StartCellValue == DestinationCellValue)
+    {
+        OutNextPointValue = DestinationPointValue;
+        return true;
+    }
+
+    const int32_t XValue = StartCellValue % Width;
+    const int32_t YValue = StartCellValue / Width;
+    int32_t BestCellValue = -1;
+    for (const auto& StepOffsetValue : StepOffsetsValue)
+    {
+        const int32_t NeighborXValue = XValue + StepOffsetValue[0];
+        const int32_t NeighborYValue = YValue + StepOffsetValue[1];
+        const bool bDiagonalValue = StepOffsetValue[0] != 0 && StepOffsetValue[1] != 0;
+        if (!IsWalkable(NeighborXValue, NeighborYValue) ||
+            (bDiagonalValue && (!IsWalkable(NeighborXValue, YValue) || !IsWalkable(XValue, NeighborYValue))))
+        {
+            continue;
+        }
+
+        const int32_t NeighborCellValue = NeighborXValue + NeighborYValue * Width;
+        if (DistancesValue[static_cast<size_t>(NeighborCellValue)] < BestDistanceValue)
+        {
+            BestDistanceValue = DistancesValue[static_cast<size_t>(NeighborCellValue)];
+            BestCellValue = NeighborCellValue;
+        }
+    }
+    if (BestCellValue < 0)
+    {
+        return false;
+    }
+
+    OutNextPointValue = Point2D(static_cast<float>(BestCellValue % Width) + 0.5f,
+                                static_cast<float>(BestCellValue / Width) + 0.5f);
+    return true;
+}
+
+bool FGroundPathfinder::IsWalkable(const int32_t XValue, const int32_t YValue) const
+{
+    if (XValue < 0 || YValue < 0 || XValue >= Width || YValue >= Height)
+    {
+        return false;
+    }
+
+    const size_t CellIndexValue = static_cast<size_t>(XValue + YValue * Width);
+    return StaticPathableCells[CellIndexValue] != 0U && StructureCoverCounts[CellIndexValue] == 0U;
+}
+
+void FGroundPathfinder::SetQueryVerificationEnabled(const bool bEnabledValue)
+{
+    bQueryVerificationEnabled = bEnabledValue;
+}
+
+bool FGroundPathfinder::IsQueryVerificationEnabled() const
+{
+    return bQueryVerificationEnabled;
+}
+
+void FGroundPathfinder::RecordVerificationResult(const float LocalDistanceValue, const float ServerDistanceValue)
+{
+    ++VerifiedQueryCount;
+    if ((LocalDistanceValue > 0.0f) != (ServerDistanceValue > 0.0f))
+    {
+        ++VerificationMismatchCount;
+    }
+}
+
+uint32_t FGroundPathfinder::GetVerifiedQueryCount() const
+{
+    return VerifiedQueryCount;
+}
+
+uint32_t FGroundPathfinder::GetVerificationMismatchCount() const
+{
+    return VerificationMismatchCount;
+}
+
+uint32_t FGroundPathfinder::GetClusterRebuildCount() const
+{
+    return ClusterRebuildCount;
+}
+
+uint32_t FGroundPathfinder::GetFlowFieldBuildCount() const
+{
+    return FlowFieldBuildCount;
+}
+
+int32_t FGroundPathfinder::GetClusterIndex(const int32_t CellIndexValue) const
+{
+    const int32_t ClusterXValue = (CellIndexValue % Width) / ClusterSizeValue;
+    const int32_t ClusterYValue = (CellIndexValue / Width) / ClusterSizeValue;
+    return ClusterXValue + ClusterYValue * ClusterCountX;
+}
+
+bool FGroundPathfinder::TryGetCell(const Point2D& PointValue, const float SnapRadiusValue,
+                                   int32_t& OutCellIndexValue) const
+{
+    if (!IsReady() || !std::isfinite(PointValue.x) || !std::isfinite(PointValue.y))
+    {
+        return false;
+    }
+
+    const int32_t CenterXValue = static_cast<int32_t>(std::floor(PointValue.x));
+    const int32_t CenterYValue = static_cast<int32_t>(std::floor(PointValue.y));
+    if (IsWalkable(CenterXValue, CenterYValue))
+    {
+        OutCellIndexValue = CenterXValue + CenterYValue * Width;
+        return true;
+    }
+    if (!(SnapRadiusValue > 0.0f))
+    {
+        return false;
+    }
+
+    const float SnapRadiusSquaredValue = SnapRadiusValue * SnapRadiusValue;
+    const int32_t MinXValue = static_cast<int32_t>(std::floor(PointValue.x - SnapRadiusValue));
+    const int32_t MinYValue = static_cast<int32_t>(std::floor(PointValue.y - SnapRadiusValue));
+    const int32_t MaxXValue = static_cast<int32_t>(std::floor(PointValue.x + SnapRadiusValue));
+    const int32_t MaxYValue = static_cast<int32_t>(std::floor(PointValue.y + SnapRadiusValue));
+    float BestDistanceSquaredValue = std::numeric_limits<float>::max();
+    bool bFoundValue = false;
+    for (int32_t YValue = MinYValue; YValue <= MaxYValue; ++YValue)
+    {
+        for (int32_t XValue = MinXValue; XValue <= MaxXValue; ++XValue)
+        {
+            if (!IsWalkable(XValue, YValue))
+            {
+                continue;
+            }
+
+            // Closest point of the cell to the unit center; the footprint overlaps the cell when it lies inside.
+            const Point2D ClosestPointValue(
+                std::min(std::max(PointValue.x, static_cast<float>(XValue)), static_cast<float>(XValue + 1)),
+                std::min(std::max(PointValue.y, static_cast<float>(YValue)), static_cast<float>(YValue + 1)));
+            if (DistanceSquared2D(PointValue, ClosestPointValue) > SnapRadiusSquaredValue)
+            {
+                continue;
+            }
+
+            const float DistanceSquaredValue = DistanceSquared2D(
+                PointValue, Point2D(static_cast<float>(XValue) + 0.5f, static_cast<float>(YValue) + 0.5f));
+            if (DistanceSquaredValue < BestDistanceSquaredValue)
+            {
+                BestDistanceSquaredValue = DistanceSquaredValue;
+                OutCellIndexValue = XValue + YValue * Width;
+                bFoundValue = true;
+            }
+        }
+    }
+    return bFoundValue;
+}
+
+void FGroundPathfinder::ApplyFootprint(const FStructureFootprint& FootprintValue, const int32_t DeltaValue)
+{
+    const int32_t MinXValue = std::max(0, FootprintValue.MinX);
+    const int32_t MinYValue = std::max(0, FootprintValue.MinY);
+    const int32_t MaxXValue = std::min(Width - 1, FootprintValue.MaxX);
+    const int32_t MaxYValue = std::min(Height - 1, FootprintValue.MaxY);
+    if (MinXValue > MaxXValue || MinYValue > MaxYValue)
+    {
+        return;
+    }
+
+    // A footprint over another structure or over unpathable ground changes no walkability and invalidates nothing.
+    bool bWalkabilityChangedValue = false;
+    for (int32_t YValue = MinYValue; YValue <= MaxYValue; ++YValue)
+    {
+        for (int32_t XValue = MinXValue; XValue <= MaxXValue; ++XValue)
+        {
+            const size_t CellIndexValue = static_cast<size_t>(XValue + YValue * Width);
+            uint8_t& CoverCountValue = StructureCoverCounts[CellIndexValue];
+            const bool bWasCoveredValue = CoverCountValue != 0U;
+            CoverCountValue = static_cast<uint8_t>(static_cast<int32_t>(CoverCountValue) + DeltaValue);
+            bWalkabilityChangedValue = bWalkabilityChangedValue || (StaticPathableCells[CellIndexValue] != 0U &&
+                                                                    bWasCoveredValue != (CoverCountValue != 0U));
+        }
+    }
+    if (!bWalkabilityChangedValue)
+    {
+        return;
+    }
+
+    for (int32_t ClusterYValue = MinYValue / ClusterSizeValue; ClusterYValue <= MaxYValue / ClusterSizeValue;
+         ++ClusterYValue)
+    {
+        for (int32_t ClusterXValue = MinXValue / ClusterSizeValue; ClusterXValue <= MaxXValue / ClusterSizeValue;
+             ++ClusterXValue)
+        {
+            Clusters[static_cast<size_t>(ClusterXValue + ClusterYValue * ClusterCountX)].bDirty = true;
+        }
+    }
+    bAbstractGraphDirty = true;
+    for (FFlowField& FlowFieldValue : FlowFields)
+    {
+        FlowFieldValue.bStale = true;
+    }
+}
+
+void FGroundPathfinder::RefreshAbstractGraph()
+{
+    if (!bAbstractGraphDirty)
+    {
+        return;
+    }
+
+    // A dirty cluster changes the transitions on its four borders, which changes the nodes of its neighbors too.
+    const size_t ClusterCountValue = Clusters.size();
+    std::vector<uint8_t> NodeRebuildFlagsValue(ClusterCountValue, 0U);
+    for (int32_t ClusterYValue = 0; ClusterYValue < ClusterCountY; ++ClusterYValue)
+    {
+        for (int32_t ClusterXValue = 0; ClusterXValue < ClusterCountX; ++ClusterXValue)
+        {
+            const int32_t ClusterIndexValue = ClusterXValue + ClusterYValue * ClusterCountX;
+            if (!Clusters[static_cast<size_t>(ClusterIndexValue)].bDirty)
+            {
+                continue;
+            }
+
+            NodeRebuildFlagsValue[static_cast<size_t>(ClusterIndexValue)] = 1U;
+            if (ClusterXValue > 0)
+            {
+                BuildBorder(true, ClusterXValue - 1, ClusterYValue,
+                            HorizontalBorders[static_cast<size_t>(ClusterIndexValue - 1)]);
+                NodeRebuildFlagsValue[static_cast<size_t>(ClusterIndexValue - 1)] = 1U;
+            }
+            if (ClusterXValue + 1 < ClusterCountX)
+            {
+                BuildBorder(true, ClusterXValue, ClusterYValue,
+                            HorizontalBorders[static_cast<size_t>(ClusterIndexValue)]);
+                NodeRebuildFlagsValue[static_cast<size_t>(ClusterIndexValue + 1)] = 1U;
+            }
+            if (ClusterYValue > 0)
+            {
+                BuildBorder(false, ClusterXValue, ClusterYValue - 1,
+                            VerticalBorders[static_cast<size_t>(ClusterIndexValue - ClusterCountX)]);
+                NodeRebuildFlagsValue[static_cast<size_t>(ClusterIndexValue - ClusterCountX)] = 1U;
+            }
+            if (ClusterYValue + 1 < ClusterCountY)
+            {
+                BuildBorder(false, ClusterXValue, ClusterYValue,
+                            VerticalBorders[static_cast<size_t>(ClusterIndexValue)]);
+                NodeRebuildFlagsValue[static_cast<size_t>(ClusterIndexValue + ClusterCountX)] = 1U;
+            }
+        }
+    }
+
+    for (size_t ClusterIndexValue = 0U; ClusterIndexValue < ClusterCountValue; ++ClusterIndexValue)
+    {
+        if (NodeRebuildFlagsValue[ClusterIndexValue] != 0U)
+        {
+            BuildClusterNodes(static_cast<int32_t>(ClusterIndexValue));
+            Clusters[ClusterIndexValue].bDirty = false;
+            ++ClusterRebuildCount;
+        }
+    }
+    bAbstractGraphDirty = false;
+}
+
+void FGroundPathfinder::BuildBorder(const bool bHorizontalValue, const int32_t ClusterXValue,
+                                    const int32_t ClusterYValue, std::vector<FTransition>& OutTransitionsValue) const
+{
+    OutTransitionsValue.clear();
+
+    // Walk along the border; Along is the coordinate parallel to it and Across the fixed cell on each side.
+    const int32_t AlongStartValue = (bHorizontalValue ? ClusterYValue : ClusterXValue) * ClusterSizeValue;
+    const int32_t AlongEndValue =
+        std::min(AlongStartValue + ClusterSizeValue, bHorizontalValue ? Height : Width) - 1;
+    const int32_t AcrossValue = ((bHorizontalValue ? ClusterXValue : ClusterYValue) + 1) * ClusterSizeValue - 1;
+    const auto GetCell = [this, bHorizontalValue](const int32_t AlongValue, const int32_t AcrossCellValue)
+    { return bHorizontalValue ? AcrossCellValue + AlongValue * Width : AlongValue + AcrossCellValue * Width; };
+    const auto IsOpen = [this, bHorizontalValue, AcrossValue](const int32_t AlongValue)
+    {
+        return bHorizontalValue
+                   ? IsWalkable(AcrossValue, AlongValue) && IsWalkable(AcrossValue + 1, AlongValue)
+                   : IsWalkable(AlongValue, AcrossValue) && IsWalkable(AlongValue, AcrossValue + 1);
+    };
+    const auto AddTransition = [&](const int32_t AlongValue)
+    {
+        FTransition TransitionValue;
+        TransitionValue.CellA = GetCell(AlongValue, AcrossValue);
+        TransitionValue.CellB = GetCell(AlongValue, AcrossValue + 1);
+        OutTransitionsValue.push_back(TransitionValue);
+    };
+
+    for (int32_t AlongValue = AlongStartValue; AlongValue <= AlongEndValue;)
+    {
+        if (!IsOpen(AlongValue))
+        {
+            ++AlongValue;
+            continue;
+        }
+
+        const int32_t RunStartValue = AlongValue;
+        while (AlongValue <= AlongEndValue && IsOpen(AlongValue))
+        {
+            ++AlongValue;
+        }
+        const int32_t RunEndValue = AlongValue - 1;
+        AddTransition(RunStartValue);
+        if (RunEndValue - RunStartValue + 1 >= LongBorderRunLengthValue)
+        {
+            AddTransition((RunStartValue + RunEndValue) / 2);
+        }
+        if (RunEndValue != RunStartValue)
+        {
+            AddTransition(RunEndValue);
+        }
+    }
+}
+
+void FGroundPathfinder::BuildClusterNodes(const int32_t ClusterIndexValue)
+{
+    FCluster& ClusterValue = Clusters[static_cast<size_t>(ClusterIndexValue)];
+    ClusterValue.NodeCells.clear();
+    ClusterValue.NodePartnerCells.clear();
+    ClusterValue.IntraDistances.clear();
+
+    const auto AddNode = [&ClusterValue](const int32_t NodeCellValue, const int32_t PartnerCellValue)
+    {
+        int32_t NodeIndexValue = FindNodeIndex(ClusterValue.NodeCells, NodeCellValue);
+        if (NodeIndexValue < 0)
+        {
+            NodeIndexValue = static_cast<int32_t>(ClusterValue.NodeCells.size());
+            ClusterValue.NodeCells.push_back(NodeCellValue);
+            ClusterValue.NodePartnerCells.emplace_back();
+        }
+        ClusterValue.NodePartnerCells[static_cast<size_t>(NodeIndexValue)].push_back(PartnerCellValue);
+    };
+
+    const int32_t ClusterXValue = ClusterIndexValue % ClusterCountX;
+    const int32_t ClusterYValue = ClusterIndexValue / ClusterCountX;
+    if (ClusterXValue > 0)
+    {
+        for (const FTransition& TransitionValue : HorizontalBorders[static_cast<size_t>(ClusterIndexValue - 1)])
+        {
+            AddNode(TransitionValue.CellB, TransitionValue.CellA);
+        }
+    }
+    if (ClusterXValue + 1 < ClusterCountX)
+    {
+        for (const FTransition& TransitionValue : HorizontalBorders[static_cast<size_t>(ClusterIndexValue)])
+        {
+            AddNode(TransitionValue.CellA, TransitionValue.CellB);
+        }
+    }
+    if (ClusterYValue > 0)
+    {
+        for (const FTransition& TransitionValue :
+             VerticalBorders[static_cast<size_t>(ClusterIndexValue - ClusterCountX)])
+        {
+            AddNode(TransitionValue.CellB, TransitionValue.CellA);
+        }
+    }
+    if (ClusterYValue + 1 < ClusterCountY)
+    {
+        for (const FTransition& TransitionValue : VerticalBorders[static_cast<size_t>(ClusterIndexValue)])
+        {
+            AddNode(TransitionValue.CellA, TransitionValue.CellB);
+        }
+    }
+
+    const size_t NodeCountValue = ClusterValue.NodeCells.size();
+    ClusterValue.IntraDistances.assign(NodeCountValue * NodeCountValue, -1.0f);
+    for (size_t FromIndexValue = 0U; FromIndexValue < NodeCountValue; ++FromIndexValue)
+    {
+        RunClusterSearch(ClusterIndexValue, ClusterValue.NodeCells[FromIndexValue]);
+        for (size_t ToIndexValue = 0U; ToIndexValue < NodeCountValue; ++ToIndexValue)
+        {
+            const float DistanceValue = DistanceScratch[static_cast<size_t>(ClusterValue.NodeCells[ToIndexValue])];
+            if (DistanceValue != UnreachableDistanceValue)
+            {
+                ClusterValue.IntraDistances[FromIndexValue * NodeCountValue + ToIndexValue] = DistanceValue;
+            }
+        }
+    }
+}
+
+void FGroundPathfinder::RunClusterSearch(const int32_t ClusterIndexValue, const int32_t SourceCellValue)
+{
+    const int32_t ClusterXValue = ClusterIndexValue % ClusterCountX;
+    const int32_t ClusterYValue = ClusterIndexValue / ClusterCountX;
+    RunRegionSearch(ClusterXValue, ClusterYValue, ClusterXValue, ClusterYValue, SourceCellValue);
+}
+
+void FGroundPathfinder::RunRegionSearch(const int32_t MinClusterXValue, const int32_t MinClusterYValue,
+                                        const int32_t MaxClusterXValue, const int32_t MaxClusterYValue,
+                                        const int32_t SourceCellValue)
+{
+    FCellBounds BoundsValue;
+    BoundsValue.MinX = std::max(0, MinClusterXValue) * ClusterSizeValue;
+    BoundsValue.MinY = std::max(0, MinClusterYValue) * ClusterSizeValue;
+    BoundsValue.MaxX = std::min((MaxClusterXValue + 1) * ClusterSizeValue, Width) - 1;
+    BoundsValue.MaxY = std::min((MaxClusterYValue + 1) * ClusterSizeValue, Height) - 1;
+    for (int32_t YValue = BoundsValue.MinY; YValue <= BoundsValue.MaxY; ++YValue)
+    {
+        std::fill_n(DistanceScratch.begin() + (BoundsValue.MinX + YValue * Width),
+                    BoundsValue.MaxX - BoundsValue.MinX + 1, UnreachableDistanceValue);
+    }
+
+    const auto IsWalkableValue = [this](const int32_t XValue, const int32_t YValue)
+    { return IsWalkable(XValue, YValue); };
+    RunBoundedSearch(Width, BoundsValue, SourceCellValue, IsWalkableValue, DistanceScratch);
+}
+
+void FGroundPathfinder::RunGridSearch(const int32_t SourceCellValue, std::vector<float>& OutDistancesValue) const
+{
+    FCellBounds BoundsValue;
+    BoundsValue.MaxX = Width - 1;
+    BoundsValue.MaxY = Height - 1;
+    OutDistancesValue.assign(static_cast<size_t>(Width) * static_cast<size_t>(Height), UnreachableDistanceValue);
+
+    const auto IsWalkableValue = [this](const int32_t XValue, const int32_t YValue)
+    { return IsWalkable(XValue, YValue); };
+    RunBoundedSearch(Width, BoundsValue, SourceCellValue, IsWalkableValue, OutDistancesValue);
+}
+
+float FGroundPathfinder::FindAbstractDistance(const int32_t StartCellValue, const int32_t EndCellValue)
+{
+    const int32_t StartClusterIndexValue = GetClusterIndex(StartCellValue);
+    const int32_t EndClusterIndexValue = GetClusterIndex(EndCellValue);
+
+    // Nearby endpoints are searched exactly on the grid, over their clusters and a one-cluster margin around them.
+    // Transition placement makes abstract paths slightly long, which matters most over short distances.
+    const int32_t StartClusterXValue = StartClusterIndexValue % ClusterCountX;
+    const int32_t StartClusterYValue = StartClusterIndexValue / ClusterCountX;
+    const int32_t EndClusterXValue = EndClusterIndexValue % ClusterCountX;
+    const int32_t EndClusterYValue = EndClusterIndexValue / ClusterCountX;
+    if (std::abs(StartClusterXValue - EndClusterXValue) <= 1 && std::abs(StartClusterYValue - EndClusterYValue) <= 1)
+    {
+        RunRegionSearch(std::min(StartClusterXValue, EndClusterXValue) - 1,
+                        std::min(StartClusterYValue, EndClusterYValue) - 1,
+                        std::max(StartClusterXValue, EndClusterXValue) + 1,
+                        std::max(StartClusterYValue, EndClusterYValue) + 1, StartCellValue);
+        if (DistanceScratch[static_cast<size_t>(EndCellValue)] != UnreachableDistanceValue)
+        {
+            return DistanceScratch[static_cast<size_t>(EndCellValue)];
+        }
+    }
+
+    RunClusterSearch(StartClusterIndexValue, StartCellValue);
+
+    const FCluster& StartClusterValue = Clusters[static_cast<size_t>(StartClusterIndexValue)];
+    std::vector<float> StartNodeDistancesValue(StartClusterValue.NodeCells.size());
+    for (size_t NodeIndexValue = 0U; NodeIndexValue < StartClusterValue.NodeCells.size(); ++NodeIndexValue)
+    {
+        StartNodeDistancesValue[NodeIndexValue] =
+            DistanceScratch[static_cast<size_t>(StartClusterValue.NodeCells[NodeIndexValue])];
+    }
+
+    RunClusterSearch(EndClusterIndexValue, EndCellValue);
+    const FCluster& EndClusterValue = Clusters[static_cast<size_t>(EndClusterIndexValue)];
+    std::vector<float> EndNodeDistancesValue(EndClusterValue.NodeCells.size());
+    for (size_t NodeIndexValue = 0U; NodeIndexValue < EndClusterValue.NodeCells.size(); ++NodeIndexValue)
+    {
+        EndNodeDistancesValue[NodeIndexValue] =
+            DistanceScratch[static_cast<size_t>(EndClusterValue.NodeCells[NodeIndexValue])];
+    }
+
+    const int32_t EndXValue = EndCellValue % Width;
+    const int32_t EndYValue = EndCellValue / Width;
+    const auto GetHeuristic = [this, EndXValue, EndYValue](const int32_t CellValue)
+    { return GetOctileDistance(CellValue % Width - EndXValue, CellValue / Width - EndYValue); };
+
+    // A* over border nodes, seeded with every start-cluster node and closed by the end-cluster node distances.
+    using FQueueEntry = std::tuple<float, float, int32_t>;
+    std::priority_queue<FQueueEntry, std::vector<FQueueEntry>, std::greater<FQueueEntry>> PendingNodesValue;
+    std::unordered_map<int32_t, float> BestCostsByCellValue;
+    const auto PushNode = [&](const int32_t CellValue, const float CostValue)
+    {
+        const auto CostIteratorValue = BestCostsByCellValue.find(CellValue);
+        if (CostIteratorValue != BestCostsByCellValue.end() && CostIteratorValue->second <= CostValue)
+        {
+            return;
+        }
+        BestCostsByCellValue[CellValue] = CostValue;
+        PendingNodesValue.emplace(CostValue + GetHeuristic(CellValue), CostValue, CellValue);
+    };
+    for (size_t NodeIndexValue = 0U; NodeIndexValue < StartClusterValue.NodeCells.size(); ++NodeIndexValue)
+    {
+        if (StartNodeDistancesValue[NodeIndexValue] != UnreachableDistanceValue)
+        {
+            PushNode(StartClusterValue.NodeCells[NodeIndexValue], StartNodeDistancesValue[NodeIndexValue]);
+        }
+    }
+
+    float BestDistanceValue = UnreachableDistanceValue;
+    while (!PendingNodesValue.empty())
+    {
+        const FQueueEntry EntryValue = PendingNodesValue.top();
+        PendingNodesValue.pop();
+        const float EstimateValue = std::get<0>(EntryValue);
+        const float CostValue = std::get<1>(EntryValue);
+        const int32_t CellValue = std::get<2>(EntryValue);
+        if (EstimateValue >= BestDistanceValue)
+        {
+            break;
+        }
+        if (CostValue > BestCostsByCellValue[CellValue])
+        {
+            continue;
+        }
+
+        const int32_t ClusterIndexValue = GetClusterIndex(CellValue);
+        const FCluster& ClusterValue = Clusters[static_cast<size_t>(ClusterIndexValue)];
+        const int32_t NodeIndexValue = FindNodeIndex(ClusterValue.NodeCells, CellValue);
+        if (NodeIndexValue < 0)
+        {
+            continue;
+        }
+
+        if (ClusterIndexValue == EndClusterIndexValue &&
+            EndNodeDistancesValue[static_cast<size_t>(NodeIndexValue)] != UnreachableDistanceValue)
+        {
+            BestDistanceValue =
+                std::min(BestDistanceValue, CostValue + EndNodeDistancesValue[static_cast<size_t>(NodeIndexValue)]);
+        }
+
+        const size_t NodeCountValue = ClusterValue.NodeCells.size();
+        for (size_t OtherIndexValue = 0U; OtherIndexValue < NodeCountValue; ++OtherIndexValue)
+        {
+            const float IntraDistanceValue =
+                ClusterValue.IntraDistances[static_cast<size_t>(NodeIndexValue) * NodeCountValue + OtherIndexValue];
+            if (IntraDistanceValue > 0.0f)
+            {
+                PushNode(ClusterValue.NodeCells[OtherIndexValue], CostValue + IntraDistanceValue);
+            }
+        }
+        for (const int32_t PartnerCellValue : ClusterValue.NodePartnerCells[static_cast<size_t>(NodeIndexValue)])
+        {
+            PushNode(PartnerCellValue, CostValue + 1.0f);
+        }
+    }
+
+    return BestDistanceValue == UnreachableDistanceValue ? 0.0f : BestDistanceValue;
+}
+
+bool FGroundPathfinder::HasCurrentFlowField(const int32_t DestinationCellValue) const
+{
+    return std::any_of(FlowFields.begin(), FlowFields.end(), [DestinationCellValue](const FFlowField& FlowFieldValue)
+                       { return FlowFieldValue.DestinationCell == DestinationCellValue && !FlowFieldValue.bStale; });
+}
+
+FGroundPathfinder::FFlowField& FGroundPathfinder::GetFlowField(const int32_t DestinationCellValue)
+{
+    ++FlowFieldUseCounter;
+    const auto FlowFieldIteratorValue =
+        std::find_if(FlowFields.begin(), FlowFields.end(), [DestinationCellValue](const FFlowField& FlowFieldValue)
+                     { return FlowFieldValue.DestinationCell == DestinationCellValue; });
+    if (FlowFieldIteratorValue != FlowFields.end() && !FlowFieldIteratorValue->bStale)
+    {
+        FlowFieldIteratorValue->LastUse = FlowFieldUseCounter;
+        return *FlowFieldIteratorValue;
+    }
+
+    // A stale field keeps its slot and its storage; a new destination takes a free slot or the least recently used.
+    FFlowField* FlowFieldPtrValue = nullptr;
+    if (FlowFieldIteratorValue != FlowFields.end())
+    {
+        FlowFieldPtrValue = &*FlowFieldIteratorValue;
+    }
+    else if (FlowFields.size() < MaxFlowFieldCountValue)
+    {
+        FlowFields.emplace_back();
+        FlowFieldPtrValue = &FlowFields.back();
+    }
+    else
+    {
+        std::sort(FlowFields.begin(), FlowFields.end(), [](const FFlowField& LeftValue, const FFlowField& RightValue)
+                  { return LeftValue.LastUse > RightValue.LastUse; });
+        FlowFieldPtrValue = &FlowFields.back();
+    }
+
+    FFlowField& FlowFieldValue = *FlowFieldPtrValue;
+    FlowFieldValue.DestinationCell = DestinationCellValue;
+    FlowFieldValue.LastUse = FlowFieldUseCounter;
+    FlowFieldValue.bStale = false;
+    RunGridSearch(DestinationCellValue, FlowFieldValue.Distances);
+    ++FlowFieldBuildCount;
+    ++FlowFieldBuildsSinceUpdate;
+    return FlowFieldValue;
+}
+
+}  // namespace sc2
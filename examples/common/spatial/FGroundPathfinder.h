@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "sc2api/sc2_common.h"
+#include "sc2api/sc2_interfaces.h"
+#include "sc2api/sc2_unit.h"
+
+namespace sc2
+{
+
+class MapGrids;
+
+// Local ground pathing over the decoded start-of-game pathing grid with observed structure footprints overlaid.
+// Paths are octile moves between cell centers with no corner cutting. GetDistance searches nearby endpoints on the
+// grid within a one-cluster margin and answers the rest by hierarchical A* over a cached abstract graph of
+// fixed-size clusters. Abstract paths cross each border only at the ends and middle of an open run, so GetDistance
+// returns an upper bound on the shortest path; reachability is exact. Flow field distances are exact shortest
+// paths. A structure appearing or dying only rebuilds the clusters its footprint touches. Destinations queried
+// repeatedly are served from cached flow fields. Like
+// QueryInterface::PathingDistance, an unreachable target returns 0, and so does a blocked start or end point. Only a
+// start given with a unit radius may move to the nearest walkable cell that the unit's footprint overlaps.
+class FGroundPathfinder
+{
+public:
+    static constexpr int32_t ClusterSizeValue = 16;
+    // Enough for the rally point and one objective per army mission without evicting each other every step.
+    static constexpr size_t MaxFlowFieldCountValue = 8U;
+    // TryGetFlowFieldDistance builds at most this many flow fields between UpdateStructures calls.
+    static constexpr uint32_t MaxFlowFieldBuildsPerUpdateValue = 2U;
+    // A batch builds a flow field for any destination shared by at least this many queries.
+    static constexpr size_t FlowFieldBatchThresholdValue = 4U;
+
+    FGroundPathfinder();
+
+    void Reset();
+    // Copies the pathing grid and marks every cluster for a rebuild on the next query.
+    void Initialize(const MapGrids& MapGridsValue);
+    bool IsReady() const;
+
+    // Overlays the footprints of grounded, non-neutral structures. Lowered supply depots stay walkable. Only
+    // footprints that changed since the last call touch the abstract graph, and only a change in walkability marks
+    // cached flow fields for a rebuild on their next use. Also restarts the flow field build budget.
+    void UpdateStructures(const Units& UnitsValue);
+
+    float GetDistance(const Point2D& StartPointValue, const Point2D& EndPointValue, float StartRadiusValue = 0.0f);
+    // Entry i answers query i. Destinations shared by several queries are answered from one flow field.
+    void GetDistances(const std::vector<QueryInterface::PathingQuery>& QueriesValue,
+                      std::vector<float>& OutDistancesValue);
+    // As above, with entry i of StartRadiiValue the radius of the unit starting query i. Missing entries count as 0.
+    void GetDistances(const std::vector<QueryInterface::PathingQuery>& QueriesValue,
+                      const std::vector<float>& StartRadiiValue, std::vector<float>& OutDistancesValue);
+
+    // Distance to a common destination such as a rally point or the enemy main, from a cached flow field.
+    float GetFlowFieldDistance(const Point2D& DestinationPointValue, const Point2D& StartPointValue,
+                               float StartRadiusValue = 0.0f);
+    // As above, for callers asking on behalf of every unit each step. False when either point is blocked or when the
+    // answer needs a flow field beyond this update's build budget. An unreachable destination answers true with
+    // std::numeric_limits<float>::max(), never 0.
+    bool TryGetFlowFieldDistance(const Point2D& DestinationPointValue, const Point2D& StartPointValue,
+                                 float& OutDistanceValue, float StartRadiusValue = 0.0f);
+    // Center of the neighboring cell one step closer to the destination. False when the start cannot reach it.
+    bool TryGetFlowFieldStep(const Point2D& DestinationPointValue, const Point2D& StartPointValue,
+                             Point2D& OutNextPointValue, float StartRadiusValue = 0.0f);
+
+    bool IsWalkable(int32_t XValue, int32_t YValue) const;
+
+    // With verification on, callers still issue the game query, use its answer, and report both results here.
+    void SetQueryVerificationEnabled(bool bEnabledValue);
+    bool IsQueryVerificationEnabled() const;
+    void RecordVerificationResult(float LocalDistanceValue, float ServerDistanceValue);
+
+    uint32_t GetVerifiedQueryCount() const;
+    uint32_t GetVerificationMismatchCount() const;
+    uint32_t GetClusterRebuildCount() const;
+    uint32_t GetFlowFieldBuildCount() const;
+
+private:
+    // Inclusive tile bounds of one structure footprint.
+    struct FStructureFootprint
+    {
+        int32_t MinX = 0;
+        int32_t MinY = 0;
+        int32_t MaxX = -1;
+        int32_t MaxY = -1;
+        uint32_t LastSeenUpdate = 0U;
+    };
+
+    // Walkable cells facing each other across a cluster border; CellA lies in the left or lower cluster.
+    struct FTransition
+    {
+        int32_t CellA = 0;
+        int32_t CellB = 0;
+    };
+
+    struct FCluster
+    {
+        std::vector<int32_t> NodeCells;
+        // Cells across the border reached in one step from each node.
+        std::vector<std::vector<int32_t>> NodePartnerCells;
+        // NodeCount x NodeCount distances inside the cluster; negative when unreachable.
+        std::vector<float> IntraDistances;
+        bool bDirty = true;
+    };
+
+    struct FFlowField
+    {
+        int32_t DestinationCell = -1;
+        uint64_t LastUse = 0U;
+        std::vector<float> Distances;
+        // Walkability changed since the distances were computed.
+        bool bStale = false;
+    };
+
+    int32_t GetClusterIndex(int32_t CellIndexValue) const;
+    // The cell under the point. When it is blocked, the nearest walkable cell a circle of SnapRadiusValue around the
+    // point overlaps, so a unit never snaps outside its own footprint.
+    bool TryGetCell(const Point2D& PointValue, float SnapRadiusValue, int32_t& OutCellIndexValue) const;
+    void ApplyFootprint(const FStructureFootprint& FootprintValue, int32_t DeltaValue);
+
+    void RefreshAbstractGraph();
+    void BuildBorder(bool bHorizontalValue, int32_t ClusterXValue, int32_t ClusterYValue,
+                     std::vector<FTransition>& OutTransitionsValue) const;
+    void BuildClusterNodes(int32_t ClusterIndexValue);
+    // Dijkstra confined to one cluster; fills DistanceScratch for the cluster's cells.
+    void RunClusterSearch(int32_t ClusterIndexValue, int32_t SourceCellValue);
+    // Dijkstra confined to an inclusive block of clusters, clamped to the map.
+    void RunRegionSearch(int32_t MinClusterXValue, int32_t MinClusterYValue, int32_t MaxClusterXValue,
+                         int32_t MaxClusterYValue, int32_t SourceCellValue);
+    // Dijkstra over the whole grid from one cell.
+    void RunGridSearch(int32_t SourceCellValue, std::vector<float>& OutDistancesValue) const;
+    float FindAbstractDistance(int32_t StartCellValue, int32_t EndCellValue);
+    bool HasCurrentFlowField(int32_t DestinationCellValue) const;
+    // The cached flow field toward the cell, built or rebuilt when it is missing or stale.
+    FFlowField& GetFlowField(int32_t DestinationCellValue);
+
+    int32_t Width;
+    int32_t Height;
+    int32_t ClusterCountX;
+    int32_t ClusterCountY;
+    std::vector<uint8_t> StaticPathableCells;
+    std::vector<uint8_t> StructureCoverCounts;
+
+    std::unordered_map<Tag, FStructureFootprint> StructureFootprints;
+    uint32_t StructureUpdateIndex;
+
+    // Borders between (x, y) and (x + 1, y), then between (x, y) and (x, y + 1).
+    std::vector<std::vector<FTransition>> HorizontalBorders;
+    std::vector<std::vector<FTransition>> VerticalBorders;
+    std::vector<FCluster> Clusters;
+    bool bAbstractGraphDirty;
+
+    std::vector<FFlowField> FlowFields;
+    uint64_t FlowFieldUseCounter;
+    uint32_t FlowFieldBuildsSinceUpdate;
+
+    std::vector<float> DistanceScratch;
+    std::vector<int32_t> TouchedCellScratch;
+
+    bool bQueryVerificationEnabled;
+    uint32_t VerifiedQueryCount;
+    uint32_t VerificationMismatchCount;
+    uint32_t ClusterRebuildCount;
+    uint32_t FlowFieldBuildCount;
+};
+
+}  // namespace sc2
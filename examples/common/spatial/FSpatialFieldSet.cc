@@ -48,4 +48,22 @@ bool FSpatialFieldSet::IsValid() const
            EngageOpportunity.size() == ExpectedFieldCount;
 }
 
+float FSpatialFieldSet::SampleField(const std::vector<float>& FieldValues, const Point2D& PointValue) const
+{
+    if (!(PointValue.x >= 0.0f) || !(PointValue.y >= 0.0f))
+    {
+        return 0.0f;
+    }
+
+    const size_t ColumnValue = static_cast<size_t>(PointValue.x);
+    const size_t RowValue = static_cast<size_t>(PointValue.y);
+    if (ColumnValue >= Width || RowValue >= Height)
+    {
+        return 0.0f;
+    }
+
+    const size_t IndexValue = RowValue * static_cast<size_t>(Width) + ColumnValue;
+    return IndexValue < FieldValues.size() ? FieldValues[IndexValue] : 0.0f;
+}
+
 }  // namespace sc2
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <vector>
 
+#include "sc2api/sc2_common.h"
+
 namespace sc2
 {
 
@@ -20,6 +22,9 @@ struct FSpatialFieldSet
     void Reset();
     void Resize(const uint32_t WidthValue, const uint32_t HeightValue);
     bool IsValid() const;
+    // Value of the tile containing PointValue in one of this set's fields, or 0 outside the map or before the first
+    // build.
+    float SampleField(const std::vector<float>& FieldValues, const Point2D& PointValue) const;
 };
 
 }  // namespace sc2
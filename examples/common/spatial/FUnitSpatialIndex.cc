@@ -0,0 +1,166 @@
+#include "common/spatial/FUnitSpatialIndex.h"
+
+namespace sc2
+{
+
+FUnitSpatialIndex::FUnitSpatialIndex() : FUnitSpatialIndex(DefaultCellSizeValue)
+{
+}
+
+FUnitSpatialIndex::FUnitSpatialIndex(const float CellSizeValue)
+    : CellSize(CellSizeValue > 0.0f ? CellSizeValue : DefaultCellSizeValue)
+{
+}
+
+void FUnitSpatialIndex::Reset()
+{
+    for (FAllianceGrid& GridValue : Grids)
+    {
+        GridValue.CellCountX = 0;
+        GridValue.CellCountY = 0;
+        GridValue.CellStarts.clear();
+        GridValue.Entries.clear();
+    }
+}
+
+void FUnitSpatialIndex::Build(const Units& UnitsValue)
+{
+    for (size_t AllianceIndexValue = 0U; AllianceIndexValue < AllianceCountValue; ++AllianceIndexValue)
+    {
+        const Unit::Alliance AllianceValue = static_cast<Unit::Alliance>(AllianceIndexValue + 1U);
+        BuildScratch.clear();
+        for (const Unit* UnitPtrValue : UnitsValue)
+        {
+            if (UnitPtrValue == nullptr || UnitPtrValue->alliance != AllianceValue)
+            {
+                continue;
+            }
+
+            FEntry EntryValue;
+            EntryValue.Position = Point2D(UnitPtrValue->pos);
+            EntryValue.Ordinal = static_cast<uint32_t>(BuildScratch.size());
+            EntryValue.UnitPtr = UnitPtrValue;
+            BuildScratch.push_back(EntryValue);
+        }
+
+        BuildGrid(Grids[AllianceIndexValue], BuildScratch);
+    }
+}
+
+float FUnitSpatialIndex::GetCellSize() const
+{
+    return CellSize;
+}
+
+size_t FUnitSpatialIndex::GetUnitCount() const
+{
+    size_t UnitCountValue = 0U;
+    for (const FAllianceGrid& GridValue : Grids)
+    {
+        UnitCountValue += GridValue.Entries.size();
+    }
+    return UnitCountValue;
+}
+
+size_t FUnitSpatialIndex::GetUnitCount(const Unit::Alliance AllianceValue) const
+{
+    const FAllianceGrid* GridPtrValue = GetGrid(AllianceValue);
+    return GridPtrValue != nullptr ? GridPtrValue->Entries.size() : 0U;
+}
+
+const FUnitSpatialIndex::FAllianceGrid* FUnitSpatialIndex::GetGrid(const Unit::Alliance AllianceValue) const
+{
+    const int AllianceIndexValue = static_cast<int>(AllianceValue) - 1;
+    if (AllianceIndexValue < 0 || AllianceIndexValue >= static_cast<int>(AllianceCountValue))
+    {
+        return nullptr;
+    }
+
+    return &Grids[static_cast<size_t>(AllianceIndexValue)];
+}
+
+int32_t FUnitSpatialIndex::GetCellCoordinate(const float PositionValue, const float MinValue,
+                                             const int32_t CellCountValue) const
+{
+    const float CellValue = std::floor((PositionValue - MinValue) / CellSize);
+    if (!(CellValue > 0.0f))
+    {
+        return 0;
+    }
+    if (CellValue >= static_cast<float>(CellCountValue - 1))
+    {
+        return CellCountValue - 1;
+    }
+
+    return static_cast<int32_t>(CellValue);
+}
+
+void FUnitSpatialIndex::BuildGrid(FAllianceGrid& GridValue, const std::vector<FEntry>& SourceEntriesValue)
+{
+    GridValue.Entries.clear();
+    if (SourceEntriesValue.empty())
+    {
+        GridValue.CellCountX = 0;
+        GridValue.CellCountY = 0;
+        GridValue.CellStarts.clear();
+        return;
+    }
+
+    float MinXValue = std::numeric_limits<float>::max();
+    float MinYValue = std::numeric_limits<float>::max();
+    float MaxXValue = std::numeric_limits<float>::lowest();
+    float MaxYValue = std::numeric_limits<float>::lowest();
+    for (const FEntry& EntryValue : SourceEntriesValue)
+    {
+        MinXValue = std::min(MinXValue, EntryValue.Position.x);
+        MinYValue = std::min(MinYValue, EntryValue.Position.y);
+        MaxXValue = std::max(MaxXValue, EntryValue.Position.x);
+        MaxYValue = std::max(MaxYValue, EntryValue.Position.y);
+    }
+
+    // Map coordinates stay well under MaxCellsPerAxisValue cells; the cap only guards against corrupt positions.
+    const auto GetCellCountValue = [this](const float ExtentValue)
+    {
+        const float CellCountValue = std::floor(ExtentValue / CellSize) + 1.0f;
+        if (!(CellCountValue >= 1.0f))
+        {
+            return 1;
+        }
+        return static_cast<int32_t>(std::min(CellCountValue, static_cast<float>(MaxCellsPerAxisValue)));
+    };
+
+    GridValue.MinX = MinXValue;
+    GridValue.MinY = MinYValue;
+    GridValue.CellCountX = GetCellCountValue(MaxXValue - MinXValue);
+    GridValue.CellCountY = GetCellCountValue(MaxYValue - MinYValue);
+
+    // Counting sort by cell keeps observation order inside each cell.
+    const size_t CellCountValue = static_cast<size_t>(GridValue.CellCountX) * static_cast<size_t>(GridValue.CellCountY);
+    GridValue.CellStarts.assign(CellCountValue + 1U, 0U);
+    for (const FEntry& EntryValue : SourceEntriesValue)
+    {
+        const size_t CellIndexValue =
+            static_cast<size_t>(GetCellCoordinate(EntryValue.Position.y, GridValue.MinY, GridValue.CellCountY)) *
+                static_cast<size_t>(GridValue.CellCountX) +
+            static_cast<size_t>(GetCellCoordinate(EntryValue.Position.x, GridValue.MinX, GridValue.CellCountX));
+        ++GridValue.CellStarts[CellIndexValue + 1U];
+    }
+    for (size_t CellIndexValue = 0U; CellIndexValue < CellCountValue; ++CellIndexValue)
+    {
+        GridValue.CellStarts[CellIndexValue + 1U] += GridValue.CellStarts[CellIndexValue];
+    }
+
+    GridValue.Entries.resize(SourceEntriesValue.size());
+    std::vector<uint32_t>& CellCursorsValue = CellCursorScratch;
+    CellCursorsValue.assign(GridValue.CellStarts.begin(), GridValue.CellStarts.end() - 1);
+    for (const FEntry& EntryValue : SourceEntriesValue)
+    {
+        const size_t CellIndexValue =
+            static_cast<size_t>(GetCellCoordinate(EntryValue.Position.y, GridValue.MinY, GridValue.CellCountY)) *
+                static_cast<size_t>(GridValue.CellCountX) +
+            static_cast<size_t>(GetCellCoordinate(EntryValue.Position.x, GridValue.MinX, GridValue.CellCountX));
+        GridValue.Entries[CellCursorsValue[CellIndexValue]++] = EntryValue;
+    }
+}
+
+}  // namespace sc2
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "sc2api/sc2_common.h"
+#include "sc2api/sc2_unit.h"
+
+namespace sc2
+{
+
+// Uniform-grid index over one observation's unit positions, split by alliance and rebuilt once per step.
+// Nearest queries return the same unit as a linear scan of GetUnits(Alliance) that keeps the first closest match:
+// ties on distance are broken by each unit's position in the observation.
+class FUnitSpatialIndex
+{
+public:
+    static constexpr float DefaultCellSizeValue = 8.0f;
+
+    FUnitSpatialIndex();
+    explicit FUnitSpatialIndex(float CellSizeValue);
+
+    void Reset();
+    void Build(const Units& UnitsValue);
+
+    float GetCellSize() const;
+    size_t GetUnitCount() const;
+    size_t GetUnitCount(Unit::Alliance AllianceValue) const;
+
+    template <typename TPredicate>
+    const Unit* FindNearest(const Point2D& OriginPointValue, Unit::Alliance AllianceValue,
+                            TPredicate PredicateValue) const;
+
+    // Appends up to MaxCountValue matches, closest first.
+    template <typename TPredicate>
+    void FindKNearest(const Point2D& OriginPointValue, Unit::Alliance AllianceValue, size_t MaxCountValue,
+                      TPredicate PredicateValue, std::vector<const Unit*>& OutUnitsValue) const;
+
+    // Appends every match within RadiusValue, in observation order.
+    template <typename TPredicate>
+    void FindWithinRadius(const Point2D& OriginPointValue, float RadiusValue, Unit::Alliance AllianceValue,
+                          TPredicate PredicateValue, std::vector<const Unit*>& OutUnitsValue) const;
+
+private:
+    struct FEntry
+    {
+        Point2D Position;
+        uint32_t Ordinal = 0U;
+        const Unit* UnitPtr = nullptr;
+    };
+
+    // Entries are sorted by cell, and by observation order inside a cell; CellStarts has one extra trailing offset.
+    struct FAllianceGrid
+    {
+        float MinX = 0.0f;
+        float MinY = 0.0f;
+        int32_t CellCountX = 0;
+        int32_t CellCountY = 0;
+        std::vector<uint32_t> CellStarts;
+        std::vector<FEntry> Entries;
+    };
+
+    static constexpr size_t AllianceCountValue = 4U;
+    static constexpr int32_t MaxCellsPerAxisValue = 512;
+
+    const FAllianceGrid* GetGrid(Unit::Alliance AllianceValue) const;
+    // Clamped to the grid. Clamping keeps ring distance bounds valid for origins outside the grid, since the origin
+    // is then only farther from every cell.
+    int32_t GetCellCoordinate(float PositionValue, float MinValue, int32_t CellCountValue) const;
+    void BuildGrid(FAllianceGrid& GridValue, const std::vector<FEntry>& SourceEntriesValue);
+
+    template <typename TVisitor>
+    void VisitRing(const FAllianceGrid& GridValue, int32_t CenterCellXValue, int32_t CenterCellYValue,
+                   int32_t RingValue, TVisitor& VisitorValue) const;
+
+    float CellSize;
+    std::array<FAllianceGrid, AllianceCountValue> Grids;
+    std::vector<FEntry> BuildScratch;
+    std::vector<uint32_t> CellCursorScratch;
+};
+
+template <typename TVisitor>
+void FUnitSpatialIndex::VisitRing(const FAllianceGrid& GridValue, const int32_t CenterCellXValue,
+                                  const int32_t CenterCellYValue, const int32_t RingValue,
+                                  TVisitor& VisitorValue) const
+{
+    const auto VisitCell = [&GridValue, &VisitorValue](const int32_t CellXValue, const int32_t CellYValue)
+    {
+        if (CellXValue < 0 || CellYValue < 0 || CellXValue >= GridValue.CellCountX ||
+            CellYValue >= GridValue.CellCountY)
+        {
+            return;
+        }
+
+        const size_t CellIndexValue = static_cast<size_t>(CellYValue) * static_cast<size_t>(GridValue.CellCountX) +
+                                      static_cast<size_t>(CellXValue);
+        for (uint32_t EntryIndexValue = GridValue.CellStarts[CellIndexValue];
+             EntryIndexValue < GridValue.CellStarts[CellIndexValue + 1U]; ++EntryIndexValue)
+        {
+            VisitorValue(GridValue.Entries[EntryIndexValue]);
+        }
+    };
+
+    if (RingValue == 0)
+    {
+        VisitCell(CenterCellXValue, CenterCellYValue);
+        return;
+    }
+
+    for (int32_t CellXValue = CenterCellXValue - RingValue; CellXValue <= CenterCellXValue + RingValue; ++CellXValue)
+    {
+        VisitCell(CellXValue, CenterCellYValue - RingValue);
+        VisitCell(CellXValue, CenterCellYValue + RingValue);
+    }
+    for (int32_t CellYValue = CenterCellYValue - RingValue + 1; CellYValue < CenterCellYValue + RingValue;
+         ++CellYValue)
+    {
+        VisitCell(CenterCellXValue - RingValue, CellYValue);
+        VisitCell(CenterCellXValue + RingValue, CellYValue);
+    }
+}
+
+template <typename TPredicate>
+const Unit* FUnitSpatialIndex::FindNearest(const Point2D& OriginPointValue, const Unit::Alliance AllianceValue,
+                                           TPredicate PredicateValue) const
+{
+    const FAllianceGrid* GridPtrValue = GetGrid(AllianceValue);
+    if (GridPtrValue == nullptr || GridPtrValue->Entries.empty())
+    {
+        return nullptr;
+    }
+
+    const FAllianceGrid& GridValue = *GridPtrValue;
+    const int32_t CenterCellXValue = GetCellCoordinate(OriginPointValue.x, GridValue.MinX, GridValue.CellCountX);
+    const int32_t CenterCellYValue = GetCellCoordinate(OriginPointValue.y, GridValue.MinY, GridValue.CellCountY);
+    const int32_t MaxRingValue =
+        std::max(std::max(CenterCellXValue, GridValue.CellCountX - 1 - CenterCellXValue),
+                 std::max(CenterCellYValue, GridValue.CellCountY - 1 - CenterCellYValue));
+
+    const FEntry* BestEntryPtrValue = nullptr;
+    float BestDistanceSquaredValue = std::numeric_limits<float>::max();
+    auto VisitEntry = [&](const FEntry& EntryValue)
+    {
+        const float DistanceSquaredValue = DistanceSquared2D(OriginPointValue, EntryValue.Position);
+        if (DistanceSquaredValue > BestDistanceSquaredValue ||
+            (DistanceSquaredValue == BestDistanceSquaredValue && BestEntryPtrValue != nullptr &&
+             EntryValue.Ordinal > BestEntryPtrValue->Ordinal) ||
+            !PredicateValue(*EntryValue.UnitPtr))
+        {
+            return;
+        }
+
+        BestDistanceSquaredValue = DistanceSquaredValue;
+        BestEntryPtrValue = &EntryValue;
+    };
+
+    for (int32_t RingValue = 0; RingValue <= MaxRingValue; ++RingValue)
+    {
+        VisitRing(GridValue, CenterCellXValue, CenterCellYValue, RingValue, VisitEntry);
+
+        // Every cell in the next ring is at least RingValue cells away from the origin.
+        const float NextRingDistanceValue = static_cast<float>(RingValue) * CellSize;
+        if (BestEntryPtrValue != nullptr && BestDistanceSquaredValue < NextRingDistanceValue * NextRingDistanceValue)
+        {
+            break;
+        }
+    }
+
+    return BestEntryPtrValue != nullptr ? BestEntryPtrValue->UnitPtr : nullptr;
+}
+
+template <typename TPredicate>
+void FUnitSpatialIndex::FindKNearest(const Point2D& OriginPointValue, const Unit::Alliance AllianceValue,
+                                     const size_t MaxCountValue, TPredicate PredicateValue,
+                                     std::vector<const Unit*>& OutUnitsValue) const
+{
+    const FAllianceGrid* GridPtrValue = GetGrid(AllianceValue);
+    if (GridPtrValue == nullptr || GridPtrValue->Entries.empty() || MaxCountValue == 0U)
+    {
+        return;
+    }
+
+    const FAllianceGrid& GridValue = *GridPtrValue;
+    const int32_t CenterCellXValue = GetCellCoordinate(OriginPointValue.x, GridValue.MinX, GridValue.CellCountX);
+    const int32_t CenterCellYValue = GetCellCoordinate(OriginPointValue.y, GridValue.MinY, GridValue.CellCountY);
+    const int32_t MaxRingValue =
+        std::max(std::max(CenterCellXValue, GridValue.CellCountX - 1 - CenterCellXValue),
+                 std::max(CenterCellYValue, GridValue.CellCountY - 1 - CenterCellYValue));
+
+    // Max-heap on (distance, ordinal) holding the best MaxCountValue matches seen so far.
+    using FCandidate = std::pair<float, const FEntry*>;
+    const auto IsCloser = [](const FCandidate& LeftValue, const FCandidate& RightValue)
+    {
+        return LeftValue.first < RightValue.first ||
+               (LeftValue.first == RightValue.first && LeftValue.second->Ordinal < RightValue.second->Ordinal);
+    };
+    std::vector<FCandidate> CandidatesValue;
+    CandidatesValue.reserve(MaxCountValue);
+    auto VisitEntry = [&](const FEntry& EntryValue)
+    {
+        const FCandidate CandidateValue(DistanceSquared2D(OriginPointValue, EntryValue.Position), &EntryValue);
+        if (CandidatesValue.size() == MaxCountValue && !IsCloser(CandidateValue, CandidatesValue.front()))
+        {
+            return;
+        }
+        if (!PredicateValue(*EntryValue.UnitPtr))
+        {
+            return;
+        }
+
+        if (CandidatesValue.size() == MaxCountValue)
+        {
+            std::pop_heap(CandidatesValue.begin(), CandidatesValue.end(), IsCloser);
+            CandidatesValue.back() = CandidateValue;
+        }
+        else
+        {
+            CandidatesValue.push_back(CandidateValue);
+        }
+        std::push_heap(CandidatesValue.begin(), CandidatesValue.end(), IsCloser);
+    };
+
+    for (int32_t RingValue = 0; RingValue <= MaxRingValue; ++RingValue)
+    {
+        VisitRing(GridValue, CenterCellXValue, CenterCellYValue, RingValue, VisitEntry);
+
+        const float NextRingDistanceValue = static_cast<float>(RingValue) * CellSize;
+        if (CandidatesValue.size() == MaxCountValue &&
+            CandidatesValue.front().first < NextRingDistanceValue * NextRingDistanceValue)
+        {
+            break;
+        }
+    }
+
+    std::sort_heap(CandidatesValue.begin(), CandidatesValue.end(), IsCloser);
+    for (const FCandidate& CandidateValue : CandidatesValue)
+    {
+        OutUnitsValue.push_back(CandidateValue.second->UnitPtr);
+    }
+}
+
+template <typename TPredicate>
+void FUnitSpatialIndex::FindWithinRadius(const Point2D& OriginPointValue, const float RadiusValue,
+                                         const Unit::Alliance AllianceValue, TPredicate PredicateValue,
+                                         std::vector<const Unit*>& OutUnitsValue) const
+{
+    const FAllianceGrid* GridPtrValue = GetGrid(AllianceValue);
+    if (GridPtrValue == nullptr || GridPtrValue->Entries.empty() || !(RadiusValue >= 0.0f))
+    {
+        return;
+    }
+
+    const FAllianceGrid& GridValue = *GridPtrValue;
+    const float RadiusSquaredValue = RadiusValue * RadiusValue;
+    const int32_t MinCellXValue =
+        GetCellCoordinate(OriginPointValue.x - RadiusValue, GridValue.MinX, GridValue.CellCountX);
+    const int32_t MaxCellXValue =
+        GetCellCoordinate(OriginPointValue.x + RadiusValue, GridValue.MinX, GridValue.CellCountX);
+    const int32_t MinCellYValue =
+        GetCellCoordinate(OriginPointValue.y - RadiusValue, GridValue.MinY, GridValue.CellCountY);
+    const int32_t MaxCellYValue =
+        GetCellCoordinate(OriginPointValue.y + RadiusValue, GridValue.MinY, GridValue.CellCountY);
+
+    std::vector<const FEntry*> MatchesValue;
+    for (int32_t CellYValue = MinCellYValue; CellYValue <= MaxCellYValue; ++CellYValue)
+    {
+        for (int32_t CellXValue = MinCellXValue; CellXValue <= MaxCellXValue; ++CellXValue)
+        {
+            const size_t CellIndexValue = static_cast<size_t>(CellYValue) * static_cast<size_t>(GridValue.CellCountX) +
+                                          static_cast<size_t>(CellXValue);
+            for (uint32_t EntryIndexValue = GridValue.CellStarts[CellIndexValue];
+                 EntryIndexValue < GridValue.CellStarts[CellIndexValue + 1U]; ++EntryIndexValue)
+            {
+                const FEntry& EntryValue = GridValue.Entries[EntryIndexValue];
+                if (DistanceSquared2D(OriginPointValue, EntryValue.Position) <= RadiusSquaredValue &&
+                    PredicateValue(*EntryValue.UnitPtr))
+                {
+                    MatchesValue.push_back(&EntryValue);
+                }
+            }
+        }
+    }
+
+    std::sort(MatchesValue.begin(), MatchesValue.end(), [](const FEntry* LeftValue, const FEntry* RightValue)
+              { return LeftValue->Ordinal < RightValue->Ordinal; });
+    for (const FEntry* EntryPtrValue : MatchesValue)
+    {
+        OutUnitsValue.push_back(EntryPtrValue->UnitPtr);
+    }
+}
+
+}  // namespace sc2
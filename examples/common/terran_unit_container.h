@@ -1,10 +1,12 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "common/containers/FFrameArena.h"
 #include "common/logging.h"
 #include "sc2api/sc2_unit.h"
 #include "terran_models.h"
@@ -74,15 +76,15 @@ struct FTerranUnitContainer
     std::vector<float> Energy;
     std::vector<float> EnergyMax;
 
-    std::vector<std::vector<BuffID>> UnitBuffs;
+    std::vector<FFrameArenaRange> UnitBuffs;
 
     FUnitStateFlags StateFlags;
 
     std::vector<float> WeaponCooldownRemaining;
-    std::vector<std::vector<UnitOrder>> Orders;
+    std::vector<FFrameArenaRange> Orders;
     std::vector<Tag> EngagedTargetTag;
 
-    std::vector<std::vector<PassengerUnit>> Passengers;
+    std::vector<FFrameArenaRange> Passengers;
     std::vector<int> CargoSpaceOccupied;
     std::vector<int> CargoSpaceMax;
 
@@ -91,6 +93,16 @@ struct FTerranUnitContainer
     std::vector<int> IdealHarvesters;
     std::unordered_map<Tag, size_t> TagToIndexMap;
 
+    // Variable-length per-row data lives in frame arenas that are refilled on every update, so the UnitBuffs, Orders
+    // and Passengers columns only hold ranges and never own heap storage per row.
+    FFrameArena<BuffID> BuffArena;
+    FFrameArena<UnitOrder> OrderArena;
+    FFrameArena<PassengerUnit> PassengerArena;
+
+    // Stamp of the last UpdateUnits call that observed each row. Rows whose stamp falls behind are swap-removed.
+    std::vector<uint64_t> RowUpdateStamps;
+    uint64_t CurrentUpdateStamp = 0U;
+
     FTerranUnitContainer() = default;
 
     void AddUnit(const Unit* NewUnit)
@@ -115,52 +127,18 @@ struct FTerranUnitContainer
         ShieldMax.push_back(NewUnit->shield_max);
         Energy.push_back(NewUnit->energy);
         EnergyMax.push_back(NewUnit->energy_max);
-        UnitBuffs.push_back(NewUnit->buffs);
+        UnitBuffs.push_back(BuffArena.Append(NewUnit->buffs));
         WeaponCooldownRemaining.push_back(NewUnit->weapon_cooldown);
-        Orders.push_back(NewUnit->orders);
+        Orders.push_back(OrderArena.Append(NewUnit->orders));
         EngagedTargetTag.push_back(NewUnit->engaged_target_tag);
-        Passengers.push_back(NewUnit->passengers);
+        Passengers.push_back(PassengerArena.Append(NewUnit->passengers));
         CargoSpaceOccupied.push_back(NewUnit->cargo_space_taken);
         CargoSpaceMax.push_back(NewUnit->cargo_space_max);
         AddonTag.push_back(NewUnit->add_on_tag);
         AssignedHarvisters.push_back(NewUnit->assigned_harvesters);
         IdealHarvesters.push_back(NewUnit->ideal_harvesters);
-
-        StateFlags.StateFlags.push_back(0);
-
-        const size_t Index = ControlledUnits.size() - 1;
-        if (NewUnit->is_alive)
-        {
-            StateFlags.SetFlag(Index, IsAlive);
-        }
-        if (NewUnit->is_building)
-        {
-            StateFlags.SetFlag(Index, IsABuilding);
-        }
-        if (NewUnit->is_flying)
-        {
-            StateFlags.SetFlag(Index, IsFlying);
-        }
-        if (NewUnit->is_burrowed)
-        {
-            StateFlags.SetFlag(Index, IsBurrowed);
-        }
-        if (NewUnit->is_hallucination)
-        {
-            StateFlags.SetFlag(Index, IsHallucination);
-        }
-        if (NewUnit->is_selected)
-        {
-            StateFlags.SetFlag(Index, IsSelected);
-        }
-        if (NewUnit->is_on_screen)
-        {
-            StateFlags.SetFlag(Index, IsOnScreen);
-        }
-        if (NewUnit->is_blip)
-        {
-            StateFlags.SetFlag(Index, IsASensorTowerBlip);
-        }
+        StateFlags.StateFlags.push_back(BuildStateFlags(*NewUnit));
+        RowUpdateStamps.push_back(CurrentUpdateStamp);
 
         FilteredUnits.resize(ControlledUnits.size(), false);
         TagToIndexMap[NewUnit->tag] = ControlledUnits.size() - 1U;
@@ -206,6 +184,10 @@ struct FTerranUnitContainer
         AssignedHarvisters.clear();
         IdealHarvesters.clear();
         TagToIndexMap.clear();
+        BuffArena.Reset();
+        OrderArena.Reset();
+        PassengerArena.Reset();
+        RowUpdateStamps.clear();
         AssertSynchronizedSizes();
     }
 
@@ -242,10 +224,69 @@ struct FTerranUnitContainer
         AssignedHarvisters.reserve(NewUnits.size());
         IdealHarvesters.reserve(NewUnits.size());
         TagToIndexMap.reserve(NewUnits.size());
+        RowUpdateStamps.reserve(NewUnits.size());
 
         AddUnits(NewUnits);
     }
 
+    // Diffs the current observation against the stored rows instead of rebuilding every column.
+    // Known tags refresh their scalar columns in place, new tags are appended, and rows that were not observed this
+    // update are swap-removed. Row order is therefore stable across steps rather than following observation order.
+    void UpdateUnits(const std::vector<const Unit*>& CurrentUnits)
+    {
+        ++CurrentUpdateStamp;
+        BuffArena.Reset();
+        OrderArena.Reset();
+        PassengerArena.Reset();
+        SelectedUnits.clear();
+
+        for (const Unit* CurrentUnit : CurrentUnits)
+        {
+            if (!CurrentUnit)
+            {
+                continue;
+            }
+
+            const std::unordered_map<Tag, size_t>::const_iterator FoundIndex = TagToIndexMap.find(CurrentUnit->tag);
+            if (FoundIndex == TagToIndexMap.end())
+            {
+                AddUnit(CurrentUnit);
+                continue;
+            }
+
+            RefreshRow(FoundIndex->second, *CurrentUnit);
+        }
+
+        size_t RowIndex = 0U;
+        while (RowIndex < ControlledUnits.size())
+        {
+            if (RowUpdateStamps[RowIndex] != CurrentUpdateStamp)
+            {
+                RemoveRowAt(RowIndex);
+                continue;
+            }
+            ++RowIndex;
+        }
+
+        FilteredUnits.assign(ControlledUnits.size(), false);
+        AssertSynchronizedSizes();
+    }
+
+    FFrameArenaView<BuffID> GetUnitBuffs(size_t Index) const
+    {
+        return BuffArena.GetView(UnitBuffs[Index]);
+    }
+
+    FFrameArenaView<UnitOrder> GetOrders(size_t Index) const
+    {
+        return OrderArena.GetView(Orders[Index]);
+    }
+
+    FFrameArenaView<PassengerUnit> GetPassengers(size_t Index) const
+    {
+        return PassengerArena.GetView(Passengers[Index]);
+    }
+
     bool HasSynchronizedSizes() const
     {
         const size_t ExpectedSize = ControlledUnits.size();
@@ -259,7 +300,8 @@ struct FTerranUnitContainer
                EngagedTargetTag.size() == ExpectedSize && Passengers.size() == ExpectedSize &&
                CargoSpaceOccupied.size() == ExpectedSize && CargoSpaceMax.size() == ExpectedSize &&
                AddonTag.size() == ExpectedSize && AssignedHarvisters.size() == ExpectedSize &&
-               IdealHarvesters.size() == ExpectedSize && TagToIndexMap.size() == ExpectedSize;
+               IdealHarvesters.size() == ExpectedSize && RowUpdateStamps.size() == ExpectedSize &&
+               TagToIndexMap.size() == ExpectedSize;
     }
 
     void ResetFilteredUnits()
@@ -574,8 +616,13 @@ struct FTerranUnitContainer
     {
         for (size_t Index = 0; Index < ControlledUnits.size(); ++Index)
         {
-            if (FilteredUnits[Index] &&
-                std::find(UnitBuffs[Index].begin(), UnitBuffs[Index].end(), Buff) == UnitBuffs[Index].end())
+            if (!FilteredUnits[Index])
+            {
+                continue;
+            }
+
+            const FFrameArenaView<BuffID> UnitBuffView = GetUnitBuffs(Index);
+            if (std::find(UnitBuffView.begin(), UnitBuffView.end(), Buff) == UnitBuffView.end())
             {
                 FilteredUnits[Index] = false;
             }
@@ -589,7 +636,7 @@ struct FTerranUnitContainer
             bool MatchFound = false;
             if (FilteredUnits[Index])
             {
-                for (const UnitOrder& OrderValue : Orders[Index])
+                for (const UnitOrder& OrderValue : GetOrders(Index))
                 {
                     if (OrderValue.target_unit_tag == TargetTag)
                     {
@@ -612,7 +659,7 @@ struct FTerranUnitContainer
             bool MatchFound = false;
             if (FilteredUnits[Index])
             {
-                for (const UnitOrder& OrderValue : Orders[Index])
+                for (const UnitOrder& OrderValue : GetOrders(Index))
                 {
                     if (OrderValue.target_pos == TargetPos)
                     {
@@ -676,7 +723,7 @@ struct FTerranUnitContainer
     {
         for (size_t Index = 0; Index < ControlledUnits.size(); ++Index)
         {
-            if (FilteredUnits[Index] && static_cast<int>(Passengers[Index].size()) != PassengerCount)
+            if (FilteredUnits[Index] && static_cast<int>(GetPassengers(Index).size()) != PassengerCount)
             {
                 FilteredUnits[Index] = false;
             }
@@ -722,7 +769,7 @@ struct FTerranUnitContainer
         {
             if (FilteredUnits[Index])
             {
-                for (const UnitOrder& OrderValue : Orders[Index])
+                for (const UnitOrder& OrderValue : GetOrders(Index))
                 {
                     if (IsTrainTerranUnit(OrderValue.ability_id))
                     {
@@ -821,7 +868,7 @@ struct FTerranUnitContainer
         for (size_t Index = 0; Index < ControlledUnits.size(); ++Index)
         {
             if (UnitTypes[Index].ToType() == UNIT_TYPEID::TERRAN_SCV && BuildProgress[Index] >= 1.0f &&
-                Orders[Index].empty())
+                GetOrders(Index).empty())
             {
                 return ControlledUnits[Index];
             }
@@ -834,7 +881,7 @@ struct FTerranUnitContainer
         for (size_t Index = 0; Index < ControlledUnits.size(); ++Index)
         {
             const UNIT_TYPEID UnitType = UnitTypes[Index].ToType();
-            if (BuildProgress[Index] < 1.0f || !Orders[Index].empty())
+            if (BuildProgress[Index] < 1.0f || !GetOrders(Index).empty())
             {
                 continue;
             }
@@ -856,7 +903,7 @@ struct FTerranUnitContainer
         for (size_t Index = 0; Index < ControlledUnits.size(); ++Index)
         {
             if (UnitTypes[Index].ToType() == UNIT_TYPEID::TERRAN_BARRACKS && BuildProgress[Index] >= 1.0f &&
-                Orders[Index].empty())
+                GetOrders(Index).empty())
             {
                 return ControlledUnits[Index];
             }
@@ -865,6 +912,123 @@ struct FTerranUnitContainer
     }
 
 private:
+    static uint8_t BuildStateFlags(const Unit& SourceUnit)
+    {
+        uint8_t FlagsValue = 0U;
+        if (SourceUnit.is_alive)
+        {
+            FlagsValue |= IsAlive;
+        }
+        if (SourceUnit.is_building)
+        {
+            FlagsValue |= IsABuilding;
+        }
+        if (SourceUnit.is_flying)
+        {
+            FlagsValue |= IsFlying;
+        }
+        if (SourceUnit.is_burrowed)
+        {
+            FlagsValue |= IsBurrowed;
+        }
+        if (SourceUnit.is_hallucination)
+        {
+            FlagsValue |= IsHallucination;
+        }
+        if (SourceUnit.is_selected)
+        {
+            FlagsValue |= IsSelected;
+        }
+        if (SourceUnit.is_on_screen)
+        {
+            FlagsValue |= IsOnScreen;
+        }
+        if (SourceUnit.is_blip)
+        {
+            FlagsValue |= IsASensorTowerBlip;
+        }
+        return FlagsValue;
+    }
+
+    void RefreshRow(size_t Index, const Unit& SourceUnit)
+    {
+        ControlledUnits[Index] = &SourceUnit;
+        Alliances[Index] = SourceUnit.alliance;
+        UnitTypes[Index] = SourceUnit.unit_type;
+        Positions[Index] = SourceUnit.pos;
+        FacingRadians[Index] = SourceUnit.facing;
+        UnitRadius[Index] = SourceUnit.radius;
+        BuildProgress[Index] = SourceUnit.build_progress;
+        CloakStates[Index] = SourceUnit.cloak;
+        Health[Index] = SourceUnit.health;
+        HealthMax[Index] = SourceUnit.health_max;
+        Shield[Index] = SourceUnit.shield;
+        ShieldMax[Index] = SourceUnit.shield_max;
+        Energy[Index] = SourceUnit.energy;
+        EnergyMax[Index] = SourceUnit.energy_max;
+        UnitBuffs[Index] = BuffArena.Append(SourceUnit.buffs);
+        WeaponCooldownRemaining[Index] = SourceUnit.weapon_cooldown;
+        Orders[Index] = OrderArena.Append(SourceUnit.orders);
+        EngagedTargetTag[Index] = SourceUnit.engaged_target_tag;
+        Passengers[Index] = PassengerArena.Append(SourceUnit.passengers);
+        CargoSpaceOccupied[Index] = SourceUnit.cargo_space_taken;
+        CargoSpaceMax[Index] = SourceUnit.cargo_space_max;
+        AddonTag[Index] = SourceUnit.add_on_tag;
+        AssignedHarvisters[Index] = SourceUnit.assigned_harvesters;
+        IdealHarvesters[Index] = SourceUnit.ideal_harvesters;
+        StateFlags.StateFlags[Index] = BuildStateFlags(SourceUnit);
+        RowUpdateStamps[Index] = CurrentUpdateStamp;
+    }
+
+    template <typename TValueType>
+    static void SwapRemoveAt(std::vector<TValueType>& Values, size_t Index)
+    {
+        if (Index + 1U != Values.size())
+        {
+            Values[Index] = Values.back();
+        }
+        Values.pop_back();
+    }
+
+    void RemoveRowAt(size_t Index)
+    {
+        const size_t LastIndex = ControlledUnits.size() - 1U;
+        TagToIndexMap.erase(Tags[Index]);
+        if (Index != LastIndex)
+        {
+            TagToIndexMap[Tags[LastIndex]] = Index;
+        }
+
+        SwapRemoveAt(ControlledUnits, Index);
+        SwapRemoveAt(FilteredUnits, Index);
+        SwapRemoveAt(Alliances, Index);
+        SwapRemoveAt(Tags, Index);
+        SwapRemoveAt(UnitTypes, Index);
+        SwapRemoveAt(Positions, Index);
+        SwapRemoveAt(FacingRadians, Index);
+        SwapRemoveAt(UnitRadius, Index);
+        SwapRemoveAt(BuildProgress, Index);
+        SwapRemoveAt(CloakStates, Index);
+        SwapRemoveAt(Health, Index);
+        SwapRemoveAt(HealthMax, Index);
+        SwapRemoveAt(Shield, Index);
+        SwapRemoveAt(ShieldMax, Index);
+        SwapRemoveAt(Energy, Index);
+        SwapRemoveAt(EnergyMax, Index);
+        SwapRemoveAt(UnitBuffs, Index);
+        SwapRemoveAt(StateFlags.StateFlags, Index);
+        SwapRemoveAt(WeaponCooldownRemaining, Index);
+        SwapRemoveAt(Orders, Index);
+        SwapRemoveAt(EngagedTargetTag, Index);
+        SwapRemoveAt(Passengers, Index);
+        SwapRemoveAt(CargoSpaceOccupied, Index);
+        SwapRemoveAt(CargoSpaceMax, Index);
+        SwapRemoveAt(AddonTag, Index);
+        SwapRemoveAt(AssignedHarvisters, Index);
+        SwapRemoveAt(IdealHarvesters, Index);
+        SwapRemoveAt(RowUpdateStamps, Index);
+    }
+
     void AssertSynchronizedSizes() const
     {
         if (!HasSynchronizedSizes())
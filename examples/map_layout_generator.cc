@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/catalogs/FMapGridLayoutAnalyzer.h"
+
+// Builds MapLayoutDictionary.yaml map entries from terrain grid dumps.
+//
+//   map_layout_generator [--threads N] <output.yaml> <map_dump_dir>...
+//
+// Each map dump directory holds pathing.txt, placement.txt and height.txt written at game start by
+// PathingGrid::Dump, PlacementGrid::Dump and HeightMap::Dump, plus an optional start_locations.txt. Maps are
+// analyzed in parallel and written in argument order.
+
+namespace
+{
+
+struct FMapGenerationResult
+{
+    std::string YamlEntry;
+    std::string Error;
+    size_t BaseCount = 0U;
+    size_t RampCount = 0U;
+};
+
+void PrintUsage()
+{
+    std::cerr << "Usage: map_layout_generator [--threads N] <output.yaml> <map_dump_dir>..." << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    uint32_t ThreadCountValue = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<std::string> PositionalArgumentsValue;
+    for (int ArgumentIndexValue = 1; ArgumentIndexValue < argc; ++ArgumentIndexValue)
+    {
+        const std::string ArgumentValue = argv[ArgumentIndexValue];
+        if (ArgumentValue == "--threads" && ArgumentIndexValue + 1 < argc)
+        {
+            const long ParsedThreadCountValue = std::strtol(argv[++ArgumentIndexValue], nullptr, 10);
+            ThreadCountValue = static_cast<uint32_t>(std::max(1L, ParsedThreadCountValue));
+            continue;
+        }
+        PositionalArgumentsValue.push_back(ArgumentValue);
+    }
+    if (PositionalArgumentsValue.size() < 2U)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const std::string OutputPathValue = PositionalArgumentsValue.front();
+    const std::vector<std::string> MapDirectoriesValue(PositionalArgumentsValue.begin() + 1,
+                                                       PositionalArgumentsValue.end());
+    std::vector<FMapGenerationResult> ResultsValue(MapDirectoriesValue.size());
+    std::atomic<size_t> NextMapIndexValue{0U};
+
+    const auto ProcessMapsValue = [&MapDirectoriesValue, &ResultsValue, &NextMapIndexValue]()
+    {
+        for (size_t MapIndexValue = NextMapIndexValue++; MapIndexValue < MapDirectoriesValue.size();
+             MapIndexValue = NextMapIndexValue++)
+        {
+            FMapGenerationResult& ResultValue = ResultsValue[MapIndexValue];
+            sc2::FMapGridDump GridDumpValue;
+            if (!sc2::FMapGridLayoutAnalyzer::LoadGridDumpDirectory(MapDirectoriesValue[MapIndexValue], GridDumpValue,
+                                                                    ResultValue.Error))
+            {
+                continue;
+            }
+
+            const sc2::FGeneratedMapLayout GeneratedMapLayoutValue =
+                sc2::FMapGridLayoutAnalyzer::Analyze(GridDumpValue);
+            ResultValue.YamlEntry = sc2::FMapGridLayoutAnalyzer::FormatYamlEntry(GeneratedMapLayoutValue);
+            ResultValue.BaseCount = GeneratedMapLayoutValue.Bases.size();
+            ResultValue.RampCount = GeneratedMapLayoutValue.Ramps.size();
+        }
+    };
+
+    const size_t WorkerCountValue = std::min<size_t>(ThreadCountValue, MapDirectoriesValue.size());
+    std::vector<std::thread> WorkersValue;
+    for (size_t WorkerIndexValue = 1U; WorkerIndexValue < WorkerCountValue; ++WorkerIndexValue)
+    {
+        WorkersValue.emplace_back(ProcessMapsValue);
+    }
+    ProcessMapsValue();
+    for (std::thread& WorkerValue : WorkersValue)
+    {
+        WorkerValue.join();
+    }
+
+    std::ofstream OutputStreamValue(OutputPathValue, std::ios::binary);
+    if (!OutputStreamValue)
+    {
+        std::cerr << "Unable to write " << OutputPathValue << std::endl;
+        return 1;
+    }
+
+    OutputStreamValue << "# Generated by map_layout_generator. Merge these entries into the Maps list of\n";
+    OutputStreamValue << "# MapLayoutDictionary.yaml and author the Spawns, Watchtowers and DestructibleRocks.\n\n";
+    OutputStreamValue << "Maps:\n";
+    int ExitCodeValue = 0;
+    for (size_t MapIndexValue = 0U; MapIndexValue < ResultsValue.size(); ++MapIndexValue)
+    {
+        const FMapGenerationResult& ResultValue = ResultsValue[MapIndexValue];
+        if (!ResultValue.Error.empty())
+        {
+            std::cerr << ResultValue.Error << std::endl;
+            ExitCodeValue = 1;
+            continue;
+        }
+
+        OutputStreamValue << ResultValue.YamlEntry << "\n";
+        std::cout << MapDirectoriesValue[MapIndexValue] << ": " << ResultValue.BaseCount << " bases, "
+                  << ResultValue.RampCount << " ramps" << std::endl;
+    }
+    return ExitCodeValue;
+}
@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sc2api/sc2_api.h"
+#include "sc2api/sc2_mock_game.h"
+#include "sc2utils/sc2_manage_process.h"
+
+// Stands in for the game so the client stack can be load-tested without it.
+//
+//   mock_game_server [options] --serve
+//   mock_game_server [options] [--clients 1,4,16,64] [--steps N]
+//
+// Options: --port N, --units N, --enemy-units N, --feature-layers N, --minimap N, --latency-us N, --jitter-us N,
+// --dispatch-threads N, --recording PATH.
+//
+// With --serve the server answers bots until a key is pressed. Otherwise each client count runs that many clients in
+// parallel through Connection, ProtoInterface and ControlImp. Each client steps, queries and acts N times, and the run
+// reports throughput plus p50, p99 and max round trips.
+
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+
+struct FClientSamples
+{
+    std::vector<uint64_t> StepMicroseconds;
+    std::vector<uint64_t> QueryMicroseconds;
+    std::vector<uint64_t> ActionMicroseconds;
+    bool bJoined = false;
+};
+
+uint64_t GetElapsedMicroseconds(const FSteadyClock::time_point& StartTimeValue)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(FSteadyClock::now() - StartTimeValue).count());
+}
+
+void RunClient(const int PortValue, const uint32_t StepCountValue, FClientSamples& OutSamplesValue)
+{
+    sc2::Agent AgentValue;
+    sc2::ControlInterface* ControlPtrValue = AgentValue.Control();
+    if (!ControlPtrValue->Connect("127.0.0.1", PortValue, 10000) ||
+        !ControlPtrValue->RequestJoinGame(sc2::CreateParticipant(sc2::Race::Terran, &AgentValue),
+                                          sc2::InterfaceSettings()) ||
+        !ControlPtrValue->WaitJoinGame() || !ControlPtrValue->GetObservation())
+    {
+        return;
+    }
+
+    OutSamplesValue.bJoined = true;
+    OutSamplesValue.StepMicroseconds.reserve(StepCountValue);
+    OutSamplesValue.QueryMicroseconds.reserve(StepCountValue);
+    OutSamplesValue.ActionMicroseconds.reserve(StepCountValue);
+    for (uint32_t StepIndexValue = 0U; StepIndexValue < StepCountValue && ControlPtrValue->IsInGame();
+         ++StepIndexValue)
+    {
+        FSteadyClock::time_point StartTimeValue = FSteadyClock::now();
+        if (!ControlPtrValue->Step(1) || !ControlPtrValue->WaitStep())
+        {
+            break;
+        }
+        ControlPtrValue->IssueEvents();
+        OutSamplesValue.StepMicroseconds.push_back(GetElapsedMicroseconds(StartTimeValue));
+
+        StartTimeValue = FSteadyClock::now();
+        AgentValue.Query()->PathingDistance(sc2::Point2D(10.0f, 10.0f), sc2::Point2D(40.0f, 50.0f));
+        OutSamplesValue.QueryMicroseconds.push_back(GetElapsedMicroseconds(StartTimeValue));
+
+        const sc2::Units SelfUnitsValue = AgentValue.Observation()->GetUnits(sc2::Unit::Alliance::Self);
+        if (!SelfUnitsValue.empty())
+        {
+            StartTimeValue = FSteadyClock::now();
+            AgentValue.Actions()->UnitCommand(SelfUnitsValue, sc2::ABILITY_ID::MOVE_MOVE, sc2::Point2D(40.0f, 50.0f));
+            AgentValue.Actions()->SendActions();
+            OutSamplesValue.ActionMicroseconds.push_back(GetElapsedMicroseconds(StartTimeValue));
+        }
+    }
+}
+
+std::string FormatPercentiles(std::vector<uint64_t>& SamplesValue)
+{
+    if (SamplesValue.empty())
+    {
+        return "-";
+    }
+
+    std::sort(SamplesValue.begin(), SamplesValue.end());
+    const auto GetPercentileValue = [&SamplesValue](const double FractionValue)
+    {
+        const size_t IndexValue = static_cast<size_t>(FractionValue * static_cast<double>(SamplesValue.size()));
+        return SamplesValue[std::min(IndexValue, SamplesValue.size() - 1U)];
+    };
+
+    std::ostringstream StreamValue;
+    StreamValue << GetPercentileValue(0.5) << "/" << GetPercentileValue(0.99) << "/" << SamplesValue.back();
+    return StreamValue.str();
+}
+
+bool RunLoadTest(const int PortValue, const uint32_t ClientCountValue, const uint32_t StepCountValue)
+{
+    std::vector<FClientSamples> SamplesValue(ClientCountValue);
+    std::vector<std::thread> ClientsValue;
+    const FSteadyClock::time_point StartTimeValue = FSteadyClock::now();
+    for (uint32_t ClientIndexValue = 0U; ClientIndexValue < ClientCountValue; ++ClientIndexValue)
+    {
+        ClientsValue.emplace_back(RunClient, PortValue, StepCountValue, std::ref(SamplesValue[ClientIndexValue]));
+    }
+    for (std::thread& ClientValue : ClientsValue)
+    {
+        ClientValue.join();
+    }
+    const uint64_t ElapsedMicrosecondsValue = std::max<uint64_t>(1U, GetElapsedMicroseconds(StartTimeValue));
+
+    FClientSamples MergedSamplesValue;
+    uint32_t JoinedCountValue = 0U;
+    for (const FClientSamples& ClientSamplesValue : SamplesValue)
+    {
+        JoinedCountValue += ClientSamplesValue.bJoined ? 1U : 0U;
+        MergedSamplesValue.StepMicroseconds.insert(MergedSamplesValue.StepMicroseconds.end(),
+                                                   ClientSamplesValue.StepMicroseconds.begin(),
+                                                   ClientSamplesValue.StepMicroseconds.end());
+        MergedSamplesValue.QueryMicroseconds.insert(MergedSamplesValue.QueryMicroseconds.end(),
+                                                    ClientSamplesValue.QueryMicroseconds.begin(),
+                                                    ClientSamplesValue.QueryMicroseconds.end());
+        MergedSamplesValue.ActionMicroseconds.insert(MergedSamplesValue.ActionMicroseconds.end(),
+                                                     ClientSamplesValue.ActionMicroseconds.begin(),
+                                                     ClientSamplesValue.ActionMicroseconds.end());
+    }
+
+    const double StepsPerSecondValue = static_cast<double>(MergedSamplesValue.StepMicroseconds.size()) * 1000000.0 /
+                                       static_cast<double>(ElapsedMicrosecondsValue);
+    std::cout << "clients " << ClientCountValue << " (" << JoinedCountValue << " joined): "
+              << static_cast<uint64_t>(StepsPerSecondValue) << " steps/s | step us p50/p99/max "
+              << FormatPercentiles(MergedSamplesValue.StepMicroseconds)
+              << " | query " << FormatPercentiles(MergedSamplesValue.QueryMicroseconds) << " | action "
+              << FormatPercentiles(MergedSamplesValue.ActionMicroseconds) << std::endl;
+    return JoinedCountValue == ClientCountValue;
+}
+
+std::vector<uint32_t> ParseClientCounts(const std::string& ListValue)
+{
+    std::vector<uint32_t> ClientCountsValue;
+    std::istringstream StreamValue(ListValue);
+    std::string EntryValue;
+    while (std::getline(StreamValue, EntryValue, ','))
+    {
+        const unsigned long ParsedValue = std::strtoul(EntryValue.c_str(), nullptr, 10);
+        if (ParsedValue > 0UL)
+        {
+            ClientCountsValue.push_back(static_cast<uint32_t>(ParsedValue));
+        }
+    }
+    return ClientCountsValue;
+}
+
+void PrintUsage()
+{
+    std::cerr << "Usage: mock_game_server [--port N] [--units N] [--enemy-units N] [--feature-layers N] [--minimap N]"
+                 " [--latency-us N] [--jitter-us N] [--dispatch-threads N] [--recording PATH]"
+                 " [--serve | --clients 1,4,16,64 --steps N]"
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    sc2::MockGameServerSettings ServerSettingsValue;
+    sc2::MockGameSettings GameSettingsValue;
+    std::vector<uint32_t> ClientCountsValue = {1U, 4U, 16U, 64U};
+    uint32_t StepCountValue = 500U;
+    bool bServeOnlyValue = false;
+
+    for (int ArgumentIndexValue = 1; ArgumentIndexValue < argc; ++ArgumentIndexValue)
+    {
+        const std::string ArgumentValue = argv[ArgumentIndexValue];
+        if (ArgumentValue == "--serve")
+        {
+            bServeOnlyValue = true;
+            continue;
+        }
+        if (ArgumentIndexValue + 1 >= argc)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        const std::string ParameterValue = argv[++ArgumentIndexValue];
+        const int NumberValue = std::atoi(ParameterValue.c_str());
+        if (ArgumentValue == "--port")
+        {
+            ServerSettingsValue.port = NumberValue;
+        }
+        else if (ArgumentValue == "--units")
+        {
+            GameSettingsValue.self_unit_count = NumberValue;
+        }
+        else if (ArgumentValue == "--enemy-units")
+        {
+            GameSettingsValue.enemy_unit_count = NumberValue;
+        }
+        else if (ArgumentValue == "--feature-layers")
+        {
+            GameSettingsValue.feature_layer_resolution = NumberValue;
+        }
+        else if (ArgumentValue == "--minimap")
+        {
+            GameSettingsValue.minimap_resolution = NumberValue;
+        }
+        else if (ArgumentValue == "--latency-us")
+        {
+            ServerSettingsValue.latency_us = static_cast<unsigned int>(std::max(0, NumberValue));
+        }
+        else if (ArgumentValue == "--jitter-us")
+        {
+            ServerSettingsValue.jitter_us = static_cast<unsigned int>(std::max(0, NumberValue));
+        }
+        else if (ArgumentValue == "--dispatch-threads")
+        {
+            ServerSettingsValue.dispatch_threads = NumberValue;
+        }
+        else if (ArgumentValue == "--recording")
+        {
+            GameSettingsValue.recording_path = ParameterValue;
+        }
+        else if (ArgumentValue == "--clients")
+        {
+            ClientCountsValue = ParseClientCounts(ParameterValue);
+        }
+        else if (ArgumentValue == "--steps")
+        {
+            StepCountValue = static_cast<uint32_t>(std::max(1, NumberValue));
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    for (const uint32_t ClientCountValue : ClientCountsValue)
+    {
+        ServerSettingsValue.max_clients = std::max<int>(ServerSettingsValue.max_clients, ClientCountValue);
+    }
+
+    sc2::MockGameServer ServerValue;
+    if (!ServerValue.Start(ServerSettingsValue, GameSettingsValue))
+    {
+        std::cerr << "Unable to start the mock game on port " << ServerSettingsValue.port << std::endl;
+        return 1;
+    }
+
+    if (bServeOnlyValue)
+    {
+        std::cout << "Serving the mock game on port " << ServerSettingsValue.port << ", press any key to stop."
+                  << std::endl;
+        while (!sc2::PollKeyPress())
+        {
+            sc2::SleepFor(100);
+        }
+        return 0;
+    }
+
+    bool bAllJoinedValue = true;
+    for (const uint32_t ClientCountValue : ClientCountsValue)
+    {
+        bAllJoinedValue = RunLoadTest(ServerSettingsValue.port, ClientCountValue, StepCountValue) && bAllJoinedValue;
+    }
+    std::cout << ServerValue.GetRequestCount() << " requests answered" << std::endl;
+    return bAllJoinedValue ? 0 : 1;
+}
@@ -32,10 +32,13 @@ int main(int argc, char* argv[]) {
         if (server.HasRequest()) {
             server.SendRequest(client.connection_);
 
-            // Block for sc2's response then queue it.
+            // Block for sc2's response then queue a copy of it. The server deletes what it sends, while the received
+            // response belongs to the connection's pool.
             SC2APIProtocol::Response* response = nullptr;
             client.Receive(response, 100000);
-            server.QueueResponse(client.connection_, response);
+            SC2APIProtocol::Response* forwarded_response = response ? new SC2APIProtocol::Response(*response) : nullptr;
+            client.ReleaseResponse(response);
+            server.QueueResponse(client.connection_, forwarded_response);
 
             std::cout << "Sending response" << std::endl;
 
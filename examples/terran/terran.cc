@@ -2,10 +2,11 @@
 
 #include <algorithm>
 #include <array>
-#include <chrono>
+#include <cstdlib>
 #include <unordered_map>
 
 #include "common/services/FTerranMainBaseLayoutRegistry.h"
+#include "sc2api/sc2_trace.h"
 #include "sc2lib/sc2_search.h"
 
 namespace sc2
@@ -20,14 +21,7 @@ constexpr int MineralRebalanceIntentPriorityValue = 322;
 constexpr uint64_t TerminalOrderCompactionIntervalStepCountValue = 120U;
 constexpr size_t TerminalOrderCompactionTriggerCountValue = 512U;
 constexpr uint64_t RecentProductionRallyCounterWindowStepCountValue = 120U;
-using FSteadyClock = std::chrono::steady_clock;
-using FSteadyTimePoint = std::chrono::time_point<FSteadyClock>;
-
-uint64_t GetElapsedMicroseconds(const FSteadyTimePoint& StartTimeValue, const FSteadyTimePoint& EndTimeValue)
-{
-    return static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(EndTimeValue - StartTimeValue).count());
-}
+constexpr const char* DefaultBuildPlacementSlotCachePathValue = "placement_slot_cache.bin";
 
 EExecutionConditionState GetExecutionConditionState(const bool ConditionValue)
 {
@@ -94,8 +88,9 @@ bool HasActiveSchedulerOrderForActorTag(const FCommandAuthoritySchedulingState&
     const size_t OrderCountValue = CommandAuthoritySchedulingStateValue.OrderIds.size();
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue] != ActorTagValue ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag != ActorTagValue ||
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -235,7 +230,8 @@ uint32_t CountActiveMandatoryOpeningTasks(const FCommandAuthoritySchedulingState
     {
         if (CommandAuthoritySchedulingStateValue.CommitmentClasses[OrderIndexValue] !=
                 ECommandCommitmentClass::MandatoryOpening ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -276,7 +272,8 @@ void PrintMandatorySlotOwners(const FCommandAuthoritySchedulingState& CommandAut
     {
         if (CommandAuthoritySchedulingStateValue.CommitmentClasses[OrderIndexValue] !=
                 ECommandCommitmentClass::MandatoryOpening ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]) ||
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState) ||
             CommandAuthoritySchedulingStateValue.PreferredPlacementSlotIdTypes[OrderIndexValue] ==
                 EBuildPlacementSlotType::Unknown)
         {
@@ -918,6 +915,13 @@ void TerranAgent::OnGameStart()
         }
     }
 
+    GroundPathfinder.Reset();
+    if (ObservationPtr->GetMapGrids() != nullptr)
+    {
+        GroundPathfinder.Initialize(*ObservationPtr->GetMapGrids());
+        GroundPathfinder.SetQueryVerificationEnabled(std::getenv("SC2_VERIFY_GROUND_PATHING") != nullptr);
+    }
+
     GameStateDescriptor.Reset();
     EconomyDomainState.Reset();
     ExecutionTelemetry.Reset();
@@ -935,8 +939,12 @@ void TerranAgent::OnGameStart()
 
     const FFrameContext Frame = FFrameContext::Create(ObservationPtr, Query(), CurrentStep);
     UpdateAgentState(Frame);
-    InitializeRampWallDescriptor(Frame);
-    InitializeMainBaseLayoutDescriptor(Frame);
+    if (!TryRestorePlacementLayoutFromCache(Frame))
+    {
+        InitializeRampWallDescriptor(Frame);
+        InitializeMainBaseLayoutDescriptor(Frame);
+        StorePlacementLayoutInCache(Frame);
+    }
 
     // Find natural choke: scan every row between ramp Y and natural Y,
     // count contiguous pathable tiles per row, find narrowest row.
@@ -1060,6 +1068,7 @@ void TerranAgent::OnGameStart()
 
     RebuildObservedGameStateDescriptor(Frame);
     RebuildEnemyObservationDescriptor(Frame);
+    RebuildSpatialFields(Frame);
     RebuildForecastState();
     RebuildExecutionPressureDescriptor(Frame);
     UpdateStrategicAndPlanningState();
@@ -1069,62 +1078,67 @@ void TerranAgent::OnGameStart()
 void TerranAgent::OnStep()
 {
     ++CurrentStep;
-    const FSteadyTimePoint StepStartTimeValue = FSteadyClock::now();
 
-    ObservationPtr = Observation();
-    if (!ObservationPtr)
     {
-        SCLOG(LoggingVerbosity::error, "ERROR in TerranAgent::OnStep() - Observation() is null");
-        return;
-    }
+        SC2_TRACE_ZONE_TIMED("TerranAgent::OnStep", LastStepMicroseconds);
+        ObservationPtr = Observation();
+        if (!ObservationPtr)
+        {
+            SCLOG(LoggingVerbosity::error, "ERROR in TerranAgent::OnStep() - Observation() is null");
+            return;
+        }
 
-    const FFrameContext Frame = FFrameContext::Create(ObservationPtr, Query(), CurrentStep);
+        FFrameContext Frame;
+        {
+            SC2_TRACE_ZONE_TIMED("TerranAgent::UpdateAgentState", LastAgentStateUpdateMicroseconds);
+            const Units AllUnitsValue = ObservationPtr->GetUnits();
+            UnitSpatialIndex.Build(AllUnitsValue);
+            GroundPathfinder.UpdateStructures(AllUnitsValue);
+            Frame = FFrameContext::Create(ObservationPtr, Query(), CurrentStep, &UnitSpatialIndex, &GroundPathfinder);
+            UpdateAgentState(Frame);
+        }
 
-    FSteadyTimePoint PhaseStartTimeValue = FSteadyClock::now();
-    UpdateAgentState(Frame);
-    FSteadyTimePoint PhaseEndTimeValue = FSteadyClock::now();
-    LastAgentStateUpdateMicroseconds = GetElapsedMicroseconds(PhaseStartTimeValue, PhaseEndTimeValue);
+        {
+            SC2_TRACE_ZONE_TIMED("TerranAgent::UpdateDispatchedSchedulerOrders", LastDispatchMaintenanceMicroseconds);
+            UpdateDispatchedSchedulerOrders(Frame);
+        }
 
-    PhaseStartTimeValue = FSteadyClock::now();
-    UpdateDispatchedSchedulerOrders(Frame);
-    PhaseEndTimeValue = FSteadyClock::now();
-    LastDispatchMaintenanceMicroseconds = GetElapsedMicroseconds(PhaseStartTimeValue, PhaseEndTimeValue);
+        {
+            SC2_TRACE_ZONE_TIMED("TerranAgent::RebuildDescriptors", LastDescriptorRebuildMicroseconds);
+            RebuildObservedGameStateDescriptor(Frame);
+            RebuildEnemyObservationDescriptor(Frame);
+            RebuildSpatialFields(Frame);
+            RebuildForecastState();
+            RebuildExecutionPressureDescriptor(Frame);
+            UpdateStrategicAndPlanningState();
+        }
 
-    PhaseStartTimeValue = FSteadyClock::now();
-    RebuildObservedGameStateDescriptor(Frame);
-    RebuildEnemyObservationDescriptor(Frame);
-    RebuildForecastState();
-    RebuildExecutionPressureDescriptor(Frame);
-    UpdateStrategicAndPlanningState();
-    PhaseEndTimeValue = FSteadyClock::now();
-    LastDescriptorRebuildMicroseconds = GetElapsedMicroseconds(PhaseStartTimeValue, PhaseEndTimeValue);
+        IntentBuffer.Reset();
+        PendingProductionRallyIntents.clear();
+        ProduceSchedulerIntents(Frame);
+        ProduceProductionRallyIntents();
+        ProduceWallGateIntents(Frame);
+        ProduceWorkerHarvestIntents(Frame);
+        ProduceRecoveryIntents(Frame);
+        UpdateExecutionTelemetry(Frame);
 
-    IntentBuffer.Reset();
-    PendingProductionRallyIntents.clear();
-    ProduceSchedulerIntents(Frame);
-    ProduceProductionRallyIntents();
-    ProduceWallGateIntents(Frame);
-    ProduceWorkerHarvestIntents(Frame);
-    ProduceRecoveryIntents(Frame);
-    UpdateExecutionTelemetry(Frame);
-
-    PhaseStartTimeValue = FSteadyClock::now();
-    ResolvedIntents = IntentArbiter.Resolve(Frame, AgentState.UnitContainer, IntentBuffer);
-    PhaseEndTimeValue = FSteadyClock::now();
-    LastIntentResolutionMicroseconds = GetElapsedMicroseconds(PhaseStartTimeValue, PhaseEndTimeValue);
-
-    PhaseStartTimeValue = FSteadyClock::now();
-    ExecuteResolvedIntents(Frame, ResolvedIntents);
-    ExecuteProductionRallyIntents();
-    ExecuteOrbitalAbilities(Frame);
-    PhaseEndTimeValue = FSteadyClock::now();
-    LastIntentExecutionMicroseconds = GetElapsedMicroseconds(PhaseStartTimeValue, PhaseEndTimeValue);
-
-    PhaseStartTimeValue = FSteadyClock::now();
-    CaptureNewlyDispatchedSchedulerOrders(Frame);
-    PhaseEndTimeValue = FSteadyClock::now();
-    LastDispatchCaptureMicroseconds = GetElapsedMicroseconds(PhaseStartTimeValue, PhaseEndTimeValue);
-    LastStepMicroseconds = GetElapsedMicroseconds(StepStartTimeValue, PhaseEndTimeValue);
+        {
+            SC2_TRACE_ZONE_TIMED("TerranAgent::ResolveIntents", LastIntentResolutionMicroseconds);
+            IntentArbiter.Resolve(Frame, AgentState.UnitContainer, IntentBuffer, ResolvedIntents);
+        }
+
+        {
+            SC2_TRACE_ZONE_TIMED("TerranAgent::ExecuteIntents", LastIntentExecutionMicroseconds);
+            ExecuteResolvedIntents(Frame, ResolvedIntents);
+            ExecuteProductionRallyIntents();
+            ExecuteOrbitalAbilities(Frame);
+        }
+
+        {
+            SC2_TRACE_ZONE_TIMED("TerranAgent::CaptureNewlyDispatchedSchedulerOrders", LastDispatchCaptureMicroseconds);
+            CaptureNewlyDispatchedSchedulerOrders(Frame);
+        }
+    }
 
     if (CurrentStep % 120 == 0)
     {
@@ -1134,6 +1148,7 @@ void TerranAgent::OnStep()
 
 void TerranAgent::OnGameEnd()
 {
+    PrintGroundPathingVerification();
     sc2::renderer::Shutdown();
 }
 
@@ -1223,6 +1238,76 @@ void TerranAgent::InitializeMainBaseLayoutDescriptor(const FFrameContext& Frame)
         BuildPlacementService->GetMainBaseLayoutDescriptor(Frame, BuildPlacementContextValue);
 }
 
+std::string TerranAgent::GetBuildPlacementSlotCachePath() const
+{
+    const char* CachePathPtrValue = std::getenv("SC2_PLACEMENT_SLOT_CACHE");
+    return CachePathPtrValue != nullptr ? std::string(CachePathPtrValue)
+                                        : std::string(DefaultBuildPlacementSlotCachePathValue);
+}
+
+bool TerranAgent::TryRestorePlacementLayoutFromCache(const FFrameContext& Frame)
+{
+    if (BuildPlacementService == nullptr || ObservationPtr == nullptr || Frame.GameInfo == nullptr)
+    {
+        return false;
+    }
+
+    const std::string CachePathValue = GetBuildPlacementSlotCachePath();
+    if (CachePathValue.empty())
+    {
+        return false;
+    }
+
+    if (!bBuildPlacementSlotCacheLoaded)
+    {
+        BuildPlacementSlotCache.LoadFromFile(CachePathValue);
+        bBuildPlacementSlotCacheLoaded = true;
+    }
+
+    const FBuildPlacementSlotCacheKey CacheKeyValue =
+        FBuildPlacementSlotCacheKey::Create(*Frame.GameInfo, CreateBuildPlacementContext());
+    if (!BuildPlacementSlotCache.TryGetLayout(CacheKeyValue, GameStateDescriptor.RampWallDescriptor,
+                                              GameStateDescriptor.MainBaseLayoutDescriptor))
+    {
+        return false;
+    }
+
+    if (!GameStateDescriptor.RampWallDescriptor.bIsValid)
+    {
+        ExecutionTelemetry.RecordWallDescriptorInvalid(CurrentStep, Frame.GameLoop);
+    }
+
+    return true;
+}
+
+void TerranAgent::StorePlacementLayoutInCache(const FFrameContext& Frame)
+{
+    if (BuildPlacementService == nullptr || ObservationPtr == nullptr || Frame.GameInfo == nullptr)
+    {
+        return;
+    }
+
+    if (!GameStateDescriptor.RampWallDescriptor.bIsValid || !GameStateDescriptor.MainBaseLayoutDescriptor.bIsValid)
+    {
+        return;
+    }
+
+    const std::string CachePathValue = GetBuildPlacementSlotCachePath();
+    if (CachePathValue.empty())
+    {
+        return;
+    }
+
+    const FBuildPlacementSlotCacheKey CacheKeyValue =
+        FBuildPlacementSlotCacheKey::Create(*Frame.GameInfo, CreateBuildPlacementContext());
+    BuildPlacementSlotCache.StoreLayout(CacheKeyValue, GameStateDescriptor.RampWallDescriptor,
+                                        GameStateDescriptor.MainBaseLayoutDescriptor);
+    if (!BuildPlacementSlotCache.SaveToFile(CachePathValue))
+    {
+        SCLOG(LoggingVerbosity::warning, "Could not write build placement slot cache to " + CachePathValue);
+    }
+}
+
 void TerranAgent::RebuildObservedGameStateDescriptor(const FFrameContext& Frame)
 {
     (void)Frame;
@@ -1250,6 +1335,16 @@ void TerranAgent::RebuildEnemyObservationDescriptor(const FFrameContext& Frame)
                                                       GameStateDescriptor.EnemyObservation);
 }
 
+void TerranAgent::RebuildSpatialFields(const FFrameContext& Frame)
+{
+    if (SpatialFieldBuilder == nullptr)
+    {
+        return;
+    }
+
+    SpatialFieldBuilder->RebuildSpatialFieldSet(Frame, GameStateDescriptor.SpatialFields);
+}
+
 void TerranAgent::RebuildForecastState()
 {
     DefaultForecastStateBuilder.RebuildForecastState(AgentState, EconomyDomainState, GameStateDescriptor);
@@ -1760,6 +1855,66 @@ void TerranAgent::PrintAgentState()
         }
     }
     std::cout << std::endl;
+    PrintGroundPathingVerification();
+}
+
+void TerranAgent::PrintGroundPathingVerification() const
+{
+    if (!GroundPathfinder.IsQueryVerificationEnabled())
+    {
+        return;
+    }
+
+    std::cout << "Ground Pathing Verification: " << GroundPathfinder.GetVerificationMismatchCount() << " of "
+              << GroundPathfinder.GetVerifiedQueryCount() << " queries disagreed with the game on reachability"
+              << std::endl;
+}
+
+void TerranAgent::WriteStepTimingCsvHeader(std::ostream& OutputStreamValue)
+{
+    OutputStreamValue << "Step,GameLoop";
+    for (const std::string& PhaseNameValue : GetStepTimingPhaseNames())
+    {
+        OutputStreamValue << "," << PhaseNameValue;
+    }
+    OutputStreamValue << "\n";
+}
+
+void TerranAgent::WriteStepTimingCsvRow(std::ostream& OutputStreamValue) const
+{
+    std::vector<uint64_t> MicrosecondsValue;
+    GetLastStepTimingMicroseconds(MicrosecondsValue);
+    OutputStreamValue << CurrentStep << "," << (ObservationPtr ? ObservationPtr->GetGameLoop() : 0U);
+    for (const uint64_t PhaseMicrosecondsValue : MicrosecondsValue)
+    {
+        OutputStreamValue << "," << PhaseMicrosecondsValue;
+    }
+    OutputStreamValue << "\n";
+}
+
+const std::vector<std::string>& TerranAgent::GetStepTimingPhaseNames()
+{
+    static const std::vector<std::string> PhaseNamesValue = {
+        "Total", "State",    "Descriptor", "DispatchUpdate", "Strategic", "Economy", "Army",
+        "Squad", "UnitExec", "Drain",      "Resolve",        "Execute",   "Capture"};
+    return PhaseNamesValue;
+}
+
+void TerranAgent::GetLastStepTimingMicroseconds(std::vector<uint64_t>& OutMicrosecondsValue) const
+{
+    OutMicrosecondsValue = {LastStepMicroseconds,
+                            LastAgentStateUpdateMicroseconds,
+                            LastDescriptorRebuildMicroseconds,
+                            LastDispatchMaintenanceMicroseconds,
+                            LastSchedulerStrategicProcessingMicroseconds,
+                            LastSchedulerEconomyProcessingMicroseconds,
+                            LastSchedulerArmyProcessingMicroseconds,
+                            LastSchedulerSquadProcessingMicroseconds,
+                            LastSchedulerUnitExecutionProcessingMicroseconds,
+                            LastSchedulerDrainMicroseconds,
+                            LastIntentResolutionMicroseconds,
+                            LastIntentExecutionMicroseconds,
+                            LastDispatchCaptureMicroseconds};
 }
 
 void TerranAgent::PrintWallState() const
@@ -1941,10 +2096,16 @@ void TerranAgent::UpdateExecutionTelemetry(const FFrameContext& Frame)
 
     const FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue =
         GameStateDescriptor.CommandAuthoritySchedulingState;
+    if (!CommandAuthoritySchedulingStateValue.HasDiagnosticColumns())
+    {
+        return;
+    }
+
     const size_t OrderCountValue = CommandAuthoritySchedulingStateValue.OrderIds.size();
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.LastDeferralSteps[OrderIndexValue] != CurrentStep ||
+        if (CommandAuthoritySchedulingStateValue.DiagnosticColumns.LastDeferralSteps[OrderIndexValue] !=
+                CurrentStep ||
             CommandAuthoritySchedulingStateValue.LastDeferralReasons[OrderIndexValue] ==
                 ECommandOrderDeferralReason::None)
         {
@@ -1954,9 +2115,9 @@ void TerranAgent::UpdateExecutionTelemetry(const FFrameContext& Frame)
         ExecutionTelemetry.RecordSchedulerOrderDeferred(
             CurrentStep, Frame.GameLoop, CommandAuthoritySchedulingStateValue.OrderIds[OrderIndexValue],
             CommandAuthoritySchedulingStateValue.PlanStepIds[OrderIndexValue],
-            CommandAuthoritySchedulingStateValue.ActorTags[OrderIndexValue],
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag,
             CommandAuthoritySchedulingStateValue.AbilityIds[OrderIndexValue],
-            CommandAuthoritySchedulingStateValue.IntentDomains[OrderIndexValue],
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].IntentDomain,
             CommandAuthoritySchedulingStateValue.LastDeferralReasons[OrderIndexValue]);
     }
 }
@@ -2004,23 +2165,22 @@ void TerranAgent::ProduceSchedulerIntents(const FFrameContext& Frame)
 {
     FCommandAuthoritySchedulingState& CommandAuthoritySchedulingStateValue =
         GameStateDescriptor.CommandAuthoritySchedulingState;
-    const FSteadyTimePoint StrategicPhaseStartTimeValue = FSteadyClock::now();
 
-    if (CommandTaskAdmissionService != nullptr)
     {
-        CommandAuthorityProcessor.ProcessSchedulerStep(GameStateDescriptor, *CommandTaskAdmissionService);
-    }
-    else
-    {
-        CommandAuthorityProcessor.ProcessSchedulerStep(GameStateDescriptor);
+        SC2_TRACE_ZONE_TIMED("TerranAgent::SchedulerStrategic", LastSchedulerStrategicProcessingMicroseconds);
+        if (CommandTaskAdmissionService != nullptr)
+        {
+            CommandAuthorityProcessor.ProcessSchedulerStep(GameStateDescriptor, *CommandTaskAdmissionService);
+        }
+        else
+        {
+            CommandAuthorityProcessor.ProcessSchedulerStep(GameStateDescriptor);
+        }
     }
-    FSteadyTimePoint StrategicPhaseEndTimeValue = FSteadyClock::now();
-    LastSchedulerStrategicProcessingMicroseconds =
-        GetElapsedMicroseconds(StrategicPhaseStartTimeValue, StrategicPhaseEndTimeValue);
 
     if (EconomyProductionOrderExpander != nullptr && BuildPlacementService != nullptr)
     {
-        const FSteadyTimePoint EconomyPhaseStartTimeValue = FSteadyClock::now();
+        SC2_TRACE_ZONE_TIMED("TerranAgent::SchedulerEconomy", LastSchedulerEconomyProcessingMicroseconds);
         const uint32_t RecoveryMoveIntentCountBeforeValue = CountRecoveryMoveIntents(IntentBuffer);
         CommandAuthoritySchedulingStateValue.BeginMutationBatch();
         EconomyProductionOrderExpander->ExpandEconomyAndProductionOrders(
@@ -2035,10 +2195,6 @@ void TerranAgent::ProduceSchedulerIntents(const FFrameContext& Frame)
             RecoveryMoveIntentCountAfterValue >= RecoveryMoveIntentCountBeforeValue
                 ? (RecoveryMoveIntentCountAfterValue - RecoveryMoveIntentCountBeforeValue)
                 : 0U;
-
-        const FSteadyTimePoint EconomyPhaseEndTimeValue = FSteadyClock::now();
-        LastSchedulerEconomyProcessingMicroseconds =
-            GetElapsedMicroseconds(EconomyPhaseStartTimeValue, EconomyPhaseEndTimeValue);
     }
     else
     {
@@ -2049,7 +2205,7 @@ void TerranAgent::ProduceSchedulerIntents(const FFrameContext& Frame)
 
     if (ArmyOrderExpander != nullptr)
     {
-        const FSteadyTimePoint ArmyPhaseStartTimeValue = FSteadyClock::now();
+        SC2_TRACE_ZONE_TIMED("TerranAgent::SchedulerArmy", LastSchedulerArmyProcessingMicroseconds);
         CommandAuthoritySchedulingStateValue.BeginMutationBatch();
         ArmyOrderExpander->ExpandArmyOrders(Frame, AgentState, GameStateDescriptor, ExpansionLocations, ArmyAssemblyPoint,
                                             GameStateDescriptor.CommandAuthoritySchedulingState);
@@ -2058,17 +2214,11 @@ void TerranAgent::ProduceSchedulerIntents(const FFrameContext& Frame)
             ArmyPlanner->ProduceArmyPlan(GameStateDescriptor, GameStateDescriptor.ArmyState);
         }
         CommandAuthoritySchedulingStateValue.EndMutationBatch();
-        const FSteadyTimePoint ArmyPhaseEndTimeValue = FSteadyClock::now();
-        LastSchedulerArmyProcessingMicroseconds =
-            GetElapsedMicroseconds(ArmyPhaseStartTimeValue, ArmyPhaseEndTimeValue);
     }
     else if (ArmyPlanner != nullptr)
     {
-        const FSteadyTimePoint ArmyPhaseStartTimeValue = FSteadyClock::now();
+        SC2_TRACE_ZONE_TIMED("TerranAgent::SchedulerArmy", LastSchedulerArmyProcessingMicroseconds);
         ArmyPlanner->ProduceArmyPlan(GameStateDescriptor, GameStateDescriptor.ArmyState);
-        const FSteadyTimePoint ArmyPhaseEndTimeValue = FSteadyClock::now();
-        LastSchedulerArmyProcessingMicroseconds =
-            GetElapsedMicroseconds(ArmyPhaseStartTimeValue, ArmyPhaseEndTimeValue);
     }
     else
     {
@@ -2077,14 +2227,11 @@ void TerranAgent::ProduceSchedulerIntents(const FFrameContext& Frame)
 
     if (SquadOrderExpander != nullptr)
     {
-        const FSteadyTimePoint SquadPhaseStartTimeValue = FSteadyClock::now();
+        SC2_TRACE_ZONE_TIMED("TerranAgent::SchedulerSquad", LastSchedulerSquadProcessingMicroseconds);
         CommandAuthoritySchedulingStateValue.BeginMutationBatch();
         SquadOrderExpander->ExpandSquadOrders(Frame, AgentState, GameStateDescriptor, ArmyAssemblyPoint,
                                               GameStateDescriptor.CommandAuthoritySchedulingState);
         CommandAuthoritySchedulingStateValue.EndMutationBatch();
-        const FSteadyTimePoint SquadPhaseEndTimeValue = FSteadyClock::now();
-        LastSchedulerSquadProcessingMicroseconds =
-            GetElapsedMicroseconds(SquadPhaseStartTimeValue, SquadPhaseEndTimeValue);
     }
     else
     {
@@ -2093,17 +2240,14 @@ void TerranAgent::ProduceSchedulerIntents(const FFrameContext& Frame)
 
     if (UnitExecutionPlanner != nullptr)
     {
-        const FSteadyTimePoint UnitExecutionPhaseStartTimeValue = FSteadyClock::now();
+        SC2_TRACE_ZONE_TIMED("TerranAgent::SchedulerUnitExecution", LastSchedulerUnitExecutionProcessingMicroseconds);
         CommandAuthoritySchedulingStateValue.BeginMutationBatch();
         LastArmyExecutionOrderCount = UnitExecutionPlanner->ExpandUnitExecutionOrders(
             Frame, AgentState, GameStateDescriptor, ArmyAssemblyPoint, GameStateDescriptor.CommandAuthoritySchedulingState);
         LastUnitExecutionReplanCount = LastArmyExecutionOrderCount;
         CommandAuthoritySchedulingStateValue.EndMutationBatch();
         LastActiveIndexedExecutionOrderCount = static_cast<uint32_t>(
-            GameStateDescriptor.CommandAuthoritySchedulingState.ActiveExecutionOrderIndexByActorTag.size());
-        const FSteadyTimePoint UnitExecutionPhaseEndTimeValue = FSteadyClock::now();
-        LastSchedulerUnitExecutionProcessingMicroseconds =
-            GetElapsedMicroseconds(UnitExecutionPhaseStartTimeValue, UnitExecutionPhaseEndTimeValue);
+            GameStateDescriptor.CommandAuthoritySchedulingState.ActiveExecutionOrderIndexByActorTag.GetCount());
     }
     else
     {
@@ -2118,11 +2262,9 @@ void TerranAgent::ProduceSchedulerIntents(const FFrameContext& Frame)
         CommandTaskPriorityService->UpdateTaskPriorities(GameStateDescriptor);
     }
 
-    const FSteadyTimePoint DrainPhaseStartTimeValue = FSteadyClock::now();
+    SC2_TRACE_ZONE_TIMED("TerranAgent::SchedulerDrain", LastSchedulerDrainMicroseconds);
     IntentSchedulingService.DrainReadyIntents(GameStateDescriptor.CommandAuthoritySchedulingState, IntentBuffer,
                                               GameStateDescriptor.CommandAuthoritySchedulingState.MaxUnitIntentsPerStep);
-    const FSteadyTimePoint DrainPhaseEndTimeValue = FSteadyClock::now();
-    LastSchedulerDrainMicroseconds = GetElapsedMicroseconds(DrainPhaseStartTimeValue, DrainPhaseEndTimeValue);
 }
 
 void TerranAgent::ProduceWallGateIntents(const FFrameContext& Frame)
@@ -2542,54 +2684,56 @@ void TerranAgent::UpdateDispatchedSchedulerOrders(const FFrameContext& Frame)
     for (const size_t OrderIndexValue : DispatchedOrderIndicesValue)
     {
         if (!CommandAuthoritySchedulingStateValue.IsOrderIndexValid(OrderIndexValue) ||
-            CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::UnitExecution ||
-            CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue] != EOrderLifecycleState::Dispatched)
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
+                ECommandAuthorityLayer::UnitExecution ||
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState !=
+                EOrderLifecycleState::Dispatched)
         {
             continue;
         }
 
-        const FCommandOrderRecord CommandOrderRecordValue =
-            CommandAuthoritySchedulingStateValue.GetOrderRecord(OrderIndexValue);
-        const uint32_t CurrentObservedCountValue = GetObservedCountForOrder(CommandOrderRecordValue);
+        const FCommandOrderView CommandOrderViewValue =
+            CommandAuthoritySchedulingStateValue.GetOrderView(OrderIndexValue);
+        const uint32_t CurrentObservedCountValue = GetObservedCountForOrder(CommandOrderViewValue);
         const uint32_t CurrentObservedInConstructionCountValue =
-            GetObservedInConstructionCountForOrder(CommandOrderRecordValue);
-        if (CurrentObservedCountValue > CommandOrderRecordValue.ObservedCountAtDispatch ||
+            GetObservedInConstructionCountForOrder(CommandOrderViewValue);
+        if (CurrentObservedCountValue > CommandOrderViewValue.GetObservedCountAtDispatch() ||
             CurrentObservedInConstructionCountValue >
-                CommandOrderRecordValue.ObservedInConstructionCountAtDispatch)
+                CommandOrderViewValue.GetObservedInConstructionCountAtDispatch())
         {
-            CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(CommandOrderRecordValue.OrderId,
+            CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(CommandOrderViewValue.GetOrderId(),
                                                                        EOrderLifecycleState::Completed);
             continue;
         }
 
-        const Unit* ActorUnitValue = AgentState.UnitContainer.GetUnitByTag(CommandOrderRecordValue.ActorTag);
-        if (ActorUnitValue == nullptr && CommandOrderRecordValue.DispatchGameLoop > 0U &&
-            GameStateDescriptor.CurrentGameLoop > CommandOrderRecordValue.DispatchGameLoop)
+        const Unit* ActorUnitValue = AgentState.UnitContainer.GetUnitByTag(CommandOrderViewValue.GetActorTag());
+        if (ActorUnitValue == nullptr && CommandOrderViewValue.GetDispatchGameLoop() > 0U &&
+            GameStateDescriptor.CurrentGameLoop > CommandOrderViewValue.GetDispatchGameLoop())
         {
-            CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(CommandOrderRecordValue.OrderId,
+            CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(CommandOrderViewValue.GetOrderId(),
                                                                        EOrderLifecycleState::Aborted);
             continue;
         }
 
-        if (HasProducerConfirmedDispatchedOrder(CommandOrderRecordValue, ActorUnitValue))
+        if (HasProducerConfirmedDispatchedOrder(CommandOrderViewValue, ActorUnitValue))
         {
-            CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(CommandOrderRecordValue.OrderId,
+            CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(CommandOrderViewValue.GetOrderId(),
                                                                        EOrderLifecycleState::Completed);
             continue;
         }
 
         const uint64_t DispatchConfirmationTimeoutGameLoopsValue =
-            DoesAbilityRequireObservedConstructionConfirmation(CommandOrderRecordValue.AbilityId)
+            DoesAbilityRequireObservedConstructionConfirmation(CommandOrderViewValue.GetAbilityId())
                 ? ObservedConstructionConfirmationTimeoutGameLoopsValue
                 : ProducerConfirmationTimeoutGameLoopsValue;
-        if (CommandOrderRecordValue.DispatchGameLoop == 0U ||
+        if (CommandOrderViewValue.GetDispatchGameLoop() == 0U ||
             GameStateDescriptor.CurrentGameLoop <
-                (CommandOrderRecordValue.DispatchGameLoop + DispatchConfirmationTimeoutGameLoopsValue))
+                (CommandOrderViewValue.GetDispatchGameLoop() + DispatchConfirmationTimeoutGameLoopsValue))
         {
             continue;
         }
 
-        CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(CommandOrderRecordValue.OrderId,
+        CommandAuthoritySchedulingStateValue.SetOrderLifecycleState(CommandOrderViewValue.GetOrderId(),
                                                                    EOrderLifecycleState::Aborted);
     }
     const bool bCompactionIntervalElapsedValue =
@@ -2611,18 +2755,20 @@ void TerranAgent::CaptureNewlyDispatchedSchedulerOrders(const FFrameContext& Fra
     const size_t OrderCountValue = CommandAuthoritySchedulingStateValue.OrderIds.size();
     for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::UnitExecution ||
-            CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue] != EOrderLifecycleState::Dispatched ||
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
+                ECommandAuthorityLayer::UnitExecution ||
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState !=
+                EOrderLifecycleState::Dispatched ||
             CommandAuthoritySchedulingStateValue.DispatchAttemptCounts[OrderIndexValue] > 0U)
         {
             continue;
         }
 
-        const FCommandOrderRecord CommandOrderRecordValue =
-            CommandAuthoritySchedulingStateValue.GetOrderRecord(OrderIndexValue);
+        const FCommandOrderView CommandOrderViewValue =
+            CommandAuthoritySchedulingStateValue.GetOrderView(OrderIndexValue);
         CommandAuthoritySchedulingStateValue.SetOrderDispatchState(
-            CommandOrderRecordValue.OrderId, CurrentStep, Frame.GameLoop, GetObservedCountForOrder(CommandOrderRecordValue),
-            GetObservedInConstructionCountForOrder(CommandOrderRecordValue));
+            CommandOrderViewValue.GetOrderId(), CurrentStep, Frame.GameLoop, GetObservedCountForOrder(CommandOrderViewValue),
+            GetObservedInConstructionCountForOrder(CommandOrderViewValue));
     }
 }
 
@@ -2657,9 +2803,9 @@ uint32_t TerranAgent::CountOrdersAndIntentsForAbility(const ABILITY_ID AbilityId
     return OrderCountValue;
 }
 
-uint32_t TerranAgent::GetObservedCountForOrder(const FCommandOrderRecord& CommandOrderRecordValue) const
+uint32_t TerranAgent::GetObservedCountForOrder(const FCommandOrderView& CommandOrderViewValue) const
 {
-    switch (CommandOrderRecordValue.ResultUnitTypeId)
+    switch (CommandOrderViewValue.GetResultUnitTypeId())
     {
         case UNIT_TYPEID::TERRAN_COMMANDCENTER:
             return GameStateDescriptor.BuildPlanning.ObservedTownHallCount;
@@ -2709,44 +2855,44 @@ uint32_t TerranAgent::GetObservedCountForOrder(const FCommandOrderRecord& Comman
             break;
     }
 
-    if (IsTerranBuilding(CommandOrderRecordValue.ResultUnitTypeId))
+    if (IsTerranBuilding(CommandOrderViewValue.GetResultUnitTypeId()))
     {
-        const size_t BuildingTypeIndexValue = GetTerranBuildingTypeIndex(CommandOrderRecordValue.ResultUnitTypeId);
+        const size_t BuildingTypeIndexValue = GetTerranBuildingTypeIndex(CommandOrderViewValue.GetResultUnitTypeId());
         return IsTerranBuildingTypeIndexValid(BuildingTypeIndexValue)
                    ? static_cast<uint32_t>(GameStateDescriptor.BuildPlanning.ObservedBuildingCounts[BuildingTypeIndexValue])
                    : 0U;
     }
 
-    const size_t UnitTypeIndexValue = GetTerranUnitTypeIndex(CommandOrderRecordValue.ResultUnitTypeId);
+    const size_t UnitTypeIndexValue = GetTerranUnitTypeIndex(CommandOrderViewValue.GetResultUnitTypeId());
     return IsTerranUnitTypeIndexValid(UnitTypeIndexValue)
                ? static_cast<uint32_t>(GameStateDescriptor.BuildPlanning.ObservedUnitCounts[UnitTypeIndexValue])
                : 0U;
 }
 
-uint32_t TerranAgent::GetObservedInConstructionCountForOrder(const FCommandOrderRecord& CommandOrderRecordValue) const
+uint32_t TerranAgent::GetObservedInConstructionCountForOrder(const FCommandOrderView& CommandOrderViewValue) const
 {
-    if (CommandOrderRecordValue.ResultUnitTypeId == UNIT_TYPEID::TERRAN_COMMANDCENTER)
+    if (CommandOrderViewValue.GetResultUnitTypeId() == UNIT_TYPEID::TERRAN_COMMANDCENTER)
     {
         return static_cast<uint32_t>(GameStateDescriptor.BuildPlanning.ObservedBuildingsInConstruction[
             GetTerranBuildingTypeIndex(UNIT_TYPEID::TERRAN_COMMANDCENTER)]);
     }
 
-    if (IsTerranBuilding(CommandOrderRecordValue.ResultUnitTypeId))
+    if (IsTerranBuilding(CommandOrderViewValue.GetResultUnitTypeId()))
     {
-        const size_t BuildingTypeIndexValue = GetTerranBuildingTypeIndex(CommandOrderRecordValue.ResultUnitTypeId);
+        const size_t BuildingTypeIndexValue = GetTerranBuildingTypeIndex(CommandOrderViewValue.GetResultUnitTypeId());
         return IsTerranBuildingTypeIndexValid(BuildingTypeIndexValue)
                    ? static_cast<uint32_t>(
                          GameStateDescriptor.BuildPlanning.ObservedBuildingsInConstruction[BuildingTypeIndexValue])
                    : 0U;
     }
 
-    const size_t UnitTypeIndexValue = GetTerranUnitTypeIndex(CommandOrderRecordValue.ResultUnitTypeId);
+    const size_t UnitTypeIndexValue = GetTerranUnitTypeIndex(CommandOrderViewValue.GetResultUnitTypeId());
     return IsTerranUnitTypeIndexValid(UnitTypeIndexValue)
                ? static_cast<uint32_t>(GameStateDescriptor.BuildPlanning.ObservedUnitsInConstruction[UnitTypeIndexValue])
                : 0U;
 }
 
-bool TerranAgent::HasProducerConfirmedDispatchedOrder(const FCommandOrderRecord& CommandOrderRecordValue,
+bool TerranAgent::HasProducerConfirmedDispatchedOrder(const FCommandOrderView& CommandOrderViewValue,
                                                       const Unit* ActorUnitValue) const
 {
     if (ActorUnitValue == nullptr)
@@ -2754,18 +2900,18 @@ bool TerranAgent::HasProducerConfirmedDispatchedOrder(const FCommandOrderRecord&
         return false;
     }
 
-    if (DoesAbilityRequireObservedConstructionConfirmation(CommandOrderRecordValue.AbilityId))
+    if (DoesAbilityRequireObservedConstructionConfirmation(CommandOrderViewValue.GetAbilityId()))
     {
         return false;
     }
 
-    if (CommandOrderRecordValue.AbilityId == ABILITY_ID::MORPH_ORBITALCOMMAND &&
+    if (CommandOrderViewValue.GetAbilityId() == ABILITY_ID::MORPH_ORBITALCOMMAND &&
         ActorUnitValue->unit_type.ToType() == UNIT_TYPEID::TERRAN_ORBITALCOMMAND)
     {
         return true;
     }
 
-    if (IsTerranAddonBuildAbility(CommandOrderRecordValue.AbilityId) &&
+    if (IsTerranAddonBuildAbility(CommandOrderViewValue.GetAbilityId()) &&
         ActorUnitValue->add_on_tag != NullTag)
     {
         return true;
@@ -2773,7 +2919,7 @@ bool TerranAgent::HasProducerConfirmedDispatchedOrder(const FCommandOrderRecord&
 
     for (const UnitOrder& UnitOrderValue : ActorUnitValue->orders)
     {
-        if (UnitOrderValue.ability_id == CommandOrderRecordValue.AbilityId)
+        if (UnitOrderValue.ability_id == CommandOrderViewValue.GetAbilityId())
         {
             return true;
         }
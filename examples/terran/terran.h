@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <iostream>
 #include <limits>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -23,6 +24,7 @@
 #include "common/planning/FTerranSquadOrderExpander.h"
 #include "common/planning/FTerranTimingAttackBuildPlanner.h"
 #include "common/planning/FCommandAuthorityProcessor.h"
+#include "common/planning/FCommandOrderView.h"
 #include "common/planning/FDefaultStrategicDirector.h"
 #include "common/planning/IArmyPlanner.h"
 #include "common/planning/IArmyOrderExpander.h"
@@ -39,10 +41,15 @@
 #include "common/descriptors/IEnemyObservationBuilder.h"
 #include "common/catalogs/FMapLayoutDictionary.h"
 #include "common/catalogs/FMapQueryHelper.h"
+#include "common/services/FBuildPlacementSlotCache.h"
 #include "common/services/FTerranBuildPlacementService.h"
+#include "common/services/FTerranSpatialFieldBuilder.h"
 #include "common/services/FTerranWorkerSelectionService.h"
 #include "common/services/IBuildPlacementService.h"
+#include "common/services/ISpatialFieldBuilder.h"
 #include "common/services/IWorkerSelectionService.h"
+#include "common/spatial/FGroundPathfinder.h"
+#include "common/spatial/FUnitSpatialIndex.h"
 #include "common/telemetry/FAgentExecutionTelemetry.h"
 
 #include "sc2api/sc2_api.h"
@@ -70,14 +77,26 @@ public:
     void UpdateAgentState(const FFrameContext& Frame);
     void InitializeRampWallDescriptor(const FFrameContext& Frame);
     void InitializeMainBaseLayoutDescriptor(const FFrameContext& Frame);
+    std::string GetBuildPlacementSlotCachePath() const;
+    bool TryRestorePlacementLayoutFromCache(const FFrameContext& Frame);
+    void StorePlacementLayoutInCache(const FFrameContext& Frame);
     void RebuildObservedGameStateDescriptor(const FFrameContext& Frame);
     void RebuildEnemyObservationDescriptor(const FFrameContext& Frame);
+    void RebuildSpatialFields(const FFrameContext& Frame);
     void RebuildForecastState();
     void RebuildExecutionPressureDescriptor(const FFrameContext& Frame);
     void UpdateStrategicAndPlanningState();
     void UpdateRallyAnchor();
     void PrintAgentState();
     void PrintWallState() const;
+    // Reachability disagreements between the local pathfinder and the game, when SC2_VERIFY_GROUND_PATHING is set.
+    void PrintGroundPathingVerification() const;
+    // One row per step of the per-phase timings from the last OnStep, for offline benchmarking.
+    static void WriteStepTimingCsvHeader(std::ostream& OutputStreamValue);
+    void WriteStepTimingCsvRow(std::ostream& OutputStreamValue) const;
+    // The same timings by phase, named as the CSV columns after Step and GameLoop.
+    static const std::vector<std::string>& GetStepTimingPhaseNames();
+    void GetLastStepTimingMicroseconds(std::vector<uint64_t>& OutMicrosecondsValue) const;
     FBuildPlacementContext CreateBuildPlacementContext() const;
 
     void ProduceRecoveryIntents(const FFrameContext& Frame);
@@ -93,9 +112,9 @@ public:
     void CaptureNewlyDispatchedSchedulerOrders(const FFrameContext& Frame);
 
     uint32_t CountOrdersAndIntentsForAbility(ABILITY_ID AbilityIdValue) const;
-    uint32_t GetObservedCountForOrder(const FCommandOrderRecord& CommandOrderRecordValue) const;
-    uint32_t GetObservedInConstructionCountForOrder(const FCommandOrderRecord& CommandOrderRecordValue) const;
-    bool HasProducerConfirmedDispatchedOrder(const FCommandOrderRecord& CommandOrderRecordValue,
+    uint32_t GetObservedCountForOrder(const FCommandOrderView& CommandOrderViewValue) const;
+    uint32_t GetObservedInConstructionCountForOrder(const FCommandOrderView& CommandOrderViewValue) const;
+    bool HasProducerConfirmedDispatchedOrder(const FCommandOrderView& CommandOrderViewValue,
                                              const Unit* ActorUnitValue) const;
 
     const Unit* FindNearestMineralPatch(const Point2D& OriginPointValue) const;
@@ -136,6 +155,8 @@ private:
     uint64_t CurrentStep{0};
     FIntentBuffer IntentBuffer;
     FIntentArbiter IntentArbiter;
+    FUnitSpatialIndex UnitSpatialIndex;
+    FGroundPathfinder GroundPathfinder;
     std::unordered_set<Tag> PendingRecoveryWorkers;
     FGameStateDescriptor GameStateDescriptor;
     FEconomyDomainState EconomyDomainState;
@@ -165,10 +186,15 @@ private:
     const IWallGateController* WallGateController{&DefaultWallGateController};
     FTerranBuildPlacementService DefaultBuildPlacementService;
     const IBuildPlacementService* BuildPlacementService{&DefaultBuildPlacementService};
+    // Resolved layouts from earlier games, keyed by map placement grid and spawn; loaded once per process.
+    FBuildPlacementSlotCache BuildPlacementSlotCache;
+    bool bBuildPlacementSlotCacheLoaded{false};
     FTerranWorkerSelectionService DefaultWorkerSelectionService;
     const IWorkerSelectionService* WorkerSelectionService{&DefaultWorkerSelectionService};
     FTerranEnemyObservationBuilder DefaultEnemyObservationBuilder;
     const IEnemyObservationBuilder* EnemyObservationBuilder{&DefaultEnemyObservationBuilder};
+    FTerranSpatialFieldBuilder DefaultSpatialFieldBuilder;
+    const ISpatialFieldBuilder* SpatialFieldBuilder{&DefaultSpatialFieldBuilder};
 
     // Per-map static layout data, initialized once at game start
     const FMapDescriptor* MapDescriptorPtrValue{nullptr};
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "sc2api/sc2_api.h"
+
+#include "terran/terran.h"
+
+// Replays a recorded game through TerranAgent without the game binary and writes per-step timings as CSV.
+//
+//   terran_playback_benchmark <recording> <timings.csv>
+//
+// Record a game by running the tutorial with SC2_TUTORIAL_RECORD_PROTO=<recording>. The agent sees the recorded
+// observations frame for frame; its actions are acknowledged but do not change the game, so every build of the bot
+// is measured against the same frames.
+
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+
+uint64_t GetElapsedMicroseconds(const FSteadyClock::time_point& StartTimeValue,
+                                const FSteadyClock::time_point& EndTimeValue)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(EndTimeValue - StartTimeValue).count());
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: terran_playback_benchmark <recording> <timings.csv>" << std::endl;
+        return 1;
+    }
+
+    const std::string RecordingPathValue = argv[1];
+    std::ofstream TimingStreamValue(argv[2], std::ios::binary);
+    if (!TimingStreamValue)
+    {
+        std::cerr << "Unable to write " << argv[2] << std::endl;
+        return 1;
+    }
+
+    sc2::TerranAgent AgentValue;
+    sc2::ControlInterface* ControlPtrValue = AgentValue.Control();
+    if (!ControlPtrValue->Proto().StartPlayback(RecordingPathValue))
+    {
+        std::cerr << "Unable to play back " << RecordingPathValue << std::endl;
+        return 1;
+    }
+
+    // Same sequence the coordinator runs against a live game.
+    if (!ControlPtrValue->Connect("playback", 0, sc2::kDefaultProtoInterfaceTimeout) ||
+        !ControlPtrValue->RequestJoinGame(sc2::CreateParticipant(sc2::Race::Terran, &AgentValue),
+                                          sc2::InterfaceSettings()) ||
+        !ControlPtrValue->WaitJoinGame() || !ControlPtrValue->GetObservation())
+    {
+        std::cerr << "Recording does not start with a joined game." << std::endl;
+        return 1;
+    }
+
+    const FSteadyClock::time_point RunStartTimeValue = FSteadyClock::now();
+    AgentValue.OnGameFullStart();
+    ControlPtrValue->OnGameStart();
+    AgentValue.OnGameStart();
+    ControlPtrValue->IssueEvents(AgentValue.Actions()->Commands());
+
+    TimingStreamValue << "ObservationUpdate,";
+    sc2::TerranAgent::WriteStepTimingCsvHeader(TimingStreamValue);
+    uint64_t StepCountValue = 0U;
+    uint64_t TotalObservationMicrosecondsValue = 0U;
+    uint64_t TotalStepMicrosecondsValue = 0U;
+    while (ControlPtrValue->IsInGame())
+    {
+        const FSteadyClock::time_point ObservationStartTimeValue = FSteadyClock::now();
+        if (!ControlPtrValue->Step(1) || !ControlPtrValue->WaitStep())
+        {
+            break;
+        }
+        const uint64_t ObservationMicrosecondsValue =
+            GetElapsedMicroseconds(ObservationStartTimeValue, FSteadyClock::now());
+        if (!ControlPtrValue->IsInGame())
+        {
+            break;
+        }
+
+        const FSteadyClock::time_point StepStartTimeValue = FSteadyClock::now();
+        ControlPtrValue->IssueEvents(AgentValue.Actions()->Commands());
+        AgentValue.Actions()->SendActions();
+        TotalStepMicrosecondsValue += GetElapsedMicroseconds(StepStartTimeValue, FSteadyClock::now());
+        TotalObservationMicrosecondsValue += ObservationMicrosecondsValue;
+        ++StepCountValue;
+
+        TimingStreamValue << ObservationMicrosecondsValue << ",";
+        AgentValue.WriteStepTimingCsvRow(TimingStreamValue);
+    }
+    AgentValue.OnGameEnd();
+    const uint64_t RunMicrosecondsValue = GetElapsedMicroseconds(RunStartTimeValue, FSteadyClock::now());
+
+    const sc2::ProtoPlayback* PlaybackPtrValue = ControlPtrValue->Proto().GetPlayback();
+    std::cout << "Replayed " << StepCountValue << " steps of " << PlaybackPtrValue->GetObservationCount()
+              << " recorded observations in " << RunMicrosecondsValue / 1000U << " ms" << std::endl;
+    if (StepCountValue > 0U)
+    {
+        std::cout << "Mean observation update " << TotalObservationMicrosecondsValue / StepCountValue
+                  << " us, mean step " << TotalStepMicrosecondsValue / StepCountValue << " us" << std::endl;
+    }
+    std::cout << "Queries answered from the recording: " << PlaybackPtrValue->GetMatchedQueryCount() << std::endl;
+    return 0;
+}
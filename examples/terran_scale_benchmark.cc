@@ -0,0 +1,432 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "s2clientprotocol/sc2api.pb.h"
+#include "sc2api/sc2_api.h"
+#include "sc2api/sc2_mock_game.h"
+#include "sc2api/sc2_proto_recording.h"
+#include "sc2api/sc2_trace.h"
+
+#include "terran/terran.h"
+
+// Runs TerranAgent against synthetic games of growing size and reports which phases of a step outgrow the frame.
+//
+//   terran_scale_benchmark [--scales 50,200,500,1000] [--steps N] [--output PATH] [--trace PREFIX]
+//
+// For each scale the mock game writes a recording in which both sides field that many units: a Terran base and bio
+// army against a Zerg base and ling-roach army, each army circling its quarter of the map. The agent then plays the
+// recording back through the client stack like terran_playback_benchmark, so every OnStep phase runs on the same
+// frames. The recording holds no queries, so the placement and pathing queries the agent sends are answered live by a
+// mock game with the same settings: straight-line distances and successful placements. The report is JSON: p50, p99 and max microseconds per phase, heap allocations per observation update and
+// per agent step, and the number of frames that overran the real-time frame budget. With --trace each scale also
+// reports the histogram of every trace zone and writes its zones to PREFIX_<units>.json for chrome://tracing.
+
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+
+// One game loop at faster speed is 1/22.4 s.
+constexpr uint64_t FrameBudgetMicroseconds = 44000U;
+
+std::atomic<uint64_t> AllocationCount{0U};
+
+struct FScaleSamples
+{
+    uint32_t UnitCount = 0U;
+    uint64_t OverBudgetFrameCount = 0U;
+    uint64_t MockAnsweredQueryCount = 0U;
+    std::vector<uint64_t> ObservationUpdateMicroseconds;
+    std::vector<uint64_t> AgentStepMicroseconds;
+    std::vector<std::vector<uint64_t>> PhaseMicroseconds;
+    std::vector<uint64_t> ObservationUpdateAllocations;
+    std::vector<uint64_t> AgentStepAllocations;
+    std::vector<sc2::TraceZoneStats> ZoneStats;
+};
+
+uint64_t GetElapsedMicroseconds(const FSteadyClock::time_point& StartTimeValue)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(FSteadyClock::now() - StartTimeValue).count());
+}
+
+uint32_t GetUnitTypeValue(const sc2::UNIT_TYPEID UnitTypeIdValue)
+{
+    return static_cast<uint32_t>(UnitTypeIdValue);
+}
+
+// Roughly a tenth of each side is structures, with eight mineral fields per town hall.
+sc2::MockGameSettings CreateScaleSettings(const uint32_t UnitCountValue)
+{
+    const int CountValue = static_cast<int>(UnitCountValue);
+    const int TownHallCountValue = 1 + CountValue / 250;
+    const int DepotCountValue = CountValue / 25;
+    const int BarracksCountValue = CountValue / 40;
+    const int SelfStructureCountValue = TownHallCountValue + DepotCountValue + BarracksCountValue;
+    const int SelfMobileCountValue = std::max(0, CountValue - SelfStructureCountValue);
+    const int WorkerCountValue = SelfMobileCountValue * 2 / 5;
+    const int MarauderCountValue = SelfMobileCountValue / 5;
+    const int EnemyMobileCountValue = std::max(0, CountValue - TownHallCountValue);
+    const int ZerglingCountValue = EnemyMobileCountValue * 3 / 5;
+
+    sc2::MockGameSettings SettingsValue;
+    SettingsValue.self_units = {
+        sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::TERRAN_COMMANDCENTER), TownHallCountValue, true},
+        sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::TERRAN_SUPPLYDEPOT), DepotCountValue, true},
+        sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::TERRAN_BARRACKS), BarracksCountValue, true},
+        sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::TERRAN_SCV), WorkerCountValue},
+        sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::TERRAN_MARAUDER), MarauderCountValue},
+        sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::TERRAN_MARINE),
+                           SelfMobileCountValue - WorkerCountValue - MarauderCountValue}};
+    SettingsValue.enemy_units = {
+        sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::ZERG_HATCHERY), TownHallCountValue, true},
+        sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::ZERG_ZERGLING), ZerglingCountValue},
+        sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::ZERG_ROACH),
+                           EnemyMobileCountValue - ZerglingCountValue}};
+    SettingsValue.neutral_units = {sc2::MockUnitGroup{GetUnitTypeValue(sc2::UNIT_TYPEID::NEUTRAL_MINERALFIELD),
+                                                      TownHallCountValue * 16, true, 1800}};
+    return SettingsValue;
+}
+
+// Records what the coordinator asks for when joining, then one observation per step.
+bool WriteScaleRecording(const sc2::MockGameSettings& SettingsValue, const uint32_t StepCountValue,
+                         const std::string& PathValue)
+{
+    sc2::MockGame MockGameValue(SettingsValue);
+    sc2::ProtoRecordingWriter WriterValue;
+    if (!MockGameValue.Open() || !WriterValue.Open(PathValue))
+    {
+        return false;
+    }
+
+    SC2APIProtocol::Request JoinRequestValue;
+    JoinRequestValue.mutable_join_game();
+    SC2APIProtocol::Request GameInfoRequestValue;
+    GameInfoRequestValue.mutable_game_info();
+    SC2APIProtocol::Request DataRequestValue;
+    DataRequestValue.mutable_data();
+    SC2APIProtocol::Request ObservationRequestValue;
+    ObservationRequestValue.mutable_observation();
+    SC2APIProtocol::Request StepRequestValue;
+    StepRequestValue.mutable_step()->set_count(1U);
+
+    SC2APIProtocol::Response ResponseValue;
+    bool bWrittenValue = true;
+    for (const SC2APIProtocol::Request* RequestPtrValue :
+         {&JoinRequestValue, &GameInfoRequestValue, &DataRequestValue, &ObservationRequestValue})
+    {
+        ResponseValue.Clear();
+        MockGameValue.Respond(*RequestPtrValue, ResponseValue);
+        bWrittenValue = WriterValue.Write(RequestPtrValue, ResponseValue) && bWrittenValue;
+    }
+
+    // Playback answers steps itself, so only the observations that follow them are recorded.
+    for (uint32_t StepIndexValue = 0U; StepIndexValue < StepCountValue; ++StepIndexValue)
+    {
+        ResponseValue.Clear();
+        MockGameValue.Respond(StepRequestValue, ResponseValue);
+        ResponseValue.Clear();
+        MockGameValue.Respond(ObservationRequestValue, ResponseValue);
+        bWrittenValue = WriterValue.Write(&ObservationRequestValue, ResponseValue) && bWrittenValue;
+    }
+
+    WriterValue.Close();
+    return bWrittenValue;
+}
+
+bool RunScale(const sc2::MockGameSettings& SettingsValue, const std::string& RecordingPathValue,
+              FScaleSamples& SamplesValue)
+{
+    // Outlives the agent, whose playback answers queries from it.
+    sc2::MockGame QueryGameValue(SettingsValue);
+    sc2::TerranAgent AgentValue;
+    sc2::ControlInterface* ControlPtrValue = AgentValue.Control();
+    if (!QueryGameValue.Open() || !ControlPtrValue->Proto().StartPlayback(RecordingPathValue))
+    {
+        return false;
+    }
+
+    sc2::ProtoPlayback* PlaybackPtrValue = ControlPtrValue->Proto().GetPlayback();
+    PlaybackPtrValue->SetQueryResponder(
+        [&QueryGameValue](const SC2APIProtocol::Request& RequestValue, SC2APIProtocol::Response& ResponseValue)
+        { QueryGameValue.Respond(RequestValue, ResponseValue); });
+    if (!ControlPtrValue->Connect("playback", 0, sc2::kDefaultProtoInterfaceTimeout) ||
+        !ControlPtrValue->RequestJoinGame(sc2::CreateParticipant(sc2::Race::Terran, &AgentValue),
+                                          sc2::InterfaceSettings()) ||
+        !ControlPtrValue->WaitJoinGame() || !ControlPtrValue->GetObservation())
+    {
+        return false;
+    }
+
+    AgentValue.OnGameFullStart();
+    ControlPtrValue->OnGameStart();
+    AgentValue.OnGameStart();
+    ControlPtrValue->IssueEvents(AgentValue.Actions()->Commands());
+
+    SamplesValue.PhaseMicroseconds.resize(sc2::TerranAgent::GetStepTimingPhaseNames().size());
+    std::vector<uint64_t> PhaseMicrosecondsValue;
+    while (ControlPtrValue->IsInGame())
+    {
+        uint64_t AllocationStartValue = AllocationCount.load(std::memory_order_relaxed);
+        FSteadyClock::time_point StartTimeValue = FSteadyClock::now();
+        if (!ControlPtrValue->Step(1) || !ControlPtrValue->WaitStep() || !ControlPtrValue->IsInGame())
+        {
+            break;
+        }
+        const uint64_t ObservationUpdateMicrosecondsValue = GetElapsedMicroseconds(StartTimeValue);
+        const uint64_t ObservationUpdateAllocationsValue =
+            AllocationCount.load(std::memory_order_relaxed) - AllocationStartValue;
+
+        AllocationStartValue = AllocationCount.load(std::memory_order_relaxed);
+        StartTimeValue = FSteadyClock::now();
+        ControlPtrValue->IssueEvents(AgentValue.Actions()->Commands());
+        AgentValue.Actions()->SendActions();
+        const uint64_t AgentStepMicrosecondsValue = GetElapsedMicroseconds(StartTimeValue);
+        const uint64_t AgentStepAllocationsValue =
+            AllocationCount.load(std::memory_order_relaxed) - AllocationStartValue;
+
+        SamplesValue.ObservationUpdateMicroseconds.push_back(ObservationUpdateMicrosecondsValue);
+        SamplesValue.AgentStepMicroseconds.push_back(AgentStepMicrosecondsValue);
+        SamplesValue.ObservationUpdateAllocations.push_back(ObservationUpdateAllocationsValue);
+        SamplesValue.AgentStepAllocations.push_back(AgentStepAllocationsValue);
+        if (ObservationUpdateMicrosecondsValue + AgentStepMicrosecondsValue > FrameBudgetMicroseconds)
+        {
+            ++SamplesValue.OverBudgetFrameCount;
+        }
+
+        AgentValue.GetLastStepTimingMicroseconds(PhaseMicrosecondsValue);
+        for (size_t PhaseIndexValue = 0U; PhaseIndexValue < SamplesValue.PhaseMicroseconds.size(); ++PhaseIndexValue)
+        {
+            SamplesValue.PhaseMicroseconds[PhaseIndexValue].push_back(PhaseMicrosecondsValue[PhaseIndexValue]);
+        }
+    }
+    AgentValue.OnGameEnd();
+    SamplesValue.MockAnsweredQueryCount = PlaybackPtrValue->GetDeferredQueryCount();
+    return !SamplesValue.AgentStepMicroseconds.empty();
+}
+
+void WritePercentilesJson(std::ostream& OutputStreamValue, const std::string& NameValue,
+                          std::vector<uint64_t>& SamplesValue)
+{
+    std::sort(SamplesValue.begin(), SamplesValue.end());
+    const auto GetPercentileValue = [&SamplesValue](const double FractionValue) -> uint64_t
+    {
+        if (SamplesValue.empty())
+        {
+            return 0U;
+        }
+
+        const size_t IndexValue = static_cast<size_t>(FractionValue * static_cast<double>(SamplesValue.size()));
+        return SamplesValue[std::min(IndexValue, SamplesValue.size() - 1U)];
+    };
+
+    OutputStreamValue << "\"" << NameValue << "\": {\"p50\": " << GetPercentileValue(0.5)
+                      << ", \"p99\": " << GetPercentileValue(0.99)
+                      << ", \"max\": " << (SamplesValue.empty() ? 0U : SamplesValue.back()) << "}";
+}
+
+void WriteScaleJson(std::ostream& OutputStreamValue, FScaleSamples& SamplesValue)
+{
+    const std::vector<std::string>& PhaseNamesValue = sc2::TerranAgent::GetStepTimingPhaseNames();
+    OutputStreamValue << "    {\"units_per_side\": " << SamplesValue.UnitCount
+                      << ", \"steps\": " << SamplesValue.AgentStepMicroseconds.size()
+                      << ", \"over_budget_frames\": " << SamplesValue.OverBudgetFrameCount
+                      << ", \"mock_answered_queries\": " << SamplesValue.MockAnsweredQueryCount << ",\n";
+
+    OutputStreamValue << "     \"microseconds\": {";
+    WritePercentilesJson(OutputStreamValue, "ObservationUpdate", SamplesValue.ObservationUpdateMicroseconds);
+    OutputStreamValue << ", ";
+    WritePercentilesJson(OutputStreamValue, "AgentStep", SamplesValue.AgentStepMicroseconds);
+    for (size_t PhaseIndexValue = 0U; PhaseIndexValue < SamplesValue.PhaseMicroseconds.size(); ++PhaseIndexValue)
+    {
+        OutputStreamValue << ",\n        ";
+        WritePercentilesJson(OutputStreamValue, PhaseNamesValue[PhaseIndexValue],
+                             SamplesValue.PhaseMicroseconds[PhaseIndexValue]);
+    }
+    OutputStreamValue << "},\n";
+
+    OutputStreamValue << "     \"allocations\": {";
+    WritePercentilesJson(OutputStreamValue, "ObservationUpdate", SamplesValue.ObservationUpdateAllocations);
+    OutputStreamValue << ", ";
+    WritePercentilesJson(OutputStreamValue, "AgentStep", SamplesValue.AgentStepAllocations);
+    OutputStreamValue << "}";
+
+    if (!SamplesValue.ZoneStats.empty())
+    {
+        OutputStreamValue << ",\n     \"zones_ns\": {";
+        for (size_t ZoneIndexValue = 0U; ZoneIndexValue < SamplesValue.ZoneStats.size(); ++ZoneIndexValue)
+        {
+            const sc2::TraceZoneStats& ZoneStatsValue = SamplesValue.ZoneStats[ZoneIndexValue];
+            OutputStreamValue << (ZoneIndexValue > 0U ? ",\n        " : "") << "\"" << ZoneStatsValue.name
+                              << "\": {\"count\": " << ZoneStatsValue.total_count << ", \"p50\": "
+                              << ZoneStatsValue.p50_ns << ", \"p99\": " << ZoneStatsValue.p99_ns
+                              << ", \"max\": " << ZoneStatsValue.max_ns << "}";
+        }
+        OutputStreamValue << "}";
+    }
+    OutputStreamValue << "}";
+}
+
+std::vector<uint32_t> ParseScales(const std::string& ListValue)
+{
+    std::vector<uint32_t> ScalesValue;
+    std::istringstream StreamValue(ListValue);
+    std::string EntryValue;
+    while (std::getline(StreamValue, EntryValue, ','))
+    {
+        const unsigned long ParsedValue = std::strtoul(EntryValue.c_str(), nullptr, 10);
+        if (ParsedValue > 0UL)
+        {
+            ScalesValue.push_back(static_cast<uint32_t>(ParsedValue));
+        }
+    }
+    return ScalesValue;
+}
+
+void PrintUsage()
+{
+    std::cerr << "Usage: terran_scale_benchmark [--scales 50,200,500,1000] [--steps N] [--output PATH]"
+                 " [--trace PREFIX]"
+              << std::endl;
+}
+
+}  // namespace
+
+// Every heap allocation in the process is counted, including those made by the worker pool.
+void* operator new(std::size_t SizeValue)
+{
+    AllocationCount.fetch_add(1U, std::memory_order_relaxed);
+    if (void* PtrValue = std::malloc(SizeValue > 0U ? SizeValue : 1U))
+    {
+        return PtrValue;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* PtrValue) noexcept
+{
+    std::free(PtrValue);
+}
+
+void operator delete(void* PtrValue, std::size_t) noexcept
+{
+    std::free(PtrValue);
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<uint32_t> ScalesValue = {50U, 200U, 500U, 1000U};
+    uint32_t StepCountValue = 200U;
+    std::string OutputPathValue;
+    std::string TracePrefixValue;
+    for (int ArgumentIndexValue = 1; ArgumentIndexValue + 1 < argc; ArgumentIndexValue += 2)
+    {
+        const std::string ArgumentValue = argv[ArgumentIndexValue];
+        const std::string ParameterValue = argv[ArgumentIndexValue + 1];
+        if (ArgumentValue == "--scales")
+        {
+            ScalesValue = ParseScales(ParameterValue);
+        }
+        else if (ArgumentValue == "--steps")
+        {
+            StepCountValue = static_cast<uint32_t>(std::max(1, std::atoi(ParameterValue.c_str())));
+        }
+        else if (ArgumentValue == "--output")
+        {
+            OutputPathValue = ParameterValue;
+        }
+        else if (ArgumentValue == "--trace")
+        {
+            TracePrefixValue = ParameterValue;
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (argc % 2 == 0)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<FScaleSamples> SamplesValue;
+    for (const uint32_t UnitCountValue : ScalesValue)
+    {
+        const std::string RecordingPathValue =
+            (std::filesystem::temp_directory_path() / ("terran_scale_" + std::to_string(UnitCountValue) + ".sc2rec"))
+                .string();
+        const sc2::MockGameSettings ScaleSettingsValue = CreateScaleSettings(UnitCountValue);
+        if (!WriteScaleRecording(ScaleSettingsValue, StepCountValue, RecordingPathValue))
+        {
+            std::cerr << "Unable to write " << RecordingPathValue << std::endl;
+            return 1;
+        }
+
+        FScaleSamples ScaleSamplesValue;
+        ScaleSamplesValue.UnitCount = UnitCountValue;
+        sc2::Tracer& TracerValue = sc2::Tracer::Get();
+        if (!TracePrefixValue.empty())
+        {
+            TracerValue.Reset();
+            TracerValue.SetEnabled(true);
+            TracerValue.StartCapture();
+        }
+        const bool bRanValue = RunScale(ScaleSettingsValue, RecordingPathValue, ScaleSamplesValue);
+        std::remove(RecordingPathValue.c_str());
+        if (!TracePrefixValue.empty())
+        {
+            TracerValue.SetEnabled(false);
+            TracerValue.StopCapture();
+            ScaleSamplesValue.ZoneStats = TracerValue.GetZoneStats();
+            const std::string TracePathValue = TracePrefixValue + "_" + std::to_string(UnitCountValue) + ".json";
+            if (!TracerValue.WriteChromeTrace(TracePathValue))
+            {
+                std::cerr << "Unable to write " << TracePathValue << std::endl;
+            }
+        }
+        if (!bRanValue)
+        {
+            std::cerr << "The agent did not step at " << UnitCountValue << " units per side." << std::endl;
+            return 1;
+        }
+
+        std::cerr << UnitCountValue << " units per side: " << ScaleSamplesValue.OverBudgetFrameCount << " of "
+                  << ScaleSamplesValue.AgentStepMicroseconds.size() << " frames over budget" << std::endl;
+        SamplesValue.push_back(std::move(ScaleSamplesValue));
+    }
+
+    std::ofstream OutputFileValue;
+    if (!OutputPathValue.empty())
+    {
+        OutputFileValue.open(OutputPathValue, std::ios::binary);
+        if (!OutputFileValue)
+        {
+            std::cerr << "Unable to write " << OutputPathValue << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& OutputStreamValue = OutputPathValue.empty() ? std::cout : OutputFileValue;
+    OutputStreamValue << "{\"frame_budget_us\": " << FrameBudgetMicroseconds << ",\n \"scales\": [\n";
+    for (size_t ScaleIndexValue = 0U; ScaleIndexValue < SamplesValue.size(); ++ScaleIndexValue)
+    {
+        WriteScaleJson(OutputStreamValue, SamplesValue[ScaleIndexValue]);
+        OutputStreamValue << (ScaleIndexValue + 1U < SamplesValue.size() ? ",\n" : "\n");
+    }
+    OutputStreamValue << " ]}" << std::endl;
+    return 0;
+}
@@ -1,8 +1,12 @@
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <string>
+#include <vector>
 
 #include "sc2api/sc2_api.h"
+#include "sc2api/sc2_trace.h"
 #include "sc2renderer/sc2_renderer.h"
 #include "sc2utils/sc2_manage_process.h"
 
@@ -37,6 +41,26 @@ uint32_t GetUnsignedIntegerEnvironmentOverride(const char* VariableNamePtrValue)
     return static_cast<uint32_t>(ParsedValue);
 }
 
+bool WriteTraceZoneStats(const std::vector<sc2::TraceZoneStats>& ZoneStatsValue, const std::string& PathValue)
+{
+    std::ofstream OutputFileValue(PathValue, std::ios::binary);
+    if (!OutputFileValue)
+    {
+        return false;
+    }
+
+    OutputFileValue << "{";
+    for (size_t ZoneIndexValue = 0U; ZoneIndexValue < ZoneStatsValue.size(); ++ZoneIndexValue)
+    {
+        const sc2::TraceZoneStats& ZoneStatValue = ZoneStatsValue[ZoneIndexValue];
+        OutputFileValue << (ZoneIndexValue > 0U ? ",\n    " : "\n    ") << "\"" << ZoneStatValue.name
+                        << "\": {\"count\": " << ZoneStatValue.total_count << ", \"p50\": " << ZoneStatValue.p50_ns
+                        << ", \"p99\": " << ZoneStatValue.p99_ns << ", \"max\": " << ZoneStatValue.max_ns << "}";
+    }
+    OutputFileValue << "\n}\n";
+    return static_cast<bool>(OutputFileValue);
+}
+
 }  // namespace
 
 int main(int argc, char* argv[])
@@ -66,6 +90,26 @@ int main(int argc, char* argv[])
 
     sc2::TerranAgent MirrorAgentValue;
 
+    // Records everything the game sends the main agent for terran_playback_benchmark.
+    const char* RecordingPathPtrValue = std::getenv("SC2_TUTORIAL_RECORD_PROTO");
+    if (RecordingPathPtrValue != nullptr && RecordingPathPtrValue[0] != '\0' &&
+        !agent.Control()->Proto().StartRecording(RecordingPathPtrValue))
+    {
+        std::cerr << "Unable to record to " << RecordingPathPtrValue << std::endl;
+    }
+
+    // Traces the whole match and writes PREFIX.json for chrome://tracing or Perfetto and PREFIX_zones.json with
+    // the per-zone statistics when the game ends.
+    const char* TracePrefixPtrValue = std::getenv("SC2_TUTORIAL_TRACE");
+    const bool bTraceEnabledValue = TracePrefixPtrValue != nullptr && TracePrefixPtrValue[0] != '\0';
+    sc2::Tracer& TracerValue = sc2::Tracer::Get();
+    if (bTraceEnabledValue)
+    {
+        TracerValue.Reset();
+        TracerValue.SetEnabled(true);
+        TracerValue.StartCapture();
+    }
+
     if (MirrorMatchEnabledValue)
     {
         coordinator.SetMultithreaded(true);
@@ -100,6 +144,24 @@ int main(int argc, char* argv[])
         }
     }
 
+    if (bTraceEnabledValue)
+    {
+        TracerValue.SetEnabled(false);
+        TracerValue.StopCapture();
+        const std::string TracePathValue = std::string(TracePrefixPtrValue) + ".json";
+        const std::string ZoneStatsPathValue = std::string(TracePrefixPtrValue) + "_zones.json";
+        if (!TracerValue.WriteChromeTrace(TracePathValue))
+        {
+            std::cerr << "Unable to write " << TracePathValue << std::endl;
+        }
+        if (!WriteTraceZoneStats(TracerValue.GetZoneStats(), ZoneStatsPathValue))
+        {
+            std::cerr << "Unable to write " << ZoneStatsPathValue << std::endl;
+        }
+        std::cout << "Wrote " << TracerValue.GetCapturedEventCount() << " trace events to " << TracePathValue
+                  << " (" << TracerValue.GetDroppedEventCount() << " dropped)." << std::endl;
+    }
+
     std::cout << "Game ended, Press any key to continue..." << std::endl;
     return 0;
 }
@@ -2,9 +2,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <string>
 #include <unordered_map>
 
 #include "s2clientprotocol/sc2api.pb.h"
@@ -12,62 +14,13 @@
 #include "sc2_control_interfaces.h"
 #include "sc2_game_settings.h"
 #include "sc2_interfaces.h"
+#include "sc2_map_info.h"
 #include "sc2_proto_interface.h"
 #include "sc2_proto_to_pods.h"
+#include "sc2_trace.h"
+#include "sc2_unit_filters.h"
 #include "sc2utils/sc2_manage_process.h"
 
-namespace {
-
-struct MapState {
-    explicit MapState(const SC2APIProtocol::MapState& map);
-
-    bool HasCreep(const sc2::Point2D& point) const;
-
-    sc2::Visibility GetVisibility(const sc2::Point2D& point) const;
-
-private:
-    sc2::SampleImage creep_data_;
-    sc2::SampleImage visibility_data_;
-};
-
-MapState::MapState(const SC2APIProtocol::MapState& map) : creep_data_(map.creep()), visibility_data_(map.visibility()) {
-}
-
-bool MapState::HasCreep(const sc2::Point2D& point) const {
-    if (creep_data_.BPP() == 1) {
-        bool value;
-        if (!creep_data_.GetBit(point, &value))
-            return false;
-
-        return value;
-    }
-
-    unsigned char value;
-    if (!creep_data_.GetBit(point, &value))
-        return false;
-
-    return value > 0;
-}
-
-sc2::Visibility MapState::GetVisibility(const sc2::Point2D& point) const {
-    unsigned char value;
-    if (!visibility_data_.GetBit(point, &value))
-        return sc2::Visibility::FullHidden;
-
-    if (value == 0)
-        return sc2::Visibility::Hidden;
-
-    if (value == 1)
-        return sc2::Visibility::Fogged;
-
-    if (value == 2)
-        return sc2::Visibility::Visible;
-
-    return sc2::Visibility::FullHidden;
-}
-
-}  // namespace
-
 namespace sc2 {
 
 //-------------------------------------------------------------------------------------------------
@@ -100,6 +53,12 @@ public:
     mutable bool game_info_cached_;
     mutable bool use_generalized_ability_ = true;
 
+    // Map images decoded on first use: terrain with the game info, creep and visibility once per observation.
+    mutable MapGrids map_grids_;
+    mutable bool map_state_decoded_;
+
+    void DecodeMapState() const;
+
     // Player data.
     uint32_t minerals_;
     uint32_t vespene_;
@@ -182,6 +141,7 @@ public:
     bool IsPathable(const Point2D& point) const final;
     bool IsPlacable(const Point2D& point) const final;
     float TerrainHeight(const Point2D& point) const final;
+    const MapGrids* GetMapGrids() const final;
 
     uint32_t GetMinerals() const final {
         return minerals_;
@@ -242,6 +202,7 @@ ObservationImp::ObservationImp(ProtoInterface& proto, ObservationPtr& observatio
 void ObservationImp::ClearFlags() {
     player_id_ = 0;
     game_info_cached_ = false;
+    map_state_decoded_ = false;
     abilities_cached_ = false;
     unit_types_cached = false;
     upgrades_cached_ = false;
@@ -250,9 +211,8 @@ void ObservationImp::ClearFlags() {
 }
 
 Units ObservationImp::GetUnits() const {
-    Units units;
-    unit_pool_.ForEachExistingUnit([&](Unit& unit) { units.push_back(&unit); });
-    return units;
+    const std::vector<Unit*>& existing_units = unit_pool_.GetExistingUnits();
+    return Units(existing_units.begin(), existing_units.end());
 }
 
 const Unit* ObservationImp::GetUnit(Tag tag) const {
@@ -260,12 +220,9 @@ const Unit* ObservationImp::GetUnit(Tag tag) const {
 }
 
 Units ObservationImp::GetUnits(Unit::Alliance alliance, Filter filter) const {
+    // Rejects on the contiguous alliance column before touching the unit records.
     Units units;
-    unit_pool_.ForEachExistingUnit([&](Unit& unit) {
-        if (unit.alliance != alliance) {
-            return;
-        }
-
+    unit_pool_.ForEachExisting(alliance, [&](const Unit& unit) {
         if (!filter || filter(unit)) {
             units.push_back(&unit);
         }
@@ -275,7 +232,7 @@ Units ObservationImp::GetUnits(Unit::Alliance alliance, Filter filter) const {
 
 Units ObservationImp::GetUnits(Filter filter) const {
     Units units;
-    unit_pool_.ForEachExistingUnit([&](Unit& unit) {
+    unit_pool_.ForEachExisting([&](const Unit& unit) {
         if (!filter || filter(unit)) {
             units.push_back(&unit);
         }
@@ -522,44 +479,62 @@ const GameInfo& ObservationImp::GetGameInfo() const {
     }
 
     Convert(response_game_info, game_info_);
+    map_grids_.DecodeGameInfo(game_info_);
 
     game_info_cached_ = true;
     return game_info_;
 }
 
-bool ObservationImp::HasCreep(const Point2D& point) const {
+void ObservationImp::DecodeMapState() const {
+    if (map_state_decoded_) {
+        return;
+    }
+
     ObservationRawPtr observation_raw;
     SET_SUBMESSAGE_RESPONSE(observation_raw, observation_, raw_data);
     if (observation_raw.HasErrors()) {
-        return false;
+        map_grids_.ClearMapState();
+    } else {
+        map_grids_.DecodeMapState(observation_raw->map_state());
     }
 
-    return MapState(observation_raw->map_state()).HasCreep(point);
+    map_state_decoded_ = true;
 }
 
-Visibility ObservationImp::GetVisibility(const Point2D& point) const {
-    ObservationRawPtr observation_raw;
-    SET_SUBMESSAGE_RESPONSE(observation_raw, observation_, raw_data);
-    if (observation_raw.HasErrors()) {
-        return Visibility::FullHidden;
-    }
+bool ObservationImp::HasCreep(const Point2D& point) const {
+    DecodeMapState();
+    return map_grids_.HasCreep(point);
+}
 
-    return MapState(observation_raw->map_state()).GetVisibility(point);
+Visibility ObservationImp::GetVisibility(const Point2D& point) const {
+    DecodeMapState();
+    return map_grids_.GetVisibility(point);
 }
 
 bool ObservationImp::IsPathable(const Point2D& point) const {
-    return PathingGrid(GetGameInfo()).IsPathable(point);
+    GetGameInfo();
+    return map_grids_.IsPathable(point);
 }
 
 bool ObservationImp::IsPlacable(const Point2D& point) const {
-    return PlacementGrid(GetGameInfo()).IsPlacable(point);
+    GetGameInfo();
+    return map_grids_.IsPlacable(point);
 }
 
 float ObservationImp::TerrainHeight(const Point2D& point) const {
-    return HeightMap(GetGameInfo()).TerrainHeight(point);
+    GetGameInfo();
+    return map_grids_.TerrainHeight(point);
+}
+
+const MapGrids* ObservationImp::GetMapGrids() const {
+    GetGameInfo();
+    DecodeMapState();
+    return &map_grids_;
 }
 
 bool ObservationImp::UpdateObservation() {
+    map_state_decoded_ = false;
+
     // Convert observation into data.
     if (!Convert(observation_, score_)) {
         return false;
@@ -627,7 +602,7 @@ bool ObservationImp::UpdateObservation() {
     Convert(observation_raw, unit_pool_, current_game_loop_, previous_game_loop);
 
     // Remap ability ids in orders.
-    unit_pool_.ForEachExistingUnit([&](Unit& unit) {
+    unit_pool_.ForEachExisting([&](Unit& unit) {
         for (UnitOrder& unit_order : unit.orders) {
             if (use_generalized_ability_) {
                 unit_order.ability_id = GetGeneralizedAbilityID(unit_order.ability_id, *this);
@@ -702,6 +677,9 @@ public:
 
     bool Placement(const AbilityID& ability, const Point2D& target_pos, const Unit* unit = nullptr) final;
     std::vector<bool> Placement(const std::vector<PlacementQuery>& queries) final;
+
+    bool TryPathingDistance(const std::vector<PathingQuery>& queries, std::vector<float>& distances) final;
+    bool TryPlacement(const std::vector<PlacementQuery>& queries, std::vector<bool>& results) final;
 };
 
 QueryImp::QueryImp(ProtoInterface& proto, ControlInterface& control, ObservationInterface& observation)
@@ -721,6 +699,7 @@ AvailableAbilities QueryImp::GetAbilitiesForUnit(const Unit* unit, bool ignore_r
 
 std::vector<AvailableAbilities> QueryImp::GetAbilitiesForUnits(const Units& units, bool ignore_resource_requirements,
                                                                bool use_generalized_ability_id) {
+    SC2_TRACE_ZONE("QueryImp::GetAbilitiesForUnits");
     std::vector<AvailableAbilities> available_abilities_out;
 
     // Make the request.
@@ -806,6 +785,14 @@ float QueryImp::PathingDistance(const Unit* start_unit, const Point2D& end) {
 }
 
 std::vector<float> QueryImp::PathingDistance(const std::vector<PathingQuery>& queries) {
+    std::vector<float> distances;
+    TryPathingDistance(queries, distances);
+    return distances;
+}
+
+bool QueryImp::TryPathingDistance(const std::vector<PathingQuery>& queries, std::vector<float>& distances) {
+    SC2_TRACE_ZONE("QueryImp::PathingDistance");
+    distances.assign(queries.size(), 0.0F);
     GameRequestPtr request = proto_.MakeRequest();
     SC2APIProtocol::RequestQuery* request_query = request->mutable_query();
 
@@ -824,29 +811,26 @@ std::vector<float> QueryImp::PathingDistance(const std::vector<PathingQuery>& qu
     }
 
     if (!proto_.SendRequest(request)) {
-        return std::vector<float>(queries.size(), 0.0F);
+        return false;
     }
 
     const GameResponsePtr response = control_.WaitForResponse();
     ResponseQueryPtr response_query;
     SET_MESSAGE_RESPONSE(response_query, response, query);
     if (response_query.HasErrors()) {
-        return std::vector<float>(queries.size(), 0.0F);
+        return false;
     }
 
     if (response_query->pathing_size() != queries.size()) {
-        return std::vector<float>(queries.size(), 0.0F);
+        return false;
     }
 
-    std::vector<float> distances;
-    distances.reserve(queries.size());
-
     for (int i = 0; i < response_query->pathing_size(); ++i) {
         const SC2APIProtocol::ResponseQueryPathing& result = response_query->pathing(i);
-        distances.push_back(result.distance());
+        distances[i] = result.distance();
     }
 
-    return distances;
+    return true;
 }
 
 bool QueryImp::Placement(const AbilityID& ability, const Point2D& target_pos, const Unit* unit) {
@@ -863,6 +847,14 @@ bool QueryImp::Placement(const AbilityID& ability, const Point2D& target_pos, co
 }
 
 std::vector<bool> QueryImp::Placement(const std::vector<PlacementQuery>& queries) {
+    std::vector<bool> results;
+    TryPlacement(queries, results);
+    return results;
+}
+
+bool QueryImp::TryPlacement(const std::vector<PlacementQuery>& queries, std::vector<bool>& results) {
+    SC2_TRACE_ZONE("QueryImp::Placement");
+    results.assign(queries.size(), false);
     GameRequestPtr request = proto_.MakeRequest();
     SC2APIProtocol::RequestQuery* request_query = request->mutable_query();
 
@@ -878,31 +870,540 @@ std::vector<bool> QueryImp::Placement(const std::vector<PlacementQuery>& queries
     }
 
     if (!proto_.SendRequest(request)) {
-        return std::vector<bool>(queries.size(), false);
+        return false;
     }
 
     const GameResponsePtr response = control_.WaitForResponse();
     ResponseQueryPtr response_query;
     SET_MESSAGE_RESPONSE(response_query, response, query);
     if (response_query.HasErrors()) {
-        return std::vector<bool>(queries.size(), false);
+        return false;
     }
 
     if (response_query->placements_size() != queries.size()) {
-        return std::vector<bool>(queries.size(), false);
+        return false;
     }
 
-    std::vector<bool> results;
-    results.reserve(queries.size());
-
     for (int i = 0; i < response_query->placements_size(); ++i) {
         const SC2APIProtocol::ResponseQueryBuildingPlacement& result = response_query->placements(i);
-        results.push_back(result.result() == SC2APIProtocol::ActionResult::Success);
+        results[i] = result.result() == SC2APIProtocol::ActionResult::Success;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------
+// CachingQueryImp: Memoizes placement and pathing query results across frames.
+//-------------------------------------------------------------------------------------------------
+
+// Placement results are keyed on the ability and the target point quantized to half cells, and grouped into square
+// map regions. A region is invalidated when a structure appears, dies, lifts off or lands near it, or when creep or
+// visibility changes inside it. Pathing results are keyed on quantized start and end points and are all dropped
+// whenever the structure layout changes. Results of round trips that failed are returned but never kept.
+class CachingQueryImp : public QueryInterface {
+public:
+    CachingQueryImp(QueryImp& query, const ObservationInterface& observation);
+
+    AvailableAbilities GetAbilitiesForUnit(const Unit* unit, bool ignore_resource_requirements,
+                                           bool use_generalized_ability_id = true) final;
+    std::vector<AvailableAbilities> GetAbilitiesForUnits(const Units& units, bool ignore_resource_requirements,
+                                                         bool use_generalized_ability_id = true) final;
+
+    float PathingDistance(const Point2D& start, const Point2D& end) final;
+    float PathingDistance(const Unit* start_unit, const Point2D& end) final;
+    std::vector<float> PathingDistance(const std::vector<PathingQuery>& queries) final;
+
+    bool Placement(const AbilityID& ability, const Point2D& target_pos, const Unit* unit = nullptr) final;
+    std::vector<bool> Placement(const std::vector<PlacementQuery>& queries) final;
+
+    bool TryPathingDistance(const std::vector<PathingQuery>& queries, std::vector<float>& distances) final;
+    bool TryPlacement(const std::vector<PlacementQuery>& queries, std::vector<bool>& results) final;
+
+    CacheStats GetCacheStats() const final;
+    void SetCacheEnabled(bool enabled) final;
+
+    void Reset();
+    void OnObservationUpdated(const UnitPool& unit_pool, const SC2APIProtocol::Observation& observation);
+
+private:
+    struct PlacementEntry {
+        bool result;
+        uint32_t region_generation;
+    };
+
+    struct PathingKey {
+        uint64_t points;
+        uint32_t unit_type;
+
+        bool operator==(const PathingKey& other) const {
+            return points == other.points && unit_type == other.unit_type;
+        }
+    };
+
+    struct PathingKeyHash {
+        size_t operator()(const PathingKey& key) const {
+            return std::hash<uint64_t>()(key.points ^ (static_cast<uint64_t>(key.unit_type) << 32));
+        }
+    };
+
+    struct PathingEntry {
+        float distance;
+        uint32_t generation;
+    };
+
+    struct StructureState {
+        Point2D pos;
+        float radius;
+        bool is_flying;
+        UNIT_TYPEID unit_type;
+    };
+
+    static const int kRegionSize = 8;
+    static const size_t kMaxCachedResults = 1 << 16;
+
+    bool EnsureRegions();
+    bool TryGetRegionIndex(const Point2D& point, size_t& region_index) const;
+    bool TryMakePlacementKey(const PlacementQuery& query, uint64_t& key, size_t& region_index) const;
+    bool TryMakePathingKey(const PathingQuery& query, PathingKey& key) const;
+    void MarkRegionsDirty(const Point2D& center, float radius);
+    void MarkGridChanges(const SC2APIProtocol::ImageData& image, std::string& previous_data);
+    void FlushDirtyRegions();
+
+    QueryImp& query_;
+    const ObservationInterface& observation_;
+    bool enabled_;
+    CacheStats stats_;
+
+    int region_columns_;
+    int region_rows_;
+    std::vector<uint32_t> region_generations_;
+    std::vector<uint8_t> dirty_regions_;
+    uint32_t pathing_generation_;
+
+    std::unordered_map<uint64_t, PlacementEntry> placement_cache_;
+    std::unordered_map<PathingKey, PathingEntry, PathingKeyHash> pathing_cache_;
+    std::unordered_map<Tag, StructureState> tracked_structures_;
+    std::string previous_creep_;
+    std::string previous_visibility_;
+
+    // Scratch storage for the queries that missed the cache, kept across calls.
+    std::vector<PathingQuery> missed_pathing_queries_;
+    std::vector<float> missed_distances_;
+    std::vector<PlacementQuery> missed_placement_queries_;
+    std::vector<bool> missed_placement_results_;
+    std::vector<size_t> missed_indices_;
+};
+
+namespace {
+
+// Half-cell quantization keeps the usual .0 and .5 build grid points distinct.
+const float kQueryCacheQuantizationScale = 2.0f;
+
+// Largest distance from a placement point to the edge of the footprint it tests, including Terran add-ons.
+const float kPlacementFootprintMargin = 4.0f;
+
+bool TryQuantizeQueryCachePoint(const Point2D& point, uint64_t& quantized) {
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || point.x < 0.0f || point.y < 0.0f) {
+        return false;
+    }
+
+    const long x = std::lround(point.x * kQueryCacheQuantizationScale);
+    const long y = std::lround(point.y * kQueryCacheQuantizationScale);
+    if (x > 0xFFFF || y > 0xFFFF) {
+        return false;
+    }
+
+    quantized = (static_cast<uint64_t>(x) << 16) | static_cast<uint64_t>(y);
+    return true;
+}
+
+bool IsPlacementBlocker(uint8_t flags, UNIT_TYPEID unit_type) {
+    return (flags & UnitPool::FlagBuilding) != 0 || IsMineralPatch()(unit_type) || IsGeyser()(unit_type);
+}
+
+}  // namespace
+
+CachingQueryImp::CachingQueryImp(QueryImp& query, const ObservationInterface& observation)
+    : query_(query),
+      observation_(observation),
+      enabled_(true),
+      region_columns_(0),
+      region_rows_(0),
+      pathing_generation_(0) {
+}
+
+AvailableAbilities CachingQueryImp::GetAbilitiesForUnit(const Unit* unit, bool ignore_resource_requirements,
+                                                        bool use_generalized_ability_id) {
+    return query_.GetAbilitiesForUnit(unit, ignore_resource_requirements, use_generalized_ability_id);
+}
+
+std::vector<AvailableAbilities> CachingQueryImp::GetAbilitiesForUnits(const Units& units,
+                                                                      bool ignore_resource_requirements,
+                                                                      bool use_generalized_ability_id) {
+    return query_.GetAbilitiesForUnits(units, ignore_resource_requirements, use_generalized_ability_id);
+}
+
+float CachingQueryImp::PathingDistance(const Point2D& start, const Point2D& end) {
+    PathingQuery query;
+    query.start_ = start;
+    query.end_ = end;
+    return PathingDistance(std::vector<PathingQuery>{query})[0];
+}
+
+float CachingQueryImp::PathingDistance(const Unit* start_unit, const Point2D& end) {
+    PathingQuery query;
+    query.start_unit_tag_ = start_unit->tag;
+    query.end_ = end;
+    return PathingDistance(std::vector<PathingQuery>{query})[0];
+}
+
+std::vector<float> CachingQueryImp::PathingDistance(const std::vector<PathingQuery>& queries) {
+    std::vector<float> distances;
+    TryPathingDistance(queries, distances);
+    return distances;
+}
+
+bool CachingQueryImp::TryPathingDistance(const std::vector<PathingQuery>& queries, std::vector<float>& distances) {
+    if (!enabled_) {
+        return query_.TryPathingDistance(queries, distances);
+    }
+
+    distances.assign(queries.size(), 0.0f);
+    missed_pathing_queries_.clear();
+    missed_indices_.clear();
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        PathingKey key;
+        if (TryMakePathingKey(queries[i], key)) {
+            const auto found = pathing_cache_.find(key);
+            if (found != pathing_cache_.end() && found->second.generation == pathing_generation_) {
+                distances[i] = found->second.distance;
+                ++stats_.pathing_hits;
+                continue;
+            }
+        }
+
+        ++stats_.pathing_misses;
+        missed_pathing_queries_.push_back(queries[i]);
+        missed_indices_.push_back(i);
     }
 
+    if (missed_pathing_queries_.empty()) {
+        return true;
+    }
+
+    const bool answered = query_.TryPathingDistance(missed_pathing_queries_, missed_distances_);
+    if (answered && pathing_cache_.size() + missed_pathing_queries_.size() > kMaxCachedResults) {
+        pathing_cache_.clear();
+    }
+
+    for (size_t i = 0; i < missed_pathing_queries_.size(); ++i) {
+        distances[missed_indices_[i]] = missed_distances_[i];
+
+        PathingKey key;
+        if (answered && TryMakePathingKey(missed_pathing_queries_[i], key)) {
+            pathing_cache_[key] = {missed_distances_[i], pathing_generation_};
+        }
+    }
+
+    return answered;
+}
+
+bool CachingQueryImp::Placement(const AbilityID& ability, const Point2D& target_pos, const Unit* unit) {
+    PlacementQuery query(ability, target_pos);
+    query.placing_unit_tag = unit ? unit->tag : NullTag;
+    return Placement(std::vector<PlacementQuery>{query})[0];
+}
+
+std::vector<bool> CachingQueryImp::Placement(const std::vector<PlacementQuery>& queries) {
+    std::vector<bool> results;
+    TryPlacement(queries, results);
     return results;
 }
 
+bool CachingQueryImp::TryPlacement(const std::vector<PlacementQuery>& queries, std::vector<bool>& results) {
+    if (!enabled_ || !EnsureRegions()) {
+        return query_.TryPlacement(queries, results);
+    }
+
+    results.assign(queries.size(), false);
+    missed_placement_queries_.clear();
+    missed_indices_.clear();
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        uint64_t key = 0;
+        size_t region_index = 0;
+        if (TryMakePlacementKey(queries[i], key, region_index)) {
+            const auto found = placement_cache_.find(key);
+            if (found != placement_cache_.end() &&
+                found->second.region_generation == region_generations_[region_index]) {
+                results[i] = found->second.result;
+                ++stats_.placement_hits;
+                continue;
+            }
+        }
+
+        ++stats_.placement_misses;
+        missed_placement_queries_.push_back(queries[i]);
+        missed_indices_.push_back(i);
+    }
+
+    if (missed_placement_queries_.empty()) {
+        return true;
+    }
+
+    const bool answered = query_.TryPlacement(missed_placement_queries_, missed_placement_results_);
+    if (answered && placement_cache_.size() + missed_placement_queries_.size() > kMaxCachedResults) {
+        placement_cache_.clear();
+    }
+
+    for (size_t i = 0; i < missed_placement_queries_.size(); ++i) {
+        results[missed_indices_[i]] = missed_placement_results_[i];
+
+        uint64_t key = 0;
+        size_t region_index = 0;
+        if (answered && TryMakePlacementKey(missed_placement_queries_[i], key, region_index)) {
+            placement_cache_[key] = {missed_placement_results_[i], region_generations_[region_index]};
+        }
+    }
+
+    return answered;
+}
+
+QueryInterface::CacheStats CachingQueryImp::GetCacheStats() const {
+    return stats_;
+}
+
+void CachingQueryImp::SetCacheEnabled(bool enabled) {
+    if (enabled_ == enabled) {
+        return;
+    }
+
+    enabled_ = enabled;
+    Reset();
+}
+
+void CachingQueryImp::Reset() {
+    region_columns_ = 0;
+    region_rows_ = 0;
+    region_generations_.clear();
+    dirty_regions_.clear();
+    ++pathing_generation_;
+    placement_cache_.clear();
+    pathing_cache_.clear();
+    tracked_structures_.clear();
+    previous_creep_.clear();
+    previous_visibility_.clear();
+}
+
+void CachingQueryImp::OnObservationUpdated(const UnitPool& unit_pool, const SC2APIProtocol::Observation& observation) {
+    if (!enabled_ || !EnsureRegions()) {
+        return;
+    }
+
+    // Placement blockers are picked out and compared on the dense columns; only blockers touch their unit records.
+    const std::vector<Unit*>& existing_units = unit_pool.GetExistingUnits();
+    const std::vector<Point3D>& existing_positions = unit_pool.GetExistingPositions();
+    const std::vector<UnitTypeID>& existing_unit_types = unit_pool.GetExistingUnitTypes();
+    const std::vector<uint8_t>& existing_flags = unit_pool.GetExistingFlags();
+    bool structures_changed = false;
+    for (size_t i = 0; i < existing_units.size(); ++i) {
+        const UNIT_TYPEID unit_type = existing_unit_types[i];
+        if (!IsPlacementBlocker(existing_flags[i], unit_type)) {
+            continue;
+        }
+
+        const Point2D pos(existing_positions[i]);
+        const bool is_flying = (existing_flags[i] & UnitPool::FlagFlying) != 0;
+        const Unit& unit = *existing_units[i];
+        auto found = tracked_structures_.find(unit.tag);
+        if (found == tracked_structures_.end()) {
+            tracked_structures_[unit.tag] = {pos, unit.radius, is_flying, unit_type};
+            MarkRegionsDirty(pos, unit.radius);
+            structures_changed = true;
+            continue;
+        }
+
+        StructureState& state = found->second;
+        if (state.pos == pos && state.is_flying == is_flying && state.unit_type == unit_type) {
+            continue;
+        }
+
+        // Flying structures block neither placement nor pathing, so only landings and lift-offs matter.
+        if (!(state.is_flying && is_flying)) {
+            MarkRegionsDirty(state.pos, state.radius);
+            MarkRegionsDirty(pos, unit.radius);
+            structures_changed = true;
+        }
+
+        state = {pos, unit.radius, is_flying, unit_type};
+    }
+
+    if (observation.has_raw_data()) {
+        const SC2APIProtocol::ObservationRaw& raw = observation.raw_data();
+        if (raw.has_event()) {
+            for (const auto& tag : raw.event().dead_units()) {
+                auto found = tracked_structures_.find(tag);
+                if (found == tracked_structures_.end()) {
+                    continue;
+                }
+
+                MarkRegionsDirty(found->second.pos, found->second.radius);
+                tracked_structures_.erase(found);
+                structures_changed = true;
+            }
+        }
+
+        if (raw.has_map_state()) {
+            MarkGridChanges(raw.map_state().creep(), previous_creep_);
+            MarkGridChanges(raw.map_state().visibility(), previous_visibility_);
+        }
+    }
+
+    FlushDirtyRegions();
+
+    if (structures_changed) {
+        ++pathing_generation_;
+        ++stats_.pathing_invalidations;
+    }
+}
+
+bool CachingQueryImp::EnsureRegions() {
+    if (!region_generations_.empty()) {
+        return true;
+    }
+
+    const GameInfo& game_info = observation_.GetGameInfo();
+    if (game_info.width <= 0 || game_info.height <= 0) {
+        return false;
+    }
+
+    region_columns_ = (game_info.width + kRegionSize - 1) / kRegionSize;
+    region_rows_ = (game_info.height + kRegionSize - 1) / kRegionSize;
+    region_generations_.assign(static_cast<size_t>(region_columns_ * region_rows_), 0);
+    dirty_regions_.assign(region_generations_.size(), 0);
+    return true;
+}
+
+bool CachingQueryImp::TryGetRegionIndex(const Point2D& point, size_t& region_index) const {
+    const int column = static_cast<int>(point.x) / kRegionSize;
+    const int row = static_cast<int>(point.y) / kRegionSize;
+    if (point.x < 0.0f || point.y < 0.0f || column >= region_columns_ || row >= region_rows_) {
+        return false;
+    }
+
+    region_index = static_cast<size_t>(row * region_columns_ + column);
+    return true;
+}
+
+bool CachingQueryImp::TryMakePlacementKey(const PlacementQuery& query, uint64_t& key, size_t& region_index) const {
+    // Moving or add-on placements depend on the placing structure itself, so those always go to the game.
+    if (query.placing_unit_tag != NullTag) {
+        const Unit* placing_unit = observation_.GetUnit(query.placing_unit_tag);
+        if (placing_unit && placing_unit->is_building) {
+            return false;
+        }
+    }
+
+    uint64_t quantized_point = 0;
+    if (!TryQuantizeQueryCachePoint(query.target_pos, quantized_point) ||
+        !TryGetRegionIndex(query.target_pos, region_index)) {
+        return false;
+    }
+
+    key = (static_cast<uint64_t>(static_cast<uint32_t>(query.ability)) << 32) | quantized_point;
+    return true;
+}
+
+bool CachingQueryImp::TryMakePathingKey(const PathingQuery& query, PathingKey& key) const {
+    Point2D start = query.start_;
+    key.unit_type = 0;
+    if (query.start_unit_tag_ != NullTag) {
+        const Unit* start_unit = observation_.GetUnit(query.start_unit_tag_);
+        if (!start_unit) {
+            return false;
+        }
+
+        start = Point2D(start_unit->pos);
+        // Unit starts path with that unit's movement properties, so they never share entries with point starts.
+        key.unit_type = (static_cast<uint32_t>(start_unit->unit_type) << 1) | (start_unit->is_flying ? 1U : 0U);
+        key.unit_type |= 0x80000000U;
+    }
+
+    uint64_t quantized_start = 0;
+    uint64_t quantized_end = 0;
+    if (!TryQuantizeQueryCachePoint(start, quantized_start) || !TryQuantizeQueryCachePoint(query.end_, quantized_end)) {
+        return false;
+    }
+
+    key.points = (quantized_start << 32) | quantized_end;
+    return true;
+}
+
+void CachingQueryImp::MarkRegionsDirty(const Point2D& center, float radius) {
+    const float extent = radius + kPlacementFootprintMargin;
+    const int min_column = std::max(0, static_cast<int>(center.x - extent) / kRegionSize);
+    const int min_row = std::max(0, static_cast<int>(center.y - extent) / kRegionSize);
+    const int max_column = std::min(region_columns_ - 1, static_cast<int>(center.x + extent) / kRegionSize);
+    const int max_row = std::min(region_rows_ - 1, static_cast<int>(center.y + extent) / kRegionSize);
+
+    for (int row = min_row; row <= max_row; ++row) {
+        for (int column = min_column; column <= max_column; ++column) {
+            dirty_regions_[static_cast<size_t>(row * region_columns_ + column)] = 1;
+        }
+    }
+}
+
+void CachingQueryImp::MarkGridChanges(const SC2APIProtocol::ImageData& image, std::string& previous_data) {
+    const std::string& data = image.data();
+    const int width = image.size().x();
+    if (data.size() != previous_data.size() || width <= 0) {
+        previous_data = data;
+        return;
+    }
+
+    if (data == previous_data) {
+        return;
+    }
+
+    const int bits_per_pixel = image.bits_per_pixel();
+    for (size_t i = 0; i < data.size(); ++i) {
+        const unsigned char changed_bits = static_cast<unsigned char>(data[i] ^ previous_data[i]);
+        if (changed_bits == 0) {
+            continue;
+        }
+
+        if (bits_per_pixel != 1) {
+            const int cell = static_cast<int>(i);
+            MarkRegionsDirty(Point2D(static_cast<float>(cell % width), static_cast<float>(cell / width)), 0.0f);
+            continue;
+        }
+
+        for (int bit = 0; bit < 8; ++bit) {
+            if (((changed_bits >> (7 - bit)) & 1) == 0) {
+                continue;
+            }
+
+            const int cell = static_cast<int>(i) * 8 + bit;
+            MarkRegionsDirty(Point2D(static_cast<float>(cell % width), static_cast<float>(cell / width)), 0.0f);
+        }
+    }
+
+    previous_data = data;
+}
+
+void CachingQueryImp::FlushDirtyRegions() {
+    for (size_t i = 0; i < dirty_regions_.size(); ++i) {
+        if (dirty_regions_[i] == 0) {
+            continue;
+        }
+
+        dirty_regions_[i] = 0;
+        ++region_generations_[i];
+        ++stats_.invalidated_regions;
+    }
+}
+
 //-------------------------------------------------------------------------------------------------
 // DebugImp: An implementation of DebugInterface.
 //-------------------------------------------------------------------------------------------------
@@ -1406,6 +1907,7 @@ public:
     AppState app_state_;
 
     bool is_multiplayer_;
+    bool pipelined_stepping_;
 
     // Proto and socket interface to the game.
     ProtoInterface proto_;
@@ -1416,6 +1918,7 @@ public:
 
     std::unique_ptr<ObservationImp> observation_imp_;
     std::unique_ptr<QueryImp> query_imp_;
+    std::unique_ptr<CachingQueryImp> caching_query_imp_;
     std::unique_ptr<DebugImp> debug_imp_;
     ProcessInfo pi_;
 
@@ -1440,6 +1943,8 @@ public:
 
     bool Step(int count = 1) override;
     bool WaitStep() override;
+    void SetPipelinedStepping(bool value) override;
+    bool IsPipelinedStepping() const override;
 
     bool SaveReplay(const std::string& path) override;
 
@@ -1505,12 +2010,15 @@ ControlImp::ControlImp(Client& client)
     : client_(client),
       app_state_(AppState::normal),
       is_multiplayer_(false),
+      pipelined_stepping_(false),
       observation_imp_(nullptr),
       query_imp_(nullptr),
+      caching_query_imp_(nullptr),
       debug_imp_(nullptr) {
     proto_.SetControl(this);
     observation_imp_ = std::make_unique<ObservationImp>(proto_, observation_, response_, *this);
     query_imp_ = std::make_unique<QueryImp>(proto_, *this, *observation_imp_);
+    caching_query_imp_ = std::make_unique<CachingQueryImp>(*query_imp_, *observation_imp_);
     debug_imp_ = std::make_unique<DebugImp>(proto_, *observation_imp_, *this);
 }
 
@@ -1813,11 +2321,19 @@ bool ControlImp::Step(int count) {
     GameRequestPtr request = proto_.MakeRequest();
     SC2APIProtocol::RequestStep* step = request->mutable_step();
     step->set_count(count);
-    return proto_.SendRequest(request);
+    if (!proto_.SendRequest(request)) {
+        return false;
+    }
+
+    if (pipelined_stepping_) {
+        proto_.DeferPendingResponse();
+    }
+    return true;
 }
 
 bool ControlImp::WaitStep() {
-    const GameResponsePtr response = WaitForResponse();
+    // In pipelined mode the step response may already have been collected by a request sent during OnStep.
+    const GameResponsePtr response = proto_.HasDeferredResponse() ? proto_.TakeDeferredResponse() : WaitForResponse();
     if (!response.get() || !response->has_step() || response->error_size() > 0) {
         return false;
     }
@@ -1825,6 +2341,14 @@ bool ControlImp::WaitStep() {
     return GetObservation();
 }
 
+void ControlImp::SetPipelinedStepping(bool value) {
+    pipelined_stepping_ = value;
+}
+
+bool ControlImp::IsPipelinedStepping() const {
+    return pipelined_stepping_;
+}
+
 bool ControlImp::SaveReplay(const std::string& path) {
     GameRequestPtr request = proto_.MakeRequest();
     request->mutable_save_replay();
@@ -2036,6 +2560,7 @@ bool ControlImp::GetObservation() {
     response_ = response_observation;
 
     observation_imp_->UpdateObservation();
+    caching_query_imp_->OnObservationUpdated(observation_imp_->unit_pool_, *observation_);
 
     return true;
 }
@@ -2194,12 +2719,26 @@ bool ControlImp::IssueEvents(const Tags& commands) {
     IssueUnitDamagedEvents();
 
     // Run the users OnStep function after events have been issued.
-    client_.OnStep();
+    {
+        SC2_TRACE_ZONE("Client::OnStep");
+        client_.OnStep();
+    }
+
+    // Drain the zones of this step so the per-thread trace buffers do not fill up.
+    Tracer& tracer = Tracer::Get();
+    if (tracer.IsEnabled()) {
+        tracer.Collect();
+    }
 
     return true;
 }
 
 void ControlImp::OnGameStart() {
+    caching_query_imp_->Reset();
+
+    // Drop a step response left over from a pipelined step in the previous game.
+    proto_.TakeDeferredResponse();
+
     Units units = observation_imp_->GetUnits(Unit::Alliance::Self, [](const Unit& unit) {
         return unit.unit_type == UNIT_TYPEID::TERRAN_COMMANDCENTER || unit.unit_type == UNIT_TYPEID::PROTOSS_NEXUS ||
                unit.unit_type == UNIT_TYPEID::ZERG_HATCHERY;
@@ -2290,7 +2829,7 @@ const ObservationInterface* Client::Observation() const {
 
 QueryInterface* Client::Query() {
     // TODO (?): Should this return a nullptr if the interface is not valid (e.g., before a game is started)?
-    return control_imp_->query_imp_.get();
+    return control_imp_->caching_query_imp_.get();
 }
 
 DebugInterface* Client::Debug() {
@@ -3,9 +3,12 @@
 #include <cassert>
 #include <chrono>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "civetweb.h"
 #include "s2clientprotocol/sc2api.pb.h"
+#include "sc2_trace.h"
 
 namespace {
 bool StartCivetweb() {
@@ -43,6 +46,110 @@ bool StartCivetweb() {
 
 namespace sc2 {
 
+//! Recycles Response objects together with the protobuf arena they were parsed into. Each slot owns an initial arena
+//! block sized to the largest response it has held, so once a slot has seen a full observation, parsing into it again
+//! does not allocate. Slots are only created when every existing response is still referenced.
+class ResponsePool {
+public:
+    ~ResponsePool() {
+        for (auto& slot : slots_) {
+            slot->arena.reset();
+        }
+    }
+
+    //! Called on the civetweb thread. Arenas are reset here rather than on release so the thread that parses into an
+    //! arena is also the one that owns it, otherwise protobuf allocates a fresh per-thread block on every parse.
+    SC2APIProtocol::Response* Acquire() {
+        Slot* slot = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (free_slots_.empty()) {
+                slots_.push_back(std::make_unique<Slot>());
+                slot = slots_.back().get();
+            } else {
+                slot = free_slots_.back();
+                free_slots_.pop_back();
+            }
+        }
+
+        // The slot is off the free list and has no response, so nothing else touches its arena.
+        RecycleArena(*slot);
+        SC2APIProtocol::Response* response =
+            google::protobuf::Arena::CreateMessage<SC2APIProtocol::Response>(slot->arena.get());
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        slot->response = response;
+        return response;
+    }
+
+    void Release(const SC2APIProtocol::Response* response) {
+        if (!response) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (auto& slot : slots_) {
+            if (slot->response == response) {
+                slot->response = nullptr;
+                free_slots_.push_back(slot.get());
+                return;
+            }
+        }
+
+        // Not pooled, e.g. pushed by a caller that allocated it on the heap.
+        delete response;
+    }
+
+    size_t GetSlotCount() const {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return slots_.size();
+    }
+
+private:
+    static constexpr size_t kInitialBlockSize = 64 * 1024;
+    static constexpr size_t kMaxInitialBlockSize = 8 * 1024 * 1024;
+
+    struct Slot {
+        std::vector<char> initial_block;
+        std::unique_ptr<google::protobuf::Arena> arena;
+        SC2APIProtocol::Response* response = nullptr;
+    };
+
+    static void RecycleArena(Slot& slot) {
+        if (!slot.arena) {
+            ResetArena(slot, kInitialBlockSize);
+            return;
+        }
+
+        // Grow the initial block to cover the last response so the next parse of the same size stays in one block.
+        const size_t space_used = static_cast<size_t>(slot.arena->SpaceAllocated());
+        if (space_used > slot.initial_block.size() && slot.initial_block.size() < kMaxInitialBlockSize) {
+            size_t block_size = slot.initial_block.size();
+            while (block_size < space_used && block_size < kMaxInitialBlockSize) {
+                block_size *= 2;
+            }
+            ResetArena(slot, block_size);
+            return;
+        }
+
+        slot.arena->Reset();
+    }
+
+    static void ResetArena(Slot& slot, size_t block_size) {
+        slot.arena.reset();
+        slot.initial_block.resize(block_size);
+
+        google::protobuf::ArenaOptions options;
+        options.initial_block = slot.initial_block.data();
+        options.initial_block_size = slot.initial_block.size();
+        slot.arena = std::make_unique<google::protobuf::Arena>(options);
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Slot>> slots_;
+    std::vector<Slot*> free_slots_;
+};
+
 bool GetClientData(const mg_connection* connection, sc2::Connection*& out) {
     if (!connection) {
         return false;
@@ -64,12 +171,17 @@ static int DataHandler(mg_connection* conn, int /*flags*/, char* data, size_t da
         return 0;
     }
 
-    SC2APIProtocol::Response* response = new SC2APIProtocol::Response();
+    // Parse straight from civetweb's frame buffer into a recycled arena-backed response.
+    SC2APIProtocol::Response* response = sc2_connection->AcquireResponse();
     if (!response->ParseFromArray(data, (int)data_len)) {
+        sc2_connection->ReleaseResponse(response);
         return 1;
     }
 
-    sc2_connection->PushResponse(response);
+    // A response that could not be queued leaves the receiver out of step with the game, so close the connection.
+    if (!sc2_connection->PushResponse(response)) {
+        return 0;
+    }
 
     return 1;
 }
@@ -86,7 +198,16 @@ static void ConnectionClosedHandler(const struct mg_connection* conn, void*) {
 }
 
 Connection::Connection()
-    : connection_(nullptr), verbose_(false), queue_(), mutex_(), condition_(), has_response_(false) {
+    : connection_(nullptr),
+      verbose_(false),
+      response_pool_(std::make_shared<ResponsePool>()),
+      response_ring_(),
+      response_ring_head_(0),
+      response_ring_tail_(0),
+      mutex_(),
+      condition_(),
+      receiver_waiting_(false),
+      closing_(false) {
 }
 
 bool Connection::Connect(const std::string& address, int port, bool verbose) {
@@ -94,6 +215,7 @@ bool Connection::Connect(const std::string& address, int port, bool verbose) {
         return false;
     }
     verbose_ = verbose;
+    closing_.store(false);
 
     char ebuff[256] = {0};
 
@@ -114,6 +236,7 @@ bool Connection::Connect(const std::string& address, int port, bool verbose) {
 
 Connection::~Connection() {
     Disconnect();
+    DrainResponses();
 }
 
 void Connection::Send(const SC2APIProtocol::Request* request) {
@@ -138,22 +261,37 @@ void Connection::Send(const SC2APIProtocol::Request* request) {
 }
 
 bool Connection::Receive(SC2APIProtocol::Response*& response, unsigned int timeout_ms) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    // Block until a message is recieved.
+    SC2_TRACE_ZONE("Connection::Receive");
     if (verbose_) {
         std::cout << "Waiting for response..." << std::endl;
     }
-    auto now = std::chrono::system_clock::now();
-    if (condition_.wait_until(lock, now + std::chrono::milliseconds(timeout_ms), [&] { return queue_.size() != 0; })) {
-        lock.unlock();
-        PopResponse(response);
-        return true;
+
+    // Responses usually arrive while the caller is still busy, so check the ring before paying for a sleep.
+    for (size_t spin = 0; spin < kReceiveSpinCount; ++spin) {
+        if (TryPopResponse(response)) {
+            return true;
+        }
+        std::this_thread::yield();
+    }
+
+    // Block until a message is recieved. The producer only locks and notifies after it sees receiver_waiting_, and
+    // both sides use sequentially consistent operations so a push cannot slip between the check and the wait.
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        receiver_waiting_.store(true);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        const bool received = condition_.wait_until(lock, deadline, [&] { return !IsResponseRingEmpty(); });
+        receiver_waiting_.store(false);
+        if (received) {
+            lock.unlock();
+            PopResponse(response);
+            return true;
+        }
     }
 
-    lock.unlock();
     response = nullptr;
     Disconnect();
-    queue_.clear();
+    DrainResponses();
 
     // Execute the timeout callback if it exists.
     if (timeout_callback_) {
@@ -163,21 +301,79 @@ bool Connection::Receive(SC2APIProtocol::Response*& response, unsigned int timeo
     return false;
 }
 
-void Connection::PushResponse(SC2APIProtocol::Response*& response) {
-    std::lock_guard<std::mutex> guard(mutex_);
-    queue_.push_back(response);
-    condition_.notify_one();
-    has_response_ = true;
+SC2APIProtocol::Response* Connection::AcquireResponse() {
+    return response_pool_->Acquire();
+}
+
+void Connection::ReleaseResponse(const SC2APIProtocol::Response* response) {
+    response_pool_->Release(response);
+}
+
+std::shared_ptr<const SC2APIProtocol::Response> Connection::AdoptResponse(SC2APIProtocol::Response* response) {
+    if (!response) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ResponsePool> pool = response_pool_;
+    return std::shared_ptr<const SC2APIProtocol::Response>(
+        response, [pool](const SC2APIProtocol::Response* pooled_response) { pool->Release(pooled_response); });
+}
+
+size_t Connection::GetPooledResponseCount() const {
+    return response_pool_->GetSlotCount();
+}
+
+bool Connection::PushResponse(SC2APIProtocol::Response*& response) {
+    const size_t tail = response_ring_tail_.load(std::memory_order_relaxed);
+
+    // The game answers one request at a time, so a full ring means the receiver is stalled; wait for it to drain, but
+    // not past a disconnect, which joins this thread, or a receiver that never comes back.
+    if (tail - response_ring_head_.load(std::memory_order_acquire) >= kResponseRingCapacity) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kPushTimeoutMs);
+        while (tail - response_ring_head_.load(std::memory_order_acquire) >= kResponseRingCapacity) {
+            if (closing_.load() || std::chrono::steady_clock::now() >= deadline) {
+                std::cerr << "Dropping a response, the receiver has not drained the response ring." << std::endl;
+                ReleaseResponse(response);
+                response = nullptr;
+                return false;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    response_ring_[tail & (kResponseRingCapacity - 1)] = response;
+    response_ring_tail_.store(tail + 1);
+
+    if (receiver_waiting_.load()) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        condition_.notify_one();
+    }
+    return true;
 }
 
 void Connection::PopResponse(SC2APIProtocol::Response*& response) {
-    if (queue_.empty())
-        return;
-    std::lock_guard<std::mutex> guard(mutex_);
-    response = queue_.front();
-    queue_.pop_front();
-    if (queue_.empty()) {
-        has_response_ = false;
+    TryPopResponse(response);
+}
+
+bool Connection::TryPopResponse(SC2APIProtocol::Response*& response) {
+    const size_t head = response_ring_head_.load(std::memory_order_relaxed);
+    if (head == response_ring_tail_.load()) {
+        return false;
+    }
+
+    response = response_ring_[head & (kResponseRingCapacity - 1)];
+    response_ring_head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool Connection::IsResponseRingEmpty() const {
+    return response_ring_head_.load(std::memory_order_relaxed) == response_ring_tail_.load();
+}
+
+void Connection::DrainResponses() {
+    SC2APIProtocol::Response* response = nullptr;
+    while (TryPopResponse(response)) {
+        ReleaseResponse(response);
     }
 }
 
@@ -194,12 +390,13 @@ bool Connection::HasConnection() const {
 }
 
 void Connection::Disconnect() {
+    closing_.store(true);
     mg_close_connection(connection_);
     connection_ = nullptr;
 }
 
 bool Connection::PollResponse() {
-    return has_response_;
+    return !IsResponseRingEmpty();
 }
 
 }  // namespace sc2
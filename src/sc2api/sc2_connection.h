@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
-#include <deque>
+#include <cstddef>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 
@@ -20,6 +22,8 @@ class Response;
 
 namespace sc2 {
 
+class ResponsePool;
+
 //! This class acts as a wrapper around a websocket connection and queue responsible for both sending
 //! out and receiving protobuf messages.
 class Connection {
@@ -44,12 +48,33 @@ public:
     //! within the timeout it will set response to null and return false, it also calls a timeout callback that can be
     //! used if a user has any timeout logic. \param response The response pointer to be filled out. \timeout_ms The max
     //! time, in milliseconds, the function will wait to receive a message. \return Returns true if a message is
-    //! received, false otherwise.
+    //! received, false otherwise. The response is owned by the connection's response pool; hand it back with
+    //! ReleaseResponse or wrap it with AdoptResponse instead of deleting it.
     bool Receive(SC2APIProtocol::Response*& response, unsigned int timeout_ms);
 
+    //! Takes a recycled Response from the pool. Responses are parsed into a per-response protobuf arena that is reset,
+    //! not freed, when the response is released, so steady-state receives do not touch the global allocator.
+    //!< \return A cleared Response owned by the pool.
+    SC2APIProtocol::Response* AcquireResponse();
+
+    //! Returns a response obtained from Receive or AcquireResponse to the pool. Responses that did not come from the
+    //! pool are deleted.
+    //!< \param response The response to recycle, may be null.
+    void ReleaseResponse(const SC2APIProtocol::Response* response);
+
+    //! Wraps a pooled response in a shared pointer that recycles it when the last reference is dropped. The pool is
+    //! kept alive by the returned pointer, so it may outlive the connection.
+    //!< \param response The response to wrap, may be null.
+    //!< \return A shared pointer that owns the response.
+    std::shared_ptr<const SC2APIProtocol::Response> AdoptResponse(SC2APIProtocol::Response* response);
+
+    //! The number of responses the pool has created. Stays flat once every in-flight response is being recycled.
+    //!< \return The number of pooled response slots.
+    size_t GetPooledResponseCount() const;
+
     //! PopResponse is called in the Receive function when a message has been received off of the civetweb thread.
     //! Alternatively you could poll for responses with PollResponse and consume the message manually with this
-    //! function. \param response The response pointer to be filled out.
+    //! function. Only the thread that receives may pop. \param response The response pointer to be filled out.
     void PopResponse(SC2APIProtocol::Response*& response);
 
     //! An accessor function that a user can bind a timeout function to.
@@ -70,10 +95,12 @@ public:
     bool PollResponse();
 
     //! PushResponse is called by a civetweb thread when it receives a message off the socket. Pushing a response
-    //! triggers a condition and enqueues a message. The condition will cause anyone currently blocking for a response
-    //! (if Receive is called) to wake up and be able to consume that message. \param response A pointer to the Response
-    //! to queue.
-    void PushResponse(SC2APIProtocol::Response*& response);
+    //! publishes it on a single-producer/single-consumer ring without taking a lock. The condition is only signaled
+    //! when the receiving thread has gone to sleep in Receive. A full ring is waited on for at most kPushTimeoutMs, and
+    //! not at all once Disconnect has been called; the response is then released instead of queued.
+    //!< \param response A pointer to the Response to queue. Set to null if the response was dropped.
+    //!< \return False if the response was dropped.
+    bool PushResponse(SC2APIProtocol::Response*& response);
 
     std::function<void()> timeout_callback_;            //!< Timeout callback.
     std::function<void()> connection_closed_callback_;  //!< Timeout callback.
@@ -81,14 +108,29 @@ public:
     mg_connection* connection_;  //!< A pointer to the civetweb connection object.
 
 private:
+    static constexpr size_t kResponseRingCapacity = 64;    //!< Must be a power of two.
+    static constexpr size_t kReceiveSpinCount = 256;       //!< Ring polls before Receive blocks on the condition.
+    static constexpr unsigned int kPushTimeoutMs = 10000;  //!< Longest PushResponse waits for room in a full ring.
+
+    bool TryPopResponse(SC2APIProtocol::Response*& response);
+    bool IsResponseRingEmpty() const;
+    void DrainResponses();
+
     bool verbose_;  //!< Will print extra information to console if enabled.
 
-    std::deque<SC2APIProtocol::Response*> queue_;  //!< A queue that contains responses received off the socket.
-    std::mutex mutex_;                             //!< Mutex used in conjunction with the condition.
-    std::condition_variable
-        condition_;  //!< A condition that is signaled when a message has been received off the socket.
+    std::shared_ptr<ResponsePool> response_pool_;  //!< Recycled responses and their arenas.
 
-    std::atomic_bool has_response_;  //!< Thread safe bool to check whether the queue is not empty.
+    //! Responses received off the socket. The civetweb thread is the only producer and the receiving thread the only
+    //! consumer, so head and tail are each written by exactly one side.
+    std::array<SC2APIProtocol::Response*, kResponseRingCapacity> response_ring_;
+    alignas(64) std::atomic<size_t> response_ring_head_;  //!< Next slot to pop, written by the consumer.
+    alignas(64) std::atomic<size_t> response_ring_tail_;  //!< Next slot to push, written by the producer.
+
+    std::mutex mutex_;  //!< Mutex used in conjunction with the condition.
+    std::condition_variable
+        condition_;  //!< A condition that is signaled when a message arrives while the receiver is asleep.
+    std::atomic_bool receiver_waiting_;  //!< Set while Receive is blocked on the condition.
+    std::atomic_bool closing_;           //!< Set by Disconnect so a producer waiting on a full ring gives up.
 };
 
 }  // namespace sc2
@@ -32,6 +32,12 @@ public:
     virtual bool Step(int count = 1) = 0;
     virtual bool WaitStep() = 0;
 
+    // Pipelined stepping leaves the step request in flight after Step returns. Any request sent before WaitStep, such
+    // as the actions for the current observation, first collects the step response, so those actions land one step
+    // late.
+    virtual void SetPipelinedStepping(bool value) = 0;
+    virtual bool IsPipelinedStepping() const = 0;
+
     virtual bool SaveReplay(const std::string& path) = 0;
 
     virtual bool Ping() = 0;
@@ -2,9 +2,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <functional>
 #include <iostream>
-#include <thread>
 
 #include "s2clientprotocol/sc2api.pb.h"
 #include "sc2_agent.h"
@@ -13,21 +16,51 @@
 #include "sc2_errors.h"
 #include "sc2_interfaces.h"
 #include "sc2_replay_observer.h"
+#include "sc2_worker_pool.h"
 #include "sc2utils/sc2_manage_process.h"
 #include "sc2utils/sc2_scan_directory.h"
 
 namespace sc2 {
 
-void RunParallel(const std::function<void(Agent* a)>& step, std::vector<Agent*>& agents) {
-    // Run all steps in parallel.
-    std::vector<std::thread> threads(agents.size());
-    for (size_t i = 0; i < agents.size(); ++i) {
-        Agent* a = agents[i];
-        threads[i] = std::thread(std::bind(step, a));
+// Wall time one agent or replay observer spent in the current update. Each entry is only written by the thread that
+// steps its client, so the entries need no locking.
+struct StepTiming {
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::duration::zero();
+    bool stepped = false;
+};
+
+// Adds the time between construction and destruction to a StepTiming; every return path of a step is covered.
+class ScopedStepTimer {
+public:
+    explicit ScopedStepTimer(StepTiming& timing) : timing_(timing), start_(std::chrono::steady_clock::now()) {
     }
 
-    for (auto& t : threads) {
-        t.join();
+    ~ScopedStepTimer() {
+        timing_.elapsed += std::chrono::steady_clock::now() - start_;
+    }
+
+    ScopedStepTimer(const ScopedStepTimer&) = delete;
+    ScopedStepTimer& operator=(const ScopedStepTimer&) = delete;
+
+private:
+    StepTiming& timing_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+static void BeginStepTimings(std::vector<StepTiming>& timings, size_t count) {
+    timings.assign(count, StepTiming());
+}
+
+static void CommitStepTimings(const std::vector<StepTiming>& timings, std::vector<StepLatencyHistogram>& histograms) {
+    if (histograms.size() < timings.size()) {
+        histograms.resize(timings.size());
+    }
+
+    for (size_t i = 0; i < timings.size(); ++i) {
+        if (timings[i].stepped) {
+            const auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(timings[i].elapsed).count();
+            histograms[i].Add(static_cast<uint64_t>(elapsed_us));
+        }
     }
 }
 
@@ -139,6 +172,50 @@ static void CallOnStep(Agent* a) {
     }
 }
 
+void StepLatencyHistogram::Add(uint64_t elapsed_us) {
+    size_t bucket = 0;
+    for (uint64_t value = elapsed_us >> 1; value != 0 && bucket + 1 < kBucketCount; value >>= 1) {
+        ++bucket;
+    }
+
+    ++buckets[bucket];
+    ++sample_count;
+    total_us += elapsed_us;
+    max_us = std::max(max_us, elapsed_us);
+}
+
+void StepLatencyHistogram::Reset() {
+    *this = StepLatencyHistogram();
+}
+
+double StepLatencyHistogram::GetMeanMicroseconds() const {
+    if (sample_count == 0) {
+        return 0.0;
+    }
+
+    return static_cast<double>(total_us) / static_cast<double>(sample_count);
+}
+
+uint64_t StepLatencyHistogram::GetPercentileMicroseconds(double percentile) const {
+    if (sample_count == 0) {
+        return 0;
+    }
+
+    const double clamped = std::min(std::max(percentile, 0.0), 1.0);
+    const double scaled_rank = clamped * static_cast<double>(sample_count);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(scaled_rank)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            const uint64_t bucket_upper_us = (static_cast<uint64_t>(2) << i) - 1;
+            return std::min(bucket_upper_us, max_us);
+        }
+    }
+
+    return max_us;
+}
+
 // Implementation.
 class CoordinatorImp {
 public:
@@ -163,7 +240,9 @@ public:
     bool ShouldIgnore(ReplayObserver* r, const std::string& file);
     bool ShouldRelaunch(ReplayObserver* r);
 
+    void RunOnWorkers(size_t task_count, const std::function<void(size_t)>& task);
     void StepAgents();
+    void StepAgentsPipelined();
     void StepAgentsRealtime();
     void StepReplayObservers();
     void StepReplayObserversRealtime();
@@ -186,6 +265,21 @@ public:
     int last_port_ = 0;
 
     bool use_generalized_ability_id = true;
+
+    // Keep each agent's next step in flight while its OnStep runs. Trades one step of action latency for overlap
+    // between bot and game time.
+    bool pipelined_stepping_ = false;
+    std::vector<uint8_t> pipelined_step_sent_;
+
+    // Persistent threads that step agents and replay observers in parallel; started by the first update that has more
+    // than one client to step, and restarted only when more clients are added or pinning changes.
+    WorkerPool worker_pool_;
+    bool pin_worker_threads_ = false;
+
+    std::vector<StepTiming> agent_step_timings_;
+    std::vector<StepTiming> replay_observer_step_timings_;
+    std::vector<StepLatencyHistogram> agent_step_latencies_;
+    std::vector<StepLatencyHistogram> replay_observer_step_latencies_;
 };
 
 CoordinatorImp::CoordinatorImp()
@@ -198,6 +292,7 @@ CoordinatorImp::CoordinatorImp()
 }
 
 CoordinatorImp::~CoordinatorImp() {
+    worker_pool_.Stop();
     for (auto& p : process_settings_.process_info) {
         TerminateProcess(p.process_id);
     }
@@ -286,8 +381,26 @@ void CoordinatorImp::StartReplay() {
     starcraft_started_ = true;
 }
 
+void CoordinatorImp::RunOnWorkers(size_t task_count, const std::function<void(size_t)>& task) {
+    if (task_count == 1) {
+        task(0);
+        return;
+    }
+
+    if (worker_pool_.GetWorkerCount() < task_count || worker_pool_.IsPinned() != pin_worker_threads_) {
+        worker_pool_.Start(std::max(task_count, worker_pool_.GetWorkerCount()), pin_worker_threads_);
+    }
+
+    worker_pool_.Run(task_count, task);
+}
+
 void CoordinatorImp::StepAgents() {
-    auto step_agent = [this](Agent* a) {
+    BeginStepTimings(agent_step_timings_, agents_.size());
+
+    auto step_agent = [this](size_t index) {
+        Agent* a = agents_[index];
+        StepTiming& timing = agent_step_timings_[index];
+        ScopedStepTimer timer(timing);
         ControlInterface* control = a->Control();
 
         if (control->GetAppState() != AppState::normal) {
@@ -302,6 +415,7 @@ void CoordinatorImp::StepAgents() {
             return;
         }
 
+        timing.stepped = true;
         control->Step(process_settings_.step_size);
         control->WaitStep();
         if (process_settings_.multi_threaded) {
@@ -309,14 +423,11 @@ void CoordinatorImp::StepAgents() {
         }
     };
 
-    if (agents_.size() == 1) {
-        step_agent(agents_.front());
-    } else {
-        RunParallel(step_agent, agents_);
-    }
+    RunOnWorkers(agents_.size(), step_agent);
 
     if (!process_settings_.multi_threaded) {
-        for (auto a : agents_) {
+        for (size_t i = 0; i < agents_.size(); ++i) {
+            Agent* a = agents_[i];
             if (a->Control()->GetAppState() != AppState::normal) {
                 continue;
             }
@@ -326,13 +437,83 @@ void CoordinatorImp::StepAgents() {
                 continue;
             }
 
+            ScopedStepTimer timer(agent_step_timings_[i]);
             CallOnStep(a);
         }
     }
+
+    CommitStepTimings(agent_step_timings_, agent_step_latencies_);
+}
+
+void CoordinatorImp::StepAgentsPipelined() {
+    pipelined_step_sent_.assign(agents_.size(), 0);
+    BeginStepTimings(agent_step_timings_, agents_.size());
+
+    // Sends the next step before OnStep so the game simulates while the agent handles the previous observation.
+    // Leave-game polling has to happen first; it treats any other pending response as an error.
+    auto send_step = [this](size_t index) {
+        Agent* a = agents_[index];
+        ScopedStepTimer timer(agent_step_timings_[index]);
+        ControlInterface* control = a->Control();
+        if (control->GetAppState() != AppState::normal || control->PollLeaveGame() || !control->IsInGame()) {
+            return;
+        }
+
+        pipelined_step_sent_[index] = control->Step(process_settings_.step_size) ? 1 : 0;
+    };
+
+    auto call_on_step = [this](size_t index) {
+        Agent* a = agents_[index];
+        StepTiming& timing = agent_step_timings_[index];
+        ScopedStepTimer timer(timing);
+        if (a->Control()->GetAppState() != AppState::normal) {
+            return;
+        }
+
+        if (!pipelined_step_sent_[index] && a->Control()->PollLeaveGame()) {
+            return;
+        }
+
+        timing.stepped = true;
+        CallOnStep(a);
+    };
+
+    auto wait_step = [this](size_t index) {
+        if (pipelined_step_sent_[index]) {
+            ScopedStepTimer timer(agent_step_timings_[index]);
+            agents_[index]->Control()->WaitStep();
+        }
+    };
+
+    if (process_settings_.multi_threaded || agents_.size() == 1) {
+        RunOnWorkers(agents_.size(), [&send_step, &call_on_step, &wait_step](size_t index) {
+            send_step(index);
+            call_on_step(index);
+            wait_step(index);
+        });
+    } else {
+        // Single threaded OnStep with several agents: step every game, run each OnStep in turn, then collect the steps.
+        for (size_t i = 0; i < agents_.size(); ++i) {
+            send_step(i);
+        }
+        for (size_t i = 0; i < agents_.size(); ++i) {
+            call_on_step(i);
+        }
+        for (size_t i = 0; i < agents_.size(); ++i) {
+            wait_step(i);
+        }
+    }
+
+    CommitStepTimings(agent_step_timings_, agent_step_latencies_);
 }
 
 void CoordinatorImp::StepAgentsRealtime() {
-    auto step_agent = [](Agent* a) {
+    BeginStepTimings(agent_step_timings_, agents_.size());
+
+    auto step_agent = [this](size_t index) {
+        Agent* a = agents_[index];
+        StepTiming& timing = agent_step_timings_[index];
+        ScopedStepTimer timer(timing);
         ControlInterface* control = a->Control();
         if (!control) {
             return;
@@ -356,6 +537,7 @@ void CoordinatorImp::StepAgentsRealtime() {
         }
 
         // This agent shouldn't call step since it's real time.
+        timing.stepped = true;
         control->GetObservation();
         control->IssueEvents(a->Actions()->Commands());
         action->SendActions();
@@ -368,17 +550,24 @@ void CoordinatorImp::StepAgentsRealtime() {
     };
 
     if (process_settings_.multi_threaded) {
-        RunParallel(step_agent, agents_);
+        RunOnWorkers(agents_.size(), step_agent);
     } else {
-        for (auto a : agents_) {
-            step_agent(a);
+        for (size_t i = 0; i < agents_.size(); ++i) {
+            step_agent(i);
         }
     }
+
+    CommitStepTimings(agent_step_timings_, agent_step_latencies_);
 }
 
 void CoordinatorImp::StepReplayObservers() {
+    BeginStepTimings(replay_observer_step_timings_, replay_observers_.size());
+
     // Run all replay observers.
-    auto run_replay = [this](ReplayObserver* r) {
+    auto run_replay = [this](size_t index) {
+        ReplayObserver* r = replay_observers_[index];
+        StepTiming& timing = replay_observer_step_timings_[index];
+        ScopedStepTimer timer(timing);
         if (r->Control()->GetAppState() != AppState::normal) {
             return;
         }
@@ -393,6 +582,7 @@ void CoordinatorImp::StepReplayObservers() {
         }
 
         if (r->Control()->IsInGame()) {
+            timing.stepped = true;
             r->Control()->Step(process_settings_.step_size);
             r->Control()->WaitStep();
 
@@ -408,38 +598,33 @@ void CoordinatorImp::StepReplayObservers() {
         }
     };
 
-    if (replay_observers_.size() == 1) {
-        run_replay(replay_observers_.front());
-    } else {
-        // Run all steps in parallel.
-        std::vector<std::thread> threads;
-        threads.reserve(replay_observers_.size());
-        for (auto r : replay_observers_) {
-            threads.emplace_back(run_replay, r);
-        }
-
-        // Join all threads.
-        for (auto& t : threads) {
-            t.join();
-        }
-    }
+    RunOnWorkers(replay_observers_.size(), run_replay);
 
     // Do everyones OnStep, if not multi threaded, in single threaded mode.
     if (!process_settings_.multi_threaded) {
-        for (auto r : replay_observers_) {
+        for (size_t i = 0; i < replay_observers_.size(); ++i) {
+            ReplayObserver* r = replay_observers_[i];
             if (r->Control()->GetAppState() != AppState::normal) {
                 continue;
             }
 
+            ScopedStepTimer timer(replay_observer_step_timings_[i]);
             r->Control()->IssueEvents();
             r->ObserverAction()->SendActions();
         }
     }
+
+    CommitStepTimings(replay_observer_step_timings_, replay_observer_step_latencies_);
 }
 
 void CoordinatorImp::StepReplayObserversRealtime() {
+    BeginStepTimings(replay_observer_step_timings_, replay_observers_.size());
+
     // Run all replay observers.
-    auto run_replay = [this](ReplayObserver* r) {
+    auto run_replay = [this](size_t index) {
+        ReplayObserver* r = replay_observers_[index];
+        StepTiming& timing = replay_observer_step_timings_[index];
+        ScopedStepTimer timer(timing);
         if (r->Control()->GetAppState() != AppState::normal) {
             return;
         }
@@ -454,6 +639,7 @@ void CoordinatorImp::StepReplayObserversRealtime() {
         }
 
         if (r->Control()->IsInGame()) {
+            timing.stepped = true;
             r->Control()->GetObservation();
 
             // If multithreaded run everyones OnStep in parallel.
@@ -467,32 +653,22 @@ void CoordinatorImp::StepReplayObserversRealtime() {
         }
     };
 
-    if (replay_observers_.size() == 1) {
-        run_replay(replay_observers_.front());
-    } else {
-        // Run all steps in parallel.
-        std::vector<std::thread> threads;
-        threads.reserve(replay_observers_.size());
-        for (auto r : replay_observers_) {
-            threads.emplace_back(run_replay, r);
-        }
-
-        // Join all threads.
-        for (auto& t : threads) {
-            t.join();
-        }
-    }
+    RunOnWorkers(replay_observers_.size(), run_replay);
 
     // Do everyones OnStep, if not multi threaded, in single threaded mode.
     if (!process_settings_.multi_threaded) {
-        for (auto r : replay_observers_) {
+        for (size_t i = 0; i < replay_observers_.size(); ++i) {
+            ReplayObserver* r = replay_observers_[i];
             if (r->Control()->GetAppState() != AppState::normal) {
                 continue;
             }
 
+            ScopedStepTimer timer(replay_observer_step_timings_[i]);
             r->Control()->IssueEvents();
         }
     }
+
+    CommitStepTimings(replay_observer_step_timings_, replay_observer_step_latencies_);
 }
 
 bool CoordinatorImp::WaitForAllResponses() {
@@ -585,6 +761,7 @@ bool CoordinatorImp::JoinGame() {
         }
 
         c->Control()->UseGeneralizedAbility(use_generalized_ability_id);
+        c->Control()->SetPipelinedStepping(pipelined_stepping_ && !process_settings_.realtime);
     }
 
     if (errors_occurred) {
@@ -754,6 +931,8 @@ bool Coordinator::Update() {
     if (imp_->agents_.size() > 0) {
         if (imp_->process_settings_.realtime) {
             imp_->StepAgentsRealtime();
+        } else if (imp_->pipelined_stepping_) {
+            imp_->StepAgentsPipelined();
         } else {
             imp_->StepAgents();
         }
@@ -826,20 +1005,60 @@ bool Coordinator::AllGamesEnded() const {
     return true;
 }
 
+const StepLatencyHistogram& Coordinator::GetAgentStepLatency(size_t agent_index) const {
+    static const StepLatencyHistogram empty_histogram;
+    if (agent_index >= imp_->agent_step_latencies_.size()) {
+        return empty_histogram;
+    }
+
+    return imp_->agent_step_latencies_[agent_index];
+}
+
+const StepLatencyHistogram& Coordinator::GetReplayObserverStepLatency(size_t replay_observer_index) const {
+    static const StepLatencyHistogram empty_histogram;
+    if (replay_observer_index >= imp_->replay_observer_step_latencies_.size()) {
+        return empty_histogram;
+    }
+
+    return imp_->replay_observer_step_latencies_[replay_observer_index];
+}
+
+void Coordinator::ResetStepLatencies() {
+    for (auto& histogram : imp_->agent_step_latencies_) {
+        histogram.Reset();
+    }
+    for (auto& histogram : imp_->replay_observer_step_latencies_) {
+        histogram.Reset();
+    }
+}
+
 void CoordinatorImp::AddAgent(Agent* agent) {
     assert(agent);
     agents_.push_back(agent);
+    agent_step_latencies_.resize(agents_.size());
 }
 
 void Coordinator::AddReplayObserver(ReplayObserver* replay_observer) {
     assert(replay_observer);
     imp_->replay_observers_.push_back(replay_observer);
+    imp_->replay_observer_step_latencies_.resize(imp_->replay_observers_.size());
 }
 
 void Coordinator::SetMultithreaded(bool value) {
     imp_->process_settings_.multi_threaded = value;
 }
 
+void Coordinator::SetWorkerThreadPinning(bool value) {
+    imp_->pin_worker_threads_ = value;
+}
+
+void Coordinator::SetPipelinedStepping(bool value) {
+    imp_->pipelined_stepping_ = value;
+    for (auto a : imp_->agents_) {
+        a->Control()->SetPipelinedStepping(value && !imp_->process_settings_.realtime);
+    }
+}
+
 void Coordinator::SetRealtime(bool value) {
     // Realtime must be set before LaunchStarcraft is called.
     assert(!imp_->starcraft_started_);
@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -20,6 +23,32 @@ class Agent;
 class ReplayObserver;
 class CoordinatorImp;
 
+//! Distribution of how long one agent or replay observer took per Update. Samples fall into power-of-two microsecond
+//! buckets, so percentiles are reported as the upper bound of the matching bucket.
+struct StepLatencyHistogram {
+    static const size_t kBucketCount = 32;
+
+    //! Sample counts; bucket 0 holds [0, 2) us and bucket i holds [2^i, 2^(i + 1)) us.
+    std::array<uint64_t, kBucketCount> buckets{};
+    uint64_t sample_count = 0;
+    uint64_t total_us = 0;
+    uint64_t max_us = 0;
+
+    //! Records one step.
+    //!< \param elapsed_us The time the step took in microseconds.
+    void Add(uint64_t elapsed_us);
+
+    //! Clears every sample.
+    void Reset();
+
+    //!< \return The mean step time in microseconds, or 0 if there are no samples.
+    double GetMeanMicroseconds() const;
+
+    //!< \param percentile A value in [0, 1], e.g. 0.99 for the 99th percentile.
+    //!< \return The bucket upper bound that covers the percentile, capped at the largest sample.
+    uint64_t GetPercentileMicroseconds(double percentile) const;
+};
+
 //! Coordinator of one or more clients. Used to start, step and stop games and replays.
 class Coordinator {
 public:
@@ -42,6 +71,19 @@ public:
     //! are thread-safe if they reach into shared code. \param value True to multithread, false otherwise.
     void SetMultithreaded(bool value);
 
+    //! Pins each worker thread that steps agents and replay observers to its own core. Workers persist across updates
+    //! and each client is always stepped by the same worker, so pinning also keeps a client on the same core.
+    //! Takes effect on the next Update.
+    //!< \param value True to pin workers to cores.
+    void SetWorkerThreadPinning(bool value);
+
+    //! Specifies whether each agent's next step should already be in flight while its OnStep runs. The game then
+    //! simulates while the bot thinks, at the cost of one step of latency: actions issued in OnStep are sent after the
+    //! step completes and take effect from the next observation on. Requests made during OnStep, such as queries,
+    //! first wait for the in-flight step. Has no effect in realtime mode or on replay observers.
+    //! \param value True to pipeline steps, false for strictly sequential step, observe and OnStep.
+    void SetPipelinedStepping(bool value);
+
     //! Specifies whether the game should run in realtime or not. If the game is running in real time that means the
     //! coordinator is not stepping it forward. The game is running and your bot reaches into it asynchronously to read
     //! state. \param value True to be realtime, false otherwise.
@@ -183,6 +225,20 @@ public:
     //! Returns true if all running games have ended.
     bool AllGamesEnded() const;
 
+    //! Wall time each agent spent in Update: stepping the game, dispatching events and its OnStep. Only updates in
+    //! which the agent stepped are recorded.
+    //!< \param agent_index The index of the agent in the order it was added.
+    //!< \return The agent's histogram, or an empty histogram if the index is out of range.
+    const StepLatencyHistogram& GetAgentStepLatency(size_t agent_index) const;
+
+    //! Wall time each replay observer spent in Update, recorded like GetAgentStepLatency.
+    //!< \param replay_observer_index The index of the replay observer in the order it was added.
+    //!< \return The replay observer's histogram, or an empty histogram if the index is out of range.
+    const StepLatencyHistogram& GetReplayObserverStepLatency(size_t replay_observer_index) const;
+
+    //! Clears every agent and replay observer step-latency histogram.
+    void ResetStepLatencies();
+
     // Replay specific.
     //! Sets the path for to a folder of replays to analyze.
     // \param path The folder path.
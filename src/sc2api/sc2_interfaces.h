@@ -8,6 +8,7 @@ be of little concern to the consumer.
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "sc2_action.h"
@@ -28,6 +29,7 @@ enum class ABILITY_ID;
 class ObservationInterface;
 struct Score;
 struct GameInfo;
+class MapGrids;
 
 enum class Visibility { Hidden = 0, Fogged = 1, Visible = 2, FullHidden = 3 };
 
@@ -222,6 +224,14 @@ public:
     //!< \return Height.
     virtual float TerrainHeight(const Point2D& point) const = 0;
 
+    //! Returns the map images of the current step decoded into bit and byte grids, for callers that sample many
+    //! points or whole footprints. Decoding happens at most once per step. Implementations that do not decode grids
+    //! return nullptr.
+    //!< \return The decoded grids, or nullptr.
+    virtual const MapGrids* GetMapGrids() const {
+        return nullptr;
+    }
+
     //! A pointer to the low-level protocol data for the current observation. While it's possible to extract most
     //! in-game data from this pointer
     // it is highly discouraged. It should only be used for extracting feature layers because it would be inefficient to
@@ -299,6 +309,53 @@ public:
     //!< \param queries Placement queries.
     //!< \return Array of bools indicating if placement is possible.
     virtual std::vector<bool> Placement(const std::vector<PlacementQuery>& queries) = 0;
+
+    //! Issues multiple pathing queries into a caller-owned array, so callers that query every frame can keep its
+    //! storage, and reports whether the game answered.
+    //!< \param queries Pathing queries.
+    //!< \param distances Receives one distance per query. Every distance is 0 when the game did not answer.
+    //!< \return False if the game did not answer, in which case the distances must not be kept.
+    virtual bool TryPathingDistance(const std::vector<PathingQuery>& queries, std::vector<float>& distances) {
+        distances = PathingDistance(queries);
+        if (distances.size() != queries.size()) {
+            distances.assign(queries.size(), 0.0f);
+            return false;
+        }
+        return true;
+    }
+    //! Issues multiple placement queries into a caller-owned array, and reports whether the game answered.
+    //!< \param queries Placement queries.
+    //!< \param results Receives one result per query. Every result is false when the game did not answer.
+    //!< \return False if the game did not answer, in which case the results must not be kept.
+    virtual bool TryPlacement(const std::vector<PlacementQuery>& queries, std::vector<bool>& results) {
+        results = Placement(queries);
+        if (results.size() != queries.size()) {
+            results.assign(queries.size(), false);
+            return false;
+        }
+        return true;
+    }
+
+    //! Counters for the cross-frame placement and pathing result cache.
+    struct CacheStats {
+        uint64_t placement_hits = 0;
+        uint64_t placement_misses = 0;
+        uint64_t pathing_hits = 0;
+        uint64_t pathing_misses = 0;
+        //! Number of map regions whose cached placement results were dropped.
+        uint64_t invalidated_regions = 0;
+        //! Number of times every cached pathing result was dropped.
+        uint64_t pathing_invalidations = 0;
+    };
+    //! Returns the result cache counters. Implementations without a cache report zeros.
+    virtual CacheStats GetCacheStats() const {
+        return CacheStats();
+    }
+    //! Enables or disables the result cache. Disabling it drops every cached result.
+    //!< \param enabled Whether repeated placement and pathing queries may be answered from the cache.
+    virtual void SetCacheEnabled(bool enabled) {
+        (void)enabled;
+    }
 };
 
 //! The ActionInterface issues actions to units in a game. Not available in replays.
@@ -1,7 +1,14 @@
 #include "sc2_map_info.h"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SC2_MAP_INFO_SSE2 1
+#endif
+
 namespace sc2 {
 
 ImageData::ImageData() : width(0), height(0), bits_per_pixel(0) {
@@ -133,4 +140,255 @@ void HeightMap::Dump(const std::string& file_path) const {
     }
 }
 
+//-------------------------------------------------------------------------------------------------
+// Map grid decoding.
+//-------------------------------------------------------------------------------------------------
+
+namespace {
+
+// How an 8 bit per pixel image maps onto one bit per cell.
+enum class BytePredicate { Equal255, NotEqual255, NonZero };
+
+bool HasImageData(const std::string& data, int width, int height, int bits_per_pixel) {
+    if (width <= 0 || height <= 0)
+        return false;
+
+    const size_t cells = static_cast<size_t>(width) * static_cast<size_t>(height);
+    if (bits_per_pixel == 1)
+        return data.size() >= (cells + 7) / 8;
+
+    if (bits_per_pixel == 8)
+        return data.size() >= cells;
+
+    return false;
+}
+
+// Reverses the bit order inside each byte of a word.
+uint64_t ReverseBitsInBytes(uint64_t word) {
+    word = ((word >> 1) & 0x5555555555555555ULL) | ((word & 0x5555555555555555ULL) << 1);
+    word = ((word >> 2) & 0x3333333333333333ULL) | ((word & 0x3333333333333333ULL) << 2);
+    word = ((word >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return word;
+}
+
+// 1 bpp images are one unpadded bit stream, most significant bit first, so cell i is bit 7 - i % 8 of byte i / 8.
+void Decode1Bpp(const std::string& data, BitGrid& grid) {
+    const int width = grid.Width();
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data());
+
+    if (width % 8 == 0) {
+        // Rows start on a byte boundary: gather eight source bytes per word and flip each byte to LSB-first order.
+        const int row_bytes = width / 8;
+        for (int y = 0; y < grid.Height(); ++y) {
+            const unsigned char* src = bytes + static_cast<size_t>(y) * row_bytes;
+            uint64_t* dst = grid.Row(y);
+            for (int word_index = 0; word_index < grid.WordsPerRow(); ++word_index) {
+                const int first_byte = word_index * 8;
+                const int byte_count = std::min(8, row_bytes - first_byte);
+                uint64_t word = 0;
+                for (int i = 0; i < byte_count; ++i) {
+                    word |= static_cast<uint64_t>(src[first_byte + i]) << (8 * i);
+                }
+                dst[word_index] = ReverseBitsInBytes(word);
+            }
+        }
+        return;
+    }
+
+    size_t bit = 0;
+    for (int y = 0; y < grid.Height(); ++y) {
+        uint64_t* dst = grid.Row(y);
+        for (int x = 0; x < width; ++x, ++bit) {
+            const uint64_t value = (bytes[bit >> 3] >> (7 - (bit & 7))) & 1;
+            dst[x >> 6] |= value << (x & 63);
+        }
+    }
+}
+
+bool TestByte(unsigned char value, BytePredicate predicate) {
+    switch (predicate) {
+        case BytePredicate::Equal255:
+            return value == 255;
+        case BytePredicate::NotEqual255:
+            return value != 255;
+        case BytePredicate::NonZero:
+            return value != 0;
+    }
+    return false;
+}
+
+void Decode8Bpp(const std::string& data, BytePredicate predicate, BitGrid& grid) {
+    const int width = grid.Width();
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data());
+
+    for (int y = 0; y < grid.Height(); ++y) {
+        const unsigned char* src = bytes + static_cast<size_t>(y) * width;
+        uint64_t* dst = grid.Row(y);
+        int x = 0;
+#if defined(SC2_MAP_INFO_SSE2)
+        // 16 cells per compare; the byte mask lands directly on 16 consecutive bits of the row.
+        const __m128i reference = _mm_set1_epi8(predicate == BytePredicate::NonZero ? 0 : static_cast<char>(0xFF));
+        const bool invert = predicate != BytePredicate::Equal255;
+        for (; x + 16 <= width; x += 16) {
+            const __m128i cells = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(cells, reference)));
+            if (invert)
+                mask = ~mask & 0xFFFFu;
+
+            // x is a multiple of 16, so the 16 bits never straddle a word.
+            dst[x >> 6] |= static_cast<uint64_t>(mask) << (x & 63);
+        }
+#endif
+        for (; x < width; ++x) {
+            if (TestByte(src[x], predicate))
+                dst[x >> 6] |= uint64_t(1) << (x & 63);
+        }
+    }
+}
+
+void DecodeBits(const std::string& data, int width, int height, int bits_per_pixel, BytePredicate predicate,
+                BitGrid& grid) {
+    if (!HasImageData(data, width, height, bits_per_pixel)) {
+        grid.Reset(0, 0);
+        return;
+    }
+
+    grid.Reset(width, height);
+    if (bits_per_pixel == 1)
+        Decode1Bpp(data, grid);
+    else
+        Decode8Bpp(data, predicate, grid);
+}
+
+void DecodeBytes(const std::string& data, int width, int height, int bits_per_pixel, ByteGrid& grid) {
+    if (bits_per_pixel != 8 || !HasImageData(data, width, height, bits_per_pixel)) {
+        grid.Reset(0, 0);
+        return;
+    }
+
+    grid.Reset(width, height);
+    std::memcpy(grid.Data(), data.data(), static_cast<size_t>(width) * height);
+}
+
+// Maps visibility bytes onto the Visibility enum: 0, 1 and 2 keep their value, everything else becomes FullHidden.
+void ClampVisibility(ByteGrid& grid) {
+    uint8_t* cells = grid.Data();
+    const size_t count = static_cast<size_t>(grid.Width()) * grid.Height();
+    size_t i = 0;
+#if defined(SC2_MAP_INFO_SSE2)
+    const __m128i full_hidden = _mm_set1_epi8(3);
+    for (; i + 16 <= count; i += 16) {
+        __m128i* block = reinterpret_cast<__m128i*>(cells + i);
+        _mm_storeu_si128(block, _mm_min_epu8(_mm_loadu_si128(block), full_hidden));
+    }
+#endif
+    for (; i < count; ++i) {
+        cells[i] = std::min<uint8_t>(cells[i], 3);
+    }
+}
+
+}  // namespace
+
+BitGrid::BitGrid() : width_(0), height_(0), words_per_row_(0) {
+}
+
+void BitGrid::Reset(int width, int height) {
+    width_ = std::max(width, 0);
+    height_ = std::max(height, 0);
+    words_per_row_ = (width_ + 63) / 64;
+    words_.assign(static_cast<size_t>(words_per_row_) * height_, 0);
+}
+
+void BitGrid::Set(int x, int y, bool value) {
+    if (!Contain(x, y))
+        return;
+
+    uint64_t& word = Row(y)[x >> 6];
+    const uint64_t bit = uint64_t(1) << (x & 63);
+    word = value ? (word | bit) : (word & ~bit);
+}
+
+bool BitGrid::IsRowSpanSet(int y, int x_min, int x_max) const {
+    if (x_min > x_max)
+        return true;
+
+    if (!Contain(x_min, y) || !Contain(x_max, y))
+        return false;
+
+    const uint64_t* row = Row(y);
+    const int first_word = x_min >> 6;
+    const int last_word = x_max >> 6;
+    const uint64_t first_mask = ~uint64_t(0) << (x_min & 63);
+    const uint64_t last_mask = ~uint64_t(0) >> (63 - (x_max & 63));
+
+    if (first_word == last_word) {
+        const uint64_t mask = first_mask & last_mask;
+        return (row[first_word] & mask) == mask;
+    }
+
+    if ((row[first_word] & first_mask) != first_mask)
+        return false;
+
+    for (int word_index = first_word + 1; word_index < last_word; ++word_index) {
+        if (row[word_index] != ~uint64_t(0))
+            return false;
+    }
+
+    return (row[last_word] & last_mask) == last_mask;
+}
+
+bool BitGrid::IsRectSet(const Point2DI& min, const Point2DI& max) const {
+    for (int y = min.y; y <= max.y; ++y) {
+        if (!IsRowSpanSet(y, min.x, max.x))
+            return false;
+    }
+
+    return true;
+}
+
+ByteGrid::ByteGrid() : width_(0), height_(0) {
+}
+
+void ByteGrid::Reset(int width, int height) {
+    width_ = std::max(width, 0);
+    height_ = std::max(height, 0);
+    bytes_.assign(static_cast<size_t>(width_) * height_, 0);
+}
+
+MapGrids::MapGrids() {
+}
+
+void MapGrids::DecodeGameInfo(const GameInfo& info) {
+    const ImageData& pathing = info.pathing_grid;
+    DecodeBits(pathing.data, pathing.width, pathing.height, pathing.bits_per_pixel, BytePredicate::NotEqual255,
+               pathing_);
+
+    const ImageData& placement = info.placement_grid;
+    DecodeBits(placement.data, placement.width, placement.height, placement.bits_per_pixel, BytePredicate::Equal255,
+               placement_);
+
+    const ImageData& height = info.terrain_height;
+    DecodeBytes(height.data, height.width, height.height, height.bits_per_pixel, terrain_height_);
+}
+
+void MapGrids::DecodeMapState(const SC2APIProtocol::MapState& map_state) {
+    const SC2APIProtocol::ImageData& creep = map_state.creep();
+    DecodeBits(creep.data(), creep.size().x(), creep.size().y(), creep.bits_per_pixel(), BytePredicate::NonZero,
+               creep_);
+
+    const SC2APIProtocol::ImageData& visibility = map_state.visibility();
+    DecodeBytes(visibility.data(), visibility.size().x(), visibility.size().y(), visibility.bits_per_pixel(),
+                visibility_);
+    ClampVisibility(visibility_);
+}
+
+void MapGrids::ClearMapState() {
+    creep_.Reset(0, 0);
+    visibility_.Reset(0, 0);
+}
+
+bool MapGrids::HasTerrain() const {
+    return pathing_.Width() > 0 && placement_.Width() > 0;
+}
+
 }  // namespace sc2
@@ -3,6 +3,7 @@
 */
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -12,6 +13,8 @@
 
 namespace sc2 {
 
+enum class Visibility;
+
 //! Data for a feature layer or rendered image.
 struct ImageData {
     int width;
@@ -160,4 +163,198 @@ private:
     SampleImage height_map_;
 };
 
+//! One bit per map cell, packed into 64-bit words. Each row starts on a word boundary so spans of a row can be tested a
+//! word at a time; cell (x, y) is bit x % 64 of word x / 64 of row y.
+class BitGrid {
+public:
+    BitGrid();
+
+    //! Resizes the grid and clears every cell.
+    //!< \param width Number of cells in X.
+    //!< \param height Number of cells in Y.
+    void Reset(int width, int height);
+
+    int Width() const {
+        return width_;
+    }
+
+    int Height() const {
+        return height_;
+    }
+
+    int WordsPerRow() const {
+        return words_per_row_;
+    }
+
+    //!< \return True if the cell is inside the grid.
+    bool Contain(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width_ && y < height_;
+    }
+
+    //!< \return The cell value, false outside the grid.
+    bool Get(int x, int y) const {
+        if (!Contain(x, y))
+            return false;
+
+        return (words_[static_cast<size_t>(y) * words_per_row_ + (x >> 6)] >> (x & 63)) & 1;
+    }
+
+    void Set(int x, int y, bool value);
+
+    //! Returns true if every cell from x_min to x_max inclusive on row y is set. Empty spans are set; spans that
+    //! leave the grid are not.
+    bool IsRowSpanSet(int y, int x_min, int x_max) const;
+
+    //! Returns true if every cell of the rectangle between the two corners inclusive is set.
+    //!< \sa IsRowSpanSet
+    bool IsRectSet(const Point2DI& min, const Point2DI& max) const;
+
+    uint64_t* Row(int y) {
+        return words_.data() + static_cast<size_t>(y) * words_per_row_;
+    }
+
+    const uint64_t* Row(int y) const {
+        return words_.data() + static_cast<size_t>(y) * words_per_row_;
+    }
+
+private:
+    int width_;
+    int height_;
+    int words_per_row_;
+    std::vector<uint64_t> words_;
+};
+
+//! One byte per map cell, row-major with the same origin as the source image.
+class ByteGrid {
+public:
+    ByteGrid();
+
+    //! Resizes the grid and sets every cell to zero.
+    void Reset(int width, int height);
+
+    int Width() const {
+        return width_;
+    }
+
+    int Height() const {
+        return height_;
+    }
+
+    bool Contain(int x, int y) const {
+        return x >= 0 && y >= 0 && x < width_ && y < height_;
+    }
+
+    //!< \return The cell value, or fallback outside the grid.
+    uint8_t Get(int x, int y, uint8_t fallback) const {
+        if (!Contain(x, y))
+            return fallback;
+
+        return bytes_[static_cast<size_t>(y) * width_ + x];
+    }
+
+    uint8_t* Data() {
+        return bytes_.data();
+    }
+
+    const uint8_t* Data() const {
+        return bytes_.data();
+    }
+
+private:
+    int width_;
+    int height_;
+    std::vector<uint8_t> bytes_;
+};
+
+//! Map images decoded once into grids that answer point, row-span and rectangle queries without touching the
+//! protocol data. Static terrain (pathing, placement, height) comes from GameInfo; creep and visibility come from the
+//! map state of an observation. Point queries return the same values as PathingGrid, PlacementGrid, HeightMap and
+//! ObservationInterface, including their results outside the map.
+class MapGrids {
+public:
+    MapGrids();
+
+    //! Decodes pathing, placement and terrain height. Images with an unsupported format or too little data decode
+    //! to empty grids.
+    void DecodeGameInfo(const GameInfo& info);
+
+    //! Decodes creep and visibility.
+    void DecodeMapState(const SC2APIProtocol::MapState& map_state);
+
+    //! Empties the creep and visibility grids, as when an observation has no map state.
+    void ClearMapState();
+
+    bool IsPathable(const Point2DI& point) const {
+        return pathing_.Get(point.x, point.y);
+    }
+
+    bool IsPlacable(const Point2DI& point) const {
+        return placement_.Get(point.x, point.y);
+    }
+
+    bool HasCreep(const Point2DI& point) const {
+        return creep_.Get(point.x, point.y);
+    }
+
+    //! Visibility is stored already clamped so the byte maps directly onto the enum; 3 is FullHidden.
+    Visibility GetVisibility(const Point2DI& point) const {
+        return static_cast<Visibility>(visibility_.Get(point.x, point.y, 3));
+    }
+
+    float TerrainHeight(const Point2DI& point) const {
+        if (!terrain_height_.Contain(point.x, point.y))
+            return 0.0f;
+
+        return (static_cast<float>(terrain_height_.Get(point.x, point.y, 0)) - 127) / 8.f;
+    }
+
+    //! Returns true if every cell between the two corners inclusive is pathable.
+    bool IsAreaPathable(const Point2DI& min, const Point2DI& max) const {
+        return pathing_.IsRectSet(min, max);
+    }
+
+    //! Returns true if every cell between the two corners inclusive is placable, e.g. a whole structure footprint.
+    bool IsAreaPlacable(const Point2DI& min, const Point2DI& max) const {
+        return placement_.IsRectSet(min, max);
+    }
+
+    bool IsRowSpanPathable(int y, int x_min, int x_max) const {
+        return pathing_.IsRowSpanSet(y, x_min, x_max);
+    }
+
+    bool IsRowSpanPlacable(int y, int x_min, int x_max) const {
+        return placement_.IsRowSpanSet(y, x_min, x_max);
+    }
+
+    //!< \return True once DecodeGameInfo has produced non-empty terrain grids.
+    bool HasTerrain() const;
+
+    const BitGrid& Pathing() const {
+        return pathing_;
+    }
+
+    const BitGrid& Placement() const {
+        return placement_;
+    }
+
+    const BitGrid& Creep() const {
+        return creep_;
+    }
+
+    const ByteGrid& VisibilityGrid() const {
+        return visibility_;
+    }
+
+    const ByteGrid& TerrainHeightGrid() const {
+        return terrain_height_;
+    }
+
+private:
+    BitGrid pathing_;
+    BitGrid placement_;
+    BitGrid creep_;
+    ByteGrid visibility_;
+    ByteGrid terrain_height_;
+};
+
 }  // namespace sc2
@@ -0,0 +1,520 @@
+#include "sc2_mock_game.h"
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <initializer_list>
+#include <queue>
+#include <random>
+#include <utility>
+
+#include "sc2_proto_interface.h"
+
+namespace sc2 {
+
+namespace {
+
+const uint64_t kSelfTagBase = 0x100000000ULL;
+const uint64_t kEnemyTagBase = 0x200000000ULL;
+const uint64_t kNeutralTagBase = 0x300000000ULL;
+const uint32_t kMarineUnitType = 48;
+const float kMarineHealth = 45.0f;
+const unsigned int kIdleWaitUs = 10000;
+const int kGridColumns = 8;
+const float kStructureSpacing = 5.0f;
+const float kStructureRadius = 1.75f;
+const float kResourceSpacing = 2.0f;
+const float kResourceOffset = 44.0f;
+const float kMovementSpeed = 3.15f;
+const float kWeaponDamage = 6.0f;
+const float kWeaponRange = 5.0f;
+const float kWeaponCooldown = 0.61f;
+
+void FillImage(SC2APIProtocol::ImageData* image, int width, int height, int bits_per_pixel, uint8_t value) {
+    image->set_bits_per_pixel(bits_per_pixel);
+    image->mutable_size()->set_x(width);
+    image->mutable_size()->set_y(height);
+    const size_t bit_count = static_cast<size_t>(width) * static_cast<size_t>(height) * bits_per_pixel;
+    image->set_data(std::string((bit_count + 7) / 8, static_cast<char>(value)));
+}
+
+SC2APIProtocol::Unit* AddUnit(SC2APIProtocol::ObservationRaw& raw, uint64_t tag, uint32_t unit_type,
+                              SC2APIProtocol::Alliance alliance, int owner, float x, float y, float facing) {
+    SC2APIProtocol::Unit* unit = raw.add_units();
+    unit->set_display_type(SC2APIProtocol::DisplayType::Visible);
+    unit->set_alliance(alliance);
+    unit->set_tag(tag);
+    unit->set_unit_type(unit_type);
+    unit->set_owner(owner);
+    unit->mutable_pos()->set_x(x);
+    unit->mutable_pos()->set_y(y);
+    unit->mutable_pos()->set_z(8.0f);
+    unit->set_facing(facing);
+    unit->set_radius(0.375f);
+    unit->set_build_progress(1.0f);
+    unit->set_health(kMarineHealth);
+    unit->set_health_max(kMarineHealth);
+    return unit;
+}
+
+// Structures and resources fill rows of eight outward from a corner of the map.
+void GetGridPosition(int index, float corner, float direction, float spacing, float& x, float& y) {
+    x = corner + direction * spacing * static_cast<float>(index % kGridColumns);
+    y = corner + direction * spacing * static_cast<float>(index / kGridColumns);
+}
+
+// Adds one side's units. Mobile units circle their quarter of the map, one degree per game loop, in the direction
+// of turn.
+void AddSideUnits(SC2APIProtocol::ObservationRaw& raw, const std::vector<MockUnitGroup>& groups, uint64_t tag_base,
+                  SC2APIProtocol::Alliance alliance, int owner, float map_size, float center, float corner,
+                  float direction, float turn) {
+    uint64_t tag = tag_base;
+    int mobile_index = 0;
+    int structure_index = 0;
+    for (const MockUnitGroup& group : groups) {
+        for (int i = 0; i < group.count; ++i, ++tag) {
+            SC2APIProtocol::Unit* unit = nullptr;
+            if (group.is_structure) {
+                float x = 0.0f;
+                float y = 0.0f;
+                GetGridPosition(structure_index++, corner, direction, kStructureSpacing, x, y);
+                unit = AddUnit(raw, tag, group.unit_type, alliance, owner, x, y, 0.0f);
+                unit->set_radius(kStructureRadius);
+            } else {
+                const int index = mobile_index++;
+                const float radius = 2.0f + static_cast<float>(index % 16) * map_size * 0.01f;
+                const float angle = static_cast<float>(index) * 2.39996f + turn;
+                unit = AddUnit(raw, tag, group.unit_type, alliance, owner, center + radius * std::cos(angle),
+                               center + radius * std::sin(angle), angle);
+            }
+            unit->set_mineral_contents(group.mineral_contents);
+            unit->set_vespene_contents(group.vespene_contents);
+        }
+    }
+}
+
+float Distance(const SC2APIProtocol::Point2D& a, const SC2APIProtocol::Point2D& b) {
+    const float dx = a.x() - b.x();
+    const float dy = a.y() - b.y();
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+}  // namespace
+
+MockGame::MockGame(const MockGameSettings& settings)
+    : settings_(settings), status_(SC2APIProtocol::Status::launched), game_loop_(0) {
+    if (settings_.self_units.empty()) {
+        settings_.self_units.push_back(MockUnitGroup{kMarineUnitType, settings_.self_unit_count});
+    }
+    if (settings_.enemy_units.empty()) {
+        settings_.enemy_units.push_back(MockUnitGroup{kMarineUnitType, settings_.enemy_unit_count});
+    }
+}
+
+bool MockGame::Open() {
+    if (settings_.recording_path.empty()) {
+        return true;
+    }
+
+    playback_.reset(new ProtoPlayback());
+    return playback_->Open(settings_.recording_path);
+}
+
+uint32_t MockGame::GetGameLoop() const {
+    return game_loop_;
+}
+
+void MockGame::Respond(const SC2APIProtocol::Request& request, SC2APIProtocol::Response& response) {
+    if (playback_) {
+        playback_->Respond(request, response);
+        return;
+    }
+
+    switch (request.request_case()) {
+        case SC2APIProtocol::Request::kPing: {
+            response.mutable_ping()->set_game_version("mock");
+            break;
+        }
+        case SC2APIProtocol::Request::kCreateGame: {
+            response.mutable_create_game();
+            status_ = SC2APIProtocol::Status::init_game;
+            break;
+        }
+        case SC2APIProtocol::Request::kJoinGame: {
+            response.mutable_join_game()->set_player_id(1);
+            status_ = SC2APIProtocol::Status::in_game;
+            game_loop_ = 0;
+            break;
+        }
+        case SC2APIProtocol::Request::kRestartGame: {
+            response.mutable_restart_game();
+            status_ = SC2APIProtocol::Status::in_game;
+            game_loop_ = 0;
+            break;
+        }
+        case SC2APIProtocol::Request::kLeaveGame: {
+            response.mutable_leave_game();
+            status_ = SC2APIProtocol::Status::launched;
+            break;
+        }
+        case SC2APIProtocol::Request::kQuit: {
+            response.mutable_quit();
+            status_ = SC2APIProtocol::Status::quit;
+            break;
+        }
+        case SC2APIProtocol::Request::kGameInfo: {
+            FillGameInfo(*response.mutable_game_info());
+            break;
+        }
+        case SC2APIProtocol::Request::kObservation: {
+            FillObservation(*response.mutable_observation()->mutable_observation());
+            break;
+        }
+        case SC2APIProtocol::Request::kStep: {
+            response.mutable_step();
+            const uint32_t count = request.step().count() > 0 ? request.step().count() : 1;
+            game_loop_ += count;
+            if (settings_.game_loop_limit > 0 && game_loop_ >= settings_.game_loop_limit) {
+                status_ = SC2APIProtocol::Status::ended;
+            }
+            break;
+        }
+        case SC2APIProtocol::Request::kAction: {
+            SC2APIProtocol::ResponseAction* response_action = response.mutable_action();
+            for (int i = 0; i < request.action().actions_size(); ++i) {
+                response_action->add_result(SC2APIProtocol::ActionResult::Success);
+            }
+            break;
+        }
+        case SC2APIProtocol::Request::kQuery: {
+            FillQuery(request.query(), *response.mutable_query());
+            break;
+        }
+        case SC2APIProtocol::Request::kData: {
+            FillData(*response.mutable_data());
+            break;
+        }
+        case SC2APIProtocol::Request::kDebug: {
+            response.mutable_debug();
+            break;
+        }
+        case SC2APIProtocol::Request::kSaveReplay: {
+            response.mutable_save_replay();
+            break;
+        }
+        default: {
+            response.add_error(std::string("The mock game does not answer ") +
+                               RequestResponseIDToName(request.request_case()) + " requests.");
+            break;
+        }
+    }
+
+    response.set_status(status_);
+}
+
+void MockGame::FillObservation(SC2APIProtocol::Observation& observation) const {
+    int food_used = 0;
+    for (const MockUnitGroup& group : settings_.self_units) {
+        food_used += group.is_structure ? 0 : group.count;
+    }
+    observation.set_game_loop(game_loop_);
+    observation.mutable_score()->set_score(static_cast<int>(game_loop_));
+
+    SC2APIProtocol::PlayerCommon* player_common = observation.mutable_player_common();
+    player_common->set_player_id(1);
+    player_common->set_minerals(50 + game_loop_);
+    player_common->set_food_cap(200);
+    player_common->set_food_used(food_used);
+    player_common->set_food_army(food_used);
+    player_common->set_army_count(food_used);
+
+    // The client's army circles the lower-left quarter of the map and the enemy's the upper-right one.
+    SC2APIProtocol::ObservationRaw* raw = observation.mutable_raw_data();
+    const float map_size = static_cast<float>(settings_.map_size);
+    const float low_corner = kStructureSpacing;
+    const float high_corner = map_size - kStructureSpacing;
+    const float turn = static_cast<float>(game_loop_) * 0.0174533f;
+    AddSideUnits(*raw, settings_.self_units, kSelfTagBase, SC2APIProtocol::Alliance::Self, 1, map_size,
+                 map_size * 0.25f, low_corner, 1.0f, turn);
+    AddSideUnits(*raw, settings_.enemy_units, kEnemyTagBase, SC2APIProtocol::Alliance::Enemy, 2, map_size,
+                 map_size * 0.75f, high_corner, -1.0f, -turn);
+
+    // Resources sit in rows beyond each side's structures.
+    uint64_t neutral_tag = kNeutralTagBase;
+    int neutral_index = 0;
+    for (const MockUnitGroup& group : settings_.neutral_units) {
+        for (int i = 0; i < group.count; ++i, ++neutral_tag, ++neutral_index) {
+            const bool is_low = neutral_index % 2 == 0;
+            const float direction = is_low ? 1.0f : -1.0f;
+            float x = 0.0f;
+            float y = 0.0f;
+            GetGridPosition(neutral_index / 2, (is_low ? low_corner : high_corner) + direction * kResourceOffset,
+                            direction, kResourceSpacing, x, y);
+            SC2APIProtocol::Unit* unit = AddUnit(*raw, neutral_tag, group.unit_type,
+                                                 SC2APIProtocol::Alliance::Neutral, 16, x, y, 0.0f);
+            unit->set_mineral_contents(group.mineral_contents);
+            unit->set_vespene_contents(group.vespene_contents);
+        }
+    }
+
+    raw->mutable_player()->mutable_camera()->set_x(map_size * 0.5f);
+    raw->mutable_player()->mutable_camera()->set_y(map_size * 0.5f);
+
+    SC2APIProtocol::MapState* map_state = raw->mutable_map_state();
+    FillImage(map_state->mutable_visibility(), settings_.map_size, settings_.map_size, 8, 2);
+    FillImage(map_state->mutable_creep(), settings_.map_size, settings_.map_size, 1, 0);
+
+    if (settings_.feature_layer_resolution > 0) {
+        const int size = settings_.feature_layer_resolution;
+        SC2APIProtocol::FeatureLayers* renders = observation.mutable_feature_layer_data()->mutable_renders();
+        FillImage(renders->mutable_height_map(), size, size, 8, 128);
+        FillImage(renders->mutable_visibility_map(), size, size, 8, 2);
+        FillImage(renders->mutable_creep(), size, size, 1, 0);
+        FillImage(renders->mutable_player_relative(), size, size, 8, 0);
+        FillImage(renders->mutable_unit_type(), size, size, 32, 0);
+        FillImage(renders->mutable_selected(), size, size, 1, 0);
+        FillImage(renders->mutable_unit_hit_points(), size, size, 32, 0);
+    }
+    if (settings_.minimap_resolution > 0) {
+        const int size = settings_.minimap_resolution;
+        SC2APIProtocol::FeatureLayersMinimap* minimap =
+            observation.mutable_feature_layer_data()->mutable_minimap_renders();
+        FillImage(minimap->mutable_height_map(), size, size, 8, 128);
+        FillImage(minimap->mutable_visibility_map(), size, size, 8, 2);
+        FillImage(minimap->mutable_creep(), size, size, 1, 0);
+        FillImage(minimap->mutable_camera(), size, size, 1, 0);
+        FillImage(minimap->mutable_player_relative(), size, size, 8, 0);
+    }
+}
+
+void MockGame::FillGameInfo(SC2APIProtocol::ResponseGameInfo& game_info) const {
+    const int size = settings_.map_size;
+    game_info.set_map_name("Mock");
+    game_info.mutable_options()->set_raw(true);
+    for (int player_id = 1; player_id <= 2; ++player_id) {
+        SC2APIProtocol::PlayerInfo* player_info = game_info.add_player_info();
+        player_info->set_player_id(player_id);
+        player_info->set_type(SC2APIProtocol::PlayerType::Participant);
+        player_info->set_race_requested(SC2APIProtocol::Race::Terran);
+        player_info->set_race_actual(SC2APIProtocol::Race::Terran);
+    }
+
+    SC2APIProtocol::StartRaw* start_raw = game_info.mutable_start_raw();
+    start_raw->mutable_map_size()->set_x(size);
+    start_raw->mutable_map_size()->set_y(size);
+    FillImage(start_raw->mutable_pathing_grid(), size, size, 1, 0xFF);
+    FillImage(start_raw->mutable_placement_grid(), size, size, 1, 0xFF);
+    FillImage(start_raw->mutable_terrain_height(), size, size, 8, 128);
+    start_raw->mutable_playable_area()->mutable_p0()->set_x(0);
+    start_raw->mutable_playable_area()->mutable_p0()->set_y(0);
+    start_raw->mutable_playable_area()->mutable_p1()->set_x(size);
+    start_raw->mutable_playable_area()->mutable_p1()->set_y(size);
+    SC2APIProtocol::Point2D* enemy_start = start_raw->add_start_locations();
+    enemy_start->set_x(static_cast<float>(size) * 0.75f);
+    enemy_start->set_y(static_cast<float>(size) * 0.75f);
+}
+
+void MockGame::FillData(SC2APIProtocol::ResponseData& data) const {
+    // Unit types are indexed by id, so every id up to the largest one in use gets an entry.
+    std::vector<const MockUnitGroup*> groups_by_type;
+    for (const std::vector<MockUnitGroup>* groups : {&settings_.self_units, &settings_.enemy_units,
+                                                     &settings_.neutral_units}) {
+        for (const MockUnitGroup& group : *groups) {
+            if (group.unit_type >= groups_by_type.size()) {
+                groups_by_type.resize(group.unit_type + 1, nullptr);
+            }
+            groups_by_type[group.unit_type] = &group;
+        }
+    }
+
+    for (uint32_t unit_type = 0; unit_type < groups_by_type.size(); ++unit_type) {
+        SC2APIProtocol::UnitTypeData* unit_type_data = data.add_units();
+        unit_type_data->set_unit_id(unit_type);
+        unit_type_data->set_name("Mock");
+        const MockUnitGroup* group = groups_by_type[unit_type];
+        unit_type_data->set_available(group != nullptr);
+        if (group == nullptr || group->is_structure) {
+            continue;
+        }
+
+        unit_type_data->set_food_required(1.0f);
+        unit_type_data->set_movement_speed(kMovementSpeed);
+        SC2APIProtocol::Weapon* weapon = unit_type_data->add_weapons();
+        weapon->set_type(SC2APIProtocol::Weapon::Ground);
+        weapon->set_damage(kWeaponDamage);
+        weapon->set_attacks(1);
+        weapon->set_range(kWeaponRange);
+        weapon->set_speed(kWeaponCooldown);
+    }
+}
+
+void MockGame::FillQuery(const SC2APIProtocol::RequestQuery& request_query,
+                         SC2APIProtocol::ResponseQuery& response_query) const {
+    SC2APIProtocol::Point2D map_center;
+    map_center.set_x(static_cast<float>(settings_.map_size) * 0.5f);
+    map_center.set_y(static_cast<float>(settings_.map_size) * 0.5f);
+    for (const SC2APIProtocol::RequestQueryPathing& pathing : request_query.pathing()) {
+        const SC2APIProtocol::Point2D& start = pathing.has_start_pos() ? pathing.start_pos() : map_center;
+        response_query.add_pathing()->set_distance(Distance(start, pathing.end_pos()));
+    }
+    for (const SC2APIProtocol::RequestQueryAvailableAbilities& abilities : request_query.abilities()) {
+        SC2APIProtocol::ResponseQueryAvailableAbilities* response_abilities = response_query.add_abilities();
+        response_abilities->set_unit_tag(abilities.unit_tag());
+        response_abilities->set_unit_type_id(kMarineUnitType);
+    }
+    for (int i = 0; i < request_query.placements_size(); ++i) {
+        response_query.add_placements()->set_result(SC2APIProtocol::ActionResult::Success);
+    }
+}
+
+MockGameServer::MockGameServer() : running_(false), request_count_(0) {
+}
+
+MockGameServer::~MockGameServer() {
+    Stop();
+}
+
+bool MockGameServer::Start(const MockGameServerSettings& server_settings, const MockGameSettings& game_settings) {
+    Stop();
+    server_settings_ = server_settings;
+    game_settings_ = game_settings;
+    request_count_ = 0;
+
+    // Fail up front rather than answering every client with errors.
+    MockGame probe_game(game_settings_);
+    if (!probe_game.Open()) {
+        return false;
+    }
+
+    // Civetweb parks a worker thread on every open websocket.
+    const std::string port = std::to_string(server_settings_.port);
+    const std::string thread_count = std::to_string(server_settings_.max_clients + 4);
+    server_.reset(new Server());
+    server_->SetConnectionHandlers([this](mg_connection* connection) { OnConnect(connection); },
+                                   [this](mg_connection* connection) { OnClose(connection); });
+    if (!server_->Listen(port.c_str(), "100000", "100000", thread_count.c_str())) {
+        server_.reset();
+        return false;
+    }
+
+    running_ = true;
+    const int dispatch_threads = server_settings_.dispatch_threads > 0 ? server_settings_.dispatch_threads : 1;
+    for (int i = 0; i < dispatch_threads; ++i) {
+        dispatchers_.emplace_back(&MockGameServer::DispatchLoop, this, server_settings_.seed + i);
+    }
+    return true;
+}
+
+void MockGameServer::Stop() {
+    running_ = false;
+    for (std::thread& dispatcher : dispatchers_) {
+        dispatcher.join();
+    }
+    dispatchers_.clear();
+    server_.reset();
+
+    std::lock_guard<std::shared_mutex> lock(games_mutex_);
+    games_.clear();
+}
+
+uint64_t MockGameServer::GetRequestCount() const {
+    return request_count_;
+}
+
+void MockGameServer::OnConnect(mg_connection* connection) {
+    std::shared_ptr<MockGame> game = std::make_shared<MockGame>(game_settings_);
+    game->Open();
+
+    std::lock_guard<std::shared_mutex> lock(games_mutex_);
+    games_[connection] = std::move(game);
+}
+
+void MockGameServer::OnClose(mg_connection* connection) {
+    std::lock_guard<std::shared_mutex> lock(games_mutex_);
+    games_.erase(connection);
+}
+
+bool MockGameServer::TryPopRequest(RequestData& request, std::shared_ptr<MockGame>& game) {
+    // Taking the request and finding its game under one lock keeps a close and a reconnect on the same connection
+    // from landing in between, which would answer the old client's request from the new client's game.
+    std::shared_lock<std::shared_mutex> lock(games_mutex_);
+    if (!server_->PopRequest(request, 0)) {
+        return false;
+    }
+
+    const auto found = games_.find(request.first);
+    game = found != games_.end() ? found->second : nullptr;
+    return true;
+}
+
+void MockGameServer::SendIfOpen(mg_connection* connection, const std::shared_ptr<MockGame>& game,
+                                const std::string& bytes) {
+    std::shared_lock<std::shared_mutex> lock(games_mutex_);
+    const auto found = games_.find(connection);
+    if (found != games_.end() && found->second == game) {
+        server_->SendBytes(connection, bytes);
+    }
+}
+
+void MockGameServer::DispatchLoop(uint32_t seed) {
+    typedef std::chrono::steady_clock Clock;
+    struct DelayedResponse {
+        Clock::time_point due;
+        mg_connection* connection;
+        std::shared_ptr<MockGame> game;
+        std::string bytes;
+
+        bool operator>(const DelayedResponse& other) const {
+            return due > other.due;
+        }
+    };
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<unsigned int> jitter(0, server_settings_.jitter_us);
+    const bool delay_responses = server_settings_.latency_us > 0 || server_settings_.jitter_us > 0;
+    std::priority_queue<DelayedResponse, std::vector<DelayedResponse>, std::greater<DelayedResponse>> delayed;
+    SC2APIProtocol::Response response;
+    std::string bytes;
+
+    while (running_) {
+        Clock::time_point now = Clock::now();
+        while (!delayed.empty() && delayed.top().due <= now) {
+            SendIfOpen(delayed.top().connection, delayed.top().game, delayed.top().bytes);
+            delayed.pop();
+        }
+
+        unsigned int wait_us = kIdleWaitUs;
+        if (!delayed.empty()) {
+            const auto until_due = std::chrono::duration_cast<std::chrono::microseconds>(delayed.top().due - now);
+            wait_us = static_cast<unsigned int>(until_due.count()) + 1;
+        }
+
+        RequestData request;
+        std::shared_ptr<MockGame> game;
+        if (!server_->WaitForRequest(wait_us) || !TryPopRequest(request, game)) {
+            continue;
+        }
+        if (!game) {
+            delete request.second;
+            continue;
+        }
+
+        response.Clear();
+        game->Respond(*request.second, response);
+        // Clients drop the connection right after sending quit, so its answer cannot wait.
+        const bool is_quit = request.second->has_quit();
+        delete request.second;
+        response.SerializeToString(&bytes);
+        ++request_count_;
+
+        if (!delay_responses || is_quit) {
+            SendIfOpen(request.first, game, bytes);
+            continue;
+        }
+
+        const unsigned int delay_us = server_settings_.latency_us + jitter(random);
+        delayed.push({Clock::now() + std::chrono::microseconds(delay_us), request.first, std::move(game), bytes});
+    }
+}
+
+}  // namespace sc2
@@ -0,0 +1,142 @@
+/*! \file sc2_mock_game.h
+    \brief A stand-in for the game that answers requests with synthetic or recorded responses, and a websocket server
+    that hosts one per client for load-testing the client stack without the game.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "s2clientprotocol/sc2api.pb.h"
+#include "sc2_proto_recording.h"
+#include "sc2_server.h"
+
+namespace sc2 {
+
+//! A group of identical synthetic units. Mobile units circle their side's quarter of the map and are given a short
+//! ground weapon in the unit type data; structures stand still on a grid in their side's corner.
+struct MockUnitGroup {
+    uint32_t unit_type = 48;
+    int count = 0;
+    bool is_structure = false;
+    //! Resources left in each unit, for mineral fields and geysers.
+    int mineral_contents = 0;
+    int vespene_contents = 0;
+};
+
+struct MockGameSettings {
+    //! Marines in each synthetic observation, owned by the client and by the enemy.
+    int self_unit_count = 100;
+    int enemy_unit_count = 100;
+    //! When not empty these replace the marines above. Neutral units alternate between the two corners.
+    std::vector<MockUnitGroup> self_units;
+    std::vector<MockUnitGroup> enemy_units;
+    std::vector<MockUnitGroup> neutral_units;
+    //! Width and height of the square map reported in the game info and the map state.
+    int map_size = 176;
+    //! Resolution of the feature layers and of the minimap layers. 0 leaves them out of observations.
+    int feature_layer_resolution = 0;
+    int minimap_resolution = 0;
+    //! The game ends once stepping reaches this game loop. 0 never ends.
+    uint32_t game_loop_limit = 0;
+    //! When set, every request is answered from this recording instead, see ProtoPlayback.
+    std::string recording_path;
+};
+
+//! The game state one client sees. Synthetic units walk in circles so each observation differs from the last.
+//! Queries answer straight-line distances and successful placements, and every action succeeds. Data requests answer
+//! unit type data for the synthetic unit types.
+class MockGame {
+public:
+    explicit MockGame(const MockGameSettings& settings);
+
+    //! Opens the recording if one is configured.
+    //!< \return False if the recording could not be opened.
+    bool Open();
+
+    //! Fills a response for a request.
+    //!< \param request The request to answer.
+    //!< \param response A cleared response to fill.
+    void Respond(const SC2APIProtocol::Request& request, SC2APIProtocol::Response& response);
+
+    //!< \return The current game loop of the synthetic game.
+    uint32_t GetGameLoop() const;
+
+private:
+    void FillObservation(SC2APIProtocol::Observation& observation) const;
+    void FillGameInfo(SC2APIProtocol::ResponseGameInfo& game_info) const;
+    void FillData(SC2APIProtocol::ResponseData& data) const;
+    void FillQuery(const SC2APIProtocol::RequestQuery& request_query,
+                   SC2APIProtocol::ResponseQuery& response_query) const;
+
+    MockGameSettings settings_;
+    std::unique_ptr<ProtoPlayback> playback_;
+    SC2APIProtocol::Status status_;
+    uint32_t game_loop_;
+};
+
+struct MockGameServerSettings {
+    //! Port to accept websocket clients on, at /sc2api like the game.
+    int port = 5679;
+    //! Clients that can be connected at once. Each holds a civetweb worker thread.
+    int max_clients = 64;
+    //! Threads that build and send responses.
+    int dispatch_threads = 1;
+    //! Each response is held back for latency_us plus a uniform draw from [0, jitter_us].
+    unsigned int latency_us = 0;
+    unsigned int jitter_us = 0;
+    uint32_t seed = 1;
+};
+
+//! Serves a MockGame to each connected client through sc2::Server. A client's game is created when it connects and
+//! destroyed when it disconnects, and responses still held back for a closed connection are dropped.
+class MockGameServer {
+public:
+    MockGameServer();
+    ~MockGameServer();
+
+    MockGameServer(const MockGameServer&) = delete;
+    MockGameServer& operator=(const MockGameServer&) = delete;
+
+    //! Starts listening and dispatching, stopping a running server first.
+    //!< \return False if the port could not be opened or the recording could not be read.
+    bool Start(const MockGameServerSettings& server_settings, const MockGameSettings& game_settings);
+
+    //! Stops dispatching and closes the listening socket. Safe to call when the server is not running.
+    void Stop();
+
+    //!< \return The number of requests answered since Start.
+    uint64_t GetRequestCount() const;
+
+private:
+    void DispatchLoop(uint32_t seed);
+    void OnConnect(mg_connection* connection);
+    void OnClose(mg_connection* connection);
+    //! Takes the next request together with the game of its connection, if that connection is still open.
+    bool TryPopRequest(RequestData& request, std::shared_ptr<MockGame>& game);
+    //! Sends the response unless the game's connection has closed since the request arrived.
+    void SendIfOpen(mg_connection* connection, const std::shared_ptr<MockGame>& game, const std::string& bytes);
+
+    MockGameServerSettings server_settings_;
+    MockGameSettings game_settings_;
+    std::unique_ptr<Server> server_;
+    std::vector<std::thread> dispatchers_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> request_count_;
+
+    // A client's requests arrive one at a time, so only the lookup is shared between dispatchers. Dispatchers hold
+    // the lock shared while they take a request or write to a connection; connects and closes hold it exclusively,
+    // so no write reaches a connection after its close handler returns and civetweb reuses it.
+    std::shared_mutex games_mutex_;
+    std::unordered_map<mg_connection*, std::shared_ptr<MockGame>> games_;
+};
+
+}  // namespace sc2
@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <utility>
 
 #include "sc2_control_interfaces.h"
 
@@ -92,7 +93,9 @@ ProtoInterface::ProtoInterface()
       port_(5000),
       default_timeout_ms_(kDefaultProtoInterfaceTimeout),
       latest_status_(SC2APIProtocol::Status::unknown),
-      response_pending_(SC2APIProtocol::Response::RESPONSE_NOT_SET) {
+      response_pending_(SC2APIProtocol::Response::RESPONSE_NOT_SET),
+      defer_pending_response_(false),
+      has_deferred_response_(false) {
 }
 
 bool ProtoInterface::ConnectToGame(const std::string& address, int port, int timeout_ms) {
@@ -100,6 +103,10 @@ bool ProtoInterface::ConnectToGame(const std::string& address, int port, int tim
     address_ = address;
     port_ = port;
     default_timeout_ms_ = timeout_ms;
+    if (playback_) {
+        return PingGame();
+    }
+
     if (!connection_.Connect(address, port, false)) {
         return false;
     }
@@ -125,17 +132,23 @@ bool ProtoInterface::SendRequest(GameRequestPtr& request, bool ignore_pending_re
     ++count_uses_[request_type];
 
     // If there is no connection, try rebuilding the connection.
-    if (!connection_.HasConnection()) {
+    if (!playback_ && !connection_.HasConnection()) {
         if (!connection_.Connect(address_, port_, false)) {
             return false;
         }
     }
 
     // If there is still no connection, give up.
-    if (!connection_.HasConnection()) {
+    if (!playback_ && !connection_.HasConnection()) {
         return false;
     }
 
+    // A deferred response is collected now and held for its owner, so the new request keeps the sequence intact.
+    if (!ignore_pending_requests && HasResponsePending() && defer_pending_response_) {
+        deferred_response_ = control_->WaitForResponse();
+        has_deferred_response_ = true;
+    }
+
     // Technically there can be new requests while responses are pending, but this library is not written for that.
     // For now, make everything purely sequential.
     if (!ignore_pending_requests && HasResponsePending()) {
@@ -143,7 +156,12 @@ bool ProtoInterface::SendRequest(GameRequestPtr& request, bool ignore_pending_re
         return false;
     }
 
-    connection_.Send(request.get());
+    if (playback_ || recorder_) {
+        pending_request_ = request;
+    }
+    if (!playback_) {
+        connection_.Send(request.get());
+    }
 
     // Expect a certain response.
     response_pending_ = SC2APIProtocol::Response::ResponseCase(request->request_case());
@@ -153,11 +171,21 @@ bool ProtoInterface::SendRequest(GameRequestPtr& request, bool ignore_pending_re
 GameResponsePtr ProtoInterface::WaitForResponseInternal() {
     latest_status_ = SC2APIProtocol::Status::unknown;
     SC2APIProtocol::Response* response = nullptr;
-    if (!connection_.Receive(response, default_timeout_ms_)) {
+    if (playback_) {
+        response = connection_.AcquireResponse();
+        if (pending_request_) {
+            playback_->Respond(*pending_request_, *response);
+        }
+    } else if (!connection_.Receive(response, default_timeout_ms_)) {
         // If the receive fails, it means a timeout has occurred.
         return nullptr;
     }
 
+    if (recorder_ && response) {
+        recorder_->Write(pending_request_.get(), *response);
+    }
+    pending_request_.reset();
+
     for (int i = 0; error_callback_ && response && i < response->error_size(); ++i) {
         error_callback_(response->error(i));
     }
@@ -183,7 +211,8 @@ GameResponsePtr ProtoInterface::WaitForResponseInternal() {
 
     // No longer expecting a specific response.
     response_pending_ = SC2APIProtocol::Response::RESPONSE_NOT_SET;
-    return GameResponsePtr(response);
+    defer_pending_response_ = false;
+    return connection_.AdoptResponse(response);
 }
 
 bool ProtoInterface::PingGame() {
@@ -223,9 +252,61 @@ void ProtoInterface::SetErrorCallback(std::function<void(const std::string& erro
 }
 
 bool ProtoInterface::PollResponse() {
+    if (playback_) {
+        // Playback answers as soon as the response is waited for.
+        return HasResponsePending();
+    }
+
     return connection_.PollResponse();
 }
 
+bool ProtoInterface::StartRecording(const std::string& path) {
+    std::unique_ptr<ProtoRecordingWriter> recorder(new ProtoRecordingWriter());
+    if (!recorder->Open(path)) {
+        return false;
+    }
+
+    recorder_ = std::move(recorder);
+    return true;
+}
+
+void ProtoInterface::StopRecording() {
+    recorder_.reset();
+}
+
+bool ProtoInterface::IsRecording() const {
+    return recorder_ != nullptr;
+}
+
+bool ProtoInterface::StartPlayback(const std::string& path) {
+    std::unique_ptr<ProtoPlayback> playback(new ProtoPlayback());
+    if (!playback->Open(path)) {
+        return false;
+    }
+
+    playback_ = std::move(playback);
+    return true;
+}
+
+bool ProtoInterface::IsPlayingBack() const {
+    return playback_ != nullptr;
+}
+
+void ProtoInterface::DeferPendingResponse() {
+    defer_pending_response_ = HasResponsePending();
+}
+
+bool ProtoInterface::HasDeferredResponse() const {
+    return has_deferred_response_;
+}
+
+GameResponsePtr ProtoInterface::TakeDeferredResponse() {
+    has_deferred_response_ = false;
+    GameResponsePtr response = std::move(deferred_response_);
+    deferred_response_ = nullptr;
+    return response;
+}
+
 bool ProtoInterface::HasResponsePending() const {
     return response_pending_ != SC2APIProtocol::Response::ResponseCase::RESPONSE_NOT_SET;
 }
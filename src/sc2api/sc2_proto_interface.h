@@ -4,6 +4,7 @@
 
 #include "s2clientprotocol/sc2api.pb.h"
 #include "sc2_connection.h"
+#include "sc2_proto_recording.h"
 
 namespace sc2 {
 
@@ -95,6 +96,12 @@ public:
         return latest_status_;
     }
     bool HasResponsePending() const;
+    //! Allows the pending request's response to be collected late. If another request is sent while it is still
+    //! pending, the response is received first and held until TakeDeferredResponse is called. Used to keep a step in
+    //! flight while the agent runs OnStep.
+    void DeferPendingResponse();
+    bool HasDeferredResponse() const;
+    GameResponsePtr TakeDeferredResponse();
     SC2APIProtocol::Response::ResponseCase GetResponsePending() const {
         return response_pending_;
     }
@@ -116,6 +123,26 @@ public:
         return data_version_;
     }
 
+    //! Writes every response received from now on to a recording that StartPlayback can replay.
+    //!< \param path The file to record to.
+    //!< \return False if the file could not be opened.
+    bool StartRecording(const std::string& path);
+    void StopRecording();
+    bool IsRecording() const;
+
+    //! Answers every request from a recording instead of a game, so no game process or connection is needed.
+    //! ConnectToGame only replays the recorded ping. Call before connecting.
+    //!< \param path A file written by StartRecording.
+    //!< \return False if the recording could not be opened.
+    bool StartPlayback(const std::string& path);
+    bool IsPlayingBack() const;
+    const ProtoPlayback* GetPlayback() const {
+        return playback_.get();
+    }
+    ProtoPlayback* GetPlayback() {
+        return playback_.get();
+    }
+
 protected:
     Connection connection_;
     std::string address_;
@@ -124,11 +151,19 @@ protected:
     std::function<void(const std::string& error_str)> error_callback_;
     SC2APIProtocol::Status latest_status_;
     SC2APIProtocol::Response::ResponseCase response_pending_;
+    bool defer_pending_response_;
+    bool has_deferred_response_;
+    GameResponsePtr deferred_response_;
     std::vector<uint32_t> count_uses_;
     ControlInterface* control_;
 
     uint32_t base_build_;
     std::string data_version_;
+
+    // The request awaiting its response, kept while recording or playing back.
+    GameRequestPtr pending_request_;
+    std::unique_ptr<ProtoRecordingWriter> recorder_;
+    std::unique_ptr<ProtoPlayback> playback_;
 };
 
 // Helper to produce a string for the proto type.
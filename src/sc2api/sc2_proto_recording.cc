@@ -0,0 +1,443 @@
+#include "sc2_proto_recording.h"
+
+#include <cstring>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sc2 {
+
+namespace {
+
+const char kRecordingMagic[8] = {'S', 'C', '2', 'R', 'E', 'C', '0', '1'};
+const size_t kFingerprintSize = 8;
+const size_t kMaxVarintSize = 10;
+// Bounds the per-type index; response types are numbered well below this.
+const uint64_t kMaxResponseCase = 64;
+
+uint64_t HashBytes(const std::string& bytes) {
+    // 64 bit FNV-1a.
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char byte : bytes) {
+        hash ^= static_cast<uint8_t>(byte);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void AppendVarint(std::string& buffer, uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+bool ReadVarint(const uint8_t* data, size_t size, size_t& offset, uint64_t& value) {
+    value = 0;
+    for (size_t shift = 0; shift < kMaxVarintSize * 7 && offset < size; shift += 7) {
+        const uint8_t byte = data[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+uint64_t FingerprintQueryRequest(const SC2APIProtocol::Request& request) {
+    if (!request.has_query()) {
+        return 0;
+    }
+
+    std::string bytes;
+    request.query().SerializeToString(&bytes);
+    const uint64_t hash = HashBytes(bytes);
+    // 0 is reserved for records without a query.
+    return hash != 0 ? hash : 1;
+}
+
+bool ProtoRecordingWriter::Open(const std::string& path) {
+    Close();
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    file_.write(kRecordingMagic, sizeof(kRecordingMagic));
+    record_count_ = 0;
+    return file_.good();
+}
+
+void ProtoRecordingWriter::Close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+bool ProtoRecordingWriter::IsOpen() const {
+    return file_.is_open();
+}
+
+bool ProtoRecordingWriter::Write(const SC2APIProtocol::Request* request, const SC2APIProtocol::Response& response) {
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    const uint64_t fingerprint = request ? FingerprintQueryRequest(*request) : 0;
+    const size_t payload_size = response.ByteSizeLong();
+
+    // The buffer is reused across records so recording a game does not allocate per response once it has grown.
+    buffer_.clear();
+    AppendVarint(buffer_, payload_size);
+    AppendVarint(buffer_, static_cast<uint64_t>(response.response_case()));
+    for (size_t byte_index = 0; byte_index < kFingerprintSize; ++byte_index) {
+        buffer_.push_back(static_cast<char>((fingerprint >> (byte_index * 8)) & 0xFF));
+    }
+    const size_t header_size = buffer_.size();
+    buffer_.resize(header_size + payload_size);
+    if (payload_size > 0 &&
+        !response.SerializeToArray(&buffer_[header_size], static_cast<int>(payload_size))) {
+        return false;
+    }
+
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    ++record_count_;
+    return file_.good();
+}
+
+size_t ProtoRecordingWriter::GetRecordCount() const {
+    return record_count_;
+}
+
+//! A read-only view of a whole file.
+class ProtoPlayback::MappedFile {
+public:
+    ~MappedFile() {
+        Unmap();
+    }
+
+    bool Map(const std::string& path) {
+#if defined(_WIN32)
+        file_handle_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_handle_ == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_handle_, &file_size) || file_size.QuadPart == 0) {
+            return false;
+        }
+
+        mapping_handle_ = CreateFileMappingA(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_handle_) {
+            return false;
+        }
+
+        data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+        size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+        file_descriptor_ = open(path.c_str(), O_RDONLY);
+        if (file_descriptor_ < 0) {
+            return false;
+        }
+
+        struct stat file_stat;
+        if (fstat(file_descriptor_, &file_stat) != 0 || file_stat.st_size == 0) {
+            return false;
+        }
+
+        void* mapping = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE,
+                             file_descriptor_, 0);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+
+        data_ = static_cast<const uint8_t*>(mapping);
+        size_ = static_cast<size_t>(file_stat.st_size);
+#endif
+        return data_ != nullptr;
+    }
+
+    void Unmap() {
+#if defined(_WIN32)
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_handle_) {
+            CloseHandle(mapping_handle_);
+        }
+        if (file_handle_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_handle_);
+        }
+        mapping_handle_ = nullptr;
+        file_handle_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_) {
+            munmap(const_cast<uint8_t*>(data_), size_);
+        }
+        if (file_descriptor_ >= 0) {
+            close(file_descriptor_);
+        }
+        file_descriptor_ = -1;
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const uint8_t* Data() const {
+        return data_;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    HANDLE file_handle_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_handle_ = nullptr;
+#else
+    int file_descriptor_ = -1;
+#endif
+};
+
+ProtoPlayback::ProtoPlayback() : served_observation_count_(0), matched_query_count_(0), deferred_query_count_(0) {
+}
+
+ProtoPlayback::~ProtoPlayback() {
+    Close();
+}
+
+bool ProtoPlayback::Open(const std::string& path) {
+    Close();
+
+    std::unique_ptr<MappedFile> file(new MappedFile());
+    if (!file->Map(path) || file->Size() < sizeof(kRecordingMagic) ||
+        std::memcmp(file->Data(), kRecordingMagic, sizeof(kRecordingMagic)) != 0) {
+        return false;
+    }
+
+    // Index every record up front. Parsing waits until a record is served.
+    const uint8_t* data = file->Data();
+    const size_t size = file->Size();
+    std::vector<Record> records;
+    std::vector<std::vector<size_t>> records_by_case;
+    size_t offset = sizeof(kRecordingMagic);
+    while (offset < size) {
+        uint64_t payload_size = 0;
+        uint64_t response_case = 0;
+        if (!ReadVarint(data, size, offset, payload_size) || !ReadVarint(data, size, offset, response_case) ||
+            response_case > kMaxResponseCase || size - offset < kFingerprintSize ||
+            size - offset - kFingerprintSize < payload_size) {
+            return false;
+        }
+
+        Record record;
+        record.response_case = static_cast<int>(response_case);
+        record.fingerprint = 0;
+        for (size_t byte_index = 0; byte_index < kFingerprintSize; ++byte_index) {
+            record.fingerprint |= static_cast<uint64_t>(data[offset + byte_index]) << (byte_index * 8);
+        }
+        offset += kFingerprintSize;
+        record.offset = offset;
+        record.size = static_cast<size_t>(payload_size);
+        offset += record.size;
+
+        if (static_cast<size_t>(record.response_case) >= records_by_case.size()) {
+            records_by_case.resize(record.response_case + 1);
+        }
+        records_by_case[record.response_case].push_back(records.size());
+        records.push_back(record);
+    }
+
+    file_ = std::move(file);
+    records_ = std::move(records);
+    records_by_case_ = std::move(records_by_case);
+    record_used_.assign(records_.size(), 0);
+    next_by_case_.assign(records_by_case_.size(), 0);
+    return true;
+}
+
+void ProtoPlayback::Close() {
+    file_.reset();
+    records_.clear();
+    record_used_.clear();
+    records_by_case_.clear();
+    next_by_case_.clear();
+    served_observation_count_ = 0;
+    matched_query_count_ = 0;
+    deferred_query_count_ = 0;
+}
+
+bool ProtoPlayback::IsOpen() const {
+    return file_ != nullptr;
+}
+
+size_t ProtoPlayback::GetRecordCount() const {
+    return records_.size();
+}
+
+size_t ProtoPlayback::GetObservationCount() const {
+    const size_t observation_case = SC2APIProtocol::Response::kObservation;
+    return observation_case < records_by_case_.size() ? records_by_case_[observation_case].size() : 0;
+}
+
+size_t ProtoPlayback::GetServedObservationCount() const {
+    return served_observation_count_;
+}
+
+size_t ProtoPlayback::GetMatchedQueryCount() const {
+    return matched_query_count_;
+}
+
+void ProtoPlayback::SetQueryResponder(
+    std::function<void(const SC2APIProtocol::Request&, SC2APIProtocol::Response&)> responder) {
+    query_responder_ = std::move(responder);
+}
+
+size_t ProtoPlayback::GetDeferredQueryCount() const {
+    return deferred_query_count_;
+}
+
+bool ProtoPlayback::ParseRecord(size_t record_index, SC2APIProtocol::Response& response) const {
+    const Record& record = records_[record_index];
+    return response.ParseFromArray(file_->Data() + record.offset, static_cast<int>(record.size));
+}
+
+SC2APIProtocol::Status ProtoPlayback::GetPlaybackStatus() const {
+    return served_observation_count_ < GetObservationCount() ? SC2APIProtocol::Status::in_game
+                                                             : SC2APIProtocol::Status::ended;
+}
+
+bool ProtoPlayback::TryRespondToQuery(const SC2APIProtocol::Request& request, SC2APIProtocol::Response& response) {
+    // Queries recorded after the last served observation and before the next one belong to the current frame.
+    const size_t observation_count = GetObservationCount();
+    const std::vector<size_t>* observations =
+        observation_count > 0 ? &records_by_case_[SC2APIProtocol::Response::kObservation] : nullptr;
+    const size_t frame_begin =
+        served_observation_count_ > 0 ? (*observations)[served_observation_count_ - 1] + 1 : 0;
+    const size_t frame_end =
+        served_observation_count_ < observation_count ? (*observations)[served_observation_count_] : records_.size();
+
+    // Only a query asking the same thing may take a recorded answer; any other answer would be for different points.
+    const uint64_t fingerprint = FingerprintQueryRequest(request);
+    size_t matched_index = frame_end;
+    for (size_t record_index = frame_begin; record_index < frame_end; ++record_index) {
+        const Record& record = records_[record_index];
+        if (record.response_case == SC2APIProtocol::Response::kQuery && !record_used_[record_index] &&
+            record.fingerprint == fingerprint) {
+            matched_index = record_index;
+            break;
+        }
+    }
+
+    if (matched_index == frame_end || !ParseRecord(matched_index, response)) {
+        return false;
+    }
+
+    record_used_[matched_index] = 1;
+    ++matched_query_count_;
+    return true;
+}
+
+void ProtoPlayback::Respond(const SC2APIProtocol::Request& request, SC2APIProtocol::Response& response) {
+    const int request_case = static_cast<int>(request.request_case());
+    switch (request.request_case()) {
+        case SC2APIProtocol::Request::kStep: {
+            response.mutable_step();
+            response.set_status(GetPlaybackStatus());
+            return;
+        }
+        case SC2APIProtocol::Request::kAction: {
+            SC2APIProtocol::ResponseAction* response_action = response.mutable_action();
+            for (int i = 0; i < request.action().actions_size(); ++i) {
+                response_action->add_result(SC2APIProtocol::ActionResult::Success);
+            }
+            response.set_status(GetPlaybackStatus());
+            return;
+        }
+        case SC2APIProtocol::Request::kDebug: {
+            response.mutable_debug();
+            response.set_status(GetPlaybackStatus());
+            return;
+        }
+        case SC2APIProtocol::Request::kQuery: {
+            if (TryRespondToQuery(request, response)) {
+                return;
+            }
+            if (query_responder_) {
+                query_responder_(request, response);
+                response.set_status(GetPlaybackStatus());
+                ++deferred_query_count_;
+                return;
+            }
+
+            // Keep the sizes the client expects so every sub-query reads as failed rather than missing.
+            const SC2APIProtocol::RequestQuery& request_query = request.query();
+            SC2APIProtocol::ResponseQuery* response_query = response.mutable_query();
+            for (int i = 0; i < request_query.pathing_size(); ++i) {
+                response_query->add_pathing()->set_distance(0.0f);
+            }
+            for (int i = 0; i < request_query.abilities_size(); ++i) {
+                response_query->add_abilities()->set_unit_tag(request_query.abilities(i).unit_tag());
+            }
+            for (int i = 0; i < request_query.placements_size(); ++i) {
+                response_query->add_placements()->set_result(SC2APIProtocol::ActionResult::Error);
+            }
+            response.set_status(GetPlaybackStatus());
+            return;
+        }
+        case SC2APIProtocol::Request::kObservation: {
+            const size_t observation_count = GetObservationCount();
+            if (served_observation_count_ < observation_count &&
+                ParseRecord(records_by_case_[request_case][served_observation_count_], response)) {
+                ++served_observation_count_;
+                return;
+            }
+
+            // Past the end of the recording the final frame stands, and the game is over.
+            if (observation_count > 0) {
+                ParseRecord(records_by_case_[request_case].back(), response);
+            } else {
+                response.mutable_observation();
+            }
+            response.set_status(SC2APIProtocol::Status::ended);
+            return;
+        }
+        default:
+            break;
+    }
+
+    if (static_cast<size_t>(request_case) < records_by_case_.size() && !records_by_case_[request_case].empty()) {
+        const std::vector<size_t>& case_records = records_by_case_[request_case];
+        size_t& next = next_by_case_[request_case];
+        if (ParseRecord(case_records[next < case_records.size() ? next : case_records.size() - 1], response)) {
+            ++next;
+            return;
+        }
+        response.Clear();
+    }
+
+    // Nothing recorded for this request: answer with an empty response of the matching type. Response types are
+    // numbered by their field, so an empty length-delimited field of that number selects the type.
+    std::string empty_field;
+    AppendVarint(empty_field, (static_cast<uint64_t>(request_case) << 3) | 2);
+    empty_field.push_back(0);
+    response.ParseFromString(empty_field);
+    response.set_status(GetPlaybackStatus());
+}
+
+}  // namespace sc2
@@ -0,0 +1,133 @@
+/*! \file sc2_proto_recording.h
+    \brief Recording of the responses a game sends a client, and playback of a recording without the game.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "s2clientprotocol/sc2api.pb.h"
+
+namespace sc2 {
+
+//! Fingerprint of a query request, used to pair the queries a client sends during playback with recorded ones.
+//!< \param request The request to fingerprint.
+//!< \return A hash of the serialized query, or 0 for any other request.
+uint64_t FingerprintQueryRequest(const SC2APIProtocol::Request& request);
+
+//! Appends every response a client receives to a file. The file starts with a magic header followed by one record
+//! per response: the payload size and the response type as varints, the fingerprint of the request as 8
+//! little-endian bytes, then the serialized Response. Only queries carry a fingerprint.
+class ProtoRecordingWriter {
+public:
+    //! Creates or truncates the recording and writes its header.
+    //!< \param path The file to record to.
+    //!< \return False if the file could not be opened.
+    bool Open(const std::string& path);
+
+    //! Flushes and closes the recording.
+    void Close();
+
+    //!< \return True while a recording is open.
+    bool IsOpen() const;
+
+    //! Appends one response.
+    //!< \param request The request the response answers, may be null.
+    //!< \param response The response to record.
+    //!< \return False if the write failed.
+    bool Write(const SC2APIProtocol::Request* request, const SC2APIProtocol::Response& response);
+
+    //!< \return The number of responses written since Open.
+    size_t GetRecordCount() const;
+
+private:
+    std::ofstream file_;
+    std::string buffer_;
+    size_t record_count_ = 0;
+};
+
+//! Answers requests from a recording made by ProtoRecordingWriter. The recording is memory-mapped and indexed on
+//! Open; responses are parsed on demand.
+//!
+//! Observations are served in recorded order and mark frame boundaries. Queries are answered from the current frame
+//! by the unused recorded query with the same fingerprint, and otherwise by the query responder when one is set or a
+//! response of the right size holding failed results. Steps, actions and debug draws are answered without the recording, so a
+//! client that issues different commands than the recorded one still sees the recorded game. Every other request
+//! gets the next recorded response of its type, repeating the last one once they run out. After the last
+//! observation has been served the game reports that it has ended.
+class ProtoPlayback {
+public:
+    ProtoPlayback();
+    ~ProtoPlayback();
+
+    ProtoPlayback(const ProtoPlayback&) = delete;
+    ProtoPlayback& operator=(const ProtoPlayback&) = delete;
+
+    //! Maps and indexes a recording, closing any open one.
+    //!< \param path The recording to play back.
+    //!< \return False if the file is missing, is not a recording, or is truncated.
+    bool Open(const std::string& path);
+
+    //! Unmaps the recording.
+    void Close();
+
+    //!< \return True while a recording is open.
+    bool IsOpen() const;
+
+    //! Fills a response for a request.
+    //!< \param request The request to answer.
+    //!< \param response A cleared response to fill.
+    void Respond(const SC2APIProtocol::Request& request, SC2APIProtocol::Response& response);
+
+    //!< \return The number of responses in the recording.
+    size_t GetRecordCount() const;
+
+    //!< \return The number of observations in the recording.
+    size_t GetObservationCount() const;
+
+    //!< \return The number of recorded observations served so far.
+    size_t GetServedObservationCount() const;
+
+    //!< \return The number of queries answered from the recording rather than synthesized.
+    size_t GetMatchedQueryCount() const;
+
+    //! Sets what answers the queries that match no recorded query, such as a MockGame, in place of failed results.
+    //!< \param responder Fills a cleared response for a query request. An empty function restores failed results.
+    void SetQueryResponder(std::function<void(const SC2APIProtocol::Request&, SC2APIProtocol::Response&)> responder);
+
+    //!< \return The number of queries answered by the query responder.
+    size_t GetDeferredQueryCount() const;
+
+private:
+    class MappedFile;
+
+    struct Record {
+        int response_case;
+        uint64_t fingerprint;
+        size_t offset;
+        size_t size;
+    };
+
+    bool ParseRecord(size_t record_index, SC2APIProtocol::Response& response) const;
+    bool TryRespondToQuery(const SC2APIProtocol::Request& request, SC2APIProtocol::Response& response);
+    SC2APIProtocol::Status GetPlaybackStatus() const;
+
+    std::unique_ptr<MappedFile> file_;
+    std::vector<Record> records_;
+    std::vector<uint8_t> record_used_;
+    // Record indices of each response type, and the next one to serve.
+    std::vector<std::vector<size_t>> records_by_case_;
+    std::vector<size_t> next_by_case_;
+    size_t served_observation_count_;
+    size_t matched_query_count_;
+    size_t deferred_query_count_;
+    std::function<void(const SC2APIProtocol::Request&, SC2APIProtocol::Response&)> query_responder_;
+};
+
+}  // namespace sc2
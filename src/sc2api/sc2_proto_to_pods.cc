@@ -321,6 +321,8 @@ bool Convert(const ObservationRawPtr& observation_raw, UnitPool& unit_pool, uint
         unit->shield_upgrade_level = observation_unit.shield_upgrade_level();
 
         unit->is_building = IsBuilding()(unit->unit_type);
+
+        unit_pool.CommitExistingUnit(*unit);
     }
 
     return true;
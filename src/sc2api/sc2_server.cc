@@ -1,5 +1,6 @@
 #include "sc2_server.h"
 
+#include <chrono>
 #include <cstring>
 #include <iostream>
 
@@ -32,6 +33,9 @@ static int WebSocketConnectHandler(const mg_connection* conn, void* websocket_se
     }
 
     server->connections_.push_back(conn);
+    if (server->on_connect_) {
+        server->on_connect_((mg_connection*)conn);
+    }
 
     return 0;
 }
@@ -71,6 +75,12 @@ static void WebSocketCloseHandler(const mg_connection* conn, void* websocket_ser
             break;
         }
     }
+
+    // Nothing can answer these any more, and civetweb may hand the connection to the next client.
+    server->DropRequests(conn);
+    if (server->on_close_) {
+        server->on_close_((mg_connection*)conn);
+    }
 }
 
 template <class T>
@@ -124,10 +134,17 @@ bool Server::Listen(const char* listeningPorts, const char* requestTimeoutMs, co
     return true;
 }
 
+void Server::SetConnectionHandlers(std::function<void(mg_connection*)> on_connect,
+                                   std::function<void(mg_connection*)> on_close) {
+    on_connect_ = std::move(on_connect);
+    on_close_ = std::move(on_close);
+}
+
 void Server::QueueRequest(struct mg_connection* conn, SC2APIProtocol::Request*& request) {
     request_mutex_.lock();
     requests_.push(RequestData(conn, request));
     request_mutex_.unlock();
+    request_condition_.notify_one();
 }
 
 void Server::QueueResponse(struct mg_connection* conn, SC2APIProtocol::Response*& response) {
@@ -170,4 +187,41 @@ const ResponseData& Server::PeekResponse() {
     return responses_.front();
 }
 
+bool Server::PopRequest(RequestData& request, unsigned int timeout_us) {
+    std::unique_lock<std::mutex> lock(request_mutex_);
+    if (!request_condition_.wait_for(lock, std::chrono::microseconds(timeout_us),
+                                     [this]() { return !requests_.empty(); })) {
+        return false;
+    }
+
+    request = requests_.front();
+    requests_.pop();
+    return true;
+}
+
+bool Server::WaitForRequest(unsigned int timeout_us) {
+    std::unique_lock<std::mutex> lock(request_mutex_);
+    return request_condition_.wait_for(lock, std::chrono::microseconds(timeout_us),
+                                       [this]() { return !requests_.empty(); });
+}
+
+void Server::DropRequests(const mg_connection* conn) {
+    std::lock_guard<std::mutex> lock(request_mutex_);
+    std::queue<RequestData> kept;
+    while (!requests_.empty()) {
+        RequestData& request = requests_.front();
+        if (request.first == conn) {
+            delete request.second;
+        } else {
+            kept.push(request);
+        }
+        requests_.pop();
+    }
+    requests_.swap(kept);
+}
+
+void Server::SendBytes(struct mg_connection* conn, const std::string& bytes) {
+    mg_websocket_write(conn, MG_WEBSOCKET_OPCODE_BINARY, bytes.data(), bytes.size());
+}
+
 }  // namespace sc2
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -29,6 +32,14 @@ public:
     bool Listen(const char* listeningPorts, const char* requestTimeoutMs, const char* websocketTimeoutMs,
                 const char* numThreads);
 
+    //! Sets callbacks run on civetweb threads as websocket clients connect and close. Requests still queued from a
+    //! closing connection are dropped before on_close runs, and civetweb may reuse the connection once it returns.
+    //! Set them before Listen.
+    //!< \param on_connect Called when a client connects, before its first request.
+    //!< \param on_close Called when a client's connection closes.
+    void SetConnectionHandlers(std::function<void(mg_connection*)> on_connect,
+                               std::function<void(mg_connection*)> on_close);
+
     void QueueRequest(struct mg_connection* conn, SC2APIProtocol::Request*& request);
     void QueueResponse(struct mg_connection* conn, SC2APIProtocol::Response*& response);
 
@@ -42,7 +53,29 @@ public:
     const RequestData& PeekRequest();
     const ResponseData& PeekResponse();
 
+    //! Takes the oldest queued request, waiting up to timeout_us for one to arrive. Safe to call from several threads.
+    //!< \param request Filled with the connection and the request, which the caller now owns and deletes.
+    //!< \param timeout_us How long to wait for a request.
+    //!< \return False if no request arrived in time.
+    bool PopRequest(RequestData& request, unsigned int timeout_us);
+
+    //! Waits up to timeout_us for a request to be queued, leaving it in the queue.
+    //!< \param timeout_us How long to wait for a request.
+    //!< \return False if no request arrived in time.
+    bool WaitForRequest(unsigned int timeout_us);
+
+    //! Drops and deletes every queued request from a connection.
+    //!< \param conn The connection whose requests to drop.
+    void DropRequests(const mg_connection* conn);
+
+    //! Writes an already serialized message to a connection, bypassing the response queue.
+    //!< \param conn The connection to write to.
+    //!< \param bytes The serialized message.
+    void SendBytes(struct mg_connection* conn, const std::string& bytes);
+
     std::vector<const mg_connection*> connections_;
+    std::function<void(mg_connection*)> on_connect_;
+    std::function<void(mg_connection*)> on_close_;
 
 private:
     mg_context* mg_context_ = nullptr;
@@ -52,6 +85,7 @@ private:
 
     std::mutex request_mutex_;
     std::mutex response_mutex_;
+    std::condition_variable request_condition_;
 };
 
 }  // namespace sc2
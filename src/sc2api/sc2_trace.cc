@@ -0,0 +1,425 @@
+#include "sc2_trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace sc2 {
+
+namespace {
+
+// Quarter-octave buckets: the bucket of a duration is four times its bit length plus its next two bits.
+const size_t kBucketsPerOctave = 4;
+const size_t kBucketCount = 64 * kBucketsPerOctave;
+
+size_t GetBucketIndex(uint64_t duration_ns) {
+    if (duration_ns < kBucketsPerOctave) {
+        return static_cast<size_t>(duration_ns);
+    }
+
+    size_t bit_length = 0;
+    for (uint64_t value = duration_ns; value > 0; value >>= 1) {
+        ++bit_length;
+    }
+    const size_t fraction = static_cast<size_t>((duration_ns >> (bit_length - 3)) & (kBucketsPerOctave - 1));
+    return (bit_length - 1) * kBucketsPerOctave + fraction;
+}
+
+uint64_t GetBucketUpperBound(size_t bucket_index) {
+    if (bucket_index < kBucketsPerOctave) {
+        return static_cast<uint64_t>(bucket_index);
+    }
+
+    const size_t octave = bucket_index / kBucketsPerOctave;
+    const uint64_t fraction = static_cast<uint64_t>(bucket_index % kBucketsPerOctave);
+    const uint64_t lower_bound = (uint64_t(kBucketsPerOctave) + fraction) << (octave - 2);
+    return lower_bound + (uint64_t(1) << (octave - 2)) - 1;
+}
+
+void WriteJsonString(std::ostream& output, const char* value) {
+    output << '"';
+    for (const char* character = value; *character != '\0'; ++character) {
+        const unsigned char code = static_cast<unsigned char>(*character);
+        if (code == '"' || code == '\\') {
+            output << '\\' << *character;
+        } else if (code < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", code);
+            output << escaped;
+        } else {
+            output << *character;
+        }
+    }
+    output << '"';
+}
+
+void WriteMicroseconds(std::ostream& output, uint64_t nanoseconds) {
+    char formatted[32];
+    std::snprintf(formatted, sizeof(formatted), "%llu.%03llu", static_cast<unsigned long long>(nanoseconds / 1000),
+                  static_cast<unsigned long long>(nanoseconds % 1000));
+    output << formatted;
+}
+
+}  // namespace
+
+//-------------------------------------------------------------------------------------------------
+// Tracer::ThreadBuffer: A single-producer, single-consumer ring of finished zones.
+//-------------------------------------------------------------------------------------------------
+
+class Tracer::ThreadBuffer {
+public:
+    explicit ThreadBuffer(uint32_t thread_index)
+        : thread_index_(thread_index),
+          events_(kThreadBufferCapacity),
+          head_(0),
+          tail_(0),
+          dropped_(0),
+          retired_(false) {
+    }
+
+    // Called only by the owning thread.
+    void Push(const TraceEvent& event) {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= kThreadBufferCapacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        events_[head & (kThreadBufferCapacity - 1)] = event;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // Called only by the collector.
+    template <typename Visitor>
+    void Drain(Visitor&& visitor) {
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail) {
+            visitor(events_[tail & (kThreadBufferCapacity - 1)]);
+        }
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    uint64_t TakeDroppedCount() {
+        return dropped_.exchange(0, std::memory_order_relaxed);
+    }
+
+    uint32_t GetThreadIndex() const {
+        return thread_index_;
+    }
+
+    // Called by the owning thread as it exits, after its last push.
+    void Retire() {
+        retired_.store(true, std::memory_order_release);
+    }
+
+    // Once this returns true, a drain sees every event the buffer will ever hold.
+    bool IsRetired() const {
+        return retired_.load(std::memory_order_acquire);
+    }
+
+private:
+    static_assert((kThreadBufferCapacity & (kThreadBufferCapacity - 1)) == 0, "The capacity must be a power of two.");
+
+    const uint32_t thread_index_;
+    std::vector<TraceEvent> events_;
+    std::atomic<uint64_t> head_;
+    std::atomic<uint64_t> tail_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<bool> retired_;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Tracer::ZoneHistogram: Bucket counts over the most recent durations of one zone.
+//-------------------------------------------------------------------------------------------------
+
+class Tracer::ZoneHistogram {
+public:
+    ZoneHistogram() : buckets_(kBucketCount, 0), total_count_(0) {
+        window_.reserve(kHistogramWindow);
+    }
+
+    void Add(uint64_t duration_ns) {
+        if (window_.size() < kHistogramWindow) {
+            window_.push_back(duration_ns);
+        } else {
+            uint64_t& oldest = window_[total_count_ % kHistogramWindow];
+            --buckets_[GetBucketIndex(oldest)];
+            oldest = duration_ns;
+        }
+        ++buckets_[GetBucketIndex(duration_ns)];
+        ++total_count_;
+    }
+
+    TraceZoneStats GetStats(const std::string& name) const {
+        TraceZoneStats stats;
+        stats.name = name;
+        stats.total_count = total_count_;
+        stats.window_count = window_.size();
+        stats.p50_ns = GetPercentile(0.5);
+        stats.p99_ns = GetPercentile(0.99);
+        stats.max_ns = window_.empty() ? 0 : *std::max_element(window_.begin(), window_.end());
+        return stats;
+    }
+
+private:
+    uint64_t GetPercentile(double fraction) const {
+        if (window_.empty()) {
+            return 0;
+        }
+
+        const uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(window_.size() - 1)) + 1;
+        uint64_t count = 0;
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            count += buckets_[i];
+            if (count >= rank) {
+                return GetBucketUpperBound(i);
+            }
+        }
+        return GetBucketUpperBound(kBucketCount - 1);
+    }
+
+    std::vector<uint32_t> buckets_;
+    std::vector<uint64_t> window_;
+    uint64_t total_count_;
+};
+
+//-------------------------------------------------------------------------------------------------
+// Tracer
+//-------------------------------------------------------------------------------------------------
+
+Tracer& Tracer::Get() {
+    static Tracer tracer;
+    return tracer;
+}
+
+uint64_t Tracer::GetTimestampNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+Tracer::Tracer()
+    : enabled_(false), next_thread_index_(0), max_captured_events_(0), capturing_(false), dropped_event_count_(0) {
+}
+
+Tracer::~Tracer() = default;
+
+void Tracer::SetEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+bool Tracer::IsEnabled() const {
+    return enabled_.load(std::memory_order_relaxed);
+}
+
+Tracer::ThreadBuffer& Tracer::GetThreadBuffer() {
+    // The thread shares ownership so a buffer outlives whichever of its thread and the tracer ends first. When the
+    // thread exits the buffer is marked retired, and the next collection drains it and lets it go.
+    struct ThreadBufferOwner {
+        std::shared_ptr<ThreadBuffer> buffer;
+
+        ~ThreadBufferOwner() {
+            if (buffer) {
+                buffer->Retire();
+            }
+        }
+    };
+
+    thread_local ThreadBufferOwner owner;
+    if (!owner.buffer) {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        owner.buffer = std::make_shared<ThreadBuffer>(next_thread_index_++);
+        buffers_.push_back(owner.buffer);
+    }
+    return *owner.buffer;
+}
+
+void Tracer::Record(const char* name, uint64_t start_ns, uint64_t end_ns) {
+    GetThreadBuffer().Push(TraceEvent{name, start_ns, end_ns > start_ns ? end_ns - start_ns : 0});
+}
+
+void Tracer::Collect() {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    CollectLocked();
+}
+
+void Tracer::CollectLocked() {
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        buffers = buffers_;
+    }
+
+    std::vector<ThreadBuffer*> drained_retired_buffers;
+    for (const std::shared_ptr<ThreadBuffer>& buffer : buffers) {
+        // Checked before draining, so a buffer retired during the drain is kept until the next collection.
+        const bool retired = buffer->IsRetired();
+        const uint32_t thread_index = buffer->GetThreadIndex();
+        buffer->Drain([this, thread_index](const TraceEvent& event) {
+            ZoneHistogram*& histogram = zones_by_pointer_[event.name];
+            if (histogram == nullptr) {
+                std::unique_ptr<ZoneHistogram>& named_histogram = zones_[event.name];
+                if (!named_histogram) {
+                    named_histogram.reset(new ZoneHistogram());
+                }
+                histogram = named_histogram.get();
+            }
+            histogram->Add(event.duration_ns);
+
+            if (capturing_) {
+                if (captured_.size() < max_captured_events_) {
+                    captured_.push_back(CapturedEvent{event, thread_index});
+                } else {
+                    ++dropped_event_count_;
+                }
+            }
+        });
+        dropped_event_count_ += buffer->TakeDroppedCount();
+        if (retired) {
+            drained_retired_buffers.push_back(buffer.get());
+        }
+    }
+
+    if (!drained_retired_buffers.empty()) {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                      [&drained_retired_buffers](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                          return std::find(drained_retired_buffers.begin(),
+                                                           drained_retired_buffers.end(),
+                                                           buffer.get()) != drained_retired_buffers.end();
+                                      }),
+                       buffers_.end());
+    }
+}
+
+void Tracer::StartCapture(size_t max_events) {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    CollectLocked();
+    captured_.clear();
+    max_captured_events_ = max_events;
+    capturing_ = true;
+}
+
+void Tracer::StopCapture() {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    CollectLocked();
+    capturing_ = false;
+}
+
+size_t Tracer::GetCapturedEventCount() {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    CollectLocked();
+    return captured_.size();
+}
+
+uint64_t Tracer::GetDroppedEventCount() {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    CollectLocked();
+    return dropped_event_count_;
+}
+
+size_t Tracer::GetThreadBufferCount() {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    CollectLocked();
+    std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+    return buffers_.size();
+}
+
+void Tracer::WriteChromeTrace(std::ostream& output) {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    CollectLocked();
+
+    // Timestamps start at the first kept event so they stay short. Threads that exited leave gaps in the indices, so
+    // only the threads that kept an event are named.
+    uint64_t origin_ns = 0;
+    std::vector<uint32_t> thread_indices;
+    for (size_t i = 0; i < captured_.size(); ++i) {
+        const CapturedEvent& captured = captured_[i];
+        origin_ns = i == 0 ? captured.event.start_ns : std::min(origin_ns, captured.event.start_ns);
+        thread_indices.push_back(captured.thread_index);
+    }
+    std::sort(thread_indices.begin(), thread_indices.end());
+    thread_indices.erase(std::unique(thread_indices.begin(), thread_indices.end()), thread_indices.end());
+
+    output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < thread_indices.size(); ++i) {
+        output << (i == 0 ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+               << thread_indices[i] << ",\"args\":{\"name\":\"thread " << thread_indices[i] << "\"}}";
+    }
+    for (size_t i = 0; i < captured_.size(); ++i) {
+        const CapturedEvent& captured = captured_[i];
+        output << (i == 0 && thread_indices.empty() ? "\n" : ",\n") << "{\"name\":";
+        WriteJsonString(output, captured.event.name);
+        output << ",\"cat\":\"sc2\",\"ph\":\"X\",\"pid\":1,\"tid\":" << captured.thread_index << ",\"ts\":";
+        WriteMicroseconds(output, captured.event.start_ns - origin_ns);
+        output << ",\"dur\":";
+        WriteMicroseconds(output, captured.event.duration_ns);
+        output << "}";
+    }
+    output << "\n]}\n";
+}
+
+bool Tracer::WriteChromeTrace(const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    WriteChromeTrace(file);
+    return static_cast<bool>(file);
+}
+
+std::vector<TraceZoneStats> Tracer::GetZoneStats() {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    CollectLocked();
+
+    std::vector<TraceZoneStats> stats;
+    stats.reserve(zones_.size());
+    for (const auto& zone : zones_) {
+        stats.push_back(zone.second->GetStats(zone.first));
+    }
+    return stats;
+}
+
+void Tracer::Reset() {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    CollectLocked();
+    zones_by_pointer_.clear();
+    zones_.clear();
+    captured_.clear();
+    dropped_event_count_ = 0;
+}
+
+//-------------------------------------------------------------------------------------------------
+// TraceZone
+//-------------------------------------------------------------------------------------------------
+
+TraceZone::TraceZone(const char* name)
+    : name_(Tracer::Get().IsEnabled() ? name : nullptr),
+      elapsed_microseconds_(nullptr),
+      start_ns_(name_ != nullptr ? Tracer::GetTimestampNanoseconds() : 0) {
+}
+
+TraceZone::TraceZone(const char* name, uint64_t& elapsed_microseconds)
+    : name_(name != nullptr && Tracer::Get().IsEnabled() ? name : nullptr),
+      elapsed_microseconds_(&elapsed_microseconds),
+      start_ns_(Tracer::GetTimestampNanoseconds()) {
+}
+
+TraceZone::~TraceZone() {
+    if (name_ == nullptr && elapsed_microseconds_ == nullptr) {
+        return;
+    }
+
+    const uint64_t end_ns = Tracer::GetTimestampNanoseconds();
+    if (elapsed_microseconds_ != nullptr) {
+        *elapsed_microseconds_ = (end_ns - start_ns_) / 1000;
+    }
+    if (name_ != nullptr) {
+        Tracer::Get().Record(name_, start_ns_, end_ns);
+    }
+}
+
+}  // namespace sc2
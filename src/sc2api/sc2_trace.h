@@ -0,0 +1,174 @@
+/*! \file sc2_trace.h
+    \brief Scoped trace zones recorded into per-thread buffers, with rolling per-zone histograms and export to the
+    Chrome trace-event format that chrome://tracing and Perfetto load.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sc2 {
+
+//! A zone that has ended. The name is not copied, so it must be a string literal or otherwise outlive the tracer.
+struct TraceEvent {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+};
+
+//! Statistics of one zone over its most recent samples. The percentiles are upper bounds of quarter-octave
+//! histogram buckets, so they overstate the true value by at most a quarter; the maximum is exact.
+struct TraceZoneStats {
+    std::string name;
+    //! Samples since the statistics were last reset, and the samples in the rolling window.
+    uint64_t total_count;
+    uint64_t window_count;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;
+};
+
+//! Collects the zones of every thread in the process. Each thread appends to its own fixed-size ring without locks
+//! and drops events while its ring is full; Collect drains the rings into the histograms and, while capturing, into
+//! the event list that is exported, and releases the rings of threads that have exited. Zones are only recorded
+//! while the tracer is enabled, which it is not by default.
+class Tracer {
+public:
+    //! Events a thread can hold between collections.
+    static constexpr size_t kThreadBufferCapacity = 1 << 14;
+    //! Samples each zone histogram covers.
+    static constexpr size_t kHistogramWindow = 1024;
+
+    //!< \return The tracer of the process.
+    static Tracer& Get();
+
+    //!< \return Nanoseconds on the steady clock, the timebase of every event.
+    static uint64_t GetTimestampNanoseconds();
+
+    //! Starts or stops recording zones. Zones that are open when recording stops are still recorded.
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    //! Appends a finished zone to the buffer of the calling thread. Lock-free after the first call on a thread.
+    //!< \param name The zone name, which must outlive the tracer.
+    //!< \param start_ns When the zone started.
+    //!< \param end_ns When the zone ended.
+    void Record(const char* name, uint64_t start_ns, uint64_t end_ns);
+
+    //! Drains every thread buffer. Call regularly, for example once per game step, so buffers do not overflow.
+    void Collect();
+
+    //! Starts keeping collected events for export, dropping any kept earlier.
+    //!< \param max_events Events to keep; later ones are counted as dropped.
+    void StartCapture(size_t max_events = 1 << 22);
+
+    //! Stops keeping collected events. Kept events stay available for export.
+    void StopCapture();
+
+    //!< \return The number of events kept for export.
+    size_t GetCapturedEventCount();
+
+    //!< \return The number of events lost to full thread buffers or a full capture.
+    uint64_t GetDroppedEventCount();
+
+    //! Collects and counts the thread buffers still held, which are those of threads that have not exited.
+    //!< \return The number of thread buffers.
+    size_t GetThreadBufferCount();
+
+    //! Collects and writes the kept events as Chrome trace-event JSON.
+    //!< \param output The stream to write to.
+    void WriteChromeTrace(std::ostream& output);
+
+    //! Collects and writes the kept events as Chrome trace-event JSON.
+    //!< \param path The file to write.
+    //!< \return False if the file could not be written.
+    bool WriteChromeTrace(const std::string& path);
+
+    //! Collects and summarizes every zone seen since the last reset, ordered by name.
+    //!< \return The statistics of each zone.
+    std::vector<TraceZoneStats> GetZoneStats();
+
+    //! Collects and then forgets the histograms, the kept events and the dropped count.
+    void Reset();
+
+private:
+    class ThreadBuffer;
+    class ZoneHistogram;
+
+    struct CapturedEvent {
+        TraceEvent event;
+        uint32_t thread_index;
+    };
+
+    Tracer();
+    ~Tracer();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    ThreadBuffer& GetThreadBuffer();
+    void CollectLocked();
+
+    std::atomic<bool> enabled_;
+
+    std::mutex buffers_mutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    uint32_t next_thread_index_;
+
+    // Everything below belongs to the collector.
+    std::mutex collect_mutex_;
+    std::map<std::string, std::unique_ptr<ZoneHistogram>> zones_;
+    std::unordered_map<const char*, ZoneHistogram*> zones_by_pointer_;
+    std::vector<CapturedEvent> captured_;
+    size_t max_captured_events_;
+    bool capturing_;
+    uint64_t dropped_event_count_;
+};
+
+//! Times the enclosing scope and records it with the tracer when the tracer is enabled as the zone starts.
+class TraceZone {
+public:
+    //!< \param name The zone name, which must outlive the tracer.
+    explicit TraceZone(const char* name);
+
+    //! Also stores the duration of the zone when it ends, whether or not the tracer is enabled.
+    //!< \param name The zone name, which must outlive the tracer. Null only times the scope.
+    //!< \param elapsed_microseconds Receives the duration of the zone.
+    TraceZone(const char* name, uint64_t& elapsed_microseconds);
+
+    ~TraceZone();
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* name_;
+    uint64_t* elapsed_microseconds_;
+    uint64_t start_ns_;
+};
+
+}  // namespace sc2
+
+#define SC2_TRACE_CONCAT_INNER(a, b) a##b
+#define SC2_TRACE_CONCAT(a, b) SC2_TRACE_CONCAT_INNER(a, b)
+
+// SC2_TRACE_ZONE records the rest of the enclosing scope as a zone. SC2_TRACE_ZONE_TIMED also stores its duration in
+// microseconds, and keeps doing so when zones are compiled out by leaving SC2_TRACE_ENABLED undefined.
+#if defined(SC2_TRACE_ENABLED)
+#define SC2_TRACE_ZONE(name) ::sc2::TraceZone SC2_TRACE_CONCAT(sc2_trace_zone_, __LINE__)(name)
+#define SC2_TRACE_ZONE_TIMED(name, elapsed_microseconds) \
+    ::sc2::TraceZone SC2_TRACE_CONCAT(sc2_trace_zone_, __LINE__)(name, elapsed_microseconds)
+#else
+#define SC2_TRACE_ZONE(name) ((void)0)
+#define SC2_TRACE_ZONE_TIMED(name, elapsed_microseconds) \
+    ::sc2::TraceZone SC2_TRACE_CONCAT(sc2_trace_zone_, __LINE__)(nullptr, elapsed_microseconds)
+#endif
@@ -20,10 +20,13 @@ Tags ConvertToTags(const Units& units) {
 }
 
 Unit* UnitPool::CreateUnit(Tag tag) {
-    Unit* existing = GetUnit(tag);
-    if (existing) {
-        tag_to_existing_unit_[tag] = existing;
-        return existing;
+    uint32_t slot = FindSlot(tag);
+    if (slot != UnitHandle::InvalidIndex) {
+        if (slot_existing_indices_[slot] == UnitHandle::InvalidIndex) {
+            AddExistingSlot(slot);
+        }
+        last_created_slot_ = slot;
+        return slot_units_[slot];
     }
 
     if (unit_pool_.empty() || unit_pool_.size() == available_index_.first) {
@@ -33,21 +36,73 @@ Unit* UnitPool::CreateUnit(Tag tag) {
     std::vector<Unit>& pool = unit_pool_[available_index_.first];
     Unit* unit = &pool[available_index_.second];
     unit->last_seen_game_loop = 0;  // initialization required for OnUnitEnterVision
-    tag_to_unit_[tag] = unit;
-    tag_to_existing_unit_[tag] = unit;
+
+    slot = static_cast<uint32_t>(slot_units_.size());
+    slot_units_.push_back(unit);
+    slot_generations_.push_back(0);
+    slot_existing_indices_.push_back(UnitHandle::InvalidIndex);
+    tag_to_slot_[tag] = slot;
+    AddExistingSlot(slot);
+    last_created_slot_ = slot;
+
     AddNewUnit(unit);
     IncrementIndex();
     return unit;
 }
 
+void UnitPool::CommitExistingUnit(const Unit& unit) {
+    uint32_t slot = last_created_slot_;
+    if (slot == UnitHandle::InvalidIndex || slot_units_[slot] != &unit) {
+        slot = FindSlot(unit.tag);
+    }
+    if (slot == UnitHandle::InvalidIndex) {
+        return;
+    }
+
+    const uint32_t existing_index = slot_existing_indices_[slot];
+    if (existing_index == UnitHandle::InvalidIndex) {
+        return;
+    }
+
+    uint8_t flags = 0;
+    flags |= unit.is_flying ? FlagFlying : 0U;
+    flags |= unit.is_building ? FlagBuilding : 0U;
+    flags |= unit.is_burrowed ? FlagBurrowed : 0U;
+    flags |= unit.is_hallucination ? FlagHallucination : 0U;
+    flags |= unit.display_type == Unit::Snapshot ? FlagSnapshot : 0U;
+
+    existing_positions_[existing_index] = unit.pos;
+    existing_alliances_[existing_index] = unit.alliance;
+    existing_unit_types_[existing_index] = unit.unit_type;
+    existing_flags_[existing_index] = flags;
+}
+
 Unit* UnitPool::GetUnit(Tag tag) const {
-    auto found = tag_to_unit_.find(tag);
-    return found == tag_to_unit_.end() ? nullptr : found->second;
+    const uint32_t slot = FindSlot(tag);
+    return slot == UnitHandle::InvalidIndex ? nullptr : slot_units_[slot];
 }
 
 Unit* UnitPool::GetExistingUnit(Tag tag) const {
-    auto found = tag_to_existing_unit_.find(tag);
-    return found == tag_to_existing_unit_.end() ? nullptr : found->second;
+    const uint32_t slot = FindSlot(tag);
+    if (slot == UnitHandle::InvalidIndex || slot_existing_indices_[slot] == UnitHandle::InvalidIndex) {
+        return nullptr;
+    }
+    return slot_units_[slot];
+}
+
+UnitHandle UnitPool::GetHandle(Tag tag) const {
+    const uint32_t slot = FindSlot(tag);
+    if (slot == UnitHandle::InvalidIndex || !slot_units_[slot]->is_alive) {
+        return UnitHandle();
+    }
+    return UnitHandle{slot, slot_generations_[slot]};
+}
+
+Unit* UnitPool::Resolve(UnitHandle handle) const {
+    if (handle.index >= slot_units_.size() || slot_generations_[handle.index] != handle.generation) {
+        return nullptr;
+    }
+    return slot_units_[handle.index];
 }
 
 void UnitPool::IncrementIndex() {
@@ -59,24 +114,35 @@ void UnitPool::IncrementIndex() {
 }
 
 void UnitPool::MarkDead(Tag tag) {
-    Unit* unit = GetUnit(tag);
-    if (!unit) {
+    const uint32_t slot = FindSlot(tag);
+    if (slot == UnitHandle::InvalidIndex) {
         return;
     }
-    unit->is_alive = false;
+    slot_units_[slot]->is_alive = false;
+    ++slot_generations_[slot];
     // CHeck if this is necessary, bro
-    tag_to_existing_unit_.erase(tag);
+    RemoveExistingSlot(slot);
 }
 
 void UnitPool::ForEachExistingUnit(const std::function<void(Unit& unit)>& functor) const {
-    for (const auto& u : tag_to_existing_unit_) {
-        assert(u.second);
-        functor(*u.second);
+    for (Unit* unit : existing_units_) {
+        assert(unit);
+        functor(*unit);
     }
 }
 
 void UnitPool::ClearExisting() {
-    tag_to_existing_unit_.clear();
+    for (const uint32_t slot : existing_slots_) {
+        slot_existing_indices_[slot] = UnitHandle::InvalidIndex;
+    }
+    existing_slots_.clear();
+    existing_units_.clear();
+    existing_positions_.clear();
+    existing_alliances_.clear();
+    existing_unit_types_.clear();
+    existing_flags_.clear();
+    last_created_slot_ = UnitHandle::InvalidIndex;
+
     units_newly_created_.clear();
     units_entering_vision_.clear();
     buildings_constructed_.clear();
@@ -85,7 +151,52 @@ void UnitPool::ClearExisting() {
 }
 
 bool UnitPool::UnitExists(Tag tag) {
-    return tag_to_existing_unit_.find(tag) != tag_to_existing_unit_.end();
+    const uint32_t slot = FindSlot(tag);
+    return slot != UnitHandle::InvalidIndex && slot_existing_indices_[slot] != UnitHandle::InvalidIndex;
+}
+
+void UnitPool::AddExistingSlot(uint32_t slot) {
+    // Hot columns are filled by CommitExistingUnit once the observation has been converted into the record.
+    slot_existing_indices_[slot] = static_cast<uint32_t>(existing_slots_.size());
+    existing_slots_.push_back(slot);
+    existing_units_.push_back(slot_units_[slot]);
+    existing_positions_.emplace_back();
+    existing_alliances_.push_back(Unit::Alliance::Neutral);
+    existing_unit_types_.push_back(UNIT_TYPEID::INVALID);
+    existing_flags_.push_back(0);
+}
+
+void UnitPool::RemoveExistingSlot(uint32_t slot) {
+    const uint32_t existing_index = slot_existing_indices_[slot];
+    if (existing_index == UnitHandle::InvalidIndex) {
+        return;
+    }
+
+    // Swap-remove keeps the dense columns contiguous; only the moved unit's index changes.
+    const uint32_t last_index = static_cast<uint32_t>(existing_slots_.size() - 1);
+    if (existing_index != last_index) {
+        const uint32_t moved_slot = existing_slots_[last_index];
+        existing_slots_[existing_index] = moved_slot;
+        existing_units_[existing_index] = existing_units_[last_index];
+        existing_positions_[existing_index] = existing_positions_[last_index];
+        existing_alliances_[existing_index] = existing_alliances_[last_index];
+        existing_unit_types_[existing_index] = existing_unit_types_[last_index];
+        existing_flags_[existing_index] = existing_flags_[last_index];
+        slot_existing_indices_[moved_slot] = existing_index;
+    }
+
+    existing_slots_.pop_back();
+    existing_units_.pop_back();
+    existing_positions_.pop_back();
+    existing_alliances_.pop_back();
+    existing_unit_types_.pop_back();
+    existing_flags_.pop_back();
+    slot_existing_indices_[slot] = UnitHandle::InvalidIndex;
+}
+
+uint32_t UnitPool::FindSlot(Tag tag) const {
+    auto found = tag_to_slot_.find(tag);
+    return found == tag_to_slot_.end() ? UnitHandle::InvalidIndex : found->second;
 }
 
 }  // namespace sc2
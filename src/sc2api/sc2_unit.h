@@ -5,6 +5,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -215,18 +216,83 @@ struct UnitDamage {
 
 using UnitsDamaged = std::vector<UnitDamage>;
 
+//! A generation-checked reference to a unit slot in a UnitPool.
+//! A handle stops resolving once its unit is marked dead, even though the Unit record itself stays allocated.
+struct UnitHandle {
+    static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    [[nodiscard]] bool IsValid() const noexcept {
+        return index != InvalidIndex;
+    }
+};
+
+//! Storage for every unit seen during a game.
+//! Unit records live in fixed-size chunks so pointers handed out through the API stay stable. Units present in the
+//! current observation are additionally packed into dense columns: hot fields (position, alliance, type and flags)
+//! are copied into contiguous arrays for cache-friendly scans, while everything else (health, orders, buffs,
+//! passengers) stays in the Unit record reachable through the dense unit column.
 class UnitPool {
 public:
+    //! Bits stored in the existing-unit flags column.
+    static constexpr uint8_t FlagFlying = 1U << 0U;
+    static constexpr uint8_t FlagBuilding = 1U << 1U;
+    static constexpr uint8_t FlagBurrowed = 1U << 2U;
+    static constexpr uint8_t FlagHallucination = 1U << 3U;
+    static constexpr uint8_t FlagSnapshot = 1U << 4U;
+
     Unit* CreateUnit(Tag tag);
+    //! Copies the hot fields of a unit returned by the most recent CreateUnit call into the dense columns.
+    void CommitExistingUnit(const Unit& unit);
     [[nodiscard]] Unit* GetUnit(Tag tag) const;
     [[nodiscard]] Unit* GetExistingUnit(Tag tag) const;
     void MarkDead(Tag tag);
 
+    [[nodiscard]] UnitHandle GetHandle(Tag tag) const;
+    [[nodiscard]] Unit* Resolve(UnitHandle handle) const;
+
     // TODO(?): Change alive -> Exist
     void ForEachExistingUnit(const std::function<void(Unit& unit)>& functor) const;
+    //! Visits every existing unit in observation order without type-erasing the functor.
+    template <typename Functor>
+    void ForEachExisting(Functor&& functor) const {
+        for (Unit* unit : existing_units_) {
+            functor(*unit);
+        }
+    }
+    //! Visits the existing units of one alliance in observation order, rejecting others on the alliance column.
+    template <typename Functor>
+    void ForEachExisting(Unit::Alliance alliance, Functor&& functor) const {
+        for (size_t i = 0; i < existing_units_.size(); ++i) {
+            if (existing_alliances_[i] == alliance) {
+                functor(*existing_units_[i]);
+            }
+        }
+    }
     void ClearExisting();
     bool UnitExists(Tag tag);
 
+    [[nodiscard]] size_t GetExistingCount() const noexcept {
+        return existing_units_.size();
+    }
+    [[nodiscard]] const std::vector<Unit*>& GetExistingUnits() const noexcept {
+        return existing_units_;
+    }
+    [[nodiscard]] const std::vector<Point3D>& GetExistingPositions() const noexcept {
+        return existing_positions_;
+    }
+    [[nodiscard]] const std::vector<Unit::Alliance>& GetExistingAlliances() const noexcept {
+        return existing_alliances_;
+    }
+    [[nodiscard]] const std::vector<UnitTypeID>& GetExistingUnitTypes() const noexcept {
+        return existing_unit_types_;
+    }
+    [[nodiscard]] const std::vector<uint8_t>& GetExistingFlags() const noexcept {
+        return existing_flags_;
+    }
+
     [[nodiscard]] const Units& GetNewUnits() const noexcept {
         return units_newly_created_;
     };
@@ -263,13 +329,30 @@ public:
 
 private:
     void IncrementIndex();
+    void AddExistingSlot(uint32_t slot);
+    void RemoveExistingSlot(uint32_t slot);
+    [[nodiscard]] uint32_t FindSlot(Tag tag) const;
 
     static const size_t ENTRY_SIZE = 1000;
     // std::array<Unit, ENTRY_SIZE>
     std::vector<std::vector<Unit> > unit_pool_;
     std::pair<size_t, size_t> available_index_;
-    std::unordered_map<Tag, Unit*> tag_to_unit_;
-    std::unordered_map<Tag, Unit*> tag_to_existing_unit_;
+    std::unordered_map<Tag, uint32_t> tag_to_slot_;
+
+    // Indexed by slot.
+    std::vector<Unit*> slot_units_;
+    std::vector<uint32_t> slot_generations_;
+    std::vector<uint32_t> slot_existing_indices_;
+    uint32_t last_created_slot_ = UnitHandle::InvalidIndex;
+
+    // Indexed by existing position, in observation order.
+    std::vector<uint32_t> existing_slots_;
+    std::vector<Unit*> existing_units_;
+    std::vector<Point3D> existing_positions_;
+    std::vector<Unit::Alliance> existing_alliances_;
+    std::vector<UnitTypeID> existing_unit_types_;
+    std::vector<uint8_t> existing_flags_;
+
     Units units_newly_created_;
     Units units_entering_vision_;
     Units buildings_constructed_;
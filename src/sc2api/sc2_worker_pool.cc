@@ -0,0 +1,163 @@
+#include "sc2_worker_pool.h"
+
+#include <cassert>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace sc2 {
+
+namespace {
+
+void PinCurrentThread(size_t worker_index) {
+    const unsigned int core_count = std::thread::hardware_concurrency();
+    if (core_count == 0) {
+        return;
+    }
+
+    const size_t core = worker_index % core_count;
+#if defined(_WIN32)
+    // Affinity masks only cover the current processor group.
+    const size_t group_core = core % (sizeof(DWORD_PTR) * 8);
+    SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << group_core);
+#elif defined(__linux__)
+    if (core >= CPU_SETSIZE) {
+        return;
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core, &cpu_set);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#else
+    // macOS has no hard affinity; leave scheduling to the OS.
+    (void)core;
+#endif
+}
+
+}  // namespace
+
+WorkerPool::WorkerPool()
+    : workers_(),
+      worker_count_(0),
+      pinned_(false),
+      task_(nullptr),
+      task_count_(0),
+      generation_(0),
+      busy_workers_(0),
+      stopping_(false) {
+}
+
+WorkerPool::~WorkerPool() {
+    Stop();
+}
+
+void WorkerPool::Start(size_t worker_count, bool pin_to_cores) {
+    Stop();
+
+    // Workers read these before their first wait, so they are set before any worker starts.
+    worker_count_ = worker_count;
+    pinned_ = pin_to_cores;
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&WorkerPool::WorkerLoop, this, i, generation_);
+    }
+}
+
+void WorkerPool::Stop() {
+    if (workers_.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_condition_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+
+    workers_.clear();
+    worker_count_ = 0;
+    stopping_ = false;
+    pinned_ = false;
+}
+
+void WorkerPool::Run(size_t task_count, const std::function<void(size_t)>& task) {
+    if (task_count == 0) {
+        return;
+    }
+
+    if (workers_.empty()) {
+        for (size_t i = 0; i < task_count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    assert(busy_workers_ == 0);
+    task_ = &task;
+    task_count_ = task_count;
+    busy_workers_ = worker_count_;
+    ++generation_;
+    start_condition_.notify_all();
+
+    done_condition_.wait(lock, [this] { return busy_workers_ == 0; });
+    task_ = nullptr;
+    task_count_ = 0;
+}
+
+size_t WorkerPool::GetWorkerCount() const {
+    return worker_count_;
+}
+
+bool WorkerPool::IsPinned() const {
+    return pinned_;
+}
+
+void WorkerPool::WorkerLoop(size_t worker_index, uint64_t seen_generation) {
+    if (pinned_) {
+        PinCurrentThread(worker_index);
+    }
+
+    const size_t worker_count = worker_count_;
+    for (;;) {
+        const std::function<void(size_t)>* task = nullptr;
+        size_t task_count = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_condition_.wait(lock, [this, seen_generation] {
+                return stopping_ || generation_ != seen_generation;
+            });
+            if (stopping_) {
+                return;
+            }
+
+            seen_generation = generation_;
+            task = task_;
+            task_count = task_count_;
+        }
+
+        for (size_t i = worker_index; i < task_count; i += worker_count) {
+            (*task)(i);
+        }
+
+        bool last_worker = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last_worker = --busy_workers_ == 0;
+        }
+        if (last_worker) {
+            done_condition_.notify_one();
+        }
+    }
+}
+
+}  // namespace sc2
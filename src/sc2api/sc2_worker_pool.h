@@ -0,0 +1,66 @@
+/*! \file sc2_worker_pool.h
+    \brief A persistent set of worker threads that run one batch of indexed tasks at a time.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sc2 {
+
+//! Worker threads that live across steps so stepping several clients does not create and join a thread per client
+//! per step. Tasks are assigned statically: worker w runs tasks w, w + worker count, ... so a given client is always
+//! stepped by the same worker, and by the same core when pinning is enabled.
+class WorkerPool {
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    //! Starts the workers, stopping any that are already running.
+    //!< \param worker_count The number of threads to start.
+    //!< \param pin_to_cores Pins worker w to core w modulo the hardware concurrency where the platform supports it.
+    void Start(size_t worker_count, bool pin_to_cores);
+
+    //! Stops and joins every worker. Safe to call when the pool is not running.
+    void Stop();
+
+    //! Runs task(0) ... task(task_count - 1) and blocks until all of them have returned, which makes each call a
+    //! barrier for the whole batch. Runs the batch on the calling thread if the pool has not been started.
+    //! Must not be called from a task.
+    //!< \param task_count The number of tasks in the batch.
+    //!< \param task The task to run, called with the task index.
+    void Run(size_t task_count, const std::function<void(size_t)>& task);
+
+    //!< \return The number of running workers.
+    size_t GetWorkerCount() const;
+
+    //!< \return True if the running workers were asked to pin themselves to cores.
+    bool IsPinned() const;
+
+private:
+    void WorkerLoop(size_t worker_index, uint64_t seen_generation);
+
+    std::vector<std::thread> workers_;
+    size_t worker_count_;
+    bool pinned_;
+
+    std::mutex mutex_;
+    std::condition_variable start_condition_;
+    std::condition_variable done_condition_;
+    const std::function<void(size_t)>* task_;
+    size_t task_count_;
+    uint64_t generation_;
+    size_t busy_workers_;
+    bool stopping_;
+};
+
+}  // namespace sc2
@@ -13,6 +13,10 @@
 #include "test_actions.h"
 #include "test_app.h"
 #include "test_command_authority_scheduling.h"
+#include "test_connection_receive.h"
+#include "test_proto_recording.h"
+#include "test_mock_game.h"
+#include "test_trace.h"
 #include "test_feature_layer.h"
 #include "test_feature_layer_mp.h"
 #include "test_movement_combat.h"
@@ -35,7 +39,17 @@
 #include "test_terran_economy_production_order_expander.h"
 #include "test_terran_ramp_wall_controller.h"
 #include "test_terran_planners.h"
+#include "test_spatial_field_builder.h"
+#include "test_enemy_observation_descriptor.h"
+#include "test_map_grids.h"
+#include "test_map_grid_layout_analyzer.h"
+#include "test_placement_footprint_evaluator.h"
+#include "test_build_placement_slot_cache.h"
+#include "test_ground_pathfinder.h"
 #include "test_unit_command.h"
+#include "test_unit_pool.h"
+#include "test_unit_spatial_index.h"
+#include "test_worker_pool.h"
 
 namespace sc2
 {
@@ -107,7 +121,21 @@ int main(int argc, char* argv[])
     TEST(sc2::TestMovementCombat);
     TEST(sc2::TestFastRestartSinglePlayer);
     TEST(sc2::TestUnitCommand);
+    TEST(sc2::TestConnectionReceive);
+    TEST(sc2::TestProtoRecording);
+    TEST(sc2::TestMockGame);
+    TEST(sc2::TestTrace);
+    TEST(sc2::TestWorkerPool);
     TEST(sc2::TestSchedulerHotPathProfiles);
+    TEST(sc2::TestUnitPool);
+    TEST(sc2::TestUnitSpatialIndex);
+    TEST(sc2::TestSpatialFieldBuilder);
+    TEST(sc2::TestEnemyObservationDescriptor);
+    TEST(sc2::TestMapGrids);
+    TEST(sc2::TestMapGridLayoutAnalyzer);
+    TEST(sc2::TestPlacementFootprintEvaluator);
+    TEST(sc2::TestBuildPlacementSlotCache);
+    TEST(sc2::TestGroundPathfinder);
     TEST(sc2::TestPerformance);
     TEST(sc2::TestObservationInterface);
     TEST(sc2::TestSingularityFramework);
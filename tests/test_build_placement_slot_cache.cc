@@ -0,0 +1,253 @@
+#include "test_build_placement_slot_cache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/services/FBuildPlacementContext.h"
+#include "common/services/FBuildPlacementSlotCache.h"
+#include "common/services/FMainBaseLayoutDescriptor.h"
+#include "common/services/FRampWallDescriptor.h"
+#include "sc2api/sc2_map_info.h"
+
+namespace sc2
+{
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const std::string& MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+FBuildPlacementSlot MakeSlot(const EBuildPlacementSlotType SlotTypeValue, const uint8_t OrdinalValue,
+                             const EBuildPlacementFootprintPolicy FootprintPolicyValue, const Point2D& BuildPointValue)
+{
+    FBuildPlacementSlot SlotValue;
+    SlotValue.SlotId.SlotType = SlotTypeValue;
+    SlotValue.SlotId.Ordinal = OrdinalValue;
+    SlotValue.FootprintPolicy = FootprintPolicyValue;
+    SlotValue.BuildPoint = BuildPointValue;
+    return SlotValue;
+}
+
+bool AreSlotsEqual(const std::vector<FBuildPlacementSlot>& LeftSlotsValue,
+                   const std::vector<FBuildPlacementSlot>& RightSlotsValue)
+{
+    if (LeftSlotsValue.size() != RightSlotsValue.size())
+    {
+        return false;
+    }
+
+    for (size_t SlotIndexValue = 0U; SlotIndexValue < LeftSlotsValue.size(); ++SlotIndexValue)
+    {
+        if (LeftSlotsValue[SlotIndexValue].SlotId != RightSlotsValue[SlotIndexValue].SlotId ||
+            LeftSlotsValue[SlotIndexValue].FootprintPolicy != RightSlotsValue[SlotIndexValue].FootprintPolicy ||
+            LeftSlotsValue[SlotIndexValue].BuildPoint != RightSlotsValue[SlotIndexValue].BuildPoint)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+GameInfo MakeGameInfo(const char BlockedByteValue)
+{
+    GameInfo GameInfoValue;
+    GameInfoValue.width = 32;
+    GameInfoValue.height = 32;
+    GameInfoValue.placement_grid.width = 32;
+    GameInfoValue.placement_grid.height = 32;
+    GameInfoValue.placement_grid.bits_per_pixel = 8;
+    GameInfoValue.placement_grid.data.assign(32U * 32U, static_cast<char>(255));
+    GameInfoValue.placement_grid.data[100U] = BlockedByteValue;
+    return GameInfoValue;
+}
+
+}  // namespace
+
+bool TestBuildPlacementSlotCache(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+    const std::string CachePathValue = "test_build_placement_slot_cache.bin";
+    std::remove(CachePathValue.c_str());
+
+    FRampWallDescriptor RampWallDescriptorValue;
+    RampWallDescriptorValue.bIsValid = true;
+    RampWallDescriptorValue.WallCenterPoint = Point2D(40.5f, 30.5f);
+    RampWallDescriptorValue.InsideStagingPoint = Point2D(38.0f, 33.0f);
+    RampWallDescriptorValue.OutsideStagingPoint = Point2D(43.0f, 28.0f);
+    RampWallDescriptorValue.LeftDepotSlot = MakeSlot(EBuildPlacementSlotType::MainRampDepotLeft, 0U,
+                                                     EBuildPlacementFootprintPolicy::StructureOnly,
+                                                     Point2D(39.0f, 32.0f));
+    RampWallDescriptorValue.BarracksSlot = MakeSlot(EBuildPlacementSlotType::MainRampBarracksWithAddon, 0U,
+                                                    EBuildPlacementFootprintPolicy::RequiresAddonClearance,
+                                                    Point2D(41.5f, 30.5f));
+    RampWallDescriptorValue.RightDepotSlot = MakeSlot(EBuildPlacementSlotType::MainRampDepotRight, 0U,
+                                                      EBuildPlacementFootprintPolicy::StructureOnly,
+                                                      Point2D(42.0f, 29.0f));
+
+    FMainBaseLayoutDescriptor MainBaseLayoutDescriptorValue;
+    MainBaseLayoutDescriptorValue.bIsValid = true;
+    MainBaseLayoutDescriptorValue.bUsesAuthoredProductionLayout = true;
+    MainBaseLayoutDescriptorValue.LayoutAnchorPoint = Point2D(30.5f, 20.5f);
+    MainBaseLayoutDescriptorValue.ArmyAssemblyAnchorPoint = Point2D(44.0f, 26.0f);
+    MainBaseLayoutDescriptorValue.ProductionClearanceAnchorPoint = Point2D(30.5f, 28.5f);
+    for (uint8_t OrdinalValue = 0U; OrdinalValue < 6U; ++OrdinalValue)
+    {
+        MainBaseLayoutDescriptorValue.SupportDepotSlots.push_back(MakeSlot(
+            EBuildPlacementSlotType::MainSupportDepot, OrdinalValue, EBuildPlacementFootprintPolicy::StructureOnly,
+            Point2D(20.0f + static_cast<float>(OrdinalValue) * 2.0f, 12.0f)));
+        MainBaseLayoutDescriptorValue.BarracksWithAddonSlots.push_back(MakeSlot(
+            EBuildPlacementSlotType::MainBarracksWithAddon, OrdinalValue,
+            EBuildPlacementFootprintPolicy::RequiresAddonClearance,
+            Point2D(24.5f, 16.5f + static_cast<float>(OrdinalValue) * 3.0f)));
+    }
+
+    const GameInfo GameInfoValue = MakeGameInfo(0);
+    FBuildPlacementContext BuildPlacementContextValue;
+    BuildPlacementContextValue.BaseLocation = Point2D(30.5f, 20.5f);
+    const FBuildPlacementSlotCacheKey KeyValue =
+        FBuildPlacementSlotCacheKey::Create(GameInfoValue, BuildPlacementContextValue);
+
+    std::cout << "  Checking slot cache keys..." << std::endl;
+    {
+        const FBuildPlacementSlotCacheKey EditedMapKeyValue =
+            FBuildPlacementSlotCacheKey::Create(MakeGameInfo(static_cast<char>(255)), BuildPlacementContextValue);
+        Check(!(EditedMapKeyValue == KeyValue), SuccessValue,
+              "A changed placement grid should produce a different cache key.");
+
+        FBuildPlacementContext OtherSpawnContextValue = BuildPlacementContextValue;
+        OtherSpawnContextValue.BaseLocation = Point2D(120.5f, 100.5f);
+        Check(!(FBuildPlacementSlotCacheKey::Create(GameInfoValue, OtherSpawnContextValue) == KeyValue),
+              SuccessValue, "A different spawn should produce a different cache key.");
+        Check(FBuildPlacementSlotCacheKey::Create(GameInfoValue, BuildPlacementContextValue) == KeyValue,
+              SuccessValue, "The same map and spawn should produce the same cache key.");
+    }
+
+    std::cout << "  Checking slot cache round trip..." << std::endl;
+    {
+        FBuildPlacementSlotCache WriterCacheValue;
+        WriterCacheValue.StoreLayout(KeyValue, RampWallDescriptorValue, MainBaseLayoutDescriptorValue);
+        Check(WriterCacheValue.SaveToFile(CachePathValue), SuccessValue, "The slot cache should be written.");
+
+        FBuildPlacementSlotCache ReaderCacheValue;
+        Check(ReaderCacheValue.LoadFromFile(CachePathValue), SuccessValue, "The slot cache should load.");
+        Check(ReaderCacheValue.IsMapped() && ReaderCacheValue.GetEntryCount() == 1U, SuccessValue,
+              "The loaded slot cache should map one entry.");
+
+        FRampWallDescriptor LoadedRampWallDescriptorValue;
+        FMainBaseLayoutDescriptor LoadedMainBaseLayoutDescriptorValue;
+        const FSteadyClock::time_point StartTimeValue = FSteadyClock::now();
+        const bool bFoundValue = ReaderCacheValue.TryGetLayout(KeyValue, LoadedRampWallDescriptorValue,
+                                                               LoadedMainBaseLayoutDescriptorValue);
+        const FSteadyClock::time_point EndTimeValue = FSteadyClock::now();
+        Check(bFoundValue, SuccessValue, "The stored layout should be found after reload.");
+        Check(LoadedRampWallDescriptorValue.bIsValid &&
+                  LoadedRampWallDescriptorValue.WallCenterPoint == RampWallDescriptorValue.WallCenterPoint &&
+                  LoadedRampWallDescriptorValue.BarracksSlot.SlotId == RampWallDescriptorValue.BarracksSlot.SlotId &&
+                  LoadedRampWallDescriptorValue.RightDepotSlot.BuildPoint ==
+                      RampWallDescriptorValue.RightDepotSlot.BuildPoint,
+              SuccessValue, "The ramp wall descriptor should survive the round trip.");
+        Check(LoadedMainBaseLayoutDescriptorValue.bIsValid &&
+                  LoadedMainBaseLayoutDescriptorValue.bUsesAuthoredProductionLayout &&
+                  LoadedMainBaseLayoutDescriptorValue.LayoutAnchorPoint ==
+                      MainBaseLayoutDescriptorValue.LayoutAnchorPoint &&
+                  AreSlotsEqual(LoadedMainBaseLayoutDescriptorValue.SupportDepotSlots,
+                                MainBaseLayoutDescriptorValue.SupportDepotSlots) &&
+                  AreSlotsEqual(LoadedMainBaseLayoutDescriptorValue.BarracksWithAddonSlots,
+                                MainBaseLayoutDescriptorValue.BarracksWithAddonSlots) &&
+                  LoadedMainBaseLayoutDescriptorValue.FactoryWithAddonSlots.empty(),
+              SuccessValue, "The main base layout descriptor should survive the round trip.");
+        std::cout << "    RestoreNs="
+                  << std::chrono::duration_cast<std::chrono::nanoseconds>(EndTimeValue - StartTimeValue).count()
+                  << std::endl;
+
+        FBuildPlacementContext OtherSpawnContextValue = BuildPlacementContextValue;
+        OtherSpawnContextValue.BaseLocation = Point2D(120.5f, 100.5f);
+        const FBuildPlacementSlotCacheKey OtherSpawnKeyValue =
+            FBuildPlacementSlotCacheKey::Create(GameInfoValue, OtherSpawnContextValue);
+        Check(!ReaderCacheValue.TryGetLayout(OtherSpawnKeyValue, LoadedRampWallDescriptorValue,
+                                             LoadedMainBaseLayoutDescriptorValue),
+              SuccessValue, "An unknown spawn should miss the cache.");
+
+        ReaderCacheValue.StoreLayout(OtherSpawnKeyValue, FRampWallDescriptor(), MainBaseLayoutDescriptorValue);
+        Check(ReaderCacheValue.SaveToFile(CachePathValue), SuccessValue,
+              "A cache with mapped and stored entries should be written back.");
+        FBuildPlacementSlotCache MergedCacheValue;
+        Check(MergedCacheValue.LoadFromFile(CachePathValue) && MergedCacheValue.GetEntryCount() == 2U, SuccessValue,
+              "Rewriting the cache should keep the mapped entry next to the new one.");
+        Check(MergedCacheValue.TryGetLayout(KeyValue, LoadedRampWallDescriptorValue,
+                                            LoadedMainBaseLayoutDescriptorValue) &&
+                  LoadedRampWallDescriptorValue.bIsValid,
+              SuccessValue, "The original entry should still be readable after a rewrite.");
+    }
+
+    std::cout << "  Checking slot cache layout versions..." << std::endl;
+    {
+        FBuildPlacementSlotCache WriterCacheValue(FBuildPlacementSlotCache::CurrentLayoutVersionValue + 1U);
+        WriterCacheValue.StoreLayout(KeyValue, RampWallDescriptorValue, MainBaseLayoutDescriptorValue);
+        Check(WriterCacheValue.SaveToFile(CachePathValue), SuccessValue,
+              "A slot cache from another layout version should be written.");
+
+        FBuildPlacementSlotCache ReaderCacheValue;
+        FRampWallDescriptor LoadedRampWallDescriptorValue;
+        FMainBaseLayoutDescriptor LoadedMainBaseLayoutDescriptorValue;
+        Check(!ReaderCacheValue.LoadFromFile(CachePathValue) && ReaderCacheValue.GetEntryCount() == 0U &&
+                  !ReaderCacheValue.TryGetLayout(KeyValue, LoadedRampWallDescriptorValue,
+                                                 LoadedMainBaseLayoutDescriptorValue),
+              SuccessValue, "Layouts resolved by another layout version should miss the cache.");
+    }
+
+    std::cout << "  Checking foreign slot cache files..." << std::endl;
+    {
+        {
+            std::ofstream OutputStreamValue(CachePathValue, std::ios::binary | std::ios::trunc);
+            OutputStreamValue << "not a placement slot cache";
+        }
+
+        FBuildPlacementSlotCache ForeignCacheValue;
+        Check(!ForeignCacheValue.LoadFromFile(CachePathValue) && ForeignCacheValue.GetEntryCount() == 0U,
+              SuccessValue, "A foreign file should be ignored.");
+
+        FBuildPlacementSlotCache WriterCacheValue;
+        WriterCacheValue.StoreLayout(KeyValue, RampWallDescriptorValue, MainBaseLayoutDescriptorValue);
+        Check(WriterCacheValue.SaveToFile(CachePathValue), SuccessValue, "A slot cache should be written.");
+        {
+            // The entry count follows the magic, format, reserved and layout version fields.
+            std::fstream PatchStreamValue(CachePathValue, std::ios::binary | std::ios::in | std::ios::out);
+            const uint32_t OversizedEntryCountValue = 0xFFFFFFFFU;
+            PatchStreamValue.seekp(12);
+            PatchStreamValue.write(reinterpret_cast<const char*>(&OversizedEntryCountValue),
+                                   sizeof(OversizedEntryCountValue));
+        }
+
+        FBuildPlacementSlotCache OversizedCacheValue;
+        Check(!OversizedCacheValue.LoadFromFile(CachePathValue) && OversizedCacheValue.GetEntryCount() == 0U,
+              SuccessValue, "A valid header with more entries than the file can hold should be ignored.");
+
+        FBuildPlacementSlotCache MissingCacheValue;
+        std::remove(CachePathValue.c_str());
+        Check(!MissingCacheValue.LoadFromFile(CachePathValue), SuccessValue, "A missing file should be ignored.");
+    }
+
+    std::remove(CachePathValue.c_str());
+    return SuccessValue;
+}
+
+}  // namespace sc2
@@ -656,6 +656,105 @@ bool TestCommandAuthorityScheduling(int ArgC, char** ArgV)
               "Compaction should remove unseeded aborted opening work.");
     }
 
+    {
+        FCommandAuthoritySchedulingState IncrementalSchedulingStateValue;
+        FCommandOrderRecord FirstStrategicOrderValue = FCommandOrderRecord::CreateNoTarget(
+            ECommandAuthorityLayer::StrategicDirector, NullTag, ABILITY_ID::INVALID, 100, EIntentDomain::Recovery, 50U);
+        FirstStrategicOrderValue.PriorityTier = ECommandPriorityTier::Normal;
+        FirstStrategicOrderValue.EffectivePriorityValue = 100;
+        FirstStrategicOrderValue.SourceGoalId = 31U;
+        const uint32_t FirstStrategicOrderIdValue =
+            IntentSchedulingServiceValue.SubmitOrder(IncrementalSchedulingStateValue, FirstStrategicOrderValue);
+
+        FCommandOrderRecord SecondStrategicOrderValue = FirstStrategicOrderValue;
+        SecondStrategicOrderValue.EffectivePriorityValue = 200;
+        SecondStrategicOrderValue.SourceGoalId = 32U;
+        const uint32_t SecondStrategicOrderIdValue =
+            IntentSchedulingServiceValue.SubmitOrder(IncrementalSchedulingStateValue, SecondStrategicOrderValue);
+
+        const uint32_t FirstUnitOrderIdValue = IntentSchedulingServiceValue.SubmitOrder(
+            IncrementalSchedulingStateValue,
+            FCommandOrderRecord::CreatePointTarget(ECommandAuthorityLayer::UnitExecution, 951U,
+                                                   ABILITY_ID::MOVE_MOVE, Point2D(30.0f, 30.0f), 80,
+                                                   EIntentDomain::ArmyCombat, 51U, 0U, FirstStrategicOrderIdValue,
+                                                   0, 0, false, false, false));
+        const uint32_t SecondUnitOrderIdValue = IntentSchedulingServiceValue.SubmitOrder(
+            IncrementalSchedulingStateValue,
+            FCommandOrderRecord::CreatePointTarget(ECommandAuthorityLayer::UnitExecution, 951U,
+                                                   ABILITY_ID::ATTACK_ATTACK, Point2D(32.0f, 32.0f), 90,
+                                                   EIntentDomain::ArmyCombat, 52U, 0U, FirstStrategicOrderIdValue,
+                                                   0, 0, false, false, false));
+
+        size_t FirstStrategicOrderIndexValue = 0U;
+        size_t SecondStrategicOrderIndexValue = 0U;
+        size_t FirstUnitOrderIndexValue = 0U;
+        size_t SecondUnitOrderIndexValue = 0U;
+        IncrementalSchedulingStateValue.TryGetOrderIndex(FirstStrategicOrderIdValue, FirstStrategicOrderIndexValue);
+        IncrementalSchedulingStateValue.TryGetOrderIndex(SecondStrategicOrderIdValue, SecondStrategicOrderIndexValue);
+        IncrementalSchedulingStateValue.TryGetOrderIndex(FirstUnitOrderIdValue, FirstUnitOrderIndexValue);
+        IncrementalSchedulingStateValue.TryGetOrderIndex(SecondUnitOrderIdValue, SecondUnitOrderIndexValue);
+
+        Check(!IncrementalSchedulingStateValue.bDerivedQueuesDirty, SuccessValue,
+              "Unbatched submissions should keep derived queues current.");
+        Check(IncrementalSchedulingStateValue.StrategicOrderIndices.front() == SecondStrategicOrderIndexValue,
+              SuccessValue, "Incremental insertion should place higher effective priority strategic work first.");
+        Check(IncrementalSchedulingStateValue.HasConsistentDerivedQueues(), SuccessValue,
+              "Incremental insertion should match a full derived-queue rebuild.");
+
+        Check(IncrementalSchedulingStateValue.SetOrderPriorityByIndex(FirstStrategicOrderIndexValue, 300,
+                                                                      ECommandPriorityTier::Normal),
+              SuccessValue, "Priority updates by index should accept stored orders.");
+        Check(IncrementalSchedulingStateValue.StrategicOrderIndices.front() == FirstStrategicOrderIndexValue,
+              SuccessValue, "A priority raise should move the order ahead within its tier bucket.");
+        Check(IncrementalSchedulingStateValue.SetOrderPriorityByIndex(SecondStrategicOrderIndexValue, 50,
+                                                                      ECommandPriorityTier::Critical),
+              SuccessValue, "Priority updates by index should accept tier changes.");
+        Check(IncrementalSchedulingStateValue.StrategicQueues[GetCommandPriorityTierIndex(
+                  ECommandPriorityTier::Critical)].size() == 1U,
+              SuccessValue, "A tier change should move the order into the new tier bucket.");
+        Check(IncrementalSchedulingStateValue.StrategicOrderIndices.front() == SecondStrategicOrderIndexValue,
+              SuccessValue, "Critical-tier strategic work should lead the flattened strategic view.");
+        Check(!IncrementalSchedulingStateValue.SetOrderPriorityByIndex(IncrementalSchedulingStateValue.GetOrderCount(),
+                                                                       0, ECommandPriorityTier::Low),
+              SuccessValue, "Priority updates by index should reject out-of-range orders.");
+
+        size_t ActiveExecutionOrderIndexValue = 0U;
+        Check(IncrementalSchedulingStateValue.TryGetActiveExecutionOrderIndexForActor(951U,
+                                                                                      ActiveExecutionOrderIndexValue) &&
+                  ActiveExecutionOrderIndexValue == FirstUnitOrderIndexValue,
+              SuccessValue, "The actor index should resolve to the earliest active execution order.");
+
+        IncrementalSchedulingStateValue.BeginMutationBatch();
+        IncrementalSchedulingStateValue.SetOrderLifecycleState(FirstUnitOrderIdValue, EOrderLifecycleState::Completed);
+        IncrementalSchedulingStateValue.SetOrderLifecycleState(SecondUnitOrderIdValue, EOrderLifecycleState::Ready);
+        Check(IncrementalSchedulingStateValue.ReadyIntentIndices.empty(), SuccessValue,
+              "Batched lifecycle moves should stay deferred until the batch ends.");
+        IncrementalSchedulingStateValue.EndMutationBatch();
+
+        Check(IncrementalSchedulingStateValue.ReadyIntentIndices.size() == 1U &&
+                  IncrementalSchedulingStateValue.ReadyIntentIndices.front() == SecondUnitOrderIndexValue,
+              SuccessValue, "Ending a batch should move the ready order into the ready-intent view.");
+        Check(IncrementalSchedulingStateValue.CompletedOrderIndices.size() == 1U, SuccessValue,
+              "Ending a batch should move the completed order into the completed view.");
+        Check(IncrementalSchedulingStateValue.TryGetActiveExecutionOrderIndexForActor(951U,
+                                                                                      ActiveExecutionOrderIndexValue) &&
+                  ActiveExecutionOrderIndexValue == SecondUnitOrderIndexValue,
+              SuccessValue, "The actor index should fall through to the next active execution order.");
+        Check(IncrementalSchedulingStateValue.ProcessorState == EPlanningProcessorState::ReadyToDrain, SuccessValue,
+              "Incremental updates should refresh the processor state.");
+        Check(IncrementalSchedulingStateValue.HasConsistentDerivedQueues(), SuccessValue,
+              "Batched incremental updates should match a full derived-queue rebuild.");
+
+        IncrementalSchedulingStateValue.SetOrderLifecycleState(SecondUnitOrderIdValue, EOrderLifecycleState::Aborted);
+        Check(!IncrementalSchedulingStateValue.TryGetActiveExecutionOrderIndexForActor(951U,
+                                                                                       ActiveExecutionOrderIndexValue),
+              SuccessValue, "The actor index should drop the actor once no execution order is active.");
+        Check(IncrementalSchedulingStateValue.GetActiveOrderCountForLayer(ECommandAuthorityLayer::UnitExecution) == 0U,
+              SuccessValue, "Incremental updates should maintain active counts per layer.");
+        Check(IncrementalSchedulingStateValue.HasConsistentDerivedQueues(), SuccessValue,
+              "Terminal transitions should match a full derived-queue rebuild.");
+    }
+
     {
         FBlockedTaskRingBuffer BlockedTaskRingBufferValue;
         BlockedTaskRingBufferValue.Reset(2U);
@@ -0,0 +1,185 @@
+#include "test_connection_receive.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "s2clientprotocol/sc2api.pb.h"
+#include "sc2api/sc2_connection.h"
+
+namespace sc2
+{
+namespace
+{
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const char* MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+std::string MakeSerializedResponse(const size_t ResponseIndexValue)
+{
+    SC2APIProtocol::Response ResponseValue;
+    ResponseValue.set_status(SC2APIProtocol::Status::in_game);
+    ResponseValue.add_error(std::to_string(ResponseIndexValue));
+    return ResponseValue.SerializeAsString();
+}
+
+bool TestPooledResponsesRecycle()
+{
+    bool SuccessValue = true;
+
+    Connection ConnectionValue;
+    const std::string WireValue = MakeSerializedResponse(7U);
+
+    std::shared_ptr<const SC2APIProtocol::Response> RetainedResponse;
+    for (size_t IterationIndexValue = 0; IterationIndexValue < 32U; ++IterationIndexValue)
+    {
+        SC2APIProtocol::Response* ResponsePtr = ConnectionValue.AcquireResponse();
+        Check(ResponsePtr && ResponsePtr->error_size() == 0, SuccessValue,
+              "Acquired responses should start cleared.");
+        ResponsePtr->ParseFromArray(WireValue.data(), static_cast<int>(WireValue.size()));
+        ConnectionValue.PushResponse(ResponsePtr);
+
+        SC2APIProtocol::Response* ReceivedResponsePtr = nullptr;
+        Check(ConnectionValue.Receive(ReceivedResponsePtr, 1000U), SuccessValue,
+              "Receive should return a response that is already on the ring.");
+        Check(ReceivedResponsePtr == ResponsePtr, SuccessValue, "Receive should hand back the pushed response.");
+
+        // Keep the previous response alive the way an observation keeps its last response, then drop it.
+        RetainedResponse = ConnectionValue.AdoptResponse(ReceivedResponsePtr);
+    }
+    Check(RetainedResponse && RetainedResponse->error_size() == 1 && RetainedResponse->error(0) == "7", SuccessValue,
+          "Adopted responses should stay readable while referenced.");
+    Check(ConnectionValue.GetPooledResponseCount() == 2U, SuccessValue,
+          "With one retained response the pool should only need two slots.");
+
+    SC2APIProtocol::Response* HeapResponsePtr = new SC2APIProtocol::Response();
+    ConnectionValue.ReleaseResponse(HeapResponsePtr);
+    Check(ConnectionValue.GetPooledResponseCount() == 2U, SuccessValue,
+          "Releasing a response that did not come from the pool should not add a slot.");
+
+    return SuccessValue;
+}
+
+bool TestResponseRingHandoff()
+{
+    constexpr size_t ResponseCountValue = 512U;
+
+    bool SuccessValue = true;
+
+    Connection ConnectionValue;
+    std::vector<std::string> WireValues;
+    WireValues.reserve(ResponseCountValue);
+    for (size_t ResponseIndexValue = 0; ResponseIndexValue < ResponseCountValue; ++ResponseIndexValue)
+    {
+        WireValues.push_back(MakeSerializedResponse(ResponseIndexValue));
+    }
+
+    // The producer stands in for the civetweb thread and is allowed to run ahead of the receiver until the ring fills.
+    std::thread ProducerThread([&ConnectionValue, &WireValues]() {
+        for (const std::string& WireValue : WireValues)
+        {
+            SC2APIProtocol::Response* ResponsePtr = ConnectionValue.AcquireResponse();
+            ResponsePtr->ParseFromArray(WireValue.data(), static_cast<int>(WireValue.size()));
+            ConnectionValue.PushResponse(ResponsePtr);
+        }
+    });
+
+    bool bInOrderValue = true;
+    size_t ReceivedCountValue = 0U;
+    for (size_t ResponseIndexValue = 0; ResponseIndexValue < ResponseCountValue; ++ResponseIndexValue)
+    {
+        SC2APIProtocol::Response* ResponsePtr = nullptr;
+        if (!ConnectionValue.Receive(ResponsePtr, 5000U))
+        {
+            break;
+        }
+
+        ++ReceivedCountValue;
+        bInOrderValue = bInOrderValue && ResponsePtr->error_size() == 1 &&
+                        ResponsePtr->error(0) == std::to_string(ResponseIndexValue);
+        ConnectionValue.ReleaseResponse(ResponsePtr);
+    }
+    ProducerThread.join();
+
+    Check(ReceivedCountValue == ResponseCountValue, SuccessValue,
+          "Every pushed response should be received across threads.");
+    Check(bInOrderValue, SuccessValue, "The response ring should preserve push order.");
+    Check(!ConnectionValue.PollResponse(), SuccessValue, "The response ring should be empty once drained.");
+
+    SC2APIProtocol::Response* TimedOutResponsePtr = nullptr;
+    bool bTimeoutCalledValue = false;
+    ConnectionValue.SetTimeoutCallback([&bTimeoutCalledValue]() { bTimeoutCalledValue = true; });
+    Check(!ConnectionValue.Receive(TimedOutResponsePtr, 10U) && !TimedOutResponsePtr && bTimeoutCalledValue,
+          SuccessValue, "Receive should time out on an empty ring and run the timeout callback.");
+
+    return SuccessValue;
+}
+
+bool TestFullRingStopsOnDisconnect()
+{
+    // Matches the capacity of the connection's response ring.
+    constexpr size_t RingCapacityValue = 64U;
+
+    bool SuccessValue = true;
+
+    Connection ConnectionValue;
+    for (size_t ResponseIndexValue = 0; ResponseIndexValue < RingCapacityValue; ++ResponseIndexValue)
+    {
+        SC2APIProtocol::Response* ResponsePtr = ConnectionValue.AcquireResponse();
+        ConnectionValue.PushResponse(ResponsePtr);
+    }
+
+    SC2APIProtocol::Response* OverflowResponsePtr = ConnectionValue.AcquireResponse();
+    bool bPushedValue = true;
+    std::thread ProducerThread([&ConnectionValue, &OverflowResponsePtr, &bPushedValue]() {
+        bPushedValue = ConnectionValue.PushResponse(OverflowResponsePtr);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto DisconnectTimeValue = std::chrono::steady_clock::now();
+    ConnectionValue.Disconnect();
+    ProducerThread.join();
+    const auto WaitValue = std::chrono::steady_clock::now() - DisconnectTimeValue;
+
+    Check(!bPushedValue && !OverflowResponsePtr, SuccessValue,
+          "A push into a full ring should drop its response once the connection disconnects.");
+    Check(WaitValue < std::chrono::seconds(1), SuccessValue, "Disconnecting should release a producer right away.");
+    Check(ConnectionValue.GetPooledResponseCount() == RingCapacityValue + 1U, SuccessValue,
+          "The dropped response should go back to the pool.");
+
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestConnectionReceive(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking pooled response recycling..." << std::endl;
+    SuccessValue = TestPooledResponsesRecycle() && SuccessValue;
+
+    std::cout << "  Checking response ring handoff..." << std::endl;
+    SuccessValue = TestResponseRingHandoff() && SuccessValue;
+
+    std::cout << "  Checking full ring on disconnect..." << std::endl;
+    SuccessValue = TestFullRingStopsOnDisconnect() && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
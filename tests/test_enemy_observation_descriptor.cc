@@ -0,0 +1,285 @@
+#include "test_enemy_observation_descriptor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/descriptors/FEnemyObservationDescriptor.h"
+#include "common/descriptors/FTerranEnemyObservationBuilder.h"
+#include "sc2api/sc2_common.h"
+#include "sc2api/sc2_unit.h"
+
+namespace sc2
+{
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+using FSteadyTimePoint = FSteadyClock::time_point;
+
+constexpr uint64_t StaleGameLoopsValue = FEnemyObservationDescriptor::DefaultStaleEntryThresholdGameLoopsValue;
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const std::string& MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+uint64_t GetElapsedNanoseconds(const FSteadyTimePoint& StartTimeValue, const FSteadyTimePoint& EndTimeValue)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(EndTimeValue - StartTimeValue).count());
+}
+
+Unit MakeEnemyUnit(const Tag TagValue, const UNIT_TYPEID UnitTypeIdValue, const Point2D& PositionValue)
+{
+    Unit UnitValue;
+    UnitValue.display_type = Unit::DisplayType::Visible;
+    UnitValue.alliance = Unit::Alliance::Enemy;
+    UnitValue.tag = TagValue;
+    UnitValue.unit_type = UnitTypeIdValue;
+    UnitValue.pos = Point3D(PositionValue.x, PositionValue.y, 0.0f);
+    UnitValue.health = 100.0f;
+    UnitValue.health_max = 100.0f;
+    UnitValue.shield = 0.0f;
+    UnitValue.shield_max = 0.0f;
+    UnitValue.is_flying = UnitTypeIdValue == UNIT_TYPEID::ZERG_MUTALISK;
+    UnitValue.is_building = UnitTypeIdValue == UNIT_TYPEID::ZERG_HATCHERY;
+    return UnitValue;
+}
+
+UNIT_TYPEID GetEnemyUnitTypeForIndex(const size_t UnitIndexValue)
+{
+    switch (UnitIndexValue % 5U)
+    {
+        case 0U:
+            return UNIT_TYPEID::ZERG_ZERGLING;
+        case 1U:
+            return UNIT_TYPEID::ZERG_ROACH;
+        case 2U:
+            return UNIT_TYPEID::ZERG_MUTALISK;
+        case 3U:
+            return UNIT_TYPEID::ZERG_DRONE;
+        default:
+            return UNIT_TYPEID::ZERG_HATCHERY;
+    }
+}
+
+void PopulateEnemyUnits(const size_t UnitCountValue, const uint32_t SeedValue, std::vector<Unit>& OutUnitStorageValue)
+{
+    std::mt19937 RandomEngineValue(SeedValue);
+    std::uniform_real_distribution<float> CoordinateDistributionValue(10.0f, 190.0f);
+
+    OutUnitStorageValue.clear();
+    for (size_t UnitIndexValue = 0U; UnitIndexValue < UnitCountValue; ++UnitIndexValue)
+    {
+        const Point2D PositionValue(CoordinateDistributionValue(RandomEngineValue),
+                                    CoordinateDistributionValue(RandomEngineValue));
+        OutUnitStorageValue.push_back(
+            MakeEnemyUnit(5000U + UnitIndexValue, GetEnemyUnitTypeForIndex(UnitIndexValue), PositionValue));
+    }
+}
+
+// Returns the units in the window of VisibleCount starting at the step's offset, moving each by a quarter tile.
+Units SelectVisibleUnits(const uint64_t StepValue, const size_t VisibleCountValue, std::vector<Unit>& UnitStorageValue)
+{
+    Units VisibleUnitsValue;
+    const size_t UnitCountValue = UnitStorageValue.size();
+    const size_t WindowStartValue = static_cast<size_t>(StepValue * 7U) % UnitCountValue;
+    for (size_t VisibleIndexValue = 0U; VisibleIndexValue < VisibleCountValue; ++VisibleIndexValue)
+    {
+        Unit& UnitValue = UnitStorageValue[(WindowStartValue + VisibleIndexValue) % UnitCountValue];
+        if (!UnitValue.is_building)
+        {
+            UnitValue.pos.x = UnitValue.pos.x >= 189.0f ? 11.0f : UnitValue.pos.x + 0.25f;
+        }
+        VisibleUnitsValue.push_back(&UnitValue);
+    }
+    return VisibleUnitsValue;
+}
+
+bool HaveEqualSummaries(const FEnemyCompositionSummary& LeftSummaryValue,
+                        const FEnemyCompositionSummary& RightSummaryValue)
+{
+    return LeftSummaryValue.TotalUnitCount == RightSummaryValue.TotalUnitCount &&
+           LeftSummaryValue.GroundUnitCount == RightSummaryValue.GroundUnitCount &&
+           LeftSummaryValue.AirUnitCount == RightSummaryValue.AirUnitCount &&
+           LeftSummaryValue.StructureCount == RightSummaryValue.StructureCount &&
+           LeftSummaryValue.WorkerCount == RightSummaryValue.WorkerCount &&
+           LeftSummaryValue.CombatUnitCount == RightSummaryValue.CombatUnitCount &&
+           LeftSummaryValue.EstimatedArmySupply == RightSummaryValue.EstimatedArmySupply &&
+           LeftSummaryValue.HasArmyCentroid == RightSummaryValue.HasArmyCentroid &&
+           LeftSummaryValue.ArmyCentroid == RightSummaryValue.ArmyCentroid;
+}
+
+bool TestIncrementalSummaryMatchesRebuild()
+{
+    bool SuccessValue = true;
+    FTerranEnemyObservationBuilder EnemyObservationBuilderValue;
+    FEnemyObservationDescriptor EnemyObservationDescriptorValue;
+    std::vector<Unit> UnitStorageValue;
+    PopulateEnemyUnits(400U, 11U, UnitStorageValue);
+
+    for (uint64_t StepValue = 0U; StepValue < 400U; ++StepValue)
+    {
+        const uint64_t GameLoopValue = StepValue * 16U;
+        const Units VisibleUnitsValue = SelectVisibleUnits(StepValue, 48U, UnitStorageValue);
+        EnemyObservationBuilderValue.UpdateEnemyObservation(VisibleUnitsValue, GameLoopValue,
+                                                            EnemyObservationDescriptorValue);
+
+        FEnemyObservationDescriptor RebuiltDescriptorValue = EnemyObservationDescriptorValue;
+        RebuiltDescriptorValue.RebuildCompositionSummary();
+        if (!Check(HaveEqualSummaries(EnemyObservationDescriptorValue.CompositionSummary,
+                                      RebuiltDescriptorValue.CompositionSummary),
+                   SuccessValue, "Incremental composition summary should match a full rebuild at step " +
+                                     std::to_string(StepValue) + "."))
+        {
+            break;
+        }
+
+        bool bOnlyFreshEntriesValue = true;
+        for (size_t EntryIndexValue = 0U; EntryIndexValue < EnemyObservationDescriptorValue.GetObservedUnitCount();
+             ++EntryIndexValue)
+        {
+            bOnlyFreshEntriesValue =
+                bOnlyFreshEntriesValue &&
+                EnemyObservationDescriptorValue.LastSeenGameLoops[EntryIndexValue] + StaleGameLoopsValue >=
+                    GameLoopValue;
+        }
+        Check(bOnlyFreshEntriesValue, SuccessValue, "Pruning should remove every entry older than the threshold.");
+    }
+
+    Check(EnemyObservationDescriptorValue.HasSynchronizedSizes(), SuccessValue,
+          "Enemy observation columns, tag index and last seen heap should stay synchronized.");
+    return SuccessValue;
+}
+
+bool TestPruneKeepsResightedUnits()
+{
+    bool SuccessValue = true;
+    FEnemyObservationDescriptor EnemyObservationDescriptorValue;
+    const Unit FirstUnitValue = MakeEnemyUnit(1U, UNIT_TYPEID::ZERG_ROACH, Point2D(50.0f, 50.0f));
+    const Unit SecondUnitValue = MakeEnemyUnit(2U, UNIT_TYPEID::ZERG_ZERGLING, Point2D(60.0f, 60.0f));
+    Unit SnapshotUnitValue = MakeEnemyUnit(3U, UNIT_TYPEID::ZERG_HATCHERY, Point2D(100.0f, 100.0f));
+
+    EnemyObservationDescriptorValue.AddOrUpdateUnit(FirstUnitValue, 0U);
+    EnemyObservationDescriptorValue.AddOrUpdateUnit(SecondUnitValue, 0U);
+    EnemyObservationDescriptorValue.AddOrUpdateUnit(SnapshotUnitValue, 0U);
+    SnapshotUnitValue.display_type = Unit::DisplayType::Snapshot;
+    SnapshotUnitValue.health = 1.0f;
+    EnemyObservationDescriptorValue.AddOrUpdateUnit(FirstUnitValue, 600U);
+    EnemyObservationDescriptorValue.AddOrUpdateUnit(SnapshotUnitValue, 600U);
+    EnemyObservationDescriptorValue.PruneStaleEntries(700U, StaleGameLoopsValue);
+
+    Check(EnemyObservationDescriptorValue.GetObservedUnitCount() == 2U, SuccessValue,
+          "Pruning should drop only the unit that was not seen again.");
+    Check(EnemyObservationDescriptorValue.CompositionSummary.TotalUnitCount == 2U &&
+              EnemyObservationDescriptorValue.CompositionSummary.StructureCount == 1U &&
+              EnemyObservationDescriptorValue.CompositionSummary.GroundUnitCount == 1U,
+          SuccessValue, "Pruning should remove the dropped unit from the composition summary.");
+
+    bool bSnapshotKeptLastSeenStateValue = false;
+    for (size_t EntryIndexValue = 0U; EntryIndexValue < EnemyObservationDescriptorValue.GetObservedUnitCount();
+         ++EntryIndexValue)
+    {
+        if (EnemyObservationDescriptorValue.UnitTags[EntryIndexValue] == SnapshotUnitValue.tag)
+        {
+            bSnapshotKeptLastSeenStateValue =
+                EnemyObservationDescriptorValue.LastSeenHealth[EntryIndexValue] == 100.0f &&
+                EnemyObservationDescriptorValue.LastSeenGameLoops[EntryIndexValue] == 600U;
+        }
+    }
+    Check(bSnapshotKeptLastSeenStateValue, SuccessValue,
+          "Snapshots of known units should refresh the last seen loop without overwriting the last seen state.");
+
+    EnemyObservationDescriptorValue.PruneStaleEntries(1300U, StaleGameLoopsValue);
+    Check(EnemyObservationDescriptorValue.GetObservedUnitCount() == 0U &&
+              EnemyObservationDescriptorValue.CompositionSummary.TotalUnitCount == 0U &&
+              !EnemyObservationDescriptorValue.CompositionSummary.HasArmyCentroid,
+          SuccessValue, "Pruning every entry should leave an empty summary.");
+    Check(EnemyObservationDescriptorValue.HasSynchronizedSizes(), SuccessValue,
+          "Pruning should keep the tag index and last seen heap synchronized with the columns.");
+    return SuccessValue;
+}
+
+bool TestEnemyObservationUpdateProfile()
+{
+    bool SuccessValue = true;
+    constexpr size_t VisibleCountValue = 40U;
+    constexpr uint64_t StepCountValue = 2000U;
+    const std::vector<size_t> RememberedCountsValue = {100U, 300U, 1000U};
+
+    for (const size_t RememberedCountValue : RememberedCountsValue)
+    {
+        FTerranEnemyObservationBuilder EnemyObservationBuilderValue;
+        FEnemyObservationDescriptor EnemyObservationDescriptorValue;
+        std::vector<Unit> UnitStorageValue;
+        PopulateEnemyUnits(RememberedCountValue, 23U, UnitStorageValue);
+        for (const Unit& UnitValue : UnitStorageValue)
+        {
+            EnemyObservationDescriptorValue.AddOrUpdateUnit(UnitValue, 0U);
+        }
+
+        uint64_t IncrementalNanosecondsValue = 0U;
+        uint64_t RebuildNanosecondsValue = 0U;
+        for (uint64_t StepValue = 1U; StepValue <= StepCountValue; ++StepValue)
+        {
+            // A window of visible units plus a remembered set that is re-seen often enough to stay in memory.
+            const uint64_t GameLoopValue = StepValue;
+            const Units VisibleUnitsValue = SelectVisibleUnits(StepValue, VisibleCountValue, UnitStorageValue);
+            const FSteadyTimePoint IncrementalStartTimeValue = FSteadyClock::now();
+            EnemyObservationBuilderValue.UpdateEnemyObservation(VisibleUnitsValue, GameLoopValue,
+                                                                EnemyObservationDescriptorValue);
+            const FSteadyTimePoint IncrementalEndTimeValue = FSteadyClock::now();
+            IncrementalNanosecondsValue += GetElapsedNanoseconds(IncrementalStartTimeValue, IncrementalEndTimeValue);
+
+            const FSteadyTimePoint RebuildStartTimeValue = FSteadyClock::now();
+            EnemyObservationDescriptorValue.RebuildCompositionSummary();
+            const FSteadyTimePoint RebuildEndTimeValue = FSteadyClock::now();
+            RebuildNanosecondsValue += GetElapsedNanoseconds(RebuildStartTimeValue, RebuildEndTimeValue);
+        }
+
+        Check(EnemyObservationDescriptorValue.HasSynchronizedSizes(), SuccessValue,
+              "Profiled enemy observation columns should stay synchronized.");
+        std::cout << "    Remembered=" << RememberedCountValue
+                  << " | Tracked=" << EnemyObservationDescriptorValue.GetObservedUnitCount()
+                  << " | VisiblePerStep=" << VisibleCountValue
+                  << " | AvgUpdateNs=" << IncrementalNanosecondsValue / StepCountValue
+                  << " | AvgSummaryRebuildNs=" << RebuildNanosecondsValue / StepCountValue << std::endl;
+    }
+
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestEnemyObservationDescriptor(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking incremental composition summaries against full rebuilds..." << std::endl;
+    SuccessValue = TestIncrementalSummaryMatchesRebuild() && SuccessValue;
+
+    std::cout << "  Checking heap-driven stale entry pruning..." << std::endl;
+    SuccessValue = TestPruneKeepsResightedUnits() && SuccessValue;
+
+    std::cout << "  Profiling enemy observation updates..." << std::endl;
+    SuccessValue = TestEnemyObservationUpdateProfile() && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
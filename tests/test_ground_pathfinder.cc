@@ -0,0 +1,504 @@
+#include "test_ground_pathfinder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/spatial/FGroundPathfinder.h"
+#include "sc2api/sc2_map_info.h"
+#include "sc2api/sc2_unit.h"
+
+namespace sc2
+{
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+
+constexpr float UnreachableDistanceValue = std::numeric_limits<float>::max();
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const std::string& MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+// Row-major walkability with y pointing north, packed into a 1 bpp pathing image.
+struct FTestGrid
+{
+    int32_t Width = 0;
+    int32_t Height = 0;
+    std::vector<uint8_t> WalkableCells;
+
+    bool IsWalkable(const int32_t XValue, const int32_t YValue) const
+    {
+        return XValue >= 0 && YValue >= 0 && XValue < Width && YValue < Height &&
+               WalkableCells[static_cast<size_t>(XValue + YValue * Width)] != 0U;
+    }
+};
+
+FTestGrid MakeOpenGrid(const int32_t WidthValue, const int32_t HeightValue)
+{
+    FTestGrid GridValue;
+    GridValue.Width = WidthValue;
+    GridValue.Height = HeightValue;
+    GridValue.WalkableCells.assign(static_cast<size_t>(WidthValue * HeightValue), 1U);
+    return GridValue;
+}
+
+// Open ground scattered with blocked rectangles, so paths bend around obstacles across many clusters.
+FTestGrid MakeObstacleGrid(const int32_t WidthValue, const int32_t HeightValue, const uint32_t SeedValue)
+{
+    FTestGrid GridValue = MakeOpenGrid(WidthValue, HeightValue);
+    std::mt19937 RandomEngineValue(SeedValue);
+    std::uniform_int_distribution<int32_t> XDistributionValue(0, WidthValue - 1);
+    std::uniform_int_distribution<int32_t> YDistributionValue(0, HeightValue - 1);
+    std::uniform_int_distribution<int32_t> ExtentDistributionValue(1, 9);
+    for (int32_t ObstacleIndexValue = 0; ObstacleIndexValue < 90; ++ObstacleIndexValue)
+    {
+        const int32_t MinXValue = XDistributionValue(RandomEngineValue);
+        const int32_t MinYValue = YDistributionValue(RandomEngineValue);
+        const int32_t ExtentXValue = ExtentDistributionValue(RandomEngineValue);
+        const int32_t ExtentYValue = ExtentDistributionValue(RandomEngineValue);
+        for (int32_t YValue = MinYValue; YValue < std::min(HeightValue, MinYValue + ExtentYValue); ++YValue)
+        {
+            for (int32_t XValue = MinXValue; XValue < std::min(WidthValue, MinXValue + ExtentXValue); ++XValue)
+            {
+                GridValue.WalkableCells[static_cast<size_t>(XValue + YValue * WidthValue)] = 0U;
+            }
+        }
+    }
+    return GridValue;
+}
+
+MapGrids MakeMapGrids(const FTestGrid& GridValue)
+{
+    GameInfo GameInfoValue;
+    GameInfoValue.width = GridValue.Width;
+    GameInfoValue.height = GridValue.Height;
+    GameInfoValue.pathing_grid.width = GridValue.Width;
+    GameInfoValue.pathing_grid.height = GridValue.Height;
+    GameInfoValue.pathing_grid.bits_per_pixel = 1;
+    const size_t CellCountValue = GridValue.WalkableCells.size();
+    GameInfoValue.pathing_grid.data.assign((CellCountValue + 7U) / 8U, '\0');
+    for (size_t CellIndexValue = 0U; CellIndexValue < CellCountValue; ++CellIndexValue)
+    {
+        if (GridValue.WalkableCells[CellIndexValue] != 0U)
+        {
+            GameInfoValue.pathing_grid.data[CellIndexValue / 8U] |= static_cast<char>(0x80U >> (CellIndexValue % 8U));
+        }
+    }
+    GameInfoValue.placement_grid = GameInfoValue.pathing_grid;
+
+    MapGrids MapGridsValue;
+    MapGridsValue.DecodeGameInfo(GameInfoValue);
+    return MapGridsValue;
+}
+
+// Reference octile Dijkstra over the whole grid with no corner cutting.
+std::vector<float> GetExactDistances(const FTestGrid& GridValue, const int32_t SourceXValue, const int32_t SourceYValue)
+{
+    static const int32_t StepOffsetsValue[8][2] = {{1, 0}, {-1, 0}, {0, 1},  {0, -1},
+                                                   {1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+    using FQueueEntry = std::pair<float, int32_t>;
+    std::vector<float> DistancesValue(GridValue.WalkableCells.size(), UnreachableDistanceValue);
+    std::priority_queue<FQueueEntry, std::vector<FQueueEntry>, std::greater<FQueueEntry>> PendingCellsValue;
+    const int32_t SourceCellValue = SourceXValue + SourceYValue * GridValue.Width;
+    DistancesValue[static_cast<size_t>(SourceCellValue)] = 0.0f;
+    PendingCellsValue.emplace(0.0f, SourceCellValue);
+    while (!PendingCellsValue.empty())
+    {
+        const FQueueEntry EntryValue = PendingCellsValue.top();
+        PendingCellsValue.pop();
+        if (EntryValue.first > DistancesValue[static_cast<size_t>(EntryValue.second)])
+        {
+            continue;
+        }
+
+        const int32_t XValue = EntryValue.second % GridValue.Width;
+        const int32_t YValue = EntryValue.second / GridValue.Width;
+        for (const auto& StepOffsetValue : StepOffsetsValue)
+        {
+            const int32_t NeighborXValue = XValue + StepOffsetValue[0];
+            const int32_t NeighborYValue = YValue + StepOffsetValue[1];
+            const bool bDiagonalValue = StepOffsetValue[0] != 0 && StepOffsetValue[1] != 0;
+            if (!GridValue.IsWalkable(NeighborXValue, NeighborYValue) ||
+                (bDiagonalValue &&
+                 (!GridValue.IsWalkable(NeighborXValue, YValue) || !GridValue.IsWalkable(XValue, NeighborYValue))))
+            {
+                continue;
+            }
+
+            const float CandidateDistanceValue = EntryValue.first + (bDiagonalValue ? 1.41421356f : 1.0f);
+            const int32_t NeighborCellValue = NeighborXValue + NeighborYValue * GridValue.Width;
+            if (CandidateDistanceValue < DistancesValue[static_cast<size_t>(NeighborCellValue)])
+            {
+                DistancesValue[static_cast<size_t>(NeighborCellValue)] = CandidateDistanceValue;
+                PendingCellsValue.emplace(CandidateDistanceValue, NeighborCellValue);
+            }
+        }
+    }
+    return DistancesValue;
+}
+
+Point2D GetCellCenter(const int32_t XValue, const int32_t YValue)
+{
+    return Point2D(static_cast<float>(XValue) + 0.5f, static_cast<float>(YValue) + 0.5f);
+}
+
+Unit MakeStructure(const Tag TagValue, const UNIT_TYPEID UnitTypeIdValue, const Point2D& PositionValue,
+                   const float RadiusValue)
+{
+    Unit UnitValue;
+    UnitValue.display_type = Unit::Visible;
+    UnitValue.alliance = Unit::Alliance::Self;
+    UnitValue.tag = TagValue;
+    UnitValue.unit_type = UnitTypeIdValue;
+    UnitValue.pos = Point3D(PositionValue.x, PositionValue.y, 0.0f);
+    UnitValue.radius = RadiusValue;
+    UnitValue.build_progress = 1.0f;
+    UnitValue.is_flying = false;
+    UnitValue.is_building = true;
+    UnitValue.is_alive = true;
+    return UnitValue;
+}
+
+}  // namespace
+
+bool TestGroundPathfinder(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking hierarchical distances against an exact search..." << std::endl;
+    {
+        const FTestGrid GridValue = MakeObstacleGrid(100, 90, 7U);
+        FGroundPathfinder GroundPathfinderValue;
+        GroundPathfinderValue.Initialize(MakeMapGrids(GridValue));
+
+        std::mt19937 RandomEngineValue(19U);
+        std::uniform_int_distribution<int32_t> XDistributionValue(0, GridValue.Width - 1);
+        std::uniform_int_distribution<int32_t> YDistributionValue(0, GridValue.Height - 1);
+        uint32_t PairCountValue = 0U;
+        uint32_t ReachabilityMismatchCountValue = 0U;
+        float WorstRatioValue = 1.0f;
+        uint64_t QueryNanosecondsValue = 0U;
+        while (PairCountValue < 200U)
+        {
+            const int32_t StartXValue = XDistributionValue(RandomEngineValue);
+            const int32_t StartYValue = YDistributionValue(RandomEngineValue);
+            const int32_t EndXValue = XDistributionValue(RandomEngineValue);
+            const int32_t EndYValue = YDistributionValue(RandomEngineValue);
+            if (!GridValue.IsWalkable(StartXValue, StartYValue) || !GridValue.IsWalkable(EndXValue, EndYValue) ||
+                (StartXValue == EndXValue && StartYValue == EndYValue))
+            {
+                continue;
+            }
+
+            ++PairCountValue;
+            const float ExactDistanceValue = GetExactDistances(GridValue, StartXValue, StartYValue)[static_cast<size_t>(
+                EndXValue + EndYValue * GridValue.Width)];
+            const FSteadyClock::time_point StartTimeValue = FSteadyClock::now();
+            const float LocalDistanceValue = GroundPathfinderValue.GetDistance(GetCellCenter(StartXValue, StartYValue),
+                                                                               GetCellCenter(EndXValue, EndYValue));
+            QueryNanosecondsValue += static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(FSteadyClock::now() - StartTimeValue).count());
+            if ((ExactDistanceValue == UnreachableDistanceValue) != (LocalDistanceValue == 0.0f))
+            {
+                ++ReachabilityMismatchCountValue;
+                continue;
+            }
+            if (ExactDistanceValue != UnreachableDistanceValue)
+            {
+                Check(LocalDistanceValue >= ExactDistanceValue - 0.001f, SuccessValue,
+                      "A hierarchical distance should never be shorter than the exact distance.");
+                WorstRatioValue = std::max(WorstRatioValue, LocalDistanceValue / ExactDistanceValue);
+            }
+        }
+
+        Check(ReachabilityMismatchCountValue == 0U, SuccessValue,
+              "Hierarchical and exact searches should agree on reachability.");
+        Check(WorstRatioValue <= 1.1f, SuccessValue, "Hierarchical distances should stay within 10% of exact.");
+        std::cout << "    Pairs=" << PairCountValue << " | WorstRatio=" << WorstRatioValue
+                  << " | AvgQueryUs=" << static_cast<double>(QueryNanosecondsValue) / PairCountValue / 1000.0
+                  << std::endl;
+    }
+
+    std::cout << "  Checking structure overlay invalidation..." << std::endl;
+    {
+        // A wall at x = 32 with a four-cell gap at y 30..33.
+        FTestGrid GridValue = MakeOpenGrid(64, 64);
+        for (int32_t YValue = 0; YValue < GridValue.Height; ++YValue)
+        {
+            if (YValue < 30 || YValue > 33)
+            {
+                GridValue.WalkableCells[static_cast<size_t>(32 + YValue * GridValue.Width)] = 0U;
+            }
+        }
+
+        FGroundPathfinder GroundPathfinderValue;
+        GroundPathfinderValue.Initialize(MakeMapGrids(GridValue));
+        const Point2D WestPointValue = GetCellCenter(10, 31);
+        const Point2D EastPointValue = GetCellCenter(50, 31);
+        Check(std::abs(GroundPathfinderValue.GetDistance(WestPointValue, EastPointValue) - 40.0f) < 0.001f,
+              SuccessValue, "The path through the gap should be straight.");
+        const uint32_t InitialRebuildCountValue = GroundPathfinderValue.GetClusterRebuildCount();
+
+        // A town hall over the gap closes it; a lowered depot elsewhere does not count.
+        std::vector<Unit> StructureStorageValue = {
+            MakeStructure(1U, UNIT_TYPEID::TERRAN_COMMANDCENTER, Point2D(32.5f, 31.5f), 2.75f),
+            MakeStructure(2U, UNIT_TYPEID::TERRAN_SUPPLYDEPOTLOWERED, Point2D(20.0f, 20.0f), 1.0f)};
+        Units BlockingUnitsValue;
+        for (const Unit& StructureValue : StructureStorageValue)
+        {
+            BlockingUnitsValue.push_back(&StructureValue);
+        }
+        GroundPathfinderValue.UpdateStructures(BlockingUnitsValue);
+        Check(!GroundPathfinderValue.IsWalkable(32, 31) && GroundPathfinderValue.IsWalkable(20, 20), SuccessValue,
+              "Only the raised structure footprint should block pathing.");
+        Check(GroundPathfinderValue.GetDistance(WestPointValue, EastPointValue) == 0.0f, SuccessValue,
+              "A closed gap should make the far side unreachable.");
+        const uint32_t BlockRebuildCountValue =
+            GroundPathfinderValue.GetClusterRebuildCount() - InitialRebuildCountValue;
+        Check(BlockRebuildCountValue > 0U && BlockRebuildCountValue < InitialRebuildCountValue, SuccessValue,
+              "A new structure should rebuild only the clusters around its footprint.");
+
+        GroundPathfinderValue.UpdateStructures(BlockingUnitsValue);
+        Check(GroundPathfinderValue.GetDistance(WestPointValue, EastPointValue) == 0.0f &&
+                  GroundPathfinderValue.GetClusterRebuildCount() - InitialRebuildCountValue == BlockRebuildCountValue,
+              SuccessValue, "Unchanged structures should not touch the abstract graph.");
+
+        GroundPathfinderValue.UpdateStructures(Units());
+        Check(std::abs(GroundPathfinderValue.GetDistance(WestPointValue, EastPointValue) - 40.0f) < 0.001f,
+              SuccessValue, "A destroyed structure should reopen the gap.");
+        std::cout << "    InitialClusterRebuilds=" << InitialRebuildCountValue
+                  << " | StructureClusterRebuilds=" << BlockRebuildCountValue << std::endl;
+    }
+
+    std::cout << "  Checking flow fields and batched queries..." << std::endl;
+    {
+        const FTestGrid GridValue = MakeObstacleGrid(96, 96, 23U);
+        FGroundPathfinder GroundPathfinderValue;
+        GroundPathfinderValue.Initialize(MakeMapGrids(GridValue));
+
+        int32_t DestinationXValue = 48;
+        int32_t DestinationYValue = 48;
+        while (!GridValue.IsWalkable(DestinationXValue, DestinationYValue))
+        {
+            ++DestinationXValue;
+        }
+        const Point2D DestinationPointValue = GetCellCenter(DestinationXValue, DestinationYValue);
+        const std::vector<float> ExactDistancesValue =
+            GetExactDistances(GridValue, DestinationXValue, DestinationYValue);
+
+        std::vector<QueryInterface::PathingQuery> QueriesValue;
+        bool bFlowFieldMatchesValue = true;
+        bool bStepsDescendValue = true;
+        for (int32_t YValue = 0; YValue < GridValue.Height; YValue += 7)
+        {
+            for (int32_t XValue = 0; XValue < GridValue.Width; XValue += 7)
+            {
+                if (!GridValue.IsWalkable(XValue, YValue))
+                {
+                    continue;
+                }
+
+                const float ExactDistanceValue = ExactDistancesValue[static_cast<size_t>(XValue + YValue * 96)];
+                const float ExpectedDistanceValue =
+                    ExactDistanceValue == UnreachableDistanceValue ? 0.0f : ExactDistanceValue;
+                const Point2D StartPointValue = GetCellCenter(XValue, YValue);
+                bFlowFieldMatchesValue =
+                    bFlowFieldMatchesValue &&
+                    std::abs(GroundPathfinderValue.GetFlowFieldDistance(DestinationPointValue, StartPointValue) -
+                             ExpectedDistanceValue) < 0.001f;
+
+                Point2D NextPointValue;
+                if (ExactDistanceValue != UnreachableDistanceValue && ExactDistanceValue > 0.0f)
+                {
+                    bStepsDescendValue =
+                        bStepsDescendValue &&
+                        GroundPathfinderValue.TryGetFlowFieldStep(DestinationPointValue, StartPointValue,
+                                                                  NextPointValue) &&
+                        GroundPathfinderValue.GetFlowFieldDistance(DestinationPointValue, NextPointValue) <
+                            ExactDistanceValue;
+                }
+
+                QueryInterface::PathingQuery QueryValue;
+                QueryValue.start_ = StartPointValue;
+                QueryValue.end_ = DestinationPointValue;
+                QueriesValue.push_back(QueryValue);
+            }
+        }
+        Check(bFlowFieldMatchesValue, SuccessValue, "Flow field distances should be exact.");
+        Check(bStepsDescendValue, SuccessValue, "Flow field steps should always move closer to the destination.");
+        Check(GroundPathfinderValue.GetFlowFieldBuildCount() == 1U, SuccessValue,
+              "Repeated queries to one destination should reuse one flow field.");
+
+        QueryInterface::PathingQuery SingleQueryValue;
+        SingleQueryValue.start_ = QueriesValue.front().start_;
+        SingleQueryValue.end_ = GetCellCenter(5, 90);
+        QueriesValue.push_back(SingleQueryValue);
+        std::vector<float> BatchedDistancesValue;
+        const FSteadyClock::time_point StartTimeValue = FSteadyClock::now();
+        GroundPathfinderValue.GetDistances(QueriesValue, BatchedDistancesValue);
+        const FSteadyClock::time_point EndTimeValue = FSteadyClock::now();
+        bool bBatchMatchesValue = BatchedDistancesValue.size() == QueriesValue.size();
+        for (size_t QueryIndexValue = 0U; bBatchMatchesValue && QueryIndexValue + 1U < QueriesValue.size();
+             ++QueryIndexValue)
+        {
+            bBatchMatchesValue =
+                std::abs(BatchedDistancesValue[QueryIndexValue] -
+                         GroundPathfinderValue.GetFlowFieldDistance(DestinationPointValue,
+                                                                    QueriesValue[QueryIndexValue].start_)) < 0.001f;
+        }
+        bBatchMatchesValue =
+            bBatchMatchesValue &&
+            std::abs(BatchedDistancesValue.back() -
+                     GroundPathfinderValue.GetDistance(SingleQueryValue.start_, SingleQueryValue.end_)) < 0.001f;
+        Check(bBatchMatchesValue, SuccessValue, "Batched distances should match single queries.");
+        Check(GroundPathfinderValue.GetFlowFieldBuildCount() == 1U, SuccessValue,
+              "A batch to a cached destination should not build another flow field.");
+        std::cout << "    BatchQueries=" << QueriesValue.size() << " | BatchUs="
+                  << std::chrono::duration_cast<std::chrono::microseconds>(EndTimeValue - StartTimeValue).count()
+                  << std::endl;
+    }
+
+    std::cout << "  Checking flow field reuse across destinations and structure updates..." << std::endl;
+    {
+        // A wall at x = 32 with a two-cell gap at y 31..32.
+        FTestGrid GridValue = MakeOpenGrid(64, 64);
+        for (int32_t YValue = 0; YValue < GridValue.Height; ++YValue)
+        {
+            if (YValue < 31 || YValue > 32)
+            {
+                GridValue.WalkableCells[static_cast<size_t>(32 + YValue * GridValue.Width)] = 0U;
+            }
+        }
+
+        FGroundPathfinder GroundPathfinderValue;
+        GroundPathfinderValue.Initialize(MakeMapGrids(GridValue));
+        GroundPathfinderValue.UpdateStructures(Units());
+        const Point2D WestPointValue = GetCellCenter(10, 31);
+        const std::vector<Point2D> DestinationPointsValue = {GetCellCenter(50, 31), GetCellCenter(50, 10),
+                                                             GetCellCenter(50, 50)};
+        float DistanceValue = 0.0f;
+        Check(GroundPathfinderValue.TryGetFlowFieldDistance(DestinationPointsValue[0], WestPointValue, DistanceValue) &&
+                  std::abs(DistanceValue - 40.0f) < 0.001f &&
+                  GroundPathfinderValue.TryGetFlowFieldDistance(DestinationPointsValue[1], WestPointValue,
+                                                                DistanceValue) &&
+                  !GroundPathfinderValue.TryGetFlowFieldDistance(DestinationPointsValue[2], WestPointValue,
+                                                                 DistanceValue) &&
+                  GroundPathfinderValue.TryGetFlowFieldDistance(DestinationPointsValue[0], GetCellCenter(12, 40),
+                                                                DistanceValue),
+              SuccessValue, "Flow field builds past the per-update budget should be refused, cached ones served.");
+        Check(GroundPathfinderValue.GetFlowFieldBuildCount() == FGroundPathfinder::MaxFlowFieldBuildsPerUpdateValue,
+              SuccessValue, "A refused query should not build a flow field.");
+
+        GroundPathfinderValue.UpdateStructures(Units());
+        Check(GroundPathfinderValue.TryGetFlowFieldDistance(DestinationPointsValue[2], WestPointValue, DistanceValue) &&
+                  GroundPathfinderValue.GetFlowFieldBuildCount() == 3U,
+              SuccessValue, "The next update should restore the flow field build budget.");
+
+        // A depot on open ground away from every path changes walkability but no distance; it still rebuilds once.
+        std::vector<Unit> StructureStorageValue = {
+            MakeStructure(1U, UNIT_TYPEID::TERRAN_SUPPLYDEPOT, Point2D(5.0f, 5.0f), 1.0f)};
+        Units StructureUnitsValue = {&StructureStorageValue[0]};
+        GroundPathfinderValue.UpdateStructures(StructureUnitsValue);
+        GroundPathfinderValue.UpdateStructures(StructureUnitsValue);
+        Check(GroundPathfinderValue.TryGetFlowFieldDistance(DestinationPointsValue[0], WestPointValue, DistanceValue) &&
+                  GroundPathfinderValue.TryGetFlowFieldDistance(DestinationPointsValue[0], WestPointValue,
+                                                                DistanceValue) &&
+                  GroundPathfinderValue.GetFlowFieldBuildCount() == 4U,
+              SuccessValue, "A walkability change should rebuild each flow field once, on its next use.");
+
+        // A depot over the gap seals the wall. The far side must read as unreachable, never as 0.
+        StructureStorageValue.push_back(
+            MakeStructure(2U, UNIT_TYPEID::TERRAN_SUPPLYDEPOT, Point2D(33.0f, 32.0f), 1.0f));
+        StructureUnitsValue = {&StructureStorageValue[0], &StructureStorageValue[1]};
+        GroundPathfinderValue.UpdateStructures(StructureUnitsValue);
+        Check(GroundPathfinderValue.TryGetFlowFieldDistance(DestinationPointsValue[0], WestPointValue, DistanceValue) &&
+                  DistanceValue == UnreachableDistanceValue &&
+                  GroundPathfinderValue.GetFlowFieldDistance(DestinationPointsValue[0], WestPointValue) == 0.0f,
+              SuccessValue, "An unreachable destination should answer the largest distance.");
+        Check(!GroundPathfinderValue.TryGetFlowFieldDistance(GetCellCenter(32, 10), WestPointValue, DistanceValue),
+              SuccessValue, "A blocked destination should give no flow field answer.");
+
+        // Lowering the depot removes its footprint and reopens the gap.
+        StructureStorageValue[1].unit_type = UNIT_TYPEID::TERRAN_SUPPLYDEPOTLOWERED;
+        GroundPathfinderValue.UpdateStructures(StructureUnitsValue);
+        Check(GroundPathfinderValue.TryGetFlowFieldDistance(DestinationPointsValue[0], WestPointValue, DistanceValue) &&
+                  std::abs(DistanceValue - 40.0f) < 0.001f,
+              SuccessValue, "A lowered depot should reopen the path for cached flow fields.");
+    }
+
+    std::cout << "  Checking blocked endpoints..." << std::endl;
+    {
+        // One blocked cell at (10, 10) and a blocked 3x3 block at (20..22, 20..22).
+        FTestGrid GridValue = MakeOpenGrid(32, 32);
+        GridValue.WalkableCells[static_cast<size_t>(10 + 10 * GridValue.Width)] = 0U;
+        for (int32_t YValue = 20; YValue <= 22; ++YValue)
+        {
+            for (int32_t XValue = 20; XValue <= 22; ++XValue)
+            {
+                GridValue.WalkableCells[static_cast<size_t>(XValue + YValue * GridValue.Width)] = 0U;
+            }
+        }
+
+        FGroundPathfinder GroundPathfinderValue;
+        GroundPathfinderValue.Initialize(MakeMapGrids(GridValue));
+        const Point2D OpenPointValue = GetCellCenter(4, 4);
+        Check(GroundPathfinderValue.GetDistance(OpenPointValue, GetCellCenter(10, 10)) == 0.0f &&
+                  GroundPathfinderValue.GetDistance(OpenPointValue, GetCellCenter(11, 10)) > 0.0f,
+              SuccessValue, "A blocked destination should be unreachable rather than moved to a neighbor.");
+        Check(GroundPathfinderValue.GetDistance(GetCellCenter(10, 10), OpenPointValue) == 0.0f &&
+                  GroundPathfinderValue.GetDistance(GetCellCenter(10, 10), OpenPointValue, 0.375f) == 0.0f,
+              SuccessValue, "A blocked start should stay unreachable when the unit footprint fits inside the cell.");
+        Check(GroundPathfinderValue.GetDistance(Point2D(10.9f, 10.5f), OpenPointValue, 0.375f) > 0.0f &&
+                  GroundPathfinderValue.GetFlowFieldDistance(OpenPointValue, Point2D(10.9f, 10.5f), 0.375f) > 0.0f,
+              SuccessValue, "A blocked start should snap to a walkable cell the unit footprint overlaps.");
+        Check(GroundPathfinderValue.GetDistance(GetCellCenter(21, 21), OpenPointValue, 0.5f) == 0.0f,
+              SuccessValue, "A start should never snap beyond the unit footprint.");
+
+        std::vector<QueryInterface::PathingQuery> QueriesValue(2U);
+        QueriesValue[0].start_ = Point2D(10.9f, 10.5f);
+        QueriesValue[0].end_ = OpenPointValue;
+        QueriesValue[1].start_ = OpenPointValue;
+        QueriesValue[1].end_ = GetCellCenter(21, 21);
+        std::vector<float> DistancesValue;
+        GroundPathfinderValue.GetDistances(QueriesValue, std::vector<float>{0.375f, 0.375f}, DistancesValue);
+        Check(DistancesValue.size() == 2U && DistancesValue[0] > 0.0f && DistancesValue[1] == 0.0f, SuccessValue,
+              "Batched queries should snap starts by unit radius and never snap destinations.");
+    }
+
+    std::cout << "  Checking query verification bookkeeping..." << std::endl;
+    {
+        FGroundPathfinder GroundPathfinderValue;
+        GroundPathfinderValue.SetQueryVerificationEnabled(true);
+        GroundPathfinderValue.RecordVerificationResult(12.0f, 12.5f);
+        GroundPathfinderValue.RecordVerificationResult(12.0f, 0.0f);
+        Check(GroundPathfinderValue.IsQueryVerificationEnabled() &&
+                  GroundPathfinderValue.GetVerifiedQueryCount() == 2U &&
+                  GroundPathfinderValue.GetVerificationMismatchCount() == 1U,
+              SuccessValue, "Only reachability disagreements should count as verification mismatches.");
+    }
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
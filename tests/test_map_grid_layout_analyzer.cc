@@ -0,0 +1,227 @@
+#include "test_map_grid_layout_analyzer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/catalogs/FMapGridLayoutAnalyzer.h"
+#include "sc2api/sc2_common.h"
+
+namespace sc2
+{
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+
+constexpr int32_t SyntheticMapSizeValue = 64;
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const std::string& MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+// Dump text for a 64x64 map: a high plateau (y >= 40) and low ground (y <= 34) split by a cliff band with one
+// four-tile ramp at x 20..23. Each level holds a base with a 16-tile mineral row and one 3x3 geyser.
+struct FSyntheticMapDump
+{
+    std::string PathingText;
+    std::string PlacementText;
+    std::string HeightText;
+};
+
+bool IsSyntheticResourceCell(const int32_t XValue, const int32_t YValue)
+{
+    const bool bMineralRowValue = (YValue == 58 || YValue == 5) && XValue >= 10 && XValue <= 25;
+    const bool bTopGeyserValue = XValue >= 28 && XValue <= 30 && YValue >= 52 && YValue <= 54;
+    const bool bBottomGeyserValue = XValue >= 28 && XValue <= 30 && YValue >= 9 && YValue <= 11;
+    return bMineralRowValue || bTopGeyserValue || bBottomGeyserValue;
+}
+
+bool IsSyntheticRampCell(const int32_t XValue, const int32_t YValue)
+{
+    return XValue >= 20 && XValue <= 23 && YValue >= 35 && YValue <= 39;
+}
+
+bool IsSyntheticCliffCell(const int32_t XValue, const int32_t YValue)
+{
+    return YValue >= 35 && YValue <= 39 && !IsSyntheticRampCell(XValue, YValue);
+}
+
+float GetSyntheticTerrainHeight(const int32_t XValue, const int32_t YValue)
+{
+    if (IsSyntheticRampCell(XValue, YValue))
+    {
+        return static_cast<float>(YValue - 35) * 0.5f;
+    }
+    return YValue >= 37 ? 2.0f : 0.0f;
+}
+
+FSyntheticMapDump MakeSyntheticMapDump()
+{
+    FSyntheticMapDump SyntheticMapDumpValue;
+    for (int32_t YValue = SyntheticMapSizeValue - 1; YValue >= 0; --YValue)
+    {
+        for (int32_t XValue = 0; XValue < SyntheticMapSizeValue; ++XValue)
+        {
+            const bool bPathableValue =
+                !IsSyntheticCliffCell(XValue, YValue) && !IsSyntheticResourceCell(XValue, YValue);
+            const bool bPlaceableValue = !IsSyntheticCliffCell(XValue, YValue) && !IsSyntheticRampCell(XValue, YValue);
+            SyntheticMapDumpValue.PathingText.push_back(bPathableValue ? ' ' : '#');
+            SyntheticMapDumpValue.PlacementText.push_back(bPlaceableValue ? ' ' : '#');
+        }
+        SyntheticMapDumpValue.PathingText.push_back('\n');
+        SyntheticMapDumpValue.PlacementText.push_back('\n');
+    }
+
+    for (int32_t XValue = 0; XValue < SyntheticMapSizeValue; ++XValue)
+    {
+        for (int32_t YValue = 0; YValue < SyntheticMapSizeValue; ++YValue)
+        {
+            char BufferValue[16];
+            std::snprintf(BufferValue, sizeof(BufferValue), "%g|", GetSyntheticTerrainHeight(XValue, YValue));
+            SyntheticMapDumpValue.HeightText += BufferValue;
+        }
+        SyntheticMapDumpValue.HeightText.push_back('\n');
+    }
+    return SyntheticMapDumpValue;
+}
+
+bool IsTownHallFootprintClear(const Point2D& LocationValue)
+{
+    const int32_t CenterTileXValue = static_cast<int32_t>(LocationValue.x);
+    const int32_t CenterTileYValue = static_cast<int32_t>(LocationValue.y);
+    for (int32_t YValue = CenterTileYValue - 5; YValue <= CenterTileYValue + 5; ++YValue)
+    {
+        for (int32_t XValue = CenterTileXValue - 5; XValue <= CenterTileXValue + 5; ++XValue)
+        {
+            if (IsSyntheticResourceCell(XValue, YValue))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+bool TestMapGridLayoutAnalyzer(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+    const FSyntheticMapDump SyntheticMapDumpValue = MakeSyntheticMapDump();
+    FMapGridDump GridDumpValue;
+    std::string ErrorValue;
+
+    std::cout << "  Checking grid dump parsing..." << std::endl;
+    {
+        Check(FMapGridLayoutAnalyzer::ParseGridDump(SyntheticMapDumpValue.PathingText,
+                                                    SyntheticMapDumpValue.PlacementText,
+                                                    SyntheticMapDumpValue.HeightText, GridDumpValue, ErrorValue),
+              SuccessValue, "The synthetic grid dump should parse: " + ErrorValue);
+        Check(GridDumpValue.Width == SyntheticMapSizeValue && GridDumpValue.Height == SyntheticMapSizeValue,
+              SuccessValue, "The parsed grid should keep the dumped size.");
+        Check(!GridDumpValue.IsPathable(10, 58) && GridDumpValue.IsPlaceable(10, 58) &&
+                  !GridDumpValue.IsPlaceable(21, 37) && GridDumpValue.IsPathable(21, 37) &&
+                  GridDumpValue.GetTerrainHeight(21, 39) == 2.0f && GridDumpValue.GetTerrainHeight(21, 35) == 0.0f,
+              SuccessValue, "Dumped rows should be read top row first and heights column by column.");
+
+        FMapGridDump TruncatedGridDumpValue;
+        Check(!FMapGridLayoutAnalyzer::ParseGridDump(SyntheticMapDumpValue.PathingText,
+                                                     SyntheticMapDumpValue.PlacementText.substr(0U, 200U),
+                                                     SyntheticMapDumpValue.HeightText, TruncatedGridDumpValue,
+                                                     ErrorValue),
+              SuccessValue, "Grids of different sizes should be rejected.");
+    }
+
+    std::cout << "  Checking detected bases..." << std::endl;
+    const FSteadyClock::time_point StartTimeValue = FSteadyClock::now();
+    FGeneratedMapLayout GeneratedMapLayoutValue = FMapGridLayoutAnalyzer::Analyze(GridDumpValue);
+    const FSteadyClock::time_point EndTimeValue = FSteadyClock::now();
+    if (Check(GeneratedMapLayoutValue.Bases.size() == 2U, SuccessValue, "Two bases should be detected."))
+    {
+        const FMapBaseDescriptor& TopBaseValue = GeneratedMapLayoutValue.Bases[0];
+        const FMapBaseDescriptor& BottomBaseValue = GeneratedMapLayoutValue.Bases[1];
+        Check(TopBaseValue.Location.y > 40.0f && BottomBaseValue.Location.y < 35.0f, SuccessValue,
+              "Bases should be numbered from the top of the map.");
+        Check(TopBaseValue.MineralPatchCount == 8U && TopBaseValue.GeyserCount == 1U &&
+                  BottomBaseValue.MineralPatchCount == 8U && BottomBaseValue.GeyserCount == 1U,
+              SuccessValue, "Each base should hold eight 2x1 mineral patches and one geyser.");
+        Check(TopBaseValue.GeyserPositions[0] == Point2D(29.5f, 53.5f), SuccessValue,
+              "Geysers should be centered on their 3x3 footprint.");
+        Check(TopBaseValue.MineralPatchPositions[0].y == 58.5f, SuccessValue,
+              "Mineral patches should be centered on their 2x1 footprint.");
+        Check(IsTownHallFootprintClear(TopBaseValue.Location) && IsTownHallFootprintClear(BottomBaseValue.Location),
+              SuccessValue, "Town halls should keep three cells clear of every resource.");
+        Check(Distance2D(TopBaseValue.Location, Point2D(20.0f, 55.0f)) < 10.0f, SuccessValue,
+              "The town hall should sit next to its mineral line.");
+
+        GridDumpValue.StartLocations.push_back(TopBaseValue.Location + Point2D(1.0f, 1.0f));
+        const FGeneratedMapLayout StartLayoutValue = FMapGridLayoutAnalyzer::Analyze(GridDumpValue);
+        Check(StartLayoutValue.Bases.size() == 2U && StartLayoutValue.Bases[0].bIsStartLocation &&
+                  !StartLayoutValue.Bases[1].bIsStartLocation,
+              SuccessValue, "Only the base at a dumped start location should be marked as one.");
+    }
+
+    std::cout << "  Checking detected ramps and ground distances..." << std::endl;
+    if (Check(GeneratedMapLayoutValue.Ramps.size() == 1U, SuccessValue, "One ramp should be detected."))
+    {
+        const FMapRampDescriptor& RampValue = GeneratedMapLayoutValue.Ramps[0];
+        Check(RampValue.TopTileCount == 4U && RampValue.BottomTileCount == 4U && RampValue.Width == 4U, SuccessValue,
+              "The ramp should span four tiles at both edges.");
+        Check(RampValue.TopCenter == Point2D(21.5f, 39.0f) && RampValue.BottomCenter == Point2D(21.5f, 35.0f),
+              SuccessValue, "Ramp edge centers should average the edge tiles.");
+        Check(RampValue.Orientation == ERampOrientation::SouthEast, SuccessValue,
+              "A ramp descending south should face south east.");
+        Check(RampValue.ConnectedBaseIndexA == 0U && RampValue.ConnectedBaseIndexB == 1U, SuccessValue,
+              "The ramp should connect the plateau base at its top to the low base at its bottom.");
+    }
+
+    if (Check(GeneratedMapLayoutValue.GroundDistances.size() == 1U, SuccessValue,
+              "One ground distance should be produced for two bases.") &&
+        GeneratedMapLayoutValue.Bases.size() == 2U)
+    {
+        const FMapGroundDistanceEntry& GroundDistanceValue = GeneratedMapLayoutValue.GroundDistances[0];
+        const Point2D& TopLocationValue = GeneratedMapLayoutValue.Bases[0].Location;
+        const Point2D& BottomLocationValue = GeneratedMapLayoutValue.Bases[1].Location;
+        const float StraightDistanceValue = Distance2D(TopLocationValue, BottomLocationValue);
+        Check(GroundDistanceValue.FromBaseIndex == 0U && GroundDistanceValue.ToBaseIndex == 1U, SuccessValue,
+              "Ground distances should be listed once per base pair.");
+        Check(GroundDistanceValue.Distance >= StraightDistanceValue - 1.0f &&
+                  GroundDistanceValue.Distance < StraightDistanceValue + 30.0f,
+              SuccessValue, "The ground distance should follow the ramp.");
+        std::cout << "    GroundDistance=" << GroundDistanceValue.Distance
+                  << " | StraightDistance=" << StraightDistanceValue << " | AnalyzeUs="
+                  << std::chrono::duration_cast<std::chrono::microseconds>(EndTimeValue - StartTimeValue).count()
+                  << std::endl;
+    }
+
+    std::cout << "  Checking YAML output..." << std::endl;
+    {
+        GeneratedMapLayoutValue.MapName = "Synthetic Cliff LE";
+        const std::string YamlValue = FMapGridLayoutAnalyzer::FormatYamlEntry(GeneratedMapLayoutValue);
+        Check(YamlValue.find("  - MapId: SyntheticCliff\n") == 0U, SuccessValue,
+              "The YAML entry should start with the map identifier.");
+        Check(YamlValue.find("      - syntheticcliffle\n") != std::string::npos &&
+                  YamlValue.find("        Orientation: SouthEast\n") != std::string::npos &&
+                  YamlValue.find("        ConnectsBaseIndices: [0, 1]\n") != std::string::npos &&
+                  YamlValue.find("    GroundDistances:\n      - [0, 1, ") != std::string::npos &&
+                  YamlValue.find("    Spawns: []\n") != std::string::npos,
+              SuccessValue, "The YAML entry should follow the MapLayoutDictionary schema.");
+    }
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
@@ -0,0 +1,342 @@
+#include "test_map_grids.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "s2clientprotocol/sc2api.pb.h"
+#include "sc2api/sc2_common.h"
+#include "sc2api/sc2_interfaces.h"
+#include "sc2api/sc2_map_info.h"
+
+namespace sc2
+{
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+using FSteadyTimePoint = FSteadyClock::time_point;
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const std::string& MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+uint64_t GetElapsedNanoseconds(const FSteadyTimePoint& StartTimeValue, const FSteadyTimePoint& EndTimeValue)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(EndTimeValue - StartTimeValue).count());
+}
+
+// Mostly-set images with blocked blobs, so both long set spans and isolated holes occur.
+void FillImage(const int WidthValue, const int HeightValue, const int BitsPerPixelValue, const uint32_t SeedValue,
+               ImageData& OutImageValue)
+{
+    std::mt19937 RandomEngineValue(SeedValue);
+    std::uniform_int_distribution<int> PercentDistributionValue(0, 99);
+    std::uniform_int_distribution<int> ByteDistributionValue(0, 255);
+
+    OutImageValue.width = WidthValue;
+    OutImageValue.height = HeightValue;
+    OutImageValue.bits_per_pixel = BitsPerPixelValue;
+    const size_t CellCountValue = static_cast<size_t>(WidthValue) * static_cast<size_t>(HeightValue);
+    if (BitsPerPixelValue == 1)
+    {
+        OutImageValue.data.assign((CellCountValue + 7U) / 8U, '\0');
+        for (size_t CellIndexValue = 0U; CellIndexValue < CellCountValue; ++CellIndexValue)
+        {
+            if (PercentDistributionValue(RandomEngineValue) < 85)
+            {
+                OutImageValue.data[CellIndexValue / 8U] |= static_cast<char>(0x80U >> (CellIndexValue % 8U));
+            }
+        }
+        return;
+    }
+
+    OutImageValue.data.assign(CellCountValue, '\0');
+    for (size_t CellIndexValue = 0U; CellIndexValue < CellCountValue; ++CellIndexValue)
+    {
+        const int PercentValue = PercentDistributionValue(RandomEngineValue);
+        const int CellValue =
+            PercentValue < 70 ? 255 : (PercentValue < 80 ? 0 : ByteDistributionValue(RandomEngineValue));
+        OutImageValue.data[CellIndexValue] = static_cast<char>(CellValue);
+    }
+}
+
+void CopyImageToProto(const ImageData& ImageValue, SC2APIProtocol::ImageData& OutImageValue)
+{
+    OutImageValue.set_bits_per_pixel(ImageValue.bits_per_pixel);
+    OutImageValue.mutable_size()->set_x(ImageValue.width);
+    OutImageValue.mutable_size()->set_y(ImageValue.height);
+    OutImageValue.set_data(ImageValue.data);
+}
+
+bool IsAreaPlacableBySampling(const PlacementGrid& PlacementGridValue, const Point2DI& MinValue,
+                              const Point2DI& MaxValue)
+{
+    for (int YValue = MinValue.y; YValue <= MaxValue.y; ++YValue)
+    {
+        for (int XValue = MinValue.x; XValue <= MaxValue.x; ++XValue)
+        {
+            if (!PlacementGridValue.IsPlacable(Point2DI(XValue, YValue)))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool TestTerrainGridsMatchSampleImages()
+{
+    bool SuccessValue = true;
+
+    // 1 bpp images take the word gather path when the width is a multiple of 8 and the bit walk otherwise.
+    const int WidthsValue[] = {136, 131, 64, 17};
+    const int BitsPerPixelsValue[] = {1, 8};
+    for (const int WidthValue : WidthsValue)
+    {
+        for (const int BitsPerPixelValue : BitsPerPixelsValue)
+        {
+            const int HeightValue = 37;
+            GameInfo GameInfoValue;
+            GameInfoValue.width = WidthValue;
+            GameInfoValue.height = HeightValue;
+            FillImage(WidthValue, HeightValue, BitsPerPixelValue, 11U + WidthValue, GameInfoValue.pathing_grid);
+            FillImage(WidthValue, HeightValue, BitsPerPixelValue, 29U + WidthValue, GameInfoValue.placement_grid);
+            FillImage(WidthValue, HeightValue, 8, 47U + WidthValue, GameInfoValue.terrain_height);
+
+            MapGrids MapGridsValue;
+            MapGridsValue.DecodeGameInfo(GameInfoValue);
+            const PathingGrid PathingGridValue(GameInfoValue);
+            const PlacementGrid PlacementGridValue(GameInfoValue);
+            const HeightMap HeightMapValue(GameInfoValue);
+
+            size_t MismatchCountValue = 0U;
+            for (int YValue = -2; YValue < HeightValue + 2; ++YValue)
+            {
+                for (int XValue = -2; XValue < WidthValue + 2; ++XValue)
+                {
+                    const Point2DI PointValue(XValue, YValue);
+                    const bool bInsideValue = XValue >= 0 && YValue >= 0 && XValue < WidthValue && YValue < HeightValue;
+                    const bool bExpectedPathableValue = bInsideValue && PathingGridValue.IsPathable(PointValue);
+                    const bool bExpectedPlacableValue = bInsideValue && PlacementGridValue.IsPlacable(PointValue);
+                    const float ExpectedHeightValue = bInsideValue ? HeightMapValue.TerrainHeight(PointValue) : 0.0f;
+                    if (MapGridsValue.IsPathable(PointValue) != bExpectedPathableValue ||
+                        MapGridsValue.IsPlacable(PointValue) != bExpectedPlacableValue ||
+                        MapGridsValue.TerrainHeight(PointValue) != ExpectedHeightValue)
+                    {
+                        ++MismatchCountValue;
+                    }
+                }
+            }
+
+            Check(MismatchCountValue == 0U, SuccessValue,
+                  "Decoded terrain should match the sampled images at every cell for width " +
+                      std::to_string(WidthValue) + " and " + std::to_string(BitsPerPixelValue) + " bpp.");
+
+            std::mt19937 RandomEngineValue(5U + WidthValue);
+            std::uniform_int_distribution<int> XDistributionValue(-1, WidthValue);
+            std::uniform_int_distribution<int> YDistributionValue(-1, HeightValue);
+            std::uniform_int_distribution<int> ExtentDistributionValue(0, 70);
+            size_t RectMismatchCountValue = 0U;
+            for (int QueryIndexValue = 0; QueryIndexValue < 2000; ++QueryIndexValue)
+            {
+                const Point2DI MinValue(XDistributionValue(RandomEngineValue), YDistributionValue(RandomEngineValue));
+                const int ExtentValue = QueryIndexValue % 2 == 0 ? ExtentDistributionValue(RandomEngineValue) % 5
+                                                                 : ExtentDistributionValue(RandomEngineValue);
+                const Point2DI MaxValue(MinValue.x + ExtentValue, MinValue.y + ExtentValue % 4);
+                const bool bInsideValue = MinValue.x >= 0 && MinValue.y >= 0 && MaxValue.x < WidthValue &&
+                                          MaxValue.y < HeightValue;
+                const bool bExpectedValue =
+                    bInsideValue && IsAreaPlacableBySampling(PlacementGridValue, MinValue, MaxValue);
+                if (MapGridsValue.IsAreaPlacable(MinValue, MaxValue) != bExpectedValue)
+                {
+                    ++RectMismatchCountValue;
+                }
+            }
+
+            Check(RectMismatchCountValue == 0U, SuccessValue,
+                  "Rectangle placement queries should match per-cell sampling for width " +
+                      std::to_string(WidthValue) + " and " + std::to_string(BitsPerPixelValue) + " bpp.");
+        }
+    }
+
+    MapGrids EmptyMapGridsValue;
+    GameInfo TruncatedGameInfoValue;
+    FillImage(32, 8, 8, 3U, TruncatedGameInfoValue.placement_grid);
+    TruncatedGameInfoValue.placement_grid.data.resize(10U);
+    EmptyMapGridsValue.DecodeGameInfo(TruncatedGameInfoValue);
+    Check(!EmptyMapGridsValue.HasTerrain() && !EmptyMapGridsValue.IsPlacable(Point2DI(0, 0)), SuccessValue,
+          "Images with too little data should decode to empty grids.");
+
+    return SuccessValue;
+}
+
+bool TestMapStateGridsMatchObservationSemantics()
+{
+    bool SuccessValue = true;
+    constexpr int WidthValue = 88;
+    constexpr int HeightValue = 21;
+
+    ImageData CreepImageValue;
+    ImageData VisibilityImageValue;
+    FillImage(WidthValue, HeightValue, 1, 71U, CreepImageValue);
+    FillImage(WidthValue, HeightValue, 8, 73U, VisibilityImageValue);
+    for (size_t CellIndexValue = 0U; CellIndexValue < VisibilityImageValue.data.size(); ++CellIndexValue)
+    {
+        VisibilityImageValue.data[CellIndexValue] =
+            static_cast<char>(static_cast<unsigned char>(VisibilityImageValue.data[CellIndexValue]) % 5U);
+    }
+
+    SC2APIProtocol::MapState MapStateValue;
+    CopyImageToProto(CreepImageValue, *MapStateValue.mutable_creep());
+    CopyImageToProto(VisibilityImageValue, *MapStateValue.mutable_visibility());
+
+    MapGrids MapGridsValue;
+    MapGridsValue.DecodeMapState(MapStateValue);
+
+    size_t MismatchCountValue = 0U;
+    for (int YValue = -1; YValue <= HeightValue; ++YValue)
+    {
+        for (int XValue = -1; XValue <= WidthValue; ++XValue)
+        {
+            const Point2DI PointValue(XValue, YValue);
+            bool bExpectedCreepValue = false;
+            Visibility ExpectedVisibilityValue = Visibility::FullHidden;
+            if (XValue >= 0 && YValue >= 0 && XValue < WidthValue && YValue < HeightValue)
+            {
+                const size_t CellIndexValue = static_cast<size_t>(XValue + YValue * WidthValue);
+                bExpectedCreepValue =
+                    ((CreepImageValue.data[CellIndexValue / 8U] >> (7U - CellIndexValue % 8U)) & 1) != 0;
+                const unsigned char VisibilityValue =
+                    static_cast<unsigned char>(VisibilityImageValue.data[CellIndexValue]);
+                ExpectedVisibilityValue =
+                    VisibilityValue <= 2U ? static_cast<Visibility>(VisibilityValue) : Visibility::FullHidden;
+            }
+
+            if (MapGridsValue.HasCreep(PointValue) != bExpectedCreepValue ||
+                MapGridsValue.GetVisibility(PointValue) != ExpectedVisibilityValue)
+            {
+                ++MismatchCountValue;
+            }
+        }
+    }
+
+    Check(MismatchCountValue == 0U, SuccessValue, "Decoded creep and visibility should match the raw map state.");
+
+    MapGridsValue.ClearMapState();
+    Check(!MapGridsValue.HasCreep(Point2DI(1, 1)) &&
+              MapGridsValue.GetVisibility(Point2DI(1, 1)) == Visibility::FullHidden,
+          SuccessValue, "Cleared map state should report no creep and full hidden visibility.");
+
+    return SuccessValue;
+}
+
+bool TestMapGridsProfile()
+{
+    bool SuccessValue = true;
+    constexpr int WidthValue = 200;
+    constexpr int HeightValue = 176;
+    constexpr int RepeatCountValue = 20;
+
+    GameInfo GameInfoValue;
+    GameInfoValue.width = WidthValue;
+    GameInfoValue.height = HeightValue;
+    FillImage(WidthValue, HeightValue, 8, 91U, GameInfoValue.pathing_grid);
+    FillImage(WidthValue, HeightValue, 8, 93U, GameInfoValue.placement_grid);
+    FillImage(WidthValue, HeightValue, 8, 95U, GameInfoValue.terrain_height);
+
+    SC2APIProtocol::MapState MapStateValue;
+    ImageData CreepImageValue;
+    ImageData VisibilityImageValue;
+    FillImage(WidthValue, HeightValue, 1, 97U, CreepImageValue);
+    FillImage(WidthValue, HeightValue, 8, 99U, VisibilityImageValue);
+    CopyImageToProto(CreepImageValue, *MapStateValue.mutable_creep());
+    CopyImageToProto(VisibilityImageValue, *MapStateValue.mutable_visibility());
+
+    MapGrids MapGridsValue;
+    const FSteadyTimePoint DecodeStartTimeValue = FSteadyClock::now();
+    for (int RepeatIndexValue = 0; RepeatIndexValue < RepeatCountValue; ++RepeatIndexValue)
+    {
+        MapGridsValue.DecodeGameInfo(GameInfoValue);
+        MapGridsValue.DecodeMapState(MapStateValue);
+    }
+    const FSteadyTimePoint DecodeEndTimeValue = FSteadyClock::now();
+
+    // 3x3 footprints at every tile, the shape build placement scans.
+    size_t SampledPlacableCountValue = 0U;
+    const FSteadyTimePoint SampledStartTimeValue = FSteadyClock::now();
+    const PlacementGrid PlacementGridValue(GameInfoValue);
+    for (int YValue = 1; YValue + 1 < HeightValue; ++YValue)
+    {
+        for (int XValue = 1; XValue + 1 < WidthValue; ++XValue)
+        {
+            SampledPlacableCountValue += IsAreaPlacableBySampling(PlacementGridValue, Point2DI(XValue - 1, YValue - 1),
+                                                                  Point2DI(XValue + 1, YValue + 1))
+                                             ? 1U
+                                             : 0U;
+        }
+    }
+    const FSteadyTimePoint SampledEndTimeValue = FSteadyClock::now();
+
+    size_t GridPlacableCountValue = 0U;
+    const FSteadyTimePoint GridStartTimeValue = FSteadyClock::now();
+    for (int YValue = 1; YValue + 1 < HeightValue; ++YValue)
+    {
+        for (int XValue = 1; XValue + 1 < WidthValue; ++XValue)
+        {
+            GridPlacableCountValue +=
+                MapGridsValue.IsAreaPlacable(Point2DI(XValue - 1, YValue - 1), Point2DI(XValue + 1, YValue + 1)) ? 1U
+                                                                                                                : 0U;
+        }
+    }
+    const FSteadyTimePoint GridEndTimeValue = FSteadyClock::now();
+
+    Check(SampledPlacableCountValue == GridPlacableCountValue, SuccessValue,
+          "Profiled footprint scans should agree between sampling and rectangle queries.");
+    const uint64_t FootprintCountValue = static_cast<uint64_t>(WidthValue - 2) * static_cast<uint64_t>(HeightValue - 2);
+    std::cout << "    Map=" << WidthValue << "x" << HeightValue
+              << " | AvgDecodeNs=" << GetElapsedNanoseconds(DecodeStartTimeValue, DecodeEndTimeValue) / RepeatCountValue
+              << " | Footprints=" << FootprintCountValue << " | Placable=" << GridPlacableCountValue
+              << " | SampledFootprintNs="
+              << GetElapsedNanoseconds(SampledStartTimeValue, SampledEndTimeValue) / FootprintCountValue
+              << " | GridFootprintNs="
+              << GetElapsedNanoseconds(GridStartTimeValue, GridEndTimeValue) / FootprintCountValue
+              << std::endl;
+
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestMapGrids(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking decoded terrain grids against sampled images..." << std::endl;
+    SuccessValue = TestTerrainGridsMatchSampleImages() && SuccessValue;
+
+    std::cout << "  Checking decoded creep and visibility against the raw map state..." << std::endl;
+    SuccessValue = TestMapStateGridsMatchObservationSemantics() && SuccessValue;
+
+    std::cout << "  Checking map grid decode and footprint query profile..." << std::endl;
+    SuccessValue = TestMapGridsProfile() && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
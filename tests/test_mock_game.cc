@@ -0,0 +1,208 @@
+#include "test_mock_game.h"
+
+#include <iostream>
+
+#include "s2clientprotocol/sc2api.pb.h"
+#include "sc2api/sc2_mock_game.h"
+
+namespace sc2
+{
+namespace
+{
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const char* MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+SC2APIProtocol::Response Respond(MockGame& MockGameValue, const SC2APIProtocol::Request& RequestValue)
+{
+    SC2APIProtocol::Response ResponseValue;
+    MockGameValue.Respond(RequestValue, ResponseValue);
+    return ResponseValue;
+}
+
+bool TestSyntheticObservations()
+{
+    bool SuccessValue = true;
+
+    MockGameSettings SettingsValue;
+    SettingsValue.self_unit_count = 30;
+    SettingsValue.enemy_unit_count = 20;
+    SettingsValue.map_size = 64;
+    SettingsValue.feature_layer_resolution = 24;
+    SettingsValue.minimap_resolution = 16;
+    SettingsValue.game_loop_limit = 4U;
+    MockGame MockGameValue(SettingsValue);
+    Check(MockGameValue.Open(), SuccessValue, "A synthetic game should open without a recording.");
+
+    SC2APIProtocol::Request JoinRequestValue;
+    JoinRequestValue.mutable_join_game();
+    const SC2APIProtocol::Response JoinResponseValue = Respond(MockGameValue, JoinRequestValue);
+    Check(JoinResponseValue.has_join_game() && JoinResponseValue.status() == SC2APIProtocol::Status::in_game,
+          SuccessValue, "Joining should put the game in progress.");
+
+    SC2APIProtocol::Request ObservationRequestValue;
+    ObservationRequestValue.mutable_observation();
+    const SC2APIProtocol::Response FirstResponseValue = Respond(MockGameValue, ObservationRequestValue);
+    const SC2APIProtocol::Observation& FirstObservationValue = FirstResponseValue.observation().observation();
+    Check(FirstObservationValue.raw_data().units_size() == 50, SuccessValue,
+          "Observations should hold the configured unit count.");
+    Check(FirstObservationValue.raw_data().units(0).alliance() == SC2APIProtocol::Alliance::Self &&
+              FirstObservationValue.raw_data().units(49).alliance() == SC2APIProtocol::Alliance::Enemy,
+          SuccessValue, "Own units should come before enemy units.");
+    Check(FirstObservationValue.player_common().player_id() == 1U && FirstObservationValue.raw_data().has_player() &&
+              FirstObservationValue.raw_data().player().has_camera() && FirstObservationValue.has_score(),
+          SuccessValue, "Observations should carry what ObservationImp requires.");
+    Check(FirstObservationValue.feature_layer_data().renders().unit_type().size().x() == 24 &&
+              FirstObservationValue.feature_layer_data().renders().unit_type().data().size() == 24U * 24U * 4U,
+          SuccessValue, "Feature layers should use the configured resolution and depth.");
+    Check(FirstObservationValue.feature_layer_data().minimap_renders().height_map().data().size() == 16U * 16U,
+          SuccessValue, "Minimap layers should use the configured resolution.");
+    Check(FirstObservationValue.raw_data().map_state().creep().data().size() == 64U * 64U / 8U, SuccessValue,
+          "The creep map should be packed one bit per cell.");
+
+    SC2APIProtocol::Request StepRequestValue;
+    StepRequestValue.mutable_step()->set_count(2U);
+    Respond(MockGameValue, StepRequestValue);
+    const SC2APIProtocol::Response SecondResponseValue = Respond(MockGameValue, ObservationRequestValue);
+    const SC2APIProtocol::Observation& SecondObservationValue = SecondResponseValue.observation().observation();
+    Check(SecondObservationValue.game_loop() == 2U && SecondResponseValue.status() == SC2APIProtocol::Status::in_game,
+          SuccessValue, "Stepping should advance the game loop by the step count.");
+    const SC2APIProtocol::Unit& FirstUnitValue = FirstObservationValue.raw_data().units(0);
+    const SC2APIProtocol::Unit& SecondUnitValue = SecondObservationValue.raw_data().units(0);
+    Check(SecondUnitValue.tag() == FirstUnitValue.tag() && SecondUnitValue.pos().x() != FirstUnitValue.pos().x(),
+          SuccessValue, "Units should keep their tags and move between steps.");
+
+    const SC2APIProtocol::Response EndStepResponseValue = Respond(MockGameValue, StepRequestValue);
+    Check(EndStepResponseValue.status() == SC2APIProtocol::Status::ended && MockGameValue.GetGameLoop() == 4U,
+          SuccessValue, "Reaching the game loop limit should end the game.");
+
+    Respond(MockGameValue, JoinRequestValue);
+    Check(MockGameValue.GetGameLoop() == 0U, SuccessValue, "Joining again should start a new game.");
+
+    return SuccessValue;
+}
+
+bool TestSyntheticQueries()
+{
+    bool SuccessValue = true;
+
+    MockGameSettings SettingsValue;
+    MockGame MockGameValue(SettingsValue);
+    MockGameValue.Open();
+
+    SC2APIProtocol::Request QueryRequestValue;
+    SC2APIProtocol::RequestQuery* QueryPtr = QueryRequestValue.mutable_query();
+    SC2APIProtocol::RequestQueryPathing* PathingPtr = QueryPtr->add_pathing();
+    PathingPtr->mutable_start_pos()->set_x(10.0f);
+    PathingPtr->mutable_start_pos()->set_y(10.0f);
+    PathingPtr->mutable_end_pos()->set_x(13.0f);
+    PathingPtr->mutable_end_pos()->set_y(14.0f);
+    QueryPtr->add_abilities()->set_unit_tag(77U);
+    QueryPtr->add_placements();
+    QueryPtr->add_placements();
+    const SC2APIProtocol::Response QueryResponseValue = Respond(MockGameValue, QueryRequestValue);
+    const SC2APIProtocol::ResponseQuery& ResponseQueryValue = QueryResponseValue.query();
+    Check(ResponseQueryValue.pathing_size() == 1 && ResponseQueryValue.pathing(0).distance() == 5.0f, SuccessValue,
+          "Pathing should answer the straight-line distance.");
+    Check(ResponseQueryValue.abilities_size() == 1 && ResponseQueryValue.abilities(0).unit_tag() == 77U,
+          SuccessValue, "Ability queries should echo the unit.");
+    Check(ResponseQueryValue.placements_size() == 2 &&
+              ResponseQueryValue.placements(1).result() == SC2APIProtocol::ActionResult::Success,
+          SuccessValue, "Placements should all succeed.");
+
+    SC2APIProtocol::Request ActionRequestValue;
+    ActionRequestValue.mutable_action()->add_actions();
+    ActionRequestValue.mutable_action()->add_actions();
+    const SC2APIProtocol::Response ActionResponseValue = Respond(MockGameValue, ActionRequestValue);
+    Check(ActionResponseValue.action().result_size() == 2, SuccessValue, "Each action should get a result.");
+
+    SC2APIProtocol::Request ReplayInfoRequestValue;
+    ReplayInfoRequestValue.mutable_replay_info();
+    Check(Respond(MockGameValue, ReplayInfoRequestValue).error_size() == 1, SuccessValue,
+          "Requests the mock does not model should be answered with an error.");
+
+    return SuccessValue;
+}
+
+bool TestSyntheticUnitGroups()
+{
+    bool SuccessValue = true;
+
+    MockGameSettings SettingsValue;
+    SettingsValue.self_units = {MockUnitGroup{18U, 2, true}, MockUnitGroup{45U, 6}};
+    SettingsValue.enemy_units = {MockUnitGroup{105U, 4}};
+    SettingsValue.neutral_units = {MockUnitGroup{341U, 3, true, 1800}};
+    MockGame MockGameValue(SettingsValue);
+
+    SC2APIProtocol::Request JoinRequestValue;
+    JoinRequestValue.mutable_join_game();
+    Respond(MockGameValue, JoinRequestValue);
+    SC2APIProtocol::Request ObservationRequestValue;
+    ObservationRequestValue.mutable_observation();
+    const SC2APIProtocol::Response FirstResponseValue = Respond(MockGameValue, ObservationRequestValue);
+    SC2APIProtocol::Request StepRequestValue;
+    StepRequestValue.mutable_step()->set_count(8U);
+    Respond(MockGameValue, StepRequestValue);
+    const SC2APIProtocol::Response SecondResponseValue = Respond(MockGameValue, ObservationRequestValue);
+
+    const SC2APIProtocol::ObservationRaw& FirstRawValue = FirstResponseValue.observation().observation().raw_data();
+    const SC2APIProtocol::ObservationRaw& SecondRawValue = SecondResponseValue.observation().observation().raw_data();
+    if (!Check(FirstRawValue.units_size() == 15 && SecondRawValue.units_size() == 15, SuccessValue,
+               "Unit groups should replace the default marines."))
+    {
+        return SuccessValue;
+    }
+
+    Check(FirstRawValue.units(0).unit_type() == 18U && FirstRawValue.units(2).unit_type() == 45U &&
+              FirstRawValue.units(8).alliance() == SC2APIProtocol::Alliance::Enemy &&
+              FirstRawValue.units(14).alliance() == SC2APIProtocol::Alliance::Neutral &&
+              FirstRawValue.units(14).mineral_contents() == 1800,
+          SuccessValue, "Groups should be listed in order with their alliance and resources.");
+    Check(FirstRawValue.units(1).pos().x() == SecondRawValue.units(1).pos().x() &&
+              FirstRawValue.units(2).pos().x() != SecondRawValue.units(2).pos().x(),
+          SuccessValue, "Structures should stand still while mobile units move.");
+    Check(FirstResponseValue.observation().observation().player_common().food_used() == 6U, SuccessValue,
+          "Only mobile units should use food.");
+
+    SC2APIProtocol::Request DataRequestValue;
+    DataRequestValue.mutable_data();
+    const SC2APIProtocol::Response DataResponseValue = Respond(MockGameValue, DataRequestValue);
+    const SC2APIProtocol::ResponseData& DataValue = DataResponseValue.data();
+    Check(DataValue.units_size() == 342 && DataValue.units(45).unit_id() == 45U &&
+              DataValue.units(45).weapons_size() == 1 && DataValue.units(18).weapons_size() == 0 &&
+              !DataValue.units(46).available(),
+          SuccessValue, "Unit type data should cover every id in use and arm only mobile units.");
+
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestMockGame(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking synthetic observations..." << std::endl;
+    SuccessValue = TestSyntheticObservations() && SuccessValue;
+
+    std::cout << "  Checking synthetic queries..." << std::endl;
+    SuccessValue = TestSyntheticQueries() && SuccessValue;
+
+    std::cout << "  Checking synthetic unit groups..." << std::endl;
+    SuccessValue = TestSyntheticUnitGroups() && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
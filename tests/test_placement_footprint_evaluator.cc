@@ -0,0 +1,616 @@
+#include "test_placement_footprint_evaluator.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/agent_framework.h"
+#include "common/services/FPlacementFootprintEvaluator.h"
+#include "common/services/FStructureFootprintHelper.h"
+#include "sc2api/sc2_interfaces.h"
+#include "sc2api/sc2_score.h"
+
+namespace sc2
+{
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const std::string& MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+// Accepts every query except points listed in RejectedPoints and counts round trips.
+struct FCountingPlacementQuery : QueryInterface
+{
+    std::vector<Point2D> RejectedPoints;
+    uint32_t SingleQueryCount = 0U;
+    uint32_t BatchQueryCount = 0U;
+    uint32_t BatchedCandidateCount = 0U;
+    std::vector<Tag> PlacingUnitTags;
+
+    AvailableAbilities GetAbilitiesForUnit(const Unit* UnitPtr, bool IgnoreResourceRequirements = false,
+                                           bool UseGeneralizedAbility = true) override
+    {
+        (void)UnitPtr;
+        (void)IgnoreResourceRequirements;
+        (void)UseGeneralizedAbility;
+        return {};
+    }
+
+    std::vector<AvailableAbilities> GetAbilitiesForUnits(const Units& UnitsToQuery,
+                                                         bool IgnoreResourceRequirements = false,
+                                                         bool UseGeneralizedAbility = true) override
+    {
+        (void)IgnoreResourceRequirements;
+        (void)UseGeneralizedAbility;
+        return std::vector<AvailableAbilities>(UnitsToQuery.size());
+    }
+
+    float PathingDistance(const Point2D& StartPointValue, const Point2D& EndPointValue) override
+    {
+        (void)StartPointValue;
+        (void)EndPointValue;
+        return 1.0f;
+    }
+
+    float PathingDistance(const Unit* StartUnitValue, const Point2D& EndPointValue) override
+    {
+        (void)StartUnitValue;
+        (void)EndPointValue;
+        return 1.0f;
+    }
+
+    std::vector<float> PathingDistance(const std::vector<PathingQuery>& QueriesValue) override
+    {
+        return std::vector<float>(QueriesValue.size(), 1.0f);
+    }
+
+    bool IsRejected(const Point2D& TargetPointValue) const
+    {
+        for (const Point2D& RejectedPointValue : RejectedPoints)
+        {
+            if (RejectedPointValue == TargetPointValue)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool Placement(const AbilityID& AbilityIdValue, const Point2D& TargetPointValue,
+                   const Unit* UnitPtr = nullptr) override
+    {
+        (void)AbilityIdValue;
+        (void)UnitPtr;
+        ++SingleQueryCount;
+        return !IsRejected(TargetPointValue);
+    }
+
+    std::vector<bool> Placement(const std::vector<PlacementQuery>& QueriesValue) override
+    {
+        ++BatchQueryCount;
+        BatchedCandidateCount += static_cast<uint32_t>(QueriesValue.size());
+        std::vector<bool> PlacementResultsValue;
+        PlacementResultsValue.reserve(QueriesValue.size());
+        for (const PlacementQuery& PlacementQueryValue : QueriesValue)
+        {
+            PlacingUnitTags.push_back(PlacementQueryValue.placing_unit_tag);
+            PlacementResultsValue.push_back(!IsRejected(PlacementQueryValue.target_pos));
+        }
+
+        return PlacementResultsValue;
+    }
+};
+
+struct FakeObservation : ObservationInterface
+{
+    Units AllUnitsValue;
+    RawActions RawActionsValue;
+    SpatialActions SpatialActionsValue;
+    std::vector<ChatMessage> ChatMessagesValue;
+    std::vector<PowerSource> PowerSourcesValue;
+    std::vector<Effect> EffectsValue;
+    std::vector<UpgradeID> UpgradesValue;
+    Score ScoreValue{};
+    Abilities AbilityDataValue;
+    UnitTypes UnitTypeDataValue;
+    Upgrades UpgradeDataValue;
+    Buffs BuffDataValue;
+    Effects EffectDataValue;
+    GameInfo GameInfoValue;
+    std::vector<PlayerResult> ResultsValue;
+    SC2APIProtocol::Observation RawObservationValue;
+
+    FakeObservation()
+    {
+        GameInfoValue.width = 64;
+        GameInfoValue.height = 64;
+        GameInfoValue.playable_min = Point2D(0.0f, 0.0f);
+        GameInfoValue.playable_max = Point2D(63.0f, 63.0f);
+        GameInfoValue.placement_grid.width = GameInfoValue.width;
+        GameInfoValue.placement_grid.height = GameInfoValue.height;
+        GameInfoValue.placement_grid.bits_per_pixel = 8;
+        GameInfoValue.placement_grid.data.assign(static_cast<size_t>(GameInfoValue.width * GameInfoValue.height),
+                                                 static_cast<char>(255));
+    }
+
+    void BlockPlacementTile(const int TileXValue, const int TileYValue)
+    {
+        GameInfoValue.placement_grid.data[static_cast<size_t>(TileYValue * GameInfoValue.width + TileXValue)] = 0;
+    }
+
+    uint32_t GetPlayerID() const override
+    {
+        return 1U;
+    }
+
+    uint32_t GetGameLoop() const override
+    {
+        return 0U;
+    }
+
+    Units GetUnits() const override
+    {
+        return AllUnitsValue;
+    }
+
+    Units GetUnits(Unit::Alliance AllianceValue, Filter FilterValue = {}) const override
+    {
+        Units FilteredUnitsValue;
+        for (const Unit* UnitValue : AllUnitsValue)
+        {
+            if (UnitValue != nullptr && UnitValue->alliance == AllianceValue &&
+                (!FilterValue || FilterValue(*UnitValue)))
+            {
+                FilteredUnitsValue.push_back(UnitValue);
+            }
+        }
+
+        return FilteredUnitsValue;
+    }
+
+    Units GetUnits(Filter FilterValue) const override
+    {
+        return GetUnits(Unit::Alliance::Self, FilterValue);
+    }
+
+    const Unit* GetUnit(const Tag TagValue) const override
+    {
+        for (const Unit* UnitValue : AllUnitsValue)
+        {
+            if (UnitValue != nullptr && UnitValue->tag == TagValue)
+            {
+                return UnitValue;
+            }
+        }
+
+        return nullptr;
+    }
+
+    const RawActions& GetRawActions() const override
+    {
+        return RawActionsValue;
+    }
+
+    const SpatialActions& GetFeatureLayerActions() const override
+    {
+        return SpatialActionsValue;
+    }
+
+    const SpatialActions& GetRenderedActions() const override
+    {
+        return SpatialActionsValue;
+    }
+
+    const std::vector<ChatMessage>& GetChatMessages() const override
+    {
+        return ChatMessagesValue;
+    }
+
+    const std::vector<PowerSource>& GetPowerSources() const override
+    {
+        return PowerSourcesValue;
+    }
+
+    const std::vector<Effect>& GetEffects() const override
+    {
+        return EffectsValue;
+    }
+
+    const std::vector<UpgradeID>& GetUpgrades() const override
+    {
+        return UpgradesValue;
+    }
+
+    const Score& GetScore() const override
+    {
+        return ScoreValue;
+    }
+
+    const Abilities& GetAbilityData(bool ForceRefresh = false) const override
+    {
+        (void)ForceRefresh;
+        return AbilityDataValue;
+    }
+
+    const UnitTypes& GetUnitTypeData(bool ForceRefresh = false) const override
+    {
+        (void)ForceRefresh;
+        return UnitTypeDataValue;
+    }
+
+    const Upgrades& GetUpgradeData(bool ForceRefresh = false) const override
+    {
+        (void)ForceRefresh;
+        return UpgradeDataValue;
+    }
+
+    const Buffs& GetBuffData(bool ForceRefresh = false) const override
+    {
+        (void)ForceRefresh;
+        return BuffDataValue;
+    }
+
+    const Effects& GetEffectData(bool ForceRefresh = false) const override
+    {
+        (void)ForceRefresh;
+        return EffectDataValue;
+    }
+
+    const GameInfo& GetGameInfo() const override
+    {
+        return GameInfoValue;
+    }
+
+    uint32_t GetMinerals() const override
+    {
+        return 0U;
+    }
+
+    uint32_t GetVespene() const override
+    {
+        return 0U;
+    }
+
+    uint32_t GetFoodCap() const override
+    {
+        return 0U;
+    }
+
+    uint32_t GetFoodUsed() const override
+    {
+        return 0U;
+    }
+
+    uint32_t GetFoodArmy() const override
+    {
+        return 0U;
+    }
+
+    uint32_t GetFoodWorkers() const override
+    {
+        return 0U;
+    }
+
+    uint32_t GetIdleWorkerCount() const override
+    {
+        return 0U;
+    }
+
+    uint32_t GetArmyCount() const override
+    {
+        return 0U;
+    }
+
+    uint32_t GetWarpGateCount() const override
+    {
+        return 0U;
+    }
+
+    uint32_t GetLarvaCount() const override
+    {
+        return 0U;
+    }
+
+    Point2D GetCameraPos() const override
+    {
+        return Point2D();
+    }
+
+    Point3D GetStartLocation() const override
+    {
+        return Point3D();
+    }
+
+    const std::vector<PlayerResult>& GetResults() const override
+    {
+        return ResultsValue;
+    }
+
+    bool HasCreep(const Point2D& PointValue) const override
+    {
+        (void)PointValue;
+        return false;
+    }
+
+    Visibility GetVisibility(const Point2D& PointValue) const override
+    {
+        (void)PointValue;
+        return Visibility::Visible;
+    }
+
+    bool IsPathable(const Point2D& PointValue) const override
+    {
+        (void)PointValue;
+        return true;
+    }
+
+    bool IsPlacable(const Point2D& PointValue) const override
+    {
+        (void)PointValue;
+        return true;
+    }
+
+    float TerrainHeight(const Point2D& PointValue) const override
+    {
+        (void)PointValue;
+        return 0.0f;
+    }
+
+    const SC2APIProtocol::Observation* GetRawObservation() const override
+    {
+        return &RawObservationValue;
+    }
+};
+
+Unit MakeUnit(const Tag TagValue, const UNIT_TYPEID UnitTypeIdValue, const Unit::Alliance AllianceValue,
+              const Point2D& PositionValue, const float RadiusValue, const bool IsBuildingValue)
+{
+    Unit UnitValue;
+    UnitValue.display_type = Unit::Visible;
+    UnitValue.alliance = AllianceValue;
+    UnitValue.tag = TagValue;
+    UnitValue.unit_type = UnitTypeIdValue;
+    UnitValue.pos = Point3D(PositionValue.x, PositionValue.y, 0.0f);
+    UnitValue.radius = RadiusValue;
+    UnitValue.build_progress = 1.0f;
+    UnitValue.is_flying = false;
+    UnitValue.is_building = IsBuildingValue;
+    UnitValue.is_alive = true;
+    return UnitValue;
+}
+
+FPlacementCandidate MakeCandidate(const ABILITY_ID StructureAbilityIdValue, const Point2D& BuildPointValue,
+                                  const bool RequiresAddonClearanceValue = false)
+{
+    FPlacementCandidate CandidateValue;
+    CandidateValue.StructureAbilityId = StructureAbilityIdValue;
+    CandidateValue.BuildPoint = BuildPointValue;
+    CandidateValue.bRequiresAddonClearance = RequiresAddonClearanceValue;
+    return CandidateValue;
+}
+
+}  // namespace
+
+bool TestPlacementFootprintEvaluator(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::vector<Unit> UnitStorageValue;
+    UnitStorageValue.push_back(MakeUnit(1U, UNIT_TYPEID::TERRAN_SCV, Unit::Alliance::Self, Point2D(20.5f, 20.5f),
+                                        0.375f, false));
+    UnitStorageValue.push_back(MakeUnit(2U, UNIT_TYPEID::TERRAN_SUPPLYDEPOT, Unit::Alliance::Self,
+                                        Point2D(30.0f, 30.0f), 1.375f, true));
+    UnitStorageValue.push_back(MakeUnit(3U, UNIT_TYPEID::ZERG_ZERGLING, Unit::Alliance::Enemy,
+                                        Point2D(40.5f, 20.5f), 0.375f, false));
+    UnitStorageValue.push_back(MakeUnit(4U, UNIT_TYPEID::NEUTRAL_MINERALFIELD, Unit::Alliance::Neutral,
+                                        Point2D(50.0f, 50.5f), 1.125f, false));
+    UnitStorageValue.push_back(MakeUnit(5U, UNIT_TYPEID::NEUTRAL_VESPENEGEYSER, Unit::Alliance::Neutral,
+                                        Point2D(10.5f, 50.5f), 1.75f, false));
+    UnitStorageValue.push_back(MakeUnit(6U, UNIT_TYPEID::NEUTRAL_VESPENEGEYSER, Unit::Alliance::Neutral,
+                                        Point2D(20.5f, 50.5f), 1.75f, false));
+    UnitStorageValue.push_back(MakeUnit(7U, UNIT_TYPEID::TERRAN_REFINERY, Unit::Alliance::Self,
+                                        Point2D(20.5f, 50.5f), 1.75f, true));
+
+    FakeObservation ObservationValue;
+    for (const Unit& UnitValue : UnitStorageValue)
+    {
+        ObservationValue.AllUnitsValue.push_back(&UnitValue);
+    }
+    ObservationValue.BlockPlacementTile(10, 10);
+
+    FCountingPlacementQuery QueryValue;
+    const FFrameContext FrameValue = FFrameContext::Create(&ObservationValue, &QueryValue, 1U);
+    const Unit* BuilderUnitPtrValue = &UnitStorageValue[0];
+
+    std::cout << "  Checking local footprint rejections..." << std::endl;
+    {
+        const FPlacementFootprintEvaluator EvaluatorValue(FrameValue, BuilderUnitPtrValue);
+        Check(EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(20.5f, 20.5f))),
+              SuccessValue, "The builder should not block its own structure footprint.");
+        Check(!EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(10.5f, 11.5f))),
+              SuccessValue, "A footprint over an unplaceable tile should be rejected.");
+        Check(!EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_SUPPLYDEPOT, Point2D(31.0f, 30.0f))),
+              SuccessValue, "A footprint overlapping an observed structure should be rejected.");
+        Check(EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_SUPPLYDEPOT, Point2D(32.0f, 30.0f))),
+              SuccessValue, "A footprint touching an observed structure edge should be accepted.");
+        Check(!EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(41.5f, 20.5f))),
+              SuccessValue, "A footprint over an enemy ground unit should be rejected.");
+        Check(EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(28.5f, 20.5f))),
+              SuccessValue, "A clear barracks footprint should be accepted.");
+        Check(!EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(37.5f, 20.5f), true)),
+              SuccessValue, "A barracks whose add-on footprint covers an enemy unit should be rejected.");
+        Check(EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(37.5f, 20.5f))),
+              SuccessValue, "The same barracks without add-on clearance should be accepted.");
+        Check(!EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_COMMANDCENTER, Point2D(50.5f, 45.5f))),
+              SuccessValue, "A town hall inside the mineral exclusion zone should be rejected.");
+        Check(EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_COMMANDCENTER, Point2D(50.5f, 44.5f))),
+              SuccessValue, "A town hall three tiles from a mineral field should be accepted.");
+        Check(EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_REFINERY, Point2D(10.5f, 50.5f))),
+              SuccessValue, "A refinery on a free geyser should be accepted.");
+        Check(!EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_REFINERY, Point2D(20.5f, 50.5f))),
+              SuccessValue, "A refinery on an occupied geyser should be rejected.");
+        Check(!EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_REFINERY, Point2D(30.5f, 50.5f))),
+              SuccessValue, "A refinery away from any geyser should be rejected.");
+        Check(QueryValue.SingleQueryCount == 0U && QueryValue.BatchQueryCount == 0U, SuccessValue,
+              "Local checks should not issue placement queries.");
+    }
+
+    std::cout << "  Checking batched confirmation..." << std::endl;
+    {
+        const std::vector<FPlacementCandidate> CandidatesValue =
+        {
+            MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(10.5f, 11.5f)),
+            MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(41.5f, 20.5f)),
+            MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(28.5f, 20.5f)),
+            MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(28.5f, 24.5f)),
+            MakeCandidate(ABILITY_ID::BUILD_BARRACKS, Point2D(24.5f, 28.5f)),
+        };
+
+        QueryValue = FCountingPlacementQuery();
+        QueryValue.RejectedPoints.push_back(Point2D(28.5f, 20.5f));
+        const FPlacementFootprintEvaluator EvaluatorValue(FrameValue, BuilderUnitPtrValue);
+        const int32_t SelectedIndexValue = EvaluatorValue.SelectFirstConfirmedCandidate(CandidatesValue);
+        Check(SelectedIndexValue == 3, SuccessValue,
+              "The first locally valid candidate confirmed by the game should be selected.");
+        Check(QueryValue.BatchQueryCount == 1U && QueryValue.SingleQueryCount == 0U, SuccessValue,
+              "Selection should issue one batched placement query.");
+        Check(QueryValue.BatchedCandidateCount == 3U, SuccessValue,
+              "Only locally valid candidates should be sent for confirmation.");
+        Check(EvaluatorValue.GetLocalRejectionCount() == 2U, SuccessValue,
+              "Both locally invalid candidates should be counted as rejections.");
+        bool AllTagsMatchValue = !QueryValue.PlacingUnitTags.empty();
+        for (const Tag PlacingUnitTagValue : QueryValue.PlacingUnitTags)
+        {
+            AllTagsMatchValue = AllTagsMatchValue && PlacingUnitTagValue == BuilderUnitPtrValue->tag;
+        }
+        Check(AllTagsMatchValue, SuccessValue, "Batched queries should carry the builder tag.");
+
+        QueryValue = FCountingPlacementQuery();
+        QueryValue.RejectedPoints.push_back(Point2D(28.5f, 20.5f));
+        const FPlacementFootprintEvaluator SmallBatchEvaluatorValue(FrameValue, BuilderUnitPtrValue);
+        Check(SmallBatchEvaluatorValue.SelectFirstConfirmedCandidate(CandidatesValue, 1U) == 3, SuccessValue,
+              "A one-candidate batch size should select the same candidate.");
+        Check(QueryValue.BatchQueryCount == 2U, SuccessValue,
+              "A rejected batch should fall through to the next batch.");
+
+        QueryValue = FCountingPlacementQuery();
+        const std::vector<FPlacementCandidate> RefineryCandidatesValue =
+        {
+            MakeCandidate(ABILITY_ID::BUILD_REFINERY, Point2D(20.5f, 50.5f)),
+            MakeCandidate(ABILITY_ID::BUILD_REFINERY, Point2D(10.5f, 50.5f)),
+        };
+        const FPlacementFootprintEvaluator RefineryEvaluatorValue(FrameValue);
+        const std::vector<bool> ConfirmedValue = RefineryEvaluatorValue.ConfirmCandidates(RefineryCandidatesValue);
+        Check(ConfirmedValue.size() == 2U && !ConfirmedValue[0] && ConfirmedValue[1], SuccessValue,
+              "Only the free geyser should be confirmed.");
+        Check(QueryValue.BatchQueryCount == 1U && QueryValue.BatchedCandidateCount == 1U, SuccessValue,
+              "Confirming geysers should issue one query for the free geyser.");
+    }
+
+    std::cout << "  Checking the shared footprint table..." << std::endl;
+    {
+        struct FFootprintExpectation
+        {
+            ABILITY_ID StructureAbilityId;
+            UNIT_TYPEID StructureUnitTypeId;
+            float HalfExtent;
+        };
+
+        const std::vector<FFootprintExpectation> ExpectationsValue =
+        {
+            {ABILITY_ID::BUILD_SENSORTOWER, UNIT_TYPEID::TERRAN_SENSORTOWER, 0.5f},
+            {ABILITY_ID::BUILD_SUPPLYDEPOT, UNIT_TYPEID::TERRAN_SUPPLYDEPOT, 1.0f},
+            {ABILITY_ID::BUILD_MISSILETURRET, UNIT_TYPEID::TERRAN_MISSILETURRET, 1.0f},
+            {ABILITY_ID::BUILD_BARRACKS, UNIT_TYPEID::TERRAN_BARRACKS, 1.5f},
+            {ABILITY_ID::BUILD_ENGINEERINGBAY, UNIT_TYPEID::TERRAN_ENGINEERINGBAY, 1.5f},
+            {ABILITY_ID::BUILD_REFINERY, UNIT_TYPEID::TERRAN_REFINERY, 1.5f},
+            {ABILITY_ID::BUILD_COMMANDCENTER, UNIT_TYPEID::TERRAN_COMMANDCENTER, 2.5f},
+        };
+        for (const FFootprintExpectation& ExpectationValue : ExpectationsValue)
+        {
+            const Point2D AbilityHalfExtentsValue =
+                FStructureFootprintHelper::GetStructureFootprintHalfExtentsForAbility(
+                    ExpectationValue.StructureAbilityId);
+            const Point2D UnitTypeHalfExtentsValue =
+                FStructureFootprintHelper::GetStructureFootprintHalfExtentsForUnitType(
+                    ExpectationValue.StructureUnitTypeId);
+            Check(AbilityHalfExtentsValue == Point2D(ExpectationValue.HalfExtent, ExpectationValue.HalfExtent) &&
+                      UnitTypeHalfExtentsValue == AbilityHalfExtentsValue,
+                  SuccessValue, "A structure should have the same footprint by build ability and by unit type.");
+        }
+
+        // A 2x2 turret touching the observed depot fits where a 3x3 footprint at the same center would overlap it.
+        const FPlacementFootprintEvaluator EvaluatorValue(FrameValue, BuilderUnitPtrValue);
+        Check(EvaluatorValue.IsCandidateLocallyPlaceable(
+                  MakeCandidate(ABILITY_ID::BUILD_MISSILETURRET, Point2D(28.0f, 30.0f))) &&
+                  !EvaluatorValue.IsCandidateLocallyPlaceable(
+                      MakeCandidate(ABILITY_ID::BUILD_ENGINEERINGBAY, Point2D(28.0f, 30.0f))),
+              SuccessValue, "A missile turret should use its own footprint in the evaluator.");
+    }
+
+    std::cout << "  Checking local evaluation cost..." << std::endl;
+    {
+        std::vector<FPlacementCandidate> SweepCandidatesValue;
+        for (int32_t TileYValue = 4; TileYValue < 60; TileYValue += 2)
+        {
+            for (int32_t TileXValue = 4; TileXValue < 60; TileXValue += 2)
+            {
+                SweepCandidatesValue.push_back(MakeCandidate(
+                    ABILITY_ID::BUILD_BARRACKS, Point2D(static_cast<float>(TileXValue) + 0.5f,
+                                                        static_cast<float>(TileYValue) + 0.5f),
+                    true));
+            }
+        }
+
+        const FPlacementFootprintEvaluator EvaluatorValue(FrameValue, BuilderUnitPtrValue);
+        uint32_t LocallyPlaceableCountValue = 0U;
+        const FSteadyClock::time_point StartTimeValue = FSteadyClock::now();
+        for (const FPlacementCandidate& CandidateValue : SweepCandidatesValue)
+        {
+            LocallyPlaceableCountValue += EvaluatorValue.IsCandidateLocallyPlaceable(CandidateValue) ? 1U : 0U;
+        }
+        const FSteadyClock::time_point EndTimeValue = FSteadyClock::now();
+        const double NanosecondsPerCandidateValue =
+            static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(EndTimeValue - StartTimeValue).count()) /
+            static_cast<double>(SweepCandidatesValue.size());
+        std::cout << "    Candidates=" << SweepCandidatesValue.size() << " | LocallyPlaceable="
+                  << LocallyPlaceableCountValue << " | NsPerCandidate=" << NanosecondsPerCandidateValue << std::endl;
+        Check(LocallyPlaceableCountValue > 0U && LocallyPlaceableCountValue < SweepCandidatesValue.size(),
+              SuccessValue, "The sweep should mix locally placeable and blocked candidates.");
+    }
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
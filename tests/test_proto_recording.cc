@@ -0,0 +1,281 @@
+#include "test_proto_recording.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include "s2clientprotocol/sc2api.pb.h"
+#include "sc2api/sc2_proto_interface.h"
+#include "sc2api/sc2_proto_recording.h"
+
+namespace sc2
+{
+namespace
+{
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const char* MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+SC2APIProtocol::Request MakePathingQueryRequest(const float StartXValue, const float EndXValue)
+{
+    SC2APIProtocol::Request RequestValue;
+    SC2APIProtocol::RequestQueryPathing* PathingPtr = RequestValue.mutable_query()->add_pathing();
+    PathingPtr->mutable_start_pos()->set_x(StartXValue);
+    PathingPtr->mutable_start_pos()->set_y(10.0f);
+    PathingPtr->mutable_end_pos()->set_x(EndXValue);
+    PathingPtr->mutable_end_pos()->set_y(10.0f);
+    return RequestValue;
+}
+
+SC2APIProtocol::Response MakePathingQueryResponse(const float DistanceValue)
+{
+    SC2APIProtocol::Response ResponseValue;
+    ResponseValue.mutable_query()->add_pathing()->set_distance(DistanceValue);
+    ResponseValue.set_status(SC2APIProtocol::Status::in_game);
+    return ResponseValue;
+}
+
+SC2APIProtocol::Response MakeObservationResponse(const uint32_t GameLoopValue)
+{
+    SC2APIProtocol::Response ResponseValue;
+    ResponseValue.mutable_observation()->mutable_observation()->set_game_loop(GameLoopValue);
+    ResponseValue.set_status(SC2APIProtocol::Status::in_game);
+    return ResponseValue;
+}
+
+// Ping, join, game info, then three frames. The first frame holds two pathing queries.
+bool WriteRecording(const std::string& PathValue)
+{
+    ProtoRecordingWriter WriterValue;
+    if (!WriterValue.Open(PathValue))
+    {
+        return false;
+    }
+
+    SC2APIProtocol::Response PingResponseValue;
+    PingResponseValue.mutable_ping()->set_base_build(75689U);
+    PingResponseValue.set_status(SC2APIProtocol::Status::launched);
+    WriterValue.Write(nullptr, PingResponseValue);
+
+    SC2APIProtocol::Response JoinResponseValue;
+    JoinResponseValue.mutable_join_game()->set_player_id(1U);
+    JoinResponseValue.set_status(SC2APIProtocol::Status::in_game);
+    WriterValue.Write(nullptr, JoinResponseValue);
+
+    SC2APIProtocol::Response GameInfoResponseValue;
+    GameInfoResponseValue.mutable_game_info()->set_map_name("Recorded");
+    GameInfoResponseValue.set_status(SC2APIProtocol::Status::in_game);
+    WriterValue.Write(nullptr, GameInfoResponseValue);
+
+    WriterValue.Write(nullptr, MakeObservationResponse(1U));
+    const SC2APIProtocol::Request FirstQueryValue = MakePathingQueryRequest(10.0f, 20.0f);
+    WriterValue.Write(&FirstQueryValue, MakePathingQueryResponse(10.0f));
+    const SC2APIProtocol::Request SecondQueryValue = MakePathingQueryRequest(10.0f, 30.0f);
+    WriterValue.Write(&SecondQueryValue, MakePathingQueryResponse(20.0f));
+    WriterValue.Write(nullptr, MakeObservationResponse(2U));
+    const bool bWrittenValue = WriterValue.Write(nullptr, MakeObservationResponse(3U));
+    const bool bCountValue = WriterValue.GetRecordCount() == 8U;
+    WriterValue.Close();
+    return bWrittenValue && bCountValue;
+}
+
+GameResponsePtr SendAndWait(ProtoInterface& ProtoValue, const SC2APIProtocol::Request& RequestValue)
+{
+    GameRequestPtr RequestPtr = ProtoValue.MakeRequest();
+    *RequestPtr = RequestValue;
+    if (!ProtoValue.SendRequest(RequestPtr))
+    {
+        return nullptr;
+    }
+
+    return ProtoValue.WaitForResponseInternal();
+}
+
+bool TestPlaybackAnswers(const std::string& PathValue)
+{
+    bool SuccessValue = true;
+
+    ProtoInterface ProtoValue;
+    if (!Check(ProtoValue.StartPlayback(PathValue) && ProtoValue.IsPlayingBack(), SuccessValue,
+               "The recording should open for playback."))
+    {
+        return false;
+    }
+    Check(ProtoValue.GetPlayback()->GetRecordCount() == 8U && ProtoValue.GetPlayback()->GetObservationCount() == 3U,
+          SuccessValue, "Playback should index every record and observation.");
+    Check(ProtoValue.ConnectToGame("playback", 0, 1000) && ProtoValue.GetBaseBuild() == 75689U, SuccessValue,
+          "Connecting should replay the recorded ping without a game.");
+
+    SC2APIProtocol::Request JoinRequestValue;
+    JoinRequestValue.mutable_join_game();
+    const GameResponsePtr JoinResponsePtr = SendAndWait(ProtoValue, JoinRequestValue);
+    Check(JoinResponsePtr && JoinResponsePtr->has_join_game() && JoinResponsePtr->join_game().player_id() == 1U,
+          SuccessValue, "Join should be answered from the recording.");
+
+    SC2APIProtocol::Request ObservationRequestValue;
+    ObservationRequestValue.mutable_observation();
+    GameResponsePtr ObservationResponsePtr = SendAndWait(ProtoValue, ObservationRequestValue);
+    Check(ObservationResponsePtr && ObservationResponsePtr->observation().observation().game_loop() == 1U &&
+              ProtoValue.GetLastStatus() == SC2APIProtocol::Status::in_game,
+          SuccessValue, "The first observation should be the first recorded frame.");
+
+    // Queries pair by fingerprint within the frame regardless of the order they are sent in.
+    GameResponsePtr QueryResponsePtr = SendAndWait(ProtoValue, MakePathingQueryRequest(10.0f, 30.0f));
+    Check(QueryResponsePtr && QueryResponsePtr->query().pathing_size() == 1 &&
+              QueryResponsePtr->query().pathing(0).distance() == 20.0f,
+          SuccessValue, "A recorded query should be matched by fingerprint.");
+    QueryResponsePtr = SendAndWait(ProtoValue, MakePathingQueryRequest(10.0f, 40.0f));
+    Check(QueryResponsePtr && QueryResponsePtr->query().pathing_size() == 1 &&
+              QueryResponsePtr->query().pathing(0).distance() == 0.0f,
+          SuccessValue, "An unknown query should not take another recorded query's answer.");
+    QueryResponsePtr = SendAndWait(ProtoValue, MakePathingQueryRequest(10.0f, 20.0f));
+    Check(QueryResponsePtr && QueryResponsePtr->query().pathing_size() == 1 &&
+              QueryResponsePtr->query().pathing(0).distance() == 10.0f,
+          SuccessValue, "A recorded query should still be matched after an unknown one.");
+    QueryResponsePtr = SendAndWait(ProtoValue, MakePathingQueryRequest(10.0f, 20.0f));
+    Check(QueryResponsePtr && QueryResponsePtr->query().pathing_size() == 1 &&
+              QueryResponsePtr->query().pathing(0).distance() == 0.0f,
+          SuccessValue, "Once the frame's queries are used, pathing should read as unreachable.");
+    Check(ProtoValue.GetPlayback()->GetMatchedQueryCount() == 2U, SuccessValue,
+          "Only the recorded queries should count as matched.");
+
+    SC2APIProtocol::Request PlacementRequestValue;
+    PlacementRequestValue.mutable_query()->add_placements()->set_ability_id(318);
+    PlacementRequestValue.mutable_query()->add_placements()->set_ability_id(318);
+    QueryResponsePtr = SendAndWait(ProtoValue, PlacementRequestValue);
+    Check(QueryResponsePtr && QueryResponsePtr->query().placements_size() == 2 &&
+              QueryResponsePtr->query().placements(0).result() != SC2APIProtocol::ActionResult::Success,
+          SuccessValue, "Synthesized placements should match the request size and fail.");
+
+    ProtoValue.GetPlayback()->SetQueryResponder(
+        [](const SC2APIProtocol::Request& RequestValue, SC2APIProtocol::Response& ResponseValue)
+        {
+            for (int PlacementIndexValue = 0; PlacementIndexValue < RequestValue.query().placements_size();
+                 ++PlacementIndexValue)
+            {
+                ResponseValue.mutable_query()->add_placements()->set_result(SC2APIProtocol::ActionResult::Success);
+            }
+        });
+    QueryResponsePtr = SendAndWait(ProtoValue, PlacementRequestValue);
+    Check(QueryResponsePtr && QueryResponsePtr->query().placements_size() == 2 &&
+              QueryResponsePtr->query().placements(1).result() == SC2APIProtocol::ActionResult::Success &&
+              ProtoValue.GetPlayback()->GetDeferredQueryCount() == 1U &&
+              ProtoValue.GetPlayback()->GetMatchedQueryCount() == 2U,
+          SuccessValue, "Unmatched queries should go to the query responder when one is set.");
+    ProtoValue.GetPlayback()->SetQueryResponder(nullptr);
+
+    SC2APIProtocol::Request ActionRequestValue;
+    ActionRequestValue.mutable_action()->add_actions();
+    ActionRequestValue.mutable_action()->add_actions();
+    ActionRequestValue.mutable_action()->add_actions();
+    const GameResponsePtr ActionResponsePtr = SendAndWait(ProtoValue, ActionRequestValue);
+    Check(ActionResponsePtr && ActionResponsePtr->action().result_size() == 3 &&
+              ActionResponsePtr->action().result(2) == SC2APIProtocol::ActionResult::Success,
+          SuccessValue, "Actions should be acknowledged one result per action.");
+
+    SC2APIProtocol::Request GameInfoRequestValue;
+    GameInfoRequestValue.mutable_game_info();
+    SendAndWait(ProtoValue, GameInfoRequestValue);
+    const GameResponsePtr GameInfoResponsePtr = SendAndWait(ProtoValue, GameInfoRequestValue);
+    Check(GameInfoResponsePtr && GameInfoResponsePtr->game_info().map_name() == "Recorded", SuccessValue,
+          "The last recorded game info should be repeated.");
+
+    SC2APIProtocol::Request DataRequestValue;
+    DataRequestValue.mutable_data();
+    const GameResponsePtr DataResponsePtr = SendAndWait(ProtoValue, DataRequestValue);
+    Check(DataResponsePtr && DataResponsePtr->has_data(), SuccessValue,
+          "An unrecorded request should get an empty response of its type.");
+
+    SC2APIProtocol::Request StepRequestValue;
+    StepRequestValue.mutable_step()->set_count(1U);
+    for (uint32_t GameLoopValue = 2U; GameLoopValue <= 3U; ++GameLoopValue)
+    {
+        const GameResponsePtr StepResponsePtr = SendAndWait(ProtoValue, StepRequestValue);
+        Check(StepResponsePtr && StepResponsePtr->has_step() &&
+                  ProtoValue.GetLastStatus() == SC2APIProtocol::Status::in_game,
+              SuccessValue, "Steps should report in game while frames remain.");
+        ObservationResponsePtr = SendAndWait(ProtoValue, ObservationRequestValue);
+        Check(ObservationResponsePtr && ObservationResponsePtr->observation().observation().game_loop() == GameLoopValue,
+              SuccessValue, "Observations should follow the recorded order.");
+    }
+
+    SendAndWait(ProtoValue, StepRequestValue);
+    Check(ProtoValue.GetLastStatus() == SC2APIProtocol::Status::ended, SuccessValue,
+          "Stepping past the last frame should end the game.");
+    ObservationResponsePtr = SendAndWait(ProtoValue, ObservationRequestValue);
+    Check(ObservationResponsePtr && ObservationResponsePtr->observation().observation().game_loop() == 3U &&
+              ProtoValue.GetLastStatus() == SC2APIProtocol::Status::ended,
+          SuccessValue, "Past the end the final frame should stand with the game ended.");
+
+    return SuccessValue;
+}
+
+bool TestRejectedRecordings(const std::string& PathValue)
+{
+    bool SuccessValue = true;
+
+    std::string RecordingBytesValue;
+    {
+        std::ifstream InputStreamValue(PathValue, std::ios::binary);
+        RecordingBytesValue.assign(std::istreambuf_iterator<char>(InputStreamValue), std::istreambuf_iterator<char>());
+    }
+
+    {
+        std::ofstream OutputStreamValue(PathValue, std::ios::binary | std::ios::trunc);
+        OutputStreamValue.write(RecordingBytesValue.data(),
+                                static_cast<std::streamsize>(RecordingBytesValue.size() - 3U));
+    }
+    ProtoPlayback TruncatedPlaybackValue;
+    Check(!TruncatedPlaybackValue.Open(PathValue) && !TruncatedPlaybackValue.IsOpen(), SuccessValue,
+          "A truncated recording should be rejected.");
+
+    {
+        std::ofstream OutputStreamValue(PathValue, std::ios::binary | std::ios::trunc);
+        OutputStreamValue << "not a recording";
+    }
+    ProtoPlayback ForeignPlaybackValue;
+    Check(!ForeignPlaybackValue.Open(PathValue), SuccessValue, "A file without the recording header should be rejected.");
+
+    std::remove(PathValue.c_str());
+    ProtoPlayback MissingPlaybackValue;
+    Check(!MissingPlaybackValue.Open(PathValue), SuccessValue, "A missing recording should be rejected.");
+
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestProtoRecording(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+    const std::string RecordingPathValue = "test_proto_recording.sc2rec";
+
+    std::cout << "  Checking recording writer..." << std::endl;
+    if (!Check(WriteRecording(RecordingPathValue), SuccessValue, "The recording should be written."))
+    {
+        return false;
+    }
+
+    std::cout << "  Checking playback answers..." << std::endl;
+    SuccessValue = TestPlaybackAnswers(RecordingPathValue) && SuccessValue;
+
+    std::cout << "  Checking rejected recordings..." << std::endl;
+    SuccessValue = TestRejectedRecordings(RecordingPathValue) && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
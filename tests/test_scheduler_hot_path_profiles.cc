@@ -8,13 +8,16 @@
 #include <iostream>
 #include <limits>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/descriptors/EMacroPhase.h"
 #include "common/descriptors/FGameStateDescriptor.h"
 #include "common/goals/FGoalDescriptor.h"
 #include "common/planning/FCommandAuthoritySchedulingState.h"
+#include "common/planning/FCommandOrderHotFields.h"
 #include "common/planning/FCommandOrderRecord.h"
+#include "common/planning/FCommandOrderView.h"
 #include "common/planning/FCommandTaskDescriptor.h"
 #include "common/planning/FDefaultStrategicDirector.h"
 #include "common/planning/FTerranCommandTaskAdmissionService.h"
@@ -108,43 +111,64 @@ size_t GetApproximateTierQueueRetainedBytes(
     return ApproximateByteCountValue;
 }
 
+template <typename TKeyType, typename TValueType, typename THashType>
+size_t GetApproximateUnorderedMapRetainedBytes(const std::unordered_map<TKeyType, TValueType, THashType>& MapValue)
+{
+    return (MapValue.bucket_count() * sizeof(void*)) +
+           (MapValue.size() * (sizeof(void*) + sizeof(size_t) + sizeof(std::pair<const TKeyType, TValueType>)));
+}
+
+size_t GetApproximateLookupIndexRetainedBytes(const FCommandAuthoritySchedulingState& SchedulingStateValue)
+{
+    return SchedulingStateValue.OrderIdToIndex.GetRetainedBytes() +
+           SchedulingStateValue.ActiveExecutionOrderIndexByActorTag.GetRetainedBytes() +
+           SchedulingStateValue.ActiveStrategicOrderIndexByGoalId.GetRetainedBytes() +
+           SchedulingStateValue.ActiveTaskSignatureCounts.GetRetainedBytes() +
+           SchedulingStateValue.ActiveChildOrderIndexByParentAndLayer.GetRetainedBytes();
+}
+
+size_t GetLookupIndexSlotCapacity(const FCommandAuthoritySchedulingState& SchedulingStateValue)
+{
+    return SchedulingStateValue.OrderIdToIndex.GetCapacity() +
+           SchedulingStateValue.ActiveExecutionOrderIndexByActorTag.GetCapacity() +
+           SchedulingStateValue.ActiveStrategicOrderIndexByGoalId.GetCapacity() +
+           SchedulingStateValue.ActiveTaskSignatureCounts.GetCapacity() +
+           SchedulingStateValue.ActiveChildOrderIndexByParentAndLayer.GetCapacity();
+}
+
 size_t GetApproximateBlockedTaskRingBufferRetainedBytes(const FBlockedTaskRingBuffer& BlockedTaskRingBufferValue)
 {
     return sizeof(FBlockedTaskRingBuffer) +
            (BlockedTaskRingBufferValue.GetCapacity() * sizeof(FBlockedTaskRecord));
 }
 
+size_t GetApproximateDiagnosticColumnsRetainedBytes(const FCommandOrderDiagnosticColumns& DiagnosticColumnsValue)
+{
+    return GetApproximateVectorRetainedBytes(DiagnosticColumnsValue.LastDeferralSteps) +
+           GetApproximateVectorRetainedBytes(DiagnosticColumnsValue.LastDeferralGameLoops) +
+           GetApproximateVectorRetainedBytes(DiagnosticColumnsValue.DispatchSteps);
+}
+
 size_t GetApproximateSchedulingStateRetainedBytes(const FCommandAuthoritySchedulingState& SchedulingStateValue)
 {
     size_t ApproximateByteCountValue = sizeof(FCommandAuthoritySchedulingState);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.OrderIds);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.ParentOrderIds);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.SourceGoalIds);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.SourceLayers);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.LifecycleStates);
+    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.OrderHotFields);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.TaskPackageKinds);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.TaskNeedKinds);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.TaskTypes);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.RetentionPolicies);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.BlockedTaskWakeKinds);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.BasePriorityValues);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.EffectivePriorityValues);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.PriorityTiers);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.IntentDomains);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.CreationSteps);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.DeadlineSteps);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.OwningArmyIndices);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.OwningSquadIndices);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.ActorTags);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.AbilityIds);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.TargetKinds);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.TargetPoints);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.TargetUnitTags);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.QueuedValues);
-    ApproximateByteCountValue +=
-        GetApproximateVectorRetainedBytes(SchedulingStateValue.RequiresPlacementValidationValues);
-    ApproximateByteCountValue +=
-        GetApproximateVectorRetainedBytes(SchedulingStateValue.RequiresPathingValidationValues);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.PlanStepIds);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.TargetCounts);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.RequestedQueueCounts);
@@ -162,15 +186,13 @@ size_t GetApproximateSchedulingStateRetainedBytes(const FCommandAuthoritySchedul
     ApproximateByteCountValue +=
         GetApproximateVectorRetainedBytes(SchedulingStateValue.ReservedPlacementSlotOrdinals);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.LastDeferralReasons);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.LastDeferralSteps);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.LastDeferralGameLoops);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.ConsecutiveDeferralCounts);
-    ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.DispatchSteps);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.DispatchGameLoops);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.ObservedCountsAtDispatch);
     ApproximateByteCountValue +=
         GetApproximateVectorRetainedBytes(SchedulingStateValue.ObservedInConstructionCountsAtDispatch);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.DispatchAttemptCounts);
+    ApproximateByteCountValue += GetApproximateDiagnosticColumnsRetainedBytes(SchedulingStateValue.DiagnosticColumns);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.StrategicOrderIndices);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.PlanningProcessIndices);
     ApproximateByteCountValue += GetApproximateVectorRetainedBytes(SchedulingStateValue.ArmyOrderIndices);
@@ -185,9 +207,7 @@ size_t GetApproximateSchedulingStateRetainedBytes(const FCommandAuthoritySchedul
     ApproximateByteCountValue +=
         GetApproximateReadyIntentQueueRetainedBytes(SchedulingStateValue.ReadyIntentQueues);
 
-    ApproximateByteCountValue +=
-        SchedulingStateValue.OrderIdToIndex.bucket_count() *
-        (sizeof(void*) + sizeof(std::pair<const uint32_t, size_t>));
+    ApproximateByteCountValue += GetApproximateLookupIndexRetainedBytes(SchedulingStateValue);
     ApproximateByteCountValue +=
         GetApproximateBlockedTaskRingBufferRetainedBytes(SchedulingStateValue.BlockedStrategicTasks);
     ApproximateByteCountValue +=
@@ -391,6 +411,35 @@ FGameStateDescriptor CreateGoalProfileGameStateDescriptor(const EMacroPhase Macr
     return GameStateDescriptorValue;
 }
 
+template <typename TValue>
+size_t GetColumnElementBytes(const std::vector<TValue>& Values)
+{
+    (void)Values;
+    return sizeof(TValue);
+}
+
+// Column bytes read per squad order by the unit-execution planner when it goes through an order view. Layer,
+// lifecycle and priority share one hot row.
+size_t GetSquadOrderViewBytesPerOrder(const FCommandAuthoritySchedulingState& SchedulingStateValue)
+{
+    return GetColumnElementBytes(SchedulingStateValue.OrderHotFields) +
+           GetColumnElementBytes(SchedulingStateValue.OwningArmyIndices) +
+           GetColumnElementBytes(SchedulingStateValue.OwningSquadIndices) +
+           GetColumnElementBytes(SchedulingStateValue.OrderIds);
+}
+
+// Column bytes read per dispatched order by the dispatch confirmation pass when it goes through an order view.
+size_t GetDispatchOrderViewBytesPerOrder(const FCommandAuthoritySchedulingState& SchedulingStateValue)
+{
+    return GetColumnElementBytes(SchedulingStateValue.OrderHotFields) +
+           GetColumnElementBytes(SchedulingStateValue.ResultUnitTypeIds) +
+           GetColumnElementBytes(SchedulingStateValue.ObservedCountsAtDispatch) +
+           GetColumnElementBytes(SchedulingStateValue.ObservedInConstructionCountsAtDispatch) +
+           GetColumnElementBytes(SchedulingStateValue.DispatchGameLoops) +
+           GetColumnElementBytes(SchedulingStateValue.AbilityIds) +
+           GetColumnElementBytes(SchedulingStateValue.OrderIds);
+}
+
 void PrintProfileHeader(const char* HeaderTextPtrValue)
 {
     std::cout << "[HotPathProfile] " << HeaderTextPtrValue << std::endl;
@@ -409,6 +458,7 @@ bool TestSchedulerHotPathProfiles(int ArgC, char** ArgV)
     std::cout << "  FGoalDescriptor=" << sizeof(FGoalDescriptor)
               << " bytes | FCommandTaskDescriptor=" << sizeof(FCommandTaskDescriptor)
               << " bytes | FCommandOrderRecord=" << sizeof(FCommandOrderRecord)
+              << " bytes | FCommandOrderHotFields=" << sizeof(FCommandOrderHotFields)
               << " bytes | FCommandAuthoritySchedulingState=" << sizeof(FCommandAuthoritySchedulingState)
               << " bytes" << std::endl;
 
@@ -532,6 +582,393 @@ bool TestSchedulerHotPathProfiles(int ArgC, char** ArgV)
         }
     }
 
+    {
+        const std::array<size_t, 3U> IndexProfileOrderCountsValue =
+        {
+            1000U,
+            10000U,
+            100000U,
+        };
+        constexpr uint32_t IndexRebuildIterationsValue = 8U;
+
+        for (const size_t OrderCountValue : IndexProfileOrderCountsValue)
+        {
+            FCommandAuthoritySchedulingState SchedulingStateValue;
+            SchedulingStateValue.Reserve(OrderCountValue);
+            SchedulingStateValue.BeginMutationBatch();
+            for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
+            {
+                SchedulingStateValue.EnqueueOrder(CreateProfileOrder(OrderIndexValue));
+            }
+
+            const FSteadyTimePoint ColdRebuildStartTimeValue = FSteadyClock::now();
+            SchedulingStateValue.EndMutationBatch();
+            const FSteadyTimePoint ColdRebuildEndTimeValue = FSteadyClock::now();
+
+            const size_t IndexSlotCapacityBeforeValue = GetLookupIndexSlotCapacity(SchedulingStateValue);
+            const FSteadyTimePoint SteadyRebuildStartTimeValue = FSteadyClock::now();
+            for (uint32_t IterationIndexValue = 0U; IterationIndexValue < IndexRebuildIterationsValue;
+                 ++IterationIndexValue)
+            {
+                SchedulingStateValue.RebuildDerivedQueues();
+            }
+            const FSteadyTimePoint SteadyRebuildEndTimeValue = FSteadyClock::now();
+            const size_t IndexSlotCapacityAfterValue = GetLookupIndexSlotCapacity(SchedulingStateValue);
+            const size_t IndexBytesValue = GetApproximateLookupIndexRetainedBytes(SchedulingStateValue);
+
+            std::unordered_map<uint32_t, size_t> BaselineOrderIdToIndexValue;
+            const FSteadyTimePoint BaselineRebuildStartTimeValue = FSteadyClock::now();
+            for (uint32_t IterationIndexValue = 0U; IterationIndexValue < IndexRebuildIterationsValue;
+                 ++IterationIndexValue)
+            {
+                BaselineOrderIdToIndexValue.clear();
+                for (size_t OrderIndexValue = 0U; OrderIndexValue < SchedulingStateValue.OrderIds.size();
+                     ++OrderIndexValue)
+                {
+                    BaselineOrderIdToIndexValue.emplace(SchedulingStateValue.OrderIds[OrderIndexValue],
+                                                        OrderIndexValue);
+                }
+            }
+            const FSteadyTimePoint BaselineRebuildEndTimeValue = FSteadyClock::now();
+
+            const FSteadyTimePoint FlatRebuildStartTimeValue = FSteadyClock::now();
+            for (uint32_t IterationIndexValue = 0U; IterationIndexValue < IndexRebuildIterationsValue;
+                 ++IterationIndexValue)
+            {
+                SchedulingStateValue.OrderIdToIndex.Clear();
+                for (size_t OrderIndexValue = 0U; OrderIndexValue < SchedulingStateValue.OrderIds.size();
+                     ++OrderIndexValue)
+                {
+                    SchedulingStateValue.OrderIdToIndex.Set(SchedulingStateValue.OrderIds[OrderIndexValue],
+                                                            OrderIndexValue);
+                }
+            }
+            const FSteadyTimePoint FlatRebuildEndTimeValue = FSteadyClock::now();
+
+            size_t LookupOrderIndexValue = 0U;
+            Check(SchedulingStateValue.OrderIdToIndex.GetCount() == OrderCountValue, SuccessValue,
+                  "Flat order-id index should hold one entry per enqueued order.");
+            Check(SchedulingStateValue.TryGetOrderIndex(SchedulingStateValue.OrderIds.back(), LookupOrderIndexValue) &&
+                      LookupOrderIndexValue == OrderCountValue - 1U,
+                  SuccessValue, "Flat order-id index should resolve the last enqueued order.");
+            Check(IndexSlotCapacityAfterValue == IndexSlotCapacityBeforeValue, SuccessValue,
+                  "Steady-state derived queue rebuilds should reuse the reserved index capacity.");
+
+            SchedulingStateValue.Reset();
+            Check(GetLookupIndexSlotCapacity(SchedulingStateValue) == IndexSlotCapacityAfterValue, SuccessValue,
+                  "Reset should retain flat index capacity for the next game.");
+
+            PrintProfileHeader("LookupIndexes");
+            std::cout << "  Orders=" << OrderCountValue
+                      << " | ColdRebuildUs=" << GetElapsedMicroseconds(ColdRebuildStartTimeValue, ColdRebuildEndTimeValue)
+                      << " | AvgRebuildUs="
+                      << (GetElapsedMicroseconds(SteadyRebuildStartTimeValue, SteadyRebuildEndTimeValue) /
+                          IndexRebuildIterationsValue)
+                      << " | AvgOrderIdFlatUs="
+                      << (GetElapsedMicroseconds(FlatRebuildStartTimeValue, FlatRebuildEndTimeValue) /
+                          IndexRebuildIterationsValue)
+                      << " | AvgOrderIdUnorderedUs="
+                      << (GetElapsedMicroseconds(BaselineRebuildStartTimeValue, BaselineRebuildEndTimeValue) /
+                          IndexRebuildIterationsValue)
+                      << " | IndexBytes=" << IndexBytesValue
+                      << " | OrderIdFlatBytes=" << SchedulingStateValue.OrderIdToIndex.GetRetainedBytes()
+                      << " | OrderIdUnorderedBytes="
+                      << GetApproximateUnorderedMapRetainedBytes(BaselineOrderIdToIndexValue)
+                      << std::endl;
+        }
+    }
+
+    {
+        const std::array<size_t, 3U> ChurnProfileOrderCountsValue =
+        {
+            1024U,
+            4096U,
+            8192U,
+        };
+        constexpr size_t ChurnOrdersPerStepValue = 64U;
+        constexpr uint32_t ChurnStepCountValue = 16U;
+
+        for (const size_t OrderCountValue : ChurnProfileOrderCountsValue)
+        {
+            FCommandAuthoritySchedulingState SchedulingStateValue;
+            SchedulingStateValue.Reserve(OrderCountValue);
+            SchedulingStateValue.BeginMutationBatch();
+            for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
+            {
+                SchedulingStateValue.EnqueueOrder(CreateProfileOrder(OrderIndexValue));
+            }
+            SchedulingStateValue.EndMutationBatch();
+
+            uint64_t IncrementalMicrosecondsValue = 0U;
+            uint64_t RebuildMicrosecondsValue = 0U;
+            for (uint32_t StepIndexValue = 0U; StepIndexValue < ChurnStepCountValue; ++StepIndexValue)
+            {
+                SchedulingStateValue.BeginMutationBatch();
+                for (size_t ChurnIndexValue = 0U; ChurnIndexValue < ChurnOrdersPerStepValue; ++ChurnIndexValue)
+                {
+                    const size_t OrderIndexValue =
+                        ((StepIndexValue * ChurnOrdersPerStepValue) + (ChurnIndexValue * 7919U)) % OrderCountValue;
+                    const EOrderLifecycleState LifecycleStateValue =
+                        SchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState;
+                    if (IsTerminalLifecycleState(LifecycleStateValue))
+                    {
+                        continue;
+                    }
+
+                    SchedulingStateValue.SetOrderLifecycleState(
+                        SchedulingStateValue.OrderIds[OrderIndexValue],
+                        LifecycleStateValue == EOrderLifecycleState::Ready ? EOrderLifecycleState::Queued
+                                                                           : EOrderLifecycleState::Ready);
+                    SchedulingStateValue.SetOrderPriorityByIndex(
+                        OrderIndexValue,
+                        SchedulingStateValue.OrderHotFields[OrderIndexValue].EffectivePriorityValue + 1,
+                        SchedulingStateValue.OrderHotFields[OrderIndexValue].PriorityTier);
+                }
+
+                const FSteadyTimePoint IncrementalStartTimeValue = FSteadyClock::now();
+                SchedulingStateValue.EndMutationBatch();
+                const FSteadyTimePoint IncrementalEndTimeValue = FSteadyClock::now();
+                IncrementalMicrosecondsValue +=
+                    GetElapsedMicroseconds(IncrementalStartTimeValue, IncrementalEndTimeValue);
+
+                const FSteadyTimePoint RebuildStartTimeValue = FSteadyClock::now();
+                SchedulingStateValue.RebuildDerivedQueues();
+                const FSteadyTimePoint RebuildEndTimeValue = FSteadyClock::now();
+                RebuildMicrosecondsValue += GetElapsedMicroseconds(RebuildStartTimeValue, RebuildEndTimeValue);
+            }
+
+            Check(!SchedulingStateValue.bDerivedQueuesDirty, SuccessValue,
+                  "Incremental derived queue updates should leave the scheduler clean after each batch.");
+            Check(SchedulingStateValue.HasConsistentDerivedQueues(), SuccessValue,
+                  "Incremental derived queue updates should match a full rebuild after churn.");
+
+            PrintProfileHeader("DerivedQueueChurn");
+            std::cout << "  Orders=" << OrderCountValue << " | ChurnPerStep=" << ChurnOrdersPerStepValue
+                      << " | AvgIncrementalUs=" << (IncrementalMicrosecondsValue / ChurnStepCountValue)
+                      << " | AvgFullRebuildUs=" << (RebuildMicrosecondsValue / ChurnStepCountValue)
+                      << std::endl;
+        }
+    }
+
+    {
+        const std::array<size_t, 3U> ViewProfileOrderCountsValue =
+        {
+            1024U,
+            4096U,
+            8192U,
+        };
+        constexpr uint32_t ViewProfileIterationsValue = 16U;
+
+        for (const size_t OrderCountValue : ViewProfileOrderCountsValue)
+        {
+            FCommandAuthoritySchedulingState SchedulingStateValue;
+            SchedulingStateValue.Reserve(OrderCountValue);
+            SchedulingStateValue.BeginMutationBatch();
+            for (size_t OrderIndexValue = 0U; OrderIndexValue < OrderCountValue; ++OrderIndexValue)
+            {
+                SchedulingStateValue.EnqueueOrder(CreateProfileOrder(OrderIndexValue));
+            }
+            SchedulingStateValue.EndMutationBatch();
+
+            uint64_t RecordChecksumValue = 0U;
+            const FSteadyTimePoint RecordStartTimeValue = FSteadyClock::now();
+            for (uint32_t IterationIndexValue = 0U; IterationIndexValue < ViewProfileIterationsValue;
+                 ++IterationIndexValue)
+            {
+                for (const size_t OrderIndexValue : SchedulingStateValue.SquadOrderIndices)
+                {
+                    const FCommandOrderRecord SquadOrderValue = SchedulingStateValue.GetOrderRecord(OrderIndexValue);
+                    RecordChecksumValue += static_cast<uint64_t>(SquadOrderValue.BasePriorityValue) +
+                                           SquadOrderValue.OrderId +
+                                           static_cast<uint64_t>(SquadOrderValue.OwningArmyIndex + 1) +
+                                           static_cast<uint64_t>(SquadOrderValue.OwningSquadIndex + 1);
+                }
+                for (const size_t OrderIndexValue : SchedulingStateValue.DispatchedOrderIndices)
+                {
+                    const FCommandOrderRecord DispatchedOrderValue =
+                        SchedulingStateValue.GetOrderRecord(OrderIndexValue);
+                    RecordChecksumValue += static_cast<uint64_t>(DispatchedOrderValue.ResultUnitTypeId) +
+                                           DispatchedOrderValue.ObservedCountAtDispatch +
+                                           DispatchedOrderValue.ObservedInConstructionCountAtDispatch +
+                                           DispatchedOrderValue.ActorTag + DispatchedOrderValue.DispatchGameLoop +
+                                           static_cast<uint64_t>(DispatchedOrderValue.AbilityId) +
+                                           DispatchedOrderValue.OrderId;
+                }
+            }
+            const FSteadyTimePoint RecordEndTimeValue = FSteadyClock::now();
+
+            uint64_t ViewChecksumValue = 0U;
+            const FSteadyTimePoint ViewStartTimeValue = FSteadyClock::now();
+            for (uint32_t IterationIndexValue = 0U; IterationIndexValue < ViewProfileIterationsValue;
+                 ++IterationIndexValue)
+            {
+                for (const size_t OrderIndexValue : SchedulingStateValue.SquadOrderIndices)
+                {
+                    const FCommandOrderView SquadOrderValue = SchedulingStateValue.GetOrderView(OrderIndexValue);
+                    ViewChecksumValue += static_cast<uint64_t>(SquadOrderValue.GetBasePriorityValue()) +
+                                         SquadOrderValue.GetOrderId() +
+                                         static_cast<uint64_t>(SquadOrderValue.GetOwningArmyIndex() + 1) +
+                                         static_cast<uint64_t>(SquadOrderValue.GetOwningSquadIndex() + 1);
+                }
+                for (const size_t OrderIndexValue : SchedulingStateValue.DispatchedOrderIndices)
+                {
+                    const FCommandOrderView DispatchedOrderValue = SchedulingStateValue.GetOrderView(OrderIndexValue);
+                    ViewChecksumValue += static_cast<uint64_t>(DispatchedOrderValue.GetResultUnitTypeId()) +
+                                         DispatchedOrderValue.GetObservedCountAtDispatch() +
+                                         DispatchedOrderValue.GetObservedInConstructionCountAtDispatch() +
+                                         DispatchedOrderValue.GetActorTag() +
+                                         DispatchedOrderValue.GetDispatchGameLoop() +
+                                         static_cast<uint64_t>(DispatchedOrderValue.GetAbilityId()) +
+                                         DispatchedOrderValue.GetOrderId();
+                }
+            }
+            const FSteadyTimePoint ViewEndTimeValue = FSteadyClock::now();
+
+            size_t ProjectedActiveSquadOrderCountValue = 0U;
+            SchedulingStateValue.ForEachActiveOrderInLayer(
+                ECommandAuthorityLayer::Squad,
+                [&ProjectedActiveSquadOrderCountValue](const size_t OrderIndexValue,
+                                                       const EOrderLifecycleState LifecycleStateValue,
+                                                       const int EffectivePriorityValue, const Tag ActorTagValue)
+                {
+                    (void)OrderIndexValue;
+                    (void)LifecycleStateValue;
+                    (void)EffectivePriorityValue;
+                    (void)ActorTagValue;
+                    ++ProjectedActiveSquadOrderCountValue;
+                });
+
+            const size_t SquadVisitCountValue = SchedulingStateValue.SquadOrderIndices.size();
+            const size_t DispatchVisitCountValue = SchedulingStateValue.DispatchedOrderIndices.size();
+            // A record copy reads one element from every column and writes a full FCommandOrderRecord.
+            const size_t RecordBytesPerStepValue =
+                (SquadVisitCountValue + DispatchVisitCountValue) * sizeof(FCommandOrderRecord);
+            const size_t ViewBytesPerStepValue =
+                (SquadVisitCountValue * GetSquadOrderViewBytesPerOrder(SchedulingStateValue)) +
+                (DispatchVisitCountValue * GetDispatchOrderViewBytesPerOrder(SchedulingStateValue));
+
+            Check(SquadVisitCountValue > 0U && DispatchVisitCountValue > 0U, SuccessValue,
+                  "Order view profiling should visit both squad and dispatched orders.");
+            Check(ViewChecksumValue == RecordChecksumValue, SuccessValue,
+                  "Order views should read the same values as materialized order records.");
+            Check(ProjectedActiveSquadOrderCountValue ==
+                      SchedulingStateValue.GetActiveOrderCountForLayer(ECommandAuthorityLayer::Squad),
+                  SuccessValue, "Column-projected iteration should visit every active order in the layer.");
+            Check(ViewBytesPerStepValue < RecordBytesPerStepValue, SuccessValue,
+                  "Order views should touch fewer bytes than materialized order records.");
+
+            PrintProfileHeader("OrderViews");
+            std::cout << "  Orders=" << OrderCountValue << " | SquadVisits=" << SquadVisitCountValue
+                      << " | DispatchVisits=" << DispatchVisitCountValue
+                      << " | AvgRecordUs="
+                      << (GetElapsedMicroseconds(RecordStartTimeValue, RecordEndTimeValue) / ViewProfileIterationsValue)
+                      << " | AvgViewUs="
+                      << (GetElapsedMicroseconds(ViewStartTimeValue, ViewEndTimeValue) / ViewProfileIterationsValue)
+                      << " | BytesTouchedBefore=" << RecordBytesPerStepValue
+                      << " | BytesTouchedAfter=" << ViewBytesPerStepValue
+                      << std::endl;
+        }
+    }
+
+    {
+        constexpr size_t TableProfileOrderCountValue = 8192U;
+        constexpr uint32_t TableProfileIterationsValue = 16U;
+
+        FCommandAuthoritySchedulingState DiagnosticStateValue;
+        FCommandAuthoritySchedulingState LeanStateValue;
+        LeanStateValue.SetDiagnosticColumnsEnabled(false);
+        DiagnosticStateValue.Reserve(TableProfileOrderCountValue);
+        LeanStateValue.Reserve(TableProfileOrderCountValue);
+        Check(DiagnosticStateValue.HasSynchronizedSizes() && LeanStateValue.HasSynchronizedSizes(), SuccessValue,
+              "Reserve should keep hot, cold and diagnostic columns synchronized.");
+
+        for (size_t OrderIndexValue = 0U; OrderIndexValue < TableProfileOrderCountValue; ++OrderIndexValue)
+        {
+            DiagnosticStateValue.EnqueueOrder(CreateProfileOrder(OrderIndexValue));
+            LeanStateValue.EnqueueOrder(CreateProfileOrder(OrderIndexValue));
+        }
+        for (size_t OrderIndexValue = 0U; OrderIndexValue < TableProfileOrderCountValue; OrderIndexValue += 4U)
+        {
+            const uint32_t OrderIdValue = DiagnosticStateValue.OrderIds[OrderIndexValue];
+            DiagnosticStateValue.SetOrderDeferralState(OrderIdValue, ECommandOrderDeferralReason::NoProducer, 64U,
+                                                       1024U);
+            LeanStateValue.SetOrderDeferralState(OrderIdValue, ECommandOrderDeferralReason::NoProducer, 64U, 1024U);
+            const uint32_t DispatchedOrderIdValue = DiagnosticStateValue.OrderIds[OrderIndexValue + 2U];
+            DiagnosticStateValue.SetOrderDispatchState(DispatchedOrderIdValue, 65U, 1040U, 2U, 1U);
+            LeanStateValue.SetOrderDispatchState(DispatchedOrderIdValue, 65U, 1040U, 2U, 1U);
+        }
+        Check(DiagnosticStateValue.HasSynchronizedSizes() && LeanStateValue.HasSynchronizedSizes(), SuccessValue,
+              "Enqueue and row mutations should keep hot, cold and diagnostic columns synchronized.");
+
+        bool bRecordsMatchValue = true;
+        for (size_t OrderIndexValue = 0U; OrderIndexValue < TableProfileOrderCountValue; ++OrderIndexValue)
+        {
+            const FCommandOrderRecord DiagnosticRecordValue = DiagnosticStateValue.GetOrderRecord(OrderIndexValue);
+            const FCommandOrderRecord LeanRecordValue = LeanStateValue.GetOrderRecord(OrderIndexValue);
+            bRecordsMatchValue = bRecordsMatchValue && DiagnosticRecordValue.OrderId == LeanRecordValue.OrderId &&
+                                 DiagnosticRecordValue.LifecycleState == LeanRecordValue.LifecycleState &&
+                                 DiagnosticRecordValue.EffectivePriorityValue ==
+                                     LeanRecordValue.EffectivePriorityValue &&
+                                 DiagnosticRecordValue.ActorTag == LeanRecordValue.ActorTag &&
+                                 DiagnosticRecordValue.Queued == LeanRecordValue.Queued &&
+                                 DiagnosticRecordValue.LastDeferralReason == LeanRecordValue.LastDeferralReason &&
+                                 DiagnosticRecordValue.DispatchGameLoop == LeanRecordValue.DispatchGameLoop &&
+                                 LeanRecordValue.LastDeferralStep == 0U && LeanRecordValue.DispatchStep == 0U;
+        }
+        Check(bRecordsMatchValue, SuccessValue,
+              "Disabling diagnostic columns should only zero the diagnostic fields of order records.");
+        Check(DiagnosticStateValue.GetOrderRecord(0U).LastDeferralStep == 64U &&
+                  DiagnosticStateValue.GetOrderRecord(2U).DispatchStep == 65U,
+              SuccessValue, "Enabled diagnostic columns should retain deferral and dispatch steps.");
+
+        const size_t DiagnosticBytesValue = GetApproximateSchedulingStateRetainedBytes(DiagnosticStateValue);
+        const size_t LeanBytesValue = GetApproximateSchedulingStateRetainedBytes(LeanStateValue);
+        Check(LeanBytesValue + (TableProfileOrderCountValue * 3U * sizeof(uint64_t)) <= DiagnosticBytesValue,
+              SuccessValue, "Disabled diagnostic columns should not retain per-order storage.");
+
+        uint64_t LayerScanChecksumValue = 0U;
+        const FSteadyTimePoint LayerScanStartTimeValue = FSteadyClock::now();
+        for (uint32_t IterationIndexValue = 0U; IterationIndexValue < TableProfileIterationsValue;
+             ++IterationIndexValue)
+        {
+            LeanStateValue.ForEachActiveOrderInLayer(
+                ECommandAuthorityLayer::EconomyAndProduction,
+                [&LayerScanChecksumValue](const size_t OrderIndexValue, const EOrderLifecycleState LifecycleStateValue,
+                                          const int EffectivePriorityValue, const Tag ActorTagValue)
+                {
+                    LayerScanChecksumValue += OrderIndexValue + static_cast<uint64_t>(LifecycleStateValue) +
+                                              static_cast<uint64_t>(EffectivePriorityValue) + ActorTagValue;
+                });
+        }
+        const FSteadyTimePoint LayerScanEndTimeValue = FSteadyClock::now();
+
+        for (size_t OrderIndexValue = 0U; OrderIndexValue < TableProfileOrderCountValue; OrderIndexValue += 2U)
+        {
+            const uint32_t OrderIdValue = DiagnosticStateValue.OrderIds[OrderIndexValue];
+            DiagnosticStateValue.SetOrderLifecycleState(OrderIdValue, EOrderLifecycleState::Completed);
+            LeanStateValue.SetOrderLifecycleState(OrderIdValue, EOrderLifecycleState::Completed);
+        }
+        DiagnosticStateValue.CompactTerminalOrders();
+        LeanStateValue.CompactTerminalOrders();
+        Check(DiagnosticStateValue.HasSynchronizedSizes() && LeanStateValue.HasSynchronizedSizes() &&
+                  DiagnosticStateValue.OrderIds.size() == LeanStateValue.OrderIds.size(),
+              SuccessValue, "Compaction should keep hot, cold and diagnostic columns synchronized.");
+
+        LeanStateValue.SetDiagnosticColumnsEnabled(true);
+        DiagnosticStateValue.SetDiagnosticColumnsEnabled(false);
+        Check(LeanStateValue.HasSynchronizedSizes() && DiagnosticStateValue.HasSynchronizedSizes() &&
+                  DiagnosticStateValue.DiagnosticColumns.LastDeferralSteps.capacity() == 0U,
+              SuccessValue, "Toggling diagnostic columns should resize or release them in step with the table.");
+
+        PrintProfileHeader("OrderTable");
+        std::cout << "  Orders=" << TableProfileOrderCountValue << " | HotRowBytes=" << sizeof(FCommandOrderHotFields)
+                  << " | BytesWithDiagnostics=" << DiagnosticBytesValue
+                  << " | BytesWithoutDiagnostics=" << LeanBytesValue << " | AvgLayerScanUs="
+                  << (GetElapsedMicroseconds(LayerScanStartTimeValue, LayerScanEndTimeValue) /
+                      TableProfileIterationsValue)
+                  << " | LayerScanChecksum=" << LayerScanChecksumValue << std::endl;
+    }
+
     {
         constexpr uint32_t AdmissionCandidateCountValue = 256U;
         FTerranCommandTaskAdmissionService CommandTaskAdmissionServiceValue;
@@ -1,10 +1,18 @@
 #include "test_singularity_framework.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <new>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "common/agent_framework.h"
@@ -13,11 +21,44 @@
 #include "sc2api/sc2_api.h"
 #include "sc2api/sc2_score.h"
 
+namespace
+{
+
+std::atomic<uint64_t> GlobalAllocationCountValue{0U};
+
+}  // namespace
+
+// Counts every global allocation in the test binary so arbitration profiles can report allocations per resolve.
+void* operator new(std::size_t SizeValue)
+{
+    GlobalAllocationCountValue.fetch_add(1U, std::memory_order_relaxed);
+    void* AllocationPtr = std::malloc(SizeValue == 0U ? 1U : SizeValue);
+    if (!AllocationPtr)
+    {
+        throw std::bad_alloc();
+    }
+    return AllocationPtr;
+}
+
+void operator delete(void* AllocationPtr) noexcept
+{
+    std::free(AllocationPtr);
+}
+
+void operator delete(void* AllocationPtr, std::size_t SizeValue) noexcept
+{
+    (void)SizeValue;
+    std::free(AllocationPtr);
+}
+
 namespace sc2
 {
 namespace
 {
 
+using FSteadyClock = std::chrono::steady_clock;
+using FSteadyTimePoint = std::chrono::time_point<FSteadyClock>;
+
 bool Check(bool Condition, bool& Success, const std::string& Message)
 {
     if (!Condition)
@@ -38,6 +79,8 @@ struct FakeQuery : QueryInterface
     bool PlacementResult = true;
     float PointPathingResult = 1.0f;
     float UnitPathingResult = 1.0f;
+    int PlacementRequestCount = 0;
+    int PathingRequestCount = 0;
 
     AvailableAbilities GetAbilitiesForUnit(const Unit* UnitPtr, bool IgnoreResourceRequirements = false,
                                            bool UseGeneralizedAbility = true) override
@@ -59,6 +102,7 @@ struct FakeQuery : QueryInterface
 
     float PathingDistance(const Point2D& Start, const Point2D& End) override
     {
+        ++PathingRequestCount;
         (void)Start;
         (void)End;
         return PointPathingResult;
@@ -66,6 +110,7 @@ struct FakeQuery : QueryInterface
 
     float PathingDistance(const Unit* Start, const Point2D& End) override
     {
+        ++PathingRequestCount;
         (void)Start;
         (void)End;
         return UnitPathingResult;
@@ -73,11 +118,19 @@ struct FakeQuery : QueryInterface
 
     std::vector<float> PathingDistance(const std::vector<PathingQuery>& Queries) override
     {
-        return std::vector<float>(Queries.size(), PointPathingResult);
+        ++PathingRequestCount;
+        std::vector<float> Distances;
+        Distances.reserve(Queries.size());
+        for (const PathingQuery& QueryValue : Queries)
+        {
+            Distances.push_back(QueryValue.start_unit_tag_ != NullTag ? UnitPathingResult : PointPathingResult);
+        }
+        return Distances;
     }
 
     bool Placement(const AbilityID& Ability, const Point2D& TargetPos, const Unit* UnitPtr = nullptr) override
     {
+        ++PlacementRequestCount;
         (void)Ability;
         (void)TargetPos;
         (void)UnitPtr;
@@ -86,8 +139,27 @@ struct FakeQuery : QueryInterface
 
     std::vector<bool> Placement(const std::vector<PlacementQuery>& Queries) override
     {
+        ++PlacementRequestCount;
         return std::vector<bool>(Queries.size(), PlacementResult);
     }
+
+    bool TryPathingDistance(const std::vector<PathingQuery>& Queries, std::vector<float>& Distances) override
+    {
+        ++PathingRequestCount;
+        Distances.clear();
+        for (const PathingQuery& QueryValue : Queries)
+        {
+            Distances.push_back(QueryValue.start_unit_tag_ != NullTag ? UnitPathingResult : PointPathingResult);
+        }
+        return true;
+    }
+
+    bool TryPlacement(const std::vector<PlacementQuery>& Queries, std::vector<bool>& Results) override
+    {
+        ++PlacementRequestCount;
+        Results.assign(Queries.size(), PlacementResult);
+        return true;
+    }
 };
 
 struct FakeObservation : ObservationInterface
@@ -524,6 +596,145 @@ bool TestContainerResetAndSync()
     return Success;
 }
 
+bool HasConsistentTagIndex(const FTerranUnitContainer& Container)
+{
+    if (Container.TagToIndexMap.size() != Container.Tags.size())
+    {
+        return false;
+    }
+    for (size_t RowIndexValue = 0; RowIndexValue < Container.Tags.size(); ++RowIndexValue)
+    {
+        const std::unordered_map<Tag, size_t>::const_iterator FoundIndex =
+            Container.TagToIndexMap.find(Container.Tags[RowIndexValue]);
+        if (FoundIndex == Container.TagToIndexMap.end() || FoundIndex->second != RowIndexValue ||
+            Container.ControlledUnits[RowIndexValue]->tag != Container.Tags[RowIndexValue])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HasMatchingRows(const FTerranUnitContainer& Container, const FTerranUnitContainer& ReferenceContainer)
+{
+    if (Container.ControlledUnits.size() != ReferenceContainer.ControlledUnits.size())
+    {
+        return false;
+    }
+    for (size_t RowIndexValue = 0; RowIndexValue < Container.Tags.size(); ++RowIndexValue)
+    {
+        const std::unordered_map<Tag, size_t>::const_iterator FoundIndex =
+            ReferenceContainer.TagToIndexMap.find(Container.Tags[RowIndexValue]);
+        if (FoundIndex == ReferenceContainer.TagToIndexMap.end())
+        {
+            return false;
+        }
+
+        const size_t ReferenceIndexValue = FoundIndex->second;
+        const FFrameArenaView<UnitOrder> OrdersValue = Container.GetOrders(RowIndexValue);
+        const FFrameArenaView<UnitOrder> ReferenceOrdersValue = ReferenceContainer.GetOrders(ReferenceIndexValue);
+        if (Container.ControlledUnits[RowIndexValue] != ReferenceContainer.ControlledUnits[ReferenceIndexValue] ||
+            Container.UnitTypes[RowIndexValue] != ReferenceContainer.UnitTypes[ReferenceIndexValue] ||
+            Container.Health[RowIndexValue] != ReferenceContainer.Health[ReferenceIndexValue] ||
+            Container.Positions[RowIndexValue].x != ReferenceContainer.Positions[ReferenceIndexValue].x ||
+            Container.Positions[RowIndexValue].y != ReferenceContainer.Positions[ReferenceIndexValue].y ||
+            Container.StateFlags.StateFlags[RowIndexValue] !=
+                ReferenceContainer.StateFlags.StateFlags[ReferenceIndexValue] ||
+            Container.GetUnitBuffs(RowIndexValue).size() !=
+                ReferenceContainer.GetUnitBuffs(ReferenceIndexValue).size() ||
+            Container.GetPassengers(RowIndexValue).size() !=
+                ReferenceContainer.GetPassengers(ReferenceIndexValue).size() ||
+            OrdersValue.size() != ReferenceOrdersValue.size())
+        {
+            return false;
+        }
+        for (size_t OrderIndexValue = 0; OrderIndexValue < OrdersValue.size(); ++OrderIndexValue)
+        {
+            if (OrdersValue[OrderIndexValue].ability_id != ReferenceOrdersValue[OrderIndexValue].ability_id ||
+                OrdersValue[OrderIndexValue].target_unit_tag != ReferenceOrdersValue[OrderIndexValue].target_unit_tag)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool TestContainerIncrementalUpdate()
+{
+    bool Success = true;
+
+    Unit WorkerUnit = MakeUnit(1, UNIT_TYPEID::TERRAN_SCV, Unit::Alliance::Self, Point2D(10.0f, 10.0f));
+    WorkerUnit.orders.push_back({ABILITY_ID::HARVEST_GATHER, NullTag, Point2D(12.0f, 12.0f), 0.5f});
+    WorkerUnit.buffs.push_back(static_cast<BuffID>(1));
+
+    Unit MarineUnit = MakeUnit(2, UNIT_TYPEID::TERRAN_MARINE, Unit::Alliance::Self, Point2D(11.0f, 11.0f));
+
+    Unit MedivacUnit = MakeUnit(3, UNIT_TYPEID::TERRAN_MEDIVAC, Unit::Alliance::Self, Point2D(14.0f, 11.0f));
+    MedivacUnit.is_flying = true;
+    MedivacUnit.passengers.push_back(PassengerUnit());
+    MedivacUnit.passengers.push_back(PassengerUnit());
+
+    Unit ReaperUnit = MakeUnit(4, UNIT_TYPEID::TERRAN_REAPER, Unit::Alliance::Self, Point2D(20.0f, 20.0f));
+    ReaperUnit.orders.push_back({ABILITY_ID::ATTACK_ATTACK, 99, Point2D(), 0.0f});
+
+    FTerranUnitContainer Container;
+    Container.UpdateUnits({&WorkerUnit, &MarineUnit, &MedivacUnit});
+    Check(Container.HasSynchronizedSizes(), Success, "UpdateUnits should keep every SoA column synchronized.");
+    Check(Container.ControlledUnits.size() == 3U, Success, "UpdateUnits should append a row for every new tag.");
+    Check(HasConsistentTagIndex(Container), Success, "UpdateUnits should keep TagToIndexMap aligned with Tags.");
+    Check(Container.GetOrders(Container.TagToIndexMap.at(1)).size() == 1U, Success,
+          "Order ranges should expose the observed order list.");
+    Check(Container.GetPassengers(Container.TagToIndexMap.at(3)).size() == 2U, Success,
+          "Passenger ranges should expose the observed passenger list.");
+
+    MarineUnit.health = 10.0f;
+    MarineUnit.pos = Point3D(30.0f, 31.0f, 0.0f);
+    MarineUnit.buffs.push_back(static_cast<BuffID>(2));
+    MedivacUnit.passengers.clear();
+    const size_t MarineRowValue = Container.TagToIndexMap.at(2);
+
+    Container.UpdateUnits({&MedivacUnit, &MarineUnit, &ReaperUnit});
+    Check(Container.HasSynchronizedSizes(), Success, "Swap-removal should keep every SoA column synchronized.");
+    Check(Container.ControlledUnits.size() == 3U, Success, "UpdateUnits should drop unobserved rows and add new ones.");
+    Check(Container.TagToIndexMap.find(1) == Container.TagToIndexMap.end(), Success,
+          "UpdateUnits should remove tags that are no longer observed.");
+    Check(HasConsistentTagIndex(Container), Success, "Swap-removal should patch the moved row in TagToIndexMap.");
+    Check(Container.TagToIndexMap.at(2) == MarineRowValue, Success,
+          "Rows that stay observed should refresh in place without moving.");
+    Check(Container.Health[MarineRowValue] == 10.0f && Container.Positions[MarineRowValue].x == 30.0f, Success,
+          "UpdateUnits should refresh scalar columns in place.");
+    Check(Container.GetUnitBuffs(MarineRowValue).size() == 1U, Success,
+          "UpdateUnits should rebuild buff ranges for refreshed rows.");
+    Check(Container.GetPassengers(Container.TagToIndexMap.at(3)).empty(), Success,
+          "UpdateUnits should rebuild passenger ranges for refreshed rows.");
+    Check(Container.StateFlags.IsFlagSet(Container.TagToIndexMap.at(3), IsFlying), Success,
+          "UpdateUnits should refresh state flags for refreshed rows.");
+
+    FTerranUnitContainer ReferenceContainer;
+    ReferenceContainer.SetUnits({&MedivacUnit, &MarineUnit, &ReaperUnit});
+    Check(HasMatchingRows(Container, ReferenceContainer), Success,
+          "UpdateUnits should hold the same rows as a full SetUnits rebuild.");
+
+    const std::vector<const Unit*> SteadyUnits = {&MedivacUnit, &MarineUnit, &ReaperUnit};
+    Container.UpdateUnits(SteadyUnits);
+    const uint64_t AllocationStartValue = GlobalAllocationCountValue.load(std::memory_order_relaxed);
+    for (size_t IterationIndexValue = 0; IterationIndexValue < 8U; ++IterationIndexValue)
+    {
+        Container.UpdateUnits(SteadyUnits);
+    }
+    const uint64_t SteadyAllocationCountValue =
+        GlobalAllocationCountValue.load(std::memory_order_relaxed) - AllocationStartValue;
+    Check(SteadyAllocationCountValue == 0U, Success,
+          "UpdateUnits should not allocate when the observed unit set is unchanged.");
+
+    Container.UpdateUnits({});
+    Check(Container.ControlledUnits.empty() && Container.HasSynchronizedSizes(), Success,
+          "UpdateUnits with no units should remove every row.");
+
+    return Success;
+}
+
 bool TestBuildingCountsAndConstructionTracking()
 {
     bool Success = true;
@@ -743,6 +954,342 @@ bool TestIntentArbitrationAndValidation()
     Check(NaNPathingRejected.empty(), Success,
           "Non-finite pathing results should be rejected before execution.");
 
+    QueryValue.UnitPathingResult = 6.0f;
+    QueryValue.PlacementRequestCount = 0;
+    QueryValue.PathingRequestCount = 0;
+
+    FIntentBuffer BatchedBuffer;
+    BatchedBuffer.Add(FUnitIntent::CreatePointTarget(WorkerUnit.tag, ABILITY_ID::BUILD_SUPPLYDEPOT,
+                                                     Point2D(30.0f, 30.0f), 100, EIntentDomain::StructureBuild, true,
+                                                     true));
+    BatchedBuffer.Add(FUnitIntent::CreatePointTarget(MarineUnit.tag, ABILITY_ID::ATTACK_ATTACK, Point2D(40.0f, 40.0f),
+                                                     50, EIntentDomain::ArmyCombat, true));
+    const std::vector<FUnitIntent> BatchedResolved = ArbiterValue.Resolve(FrameValue, Container, BatchedBuffer);
+    Check(BatchedResolved.size() == 2, Success, "Batched validation should keep every winner the queries accept.");
+    Check(QueryValue.PlacementRequestCount == 1, Success,
+          "Arbitration should send placement checks as a single batched request per resolve.");
+    Check(QueryValue.PathingRequestCount == 1, Success,
+          "Arbitration should send pathing checks as a single batched request per resolve.");
+
+    QueryValue.PlacementResult = false;
+    const std::vector<FUnitIntent> BatchedPlacementRejected =
+        ArbiterValue.Resolve(FrameValue, Container, BatchedBuffer);
+    Check(BatchedPlacementRejected.size() == 1 && BatchedPlacementRejected.front().ActorTag == MarineUnit.tag,
+          Success, "Batched placement rejections should only drop the winners they apply to.");
+    QueryValue.PlacementResult = true;
+
+    return Success;
+}
+
+std::vector<FUnitIntent> ResolveWithReferenceArbiter(const FFrameContext& Frame,
+                                                     const FTerranUnitContainer& UnitContainerValue,
+                                                     const FIntentBuffer& BufferValue)
+{
+    const FIntentArbiter ArbiterValue;
+
+    std::unordered_map<Tag, FUnitIntent> WinningIntents;
+    for (const FUnitIntent& IntentValue : BufferValue.Intents)
+    {
+        if (IntentValue.ActorTag == NullTag)
+        {
+            continue;
+        }
+
+        std::unordered_map<Tag, FUnitIntent>::iterator FoundWinner = WinningIntents.find(IntentValue.ActorTag);
+        if (FoundWinner == WinningIntents.end() || ArbiterValue.ShouldReplaceWinner(IntentValue, FoundWinner->second))
+        {
+            WinningIntents[IntentValue.ActorTag] = IntentValue;
+        }
+    }
+
+    std::vector<FUnitIntent> ResolvedIntents;
+    std::unordered_set<Tag> AddedActors;
+    std::unordered_set<Tag> ReservedBuildActors;
+    for (const FUnitIntent& OriginalIntent : BufferValue.Intents)
+    {
+        std::unordered_map<Tag, FUnitIntent>::iterator FoundWinner = WinningIntents.find(OriginalIntent.ActorTag);
+        if (FoundWinner == WinningIntents.end() || AddedActors.find(OriginalIntent.ActorTag) != AddedActors.end() ||
+            !OriginalIntent.Matches(FoundWinner->second))
+        {
+            continue;
+        }
+
+        FUnitIntent NormalizedIntent = FoundWinner->second;
+        const Unit* ActorUnit = UnitContainerValue.GetUnitByTag(NormalizedIntent.ActorTag);
+        if (!ActorUnit)
+        {
+            continue;
+        }
+        if (NormalizedIntent.Domain == EIntentDomain::StructureBuild &&
+            !ReservedBuildActors.insert(NormalizedIntent.ActorTag).second)
+        {
+            continue;
+        }
+        if (!ArbiterValue.ValidateAndNormalize(NormalizedIntent, Frame, ActorUnit))
+        {
+            continue;
+        }
+
+        ResolvedIntents.push_back(NormalizedIntent);
+        AddedActors.insert(NormalizedIntent.ActorTag);
+    }
+
+    return ResolvedIntents;
+}
+
+bool TestIntentArbitrationProfile()
+{
+    constexpr size_t ActorCountValue = 300U;
+    constexpr size_t TargetCountValue = 64U;
+    constexpr size_t IntentCountValue = 5000U;
+    constexpr size_t IterationCountValue = 200U;
+    constexpr Tag ActorTagBaseValue = 1000U;
+    constexpr Tag TargetTagBaseValue = 5000U;
+    constexpr std::array<EIntentDomain, IntentDomainCountValue> DomainsValue = {
+        EIntentDomain::Recovery, EIntentDomain::StructureBuild, EIntentDomain::StructureControl,
+        EIntentDomain::UnitProduction, EIntentDomain::ArmyCombat};
+
+    bool Success = true;
+
+    std::vector<Unit> UnitsValue;
+    UnitsValue.reserve(ActorCountValue + TargetCountValue);
+    for (size_t ActorIndexValue = 0; ActorIndexValue < ActorCountValue; ++ActorIndexValue)
+    {
+        UnitsValue.push_back(MakeUnit(ActorTagBaseValue + ActorIndexValue, UNIT_TYPEID::TERRAN_MARINE,
+                                      Unit::Alliance::Self,
+                                      Point2D(static_cast<float>(ActorIndexValue % 60U) + 1.0f,
+                                              static_cast<float>(ActorIndexValue / 60U) + 1.0f)));
+        UnitsValue.back().is_flying = (ActorIndexValue % 17U) == 0U;
+    }
+    for (size_t TargetIndexValue = 0; TargetIndexValue < TargetCountValue; ++TargetIndexValue)
+    {
+        UnitsValue.push_back(MakeUnit(TargetTagBaseValue + TargetIndexValue, UNIT_TYPEID::ZERG_ZERGLING,
+                                      Unit::Alliance::Enemy,
+                                      Point2D(50.0f, static_cast<float>(TargetIndexValue % 60U) + 1.0f)));
+    }
+
+    std::vector<const Unit*> ActorPtrs;
+    Units ObservedUnits;
+    for (size_t UnitIndexValue = 0; UnitIndexValue < UnitsValue.size(); ++UnitIndexValue)
+    {
+        if (UnitIndexValue < ActorCountValue)
+        {
+            ActorPtrs.push_back(&UnitsValue[UnitIndexValue]);
+        }
+        ObservedUnits.push_back(&UnitsValue[UnitIndexValue]);
+    }
+
+    FTerranUnitContainer Container;
+    Container.SetUnits(ActorPtrs);
+
+    FakeObservation ObservationValue;
+    ObservationValue.SetUnits(ObservedUnits);
+
+    FakeQuery QueryValue;
+    QueryValue.PlacementResult = true;
+    QueryValue.UnitPathingResult = 8.0f;
+
+    const FFrameContext FrameValue = FFrameContext::Create(&ObservationValue, &QueryValue, 12);
+
+    // Deterministic LCG so the buffer mixes priorities, domain ties, duplicates, unknown actors, and invalid targets.
+    uint64_t RandomStateValue = 0x9E3779B97F4A7C15ULL;
+    const auto NextRandom = [&RandomStateValue]()
+    {
+        RandomStateValue = RandomStateValue * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<uint32_t>(RandomStateValue >> 33U);
+    };
+
+    FIntentBuffer BufferValue;
+    BufferValue.Intents.reserve(IntentCountValue);
+    for (size_t IntentIndexValue = 0; IntentIndexValue < IntentCountValue; ++IntentIndexValue)
+    {
+        const uint32_t ActorRollValue = NextRandom() % (ActorCountValue + 8U);
+        const Tag ActorTagValue = ActorRollValue < ActorCountValue ? ActorTagBaseValue + ActorRollValue :
+                                  ActorRollValue == ActorCountValue ? NullTag : 90000U + ActorRollValue;
+        const int PriorityValue = static_cast<int>(NextRandom() % 4U) * 25;
+        const EIntentDomain DomainValue = DomainsValue[NextRandom() % IntentDomainCountValue];
+        const uint32_t TargetRollValue = NextRandom() % 8U;
+        if (TargetRollValue == 0U)
+        {
+            BufferValue.Add(FUnitIntent::CreateNoTarget(ActorTagValue, ABILITY_ID::STOP, PriorityValue, DomainValue));
+        }
+        else if (TargetRollValue <= 2U)
+        {
+            const Tag TargetTagValue = TargetTagBaseValue + (NextRandom() % (TargetCountValue + 8U));
+            BufferValue.Add(FUnitIntent::CreateUnitTarget(ActorTagValue, ABILITY_ID::ATTACK_ATTACK, TargetTagValue,
+                                                          PriorityValue, DomainValue));
+        }
+        else
+        {
+            const float PointXValue = TargetRollValue == 3U ? std::numeric_limits<float>::quiet_NaN() :
+                                                              static_cast<float>(NextRandom() % 80U);
+            const Point2D TargetPointValue(PointXValue, static_cast<float>(NextRandom() % 80U));
+            BufferValue.Add(FUnitIntent::CreatePointTarget(ActorTagValue, ABILITY_ID::MOVE_MOVE, TargetPointValue,
+                                                           PriorityValue, DomainValue, (NextRandom() % 2U) == 0U,
+                                                           DomainValue == EIntentDomain::StructureBuild));
+        }
+    }
+
+    FIntentArbiter ArbiterValue;
+    std::vector<FUnitIntent> ResolvedIntents;
+    ArbiterValue.Resolve(FrameValue, Container, BufferValue, ResolvedIntents);
+
+    const std::vector<FUnitIntent> ReferenceIntents = ResolveWithReferenceArbiter(FrameValue, Container, BufferValue);
+    bool bMatchesReferenceValue = ResolvedIntents.size() == ReferenceIntents.size();
+    for (size_t IntentIndexValue = 0; bMatchesReferenceValue && IntentIndexValue < ResolvedIntents.size();
+         ++IntentIndexValue)
+    {
+        const FUnitIntent& ResolvedIntent = ResolvedIntents[IntentIndexValue];
+        const FUnitIntent& ReferenceIntent = ReferenceIntents[IntentIndexValue];
+        bMatchesReferenceValue = ResolvedIntent.Matches(ReferenceIntent);
+    }
+    Check(bMatchesReferenceValue, Success,
+          "Dense-slot arbitration should match the reference winners, order, and normalization.");
+    Check(!ResolvedIntents.empty() && ResolvedIntents.size() <= ActorCountValue, Success,
+          "Dense-slot arbitration should resolve at most one intent per controlled actor.");
+
+    const uint64_t ReferenceAllocationStartValue = GlobalAllocationCountValue.load(std::memory_order_relaxed);
+    const FSteadyTimePoint ReferenceStartTimeValue = FSteadyClock::now();
+    size_t ReferenceResolvedCountValue = 0U;
+    for (size_t IterationIndexValue = 0; IterationIndexValue < IterationCountValue; ++IterationIndexValue)
+    {
+        ReferenceResolvedCountValue += ResolveWithReferenceArbiter(FrameValue, Container, BufferValue).size();
+    }
+    const FSteadyTimePoint ReferenceEndTimeValue = FSteadyClock::now();
+    const uint64_t ReferenceAllocationCountValue =
+        GlobalAllocationCountValue.load(std::memory_order_relaxed) - ReferenceAllocationStartValue;
+
+    const uint64_t DenseAllocationStartValue = GlobalAllocationCountValue.load(std::memory_order_relaxed);
+    const FSteadyTimePoint DenseStartTimeValue = FSteadyClock::now();
+    size_t DenseResolvedCountValue = 0U;
+    for (size_t IterationIndexValue = 0; IterationIndexValue < IterationCountValue; ++IterationIndexValue)
+    {
+        ArbiterValue.Resolve(FrameValue, Container, BufferValue, ResolvedIntents);
+        DenseResolvedCountValue += ResolvedIntents.size();
+    }
+    const FSteadyTimePoint DenseEndTimeValue = FSteadyClock::now();
+    const uint64_t DenseAllocationCountValue =
+        GlobalAllocationCountValue.load(std::memory_order_relaxed) - DenseAllocationStartValue;
+
+    Check(DenseResolvedCountValue == ReferenceResolvedCountValue, Success,
+          "Repeated dense-slot resolves should stay consistent with the reference arbiter.");
+    Check(DenseAllocationCountValue == 0U, Success,
+          "Steady-state dense-slot arbitration should not allocate once scratch storage is warm.");
+
+    const double ReferenceMicrosecondsPerCallValue =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(ReferenceEndTimeValue -
+                                                                                 ReferenceStartTimeValue)
+                                .count()) /
+        1000.0 / static_cast<double>(IterationCountValue);
+    const double DenseMicrosecondsPerCallValue =
+        static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(DenseEndTimeValue - DenseStartTimeValue).count()) /
+        1000.0 / static_cast<double>(IterationCountValue);
+
+    std::cout << "    IntentArbitration Intents=" << IntentCountValue << " | Actors=" << ActorCountValue
+              << " | Resolved=" << ResolvedIntents.size() << std::endl;
+    std::cout << "    ReferenceUsPerCall=" << ReferenceMicrosecondsPerCallValue
+              << " | ReferenceAllocationsPerCall="
+              << (static_cast<double>(ReferenceAllocationCountValue) / static_cast<double>(IterationCountValue))
+              << std::endl;
+    std::cout << "    DenseUsPerCall=" << DenseMicrosecondsPerCallValue << " | DenseAllocationsPerCall="
+              << (static_cast<double>(DenseAllocationCountValue) / static_cast<double>(IterationCountValue))
+              << std::endl;
+
+    return Success;
+}
+
+bool TestContainerUpdateProfile()
+{
+    constexpr std::array<size_t, 4> UnitCountsValue = {50U, 200U, 500U, 1000U};
+    constexpr size_t IterationCountValue = 200U;
+    constexpr Tag UnitTagBaseValue = 1000U;
+
+    bool Success = true;
+
+    for (const size_t UnitCountValue : UnitCountsValue)
+    {
+        // Alternate between two observations that differ by a small churn window so each step refreshes most rows,
+        // removes a few, and appends a few, like a real game with deaths and new production.
+        const size_t ChurnCountValue = std::max<size_t>(1U, UnitCountValue / 50U);
+        std::vector<Unit> UnitsValue;
+        UnitsValue.reserve(UnitCountValue + ChurnCountValue);
+        for (size_t UnitIndexValue = 0; UnitIndexValue < UnitCountValue + ChurnCountValue; ++UnitIndexValue)
+        {
+            UnitsValue.push_back(MakeUnit(UnitTagBaseValue + UnitIndexValue, UNIT_TYPEID::TERRAN_MARINE,
+                                          Unit::Alliance::Self,
+                                          Point2D(static_cast<float>(UnitIndexValue % 100U) + 1.0f,
+                                                  static_cast<float>(UnitIndexValue / 100U) + 1.0f)));
+            UnitsValue.back().orders.push_back({ABILITY_ID::MOVE_MOVE, NullTag, Point2D(50.0f, 50.0f), 0.0f});
+            if ((UnitIndexValue % 4U) == 0U)
+            {
+                UnitsValue.back().buffs.push_back(static_cast<BuffID>(1));
+            }
+        }
+
+        std::array<std::vector<const Unit*>, 2> FrameUnitsValue;
+        for (size_t UnitIndexValue = 0; UnitIndexValue < UnitCountValue; ++UnitIndexValue)
+        {
+            FrameUnitsValue[0].push_back(&UnitsValue[UnitIndexValue]);
+            FrameUnitsValue[1].push_back(&UnitsValue[UnitIndexValue + ChurnCountValue]);
+        }
+
+        FTerranUnitContainer RebuildContainer;
+        FTerranUnitContainer DiffContainer;
+        bool bMatchesRebuildValue = true;
+        for (size_t WarmupIndexValue = 0; WarmupIndexValue < 4U; ++WarmupIndexValue)
+        {
+            RebuildContainer.SetUnits(FrameUnitsValue[WarmupIndexValue % 2U]);
+            DiffContainer.UpdateUnits(FrameUnitsValue[WarmupIndexValue % 2U]);
+            bMatchesRebuildValue = bMatchesRebuildValue && DiffContainer.HasSynchronizedSizes() &&
+                                   HasConsistentTagIndex(DiffContainer) &&
+                                   HasMatchingRows(DiffContainer, RebuildContainer);
+        }
+        Check(bMatchesRebuildValue, Success, "Incremental updates should match full rebuilds under unit churn.");
+
+        const uint64_t RebuildAllocationStartValue = GlobalAllocationCountValue.load(std::memory_order_relaxed);
+        const FSteadyTimePoint RebuildStartTimeValue = FSteadyClock::now();
+        for (size_t IterationIndexValue = 0; IterationIndexValue < IterationCountValue; ++IterationIndexValue)
+        {
+            RebuildContainer.SetUnits(FrameUnitsValue[IterationIndexValue % 2U]);
+        }
+        const FSteadyTimePoint RebuildEndTimeValue = FSteadyClock::now();
+        const uint64_t RebuildAllocationCountValue =
+            GlobalAllocationCountValue.load(std::memory_order_relaxed) - RebuildAllocationStartValue;
+
+        const uint64_t DiffAllocationStartValue = GlobalAllocationCountValue.load(std::memory_order_relaxed);
+        const FSteadyTimePoint DiffStartTimeValue = FSteadyClock::now();
+        for (size_t IterationIndexValue = 0; IterationIndexValue < IterationCountValue; ++IterationIndexValue)
+        {
+            DiffContainer.UpdateUnits(FrameUnitsValue[IterationIndexValue % 2U]);
+        }
+        const FSteadyTimePoint DiffEndTimeValue = FSteadyClock::now();
+        const uint64_t DiffAllocationCountValue =
+            GlobalAllocationCountValue.load(std::memory_order_relaxed) - DiffAllocationStartValue;
+
+        Check(DiffContainer.ControlledUnits.size() == UnitCountValue && DiffContainer.HasSynchronizedSizes(), Success,
+              "Repeated incremental updates should keep one synchronized row per observed unit.");
+        Check(DiffAllocationCountValue <= IterationCountValue * ChurnCountValue, Success,
+              "Incremental updates should only allocate tag index nodes for newly observed units.");
+
+        const double RebuildMicrosecondsPerStepValue =
+            static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(RebuildEndTimeValue -
+                                                                                     RebuildStartTimeValue)
+                                    .count()) /
+            1000.0 / static_cast<double>(IterationCountValue);
+        const double DiffMicrosecondsPerStepValue =
+            static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(DiffEndTimeValue - DiffStartTimeValue).count()) /
+            1000.0 / static_cast<double>(IterationCountValue);
+
+        std::cout << "    ContainerUpdate Units=" << UnitCountValue << " | ChurnPerStep=" << ChurnCountValue
+                  << " | RebuildUsPerStep=" << RebuildMicrosecondsPerStepValue << " | RebuildAllocationsPerStep="
+                  << (static_cast<double>(RebuildAllocationCountValue) / static_cast<double>(IterationCountValue))
+                  << " | DiffUsPerStep=" << DiffMicrosecondsPerStepValue << " | DiffAllocationsPerStep="
+                  << (static_cast<double>(DiffAllocationCountValue) / static_cast<double>(IterationCountValue))
+                  << std::endl;
+    }
+
     return Success;
 }
 
@@ -758,6 +1305,9 @@ bool TestSingularityFramework(int ArgC, char** ArgV)
     std::cout << "  Checking Singularity container sync..." << std::endl;
     Success = TestContainerResetAndSync() && Success;
 
+    std::cout << "  Checking Singularity incremental container updates..." << std::endl;
+    Success = TestContainerIncrementalUpdate() && Success;
+
     std::cout << "  Checking Singularity state counting..." << std::endl;
     Success = TestBuildingCountsAndConstructionTracking() && Success;
 
@@ -767,6 +1317,12 @@ bool TestSingularityFramework(int ArgC, char** ArgV)
     std::cout << "  Checking Singularity intent arbitration..." << std::endl;
     Success = TestIntentArbitrationAndValidation() && Success;
 
+    std::cout << "  Profiling Singularity intent arbitration..." << std::endl;
+    Success = TestIntentArbitrationProfile() && Success;
+
+    std::cout << "  Profiling Singularity container updates..." << std::endl;
+    Success = TestContainerUpdateProfile() && Success;
+
     return Success;
 }
 
@@ -0,0 +1,421 @@
+#include "test_spatial_field_builder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/services/FTerranSpatialFieldBuilder.h"
+#include "common/spatial/FSpatialFieldSet.h"
+#include "sc2api/sc2_common.h"
+#include "sc2api/sc2_data.h"
+#include "sc2api/sc2_unit.h"
+
+namespace sc2
+{
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+using FSteadyTimePoint = FSteadyClock::time_point;
+
+constexpr uint32_t MapWidthValue = 200U;
+constexpr uint32_t MapHeightValue = 200U;
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const std::string& MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+uint64_t GetElapsedMicroseconds(const FSteadyTimePoint& StartTimeValue, const FSteadyTimePoint& EndTimeValue)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(EndTimeValue - StartTimeValue).count());
+}
+
+void AddGroundWeapon(const UNIT_TYPEID UnitTypeIdValue, const float DamageValue, const float RangeValue,
+                     const float SpeedValue, UnitTypes& UnitTypesValue)
+{
+    const size_t UnitTypeIndexValue = static_cast<size_t>(UnitTypeIdValue);
+    if (UnitTypesValue.size() <= UnitTypeIndexValue)
+    {
+        UnitTypesValue.resize(UnitTypeIndexValue + 1U);
+    }
+
+    Weapon WeaponValue;
+    WeaponValue.type = Weapon::TargetType::Any;
+    WeaponValue.damage_ = DamageValue;
+    WeaponValue.attacks = 1U;
+    WeaponValue.range = RangeValue;
+    WeaponValue.speed = SpeedValue;
+    UnitTypesValue[UnitTypeIndexValue].weapons.push_back(WeaponValue);
+}
+
+UnitTypes MakeUnitTypes()
+{
+    UnitTypes UnitTypesValue;
+    AddGroundWeapon(UNIT_TYPEID::TERRAN_MARINE, 6.0f, 5.0f, 0.61f, UnitTypesValue);
+    AddGroundWeapon(UNIT_TYPEID::PROTOSS_STALKER, 13.0f, 6.0f, 1.34f, UnitTypesValue);
+    AddGroundWeapon(UNIT_TYPEID::ZERG_ZERGLING, 5.0f, 0.1f, 0.497f, UnitTypesValue);
+    return UnitTypesValue;
+}
+
+Unit MakeUnit(const Tag TagValue, const UNIT_TYPEID UnitTypeIdValue, const Unit::Alliance AllianceValue,
+              const Point2D& PositionValue)
+{
+    Unit UnitValue;
+    UnitValue.alliance = AllianceValue;
+    UnitValue.tag = TagValue;
+    UnitValue.unit_type = UnitTypeIdValue;
+    UnitValue.pos = Point3D(PositionValue.x, PositionValue.y, 0.0f);
+    UnitValue.radius = 0.375f;
+    UnitValue.build_progress = 1.0f;
+    return UnitValue;
+}
+
+void PopulateArmies(const size_t UnitCountValue, const uint32_t SeedValue, std::vector<Unit>& OutUnitStorageValue)
+{
+    std::mt19937 RandomEngineValue(SeedValue);
+    std::uniform_real_distribution<float> CoordinateDistributionValue(10.0f, 190.0f);
+    std::uniform_int_distribution<int> KindDistributionValue(0, 2);
+
+    OutUnitStorageValue.clear();
+    for (size_t UnitIndexValue = 0U; UnitIndexValue < UnitCountValue; ++UnitIndexValue)
+    {
+        const bool IsEnemyValue = (UnitIndexValue % 2U) == 1U;
+        const int KindValue = KindDistributionValue(RandomEngineValue);
+        const UNIT_TYPEID UnitTypeIdValue = !IsEnemyValue  ? UNIT_TYPEID::TERRAN_MARINE
+                                            : KindValue == 0 ? UNIT_TYPEID::ZERG_ZERGLING
+                                                             : UNIT_TYPEID::PROTOSS_STALKER;
+        const Point2D PositionValue(CoordinateDistributionValue(RandomEngineValue),
+                                    CoordinateDistributionValue(RandomEngineValue));
+        OutUnitStorageValue.push_back(MakeUnit(1000U + UnitIndexValue, UnitTypeIdValue,
+                                               IsEnemyValue ? Unit::Alliance::Enemy : Unit::Alliance::Self,
+                                               PositionValue));
+    }
+}
+
+Units GetUnitPointers(const std::vector<Unit>& UnitStorageValue)
+{
+    Units UnitsValue;
+    for (const Unit& UnitValue : UnitStorageValue)
+    {
+        UnitsValue.push_back(&UnitValue);
+    }
+    return UnitsValue;
+}
+
+// Moves roughly one unit in MoveModulo by a whole tile, kills one and spawns one, like a skirmish step.
+void AdvanceArmies(const uint32_t StepValue, const size_t MoveModuloValue, std::mt19937& RandomEngineValue,
+                   std::vector<Unit>& UnitStorageValue, Tag& NextTagValue)
+{
+    std::uniform_int_distribution<int> DirectionDistributionValue(-1, 1);
+    for (size_t UnitIndexValue = StepValue % MoveModuloValue; UnitIndexValue < UnitStorageValue.size();
+         UnitIndexValue += MoveModuloValue)
+    {
+        Unit& UnitValue = UnitStorageValue[UnitIndexValue];
+        const float DeltaXValue = static_cast<float>(DirectionDistributionValue(RandomEngineValue));
+        UnitValue.pos.x = std::clamp(UnitValue.pos.x + DeltaXValue, 1.0f, static_cast<float>(MapWidthValue) - 1.0f);
+        // Wrap instead of clamping so every move is a whole tile; sub-tile moves are deliberately left stale.
+        UnitValue.pos.y += 1.0f;
+        if (UnitValue.pos.y >= static_cast<float>(MapHeightValue) - 1.0f)
+        {
+            UnitValue.pos.y -= static_cast<float>(MapHeightValue) - 20.0f;
+        }
+    }
+
+    if (UnitStorageValue.empty())
+    {
+        return;
+    }
+
+    const size_t RemovedIndexValue = RandomEngineValue() % UnitStorageValue.size();
+    Unit ReplacementValue = UnitStorageValue[RemovedIndexValue];
+    ReplacementValue.tag = NextTagValue++;
+    ReplacementValue.pos.x = std::clamp(ReplacementValue.pos.x + 7.0f, 1.0f, static_cast<float>(MapWidthValue) - 1.0f);
+    UnitStorageValue[RemovedIndexValue] = ReplacementValue;
+}
+
+float GetMaxFieldError(const std::vector<float>& ActualValues, const std::vector<float>& ExpectedValues)
+{
+    if (ActualValues.size() != ExpectedValues.size())
+    {
+        return 1.0e9f;
+    }
+
+    float MaxErrorValue = 0.0f;
+    for (size_t IndexValue = 0U; IndexValue < ActualValues.size(); ++IndexValue)
+    {
+        const float ErrorValue = std::fabs(ActualValues[IndexValue] - ExpectedValues[IndexValue]) /
+                                 std::max(1.0f, std::fabs(ExpectedValues[IndexValue]));
+        MaxErrorValue = std::max(MaxErrorValue, ErrorValue);
+    }
+    return MaxErrorValue;
+}
+
+float GetMaxFieldSetError(const FSpatialFieldSet& ActualValue, const FSpatialFieldSet& ExpectedValue)
+{
+    return std::max({GetMaxFieldError(ActualValue.EnemyGroundThreat, ExpectedValue.EnemyGroundThreat),
+                     GetMaxFieldError(ActualValue.FriendlyGroundInfluence, ExpectedValue.FriendlyGroundInfluence),
+                     GetMaxFieldError(ActualValue.RetreatSafety, ExpectedValue.RetreatSafety),
+                     GetMaxFieldError(ActualValue.EngageOpportunity, ExpectedValue.EngageOpportunity)});
+}
+
+bool TestSingleUnitKernel()
+{
+    bool SuccessValue = true;
+
+    const UnitTypes UnitTypesValue = MakeUnitTypes();
+    std::vector<Unit> UnitStorageValue;
+    UnitStorageValue.push_back(
+        MakeUnit(1U, UNIT_TYPEID::PROTOSS_STALKER, Unit::Alliance::Enemy, Point2D(50.5f, 40.5f)));
+    UnitStorageValue.push_back(
+        MakeUnit(2U, UNIT_TYPEID::TERRAN_MARINE, Unit::Alliance::Self, Point2D(150.5f, 140.5f)));
+    Unit UnfinishedUnitValue =
+        MakeUnit(3U, UNIT_TYPEID::PROTOSS_STALKER, Unit::Alliance::Enemy, Point2D(100.5f, 20.5f));
+    UnfinishedUnitValue.build_progress = 0.5f;
+    UnitStorageValue.push_back(UnfinishedUnitValue);
+
+    FTerranSpatialFieldBuilder BuilderValue;
+    FSpatialFieldSet SpatialFieldSetValue;
+    BuilderValue.UpdateSpatialFieldSet(GetUnitPointers(UnitStorageValue), UnitTypesValue, MapWidthValue,
+                                       MapHeightValue, SpatialFieldSetValue);
+
+    Check(SpatialFieldSetValue.IsValid() && SpatialFieldSetValue.Width == MapWidthValue, SuccessValue,
+          "The builder should size the field set to the map.");
+    Check(BuilderValue.WasLastUpdateFullRebuild(), SuccessValue, "The first update should be a full rebuild.");
+
+    const float StalkerDpsValue = 13.0f / 1.34f;
+    const float CenterThreatValue =
+        SpatialFieldSetValue.SampleField(SpatialFieldSetValue.EnemyGroundThreat, Point2D(50.5f, 40.5f));
+    const float InRangeThreatValue =
+        SpatialFieldSetValue.SampleField(SpatialFieldSetValue.EnemyGroundThreat, Point2D(55.5f, 40.5f));
+    const float FalloffThreatValue =
+        SpatialFieldSetValue.SampleField(SpatialFieldSetValue.EnemyGroundThreat, Point2D(58.5f, 40.5f));
+    const float OutOfRangeThreatValue =
+        SpatialFieldSetValue.SampleField(SpatialFieldSetValue.EnemyGroundThreat, Point2D(60.5f, 40.5f));
+    Check(std::fabs(CenterThreatValue - StalkerDpsValue) < 1.0e-3f &&
+              std::fabs(InRangeThreatValue - StalkerDpsValue) < 1.0e-3f,
+          SuccessValue, "Tiles inside weapon range should carry the full DPS.");
+    Check(FalloffThreatValue > 0.0f && FalloffThreatValue < StalkerDpsValue, SuccessValue,
+          "Tiles just past weapon range should carry partial threat.");
+    Check(OutOfRangeThreatValue == 0.0f, SuccessValue, "Tiles past the falloff should carry no threat.");
+    Check(SpatialFieldSetValue.SampleField(SpatialFieldSetValue.EnemyGroundThreat, Point2D(100.5f, 20.5f)) == 0.0f,
+          SuccessValue, "Units under construction should not project threat.");
+    Check(SpatialFieldSetValue.SampleField(SpatialFieldSetValue.FriendlyGroundInfluence, Point2D(150.5f, 140.5f)) >
+              0.0f,
+          SuccessValue, "Friendly units should feed friendly influence.");
+    Check(SpatialFieldSetValue.SampleField(SpatialFieldSetValue.RetreatSafety, Point2D(50.5f, 40.5f)) < 0.5f &&
+              SpatialFieldSetValue.SampleField(SpatialFieldSetValue.RetreatSafety, Point2D(150.5f, 140.5f)) == 1.0f,
+          SuccessValue, "Retreat safety should drop under enemy threat and stay at one elsewhere.");
+    Check(SpatialFieldSetValue.SampleField(SpatialFieldSetValue.EnemyGroundThreat, Point2D(-1.0f, 40.0f)) == 0.0f &&
+              SpatialFieldSetValue.SampleField(SpatialFieldSetValue.EnemyGroundThreat, Point2D(40.0f, 400.0f)) == 0.0f,
+          SuccessValue, "Sampling outside the map should return zero.");
+    return SuccessValue;
+}
+
+bool TestIncrementalMatchesFullRebuild()
+{
+    constexpr size_t UnitCountValue = 300U;
+    constexpr uint32_t StepCountValue = 60U;
+
+    bool SuccessValue = true;
+
+    const UnitTypes UnitTypesValue = MakeUnitTypes();
+    std::vector<Unit> UnitStorageValue;
+    PopulateArmies(UnitCountValue, 11U, UnitStorageValue);
+    std::mt19937 RandomEngineValue(17U);
+    Tag NextTagValue = 100000U;
+
+    FTerranSpatialFieldBuilder IncrementalBuilderValue;
+    IncrementalBuilderValue.SetFullRebuildInterval(0U);
+    FSpatialFieldSet IncrementalFieldSetValue;
+    IncrementalBuilderValue.UpdateSpatialFieldSet(GetUnitPointers(UnitStorageValue), UnitTypesValue, MapWidthValue,
+                                                  MapHeightValue, IncrementalFieldSetValue);
+
+    float MaxErrorValue = 0.0f;
+    bool bAnyFullRebuildValue = false;
+    uint64_t DerivedTileCountValue = 0U;
+    for (uint32_t StepValue = 0U; StepValue < StepCountValue; ++StepValue)
+    {
+        AdvanceArmies(StepValue, 8U, RandomEngineValue, UnitStorageValue, NextTagValue);
+        const Units UnitsValue = GetUnitPointers(UnitStorageValue);
+        IncrementalBuilderValue.UpdateSpatialFieldSet(UnitsValue, UnitTypesValue, MapWidthValue, MapHeightValue,
+                                                      IncrementalFieldSetValue);
+        bAnyFullRebuildValue = bAnyFullRebuildValue || IncrementalBuilderValue.WasLastUpdateFullRebuild();
+        DerivedTileCountValue += IncrementalBuilderValue.GetLastDerivedTileCount();
+
+        FTerranSpatialFieldBuilder FullBuilderValue;
+        FSpatialFieldSet FullFieldSetValue;
+        FullBuilderValue.UpdateSpatialFieldSet(UnitsValue, UnitTypesValue, MapWidthValue, MapHeightValue,
+                                               FullFieldSetValue);
+        MaxErrorValue = std::max(MaxErrorValue, GetMaxFieldSetError(IncrementalFieldSetValue, FullFieldSetValue));
+    }
+
+    Check(!bAnyFullRebuildValue, SuccessValue, "Updates with a stable map size should stay incremental.");
+    Check(MaxErrorValue < 1.0e-3f, SuccessValue,
+          "Incremental updates should match a full rebuild; max relative error " + std::to_string(MaxErrorValue) + ".");
+    Check(DerivedTileCountValue < static_cast<uint64_t>(StepCountValue) * MapWidthValue * MapHeightValue, SuccessValue,
+          "Incremental updates should only rederive the tiles under changed kernels.");
+
+    // A replaced descriptor arrives as an empty field set and must trigger a rebuild rather than a diff.
+    FSpatialFieldSet ReplacedFieldSetValue;
+    IncrementalBuilderValue.UpdateSpatialFieldSet(GetUnitPointers(UnitStorageValue), UnitTypesValue, MapWidthValue,
+                                                  MapHeightValue, ReplacedFieldSetValue);
+    Check(IncrementalBuilderValue.WasLastUpdateFullRebuild() &&
+              GetMaxFieldSetError(ReplacedFieldSetValue, IncrementalFieldSetValue) < 1.0e-3f,
+          SuccessValue, "An invalid field set should be rebuilt from scratch.");
+    return SuccessValue;
+}
+
+bool TestKernelUpdateBudget()
+{
+    constexpr uint32_t BudgetValue = 16U;
+
+    bool SuccessValue = true;
+
+    const UnitTypes UnitTypesValue = MakeUnitTypes();
+    std::vector<Unit> UnitStorageValue;
+    PopulateArmies(120U, 23U, UnitStorageValue);
+
+    FTerranSpatialFieldBuilder BuilderValue;
+    BuilderValue.SetMaxKernelUpdatesPerStep(BudgetValue);
+    FSpatialFieldSet SpatialFieldSetValue;
+    BuilderValue.UpdateSpatialFieldSet(GetUnitPointers(UnitStorageValue), UnitTypesValue, MapWidthValue,
+                                       MapHeightValue, SpatialFieldSetValue);
+
+    for (Unit& UnitValue : UnitStorageValue)
+    {
+        UnitValue.pos.y = std::min(UnitValue.pos.y + 2.0f, static_cast<float>(MapHeightValue) - 1.0f);
+    }
+    const Units UnitsValue = GetUnitPointers(UnitStorageValue);
+    BuilderValue.UpdateSpatialFieldSet(UnitsValue, UnitTypesValue, MapWidthValue, MapHeightValue,
+                                       SpatialFieldSetValue);
+    Check(BuilderValue.GetLastKernelUpdateCount() == BudgetValue &&
+              BuilderValue.GetLastDeferredKernelCount() == UnitStorageValue.size() - BudgetValue,
+          SuccessValue, "Kernel updates over the budget should be deferred.");
+
+    uint32_t StepCountValue = 1U;
+    while (BuilderValue.GetLastDeferredKernelCount() > 0U && StepCountValue < 100U)
+    {
+        BuilderValue.UpdateSpatialFieldSet(UnitsValue, UnitTypesValue, MapWidthValue, MapHeightValue,
+                                           SpatialFieldSetValue);
+        ++StepCountValue;
+    }
+
+    const uint32_t ExpectedStepCountValue =
+        static_cast<uint32_t>((UnitStorageValue.size() + BudgetValue - 1U) / BudgetValue);
+    Check(StepCountValue == ExpectedStepCountValue, SuccessValue,
+          "Deferred kernels should drain at the budget rate; took " + std::to_string(StepCountValue) + " steps.");
+
+    FTerranSpatialFieldBuilder FullBuilderValue;
+    FSpatialFieldSet FullFieldSetValue;
+    FullBuilderValue.UpdateSpatialFieldSet(UnitsValue, UnitTypesValue, MapWidthValue, MapHeightValue,
+                                           FullFieldSetValue);
+    Check(GetMaxFieldSetError(SpatialFieldSetValue, FullFieldSetValue) < 1.0e-3f, SuccessValue,
+          "Fields should converge to a full rebuild once the deferred kernels drain.");
+    return SuccessValue;
+}
+
+bool TestSpatialFieldUpdateProfile()
+{
+    constexpr size_t UnitCountValue = 300U;
+    constexpr uint32_t StepCountValue = 100U;
+
+    bool SuccessValue = true;
+
+    const UnitTypes UnitTypesValue = MakeUnitTypes();
+    std::vector<Unit> UnitStorageValue;
+    PopulateArmies(UnitCountValue, 29U, UnitStorageValue);
+    std::mt19937 RandomEngineValue(31U);
+    Tag NextTagValue = 100000U;
+
+    FTerranSpatialFieldBuilder FullBuilderValue;
+    FTerranSpatialFieldBuilder IncrementalBuilderValue;
+    IncrementalBuilderValue.SetFullRebuildInterval(0U);
+    FSpatialFieldSet FullFieldSetValue;
+    FSpatialFieldSet IncrementalFieldSetValue;
+    IncrementalBuilderValue.UpdateSpatialFieldSet(GetUnitPointers(UnitStorageValue), UnitTypesValue, MapWidthValue,
+                                                  MapHeightValue, IncrementalFieldSetValue);
+
+    uint64_t FullMicrosecondsValue = 0U;
+    uint64_t IncrementalMicrosecondsValue = 0U;
+    uint64_t MaxIncrementalMicrosecondsValue = 0U;
+    uint64_t KernelUpdateCountValue = 0U;
+    for (uint32_t StepValue = 0U; StepValue < StepCountValue; ++StepValue)
+    {
+        AdvanceArmies(StepValue, 10U, RandomEngineValue, UnitStorageValue, NextTagValue);
+        const Units UnitsValue = GetUnitPointers(UnitStorageValue);
+
+        FullBuilderValue.Invalidate();
+        const FSteadyTimePoint FullStartTimeValue = FSteadyClock::now();
+        FullBuilderValue.UpdateSpatialFieldSet(UnitsValue, UnitTypesValue, MapWidthValue, MapHeightValue,
+                                               FullFieldSetValue);
+        FullMicrosecondsValue += GetElapsedMicroseconds(FullStartTimeValue, FSteadyClock::now());
+
+        const FSteadyTimePoint IncrementalStartTimeValue = FSteadyClock::now();
+        IncrementalBuilderValue.UpdateSpatialFieldSet(UnitsValue, UnitTypesValue, MapWidthValue, MapHeightValue,
+                                                      IncrementalFieldSetValue);
+        const uint64_t StepMicrosecondsValue =
+            GetElapsedMicroseconds(IncrementalStartTimeValue, FSteadyClock::now());
+        IncrementalMicrosecondsValue += StepMicrosecondsValue;
+        MaxIncrementalMicrosecondsValue = std::max(MaxIncrementalMicrosecondsValue, StepMicrosecondsValue);
+        KernelUpdateCountValue += IncrementalBuilderValue.GetLastKernelUpdateCount();
+    }
+
+    const float MaxErrorValue = GetMaxFieldSetError(IncrementalFieldSetValue, FullFieldSetValue);
+    Check(MaxErrorValue < 1.0e-3f, SuccessValue,
+          "The profiled incremental fields should match the full rebuild; max relative error " +
+              std::to_string(MaxErrorValue) + ".");
+
+    const uint64_t FullUsPerStepValue = FullMicrosecondsValue / StepCountValue;
+    const uint64_t IncrementalUsPerStepValue = IncrementalMicrosecondsValue / StepCountValue;
+    std::cout << "    Map=" << MapWidthValue << "x" << MapHeightValue << " | Units=" << UnitCountValue
+              << " | KernelUpdatesPerStep=" << KernelUpdateCountValue / StepCountValue
+              << " | FullUsPerStep=" << FullUsPerStepValue << " | IncrementalUsPerStep=" << IncrementalUsPerStepValue
+              << " | IncrementalMaxUs=" << MaxIncrementalMicrosecondsValue << " | Speedup=" << std::fixed
+              << std::setprecision(1)
+              << (IncrementalUsPerStepValue > 0U
+                      ? static_cast<double>(FullUsPerStepValue) / static_cast<double>(IncrementalUsPerStepValue)
+                      : 0.0)
+              << "x" << std::defaultfloat << std::endl;
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestSpatialFieldBuilder(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking single-unit threat kernels..." << std::endl;
+    SuccessValue = TestSingleUnitKernel() && SuccessValue;
+
+    std::cout << "  Checking incremental updates against full rebuilds..." << std::endl;
+    SuccessValue = TestIncrementalMatchesFullRebuild() && SuccessValue;
+
+    std::cout << "  Checking the per-step kernel update budget..." << std::endl;
+    SuccessValue = TestKernelUpdateBudget() && SuccessValue;
+
+    std::cout << "  Profiling spatial field updates..." << std::endl;
+    SuccessValue = TestSpatialFieldUpdateProfile() && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
@@ -17,7 +17,9 @@
 #include "common/planning/FTerranArmyOrderExpander.h"
 #include "common/planning/FTerranArmyUnitExecutionPlanner.h"
 #include "common/planning/FTerranSquadOrderExpander.h"
+#include "common/spatial/FGroundPathfinder.h"
 #include "sc2api/sc2_api.h"
+#include "sc2api/sc2_map_info.h"
 #include "sc2api/sc2_score.h"
 
 namespace sc2
@@ -338,6 +340,33 @@ void AppendUnitPointers(const std::vector<Unit>& UnitStorageValue, Units& OutUni
     }
 }
 
+// Open 48x48 ground split by an unbroken wall along x = 22.
+MapGrids CreateWalledMapGrids()
+{
+    constexpr int32_t MapSizeValue = 48;
+    constexpr int32_t WallXValue = 22;
+    GameInfo GameInfoValue;
+    GameInfoValue.width = MapSizeValue;
+    GameInfoValue.height = MapSizeValue;
+    GameInfoValue.pathing_grid.width = MapSizeValue;
+    GameInfoValue.pathing_grid.height = MapSizeValue;
+    GameInfoValue.pathing_grid.bits_per_pixel = 1;
+    GameInfoValue.pathing_grid.data.assign(static_cast<size_t>(MapSizeValue * MapSizeValue / 8), '\0');
+    for (int32_t CellIndexValue = 0; CellIndexValue < MapSizeValue * MapSizeValue; ++CellIndexValue)
+    {
+        if (CellIndexValue % MapSizeValue != WallXValue)
+        {
+            GameInfoValue.pathing_grid.data[static_cast<size_t>(CellIndexValue / 8)] |=
+                static_cast<char>(0x80U >> (CellIndexValue % 8));
+        }
+    }
+    GameInfoValue.placement_grid = GameInfoValue.pathing_grid;
+
+    MapGrids MapGridsValue;
+    MapGridsValue.DecodeGameInfo(GameInfoValue);
+    return MapGridsValue;
+}
+
 FGameStateDescriptor CreateArmyTestDescriptor()
 {
     FGameStateDescriptor GameStateDescriptorValue;
@@ -454,7 +483,8 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         size_t ArmyOrderIndexValue = 0U;
         Check(SchedulingStateValue.TryGetOrderIndex(ArmyOrderIdValue, ArmyOrderIndexValue), SuccessValue,
               "Army mission order should remain addressable after squad expansion.");
-        Check(SchedulingStateValue.LifecycleStates[ArmyOrderIndexValue] == EOrderLifecycleState::Queued, SuccessValue,
+        Check(SchedulingStateValue.OrderHotFields[ArmyOrderIndexValue].LifecycleState ==
+            EOrderLifecycleState::Queued, SuccessValue,
               "Army mission orders should remain active after squad expansion so the squad child can persist until the mission changes.");
     }
 
@@ -498,11 +528,11 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         size_t MedivacOrderIndexValue = 0U;
         for (const size_t ReadyIntentIndexValue : SchedulingStateValue.ReadyIntentIndices)
         {
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] == 401U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag == 401U)
             {
                 MarineOrderIndexValue = ReadyIntentIndexValue;
             }
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] == 402U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag == 402U)
             {
                 MedivacOrderIndexValue = ReadyIntentIndexValue;
             }
@@ -512,8 +542,8 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
               "Pressure missions should use attack-move for marine execution orders.");
         Check(SchedulingStateValue.AbilityIds[MedivacOrderIndexValue] == ABILITY_ID::MOVE_MOVE, SuccessValue,
               "Support air units should use move orders when following the army mission.");
-        Check(!SchedulingStateValue.QueuedValues[MarineOrderIndexValue] &&
-                  !SchedulingStateValue.QueuedValues[MedivacOrderIndexValue],
+        Check(!SchedulingStateValue.OrderHotFields[MarineOrderIndexValue].bQueued &&
+                  !SchedulingStateValue.OrderHotFields[MedivacOrderIndexValue].bQueued,
               SuccessValue, "Combat execution orders should replace prior commands instead of being queued behind them.");
     }
 
@@ -555,11 +585,11 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         size_t MedivacOrderIndexValue = 0U;
         for (const size_t ReadyIntentIndexValue : SchedulingStateValue.ReadyIntentIndices)
         {
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] == 411U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag == 411U)
             {
                 MarineOrderIndexValue = ReadyIntentIndexValue;
             }
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] == 412U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag == 412U)
             {
                 MedivacOrderIndexValue = ReadyIntentIndexValue;
             }
@@ -616,6 +646,68 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         }
     }
 
+    {
+        // Both marines stand within the assembly radius in a straight line, but 431 is across a wall from the rally.
+        FakeObservation ObservationValue;
+        std::vector<Unit> UnitStorageValue;
+        UnitStorageValue.push_back(
+            MakeUnit(431U, UNIT_TYPEID::TERRAN_MARINE, Unit::Alliance::Self, Point2D(21.0f, 24.0f), false));
+        UnitStorageValue.push_back(
+            MakeUnit(432U, UNIT_TYPEID::TERRAN_MARINE, Unit::Alliance::Self, Point2D(26.0f, 24.0f), false));
+        Units ObservationUnitsValue;
+        AppendUnitPointers(UnitStorageValue, ObservationUnitsValue);
+        ObservationValue.SetUnits(ObservationUnitsValue);
+
+        FGroundPathfinder GroundPathfinderValue;
+        GroundPathfinderValue.Initialize(CreateWalledMapGrids());
+        GroundPathfinderValue.UpdateStructures(ObservationUnitsValue);
+        const FFrameContext FrameValue =
+            FFrameContext::Create(&ObservationValue, nullptr, 1U, nullptr, &GroundPathfinderValue);
+        FAgentState AgentStateValue;
+        AgentStateValue.Update(FrameValue);
+
+        FGameStateDescriptor GameStateDescriptorValue = CreateArmyTestDescriptor();
+        GameStateDescriptorValue.ArmyState.ArmyMissions.front().MissionType = EArmyMissionType::AssembleAtRally;
+        GameStateDescriptorValue.ArmyState.ArmyMissions.front().ObjectivePoint = Point2D(24.0f, 24.0f);
+        GameStateDescriptorValue.ArmyState.ArmyMissions.front().SourceGoalId = 405U;
+
+        FCommandAuthoritySchedulingState SchedulingStateValue;
+        FCommandOrderRecord SquadOrderValue = FCommandOrderRecord::CreatePointTarget(
+            ECommandAuthorityLayer::Squad, NullTag, ABILITY_ID::INVALID, Point2D(24.0f, 24.0f), 100,
+            EIntentDomain::ArmyCombat, 20U, 0U, 81U, 0, 0);
+        SquadOrderValue.SourceGoalId = 405U;
+        SquadOrderValue.TaskType = ECommandTaskType::ArmyMission;
+        SchedulingStateValue.EnqueueOrder(SquadOrderValue);
+
+        const uint32_t CreatedOrderCountValue = UnitExecutionPlannerValue.ExpandUnitExecutionOrders(
+            FrameValue, AgentStateValue, GameStateDescriptorValue, Point2D(24.0f, 24.0f), SchedulingStateValue);
+
+        Check(CreatedOrderCountValue == 2U, SuccessValue,
+              "Both marines near the rally point should receive an execution order.");
+        bool bWalledMarineMovesValue = false;
+        bool bNearMarineHoldsValue = false;
+        for (const size_t ReadyIntentIndexValue : SchedulingStateValue.ReadyIntentIndices)
+        {
+            const Tag ActorTagValue = SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag;
+            const ABILITY_ID AbilityIdValue = SchedulingStateValue.AbilityIds[ReadyIntentIndexValue];
+            const Point2D TargetPointValue = SchedulingStateValue.TargetPoints[ReadyIntentIndexValue];
+            if (ActorTagValue == 431U)
+            {
+                bWalledMarineMovesValue = AbilityIdValue == ABILITY_ID::ATTACK_ATTACK &&
+                                          ApproxEqual(TargetPointValue.x, 24.0f) &&
+                                          ApproxEqual(TargetPointValue.y, 24.0f);
+            }
+            if (ActorTagValue == 432U)
+            {
+                bNearMarineHoldsValue = AbilityIdValue == ABILITY_ID::GENERAL_HOLDPOSITION;
+            }
+        }
+        Check(bWalledMarineMovesValue, SuccessValue,
+              "A unit that cannot reach the rally point on the ground should keep moving toward it.");
+        Check(bNearMarineHoldsValue, SuccessValue,
+              "A unit with a short ground path to the rally point should hold inside the assembly radius.");
+    }
+
     {
         FakeObservation ObservationValue;
         std::vector<Unit> UnitStorageValue;
@@ -768,7 +860,7 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         bool FoundMedivacOrderValue = false;
         for (const size_t ReadyIntentIndexValue : SchedulingStateValue.ReadyIntentIndices)
         {
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] != 802U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag != 802U)
             {
                 continue;
             }
@@ -824,7 +916,7 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         bool FoundMedivacOrderValue = false;
         for (const size_t ReadyIntentIndexValue : SchedulingStateValue.ReadyIntentIndices)
         {
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] != 812U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag != 812U)
             {
                 continue;
             }
@@ -878,7 +970,7 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         bool FoundWidowMineOrderValue = false;
         for (const size_t ReadyIntentIndexValue : SchedulingStateValue.ReadyIntentIndices)
         {
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] != 821U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag != 821U)
             {
                 continue;
             }
@@ -928,7 +1020,7 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         bool FoundWidowMineOrderValue = false;
         for (const size_t ReadyIntentIndexValue : SchedulingStateValue.ReadyIntentIndices)
         {
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] != 831U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag != 831U)
             {
                 continue;
             }
@@ -980,7 +1072,7 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         bool FoundSiegeTankOrderValue = false;
         for (const size_t ReadyIntentIndexValue : SchedulingStateValue.ReadyIntentIndices)
         {
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] != 841U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag != 841U)
             {
                 continue;
             }
@@ -1030,7 +1122,7 @@ bool TestTerranArmyOrderPipeline(int ArgC, char** ArgV)
         bool FoundSiegeTankOrderValue = false;
         for (const size_t ReadyIntentIndexValue : SchedulingStateValue.ReadyIntentIndices)
         {
-            if (SchedulingStateValue.ActorTags[ReadyIntentIndexValue] != 851U)
+            if (SchedulingStateValue.OrderHotFields[ReadyIntentIndexValue].ActorTag != 851U)
             {
                 continue;
             }
@@ -291,6 +291,40 @@ bool TestTerranEconomicModels(int ArgC, char** ArgV)
               SuccessValue, "Economy forecast should project short-horizon minerals from the moving gross-gather average.");
     }
 
+    {
+        // A long steady game: one SCV and 8 minerals of income every 16 game loops.
+        FEconomyDomainState EconomyDomainStateValue;
+        FAgentState SteadyAgentStateValue;
+        uint16_t ScvCountValue = 12U;
+        for (uint64_t GameLoopValue = 16U; GameLoopValue <= 32000U; GameLoopValue += 16U)
+        {
+            SteadyAgentStateValue.Economy.Minerals = static_cast<uint32_t>(GameLoopValue / 2U);
+            SteadyAgentStateValue.Units.SetUnitCount(UNIT_TYPEID::TERRAN_SCV, ++ScvCountValue);
+            SteadyAgentStateValue.Units.Update();
+            EconomyDomainStateValue.Update(SteadyAgentStateValue, GameLoopValue);
+        }
+
+        const uint64_t LongHorizonGameLoopsValue = ForecastHorizonGameLoopsValue[LongForecastHorizonIndexValue];
+        Check(EconomyDomainStateValue.HasSynchronizedSampleSizes(), SuccessValue,
+              "Economy history should stay consistent across a long game.");
+        Check(EconomyDomainStateValue.GetSampleCount() <= LongHorizonGameLoopsValue / 16U + 1U, SuccessValue,
+              "Economy history should only retain samples reaching back to the longest horizon.");
+        Check(EconomyDomainStateValue.GetElapsedGameLoopsForHorizon(LongForecastHorizonIndexValue) ==
+                  LongHorizonGameLoopsValue,
+              SuccessValue, "Long-horizon windows should span the configured horizon once history is long enough.");
+        Check(EconomyDomainStateValue.GetUnitCompletionCountForHorizon(UNIT_TYPEID::TERRAN_SCV,
+                                                                       LongForecastHorizonIndexValue) ==
+                  LongHorizonGameLoopsValue / 16U,
+              SuccessValue, "Long-horizon unit completions should count only completions inside the window.");
+        Check(EconomyDomainStateValue.GetUnitCompletionCountForHorizon(UNIT_TYPEID::TERRAN_SCV,
+                                                                       ShortForecastHorizonIndexValue) ==
+                  ForecastHorizonGameLoopsValue[ShortForecastHorizonIndexValue] / 16U,
+              SuccessValue, "Short-horizon unit completions should count only completions inside the window.");
+        Check(EconomyDomainStateValue.GetGrossMineralIncomeForHorizon(MediumForecastHorizonIndexValue) ==
+                  ForecastHorizonGameLoopsValue[MediumForecastHorizonIndexValue] / 2U,
+              SuccessValue, "Medium-horizon gross mineral income should follow the steady gather rate.");
+    }
+
     return SuccessValue;
 }
 
@@ -508,8 +508,9 @@ uint32_t CountActiveChildOrders(const FCommandAuthoritySchedulingState& CommandA
          ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.ParentOrderIds[OrderIndexValue] != ParentOrderIdValue ||
-            CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] != SourceLayerValue ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer != SourceLayerValue ||
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -809,17 +810,18 @@ bool TestTerranEconomyProductionOrderExpander(int ArgC, char** ArgV)
          ++OrderIndexValue)
     {
         if (WorkerTownHallSchedulingStateValue.ParentOrderIds[OrderIndexValue] != WorkerEconomyOrderIdValue ||
-            WorkerTownHallSchedulingStateValue.SourceLayers[OrderIndexValue] != ECommandAuthorityLayer::UnitExecution ||
-            IsTerminalLifecycleState(WorkerTownHallSchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            WorkerTownHallSchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
+                ECommandAuthorityLayer::UnitExecution ||
+            IsTerminalLifecycleState(WorkerTownHallSchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
 
-        if (WorkerTownHallSchedulingStateValue.ActorTags[OrderIndexValue] == 211U)
+        if (WorkerTownHallSchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag == 211U)
         {
             HasCommandCenterWorkerOrderValue = true;
         }
-        if (WorkerTownHallSchedulingStateValue.ActorTags[OrderIndexValue] == 212U)
+        if (WorkerTownHallSchedulingStateValue.OrderHotFields[OrderIndexValue].ActorTag == 212U)
         {
             HasOrbitalWorkerOrderValue = true;
         }
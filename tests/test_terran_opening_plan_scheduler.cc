@@ -135,7 +135,7 @@ bool TryFindOrderIndexByPlanStepId(const FCommandAuthoritySchedulingState& Comma
          ++OrderIndexValue)
     {
         if (CommandAuthoritySchedulingStateValue.PlanStepIds[OrderIndexValue] == PlanStepIdValue &&
-            CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] == SourceLayerValue)
+            CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer == SourceLayerValue)
         {
             OutOrderIndexValue = OrderIndexValue;
             return true;
@@ -151,9 +151,11 @@ bool TryFindStrategicOrderByTaskType(const FCommandAuthoritySchedulingState& Com
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] == ECommandAuthorityLayer::StrategicDirector &&
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer ==
+                ECommandAuthorityLayer::StrategicDirector &&
             CommandAuthoritySchedulingStateValue.TaskTypes[OrderIndexValue] == CommandTaskTypeValue &&
-            !IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            !IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             OutOrderIndexValue = OrderIndexValue;
             return true;
@@ -169,10 +171,11 @@ bool TryFindStrategicOrderByGoalId(const FCommandAuthoritySchedulingState& Comma
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] !=
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
                 ECommandAuthorityLayer::StrategicDirector ||
             CommandAuthoritySchedulingStateValue.SourceGoalIds[OrderIndexValue] != GoalIdValue ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]))
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState))
         {
             continue;
         }
@@ -191,11 +194,12 @@ uint32_t CountActiveStrategicOpeningSupplyOrders(
     for (size_t OrderIndexValue = 0U; OrderIndexValue < CommandAuthoritySchedulingStateValue.OrderIds.size();
          ++OrderIndexValue)
     {
-        if (CommandAuthoritySchedulingStateValue.SourceLayers[OrderIndexValue] !=
+        if (CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].SourceLayer !=
                 ECommandAuthorityLayer::StrategicDirector ||
             CommandAuthoritySchedulingStateValue.TaskOrigins[OrderIndexValue] != ECommandTaskOrigin::Opening ||
             CommandAuthoritySchedulingStateValue.AbilityIds[OrderIndexValue] != ABILITY_ID::BUILD_SUPPLYDEPOT ||
-            IsTerminalLifecycleState(CommandAuthoritySchedulingStateValue.LifecycleStates[OrderIndexValue]) ||
+            IsTerminalLifecycleState(
+                CommandAuthoritySchedulingStateValue.OrderHotFields[OrderIndexValue].LifecycleState) ||
             CommandAuthoritySchedulingStateValue.ExecutionGuarantees[OrderIndexValue] ==
                 ECommandTaskExecutionGuarantee::MustExecute)
         {
@@ -0,0 +1,198 @@
+#include "test_trace.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sc2api/sc2_trace.h"
+
+namespace sc2
+{
+namespace
+{
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const char* MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+const TraceZoneStats* FindZoneStats(const std::vector<TraceZoneStats>& ZoneStatsValue, const char* NameValue)
+{
+    for (const TraceZoneStats& StatsValue : ZoneStatsValue)
+    {
+        if (StatsValue.name == NameValue)
+        {
+            return &StatsValue;
+        }
+    }
+
+    return nullptr;
+}
+
+bool TestDisabledZones()
+{
+    bool SuccessValue = true;
+
+    Tracer& TracerValue = Tracer::Get();
+    TracerValue.SetEnabled(false);
+    TracerValue.Reset();
+
+    uint64_t ElapsedMicrosecondsValue = 0U;
+    {
+        TraceZone ZoneValue("Test.Disabled");
+        TraceZone TimedZoneValue("Test.DisabledTimed", ElapsedMicrosecondsValue);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    Check(TracerValue.GetZoneStats().empty(), SuccessValue, "Zones should not be recorded while tracing is off.");
+    Check(ElapsedMicrosecondsValue >= 1000U, SuccessValue,
+          "Timed zones should store their duration while tracing is off.");
+    return SuccessValue;
+}
+
+bool TestZonesAcrossThreads()
+{
+    bool SuccessValue = true;
+
+    Tracer& TracerValue = Tracer::Get();
+    TracerValue.Reset();
+    TracerValue.SetEnabled(true);
+    TracerValue.StartCapture();
+
+    {
+        TraceZone OuterZoneValue("Test.Outer");
+        TraceZone InnerZoneValue("Test.Inner");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const size_t ThreadBufferCountValue = TracerValue.GetThreadBufferCount();
+    std::vector<std::thread> ThreadsValue;
+    for (int ThreadIndexValue = 0; ThreadIndexValue < 4; ++ThreadIndexValue)
+    {
+        ThreadsValue.emplace_back([]()
+        {
+            for (int ZoneIndexValue = 0; ZoneIndexValue < 100; ++ZoneIndexValue)
+            {
+                TraceZone ZoneValue("Test.Worker");
+            }
+        });
+    }
+    for (std::thread& ThreadValue : ThreadsValue)
+    {
+        ThreadValue.join();
+    }
+
+    TracerValue.StopCapture();
+    TracerValue.SetEnabled(false);
+
+    const std::vector<TraceZoneStats> ZoneStatsValue = TracerValue.GetZoneStats();
+    const TraceZoneStats* OuterStatsPtr = FindZoneStats(ZoneStatsValue, "Test.Outer");
+    const TraceZoneStats* InnerStatsPtr = FindZoneStats(ZoneStatsValue, "Test.Inner");
+    const TraceZoneStats* WorkerStatsPtr = FindZoneStats(ZoneStatsValue, "Test.Worker");
+    if (!Check(OuterStatsPtr != nullptr && InnerStatsPtr != nullptr && WorkerStatsPtr != nullptr, SuccessValue,
+               "Every zone should have statistics."))
+    {
+        return SuccessValue;
+    }
+
+    Check(WorkerStatsPtr->total_count == 400U && OuterStatsPtr->total_count == 1U, SuccessValue,
+          "Zones from every thread should be collected.");
+    Check(OuterStatsPtr->max_ns >= InnerStatsPtr->max_ns && InnerStatsPtr->max_ns >= 1000000U, SuccessValue,
+          "An enclosing zone should last at least as long as the zone it encloses.");
+    Check(TracerValue.GetCapturedEventCount() == 402U && TracerValue.GetDroppedEventCount() == 0U, SuccessValue,
+          "Every zone should be kept while capturing.");
+
+    std::ostringstream TraceStreamValue;
+    TracerValue.WriteChromeTrace(TraceStreamValue);
+    const std::string TraceValue = TraceStreamValue.str();
+    Check(TraceValue.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0U &&
+              TraceValue.find("\"name\":\"Test.Inner\",\"cat\":\"sc2\",\"ph\":\"X\"") != std::string::npos &&
+              TraceValue.find("\"ph\":\"M\"") != std::string::npos &&
+              TraceValue.rfind("]}\n") == TraceValue.size() - 3U,
+          SuccessValue, "The export should be a Chrome trace with complete events and thread names.");
+    Check(TracerValue.GetThreadBufferCount() == ThreadBufferCountValue, SuccessValue,
+          "The buffers of exited threads should be released once drained.");
+
+    TracerValue.Reset();
+    Check(TracerValue.GetZoneStats().empty() && TracerValue.GetCapturedEventCount() == 0U, SuccessValue,
+          "Reset should forget zones and kept events.");
+    return SuccessValue;
+}
+
+bool TestRollingHistogram()
+{
+    bool SuccessValue = true;
+
+    Tracer& TracerValue = Tracer::Get();
+    TracerValue.Reset();
+
+    for (int SampleIndexValue = 0; SampleIndexValue < 100; ++SampleIndexValue)
+    {
+        TracerValue.Record("Test.Histogram", 0U, 10000U);
+    }
+    TracerValue.Record("Test.Histogram", 0U, 1000000U);
+
+    std::vector<TraceZoneStats> ZoneStatsValue = TracerValue.GetZoneStats();
+    const TraceZoneStats* StatsPtr = FindZoneStats(ZoneStatsValue, "Test.Histogram");
+    if (!Check(StatsPtr != nullptr, SuccessValue, "Recorded events should have statistics."))
+    {
+        return SuccessValue;
+    }
+
+    Check(StatsPtr->p50_ns >= 10000U && StatsPtr->p50_ns <= 12500U && StatsPtr->p99_ns <= 12500U &&
+              StatsPtr->max_ns == 1000000U,
+          SuccessValue, "Percentiles should come from the histogram and the maximum should be exact.");
+
+    for (size_t SampleIndexValue = 0U; SampleIndexValue < Tracer::kHistogramWindow; ++SampleIndexValue)
+    {
+        TracerValue.Record("Test.Histogram", 0U, 5000U);
+    }
+    ZoneStatsValue = TracerValue.GetZoneStats();
+    StatsPtr = FindZoneStats(ZoneStatsValue, "Test.Histogram");
+    Check(StatsPtr != nullptr && StatsPtr->total_count == 101U + Tracer::kHistogramWindow &&
+              StatsPtr->window_count == Tracer::kHistogramWindow && StatsPtr->max_ns == 5000U &&
+              StatsPtr->p99_ns >= 5000U && StatsPtr->p99_ns <= 6250U,
+          SuccessValue, "Older samples should roll out of the window.");
+
+    for (size_t SampleIndexValue = 0U; SampleIndexValue < Tracer::kThreadBufferCapacity + 10U; ++SampleIndexValue)
+    {
+        TracerValue.Record("Test.Overflow", 0U, 1U);
+    }
+    Check(TracerValue.GetDroppedEventCount() == 10U, SuccessValue,
+          "Events past a full thread buffer should be counted as dropped.");
+
+    TracerValue.Reset();
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestTrace(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking disabled zones..." << std::endl;
+    SuccessValue = TestDisabledZones() && SuccessValue;
+
+    std::cout << "  Checking zones across threads..." << std::endl;
+    SuccessValue = TestZonesAcrossThreads() && SuccessValue;
+
+    std::cout << "  Checking rolling histograms..." << std::endl;
+    SuccessValue = TestRollingHistogram() && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace sc2
+{
+
+bool TestTrace(int ArgC, char** ArgV);
+
+}  // namespace sc2
@@ -0,0 +1,295 @@
+#include "test_unit_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "sc2api/sc2_common.h"
+#include "sc2api/sc2_unit.h"
+
+namespace sc2
+{
+namespace
+{
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const std::string& MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+struct FObservedUnit
+{
+    Tag UnitTag;
+    UNIT_TYPEID UnitTypeId;
+    Unit::Alliance Alliance;
+    Point3D Position;
+    bool bIsFlying;
+    bool bIsBuilding;
+};
+
+FObservedUnit MakeObservedUnit(const Tag TagValue, const UNIT_TYPEID UnitTypeIdValue,
+                               const Unit::Alliance AllianceValue, const Point2D& PositionValue)
+{
+    FObservedUnit ObservedUnitValue;
+    ObservedUnitValue.UnitTag = TagValue;
+    ObservedUnitValue.UnitTypeId = UnitTypeIdValue;
+    ObservedUnitValue.Alliance = AllianceValue;
+    ObservedUnitValue.Position = Point3D(PositionValue.x, PositionValue.y, 0.0f);
+    ObservedUnitValue.bIsFlying = false;
+    ObservedUnitValue.bIsBuilding = false;
+    return ObservedUnitValue;
+}
+
+// Mirrors Convert in sc2_proto_to_pods.cc: every observation clears the existing units, then each observed unit is
+// created or revived, has its record filled and is committed into the dense columns.
+void ApplyObservation(UnitPool& UnitPoolValue, const std::vector<FObservedUnit>& ObservedUnitsValue)
+{
+    UnitPoolValue.ClearExisting();
+    for (const FObservedUnit& ObservedUnitValue : ObservedUnitsValue)
+    {
+        Unit* UnitPtrValue = UnitPoolValue.CreateUnit(ObservedUnitValue.UnitTag);
+        UnitPtrValue->tag = ObservedUnitValue.UnitTag;
+        UnitPtrValue->unit_type = ObservedUnitValue.UnitTypeId;
+        UnitPtrValue->alliance = ObservedUnitValue.Alliance;
+        UnitPtrValue->pos = ObservedUnitValue.Position;
+        UnitPtrValue->display_type = Unit::DisplayType::Visible;
+        UnitPtrValue->is_flying = ObservedUnitValue.bIsFlying;
+        UnitPtrValue->is_building = ObservedUnitValue.bIsBuilding;
+        UnitPtrValue->is_burrowed = false;
+        UnitPtrValue->is_hallucination = false;
+        UnitPtrValue->is_alive = true;
+        UnitPoolValue.CommitExistingUnit(*UnitPtrValue);
+    }
+}
+
+// Every dense column at an index must describe the unit record the unit column points at.
+bool AreColumnsInSync(const UnitPool& UnitPoolValue)
+{
+    const std::vector<Unit*>& ExistingUnitsValue = UnitPoolValue.GetExistingUnits();
+    const std::vector<Point3D>& ExistingPositionsValue = UnitPoolValue.GetExistingPositions();
+    const std::vector<Unit::Alliance>& ExistingAlliancesValue = UnitPoolValue.GetExistingAlliances();
+    const std::vector<UnitTypeID>& ExistingUnitTypesValue = UnitPoolValue.GetExistingUnitTypes();
+    const std::vector<uint8_t>& ExistingFlagsValue = UnitPoolValue.GetExistingFlags();
+    if (ExistingPositionsValue.size() != ExistingUnitsValue.size() ||
+        ExistingAlliancesValue.size() != ExistingUnitsValue.size() ||
+        ExistingUnitTypesValue.size() != ExistingUnitsValue.size() ||
+        ExistingFlagsValue.size() != ExistingUnitsValue.size())
+    {
+        return false;
+    }
+
+    for (size_t ExistingIndexValue = 0U; ExistingIndexValue < ExistingUnitsValue.size(); ++ExistingIndexValue)
+    {
+        const Unit& UnitValue = *ExistingUnitsValue[ExistingIndexValue];
+        const uint8_t FlagsValue = ExistingFlagsValue[ExistingIndexValue];
+        if (ExistingPositionsValue[ExistingIndexValue] != UnitValue.pos ||
+            ExistingAlliancesValue[ExistingIndexValue] != UnitValue.alliance ||
+            ExistingUnitTypesValue[ExistingIndexValue] != UnitValue.unit_type ||
+            ((FlagsValue & UnitPool::FlagFlying) != 0U) != UnitValue.is_flying ||
+            ((FlagsValue & UnitPool::FlagBuilding) != 0U) != UnitValue.is_building ||
+            UnitPoolValue.GetExistingUnit(UnitValue.tag) != &UnitValue)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TestObservationsCommitAndClear()
+{
+    bool SuccessValue = true;
+
+    UnitPool UnitPoolValue;
+    std::vector<FObservedUnit> FirstObservationValue;
+    FirstObservationValue.push_back(
+        MakeObservedUnit(1U, UNIT_TYPEID::TERRAN_SCV, Unit::Alliance::Self, Point2D(10.0f, 10.0f)));
+    FirstObservationValue.push_back(
+        MakeObservedUnit(2U, UNIT_TYPEID::TERRAN_MARINE, Unit::Alliance::Self, Point2D(12.0f, 10.0f)));
+    FirstObservationValue.push_back(
+        MakeObservedUnit(3U, UNIT_TYPEID::NEUTRAL_MINERALFIELD, Unit::Alliance::Neutral, Point2D(20.0f, 8.0f)));
+    FirstObservationValue.push_back(
+        MakeObservedUnit(4U, UNIT_TYPEID::PROTOSS_ZEALOT, Unit::Alliance::Enemy, Point2D(40.0f, 40.0f)));
+    ApplyObservation(UnitPoolValue, FirstObservationValue);
+
+    Check(UnitPoolValue.GetExistingCount() == 4U && UnitPoolValue.GetNewUnits().size() == 4U, SuccessValue,
+          "The first observation should create and commit every unit.");
+    Check(AreColumnsInSync(UnitPoolValue), SuccessValue,
+          "Committed columns should match the unit records after the first observation.");
+    const Unit* MarinePtrValue = UnitPoolValue.GetExistingUnit(2U);
+
+    std::vector<FObservedUnit> SecondObservationValue;
+    SecondObservationValue.push_back(
+        MakeObservedUnit(2U, UNIT_TYPEID::TERRAN_MARINE, Unit::Alliance::Self, Point2D(14.0f, 11.0f)));
+    SecondObservationValue.push_back(
+        MakeObservedUnit(5U, UNIT_TYPEID::TERRAN_BARRACKS, Unit::Alliance::Self, Point2D(30.0f, 30.0f)));
+    SecondObservationValue.back().bIsBuilding = true;
+    SecondObservationValue.push_back(
+        MakeObservedUnit(3U, UNIT_TYPEID::NEUTRAL_MINERALFIELD, Unit::Alliance::Neutral, Point2D(20.0f, 8.0f)));
+    ApplyObservation(UnitPoolValue, SecondObservationValue);
+
+    const std::vector<Unit*>& ExistingUnitsValue = UnitPoolValue.GetExistingUnits();
+    Check(ExistingUnitsValue.size() == 3U && ExistingUnitsValue[0]->tag == 2U && ExistingUnitsValue[1]->tag == 5U &&
+              ExistingUnitsValue[2]->tag == 3U,
+          SuccessValue, "The existing units should follow the order of the second observation.");
+    Check(UnitPoolValue.GetNewUnits().size() == 1U && UnitPoolValue.GetNewUnits()[0]->tag == 5U, SuccessValue,
+          "Only units first seen in the second observation should be new.");
+    Check(UnitPoolValue.GetExistingUnit(2U) == MarinePtrValue &&
+              UnitPoolValue.GetExistingPositions()[0] == Point3D(14.0f, 11.0f, 0.0f),
+          SuccessValue, "A unit seen again should keep its record and have its columns refreshed.");
+    Check(UnitPoolValue.GetExistingUnit(1U) == nullptr && !UnitPoolValue.UnitExists(1U) &&
+              UnitPoolValue.GetUnit(1U) != nullptr,
+          SuccessValue, "A unit missing from the observation should stop existing but keep its record.");
+    Check((UnitPoolValue.GetExistingFlags()[1] & UnitPool::FlagBuilding) != 0U && AreColumnsInSync(UnitPoolValue),
+          SuccessValue, "Committed columns should match the unit records after the second observation.");
+    return SuccessValue;
+}
+
+bool TestHandlesAndSwapRemove()
+{
+    bool SuccessValue = true;
+
+    UnitPool UnitPoolValue;
+    std::vector<FObservedUnit> ObservationValue;
+    for (Tag TagValue = 1U; TagValue <= 5U; ++TagValue)
+    {
+        ObservationValue.push_back(MakeObservedUnit(TagValue, UNIT_TYPEID::TERRAN_MARINE,
+                                                    TagValue % 2U == 0U ? Unit::Alliance::Enemy
+                                                                        : Unit::Alliance::Self,
+                                                    Point2D(static_cast<float>(TagValue), 5.0f)));
+    }
+    ObservationValue[4].UnitTypeId = UNIT_TYPEID::TERRAN_MEDIVAC;
+    ObservationValue[4].bIsFlying = true;
+    ApplyObservation(UnitPoolValue, ObservationValue);
+
+    const UnitHandle DeadHandleValue = UnitPoolValue.GetHandle(2U);
+    const UnitHandle MovedHandleValue = UnitPoolValue.GetHandle(5U);
+    Unit* MovedUnitPtrValue = UnitPoolValue.GetExistingUnit(5U);
+    Check(DeadHandleValue.IsValid() && UnitPoolValue.Resolve(DeadHandleValue) == UnitPoolValue.GetUnit(2U) &&
+              UnitPoolValue.Resolve(MovedHandleValue) == MovedUnitPtrValue,
+          SuccessValue, "Handles of living units should resolve to their records.");
+    Check(!UnitPoolValue.GetHandle(99U).IsValid() && UnitPoolValue.Resolve(UnitHandle()) == nullptr, SuccessValue,
+          "Unknown tags should give handles that resolve to nothing.");
+
+    // Unit 2 sits in the middle of the columns, so the last unit is swapped into its place.
+    UnitPoolValue.MarkDead(2U);
+    Check(UnitPoolValue.Resolve(DeadHandleValue) == nullptr && !UnitPoolValue.GetHandle(2U).IsValid(), SuccessValue,
+          "A handle should stop resolving once its unit is marked dead.");
+    Check(UnitPoolValue.GetExistingUnit(2U) == nullptr && UnitPoolValue.GetUnit(2U) != nullptr &&
+              !UnitPoolValue.GetUnit(2U)->is_alive,
+          SuccessValue, "A dead unit should leave the existing units but keep its record.");
+
+    const std::vector<Unit*>& ExistingUnitsValue = UnitPoolValue.GetExistingUnits();
+    Check(ExistingUnitsValue.size() == 4U && ExistingUnitsValue[1] == MovedUnitPtrValue, SuccessValue,
+          "Marking a unit dead should swap the last unit into its place.");
+    Check(UnitPoolValue.GetExistingPositions()[1] == MovedUnitPtrValue->pos &&
+              UnitPoolValue.GetExistingUnitTypes()[1] == UNIT_TYPEID::TERRAN_MEDIVAC &&
+              UnitPoolValue.GetExistingAlliances()[1] == Unit::Alliance::Self &&
+              (UnitPoolValue.GetExistingFlags()[1] & UnitPool::FlagFlying) != 0U,
+          SuccessValue, "Every column should move with the swapped unit.");
+    Check(AreColumnsInSync(UnitPoolValue) && UnitPoolValue.Resolve(MovedHandleValue) == MovedUnitPtrValue,
+          SuccessValue, "The swapped unit should stay reachable by tag and by handle.");
+
+    // Removing the last unit, and a unit that already left, must leave the other columns alone.
+    UnitPoolValue.MarkDead(4U);
+    UnitPoolValue.MarkDead(2U);
+    Check(UnitPoolValue.GetExistingCount() == 3U && AreColumnsInSync(UnitPoolValue), SuccessValue,
+          "Removing the last unit should keep the columns in sync.");
+    return SuccessValue;
+}
+
+bool TestAllianceScanMatchesLinearScan()
+{
+    bool SuccessValue = true;
+
+    std::mt19937 RandomEngineValue(11U);
+    std::uniform_real_distribution<float> CoordinateDistributionValue(0.0f, 200.0f);
+    std::uniform_int_distribution<int> KindDistributionValue(0, 3);
+
+    UnitPool UnitPoolValue;
+    for (int ObservationIndexValue = 0; ObservationIndexValue < 3; ++ObservationIndexValue)
+    {
+        std::vector<FObservedUnit> ObservationValue;
+        for (Tag TagValue = 1U; TagValue <= 450U; ++TagValue)
+        {
+            const int KindValue = KindDistributionValue(RandomEngineValue);
+            if (KindValue == 3 && ObservationIndexValue > 0)
+            {
+                continue;
+            }
+
+            const Unit::Alliance AllianceValue = TagValue % 3U == 0U   ? Unit::Alliance::Neutral
+                                                 : TagValue % 3U == 1U ? Unit::Alliance::Self
+                                                                       : Unit::Alliance::Enemy;
+            ObservationValue.push_back(MakeObservedUnit(
+                TagValue, KindValue == 0 ? UNIT_TYPEID::TERRAN_SCV : UNIT_TYPEID::TERRAN_MARINE, AllianceValue,
+                Point2D(CoordinateDistributionValue(RandomEngineValue),
+                        CoordinateDistributionValue(RandomEngineValue))));
+        }
+        ApplyObservation(UnitPoolValue, ObservationValue);
+        UnitPoolValue.MarkDead(static_cast<Tag>(10U + ObservationIndexValue));
+
+        const auto FilterValue = [](const Unit& UnitValue)
+        {
+            return UnitValue.unit_type == UNIT_TYPEID::TERRAN_MARINE && UnitValue.pos.x < 100.0f;
+        };
+        for (const Unit::Alliance AllianceValue :
+             {Unit::Alliance::Self, Unit::Alliance::Enemy, Unit::Alliance::Neutral, Unit::Alliance::Ally})
+        {
+            Units ColumnScanUnitsValue;
+            UnitPoolValue.ForEachExisting(AllianceValue, [&ColumnScanUnitsValue, &FilterValue](const Unit& UnitValue)
+            {
+                if (FilterValue(UnitValue))
+                {
+                    ColumnScanUnitsValue.push_back(&UnitValue);
+                }
+            });
+
+            Units LinearScanUnitsValue;
+            for (const Unit* UnitPtrValue : UnitPoolValue.GetExistingUnits())
+            {
+                if (UnitPtrValue->alliance == AllianceValue && FilterValue(*UnitPtrValue))
+                {
+                    LinearScanUnitsValue.push_back(UnitPtrValue);
+                }
+            }
+
+            Check(ColumnScanUnitsValue == LinearScanUnitsValue, SuccessValue,
+                  "The alliance column scan should return the linear scan's units in the same order.");
+        }
+    }
+
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestUnitPool(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking observations across commits and clears..." << std::endl;
+    SuccessValue = TestObservationsCommitAndClear() && SuccessValue;
+
+    std::cout << "  Checking handles and swap-removal..." << std::endl;
+    SuccessValue = TestHandlesAndSwapRemove() && SuccessValue;
+
+    std::cout << "  Checking alliance scans against linear scans..." << std::endl;
+    SuccessValue = TestAllianceScanMatchesLinearScan() && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
@@ -0,0 +1,375 @@
+#include "test_unit_spatial_index.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/spatial/FUnitSpatialIndex.h"
+#include "sc2api/sc2_common.h"
+#include "sc2api/sc2_unit.h"
+
+namespace sc2
+{
+namespace
+{
+
+using FSteadyClock = std::chrono::steady_clock;
+using FSteadyTimePoint = FSteadyClock::time_point;
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const std::string& MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+uint64_t GetElapsedMicroseconds(const FSteadyTimePoint& StartTimeValue, const FSteadyTimePoint& EndTimeValue)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(EndTimeValue - StartTimeValue).count());
+}
+
+Unit MakeUnit(const Tag TagValue, const UNIT_TYPEID UnitTypeIdValue, const Unit::Alliance AllianceValue,
+              const Point2D& PositionValue, const bool IsBuildingValue)
+{
+    Unit UnitValue;
+    UnitValue.alliance = AllianceValue;
+    UnitValue.tag = TagValue;
+    UnitValue.unit_type = UnitTypeIdValue;
+    UnitValue.pos = Point3D(PositionValue.x, PositionValue.y, 0.0f);
+    UnitValue.build_progress = 1.0f;
+    UnitValue.health = 45.0f;
+    UnitValue.health_max = 45.0f;
+    UnitValue.is_flying = false;
+    UnitValue.is_building = IsBuildingValue;
+    return UnitValue;
+}
+
+// Mirrors the army unit-execution planner predicates.
+bool IsCombatThreat(const Unit& UnitValue)
+{
+    return UnitValue.build_progress >= 1.0f && !UnitValue.is_building &&
+           UnitValue.unit_type.ToType() != UNIT_TYPEID::PROTOSS_PROBE;
+}
+
+bool IsGroundThreat(const Unit& UnitValue)
+{
+    return IsCombatThreat(UnitValue) && !UnitValue.is_flying;
+}
+
+bool IsCompletedStructure(const Unit& UnitValue)
+{
+    return UnitValue.build_progress >= 1.0f && UnitValue.is_building;
+}
+
+// The linear scan the index replaces: first closest match in observation order.
+template <typename TPredicate>
+const Unit* FindNearestLinear(const Point2D& OriginPointValue, const Units& UnitsValue,
+                              const Unit::Alliance AllianceValue, TPredicate PredicateValue)
+{
+    const Unit* BestUnitPtrValue = nullptr;
+    float BestDistanceSquaredValue = std::numeric_limits<float>::max();
+    for (const Unit* UnitPtrValue : UnitsValue)
+    {
+        if (UnitPtrValue == nullptr || UnitPtrValue->alliance != AllianceValue || !PredicateValue(*UnitPtrValue))
+        {
+            continue;
+        }
+
+        const float DistanceSquaredValue = DistanceSquared2D(OriginPointValue, Point2D(UnitPtrValue->pos));
+        if (DistanceSquaredValue >= BestDistanceSquaredValue)
+        {
+            continue;
+        }
+
+        BestDistanceSquaredValue = DistanceSquaredValue;
+        BestUnitPtrValue = UnitPtrValue;
+    }
+
+    return BestUnitPtrValue;
+}
+
+void PopulateArmies(const size_t UnitsPerSideValue, const uint32_t SeedValue, std::vector<Unit>& OutUnitStorageValue,
+                    Units& OutUnitsValue)
+{
+    std::mt19937 RandomEngineValue(SeedValue);
+    std::uniform_real_distribution<float> CoordinateDistributionValue(20.0f, 180.0f);
+    std::uniform_int_distribution<int> KindDistributionValue(0, 9);
+
+    OutUnitStorageValue.clear();
+    OutUnitStorageValue.reserve(UnitsPerSideValue * 2U);
+    for (size_t UnitIndexValue = 0U; UnitIndexValue < UnitsPerSideValue * 2U; ++UnitIndexValue)
+    {
+        const bool IsEnemyValue = (UnitIndexValue % 2U) == 1U;
+        const int KindValue = KindDistributionValue(RandomEngineValue);
+        const Point2D PositionValue(CoordinateDistributionValue(RandomEngineValue),
+                                    CoordinateDistributionValue(RandomEngineValue));
+        if (IsEnemyValue)
+        {
+            const UNIT_TYPEID UnitTypeIdValue = KindValue == 0   ? UNIT_TYPEID::PROTOSS_GATEWAY
+                                                : KindValue == 1 ? UNIT_TYPEID::PROTOSS_PROBE
+                                                                 : UNIT_TYPEID::PROTOSS_STALKER;
+            Unit UnitValue = MakeUnit(1000U + UnitIndexValue, UnitTypeIdValue, Unit::Alliance::Enemy, PositionValue,
+                                      KindValue == 0);
+            UnitValue.is_flying = KindValue == 2;
+            OutUnitStorageValue.push_back(UnitValue);
+        }
+        else
+        {
+            Unit UnitValue = MakeUnit(1000U + UnitIndexValue, UNIT_TYPEID::TERRAN_MARINE, Unit::Alliance::Self,
+                                      PositionValue, false);
+            UnitValue.health = KindValue < 3 ? 20.0f : 45.0f;
+            OutUnitStorageValue.push_back(UnitValue);
+        }
+    }
+
+    OutUnitsValue.clear();
+    for (const Unit& UnitValue : OutUnitStorageValue)
+    {
+        OutUnitsValue.push_back(&UnitValue);
+    }
+}
+
+bool TestNearestMatchesLinearScan()
+{
+    bool SuccessValue = true;
+
+    std::vector<Unit> UnitStorageValue;
+    Units UnitsValue;
+    PopulateArmies(150U, 7U, UnitStorageValue, UnitsValue);
+
+    // Exact ties: the earlier unit in observation order must win, as it does for the linear scan.
+    UnitStorageValue.push_back(MakeUnit(1U, UNIT_TYPEID::PROTOSS_ZEALOT, Unit::Alliance::Enemy, Point2D(4.0f, 4.0f),
+                                        false));
+    UnitStorageValue.push_back(MakeUnit(2U, UNIT_TYPEID::PROTOSS_ZEALOT, Unit::Alliance::Enemy, Point2D(6.0f, 4.0f),
+                                        false));
+    UnitsValue.clear();
+    for (const Unit& UnitValue : UnitStorageValue)
+    {
+        UnitsValue.push_back(&UnitValue);
+    }
+
+    FUnitSpatialIndex UnitSpatialIndexValue;
+    UnitSpatialIndexValue.Build(UnitsValue);
+    Check(UnitSpatialIndexValue.GetUnitCount() == UnitsValue.size() &&
+              UnitSpatialIndexValue.GetUnitCount(Unit::Alliance::Enemy) == 152U,
+          SuccessValue, "Build should index every unit under its alliance.");
+
+    const Unit* TiedUnitPtrValue =
+        UnitSpatialIndexValue.FindNearest(Point2D(5.0f, 4.0f), Unit::Alliance::Enemy, IsCombatThreat);
+    Check(TiedUnitPtrValue != nullptr && TiedUnitPtrValue->tag == 1U, SuccessValue,
+          "Equidistant matches should resolve to the earlier observed unit.");
+
+    std::mt19937 RandomEngineValue(11U);
+    std::uniform_real_distribution<float> OriginDistributionValue(-40.0f, 240.0f);
+    bool bNearestMatchesValue = true;
+    for (size_t QueryIndexValue = 0U; QueryIndexValue < 2000U; ++QueryIndexValue)
+    {
+        const Point2D OriginPointValue(OriginDistributionValue(RandomEngineValue),
+                                       OriginDistributionValue(RandomEngineValue));
+        bNearestMatchesValue =
+            bNearestMatchesValue &&
+            UnitSpatialIndexValue.FindNearest(OriginPointValue, Unit::Alliance::Enemy, IsCombatThreat) ==
+                FindNearestLinear(OriginPointValue, UnitsValue, Unit::Alliance::Enemy, IsCombatThreat) &&
+            UnitSpatialIndexValue.FindNearest(OriginPointValue, Unit::Alliance::Enemy, IsGroundThreat) ==
+                FindNearestLinear(OriginPointValue, UnitsValue, Unit::Alliance::Enemy, IsGroundThreat) &&
+            UnitSpatialIndexValue.FindNearest(OriginPointValue, Unit::Alliance::Enemy, IsCompletedStructure) ==
+                FindNearestLinear(OriginPointValue, UnitsValue, Unit::Alliance::Enemy, IsCompletedStructure);
+    }
+    Check(bNearestMatchesValue, SuccessValue,
+          "Nearest queries should match the linear scan for origins inside and outside the indexed area.");
+
+    const auto IsNeverMatched = [](const Unit&) { return false; };
+    Check(UnitSpatialIndexValue.FindNearest(Point2D(50.0f, 50.0f), Unit::Alliance::Enemy, IsNeverMatched) == nullptr &&
+              UnitSpatialIndexValue.FindNearest(Point2D(50.0f, 50.0f), Unit::Alliance::Ally, IsCombatThreat) ==
+                  nullptr,
+          SuccessValue, "Queries with no match or an empty alliance should return null.");
+
+    UnitSpatialIndexValue.Reset();
+    Check(UnitSpatialIndexValue.GetUnitCount() == 0U, SuccessValue, "Reset should clear every alliance.");
+    return SuccessValue;
+}
+
+bool TestKNearestAndRadiusQueries()
+{
+    bool SuccessValue = true;
+
+    std::vector<Unit> UnitStorageValue;
+    Units UnitsValue;
+    PopulateArmies(120U, 23U, UnitStorageValue, UnitsValue);
+
+    FUnitSpatialIndex UnitSpatialIndexValue(6.0f);
+    UnitSpatialIndexValue.Build(UnitsValue);
+
+    const Point2D OriginPointValue(100.0f, 90.0f);
+    std::vector<const Unit*> NearestUnitsValue;
+    UnitSpatialIndexValue.FindKNearest(OriginPointValue, Unit::Alliance::Enemy, 5U, IsCombatThreat,
+                                       NearestUnitsValue);
+
+    bool bSortedValue = NearestUnitsValue.size() == 5U;
+    for (size_t UnitIndexValue = 1U; bSortedValue && UnitIndexValue < NearestUnitsValue.size(); ++UnitIndexValue)
+    {
+        bSortedValue = DistanceSquared2D(OriginPointValue, Point2D(NearestUnitsValue[UnitIndexValue - 1U]->pos)) <=
+                       DistanceSquared2D(OriginPointValue, Point2D(NearestUnitsValue[UnitIndexValue]->pos));
+    }
+    Check(bSortedValue, SuccessValue, "K-nearest should return the requested count, closest first.");
+
+    size_t CloserUnmatchedCountValue = 0U;
+    const float FarthestDistanceSquaredValue =
+        NearestUnitsValue.empty() ? 0.0f : DistanceSquared2D(OriginPointValue, Point2D(NearestUnitsValue.back()->pos));
+    for (const Unit* UnitPtrValue : UnitsValue)
+    {
+        if (UnitPtrValue->alliance == Unit::Alliance::Enemy && IsCombatThreat(*UnitPtrValue) &&
+            DistanceSquared2D(OriginPointValue, Point2D(UnitPtrValue->pos)) < FarthestDistanceSquaredValue)
+        {
+            ++CloserUnmatchedCountValue;
+        }
+    }
+    Check(CloserUnmatchedCountValue < 5U, SuccessValue, "K-nearest should not skip a closer matching unit.");
+    Check(NearestUnitsValue.empty() ||
+              NearestUnitsValue.front() ==
+                  FindNearestLinear(OriginPointValue, UnitsValue, Unit::Alliance::Enemy, IsCombatThreat),
+          SuccessValue, "The first k-nearest result should be the nearest match.");
+
+    constexpr float RadiusValue = 25.0f;
+    std::vector<const Unit*> RadiusUnitsValue;
+    UnitSpatialIndexValue.FindWithinRadius(OriginPointValue, RadiusValue, Unit::Alliance::Self,
+                                           [](const Unit&) { return true; }, RadiusUnitsValue);
+    std::vector<const Unit*> ExpectedRadiusUnitsValue;
+    for (const Unit* UnitPtrValue : UnitsValue)
+    {
+        if (UnitPtrValue->alliance == Unit::Alliance::Self &&
+            DistanceSquared2D(OriginPointValue, Point2D(UnitPtrValue->pos)) <= RadiusValue * RadiusValue)
+        {
+            ExpectedRadiusUnitsValue.push_back(UnitPtrValue);
+        }
+    }
+    Check(!ExpectedRadiusUnitsValue.empty() && RadiusUnitsValue == ExpectedRadiusUnitsValue, SuccessValue,
+          "Radius queries should return every unit in range, in observation order.");
+    return SuccessValue;
+}
+
+bool TestUnitExecutionQueryProfile()
+{
+    // One nearest-threat, nearest-ground-threat and nearest-structure query per combat unit per squad order, which
+    // is the query load ExpandUnitExecutionOrders puts on the observation each step.
+    constexpr size_t UnitsPerSideValue = 200U;
+    constexpr size_t SquadOrderCountValue = 4U;
+    constexpr size_t IterationCountValue = 20U;
+
+    bool SuccessValue = true;
+
+    std::vector<Unit> UnitStorageValue;
+    Units UnitsValue;
+    PopulateArmies(UnitsPerSideValue, 31U, UnitStorageValue, UnitsValue);
+    Units EnemyUnitsValue;
+    Units ControlledUnitsValue;
+    for (const Unit* UnitPtrValue : UnitsValue)
+    {
+        (UnitPtrValue->alliance == Unit::Alliance::Enemy ? EnemyUnitsValue : ControlledUnitsValue)
+            .push_back(UnitPtrValue);
+    }
+    const Point2D ObjectivePointValue(150.0f, 150.0f);
+
+    uint64_t LinearChecksumValue = 0U;
+    const FSteadyTimePoint LinearStartTimeValue = FSteadyClock::now();
+    for (size_t IterationIndexValue = 0U; IterationIndexValue < IterationCountValue; ++IterationIndexValue)
+    {
+        for (size_t SquadIndexValue = 0U; SquadIndexValue < SquadOrderCountValue; ++SquadIndexValue)
+        {
+            for (const Unit* ControlledUnitPtrValue : ControlledUnitsValue)
+            {
+                const Point2D UnitPointValue(ControlledUnitPtrValue->pos);
+                const Unit* ThreatPtrValue =
+                    FindNearestLinear(UnitPointValue, EnemyUnitsValue, Unit::Alliance::Enemy, IsCombatThreat);
+                const Unit* GroundThreatPtrValue =
+                    FindNearestLinear(UnitPointValue, EnemyUnitsValue, Unit::Alliance::Enemy, IsGroundThreat);
+                const Unit* StructurePtrValue = FindNearestLinear(ObjectivePointValue, EnemyUnitsValue,
+                                                                  Unit::Alliance::Enemy, IsCompletedStructure);
+                LinearChecksumValue += (ThreatPtrValue ? ThreatPtrValue->tag : 0U) +
+                                       (GroundThreatPtrValue ? GroundThreatPtrValue->tag : 0U) +
+                                       (StructurePtrValue ? StructurePtrValue->tag : 0U);
+            }
+        }
+    }
+    const FSteadyTimePoint LinearEndTimeValue = FSteadyClock::now();
+
+    FUnitSpatialIndex UnitSpatialIndexValue;
+    uint64_t IndexedChecksumValue = 0U;
+    uint64_t BuildMicrosecondsValue = 0U;
+    const FSteadyTimePoint IndexedStartTimeValue = FSteadyClock::now();
+    for (size_t IterationIndexValue = 0U; IterationIndexValue < IterationCountValue; ++IterationIndexValue)
+    {
+        const FSteadyTimePoint BuildStartTimeValue = FSteadyClock::now();
+        UnitSpatialIndexValue.Build(UnitsValue);
+        BuildMicrosecondsValue += GetElapsedMicroseconds(BuildStartTimeValue, FSteadyClock::now());
+        for (size_t SquadIndexValue = 0U; SquadIndexValue < SquadOrderCountValue; ++SquadIndexValue)
+        {
+            for (const Unit* ControlledUnitPtrValue : ControlledUnitsValue)
+            {
+                const Point2D UnitPointValue(ControlledUnitPtrValue->pos);
+                const Unit* ThreatPtrValue =
+                    UnitSpatialIndexValue.FindNearest(UnitPointValue, Unit::Alliance::Enemy, IsCombatThreat);
+                const Unit* GroundThreatPtrValue =
+                    UnitSpatialIndexValue.FindNearest(UnitPointValue, Unit::Alliance::Enemy, IsGroundThreat);
+                const Unit* StructurePtrValue = UnitSpatialIndexValue.FindNearest(
+                    ObjectivePointValue, Unit::Alliance::Enemy, IsCompletedStructure);
+                IndexedChecksumValue += (ThreatPtrValue ? ThreatPtrValue->tag : 0U) +
+                                        (GroundThreatPtrValue ? GroundThreatPtrValue->tag : 0U) +
+                                        (StructurePtrValue ? StructurePtrValue->tag : 0U);
+            }
+        }
+    }
+    const FSteadyTimePoint IndexedEndTimeValue = FSteadyClock::now();
+
+    Check(IndexedChecksumValue == LinearChecksumValue, SuccessValue,
+          "The indexed query load should pick the same units as the linear scans.");
+
+    const uint64_t LinearMicrosecondsValue =
+        GetElapsedMicroseconds(LinearStartTimeValue, LinearEndTimeValue) / IterationCountValue;
+    const uint64_t IndexedMicrosecondsValue =
+        GetElapsedMicroseconds(IndexedStartTimeValue, IndexedEndTimeValue) / IterationCountValue;
+    std::cout << "    Units=" << UnitsPerSideValue << "v" << UnitsPerSideValue
+              << " | SquadOrders=" << SquadOrderCountValue << " | LinearUsPerStep=" << LinearMicrosecondsValue
+              << " | IndexedUsPerStep=" << IndexedMicrosecondsValue
+              << " | BuildUsPerStep=" << BuildMicrosecondsValue / IterationCountValue << " | Speedup="
+              << std::fixed << std::setprecision(1)
+              << (IndexedMicrosecondsValue > 0U
+                      ? static_cast<double>(LinearMicrosecondsValue) / static_cast<double>(IndexedMicrosecondsValue)
+                      : 0.0)
+              << "x" << std::defaultfloat << std::endl;
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestUnitSpatialIndex(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking nearest queries against linear scans..." << std::endl;
+    SuccessValue = TestNearestMatchesLinearScan() && SuccessValue;
+
+    std::cout << "  Checking k-nearest and radius queries..." << std::endl;
+    SuccessValue = TestKNearestAndRadiusQueries() && SuccessValue;
+
+    std::cout << "  Profiling unit-execution proximity queries..." << std::endl;
+    SuccessValue = TestUnitExecutionQueryProfile() && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2
@@ -0,0 +1,163 @@
+#include "test_worker_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "sc2api/sc2_coordinator.h"
+#include "sc2api/sc2_worker_pool.h"
+
+namespace sc2
+{
+namespace
+{
+
+bool Check(const bool ConditionValue, bool& SuccessValue, const char* MessageValue)
+{
+    if (!ConditionValue)
+    {
+        SuccessValue = false;
+        std::cerr << "    " << MessageValue << std::endl;
+    }
+
+    return ConditionValue;
+}
+
+bool TestWorkerPoolBarrier()
+{
+    constexpr size_t WorkerCountValue = 4U;
+    constexpr size_t TaskCountValue = 11U;
+    constexpr size_t BatchCountValue = 200U;
+
+    bool SuccessValue = true;
+
+    WorkerPool WorkerPoolValue;
+    std::vector<size_t> InlineRunCounts(3U, 0U);
+    WorkerPoolValue.Run(InlineRunCounts.size(), [&InlineRunCounts](size_t TaskIndexValue) {
+        ++InlineRunCounts[TaskIndexValue];
+    });
+    Check(InlineRunCounts == std::vector<size_t>(3U, 1U), SuccessValue,
+          "A pool that was never started should run the batch on the calling thread.");
+
+    WorkerPoolValue.Start(WorkerCountValue, false);
+    Check(WorkerPoolValue.GetWorkerCount() == WorkerCountValue && !WorkerPoolValue.IsPinned(), SuccessValue,
+          "Start should report the requested worker count.");
+
+    // Each task records which worker thread ran it, so static assignment can be checked across batches.
+    std::vector<std::thread::id> FirstTaskThreads(TaskCountValue);
+    std::vector<uint32_t> TaskRunCounts(TaskCountValue, 0U);
+    bool bSameThreadValue = true;
+    bool bBarrierHeldValue = true;
+    std::mutex ResultMutex;
+    for (size_t BatchIndexValue = 0; BatchIndexValue < BatchCountValue; ++BatchIndexValue)
+    {
+        std::atomic<size_t> CompletedTaskCount(0U);
+        WorkerPoolValue.Run(TaskCountValue, [&](size_t TaskIndexValue) {
+            ++TaskRunCounts[TaskIndexValue];
+            const std::thread::id ThreadIdValue = std::this_thread::get_id();
+            if (BatchIndexValue == 0U)
+            {
+                FirstTaskThreads[TaskIndexValue] = ThreadIdValue;
+            }
+            else if (FirstTaskThreads[TaskIndexValue] != ThreadIdValue)
+            {
+                std::lock_guard<std::mutex> LockValue(ResultMutex);
+                bSameThreadValue = false;
+            }
+            CompletedTaskCount.fetch_add(1U);
+        });
+        bBarrierHeldValue = bBarrierHeldValue && CompletedTaskCount.load() == TaskCountValue;
+    }
+
+    bool bEveryTaskRanValue = true;
+    for (const uint32_t TaskRunCountValue : TaskRunCounts)
+    {
+        bEveryTaskRanValue = bEveryTaskRanValue && TaskRunCountValue == BatchCountValue;
+    }
+
+    std::set<std::thread::id> DistinctThreads(FirstTaskThreads.begin(), FirstTaskThreads.end());
+    Check(bBarrierHeldValue, SuccessValue, "Run should not return before every task in the batch has finished.");
+    Check(bEveryTaskRanValue, SuccessValue, "Every task should run exactly once per batch.");
+    Check(bSameThreadValue, SuccessValue, "A task index should always be run by the same worker.");
+    Check(DistinctThreads.size() == WorkerCountValue &&
+              DistinctThreads.count(std::this_thread::get_id()) == 0U,
+          SuccessValue, "Tasks should be spread over every worker and never run on the caller.");
+
+    std::vector<size_t> FewerTaskRunCounts(2U, 0U);
+    WorkerPoolValue.Run(FewerTaskRunCounts.size(), [&FewerTaskRunCounts](size_t TaskIndexValue) {
+        ++FewerTaskRunCounts[TaskIndexValue];
+    });
+    Check(FewerTaskRunCounts == std::vector<size_t>(2U, 1U), SuccessValue,
+          "A batch smaller than the worker count should still complete.");
+
+    WorkerPoolValue.Start(2U, true);
+    std::atomic<size_t> PinnedRunCount(0U);
+    WorkerPoolValue.Run(5U, [&PinnedRunCount](size_t) { PinnedRunCount.fetch_add(1U); });
+    Check(WorkerPoolValue.IsPinned() && PinnedRunCount.load() == 5U, SuccessValue,
+          "A restarted, pinned pool should run every task.");
+
+    WorkerPoolValue.Stop();
+    Check(WorkerPoolValue.GetWorkerCount() == 0U, SuccessValue, "Stop should join every worker.");
+    return SuccessValue;
+}
+
+bool TestStepLatencyHistogram()
+{
+    bool SuccessValue = true;
+
+    StepLatencyHistogram HistogramValue;
+    Check(HistogramValue.GetMeanMicroseconds() == 0.0 && HistogramValue.GetPercentileMicroseconds(0.5) == 0U,
+          SuccessValue, "An empty histogram should report zero.");
+
+    for (uint64_t SampleIndexValue = 0; SampleIndexValue < 90U; ++SampleIndexValue)
+    {
+        HistogramValue.Add(1000U);
+    }
+    for (uint64_t SampleIndexValue = 0; SampleIndexValue < 10U; ++SampleIndexValue)
+    {
+        HistogramValue.Add(40000U);
+    }
+
+    Check(HistogramValue.sample_count == 100U && HistogramValue.max_us == 40000U, SuccessValue,
+          "Add should track the sample count and maximum.");
+    Check(HistogramValue.GetMeanMicroseconds() == 4900.0, SuccessValue, "The mean should use exact totals.");
+    Check(HistogramValue.buckets[9] == 90U && HistogramValue.buckets[15] == 10U, SuccessValue,
+          "Samples should land in their power-of-two buckets.");
+    Check(HistogramValue.GetPercentileMicroseconds(0.5) == 1023U, SuccessValue,
+          "The median should be the upper bound of the 512-1023 us bucket.");
+    Check(HistogramValue.GetPercentileMicroseconds(0.99) == 40000U, SuccessValue,
+          "A tail percentile should be capped at the largest sample.");
+
+    HistogramValue.Add(UINT64_MAX);
+    Check(HistogramValue.buckets[StepLatencyHistogram::kBucketCount - 1U] == 1U, SuccessValue,
+          "Samples past the last bucket should be clamped into it.");
+
+    HistogramValue.Reset();
+    Check(HistogramValue.sample_count == 0U && HistogramValue.buckets[9] == 0U, SuccessValue,
+          "Reset should clear every sample.");
+    return SuccessValue;
+}
+
+}  // namespace
+
+bool TestWorkerPool(int ArgC, char** ArgV)
+{
+    (void)ArgC;
+    (void)ArgV;
+
+    bool SuccessValue = true;
+
+    std::cout << "  Checking worker pool barriers and task assignment..." << std::endl;
+    SuccessValue = TestWorkerPoolBarrier() && SuccessValue;
+
+    std::cout << "  Checking step latency histogram..." << std::endl;
+    SuccessValue = TestStepLatencyHistogram() && SuccessValue;
+
+    return SuccessValue;
+}
+
+}  // namespace sc2